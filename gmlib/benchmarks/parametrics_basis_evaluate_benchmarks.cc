@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+
+#include <parametrics/evaluators/gmevaluatorstatic.h>
+#include <parametrics/evaluators/gmerbsevaluator.h>
+#include <parametrics/curves/gmpbsplinecurve.h>
+#include <parametrics/surfaces/gmpbeziersurf.h>
+using namespace GMlib;
+
+// stl
+#include <cmath>
+#include <cstdio>
+
+
+
+// Arguments: {polynomial degree, 0: generic kernel, 1: degree specialized kernel}
+static void BasisArgs(benchmark::internal::Benchmark* b)
+{
+  for( int d = 2; d <= 5; d++ )
+    for( int s = 0; s < 2; s++ )
+      b->Args({d, s});
+}
+
+
+
+static void BM_EvaluateBhp(benchmark::State& state)
+{
+  const int  d    = state.range(0);
+  const bool spec = state.range(1);
+  const int  m    = 1024;
+
+  DMatrix<float> bhp;
+
+  // The test loop
+  while (state.KeepRunning()) {
+    for( int i = 0; i < m; i++ ) {
+      if(spec) EvaluatorStatic<float>::evaluateBhp( bhp, d, i/float(m-1) );
+      else     EvaluatorStatic<float>::evaluateBhpGeneric( bhp, d, i/float(m-1) );
+    }
+    benchmark::DoNotOptimize( bhp[0][0] );
+  }
+  state.SetItemsProcessed( state.iterations() * m );
+}
+
+
+static void BM_EvaluateBSp2(benchmark::State& state)
+{
+  const int  d    = state.range(0);
+  const bool spec = state.range(1);
+  const int  m    = 1024;
+  const int  n    = 20;
+
+  DVector<float> tv(n+d+1);
+  for( int i = 0; i < tv.getDim(); i++ )
+    tv[i] = std::min( std::max( i-d, 0 ), n-d );
+
+  DMatrix<float> bsp;
+  const float dt = (tv(n)-tv(d)) / (m-1);
+
+  // The test loop
+  while (state.KeepRunning()) {
+    for( int i = 0; i < m; i++ ) {
+      const float t = tv(d) + i*dt;
+      const int   k = EvaluatorStatic<float>::knotIndex( tv, t, d, true );
+      if(spec) EvaluatorStatic<float>::evaluateBSp2( bsp, t, tv, d, k );
+      else     EvaluatorStatic<float>::evaluateBSp2Generic( bsp, t, tv, d, k );
+    }
+    benchmark::DoNotOptimize( bsp[0][0] );
+  }
+  state.SetItemsProcessed( state.iterations() * m );
+}
+
+
+BENCHMARK(BM_EvaluateBhp)
+  ->Unit(benchmark::kMicrosecond)
+  ->Apply(BasisArgs);
+
+BENCHMARK(BM_EvaluateBSp2)
+  ->Unit(benchmark::kMicrosecond)
+  ->Apply(BasisArgs);
+
+
+
+// Arguments: {polynomial degree}
+static void BM_PBSplineCurve_Evaluate(benchmark::State& state)
+{
+  const int d = state.range(0);
+  const int m = 1024;
+
+  DVector<Vector<float,3>> c(20);
+  for( int i = 0; i < c.getDim(); i++ )
+    c[i] = Vector<float,3>( i, std::sin(0.5f*i), std::cos(0.3f*i) );
+
+  PBSplineCurve<float> curve(c, d, false);
+  const float s  = curve.getParStart();
+  const float dt = curve.getParDelta() / (m-1);
+
+  DVector<Vector<float,3>> p;
+
+  // The test loop
+  while (state.KeepRunning()) {
+    for( int i = 0; i < m; i++ )
+      curve.evaluate( p, s + i*dt, 1 );
+    benchmark::DoNotOptimize( p[0] );
+  }
+  state.SetItemsProcessed( state.iterations() * m );
+}
+
+
+// Arguments: {polynomial degree}
+static void BM_PBezierSurf_Evaluate(benchmark::State& state)
+{
+  const int d = state.range(0);
+  const int m = 32;
+
+  DMatrix<Vector<float,3>> c(d+1,d+1);
+  for( int i = 0; i <= d; i++ )
+    for( int j = 0; j <= d; j++ )
+      c[i][j] = Vector<float,3>( i, j, float((i*j) % 3) );
+
+  PBezierSurf<float> surf(c);
+  const float dt = 1.0f / (m-1);
+
+  DMatrix<Vector<float,3>> p;
+
+  // The test loop
+  while (state.KeepRunning()) {
+    for( int i = 0; i < m; i++ )
+      for( int j = 0; j < m; j++ )
+        surf.evaluate( p, i*dt, j*dt, 1, 1 );
+    benchmark::DoNotOptimize( p[0][0] );
+  }
+  state.SetItemsProcessed( state.iterations() * m * m );
+}
+
+
+BENCHMARK(BM_PBSplineCurve_Evaluate)
+  ->Unit(benchmark::kMicrosecond)
+  ->DenseRange(2, 5);
+
+BENCHMARK(BM_PBezierSurf_Evaluate)
+  ->Unit(benchmark::kMicrosecond)
+  ->DenseRange(2, 5);
+
+
+
+// Arguments: {0: table computed, 1: table read from the table cache}
+static void BM_ERBSEvaluator_Construct(benchmark::State& state)
+{
+  const bool cached = state.range(0);
+  const std::string file = "/tmp/" + ERBSEvaluator<long double>().getTableName() + "_m1024_s" + std::to_string(sizeof(long double)) + ".gmbt";
+
+  if(cached) {
+    BasisEvaluator<long double>::setTableCacheDir( "/tmp" );
+    ERBSEvaluator<long double> e;   // Make sure the cache is filled
+  }
+
+  // The test loop
+  while (state.KeepRunning()) {
+    ERBSEvaluator<long double> e;
+    benchmark::DoNotOptimize( e.getScale() );
+  }
+
+  BasisEvaluator<long double>::setTableCacheDir( "" );
+  std::remove( file.c_str() );
+}
+
+BENCHMARK(BM_ERBSEvaluator_Construct)
+  ->Unit(benchmark::kMicrosecond)
+  ->Arg(0)
+  ->Arg(1);
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <parametrics/curves/gmpbutterfly.h>
+#include <parametrics/curves/gmpcircle.h>
+#include <parametrics/curves/gmperbscurve.h>
+#include <parametrics/curves/gmprosecurve.h>
+#include <parametrics/surfaces/gmptorus.h>
+#include <parametrics/utils/gmpintersection.h>
+using namespace GMlib;
+
+#include <thread>
+
+
+
+// Arguments: {number of knots, number of threads (1..N)}
+static void IntersectionArgs(benchmark::internal::Benchmark* b)
+{
+  const int no_threads = std::max<int>( 1, std::thread::hardware_concurrency() );
+  for( int m = 250; m <= 1000; m *= 2 )
+    for( int t = 1; t <= no_threads; t++ )
+      b->Args({m, t});
+}
+
+
+
+// Two ERBS curves of m knots each, crossing each other many times
+static void BM_PERBSCurve_PERBSCurve(benchmark::State& state)
+{
+  PRoseCurve<double> rose( 1.0, 0.0 );
+  PCircle<double>    circle( 0.6 );
+  rose.sample( 4 * int(state.range(0)), 0 );     // The sub curves are sampled as the original curves
+  circle.sample( 4 * int(state.range(0)), 0 );
+  PERBSCurve<double> c1( &rose, int(state.range(0)) );
+  PERBSCurve<double> c2( &circle, int(state.range(0)) );
+  c1.sample( 4 * int(state.range(0)), 0 );
+  c2.sample( 4 * int(state.range(0)), 0 );
+
+  size_t no = 0;
+  while (state.KeepRunning()) {
+    no = GMPintersection::getIntersections( c1, c2, 1e-6, int(state.range(1)) ).size();
+  }
+  state.counters["intersections"] = no;
+}
+BENCHMARK(BM_PERBSCurve_PERBSCurve)->Apply(IntersectionArgs)->Unit(benchmark::kMillisecond);
+
+
+
+static void BM_PERBSCurve_PTorus(benchmark::State& state)
+{
+  PButterfly<double> butterfly( 1.0 );
+  butterfly.sample( 4 * int(state.range(0)), 0 );
+  PERBSCurve<double> c( &butterfly, int(state.range(0)) );
+  c.sample( 4 * int(state.range(0)), 0 );
+  PTorus<double> torus( 2.0, 0.5, 0.5 );
+  torus.sample( 64, 64, 1, 1 );
+
+  size_t no = 0;
+  while (state.KeepRunning()) {
+    no = GMPintersection::getIntersections( c, torus, 1e-6, int(state.range(1)) ).size();
+  }
+  state.counters["intersections"] = no;
+}
+BENCHMARK(BM_PERBSCurve_PTorus)->Apply(IntersectionArgs)->Unit(benchmark::kMillisecond);
+
@@ -1,14 +1,55 @@
 #include <benchmark/benchmark.h>
 
 #include <parametrics/curves/gmpcircle.h>
+#include <parametrics/curves/gmpbsplinecurve.h>
 using namespace GMlib;
 
+// stl
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+
+
+// Counts the heap allocations made by the program, to be able to report allocations per evaluation
+static std::atomic<long> no_allocs(0);
+
+void* operator new(std::size_t size) {
+  no_allocs++;
+  if(void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+
+
+// Gives access to the (protected) resample function of a curve
+template <typename Curve>
+class Resampler : public Curve {
+public:
+  using Curve::Curve;
+
+  void resample( std::vector<DVector<Vector<float,3>>>& p, int m, int d ) {
+
+    std::vector<float> t(m);
+    const float dt = this->getParDelta() / (m-1);
+    for( int i = 0; i < m; i++ )
+      t[i] = this->getParStart() + i*dt;
+
+    Sphere<float,3> s;
+    Curve::resample( p, s, t, d );
+  }
+};
+
 
 
 static void BM_PCircle_Resample(benchmark::State& state)
 {
-  auto pcircle = PCircle<float>();
-  DVector<DVector<Vector<float,3>>> samps;
+  Resampler<PCircle<float>> pcircle;
+  std::vector<DVector<Vector<float,3>>> samps;
 
   // The test loop
   while (state.KeepRunning()) {
@@ -21,3 +62,102 @@ BENCHMARK(BM_PCircle_Resample)
   ->Unit(benchmark::kNanosecond)
   ->RangeMultiplier(2)
   ->Ranges({{2, 2 << 15}, {1,2}});
+
+
+
+// Arguments: {polynomial degree, number of derivatives}
+static void BM_PBSplineCurve_Evaluate(benchmark::State& state)
+{
+  const int d  = state.range(0);
+  const int nd = state.range(1);
+  const int m  = 1024;
+
+  DVector<Vector<float,3>> c(20);
+  for( int i = 0; i < c.getDim(); i++ )
+    c[i] = Vector<float,3>( i, std::sin(0.5f*i), std::cos(0.3f*i) );
+
+  PBSplineCurve<float> curve(c, d, false);
+  const float s  = curve.getParStart();
+  const float dt = curve.getParDelta() / (m-1);
+
+  DVector<Vector<float,3>> p;
+  curve.evaluate( p, s, nd );       // Warm up the evaluation buffers
+
+  // The test loop
+  const long allocs = no_allocs;
+  while (state.KeepRunning()) {
+    for( int i = 0; i < m; i++ )
+      curve.evaluate( p, s + i*dt, nd );
+    benchmark::DoNotOptimize( p[0] );
+  }
+
+  const double no_evals = double(state.iterations()) * m;
+  state.counters["allocs/eval"] = double(no_allocs - allocs) / no_evals;
+  state.SetItemsProcessed( state.iterations() * m );
+}
+
+
+BENCHMARK(BM_PBSplineCurve_Evaluate)
+  ->Unit(benchmark::kMicrosecond)
+  ->Args({2,1})
+  ->Args({3,1})
+  ->Args({3,2})
+  ->Args({5,1})
+  ->Args({7,2});
+
+
+
+// Arguments: {0: one evaluate() call for each parameter value, 1: batch evaluate()}
+template <typename Curve>
+static void runEvaluate(benchmark::State& state, const Curve& curve, int d)
+{
+  const bool batch = state.range(0);
+  const int  m     = 4096;
+
+  std::vector<float> t(m);
+  for( int i = 0; i < m; i++ )
+    t[i] = curve.getParStart() + i * curve.getParDelta() / (m-1);
+
+  std::vector<Vector<float,3>> p( (d+1)*m );
+  DVector<Vector<float,3>>     q;
+
+  // The test loop
+  while (state.KeepRunning()) {
+    if(batch)
+      curve.evaluate( p.data(), t.data(), m, d );
+    else
+      for( int i = 0; i < m; i++ ) {
+        curve.evaluate( q, t[i], d );
+        for( int k = 0; k <= d; k++ )
+          p[k*m+i] = q[k];
+      }
+    benchmark::DoNotOptimize( p[0] );
+  }
+  state.SetItemsProcessed( state.iterations() * m );
+}
+
+
+static void BM_PCircle_Evaluate(benchmark::State& state)
+{
+  PCircle<float> circle(2.0f);
+  runEvaluate(state, circle, 2);
+}
+
+static void BM_PBSplineCurve_EvaluateBatch(benchmark::State& state)
+{
+  DVector<Vector<float,3>> c(20);
+  for( int i = 0; i < c.getDim(); i++ )
+    c[i] = Vector<float,3>( i, std::sin(0.5f*i), std::cos(0.3f*i) );
+
+  PBSplineCurve<float> curve(c, 3, false);
+  runEvaluate(state, curve, 1);
+}
+
+
+BENCHMARK(BM_PCircle_Evaluate)
+  ->Unit(benchmark::kMicrosecond)
+  ->DenseRange(0, 1);
+
+BENCHMARK(BM_PBSplineCurve_EvaluateBatch)
+  ->Unit(benchmark::kMicrosecond)
+  ->DenseRange(0, 1);
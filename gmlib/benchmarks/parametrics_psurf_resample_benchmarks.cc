@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <parametrics/surfaces/gmptorus.h>
+#include <parametrics/surfaces/gmpbeziersurf.h>
+#include <parametrics/surfaces/gmperbssurf.h>
+using namespace GMlib;
+
+#include <thread>
+
+
+
+// Gives access to the (protected) resample function of a surface
+template <typename Surf>
+class Resampler : public Surf {
+public:
+  using Surf::Surf;
+  using PSurf<float,3>::resample;
+
+  void resample( DSampleGrid<Vector<float,3>>& p, int m ) {
+
+    this->resample( p, m, m, 1, 1,
+                    this->getParStartU(), this->getParStartV(), this->getParEndU(), this->getParEndV() );
+  }
+};
+
+
+
+// Arguments: {number of samples in each direction, number of threads (1..N)}
+static void ResampleArgs(benchmark::internal::Benchmark* b)
+{
+  const int no_threads = std::max<int>( 1, std::thread::hardware_concurrency() );
+  for( int m = 64; m <= 512; m *= 2 )
+    for( int t = 1; t <= no_threads; t++ )
+      b->Args({m, t});
+}
+
+
+
+template <typename Surf>
+static void runResample(benchmark::State& state, Resampler<Surf>& surf)
+{
+  const int m = state.range(0);
+  DSampleGrid<Vector<float,3>> samps;
+
+  surf.sample(m, m, 1, 1);
+  surf.setResampleThreads(state.range(1));
+
+  // The test loop
+  while (state.KeepRunning()) {
+    surf.resample(samps, m);
+  }
+  state.SetItemsProcessed(state.iterations() * m * m);
+}
+
+
+
+static void BM_PTorus_Resample(benchmark::State& state)
+{
+  Resampler<PTorus<float>> torus;
+  runResample(state, torus);
+}
+
+static void BM_PTorus_Resample_DD(benchmark::State& state)
+{
+  Resampler<PTorus<float>> torus;
+  torus.setDerivationMethod(GM_DERIVATION_DD);
+  runResample(state, torus);
+}
+
+static void BM_PBezierSurf_Resample(benchmark::State& state)
+{
+  DMatrix<Vector<float,3>> c(4,4);
+  for( int i = 0; i < 4; i++ )
+    for( int j = 0; j < 4; j++ )
+      c[i][j] = Vector<float,3>( i, j, float((i*j) % 3) );
+
+  Resampler<PBezierSurf<float>> bezier(c);
+  runResample(state, bezier);
+}
+
+static void BM_PERBSSurf_Resample(benchmark::State& state)
+{
+  PTorus<float> torus;
+  Resampler<PERBSSurf<float>> erbs(&torus, 6, 6, 1, 1);
+  runResample(state, erbs);
+}
+
+static void BM_PERBSSurf_Resample_FixedGrid(benchmark::State& state)
+{
+  PTorus<float> torus;
+  Resampler<PERBSSurf<float>> erbs(&torus, 6, 6, 1, 1);
+  erbs.setResampleMode(GM_RESAMPLE_FIXED_GRID);
+  runResample(state, erbs);
+}
+
+
+BENCHMARK(BM_PTorus_Resample)
+  ->Unit(benchmark::kMicrosecond)
+  ->UseRealTime()
+  ->Apply(ResampleArgs);
+
+BENCHMARK(BM_PTorus_Resample_DD)
+  ->Unit(benchmark::kMicrosecond)
+  ->UseRealTime()
+  ->Apply(ResampleArgs);
+
+BENCHMARK(BM_PBezierSurf_Resample)
+  ->Unit(benchmark::kMicrosecond)
+  ->UseRealTime()
+  ->Apply(ResampleArgs);
+
+BENCHMARK(BM_PERBSSurf_Resample)
+  ->Unit(benchmark::kMicrosecond)
+  ->UseRealTime()
+  ->Apply(ResampleArgs);
+
+BENCHMARK(BM_PERBSSurf_Resample_FixedGrid)
+  ->Unit(benchmark::kMicrosecond)
+  ->UseRealTime()
+  ->Apply(ResampleArgs);
@@ -0,0 +1,217 @@
+#include <benchmark/benchmark.h>
+
+#include <trianglesystem/gmtrianglemesh.h>
+#include <trianglesystem/gmtrianglestream.h>
+#include <trianglesystem/gmtrianglesystem.h>
+using namespace GMlib;
+
+// stl
+#include <sstream>
+#include <vector>
+
+
+
+// The memory of the vertices, edges and triangles of a TriangleFacets, and of the edge arrays
+// of the vertices, without allocation overhead, the triangle order grid and the vertex hash.
+// To compare with TriangleMesh::getMemoryUsage().
+static std::size_t facetsMemoryUsage(TriangleFacets<float>& facets)
+{
+  std::size_t bytes = facets.getMaxSize() * sizeof(TSVertex<float>);
+  for( int i = 0; i < facets.getNoVertices(); i++ )
+    bytes += facets.getVertex( i )->getEdges().getMaxSize() * sizeof(TSEdge<float>*);
+  bytes += facets.getNoEdges()     * ( sizeof(TSEdge<float>)     + sizeof(TSEdge<float>*) );
+  bytes += facets.getNoTriangles() * ( sizeof(TSTriangle<float>) + sizeof(TSTriangle<float>*) );
+  return bytes;
+}
+
+
+
+// Random points in the unit square, a height field over them.
+// If clustered, the points are in 16 small squares with big empty space between them.
+static ArrayLX<TSVertex<float>> randomVertices(int n, bool clustered = false)
+{
+  ArrayLX<TSVertex<float>> v;
+  v.setSize(n);
+  unsigned int seed = 11u;
+  for( int i = 0; i < n; i++ ) {
+    seed = seed * 1103515245u + 12345u;  float x = (seed >> 8) / float(1 << 24);
+    seed = seed * 1103515245u + 12345u;  float y = (seed >> 8) / float(1 << 24);
+    if( clustered ) {
+      const int c = i % 16;
+      x = 0.25f * (c % 4) + 0.01f * x;
+      y = 0.25f * (c / 4) + 0.01f * y;
+    }
+    v[i] = TSVertex<float>( x, y, 0.1f * x * y );
+  }
+  return v;
+}
+
+
+
+// Arguments: {number of vertices, clustered (0/1)}
+static void TriangulateArgs(benchmark::internal::Benchmark* b, int max)
+{
+  for( int c = 0; c <= 1; c++ )
+    for( int n = 1<<10; n <= max; n *= 4 )
+      b->Args({n, c});
+}
+
+
+
+static void BM_TriangleFacets_TriangulateDelaunay(benchmark::State& state)
+{
+  const ArrayLX<TSVertex<float>> v = randomVertices( int(state.range(0)), state.range(1) );
+  const bool ordered = state.range(2);
+
+  std::size_t bytes = 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    TriangleFacets<float>* facets = new TriangleFacets<float>( v );
+    state.ResumeTiming();
+
+    facets->triangulateDelaunay( ordered );
+
+    state.PauseTiming();
+    bytes = facetsMemoryUsage( *facets );
+    delete facets;
+    state.ResumeTiming();
+  }
+  state.counters["bytes/vertex"] = double(bytes) / state.range(0);
+}
+BENCHMARK(BM_TriangleFacets_TriangulateDelaunay)
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      for( int c = 0; c <= 1; c++ ) {
+        for( int n = 1<<10; n <= 1<<14; n *= 4 ) b->Args({n, c, 0});
+        for( int n = 1<<10; n <= 1<<16; n *= 4 ) b->Args({n, c, 1});
+      } })
+    ->Unit(benchmark::kMillisecond);
+
+
+
+static void BM_TriangleMesh_TriangulateDelaunay(benchmark::State& state)
+{
+  const ArrayLX<TSVertex<float>> v = randomVertices( int(state.range(0)), state.range(1) );
+  TriangleMesh<float> mesh( v );
+
+  while (state.KeepRunning()) {
+    mesh.triangulateDelaunay();
+  }
+  state.counters["bytes/vertex"] = double(mesh.getMemoryUsage()) / state.range(0);
+}
+BENCHMARK(BM_TriangleMesh_TriangulateDelaunay)
+    ->Apply([](benchmark::internal::Benchmark* b) { TriangulateArgs( b, 1<<20 ); })
+    ->Unit(benchmark::kMillisecond);
+
+
+
+// The strips on several threads, 0 threads uses all cores
+static void BM_TriangleMesh_TriangulateDelaunay__Threads(benchmark::State& state)
+{
+  const ArrayLX<TSVertex<float>> v = randomVertices( int(state.range(0)) );
+  TriangleMesh<float> mesh( v );
+  const int no_threads = int(state.range(1));
+
+  while (state.KeepRunning()) {
+    mesh.triangulateDelaunay( no_threads );
+  }
+}
+BENCHMARK(BM_TriangleMesh_TriangulateDelaunay__Threads)
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      for( int n = 1<<18; n <= 1<<22; n *= 4 )
+        for( int t : { 1, 2, 4, 0 } )
+          b->Args({n, t}); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+
+
+// Only counts what it gets
+class CountingSink : public TriangleStreamSink<float> {
+public:
+  long long no_triangles = 0;
+  void triangle( long long, long long, long long ) override { no_triangles++; }
+  void vertex( long long, const Point<float,3>& ) override {}
+};
+
+// Arguments: {number of vertices, tile size}, the points are sorted in chunks of 2^20
+static void BM_TriangleStream_Triangulate(benchmark::State& state)
+{
+  const ArrayLX<TSVertex<float>> v = randomVertices( int(state.range(0)) );
+  std::string data;
+  for( int i = 0; i < v.size(); i++ )
+    data.append( reinterpret_cast<const char*>( v(i).getPosition().getPtr() ), 3*sizeof(float) );
+
+  TriangleStream<float> stream( int(state.range(1)), 1<<20 );
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::istringstream in( data );
+    CountingSink sink;
+    state.ResumeTiming();
+
+    stream.triangulate( in, sink, TriangleStream<float>::BINARY );
+  }
+  state.counters["max vertices"] = stream.getMaxNoVertices();
+}
+BENCHMARK(BM_TriangleStream_Triangulate)
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      for( int n = 1<<16; n <= 1<<22; n *= 4 )
+        for( int t : { 1<<12, 1<<16 } )
+          b->Args({n, t}); })
+    ->Unit(benchmark::kMillisecond);
+
+
+
+// Inserting 1000 new vertices one by one into a triangulation of n vertices
+static void BM_TriangleFacets_InsertVertex(benchmark::State& state)
+{
+  const ArrayLX<TSVertex<float>> v = randomVertices( int(state.range(0)) );
+  ArrayLX<TSVertex<float>> w;
+  for( int i = 0; i < 1000; i++ ) {
+    const float x = (i % 40 + 0.5f) / 40.0f, y = (i / 40 + 0.5f) / 25.0f;
+    w += TSVertex<float>( x, y, 0.1f * x * y );
+  }
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    TriangleFacets<float>* facets = new TriangleFacets<float>( v );
+    facets->triangulateDelaunay( true );
+    facets->insertVertex( v(0) );     // Makes the vertex hash, it is only made once
+    state.ResumeTiming();
+
+    for( int i = 0; i < w.getSize(); i++ )
+      facets->insertVertex( w[i] );
+
+    state.PauseTiming();
+    delete facets;
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_TriangleFacets_InsertVertex)->RangeMultiplier(4)->Range(1<<12, 1<<18)->Unit(benchmark::kMillisecond);
+
+
+
+static void BM_TriangleFacets_ComputeNormals(benchmark::State& state)
+{
+  const ArrayLX<TSVertex<float>> v = randomVertices( int(state.range(0)) );
+  TriangleFacets<float> facets( v );
+  facets.triangulateDelaunay();
+
+  while (state.KeepRunning()) {
+    facets.computeNormals();
+  }
+}
+BENCHMARK(BM_TriangleFacets_ComputeNormals)->RangeMultiplier(4)->Range(1<<10, 1<<14)->Unit(benchmark::kMicrosecond);
+
+
+
+static void BM_TriangleMesh_ComputeNormals(benchmark::State& state)
+{
+  const ArrayLX<TSVertex<float>> v = randomVertices( int(state.range(0)) );
+  TriangleMesh<float> mesh( v );
+  mesh.triangulateDelaunay();
+
+  while (state.KeepRunning()) {
+    mesh.computeNormals();
+  }
+}
+BENCHMARK(BM_TriangleMesh_ComputeNormals)->RangeMultiplier(4)->Range(1<<10, 1<<14)->Unit(benchmark::kMicrosecond);
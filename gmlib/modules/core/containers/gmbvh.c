@@ -0,0 +1,598 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+// stl
+#include <algorithm>
+#include <cmath>
+
+
+
+namespace GMlib {
+
+
+  template <typename T>
+  inline
+  Bvh<T>::Bvh() {}
+
+
+  /*! void Bvh<T>::build( const std::vector<Point<T,3>>& p, const std::vector<Vector<int,3>>& tri,
+   *                      const std::vector<Point<T,2>>& par )
+   *  Builds the hierarchy over a triangle mesh, the mesh is copied.
+   *
+   *  \param[in] p    The vertices
+   *  \param[in] tri  The triangles, as indices into p
+   *  \param[in] par  The parameters of the vertices
+   */
+  template <typename T>
+  void Bvh<T>::build( const std::vector<Point<T,3>>& p, const std::vector<Vector<int,3>>& tri,
+                      const std::vector<Point<T,2>>& par ) {
+
+    _p   = p;
+    _tri = tri;
+    _par = par;
+
+    const int m = int(_tri.size());
+    std::vector<Box<T,3>>   box;
+    std::vector<Point<T,3>> c(m);
+    box.reserve( m );
+    _order.resize( m );
+    for( int i = 0; i < m; i++ ) {
+      box.push_back( _triBox( i ) );
+      c[i]      = box[i].getPointCenter();
+      _order[i] = i;
+    }
+
+    _nodes.clear();
+    _nodes.reserve( 2*m );
+    if( m > 0 ) _build( box, c, 0, m, 0 );
+  }
+
+
+  template <typename T>
+  inline
+  void Bvh<T>::clear() {
+
+    _nodes.clear();
+    _order.clear();
+    _p.clear();
+    _tri.clear();
+    _par.clear();
+  }
+
+
+  /*! void Bvh<T>::refit( const std::vector<Point<T,3>>& p )
+   *  Updates the boxes of the hierarchy after the vertices have moved, the triangles
+   *  must be the same as in build(). The tree is kept, so the queries may be slower
+   *  than after a new build() if the vertices have moved much.
+   *
+   *  \param[in] p    The vertices
+   */
+  template <typename T>
+  inline
+  void Bvh<T>::refit( const std::vector<Point<T,3>>& p ) {
+
+    _p = p;
+    _refit();
+  }
+
+
+  template <typename T>
+  inline
+  void Bvh<T>::refit( const std::vector<Point<T,3>>& p, const std::vector<Point<T,2>>& par ) {
+
+    _par = par;
+    refit( p );
+  }
+
+
+  /*! bool Bvh<T>::update( const std::vector<Point<T,3>>& p, const std::vector<Vector<int,3>>& tri,
+   *                       const std::vector<Point<T,2>>& par )
+   *  Refits the hierarchy if the triangles are the same as before, builds it otherwise.
+   *
+   *  \return True if the hierarchy was built
+   */
+  template <typename T>
+  bool Bvh<T>::update( const std::vector<Point<T,3>>& p, const std::vector<Vector<int,3>>& tri,
+                       const std::vector<Point<T,2>>& par ) {
+
+    bool same = !_nodes.empty() && tri.size() == _tri.size() && p.size() == _p.size();
+    for( unsigned int i = 0; same && i < tri.size(); i++ )
+      same = tri[i][0] == _tri[i][0] && tri[i][1] == _tri[i][1] && tri[i][2] == _tri[i][2];
+
+    if( same ) refit( p, par );
+    else       build( p, tri, par );
+    return !same;
+  }
+
+
+  template <typename T>
+  inline
+  Box<T,3> Bvh<T>::getBox() const {
+
+    return _nodes.empty() ? Box<T,3>() : _nodes[0].box;
+  }
+
+
+  template <typename T>
+  inline
+  int Bvh<T>::getNoNodes() const {
+
+    return int(_nodes.size());
+  }
+
+
+  template <typename T>
+  inline
+  int Bvh<T>::getNoTriangles() const {
+
+    return int(_tri.size());
+  }
+
+
+  /*! Point<T,2> Bvh<T>::getParameters( int i, T b1, T b2 ) const
+   *  \param[in] i   The triangle
+   *  \param[in] b1  Barycentric coordinate of the second vertex
+   *  \param[in] b2  Barycentric coordinate of the third vertex
+   *  \return The parameters interpolated over the triangle
+   */
+  template <typename T>
+  inline
+  Point<T,2> Bvh<T>::getParameters( int i, T b1, T b2 ) const {
+
+    const Point<T,2>& a = _par[_tri[i][0]];
+    const Point<T,2>& b = _par[_tri[i][1]];
+    const Point<T,2>& c = _par[_tri[i][2]];
+    const T           b0 = T(1) - b1 - b2;
+    return Point<T,2>( b0*a[0] + b1*b[0] + b2*c[0], b0*a[1] + b1*b[1] + b2*c[1] );
+  }
+
+
+  template <typename T>
+  inline
+  const Vector<int,3>& Bvh<T>::getTriangle( int i ) const {
+
+    return _tri[i];
+  }
+
+
+  template <typename T>
+  inline
+  bool Bvh<T>::isEmpty() const {
+
+    return _nodes.empty();
+  }
+
+
+  /*! bool Bvh<T>::findNearest( const Point<T,3>& q, Hit& hit, T max_dist ) const
+   *  The point on the mesh nearest to q. The fields triangle, dist, pos and par of hit are set.
+   *
+   *  \param[in]  q         The query point
+   *  \param[out] hit       The nearest point
+   *  \param[in]  max_dist  (default max) Only points closer than this are found
+   *  \return True if a point was found
+   */
+  template <typename T>
+  bool Bvh<T>::findNearest( const Point<T,3>& q, Hit& hit, T max_dist ) const {
+
+    hit.triangle = -1;
+    if( _nodes.empty() ) return false;
+
+    T best = max_dist < std::sqrt( std::numeric_limits<T>::max() ) ? max_dist * max_dist : std::numeric_limits<T>::max();
+
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while( top > 0 ) {
+
+      const int   ni   = stack[--top];
+      const Node& node = _nodes[ni];
+      if( _boxDist2( node.box, q ) >= best ) continue;
+
+      if( node.count > 0 ) {
+        for( int k = node.first; k < node.first + node.count; k++ ) {
+          const int            i  = _order[k];
+          T                    b1, b2;
+          const Point<T,3>     x  = _closestOnTriangle( q, _p[_tri[i][0]], _p[_tri[i][1]], _p[_tri[i][2]], b1, b2 );
+          const Vector<T,3>    w  = q - x;
+          const T              d2 = w * w;
+          if( d2 < best ) {
+            best         = d2;
+            hit.triangle = i;
+            hit.pos      = x;
+            hit.par      = getParameters( i, b1, b2 );
+          }
+        }
+      }
+      else {
+        const int l  = ni + 1;
+        const int r  = node.first;
+        const T   dl = _boxDist2( _nodes[l].box, q );
+        const T   dr = _boxDist2( _nodes[r].box, q );
+        // The nearest child is visited first
+        if( dl < dr ) { stack[top++] = r; stack[top++] = l; }
+        else          { stack[top++] = l; stack[top++] = r; }
+      }
+    }
+
+    if( hit.triangle < 0 ) return false;
+    hit.dist = std::sqrt( best );
+    return true;
+  }
+
+
+  /*! int Bvh<T>::findOverlapping( const Box<T,3>& b, std::vector<int>& tri ) const
+   *  The triangles with a bounding box overlapping a box.
+   *
+   *  \param[in]  b    The box
+   *  \param[out] tri  The triangles found are appended to tri
+   *  \return The number of triangles found
+   */
+  template <typename T>
+  int Bvh<T>::findOverlapping( const Box<T,3>& b, std::vector<int>& tri ) const {
+
+    if( _nodes.empty() ) return 0;
+
+    const size_t size = tri.size();
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while( top > 0 ) {
+
+      const int   ni   = stack[--top];
+      const Node& node = _nodes[ni];
+      if( !node.box.isIntersecting( b ) ) continue;
+
+      if( node.count > 0 ) {
+        for( int k = node.first; k < node.first + node.count; k++ )
+          if( _triBox( _order[k] ).isIntersecting( b ) )
+            tri.push_back( _order[k] );
+      }
+      else {
+        stack[top++] = node.first;
+        stack[top++] = ni + 1;
+      }
+    }
+    return int(tri.size() - size);
+  }
+
+
+  /*! bool Bvh<T>::intersect( const Point<T,3>& o, const Vector<T,3>& d, Hit& hit, T t_max ) const
+   *  The first intersection of the ray o + t*d, 0 <= t < t_max, with the mesh.
+   *  The fields triangle, t, pos and par of hit are set.
+   *
+   *  \param[in]  o      The origin of the ray
+   *  \param[in]  d      The direction of the ray (not necessarily normalized)
+   *  \param[out] hit    The first intersection
+   *  \param[in]  t_max  (default max) The end of the ray
+   *  \return True if the ray hits the mesh
+   */
+  template <typename T>
+  bool Bvh<T>::intersect( const Point<T,3>& o, const Vector<T,3>& d, Hit& hit, T t_max ) const {
+
+    hit.triangle = -1;
+    if( _nodes.empty() ) return false;
+
+    const Vector<T,3> inv_d( T(1)/d[0], T(1)/d[1], T(1)/d[2] );
+    T best = t_max;
+    T hb1  = T(0), hb2 = T(0);
+    T t0;
+
+    int stack[64];
+    int top = 0;
+    if( _rayBox( _nodes[0].box, o, inv_d, best, t0 ) ) stack[top++] = 0;
+    while( top > 0 ) {
+
+      const int   ni   = stack[--top];
+      const Node& node = _nodes[ni];
+      if( !_rayBox( node.box, o, inv_d, best, t0 ) ) continue;
+
+      if( node.count > 0 ) {
+        for( int k = node.first; k < node.first + node.count; k++ ) {
+
+          // Moller-Trumbore
+          const int         i   = _order[k];
+          const Point<T,3>& a   = _p[_tri[i][0]];
+          const Vector<T,3> e1  = _p[_tri[i][1]] - a;
+          const Vector<T,3> e2  = _p[_tri[i][2]] - a;
+          const Vector<T,3> pv  = d ^ e2;
+          const T           det = e1 * pv;
+          if( det == T(0) ) continue;
+
+          const T           inv = T(1) / det;
+          const Vector<T,3> tv  = o - a;
+          const T           b1  = (tv * pv) * inv;
+          if( b1 < T(0) || b1 > T(1) ) continue;
+
+          const Vector<T,3> qv  = tv ^ e1;
+          const T           b2  = (d * qv) * inv;
+          if( b2 < T(0) || b1 + b2 > T(1) ) continue;
+
+          const T           t   = (e2 * qv) * inv;
+          if( t >= T(0) && t < best ) {
+            best         = t;
+            hit.triangle = i;
+            hb1          = b1;
+            hb2          = b2;
+          }
+        }
+      }
+      else {
+        const int l = ni + 1;
+        const int r = node.first;
+        T tl, tr;
+        const bool hl = _rayBox( _nodes[l].box, o, inv_d, best, tl );
+        const bool hr = _rayBox( _nodes[r].box, o, inv_d, best, tr );
+        // The nearest child is visited first
+        if( hl && hr ) {
+          if( tl < tr ) { stack[top++] = r; stack[top++] = l; }
+          else          { stack[top++] = l; stack[top++] = r; }
+        }
+        else if( hl ) stack[top++] = l;
+        else if( hr ) stack[top++] = r;
+      }
+    }
+
+    if( hit.triangle < 0 ) return false;
+    hit.t   = best;
+    hit.pos = o + best * d;
+    hit.par = getParameters( hit.triangle, hb1, hb2 );
+    return true;
+  }
+
+
+  template <typename T>
+  inline
+  Box<T,3> Bvh<T>::_triBox( int i ) const {
+
+    return Box<T,3>( _p[_tri[i][0]], _p[_tri[i][1]], _p[_tri[i][2]] );
+  }
+
+
+  /*! int Bvh<T>::_build( const std::vector<Box<T,3>>& box, const std::vector<Point<T,3>>& c, int b, int e, int depth )
+   *  Private, builds the subtree of the triangles _order[b..e), and returns the index of its root.
+   *  The range is split where the surface area heuristic, evaluated at the borders of 16 bins
+   *  along each axis, is the lowest.
+   */
+  template <typename T>
+  int Bvh<T>::_build( const std::vector<Box<T,3>>& box, const std::vector<Point<T,3>>& c, int b, int e, int depth ) {
+
+    const int no_bins  = 16;
+    const int max_leaf = 8;
+
+    const int ni = int(_nodes.size());
+    _nodes.push_back( Node() );
+
+    Box<T,3> nb( box[_order[b]] );
+    Box<T,3> cb( c[_order[b]] );
+    for( int k = b+1; k < e; k++ ) {
+      nb.insert( box[_order[k]] );
+      cb.insert( c[_order[k]] );
+    }
+    _setBox( _nodes[ni].box, nb );
+    _nodes[ni].first = b;
+    _nodes[ni].count = e - b;
+
+    // Max depth is bounded by the size of the query stacks
+    if( e - b <= 2 || depth >= 60 ) return ni;
+
+    // Binned surface area heuristic
+    T   best_cost = std::numeric_limits<T>::max();
+    int best_axis = -1;
+    int best_bin  = 0;
+    for( int a = 0; a < 3; a++ ) {
+
+      const T cmin = cb.getValueMin(a);
+      const T ext  = cb.getValueDelta(a);
+      if( !(ext > T(0)) ) continue;
+
+      Box<T,3> bins[no_bins];
+      int      cnt[no_bins] = {};
+      for( int k = b; k < e; k++ ) {
+        const int i   = _order[k];
+        const int bin = std::min( no_bins-1, int( no_bins * (c[i][a] - cmin) / ext ) );
+        if( cnt[bin]++ == 0 ) _setBox( bins[bin], box[i] );
+        else                  bins[bin].insert( box[i] );
+      }
+
+      // Area and count to the right of each border
+      T        right_cost[no_bins];
+      Box<T,3> acc;
+      int      acc_cnt = 0;
+      for( int j = no_bins-1; j > 0; j-- ) {
+        if( cnt[j] ) { if( acc_cnt ) acc.insert( bins[j] ); else _setBox( acc, bins[j] ); acc_cnt += cnt[j]; }
+        right_cost[j] = acc_cnt ? _area( acc ) * acc_cnt : T(0);
+      }
+
+      acc_cnt = 0;
+      for( int j = 0; j < no_bins-1; j++ ) {
+        if( cnt[j] ) { if( acc_cnt ) acc.insert( bins[j] ); else _setBox( acc, bins[j] ); acc_cnt += cnt[j]; }
+        if( acc_cnt == 0 || acc_cnt == e - b ) continue;
+        const T cost = _area( acc ) * acc_cnt + right_cost[j+1];
+        if( cost < best_cost ) {
+          best_cost = cost;
+          best_axis = a;
+          best_bin  = j;
+        }
+      }
+    }
+
+    // Traversal cost relative to a triangle test is 1
+    const T node_area = _area( nb );
+    if( best_axis < 0 ) {
+      if( e - b <= max_leaf ) return ni;
+    }
+    else if( e - b <= max_leaf && T(e - b) * node_area <= node_area + best_cost )
+      return ni;
+
+    int mid;
+    if( best_axis >= 0 ) {
+      const T cmin = cb.getValueMin(best_axis);
+      const T ext  = cb.getValueDelta(best_axis);
+      mid = int( std::partition( _order.begin() + b, _order.begin() + e, [&]( int i ) {
+        return std::min( no_bins-1, int( no_bins * (c[i][best_axis] - cmin) / ext ) ) <= best_bin;
+      } ) - _order.begin() );
+    }
+    else
+      mid = (b + e) / 2;
+
+    _build( box, c, b, mid, depth+1 );
+    const int r = _build( box, c, mid, e, depth+1 );
+    _nodes[ni].first = r;
+    _nodes[ni].count = 0;
+    return ni;
+  }
+
+
+  /*! void Bvh<T>::_refit()
+   *  Private, the children are stored after the parent, so the boxes are updated in reverse order.
+   */
+  template <typename T>
+  void Bvh<T>::_refit() {
+
+    for( int ni = int(_nodes.size()) - 1; ni >= 0; ni-- ) {
+
+      Node& node = _nodes[ni];
+      if( node.count > 0 ) {
+        _setBox( node.box, _triBox( _order[node.first] ) );
+        for( int k = node.first + 1; k < node.first + node.count; k++ )
+          node.box.insert( _triBox( _order[k] ) );
+      }
+      else {
+        _setBox( node.box, _nodes[ni+1].box );
+        node.box.insert( _nodes[node.first].box );
+      }
+    }
+  }
+
+
+  template <typename T>
+  inline
+  T Bvh<T>::_area( const Box<T,3>& b ) {
+
+    const Vector<T,3> d = b.getPointDelta();
+    return T(2) * ( d[0]*d[1] + d[1]*d[2] + d[2]*d[0] );
+  }
+
+
+  /*! void Bvh<T>::_setBox( Box<T,3>& b, const Box<T,3>& from )
+   *  Private, sets b equal to from (Box has no copy assignment).
+   */
+  template <typename T>
+  inline
+  void Bvh<T>::_setBox( Box<T,3>& b, const Box<T,3>& from ) {
+
+    b.reset( from.getPointMin() );
+    b.insert( from.getPointMax() );
+  }
+
+
+  template <typename T>
+  inline
+  T Bvh<T>::_boxDist2( const Box<T,3>& b, const Point<T,3>& q ) {
+
+    T d2 = T(0);
+    for( int a = 0; a < 3; a++ ) {
+      const T d = std::max( T(0), std::max( b.getValueMin(a) - q[a], q[a] - b.getValueMax(a) ) );
+      d2 += d*d;
+    }
+    return d2;
+  }
+
+
+  /*! bool Bvh<T>::_rayBox( const Box<T,3>& b, const Point<T,3>& o, const Vector<T,3>& inv_d, T t_max, T& t_min )
+   *  Private, slab test. t_min is set to where the ray enters the box.
+   */
+  template <typename T>
+  inline
+  bool Bvh<T>::_rayBox( const Box<T,3>& b, const Point<T,3>& o, const Vector<T,3>& inv_d, T t_max, T& t_min ) {
+
+    T t0 = T(0), t1 = t_max;
+    for( int a = 0; a < 3; a++ ) {
+      T tn = (b.getValueMin(a) - o[a]) * inv_d[a];
+      T tf = (b.getValueMax(a) - o[a]) * inv_d[a];
+      if( tn > tf ) std::swap( tn, tf );
+      // NaN (the origin on a slab of a direction parallel to it) does not cull the box
+      if( tn > t0 ) t0 = tn;
+      if( tf < t1 ) t1 = tf;
+      if( t0 > t1 ) return false;
+    }
+    t_min = t0;
+    return true;
+  }
+
+
+  /*! Point<T,3> Bvh<T>::_closestOnTriangle( const Point<T,3>& q, const Point<T,3>& a, const Point<T,3>& b,
+   *                                          const Point<T,3>& c, T& b1, T& b2 )
+   *  Private, the point a + b1*(b-a) + b2*(c-a) on the triangle nearest to q,
+   *  by the Voronoi regions of the vertices and the edges.
+   */
+  template <typename T>
+  Point<T,3> Bvh<T>::_closestOnTriangle( const Point<T,3>& q, const Point<T,3>& a, const Point<T,3>& b,
+                                         const Point<T,3>& c, T& b1, T& b2 ) {
+
+    const Vector<T,3> ab = b - a;
+    const Vector<T,3> ac = c - a;
+    const Vector<T,3> ap = q - a;
+    const T d1 = ab * ap;
+    const T d2 = ac * ap;
+    if( d1 <= T(0) && d2 <= T(0) ) { b1 = b2 = T(0); return a; }
+
+    const Vector<T,3> bp = q - b;
+    const T d3 = ab * bp;
+    const T d4 = ac * bp;
+    if( d3 >= T(0) && d4 <= d3 ) { b1 = T(1); b2 = T(0); return b; }
+
+    const T vc = d1*d4 - d3*d2;
+    if( vc <= T(0) && d1 >= T(0) && d3 <= T(0) ) {
+      b1 = d1 / (d1 - d3);
+      b2 = T(0);
+      return a + b1 * ab;
+    }
+
+    const Vector<T,3> cp = q - c;
+    const T d5 = ab * cp;
+    const T d6 = ac * cp;
+    if( d6 >= T(0) && d5 <= d6 ) { b1 = T(0); b2 = T(1); return c; }
+
+    const T vb = d5*d2 - d1*d6;
+    if( vb <= T(0) && d2 >= T(0) && d6 <= T(0) ) {
+      b1 = T(0);
+      b2 = d2 / (d2 - d6);
+      return a + b2 * ac;
+    }
+
+    const T va = d3*d6 - d5*d4;
+    if( va <= T(0) && (d4 - d3) >= T(0) && (d5 - d6) >= T(0) ) {
+      b2 = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+      b1 = T(1) - b2;
+      return b + b2 * (c - b);
+    }
+
+    const T denom = T(1) / (va + vb + vc);
+    b1 = vb * denom;
+    b2 = vc * denom;
+    return a + b1 * ab + b2 * ac;
+  }
+
+} // END namespace GMlib
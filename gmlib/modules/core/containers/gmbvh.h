@@ -0,0 +1,118 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+
+
+#ifndef GM_CORE_CONTAINERS_BVH_H
+#define GM_CORE_CONTAINERS_BVH_H
+
+
+// gmlib
+#include "../types/gmpoint.h"
+
+// stl
+#include <limits>
+#include <vector>
+
+namespace GMlib{
+
+
+  /*! \class Bvh gmbvh.h <gmbvh>
+   *  \brief A bounding volume hierarchy over a triangle mesh, for ray, nearest point and box queries
+   *
+   *  The hierarchy is built with the surface area heuristic (binned) and stored as a flat
+   *  array of nodes in depth first order. Each vertex carries a parameter pair, and the
+   *  queries return the parameters of the hit interpolated over the triangle.
+   *  When only the vertices have moved the hierarchy can be refitted instead of rebuilt.
+   *  The queries are const and can be run from several threads at the same time.
+   */
+  template <typename T>
+  class Bvh {
+  public:
+    struct Hit {
+      int                 triangle;   //!< Index of the triangle hit, -1 if none
+      T                   t;          //!< Ray parameter of the hit (ray queries)
+      T                   dist;       //!< Distance to the query point (nearest point queries)
+      Point<T,3>          pos;        //!< The point hit
+      Point<T,2>          par;        //!< The parameters of the point hit
+    };
+
+    Bvh();
+
+    void                  build( const std::vector<Point<T,3>>& p, const std::vector<Vector<int,3>>& tri,
+                                 const std::vector<Point<T,2>>& par );
+    void                  clear();
+    void                  refit( const std::vector<Point<T,3>>& p );
+    void                  refit( const std::vector<Point<T,3>>& p, const std::vector<Point<T,2>>& par );
+    bool                  update( const std::vector<Point<T,3>>& p, const std::vector<Vector<int,3>>& tri,
+                                  const std::vector<Point<T,2>>& par );
+
+    Box<T,3>              getBox() const;
+    int                   getNoNodes() const;
+    int                   getNoTriangles() const;
+    Point<T,2>            getParameters( int i, T b1, T b2 ) const;
+    const Vector<int,3>&  getTriangle( int i ) const;
+    bool                  isEmpty() const;
+
+    bool                  findNearest( const Point<T,3>& q, Hit& hit, T max_dist = std::numeric_limits<T>::max() ) const;
+    int                   findOverlapping( const Box<T,3>& b, std::vector<int>& tri ) const;
+    bool                  intersect( const Point<T,3>& o, const Vector<T,3>& d, Hit& hit,
+                                     T t_max = std::numeric_limits<T>::max() ) const;
+
+  private:
+    struct Node {
+      Box<T,3>                  box;
+      int                       first;  // Leaf: first index into _order, inner node: index of the right child
+      int                       count;  // Leaf: number of triangles, inner node: 0 (the left child is the next node)
+    };
+
+    std::vector<Node>           _nodes;
+    std::vector<int>            _order;   // Triangle indices in leaf order
+    std::vector<Point<T,3>>     _p;
+    std::vector<Vector<int,3>>  _tri;
+    std::vector<Point<T,2>>     _par;
+
+    Box<T,3>                    _triBox( int i ) const;
+    int                         _build( const std::vector<Box<T,3>>& box, const std::vector<Point<T,3>>& c,
+                                        int b, int e, int depth );
+    void                        _refit();
+
+    static T                    _area( const Box<T,3>& b );
+    static T                    _boxDist2( const Box<T,3>& b, const Point<T,3>& q );
+    static void                 _setBox( Box<T,3>& b, const Box<T,3>& from );
+    static bool                 _rayBox( const Box<T,3>& b, const Point<T,3>& o, const Vector<T,3>& inv_d,
+                                         T t_max, T& t_min );
+    static Point<T,3>           _closestOnTriangle( const Point<T,3>& q, const Point<T,3>& a, const Point<T,3>& b,
+                                                    const Point<T,3>& c, T& b1, T& b2 );
+
+  }; // END Bvh class
+
+} // END namespace GMlib
+
+
+// Include Bvh class function implementations
+#include "gmbvh.c"
+
+
+#endif // GM_CORE_CONTAINERS_BVH_H
@@ -147,7 +147,7 @@ namespace GMlib{
   template <typename T, typename G>
   inline
   const DVector<T>&  operator*(const DMatrix<G>& m, const DVector<T>& b) {
-    static DVector<T> r;
+    static thread_local DVector<T> r;
 
     if(m.getDim2() != b.getDim()) return r;
     r.setDim(m.getDim1());
@@ -165,7 +165,7 @@ namespace GMlib{
   template <typename T, typename G>
   inline
   const DMatrix<T>&  operator*(const DMatrix<G>& m, const DMatrix<T>& b) {
-    static DMatrix<T> r;
+    static thread_local DMatrix<T> r;
 
     if(m.getDim2() != b.getDim1()) return r;
     r.setDim(m.getDim1(),b.getDim2());
@@ -184,7 +184,7 @@ namespace GMlib{
   template <typename T, typename G>
   inline
   const DVector<G>&  operator^(const DMatrix<G>& m, const DVector<T>& b) {
-    static DVector<G> r;
+    static thread_local DVector<G> r;
 
     if(m.getDim2() != b.getDim()) return r;
     r.setDim(m.getDim1());
@@ -202,7 +202,7 @@ namespace GMlib{
   template <typename T, typename G>
   inline
   const DMatrix<G>&  operator^(const DMatrix<G>& m, const DMatrix<T>& b) {
-    static DMatrix<G> r;
+    static thread_local DMatrix<G> r;
 
     if(m.getDim2() != b.getDim1()) return r;
     r.setDim(m.getDim1(),b.getDim2());
@@ -0,0 +1,188 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+
+
+
+namespace GMlib {
+
+
+  /*! DSampleGrid<T>::DSampleGrid( int m1, int m2, int d1, int d2 )
+   *  Constructs a m1 x m2 grid with d1/d2 derivatives in each sample.
+   *
+   *  \param[in] m1 The number of samples in u-direction
+   *  \param[in] m2 The number of samples in v-direction
+   *  \param[in] d1 The number of derivatives in u-direction
+   *  \param[in] d2 The number of derivatives in v-direction
+   */
+  template <typename T>
+  inline
+  DSampleGrid<T>::DSampleGrid( int m1, int m2, int d1, int d2 ) {
+
+    _m[0] = _m[1] = 0;
+    _d[0] = _d[1] = 1;
+    setDim( m1, m2, d1, d2 );
+  }
+
+
+  /*! \brief Return the number of samples in u-direction. */
+  template <typename T>
+  inline
+  int DSampleGrid<T>::getDim1() const {
+    return _m[0];
+  }
+
+
+  /*! \brief Return the number of samples in v-direction. */
+  template <typename T>
+  inline
+  int DSampleGrid<T>::getDim2() const {
+    return _m[1];
+  }
+
+
+  /*! \brief Return the number of derivatives in u-direction + 1 (the position). */
+  template <typename T>
+  inline
+  int DSampleGrid<T>::getDerDim1() const {
+    return _d[0];
+  }
+
+
+  /*! \brief Return the number of derivatives in v-direction + 1 (the position). */
+  template <typename T>
+  inline
+  int DSampleGrid<T>::getDerDim2() const {
+    return _d[1];
+  }
+
+
+  /*! \brief Return the number of elements in one plane, m1*m2. */
+  template <typename T>
+  inline
+  int DSampleGrid<T>::getPlaneSize() const {
+    return _m[0]*_m[1];
+  }
+
+
+  /*! void DSampleGrid<T>::setDim( int m1, int m2, int d1, int d2 )
+   *  Set the dimension of the grid. The content is undefined after a change of dimension.
+   *  Memory is only allocated if the grid grows.
+   *
+   *  \param[in] m1 The number of samples in u-direction
+   *  \param[in] m2 The number of samples in v-direction
+   *  \param[in] d1 The number of derivatives in u-direction
+   *  \param[in] d2 The number of derivatives in v-direction
+   */
+  template <typename T>
+  inline
+  void DSampleGrid<T>::setDim( int m1, int m2, int d1, int d2 ) {
+
+    _m[0] = m1;
+    _m[1] = m2;
+    _d[0] = d1+1;
+    _d[1] = d2+1;
+    const size_t size = size_t(m1)*size_t(m2)*size_t(_d[0]*_d[1]);
+    if( _data.size() < size ) _data.resize(size);
+  }
+
+
+  /*! \brief Return a pointer to the m1*m2 values of derivative (k,l), (0,0) is the positions. */
+  template <typename T>
+  inline
+  T* DSampleGrid<T>::getPlane( int k, int l ) {
+    return _data.data() + (k*_d[1]+l) * getPlaneSize();
+  }
+
+
+  /*! \brief Return a pointer to the m1*m2 values of derivative (k,l), (0,0) is the positions. */
+  template <typename T>
+  inline
+  const T* DSampleGrid<T>::getPlane( int k, int l ) const {
+    return _data.data() + (k*_d[1]+l) * getPlaneSize();
+  }
+
+
+  /*! void DSampleGrid<T>::getSample( DMatrix<T>& s, int i, int j ) const
+   *  Copy the position and derivatives of sample (i,j) into a matrix.
+   *
+   *  \param[out] s The (d1+1) x (d2+1) matrix of the sample
+   *  \param[in]  i The sample index in u-direction
+   *  \param[in]  j The sample index in v-direction
+   */
+  template <typename T>
+  inline
+  void DSampleGrid<T>::getSample( DMatrix<T>& s, int i, int j ) const {
+
+    s.setDim( _d[0], _d[1] );
+    for( int k = 0; k < _d[0]; k++ )
+      for( int l = 0; l < _d[1]; l++ )
+        s[k][l] = (*this)(i,j,k,l);
+  }
+
+
+  /*! void DSampleGrid<T>::setSample( const DMatrix<T>& s, int i, int j )
+   *  Copy a matrix of position and derivatives into sample (i,j).
+   *  Only the overlapping part of the matrix and the sample is copied.
+   *
+   *  \param[in] s The matrix of the sample
+   *  \param[in] i The sample index in u-direction
+   *  \param[in] j The sample index in v-direction
+   */
+  template <typename T>
+  inline
+  void DSampleGrid<T>::setSample( const DMatrix<T>& s, int i, int j ) {
+
+    const int d1 = std::min( _d[0], s.getDim1() );
+    const int d2 = std::min( _d[1], s.getDim2() );
+    for( int k = 0; k < d1; k++ )
+      for( int l = 0; l < d2; l++ )
+        (*this)(i,j,k,l) = s(k)(l);
+  }
+
+
+  /*! \brief Return derivative (k,l) of sample (i,j), (0,0) is the position. */
+  template <typename T>
+  inline
+  T& DSampleGrid<T>::operator () ( int i, int j, int k, int l ) {
+  #ifdef DEBUG
+    if( i<0 || i>=_m[0] || j<0 || j>=_m[1] || k<0 || k>=_d[0] || l<0 || l>=_d[1] )
+      std::cerr << "Error index (" << i << "," << j << "," << k << "," << l << ") is outside the sample grid\n";
+  #endif
+    return getPlane(k,l)[i*_m[1]+j];
+  }
+
+
+  /*! \brief Return derivative (k,l) of sample (i,j), (0,0) is the position. */
+  template <typename T>
+  inline
+  const T& DSampleGrid<T>::operator () ( int i, int j, int k, int l ) const {
+  #ifdef DEBUG
+    if( i<0 || i>=_m[0] || j<0 || j>=_m[1] || k<0 || k>=_d[0] || l<0 || l>=_d[1] )
+      std::cerr << "Error index (" << i << "," << j << "," << k << "," << l << ") is outside the sample grid\n";
+  #endif
+    return getPlane(k,l)[i*_m[1]+j];
+  }
+
+} // END namespace GMlib
@@ -0,0 +1,88 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+
+
+#ifndef GM_CORE_CONTAINERS_DSAMPLEGRID_H
+#define GM_CORE_CONTAINERS_DSAMPLEGRID_H
+
+
+// gmlib
+#include "gmdmatrix.h"
+
+// stl
+#include <algorithm>
+#include <vector>
+
+namespace GMlib{
+
+
+  /*! \class DSampleGrid gmdsamplegrid.h <gmdsamplegrid>
+   *  \brief A contiguous m1 x m2 grid of samples with (d1+1) x (d2+1) derivatives in each sample
+   *
+   *  The samples are stored as a structure of arrays: one plane of m1*m2 elements
+   *  for the positions, and one plane for each of the derivatives.
+   *  The planes are stored row by row (u-direction first), so element (i,j) of
+   *  plane (k,l) is found at getPlane(k,l)[i*getDim2()+j].
+   *
+   *  Changing the dimension does not release memory, so resampling into the same grid
+   *  does not allocate memory as long as the grid does not grow.
+   */
+  template <typename T>
+  class DSampleGrid {
+  public:
+    DSampleGrid( int m1 = 0, int m2 = 0, int d1 = 0, int d2 = 0 );
+
+    int                 getDim1() const;
+    int                 getDim2() const;
+    int                 getDerDim1() const;
+    int                 getDerDim2() const;
+    int                 getPlaneSize() const;
+    void                setDim( int m1, int m2, int d1, int d2 );
+
+    T*                  getPlane( int k, int l );
+    const T*            getPlane( int k, int l ) const;
+
+    void                getSample( DMatrix<T>& s, int i, int j ) const;
+    void                setSample( const DMatrix<T>& s, int i, int j );
+
+    T&                  operator () ( int i, int j, int k = 0, int l = 0 );
+    const T&            operator () ( int i, int j, int k = 0, int l = 0 ) const;
+
+  private:
+    int                 _m[2];      // Number of samples in u and v direction
+    int                 _d[2];      // Number of derivatives (+1) in u and v direction
+    std::vector<T>      _data;      // The planes, one after the other
+
+  }; // END DSampleGrid class
+
+
+} // END namespace GMlib
+
+
+// Include DSampleGrid class function implementations
+#include "gmdsamplegrid.c"
+
+
+#endif // GM_CORE_CONTAINERS_DSAMPLEGRID_H
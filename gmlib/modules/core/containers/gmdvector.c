@@ -192,7 +192,7 @@ namespace GMlib {
   template <typename T>
   inline
   const DVector<T>& DVector<T>::getReversed() const {
-    static DVector<T> ret;
+    static thread_local DVector<T> ret;
     ret.setDim(_n);
     for(int i=0; i<_n; i++)
       ret[i] = _p[_n-1-i];
@@ -203,7 +203,7 @@ namespace GMlib {
   template <typename T>
   inline
   const DVector<T>& DVector<T>::getSubVector(int start, int end) const {
-    static DVector<T> ret;
+    static thread_local DVector<T> ret;
     if(start < 0)	start = 0;
     if(end > _n)		end = _n;
     if(start < end)
@@ -222,7 +222,7 @@ namespace GMlib {
   template <typename T>
   inline
   const T& DVector<T>::getSum() const {
-    static T ret;
+    static thread_local T ret;
     ret = T(0);
     for(int i=0; i<_n; i++) ret += _p[i];
     return ret;
@@ -232,7 +232,7 @@ namespace GMlib {
   template <typename T>
   inline
   const T& DVector<T>::getSum(int start, int end) const {
-    static T ret;
+    static thread_local T ret;
     if(start < 0)	start = 0;
     if(end   > _n)	end = _n;
     ret = T(0);
@@ -0,0 +1,157 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+// stl
+#include <algorithm>
+#include <limits>
+
+
+
+namespace GMlib {
+
+
+  template <typename T, int n>
+  inline
+  KdTree<T,n>::KdTree() {}
+
+
+  template <typename T, int n>
+  inline
+  KdTree<T,n>::KdTree( const Point<T,n>* p, int m ) {
+
+    build( p, m );
+  }
+
+
+  /*! void KdTree<T,n>::build( const Point<T,n>* p, int m )
+   *  Builds the tree over m points, the points are copied.
+   *
+   *  \param[in] p  The points
+   *  \param[in] m  The number of points
+   */
+  template <typename T, int n>
+  void KdTree<T,n>::build( const Point<T,n>* p, int m ) {
+
+    _idx.resize( m );
+    for( int i = 0; i < m; i++ ) _idx[i] = i;
+    _axis.assign( m, 0 );
+    _build( p, 0, m );
+
+    // The points in tree order
+    _p.resize( m );
+    for( int i = 0; i < m; i++ ) _p[i] = p[_idx[i]];
+  }
+
+
+  template <typename T, int n>
+  inline
+  int KdTree<T,n>::getSize() const {
+
+    return int(_p.size());
+  }
+
+
+  /*! int KdTree<T,n>::findNearest( const Point<T,n>& q ) const
+   *  \param[in] q  The query point
+   *  \return The index (in the input to build()) of the point nearest to q, -1 if the tree is empty
+   */
+  template <typename T, int n>
+  inline
+  int KdTree<T,n>::findNearest( const Point<T,n>& q ) const {
+
+    T dist2;
+    return findNearest( q, dist2 );
+  }
+
+
+  /*! int KdTree<T,n>::findNearest( const Point<T,n>& q, T& dist2 ) const
+   *  \param[in]  q      The query point
+   *  \param[out] dist2  The squared distance to the nearest point
+   *  \return The index (in the input to build()) of the point nearest to q, -1 if the tree is empty
+   */
+  template <typename T, int n>
+  int KdTree<T,n>::findNearest( const Point<T,n>& q, T& dist2 ) const {
+
+    int best = -1;
+    dist2 = std::numeric_limits<T>::max();
+    _nearest( 0, int(_p.size()), q, best, dist2 );
+    return best < 0 ? -1 : _idx[best];
+  }
+
+
+  template <typename T, int n>
+  void KdTree<T,n>::_build( const Point<T,n>* p, int b, int e ) {
+
+    if( e - b < 2 ) return;
+
+    // Split along the axis of the largest extent
+    Point<T,n> lo = p[_idx[b]], hi = p[_idx[b]];
+    for( int i = b+1; i < e; i++ )
+      for( int k = 0; k < n; k++ ) {
+        lo[k] = std::min( lo[k], p[_idx[i]][k] );
+        hi[k] = std::max( hi[k], p[_idx[i]][k] );
+      }
+    int a = 0;
+    for( int k = 1; k < n; k++ )
+      if( hi[k] - lo[k] > hi[a] - lo[a] ) a = k;
+
+    // Median to the middle
+    const int mid = (b + e) / 2;
+    std::nth_element( _idx.begin() + b, _idx.begin() + mid, _idx.begin() + e,
+                      [p,a]( int i, int j ) { return p[i][a] < p[j][a]; } );
+    _axis[mid] = static_cast<signed char>(a);
+
+    _build( p, b, mid );
+    _build( p, mid+1, e );
+  }
+
+
+  template <typename T, int n>
+  void KdTree<T,n>::_nearest( int b, int e, const Point<T,n>& q, int& best, T& dist2 ) const {
+
+    if( b >= e ) return;
+
+    const int mid = (b + e) / 2;
+    const Vector<T,n> d = q - _p[mid];
+    const T d2 = d * d;
+    if( d2 < dist2 ) {
+      dist2 = d2;
+      best  = mid;
+    }
+    if( e - b == 1 ) return;
+
+    // The side of q first, the other side only if it can be closer
+    const T diff = d[_axis[mid]];
+    if( diff < T(0) ) {
+      _nearest( b, mid, q, best, dist2 );
+      if( diff*diff < dist2 ) _nearest( mid+1, e, q, best, dist2 );
+    }
+    else {
+      _nearest( mid+1, e, q, best, dist2 );
+      if( diff*diff < dist2 ) _nearest( b, mid, q, best, dist2 );
+    }
+  }
+
+
+} // END namespace GMlib
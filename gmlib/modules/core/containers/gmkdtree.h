@@ -0,0 +1,77 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+
+
+#ifndef GM_CORE_CONTAINERS_KDTREE_H
+#define GM_CORE_CONTAINERS_KDTREE_H
+
+
+// gmlib
+#include "../types/gmpoint.h"
+
+// stl
+#include <vector>
+
+namespace GMlib{
+
+
+  /*! \class KdTree gmkdtree.h <gmkdtree>
+   *  \brief A static k-d tree over a set of points, for nearest point queries
+   *
+   *  The tree is balanced and stored implicitly: the points are reordered such that
+   *  the median of each range is the splitting point of the range, split along the
+   *  axis of the largest extent. The queries are const and can be run from several
+   *  threads at the same time.
+   */
+  template <typename T, int n>
+  class KdTree {
+  public:
+    KdTree();
+    KdTree( const Point<T,n>* p, int m );
+
+    void                build( const Point<T,n>* p, int m );
+    int                 getSize() const;
+
+    int                 findNearest( const Point<T,n>& q ) const;
+    int                 findNearest( const Point<T,n>& q, T& dist2 ) const;
+
+  private:
+    std::vector<Point<T,n>>   _p;       // The points in tree order
+    std::vector<int>          _idx;     // Index of the points in the input
+    std::vector<signed char>  _axis;    // Splitting axis of the range having this point as median
+
+    void                _build( const Point<T,n>* p, int b, int e );
+    void                _nearest( int b, int e, const Point<T,n>& q, int& best, T& dist2 ) const;
+
+  }; // END KdTree class
+
+} // END namespace GMlib
+
+
+// Include KdTree class function implementations
+#include "gmkdtree.c"
+
+
+#endif // GM_CORE_CONTAINERS_KDTREE_H
@@ -1031,7 +1031,7 @@ namespace GMlib {
   template <typename T, int n>
   inline
   Matrix<T,n,n> const& SqMatrix<T, n>::transposeMult(const Matrix<T,n,n>& m) const {	// Not changing this: a = this->transpose * m
-    static Matrix<T,n,n> r;
+    static thread_local Matrix<T,n,n> r;
     GM_Static_P_<T,n,n>::mc_x(r.getPtr(), this->getPtr(),m.getPtr());
     return r;
   }
@@ -1047,7 +1047,7 @@ namespace GMlib {
   template <typename T, int n>
   inline
   Matrix<T,n,n> const& SqMatrix<T, n>::reverseMult(const Matrix<T,n,n>& m) {		// Changing this ( is a kind of *= operator): *this = m * *this
-    static Matrix<T,n,n> r;
+    static thread_local Matrix<T,n,n> r;
     GM_Static_P2_<T,n,n,n>::mm_x(r.getPtrP(), m.getPtrP(), this->getPtr());
     return *this = r;
   }
@@ -6,9 +6,12 @@
 #include "gmutils.h"
 #include "../containers/gmdvector.h"
 #include "../containers/gmdmatrix.h"
+#include "../containers/gmdsamplegrid.h"
+#include "gmparallel.h"
 
 // stl
 #include <cassert>
+#include <vector>
 
 namespace GMlib {
   namespace DD {
@@ -549,6 +552,228 @@ namespace GMlib {
 
 
 
+    template <typename T>
+    inline
+    void compute2D( DSampleGrid<T>& p, double du, double dv, bool closed_u, bool closed_v,
+                    int d1, int d2, int ed1, int ed2, int no_threads ) {
+
+      assert( ed1 >= 0 );
+      assert( ed2 >= 0 );
+
+
+      double du2 = 2*du;
+      double dv2 = 2*dv;
+      const int m2 = p.getDim2();
+      const int ku = p.getDim1()-1;
+      const int kv = m2-1;
+
+      // The chord/arc relation only depends on the positions,
+      // so it is computed once for each direction.
+      const T* pos = p.getPlane(0,0);
+      std::vector<double> scale( p.getPlaneSize() );
+
+      // The work is split in blocks of rows (u), each row is contiguous in all planes.
+      // Closed ends are computed from the wrapped rows/columns directly, so no block
+      // depends on the result of another block within one pass.
+
+
+      // Compute U derivatives, one plane at a time (a plane needs the neighbour rows of the previous plane)
+
+      for(int i = 1+ed1; i <= ed1+d1; ++i) { // edr in u
+
+        const T* q = p.getPlane(i-1,0);
+        T*       r = p.getPlane(i,0);
+
+        Parallel::forBlocks( 0, ku+1, [&]( int b, int e ) {
+
+          for(int k = b; k < e; ++k) {      // data points u
+
+            double*  sc = &scale[k*m2];
+            T*       rk = &r[k*m2];
+            const T* q0 = &q[k*m2];
+
+            if( k > 0 && k < ku ) {
+
+              const T* qp = &q[(k-1)*m2];
+              const T* qn = &q[(k+1)*m2];
+
+              // The scale is computed together with the first derivative, while the rows are in cache
+              if( i == 1+ed1 )
+                for(int l = 0; l < kv+1; ++l)   // data points v
+                  sc[l] = relationCK(pos[(k-1)*m2+l], pos[k*m2+l], pos[(k+1)*m2+l]);
+
+              // ordinary divided differences
+              for(int l = 0; l < kv+1; ++l)     // data points v
+                rk[l] = sc[l] * (qn[l] - qp[l]) / ( du2);
+            }
+            else if(closed_u) { // biting its own tail, row ku is a copy of row 0
+
+              const T* q1  = &q[m2];
+              const T* qk1 = &q[(ku-1)*m2];
+
+              if( i == 1+ed1 && k == 0 )
+                for(int l = 0; l < kv+1; ++l)
+                  sc[l] = relationCK(pos[(ku-1)*m2+l], pos[l], pos[m2+l]);
+
+              // Row ku uses the scale of row 0, it is computed here if row 0 is in another block
+              for(int l = 0; l < kv+1; ++l) {
+                const double s0 = k == 0 || i > 1+ed1 ? scale[l] : relationCK(pos[(ku-1)*m2+l], pos[l], pos[m2+l]);
+                rk[l] = s0 * (q1[l] - qk1[l]) / du2;
+              }
+            }
+            else if( k == 0 ) { // second degree endpoints divided differences
+
+              const T* q1 = &q[m2];
+              const T* q2 = &q[2*m2];
+
+              if( i == 1+ed1 )
+                for(int l = 0; l < kv+1; ++l)
+                  sc[l] = relationCK(pos[l], pos[m2+l], pos[2*m2+l]);
+
+              for(int l = 0; l < kv+1; ++l)
+                rk[l] = sc[l] * ( 4*q1[l] - 3*q0[l] - q2[l] ) / du2;
+            }
+            else {
+
+              const T* qk1 = &q[(ku-1)*m2];
+              const T* qk2 = &q[(ku-2)*m2];
+
+              if( i == 1+ed1 )
+                for(int l = 0; l < kv+1; ++l)
+                  sc[l] = relationCK(pos[(ku-2)*m2+l], pos[(ku-1)*m2+l], pos[ku*m2+l]);
+
+              for(int l = 0; l < kv+1; ++l)
+                rk[l] = sc[l] * (-4*qk1[l] + 3*q0[l] + qk2[l] ) / du2;
+            }
+          }
+        }, no_threads );
+      }
+
+
+      // Compute ALL V derivatives, the rows are independent so all planes are done row by row
+
+      if( d2 > 0 ) {
+
+        Parallel::forBlocks( 0, ku+1, [&]( int b, int e ) {
+
+          for(int k = b; k < e; ++k) {    // data points u
+
+            double*  sc = &scale[k*m2];
+            const T* pk = &pos[k*m2];
+
+            for(int l = 1; l < kv; ++l)     // data points v
+              sc[l] = relationCK(pk[l-1], pk[l], pk[l+1]);
+
+            if(closed_v)
+              sc[0] = relationCK(pk[kv-1], pk[0], pk[1]);
+            else {
+              sc[0]  = relationCK(pk[0], pk[1], pk[2]);
+              sc[kv] = relationCK(pk[kv-2], pk[kv-1], pk[kv]);
+            }
+
+            for( int i = 0; i <= ed1+d1; ++i ) {
+              for(int j = 1+ed2; j <= ed2+d2; ++j) { // edr in u
+
+                const T* q = p.getPlane(i,j-1) + k*m2;
+                T*       r = p.getPlane(i,j)   + k*m2;
+
+                // ordinary divided differences
+                for(int l = 1; l < kv; ++l)   // data points v
+                  r[l] = sc[l] * (q[l+1] - q[l-1]) / (  dv2 );
+
+                if(closed_v) { // biting its own tail
+                  r[0]  = sc[0] * (q[1] - q[kv-1]) / dv2;
+                  r[kv] = r[0];
+                }
+                else { // second degree endpoints divided differences
+                  r[0]  = sc[0]  * ( 4*q[1] - 3*q[0] - q[2] ) / dv2;
+                  r[kv] = sc[kv] * (-4*q[kv-1] + 3*q[kv] + q[kv-2] ) / dv2;
+                }
+              }
+            }
+          }
+        }, no_threads );
+      }
+    }
+
+
+
+
+
+
+    template <typename T, typename G>
+    inline
+    void compute2D( DSampleGrid<T>& p, const G& u, const G& v, bool closed_u, bool closed_v,
+                    int d1, int d2, int ed1, int ed2 ) {
+
+      assert( ed1 >= 0 );
+      assert( ed2 >= 0 );
+
+      const int m2 = p.getDim2();
+      const int ku = p.getDim1()-1;
+      const int kv = m2-1;
+
+      std::vector<double[3]> bu(ku+1);
+      std::vector<double[3]> bv(kv+1);
+      Private::computeHelp2<G>( bu, u, closed_u, ku );
+      Private::computeHelp2<G>( bv, v, closed_v, kv );
+
+
+      // Compute U derivatives
+
+      for(int i = 1+ed1; i <= ed1+d1; ++i) { // edr in u
+
+        const T* q = p.getPlane(i-1,0);
+        T*       r = p.getPlane(i,0);
+
+        // ordinary divided differences
+        for(int k = 1; k < ku; ++k)       // data points u
+          for(int l = 0; l < kv+1; ++l)   // data points v
+            r[k*m2+l] = bu[k][0]*q[(k-1)*m2+l] + bu[k][1]*q[k*m2+l] + bu[k][2]*q[(k+1)*m2+l];
+
+        if(closed_u) { // biting its own tail
+          for(int l = 0; l < kv+1; ++l)
+            r[l] = r[ku*m2+l] = bu[0][0]*q[(ku-1)*m2+l] + bu[0][1]*q[l] + bu[0][2]*q[m2+l];
+        }
+        else { // second degree endpoints divided differences
+          for(int l = 0; l < kv+1; ++l) {
+            r[l]       = bu[0][0]*q[l] + bu[0][1]*q[m2+l] + bu[0][2]*q[2*m2+l];
+            r[ku*m2+l] = bu[ku][0]*q[(ku-2)*m2+l] + bu[ku][1]*q[(ku-1)*m2+l] + bu[ku][2]*q[ku*m2+l];
+          }
+        }
+      }
+
+
+      // Compute ALL V derivatives
+
+      for( int i = 0; i <= ed1+d1; ++i ) {
+        for(int j = 1+ed2; j <= ed2+d2; ++j) { // edr in v
+
+          for(int k = 0; k < ku+1; ++k) {   // data points u
+
+            const T* q = p.getPlane(i,j-1) + k*m2;
+            T*       r = p.getPlane(i,j)   + k*m2;
+
+            // ordinary divided differences
+            for(int l = 1; l < kv; ++l)     // data points v
+              r[l] = bv[l][0]*q[l-1] + bv[l][1]*q[l] + bv[l][2]*q[l+1];
+
+            if(closed_v) // biting its own tail
+              r[0] = r[kv] = bv[0][0]*q[kv-1] + bv[0][1]*q[0] + bv[0][2]*q[1];
+            else {       // second degree endpoints divided differences
+              r[0]  = bv[0][0]*q[0] + bv[0][1]*q[1] + bv[0][2]*q[2];
+              r[kv] = bv[kv][0]*q[kv-2] + bv[kv][1]*q[kv-1] + bv[kv][2]*q[kv];
+            }
+          }
+        }
+      }
+    }
+
+
+
+
+
+
     template <typename T, int n>
     void compute( T& p, const Vector<int,n>& sizes, const Vector<double,n>& dt, const Vector<bool,n>& closed, const Vector<int,n>& d, const Vector<int,n>& ed ) {
 
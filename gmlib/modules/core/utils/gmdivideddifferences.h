@@ -26,6 +26,8 @@
 
 // GMlib
 #include "../types/gmpoint.h"
+#include "../containers/gmdsamplegrid.h"
+#include "gmparallel.h"
 
 namespace GMlib {
 
@@ -38,9 +40,28 @@ namespace GMlib {
     void compute2D( T& p, double du, double dv, bool closed_u, bool closed_v, int d1, int d2, int ed1 = 0, int ed2 = 0 );
 
 
+    /*!
+     * Computes the derivatives of a sample grid, as compute2D( T& p, ... ) above,
+     * but working directly on the planes of the grid.
+     * The rows of the grid are split in blocks computed in parallel, the result
+     * does not depend on the number of threads.
+     *
+     * \param[in] no_threads Number of threads, 1 computes on the calling thread, 0 uses all cores
+     */
+    template <typename T>
+    void compute2D( DSampleGrid<T>& p, double du, double dv, bool closed_u, bool closed_v, int d1, int d2, int ed1 = 0, int ed2 = 0, int no_threads = 1 );
+
+
     template <typename T, typename G>
     void compute1D( T& p, const G& t, bool closed, int d, int ed = 0 );
 
+    /*!
+     * Computes the derivatives of a sample grid with non-uniform parameter values,
+     * using the same three point divided differences as compute1D( T& p, const G& t, ... ).
+     */
+    template <typename T, typename G>
+    void compute2D( DSampleGrid<T>& p, const G& u, const G& v, bool closed_u, bool closed_v, int d1, int d2, int ed1 = 0, int ed2 = 0 );
+
     template <typename T, typename G>
     void compute2D( T& p, const G& u, const G& v, bool closed_u, bool closed_v, int d1, int d2, int ed1 = 0, int ed2 = 0 );
 
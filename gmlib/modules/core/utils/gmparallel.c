@@ -0,0 +1,261 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+// stl
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+namespace GMlib {
+
+  namespace Parallel {
+
+
+    inline
+    int getNoThreads( int no_threads ) {
+
+      if( no_threads > 0 )
+        return no_threads;
+
+      const int hw = int(std::thread::hardware_concurrency());
+      return hw > 0 ? hw : 1;
+    }
+
+
+
+    template <typename Func>
+    void forBlocks( int begin, int end, Func f, int no_threads, int block_size ) {
+
+      const int m = end - begin;
+      if( m <= 0 ) return;
+
+      no_threads = std::min( getNoThreads(no_threads), m );
+      if( no_threads == 1 ) {
+        f( begin, end );
+        return;
+      }
+
+      // Some blocks per thread to even out the load
+      if( block_size < 1 )
+        block_size = std::max( 1, m / (4*no_threads) );
+
+      std::atomic<int> next( begin );
+      auto work = [&]() {
+        for( int b = next.fetch_add(block_size); b < end; b = next.fetch_add(block_size) )
+          f( b, std::min( b + block_size, end ) );
+      };
+
+      std::vector<std::thread> threads;
+      threads.reserve( no_threads-1 );
+      for( int i = 1; i < no_threads; i++ )
+        threads.push_back( std::thread( work ) );
+      work();
+      for( auto& th : threads )
+        th.join();
+    }
+
+
+
+    /*! WorkerPool::WorkerPool( int no_threads )
+     *  Starts the worker threads.
+     *
+     *  \param[in] no_threads  Number of threads, 0 uses all cores
+     */
+    inline
+    WorkerPool::WorkerPool( int no_threads ) : _no_running(0), _stop(false) {
+
+      no_threads = Parallel::getNoThreads( no_threads );
+      for( int i = 0; i < no_threads; i++ )
+        _threads.push_back( std::thread( &WorkerPool::_work, this ) );
+    }
+
+
+    inline
+    WorkerPool::~WorkerPool() {
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+        _jobs.clear();
+      }
+      _cv.notify_all();
+      for( auto& th : _threads )
+        th.join();
+    }
+
+
+    inline
+    void WorkerPool::submit( std::function<void()> job ) {
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back( std::move(job) );
+      }
+      _cv.notify_one();
+    }
+
+
+    /*! void WorkerPool::wait()
+     *  Waits until the queue is empty and no job is running.
+     */
+    inline
+    void WorkerPool::wait() {
+
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv_idle.wait( lock, [this]() { return _jobs.empty() && _no_running == 0; } );
+    }
+
+
+    inline
+    int WorkerPool::getNoThreads() const {
+
+      return int(_threads.size());
+    }
+
+
+    /*! WorkerPool& WorkerPool::getDefault()
+     *  The pool used for background work of the library,
+     *  one thread less than the number of cores (at least one).
+     */
+    inline
+    WorkerPool& WorkerPool::getDefault() {
+
+      static WorkerPool pool( std::max( 1, Parallel::getNoThreads() - 1 ) );
+      return pool;
+    }
+
+
+    inline
+    void WorkerPool::_work() {
+
+      std::unique_lock<std::mutex> lock(_mutex);
+      while( true ) {
+
+        _cv.wait( lock, [this]() { return _stop || !_jobs.empty(); } );
+        if( _stop ) return;
+
+        std::function<void()> job = std::move( _jobs.front() );
+        _jobs.pop_front();
+        _no_running++;
+
+        lock.unlock();
+        job();
+        lock.lock();
+
+        _no_running--;
+        if( _jobs.empty() && _no_running == 0 )
+          _cv_idle.notify_all();
+      }
+    }
+
+
+
+    inline
+    AsyncJob::AsyncJob() : _cancelled(false), _state(QUEUED) {}
+
+
+    inline
+    void AsyncJob::cancel() {
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cancelled = true;
+      }
+      _cv.notify_all();
+    }
+
+
+    inline
+    bool AsyncJob::isCancelled() const {
+
+      return _cancelled;
+    }
+
+
+    inline
+    bool AsyncJob::isDone() const {
+
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _state == DONE;
+    }
+
+
+    /*! bool AsyncJob::isStopped() const
+     *  Whether the job is done, or is cancelled before it is started
+     *  (it will then never run). The data of a stopped job can be released.
+     */
+    inline
+    bool AsyncJob::isStopped() const {
+
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _state == DONE || (_state == QUEUED && _cancelled);
+    }
+
+
+    /*! void AsyncJob::join()
+     *  Waits until the job is stopped (see isStopped()).
+     */
+    inline
+    void AsyncJob::join() {
+
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait( lock, [this]() { return _state == DONE || (_state == QUEUED && _cancelled); } );
+    }
+
+
+    /*! std::shared_ptr<AsyncJob> AsyncJob::submit( Func f, WorkerPool& pool )
+     *  Runs f(job) in the pool, where job is the returned job.
+     *  f is not called if the job is cancelled before it is started,
+     *  and can poll job.isCancelled() to stop early.
+     *
+     *  \param[in] f     The job function, called as f(AsyncJob&)
+     *  \param[in] pool  The pool to run the job in
+     *  \return The job
+     */
+    template <typename Func>
+    std::shared_ptr<AsyncJob> AsyncJob::submit( Func f, WorkerPool& pool ) {
+
+      std::shared_ptr<AsyncJob> job = std::make_shared<AsyncJob>();
+      pool.submit( [job,f]() {
+        bool run;
+        {
+          std::lock_guard<std::mutex> lock(job->_mutex);
+          run = !job->_cancelled;
+          if( run ) job->_state = RUNNING;
+        }
+        if( run ) f( *job );
+        {
+          std::lock_guard<std::mutex> lock(job->_mutex);
+          job->_state = DONE;
+        }
+        job->_cv.notify_all();
+      } );
+      return job;
+    }
+
+
+  } // END namespace Parallel
+} // END namespace GMlib
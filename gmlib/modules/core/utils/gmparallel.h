@@ -0,0 +1,134 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+#ifndef GM_CORE_UTILS_PARALLEL_H
+#define GM_CORE_UTILS_PARALLEL_H
+
+
+// stl
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace GMlib {
+
+  namespace Parallel {
+
+    /*!
+     * Returns the number of threads to use.
+     * 0 (or a negative number) means one thread for each core of the machine.
+     *
+     * \param[in] no_threads Requested number of threads
+     * \return The actual number of threads, always at least 1
+     */
+    int   getNoThreads( int no_threads = 0 );
+
+    /*!
+     * Runs f(b,e) on disjoint blocks [b,e) covering [begin,end).
+     * The blocks are handed out to the threads on demand (the calling thread is one of them),
+     * so uneven work per index is balanced. The function returns when all blocks are done.
+     * Which thread computes which block does not affect the result as long as f only writes
+     * to data belonging to its own block.
+     *
+     * \param[in] begin       First index
+     * \param[in] end         One past the last index
+     * \param[in] f           The block function, called as f(int b, int e)
+     * \param[in] no_threads  Number of threads, 1 runs f(begin,end) on the calling thread, 0 uses all cores
+     * \param[in] block_size  Number of indices in each block, 0 gives an automatic size
+     */
+    template <typename Func>
+    void  forBlocks( int begin, int end, Func f, int no_threads = 0, int block_size = 0 );
+
+
+
+    /*!
+     * A fixed set of worker threads running jobs from a queue, in the order they are submitted.
+     * The destructor finishes the running jobs, jobs still in the queue are dropped.
+     */
+    class WorkerPool {
+    public:
+      explicit WorkerPool( int no_threads = 0 );
+      ~WorkerPool();
+
+      void                submit( std::function<void()> job );
+      void                wait();
+      int                 getNoThreads() const;
+
+      static WorkerPool&  getDefault();
+
+    private:
+      std::vector<std::thread>          _threads;
+      std::deque<std::function<void()>> _jobs;
+      std::mutex                        _mutex;
+      std::condition_variable           _cv;
+      std::condition_variable           _cv_idle;
+      int                               _no_running;
+      bool                              _stop;
+
+      void                _work();
+    };
+
+
+
+    /*!
+     * A job running in a WorkerPool, shared between the owner and the pool.
+     * A cancelled job is not started, and the owner is to discard the result
+     * of a job cancelled while running.
+     */
+    class AsyncJob {
+    public:
+      AsyncJob();
+
+      void                cancel();
+      bool                isCancelled() const;
+      bool                isDone() const;
+      bool                isStopped() const;
+      void                join();
+
+      template <typename Func>
+      static std::shared_ptr<AsyncJob>  submit( Func f, WorkerPool& pool = WorkerPool::getDefault() );
+
+    private:
+      enum State { QUEUED, RUNNING, DONE };
+
+      std::atomic<bool>         _cancelled;
+      State                     _state;
+      mutable std::mutex        _mutex;
+      std::condition_variable   _cv;
+    };
+
+  } // END namespace Parallel
+} // END namespace GMlib
+
+
+// Including template definition file.
+#include "gmparallel.c"
+
+#endif // GM_CORE_UTILS_PARALLEL_H
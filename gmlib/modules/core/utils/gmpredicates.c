@@ -0,0 +1,249 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+// stl
+#include <cmath>
+
+
+namespace GMlib {
+
+  namespace Predicates {
+
+    namespace Private {
+
+      // An expansion is a sum of doubles, non-overlapping and sorted by increasing magnitude
+      typedef std::vector<double> Expansion;
+
+
+      // x + y = a + b exactly, x is the rounded sum
+      inline
+      void twoSum( double a, double b, double& x, double& y ) {
+
+        x = a + b;
+        const double bv = x - a;
+        const double av = x - bv;
+        y = (a - av) + (b - bv);
+      }
+
+
+      // As twoSum(), but |a| >= |b|
+      inline
+      void fastTwoSum( double a, double b, double& x, double& y ) {
+
+        x = a + b;
+        y = b - (x - a);
+      }
+
+
+      // x + y = a - b exactly
+      inline
+      void twoDiff( double a, double b, double& x, double& y ) {
+
+        x = a - b;
+        const double bv = a - x;
+        const double av = x + bv;
+        y = (a - av) + (bv - b);
+      }
+
+
+      // x + y = a * b exactly (Dekker's product)
+      inline
+      void twoProduct( double a, double b, double& x, double& y ) {
+
+        x = a * b;
+        const double ca = 134217729.0 * a, ah = ca - (ca - a), al = a - ah;
+        const double cb = 134217729.0 * b, bh = cb - (cb - b), bl = b - bh;
+        y = al * bl - (((x - ah * bh) - al * bh) - ah * bl);
+      }
+
+
+      inline
+      Expansion difference( double a, double b ) {
+
+        double x, y;
+        twoDiff( a, b, x, y );
+        Expansion e;
+        if( y != 0.0 ) e.push_back( y );
+        e.push_back( x );
+        return e;
+      }
+
+
+      // e += b, zero components are left out
+      inline
+      void grow( Expansion& e, double b ) {
+
+        double q = b, h;
+        std::size_t k = 0;
+        for( std::size_t i = 0; i < e.size(); i++ ) {
+          twoSum( q, e[i], q, h );
+          if( h != 0.0 ) e[k++] = h;
+        }
+        e.resize( k );
+        if( q != 0.0 || e.empty() ) e.push_back( q );
+      }
+
+
+      // e += f
+      inline
+      void add( Expansion& e, const Expansion& f ) {
+
+        for( std::size_t i = 0; i < f.size(); i++ )
+          grow( e, f[i] );
+      }
+
+
+      // h = e * b, zero components are left out
+      inline
+      Expansion scale( const Expansion& e, double b ) {
+
+        Expansion h;
+        double q, hh, p1, p0, s;
+        twoProduct( e[0], b, q, hh );
+        if( hh != 0.0 ) h.push_back( hh );
+        for( std::size_t i = 1; i < e.size(); i++ ) {
+          twoProduct( e[i], b, p1, p0 );
+          twoSum( q, p0, s, hh );
+          if( hh != 0.0 ) h.push_back( hh );
+          fastTwoSum( p1, s, q, hh );
+          if( hh != 0.0 ) h.push_back( hh );
+        }
+        if( q != 0.0 || h.empty() ) h.push_back( q );
+        return h;
+      }
+
+
+      inline
+      Expansion product( const Expansion& e, const Expansion& f ) {
+
+        Expansion h( 1, 0.0 );
+        for( std::size_t i = 0; i < f.size(); i++ )
+          add( h, scale( e, f[i] ) );
+        return h;
+      }
+
+
+      inline
+      Expansion negate( Expansion e ) {
+
+        for( std::size_t i = 0; i < e.size(); i++ ) e[i] = -e[i];
+        return e;
+      }
+
+
+      // The exact 2x2 determinant a*d - b*c
+      inline
+      Expansion det2( const Expansion& a, const Expansion& b, const Expansion& c, const Expansion& d ) {
+
+        Expansion h = product( a, d );
+        add( h, negate( product( b, c ) ) );
+        return h;
+      }
+
+
+      // The largest component has the sign of the expansion
+      inline
+      double estimate( const Expansion& e ) {
+
+        return e.back();
+      }
+
+
+      const double epsilon     = std::ldexp( 1.0, -53 );
+      const double orientBound = (3.0 + 16.0 * epsilon) * epsilon;
+      const double circleBound = (10.0 + 96.0 * epsilon) * epsilon;
+
+    } // END namespace Private
+
+
+
+    inline
+    double orient2D( double ax, double ay, double bx, double by, double cx, double cy ) {
+
+      const double left  = (ax - cx) * (by - cy);
+      const double right = (ay - cy) * (bx - cx);
+      const double det   = left - right;
+
+      // The sign is certain if the terms have different signs, else compare with the error bound
+      double sum;
+      if( left > 0.0 ) {
+        if( right <= 0.0 ) return det;
+        sum = left + right;
+      }
+      else if( left < 0.0 ) {
+        if( right >= 0.0 ) return det;
+        sum = -left - right;
+      }
+      else
+        return det;
+
+      if( std::fabs( det ) >= Private::orientBound * sum )
+        return det;
+
+      using namespace Private;
+      return estimate( det2( difference( ax, cx ), difference( ay, cy ),
+                             difference( bx, cx ), difference( by, cy ) ) );
+    }
+
+
+    inline
+    double inCircle( double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy ) {
+
+      const double adx = ax - dx, ady = ay - dy;
+      const double bdx = bx - dx, bdy = by - dy;
+      const double cdx = cx - dx, cdy = cy - dy;
+
+      const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+      const double cdxady = cdx * ady, adxcdy = adx * cdy;
+      const double adxbdy = adx * bdy, bdxady = bdx * ady;
+      const double alift  = adx * adx + ady * ady;
+      const double blift  = bdx * bdx + bdy * bdy;
+      const double clift  = cdx * cdx + cdy * cdy;
+
+      const double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+
+      const double permanent = (std::fabs( bdxcdy ) + std::fabs( cdxbdy )) * alift
+                             + (std::fabs( cdxady ) + std::fabs( adxcdy )) * blift
+                             + (std::fabs( adxbdy ) + std::fabs( bdxady )) * clift;
+      if( std::fabs( det ) > Private::circleBound * permanent )
+        return det;
+
+      // Exact, with the differences as expansions
+      using namespace Private;
+      const Expansion eadx = difference( ax, dx ), eady = difference( ay, dy );
+      const Expansion ebdx = difference( bx, dx ), ebdy = difference( by, dy );
+      const Expansion ecdx = difference( cx, dx ), ecdy = difference( cy, dy );
+
+      Expansion ealift = product( eadx, eadx );  add( ealift, product( eady, eady ) );
+      Expansion eblift = product( ebdx, ebdx );  add( eblift, product( ebdy, ebdy ) );
+      Expansion eclift = product( ecdx, ecdx );  add( eclift, product( ecdy, ecdy ) );
+
+      Expansion h = product( ealift, det2( ebdx, ecdx, ebdy, ecdy ) );
+      add( h, product( eblift, det2( ecdx, eadx, ecdy, eady ) ) );
+      add( h, product( eclift, det2( eadx, ebdx, eady, ebdy ) ) );
+      return estimate( h );
+    }
+
+  } // END namespace Predicates
+} // END namespace GMlib
@@ -0,0 +1,64 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+#ifndef GM_CORE_UTILS_PREDICATES_H
+#define GM_CORE_UTILS_PREDICATES_H
+
+
+// stl
+#include <vector>
+
+
+namespace GMlib {
+
+  namespace Predicates {
+
+    /*!
+     * The orientation of three points in the plane, the determinant
+     *   | bx-ax  cx-ax |
+     *   | by-ay  cy-ay |
+     * The sign is exact (adaptive precision after Shewchuk): it is computed in double precision
+     * and only computed again in exact expansion arithmetic when the round off could give the
+     * wrong sign. The magnitude is only an approximation.
+     *
+     * \return Positive if c is to the left of the line from a to b, negative if to the right, 0 if on it
+     */
+    double  orient2D( double ax, double ay, double bx, double by, double cx, double cy );
+
+    /*!
+     * The in-circle test of four points in the plane, with the same exact sign as orient2D().
+     *
+     * \return Positive if d is inside the circle through a, b and c (counter-clockwise),
+     *         negative if outside, 0 if on the circle
+     */
+    double  inCircle( double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy );
+
+  } // END namespace Predicates
+} // END namespace GMlib
+
+
+// Including definition file.
+#include "gmpredicates.c"
+
+#endif // GM_CORE_UTILS_PREDICATES_H
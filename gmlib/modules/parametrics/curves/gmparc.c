@@ -194,6 +194,7 @@ namespace GMlib {
 
     _start = copy._start;
     _end   = copy._end;
+    _x     = copy._x;
   }
 
 
@@ -353,37 +354,38 @@ namespace GMlib {
   // Overrided (protected) virtual functons from PCurve **
   //******************************************************
 
-  /*! void PArc<T>::eval( T t, int d, bool l ) const
+  /*! void PArc<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *  2 derivatives are implemented
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute
    *  \param  l[in]  (dummy) because left and right are always equal
    */
   template <typename T>
-  void PArc<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PArc<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
-      this->_p.setDim( d + 1 );
+      p.setDim( d + 1 );
 
       if( _k < 1e-5 ) { // special case, a stright line
-          this->_p[0][0] = _d * t;
-          this->_p[0][1] = T(0);
-          this->_p[0][2] = T(0);
+          p[0][0] = _d * t;
+          p[0][1] = T(0);
+          p[0][2] = T(0);
           if( this->_dm == GM_DERIVATION_EXPLICIT ) {
               if( d > 0 ) {
-                  this->_p[1][0] = _d;
-                  this->_p[1][1] = T(0);
-                  this->_p[1][2] = T(0);
+                  p[1][0] = _d;
+                  p[1][1] = T(0);
+                  p[1][2] = T(0);
                   if( d > 1 ) {
-                      this->_p[2][0] = T(0);
-                      this->_p[2][1] = T(0);
-                      this->_p[2][2] = T(0);
+                      p[2][0] = T(0);
+                      p[2][1] = T(0);
+                      p[2][2] = T(0);
                       if( d > 2 ) {
-                          this->_p[3][0] = T(0);
-                          this->_p[3][1] = T(0);
-                          this->_p[3][2] = T(0);
+                          p[3][0] = T(0);
+                          p[3][1] = T(0);
+                          p[3][2] = T(0);
                       }
                   }
               }
@@ -393,25 +395,25 @@ namespace GMlib {
           T kdt = _k * _d * t;
           T skdt = sin(kdt)/_k;
           T ckdt = cos(kdt)/_k;
-          this->_p[0][0] = skdt;
-          this->_p[0][1] = 1/_k - ckdt;
-          this->_p[0][2] = T(0);
+          p[0][0] = skdt;
+          p[0][1] = 1/_k - ckdt;
+          p[0][2] = T(0);
           if( this->_dm == GM_DERIVATION_EXPLICIT ) {
               T g = _k * _d;
               if( d > 0 ) {
-                  this->_p[1][0] = g * ckdt;
-                  this->_p[1][1] = g * skdt;
-                  this->_p[1][2] = T(0);
+                  p[1][0] = g * ckdt;
+                  p[1][1] = g * skdt;
+                  p[1][2] = T(0);
                   if( d > 1 ) {
                       g *= g;
-                      this->_p[2][0] = -g * skdt;
-                      this->_p[2][1] =  g * ckdt;
-                      this->_p[2][2] =  T(0);
+                      p[2][0] = -g * skdt;
+                      p[2][1] =  g * ckdt;
+                      p[2][2] =  T(0);
                       if( d > 2 ) {
                           g *= g;
-                          this->_p[3][0] = -g * ckdt;
-                          this->_p[3][1] = -g * skdt;
-                          this->_p[3][2] =  T(0);
+                          p[3][0] = -g * ckdt;
+                          p[3][1] = -g * skdt;
+                          p[3][2] =  T(0);
                       }
                   }
               }
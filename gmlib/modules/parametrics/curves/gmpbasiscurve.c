@@ -116,17 +116,18 @@ namespace GMlib {
   // Overrided (protected) virtual functons from PCurve **
   //******************************************************
 
-  /*! void PBasisCurve<T,G>::eval( T t, int d, bool l ) const
+  /*! void PBasisCurve<T,G>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the basis curve at a given parameter value
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  (dummy) because this is desided by _d_no.
    *  \param  l[in]  (dummy) because left and right are always equal
    */
   template <typename T, typename G>
-  void PBasisCurve<T,G>::eval( T t, int /*d*/, bool /*l*/ ) const {
+  void PBasisCurve<T,G>::eval( DVector<Vector<T,3>>& p, T t, int /*d*/, bool /*l*/ ) const {
 
-    this->_p.setDim(1);
+    p.setDim(1);
     float value = (float)_B->operator()(t);
 
     switch( _d_no ) {
@@ -135,9 +136,9 @@ namespace GMlib {
     }
 
 
-    this->_p[0][0] = t*_scale;
-    this->_p[0][1] = value;
-    this->_p[0][2] = 0.0f;
+    p[0][0] = t*_scale;
+    p[0][1] = value;
+    p[0][2] = 0.0f;
   }
 
 
@@ -25,7 +25,7 @@
 #include "../evaluators/gmevaluatorstatic.h"
 
 // gmlib
-//#include <scene/visualizers/gmselectorgridvisualizer.h>
+#include <scene/visualizers/gmselectorgridvisualizer.h>
 #include <scene/selector/gmselector.h>
 
 namespace GMlib {
@@ -189,6 +189,7 @@ namespace GMlib {
   void PBezierCurve<T>::setControlPoints( const DVector< Vector<T,3> >& c ) {
 
     _c = c;
+    this->invalidateArcLength();
 
     if(_selectors) {
         hideSelectors();
@@ -263,6 +264,7 @@ namespace GMlib {
           _coord_ch = true;
       }
       _pos_change.push_back(EditSet(selector_id, dp));
+      this->invalidateArcLength();
       this->setEditDone(true);
     _c_moved = false;
   }
@@ -304,8 +306,9 @@ namespace GMlib {
   void PBezierCurve<T>::prepareForSampling() {
 
      if(this->_parent && _coord_ch) {
-       eval(_t,0);
-       moveLocalCoordinatsystem(this->_p[0]);
+       DVector<Vector<T,3>> p;
+       eval(p, _t, 0);
+       moveLocalCoordinatsystem(p[0]);
        _coord_ch = false;
      }
 std::cout << "HER ER VI!!" << std::endl;
@@ -474,27 +477,65 @@ int PBezierCurve<T>::getSample_d(int i, int j) const {
   //*****************************************************
 
 
-  /*! void PBezierCurve<T>::eval( T t, int d ) const
+  /*! void PBezierCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d ) const
    *  Protected,
    *  Evaluation of the curve at a given parameter value
    *  in intrinsiq coordinates.
    *
+   *  \param  p  The position and d derivatives at t (output)
    *  \param  t  The parameter value to evaluate at
    *  \param  d  The number of derivatives to compute
    */
   template <typename T>
-  void PBezierCurve<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PBezierCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
     // Compute the Bernstein-Hermite Polynomials
     DMatrix< T > bhp;
     EvaluatorStatic<T>::evaluateBhp( bhp, getDegree(), t, 1/this->_sc );
 
-    multEval(this->_p, bhp, d);
+    multEval(p, bhp, d);
 
   }
 
 
 
+  /*! void PBezierCurve<T>::evalBatch( Vector<T,3>* p, const T* t, int m, int d, bool l ) const
+   *  Protected,
+   *  Evaluation of the curve at m parameter values
+   *  in intrinsiq coordinates. Gives the same result as eval() for each parameter value.
+   *
+   *  \param  p  The positions and d derivatives, the k-th derivative at t[i] is p[k*m+i] (output)
+   *  \param  t  The m parameter values to evaluate at
+   *  \param  m  The number of parameter values
+   *  \param  d  The number of derivatives to compute
+   *  \param  l  (dummy) because left and right are always equal
+   */
+  template <typename T>
+  void PBezierCurve<T>::evalBatch( Vector<T,3>* p, const T* t, int m, int d, bool l ) const {
+
+    const int deg = getDegree();
+    if( d > deg ) {
+      PCurve<T,3>::evalBatch( p, t, m, d, l );
+      return;
+    }
+
+    // The Bernstein-Hermite matrix is kept per thread, to not allocate memory each time
+    static thread_local DMatrix<T> bhp;
+    const T scale = 1/this->_sc;
+
+    for( int i = 0; i < m; i++ ) {
+      EvaluatorStatic<T>::evaluateBhp( bhp, deg, t[i], scale );
+      for( int j = 0; j <= d; j++ ) {
+        Vector<T,3> q = bhp(j)(0)*_c[0];
+        for( int k = 1; k <= deg; k++ )
+          q += bhp(j)(k)*_c[k];
+        p[j*m+i] = q;
+      }
+    }
+  }
+
+
+
 
   /*! T PBezierCurve<T>::getStartP() const
    *  Provides the start parameter value associated with
@@ -541,6 +582,20 @@ int PBezierCurve<T>::getSample_d(int i, int j) const {
 
 
 
+  /*! void PBezierCurve<T>::lodSwapped()
+   *  Protected,
+   *  The samples of another level of detail are swapped in,
+   *  the Bernstein-Hermite matrices are made for their sample values.
+   */
+  template <typename T>
+  void PBezierCurve<T>::lodSwapped() {
+
+      makeBernsteinMat(int(this->_visu[0].size()), _c.getDim()-1, this->_sc);
+  }
+
+
+
+
   //*****************************************
   //     Local (protected) help functons   **
   //*****************************************
@@ -589,7 +644,7 @@ int PBezierCurve<T>::getSample_d(int i, int j) const {
           _pos_change.pop_back();
           if(this->_local_pre_eval) {
 //              prepareForSampling();
-              resample( this->_visu[1].sample_val, this->_visu[1].sur_sphere , this->_visu[1], this->_visu[1].sample_val[0].getDim()-1);
+              this->resample( this->_visu[1].sample_val, this->_visu[1].sur_sphere , this->_visu[1], this->_visu[1].sample_val[0].getDim()-1);
               this->setEditDone();
           }
       }
@@ -94,9 +94,11 @@ namespace GMlib {
 
   protected:
     // Virtual functions from PCurve, which have to be implemented locally
-    void            eval( T t, int d = 0, bool l = false ) const override;
+    void            eval( DVector<Vector<T,3>>& p, T t, int d = 0, bool l = false ) const override;
+    void            evalBatch( Vector<T,3>* p, const T* t, int m, int d, bool l ) const override;
     T               getStartP() const override;
     T               getEndP()   const override;
+    void            lodSwapped() override;
 
 //    void            resample( std::vector<DVector<Vector<T,n>>>& p, Sphere<T,3>& s, const std::vector<T>& t, int d ) const override;
 
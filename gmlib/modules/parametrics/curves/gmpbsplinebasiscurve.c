@@ -99,48 +99,49 @@ namespace GMlib {
   // Overrided (protected) virtual functons from PCurve **
   //******************************************************
 
-  /*! void PBSplineBasisCurve<T>::eval( T t, int d, bool l ) const
+  /*! void PBSplineBasisCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *  4 derivatives are implemented
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute (max is the polynomial degree)
    *  \param  l[in]  Evaluating from left or right, important if multiple knots
    */
   template <typename T>
-  void PBSplineBasisCurve<T>::eval( T t, int d, bool l ) const {
+  void PBSplineBasisCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const {
 
-    this->_p.setDim( d + 1 );
+    p.setDim( d + 1 );
 
     DMatrix<T> B;
     int k = (_t.getDim()+1)/3;
     int i = 2*(k-1) - EvaluatorStatic<T>::evaluateBSp( B, t, _t, k-1, l);
 
-    this->_p[0][0] = B[0][i];
-    this->_p[0][1] = t;
-    this->_p[0][2] = 0;
+    p[0][0] = B[0][i];
+    p[0][1] = t;
+    p[0][2] = 0;
 
     if(d>0)
     {
-      this->_p[1][0] = B[1][i];
-      this->_p[1][1] = 1;
-      this->_p[1][2] = 0;
+      p[1][0] = B[1][i];
+      p[1][1] = 1;
+      p[1][2] = 0;
       if(d>1)
       {
-        this->_p[2][0] = B[2][i];
-        this->_p[2][1] = 0;
-        this->_p[2][2] = 0;
+        p[2][0] = B[2][i];
+        p[2][1] = 0;
+        p[2][2] = 0;
         if(d>2)
         {
-          this->_p[3][0] = B[3][i];
-          this->_p[3][1] = 0;
-          this->_p[3][2] = 0;
+          p[3][0] = B[3][i];
+          p[3][1] = 0;
+          p[3][2] = 0;
           if(d>3)
           {
-            this->_p[4][0] = B[4][i];
-            this->_p[4][1] = 0;
-            this->_p[4][2] = 0;
+            p[4][0] = B[4][i];
+            p[4][1] = 0;
+            p[4][2] = 0;
           }
         }
       }
@@ -25,6 +25,7 @@
 
 // gmlib
 #include <core/containers/gmdmatrix.h>
+#include <scene/visualizers/gmselectorgridvisualizer.h>
 #include <scene/selector/gmselector.h>
 
 
@@ -186,6 +187,7 @@ template <typename T>
         updateKnotClosed(d);
     else
         updateKnotOpen(d);
+    this->invalidateArcLength();
   }
 
 
@@ -228,6 +230,7 @@ template <typename T>
               transKnotClose(_t, _cl, nt, n, _d, dt);
           } else
               transKnot(_t, _cl, nt, n, _d);
+          this->invalidateArcLength();
 
           if( this->_derived ) this->_derived->edit( this );
       }
@@ -257,6 +260,7 @@ template <typename T>
               _d = _k-1;
           }
       _c = c;
+      this->invalidateArcLength();
   }
 
 
@@ -295,6 +299,7 @@ template <typename T>
 
       _t = t;
       _cl = closed;
+      this->invalidateArcLength();
   }
 
 
@@ -371,7 +376,11 @@ template <typename T>
     _c_moved = true;
        if( this->_parent ) this->_parent->edit( this );
        if( this->_derived ) this->_derived->edit( this );
-       _pos_change.push_back(EditSet(selector_id, dp));
+       if( _pre_outdated )
+           sample( this->getNumSamples(), this->getNumDerivatives() );
+       else
+           _pos_change.push_back(EditSet(selector_id, dp));
+       this->invalidateArcLength();
        this->setEditDone();
     _c_moved = false;
   }
@@ -414,6 +423,7 @@ template <typename T>
       for(uint i=1; i < this->_visu.size(); i++)
           this->cleanVisualizers(i);
       makePartition( m );
+      _pre_outdated = false;
       preSample(d);
       this->prepareVisualizers();
       this->setEditDone();
@@ -536,22 +546,71 @@ template <typename T>
   //*****************************************************
 
 
-  /*! void PBSplineCurve<T>::eval( T t, int d, bool l ) const
+  /*! void PBSplineCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute
    *  \param  l[in]  (default true) To evauate from left or from right
    */
   template <typename T>
-  void PBSplineCurve<T>::eval( T t, int d, bool l ) const {
+  void PBSplineCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
+
+      // The B-spline Hermite matrix and the control point indices are kept per thread,
+      // they keep their size between calls, so the evaluation does not allocate memory.
+      static thread_local DMatrix<T> bsp;
+      static thread_local IndexBsp   ind;
 
       // Make the B-spline Hermite matrix
-      DMatrix<T> bsp;
       int idx = EvaluatorStatic<T>::evaluateBSp( bsp, t, _t, _d);
-      IndexBsp ind(idx, _k, _c.getDim());
-      multEval(this->_p, bsp, ind, d);
+      ind.init(idx, _k, _c.getDim());
+      multEval(p, bsp, ind, d);
+  }
+
+
+
+  /*! void PBSplineCurve<T>::evalBatch( Vector<T,3>* p, const T* t, int m, int d, bool l ) const
+   *  Evaluation of the curve at m parameter values
+   *  Gives the same result as eval() for each parameter value.
+   *  The knot interval of the previous parameter value is tried first,
+   *  so sorted parameter values only need a binary search when a new knot interval is entered.
+   *
+   *  \param  p[out] The positions and d derivatives, the k-th derivative at t[i] is p[k*m+i]
+   *  \param  t[in]  The m parameter values to evaluate at
+   *  \param  m[in]  The number of parameter values
+   *  \param  d[in]  The number of derivatives to compute
+   *  \param  l[in]  To evauate from left or from right
+   */
+  template <typename T>
+  void PBSplineCurve<T>::evalBatch( Vector<T,3>* p, const T* t, int m, int d, bool l ) const {
+
+      if( d > _d ) {
+          PCurve<T,3>::evalBatch( p, t, m, d, l );
+          return;
+      }
+
+      static thread_local DMatrix<T> bsp;
+      static thread_local IndexBsp   ind;
+
+      int idx = -1;
+      for( int i = 0; i < m; i++ ) {
+
+          // Same knot index as eval() finds by binary search (left evaluation)
+          if( idx < 0 || !( _t(idx) < t[i] && t[i] <= _t(idx+1) ) ) {
+              idx = EvaluatorStatic<T>::knotIndex( _t, t[i], _d, true );
+              ind.init( idx, _k, _c.getDim() );
+          }
+          EvaluatorStatic<T>::evaluateBSp2( bsp, t[i], _t, _d, idx );
+
+          for( int j = 0; j <= d; j++ ) {
+              Vector<T,3> q = bsp(j)(0)*_c[ind[0]];
+              for( int k = 1; k < _k; k++ )
+                  q += bsp(j)(k)*_c[ind[k]];
+              p[j*m+i] = q;
+          }
+      }
   }
 
 
@@ -582,6 +641,19 @@ template <typename T>
 
 
 
+  /*! void PBSplineCurve<T>::lodSwapped()
+   *  Protected
+   *  The samples of another level of detail are swapped in, the pre-evaluated
+   *  basis functions are for the previous level. The curve is sampled again
+   *  when a control point is moved.
+   */
+  template <typename T>
+  void PBSplineCurve<T>::lodSwapped() {
+    _pre_outdated = true;
+  }
+
+
+
 
   //*****************************************
   //     Local (protected) help functons   **
@@ -867,7 +939,8 @@ template <typename T>
         _pre_basis.resize(su.size());
 
         for(uint i=0; i<this->_visu.size(); i++) {
-            computeUniformParamVal(this->_visu[i], su[i], _t[pu[2*i]], _t[pu[2*i+1]]);
+            this->makeSampleValues(this->_visu[i], su[i], _t[pu[2*i]], _t[pu[2*i+1]]);
+            su[i] = int(this->_visu[i].size());   // Adaptive sampling can add samples
             _pre_basis[i].resize(su[i]);
 
             for(int j=0; j<su[i]-1; j++)
@@ -1011,6 +1084,7 @@ template <typename T>
       _sgv          = 0x0;
       _pct          = 1;
       _cl           = false;
+      _pre_outdated = false;
 
       _selector_radius = T(1);
       _grid            = true;
@@ -99,9 +99,11 @@ class SelectorGridVisualizer;
 
   protected:
     // Virtual protected functions from PCurve, which have to be implemented locally
-    void            eval(T t, int d = 0, bool l = false) const override;
+    void            eval(DVector<Vector<T,3>>& p, T t, int d = 0, bool l = false) const override;
+    void            evalBatch(Vector<T,3>* p, const T* t, int m, int d, bool l) const override;
     T               getStartP() const override;
     T               getEndP()   const override;
+    void            lodSwapped() override;
 
 
     // Protected intrinsic data for the curve
@@ -126,6 +128,7 @@ class SelectorGridVisualizer;
     // Partitioning of the curve based on continuity criteria
     mutable int                      _pct;        //!< Partition criteria (continuity C^_pct)
     mutable std::vector<PreBasis<T>> _pre_basis;  //!< Pre-evaluated basis functions for each partition
+    bool                             _pre_outdated; //!< Samples of another level of detail are swapped in
 
     mutable bool                 _c_moved;    //!< Mark that we are editing, moving controll points
     mutable std::vector<EditSet> _pos_change; //!< The step vector of control points that is moved
@@ -56,7 +56,12 @@ namespace GMlib {
    */
   template <typename T>
   inline
-  PButterfly<T>::PButterfly( const PButterfly<T>& copy ) : PCurve<T,3>(copy) {}
+  PButterfly<T>::PButterfly( const PButterfly<T>& copy ) : PCurve<T,3>(copy) {
+      _size         = copy._size;
+      _flaps        = copy._flaps;
+      _sim_speed    = copy._sim_speed;
+      _sim_boundary = copy._sim_boundary;
+  }
 
 
 
@@ -202,49 +207,50 @@ namespace GMlib {
   // Overrided (protected) virtual functons from PCurve **
   //******************************************************
 
-  /*! void PButterfly<T>::eval( T t, int d, bool l ) const
+  /*! void PButterfly<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *  2 derivatives are implemented
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute
    *  \param  l[in]  (dummy) because left and right are always equal
    */
   template <typename T>
-  void PButterfly<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PButterfly<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
-    this->_p.setDim( d + 1 );
+    p.setDim( d + 1 );
 
     const double ct   = cos(t);
     const double st   = sin(t);
     const double st12 = sin(t/12);
     const double a    = exp(ct) - 2*cos(4*t) - pow(st12, 5.0);
 
-    this->_p[0][0] = _size * T(ct * a);
-    this->_p[0][1] = _size * T(st * a);
-    this->_p[0][2] =  fabs(this->_p[0][1])*_flaps;
+    p[0][0] = _size * T(ct * a);
+    p[0][1] = _size * T(st * a);
+    p[0][2] =  fabs(p[0][1])*_flaps;
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
         if( d > 0 ) { // The first derivative
             const double ct12 = cos(t/12);
             const double a1 = -exp(ct)*st + 8*sin(4*t) - (5.0/12)*pow(st12,4.0)*ct12;
-            this->_p[1][0]  = _size * T( -st*a + ct*a1 );
-            this->_p[1][1]  = _size * T(  ct*a + st*a1 );
-            if(this->_p[0][1] > 0)
-                this->_p[1][2]  = this->_p[1][1]*_flaps;
+            p[1][0]  = _size * T( -st*a + ct*a1 );
+            p[1][1]  = _size * T(  ct*a + st*a1 );
+            if(p[0][1] > 0)
+                p[1][2]  = p[1][1]*_flaps;
             else
-                this->_p[1][2]  = -this->_p[1][1]*_flaps;
+                p[1][2]  = -p[1][1]*_flaps;
             if( d > 1 ) { // The second derivative
                 const double a2 = exp(ct)*st*st - exp(ct) * ct + 8.0*4.0*cos(4*t)
                                   - (5.0/12)*((1.0/3)* pow(st12,3.0 )*pow(ct12,2.0)
                                   - (1.0/12)* pow(st12,5.0));
-                this->_p[2][0]  = _size * T( -ct*a - st*a1 - st*a1 + ct*a2 );
-                this->_p[2][1]  = _size * T( -st*a + ct*a1 + ct*a1 + st*a2 );
-                if(this->_p[0][1] > 0)
-                    this->_p[2][2]  = this->_p[2][1]*_flaps;
+                p[2][0]  = _size * T( -ct*a - st*a1 - st*a1 + ct*a2 );
+                p[2][1]  = _size * T( -st*a + ct*a1 + ct*a1 + st*a2 );
+                if(p[0][1] > 0)
+                    p[2][2]  = p[2][1]*_flaps;
                 else
-                    this->_p[2][2]  = -this->_p[2][1]*_flaps;
+                    p[2][2]  = -p[2][1]*_flaps;
             }
         }
     }
@@ -56,6 +56,9 @@ namespace GMlib {
    */
   template <typename T>
   PChrysanthemumCurve<T>::PChrysanthemumCurve( const PChrysanthemumCurve<T>& copy ) : PCurve<T,3>( copy ) {
+    _r     = copy._r;
+    _scale = copy._scale;
+    _trans = copy._trans;
   }
 
 
@@ -78,27 +81,28 @@ namespace GMlib {
   // Overrided (protected) virtual functons from PCurve **
   //******************************************************
 
-  /*! void PChrysanthemumCurve<T>::eval( T t, int d, bool l ) const
+  /*! void PChrysanthemumCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *  0 derivatives are implemented
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute
    *  \param  l[in]  (dummy) because left and right are always equal
    */
   template <typename T>
-  void PChrysanthemumCurve<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PChrysanthemumCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
-    this->_p.setDim( d+1 );
+    p.setDim( d+1 );
 
     const double p4 = sin(17*t/3);
     const double p8 = sin(2*cos(3*t) - 28*t);
     const double r  = 5*(1+sin(11*t/5)) - 4*pow(p4,4) * pow(p8,8);
 
-    this->_p[0][0] = _r * T(r * cos(t));
-    this->_p[0][1] = _r * T(r * sin(t));
-    this->_p[0][2] = _r * T((r/20 + _trans) * sin(_scale * r));
+    p[0][0] = _r * T(r * cos(t));
+    p[0][1] = _r * T(r * sin(t));
+    p[0][2] = _r * T((r/20 + _trans) * sin(_scale * r));
   }
 
 
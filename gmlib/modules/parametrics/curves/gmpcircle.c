@@ -72,7 +72,10 @@ namespace GMlib {
    */
   template <typename T>
   inline
-  PCircle<T>::PCircle( const PCircle<T>& copy ) : PCurve<T,3>(copy) {}
+  PCircle<T>::PCircle( const PCircle<T>& copy ) : PCurve<T,3>(copy) {
+    _rx = copy._rx;
+    _ry = copy._ry;
+  }
 
 
 
@@ -151,41 +154,89 @@ namespace GMlib {
   // Overrided (protected) virtual functons from PCurve **
   //******************************************************
 
-  /*! void PCircle<T>::eval( T t, int d, bool l ) const
+  /*! void PCircle<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *  7 derivatives are implemented
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute
    *  \param  l[in]  (dummy) because left and right are always equal
    */
   template <typename T>
-  void PCircle<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PCircle<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
-    this->_p.setDim( d + 1 );
+    p.setDim( d + 1 );
 
     const T ct_x = _rx * cos(t);
     const T st_y = _ry * sin(t);
 
-    this->_p[0][0] = ct_x;
-    this->_p[0][1] = st_y;
-    this->_p[0][2] = T(0);
+    p[0][0] = ct_x;
+    p[0][1] = st_y;
+    p[0][2] = T(0);
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
       const T st_x = _rx * sin(t);
       const T ct_y = _ry * cos(t);
       if( d > 0 ) {
-        this->_p[1][0] = -st_x;
-        this->_p[1][1] =  ct_y;
-        this->_p[1][2] =  T(0);
+        p[1][0] = -st_x;
+        p[1][1] =  ct_y;
+        p[1][2] =  T(0);
+      }
+      if( d > 1 ) p[2] = -p[0];
+      if( d > 2 ) p[3] = -p[1];
+      if( d > 3 ) p[4] =  p[0];
+      if( d > 4 ) p[5] =  p[1];
+      if( d > 5 ) p[6] =  p[2];
+      if( d > 6 ) p[7] =  p[3];
+    }
+  }
+
+
+
+  /*! void PCircle<T>::evalBatch( Vector<T,3>* p, const T* t, int m, int d, bool l ) const
+   *  Evaluation of the curve at m parameter values
+   *  Gives the same result as eval() for each parameter value,
+   *  but runs through the parameter values one derivative at a time.
+   *
+   *  \param  p[out] The positions and d derivatives, the k-th derivative at t[i] is p[k*m+i]
+   *  \param  t[in]  The m parameter values to evaluate at
+   *  \param  m[in]  The number of parameter values
+   *  \param  d[in]  The number of derivatives to compute
+   *  \param  l[in]  (dummy) because left and right are always equal
+   */
+  template <typename T>
+  void PCircle<T>::evalBatch( Vector<T,3>* p, const T* t, int m, int d, bool l ) const {
+
+    if( this->_dm != GM_DERIVATION_EXPLICIT || d > 7 ) {
+      PCurve<T,3>::evalBatch( p, t, m, d, l );
+      return;
+    }
+
+    for( int i = 0; i < m; i++ ) {
+      const T ct   = cos(t[i]);
+      const T st   = sin(t[i]);
+      const T ct_x = _rx * ct;
+      const T st_y = _ry * st;
+      p[i][0] = ct_x;
+      p[i][1] = st_y;
+      p[i][2] = T(0);
+      if( d > 0 ) {
+        const T st_x = _rx * st;
+        const T ct_y = _ry * ct;
+        p[m+i][0] = -st_x;
+        p[m+i][1] =  ct_y;
+        p[m+i][2] =  T(0);
       }
-      if( d > 1 ) this->_p[2] = -this->_p[0];
-      if( d > 2 ) this->_p[3] = -this->_p[1];
-      if( d > 3 ) this->_p[4] =  this->_p[0];
-      if( d > 4 ) this->_p[5] =  this->_p[1];
-      if( d > 5 ) this->_p[6] =  this->_p[2];
-      if( d > 6 ) this->_p[7] =  this->_p[3];
+    }
+
+    // The higher derivatives are the two first ones with alternating sign
+    for( int k = 2; k <= d; k++ ) {
+      Vector<T,3>*       pk = p + k*m;
+      const Vector<T,3>* pj = p + (k-2)*m;
+      for( int i = 0; i < m; i++ )
+        pk[i] = -pj[i];
     }
   }
 
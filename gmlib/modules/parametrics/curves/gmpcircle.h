@@ -57,7 +57,8 @@ namespace GMlib {
 
   protected:
     // Virtual functions from PCurve, which have to be implemented locally
-    void            eval(T t, int d, bool l) const override;
+    void            eval(DVector<Vector<T,3>>& p, T t, int d, bool l) const override;
+    void            evalBatch(Vector<T,3>* p, const T* t, int m, int d, bool l) const override;
     T               getStartP() const override;
     T               getEndP()   const override;
 
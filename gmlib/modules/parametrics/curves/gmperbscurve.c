@@ -160,10 +160,26 @@ namespace GMlib {
    */
   template <typename T>
   inline
-  PERBSCurve<T>::PERBSCurve( const PERBSCurve<T>& copy ) : PCurve<T,3>( copy ) {
+  PERBSCurve<T>::PERBSCurve( const PERBSCurve<T>& copy ) : PERBSCurve( copy, true ) {}
+
+
+
+  /*! PERBSCurve<T>::PERBSCurve( const PERBSCurve<T>& copy, bool children )
+   *  Private, the copy constructor.
+   *  Without children the local curves are snapshots (see makeSnapshot()),
+   *  owned by the copy but not inserted in it.
+   *
+   *  \param copy      The PERBSCurve to copy
+   *  \param children  Whether to copy the local curves as children
+   */
+  template <typename T>
+  inline
+  PERBSCurve<T>::PERBSCurve( const PERBSCurve<T>& copy, bool children ) : PCurve<T,3>( copy, children ) {
 
       init(copy._cl);
-      _origin = copy._origin;
+      _type_local = copy._type_local;
+      _origin     = copy._origin;
+      _pct        = copy._pct;
 
       // Copy the knot vector
       _t = copy._t;
@@ -172,10 +188,16 @@ namespace GMlib {
       const DVector<PCurve<T,3>*> &c = copy._c;
       _c.setDim( c.getDim() );
 
+      if( !children ) {
+          for( int i = 0; i < c.getDim(); ++i )
+              _c[i] = c[i]->makeSnapshot();
+          return;
+      }
+
       // Find and save the reference to the local patches
       for( int i = 0; i < c.getDim(); ++i ) {
           SceneObject* local_p =  dynamic_cast<SceneObject*>(c[i]);
-          for( int j = 0; j < this->getChildren().getSize(); ++i ) {
+          for( int j = 0; j < this->getChildren().getSize(); ++j ) {
               SceneObject *child = this->getChildren()[j];
               if( local_p == child->_copy_of) {
                   _c[i] = dynamic_cast<PCurve<T,3>*>(child);
@@ -196,9 +218,6 @@ namespace GMlib {
       SceneObject::remove( _c[i] );
       delete _c[i];
     }
-
-    if( _evaluator )
-      delete _evaluator;
   }
 
 
@@ -254,7 +273,12 @@ namespace GMlib {
       }
       else {
           int i = obj->getNumber();
-          if(i >= 0) {
+          if(i >= 0 && _pre_outdated) {
+              // The pre-evaluation is not made for the swapped in samples
+              sample(this->getNumSamples(), this->getNumDerivatives());
+          }
+          else if(i >= 0) {
+              this->invalidateArcLength();
               for(uint j=0; j<_local_change.size(); j++)
                   if(i == _local_change[j]) return;
               _local_change.push_back(i);
@@ -275,13 +299,52 @@ namespace GMlib {
    *  \brief Not for public use
    *
    *  To replot after object editing or shape changing else,
-   *  therefor, this function is not meant for public use
+   *  therefor, this function is not meant for public use.
+   *  After editing of local curves only the samples in the support of
+   *  the edited local curves are recomputed and sent to the visualizers.
+   *  The surrounding spheres of the changed partitions grow with the changed samples,
+   *  and the other visualizers of the curve are updated as in SceneObject::replot().
    */
   template <typename T>
   void PERBSCurve<T>::replot() const {
 
-      updateSamples();
-      PCurve<T,3>::replot();
+      std::vector<CpIndex> ind;
+      updateSamples( ind );
+      if( ind.empty() ) {
+          PCurve<T,3>::replot();
+          return;
+      }
+      this->clearLodCache();
+      this->restartAsyncReplot();
+      this->invalidateArcLength();
+
+      for(unsigned int i=0; i<ind.size(); i++) {  // for all partisions
+          if(ind[i].getDim() == 0) continue;
+          int first = ind[i][0][0];
+          int last  = ind[i][0][1];
+          for(int j=1; j<ind[i].getDim(); j++) {
+              first = std::min(first, ind[i][j][0]);
+              last  = std::max(last,  ind[i][j][1]);
+          }
+          for(unsigned int j=0; j<this->_visu[i].vis.size(); j++)
+              if(this->_visualizers.exist(this->_visu[i].vis[j]))
+                  this->_visu[i].vis[j]->update(first, last);
+      }
+
+      Sphere<T,3> sph = this->_visu[0].sur_sphere;
+      for(unsigned int i=1; i<ind.size(); i++)
+          sph += this->_visu[i].sur_sphere;
+      SceneObject::setSurroundingSphere(sph);
+
+      // The other visualizers are updated as by SceneObject::replot()
+      std::vector<const Visualizer*> partition_vis;
+      for(unsigned int i=0; i<this->_visu.size(); i++)
+          partition_vis.insert(partition_vis.end(), this->_visu[i].vis.begin(), this->_visu[i].vis.end());
+      std::sort(partition_vis.begin(), partition_vis.end());
+
+      for(int j=0; j<this->_visualizers.getSize(); j++)
+          if(!std::binary_search(partition_vis.begin(), partition_vis.end(), this->_visualizers[j]))
+              this->_visualizers[j]->update();
   }
 
 
@@ -292,24 +355,26 @@ namespace GMlib {
 
 
   template <typename T>
-  void PERBSCurve<T>::eval( T t, int d, bool left ) const
+  void PERBSCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool left ) const
   {
     int k = EvaluatorStatic<T>::knotIndex(_t, t, 1, left);
 
     IndexBsp ii( k, 2, _c.getDim());
 
     // Evaluating first Local Curve @ (t-_t[k-1])/(_t[k+1]-_t[k-1])
-    DVector<Vector<T,3>> c0 = _c[ii[0]]->evaluateParent(t, d);
+    DVector<Vector<T,3>> c0;
+    _c[ii[0]]->evaluateParent(c0, t, d);
 
     // If t == _t[k], the sample is at the knot, set the values to the values of the first local curve.
-    if(std::abs(t - _t[k]) < 1e-5) { this->_p = c0; return; }
+    if(std::abs(t - _t[k]) < 1e-5) { p = c0; return; }
 
     // Evaluating second Local Curve @ (t-_t[k])/(_t[k+2]-_t[k)
-    this->_p = _c[ii[1]]->evaluateParent(t - (ii[0]<ii[1] ? T(0):this->getParDelta()), d);
+    _c[ii[1]]->evaluateParent(p, t - (ii[0]<ii[1] ? T(0):this->getParDelta()), d);
 
     // Blend c0 and c1
-    Vector<T,3>& B = getB(t, k, d);
-    compBlend( d, B, c0, this->_p );
+    Vector<T,3> B;
+    getB(B, t, k, d);
+    compBlend( d, B, c0, p );
   }
 
 
@@ -336,17 +401,15 @@ namespace GMlib {
 
   template <typename T>
   inline
-  Vector<T,3>& PERBSCurve<T>::getB(T t, int k, int d) const {
-
-    static Vector<T,3> B;
+  void PERBSCurve<T>::getB(Vector<T,3>& B, T t, int k, int d) const {
 
-    _evaluator->set( _t[k], _t[k+1] - _t[k] );
-    B[0] = 1 - (*_evaluator)(t);
+    long double b[3];
+    _evaluator->eval( b, t, _t[k], _t[k+1] - _t[k], 2 );
+    B[0] = 1 - b[0];
     switch(d) {
-      case 2: B[2] = - _evaluator->getDer2();
-      case 1: B[1] = - _evaluator->getDer1();
+      case 2: B[2] = - b[2];
+      case 1: B[1] = - b[1];
     }
-    return B;
   }
 
 
@@ -389,6 +452,20 @@ namespace GMlib {
 
 
 
+  /*! void PERBSCurve<T>::lodSwapped()
+   *  \brief Protected
+   *
+   *  The samples of another level of detail are swapped in. The pre-evaluated
+   *  b-functions and the samples of the local curves are for the previous level,
+   *  so the curve is sampled again when a local curve is edited.
+   */
+  template <typename T>
+  void PERBSCurve<T>::lodSwapped() {
+    _pre_outdated = true;
+  }
+
+
+
   template <typename T>
   inline
   void PERBSCurve<T>::hideLocalCurves() {
@@ -571,6 +648,8 @@ namespace GMlib {
 
       // Make partitions, the parameter values and pre-evaluated b-functions for each partition
     makePartition( m );
+    _pre_outdated  = false;
+    _sphere_growth = 0;
 //    prepareSampling(d);
     preSample(d);
     this->prepareVisualizers();
@@ -581,6 +660,36 @@ namespace GMlib {
 
 
 
+  /*! PCurve<T,3>* PERBSCurve<T>::makeSnapshot() const
+   *  A copy of the knot vector and snapshots of the local curves,
+   *  for a background resampling (see PCurve::setAsyncReplot()).
+   *  The local curves are not copied as children, so their children are not copied.
+   *
+   *  Classes derived from PERBSCurve get the copy made by makeCopy().
+   *
+   *  \return The copy, or nullptr if a local curve gives no snapshot
+   */
+  template <typename T>
+  PCurve<T,3>* PERBSCurve<T>::makeSnapshot() const {
+
+      if( typeid(*this) != typeid(PERBSCurve<T>) ) return PCurve<T,3>::makeSnapshot();
+
+      PERBSCurve<T>* curve = new PERBSCurve<T>( *this, false );
+      for( int i = 0; i < curve->_c.getDim(); i++ )
+          if( !curve->_c[i] ) {
+              delete curve;
+              return nullptr;
+          }
+
+      // Pre-evaluated for the number of samples of this curve, done again
+      curve->_visu.no_sample = 0;
+      return curve;
+  }
+
+
+
+
+
   /*! void  PERBSCurve<T>::preSample( int d )
    *  \brief Private, not for public use
    *
@@ -622,16 +731,18 @@ namespace GMlib {
 
 
 
-  /*! void  PERBSCurve<T>::updateSamples() const
+  /*! void  PERBSCurve<T>::updateSamples( std::vector<CpIndex>& ind ) const
    *  \brief Private, not for public use
    *
    *  Update affected sample points for all partitions when some local curves has mover or rotated ...
+   *
+   *  \param[out] ind  The updated sample intervals for each partition, empty if nothing is changed
    */
   template <typename T>
-  void  PERBSCurve<T>::updateSamples() const {
+  void  PERBSCurve<T>::updateSamples( std::vector<CpIndex>& ind ) const {
+      ind.clear();
       if(_local_change.size() > 0) {
           int k = _local_change.back();
-          std::vector<CpIndex> ind;
           ind.resize(_pre_basis.size());
           for(unsigned int i=0; i<ind.size(); i++) // for all partisions
             if(_cp_index[k][i][1]>=0)
@@ -660,12 +771,27 @@ namespace GMlib {
               _c[k]->updateMat();
               _local_change.pop_back();
           }
+          // The spheres only grow with the updated samples
+          int no_samples = 0;
           for(unsigned int i=0; i<this->_visu.size(); i++) {  // for all partisions
-              for(int j=0; j<ind[i].getDim(); j++){
-                  for(int k = ind[i][j][0]; k <= ind[i][j][1]; k++){
+              no_samples += this->_visu[i].sample_val.size();
+              for(int j=0; j<ind[i].getDim(); j++)
+                  for(int k = ind[i][j][0]; k <= ind[i][j][1]; k++) {
                       multEval( this->_visu[i].sample_val[k], _pre_basis[i][k].B, _pre_basis[i][k].ind, k, i);
+                      this->_visu[i].sur_sphere += this->_visu[i].sample_val[k][0];
+                      _sphere_growth++;
                   }
+          }
+
+          // When as many samples are updated as there are samples, the spheres are made
+          // again from all samples, so they shrink when local curves are moved back
+          if(_sphere_growth >= no_samples) {
+              for(unsigned int i=0; i<this->_visu.size(); i++) {
+                  this->_visu[i].sur_sphere.reset();
+                  for(unsigned int k=0; k<this->_visu[i].sample_val.size(); k++)
+                      this->_visu[i].sur_sphere += this->_visu[i].sample_val[k][0];
               }
+              _sphere_growth = 0;
           }
       }
   }
@@ -699,13 +825,13 @@ namespace GMlib {
                 for(unsigned int j=0; j<_pre_basis[i].size()-1; j++) {
                     int k = EvaluatorStatic<T>::knotIndex(_t, this->_visu[i][j], 1, false);
                     IndexBsp ii( k, 2, _c.getDim());
-                    _pre_basis[i][j].B = getB(this->_visu[i][j],k,2);
+                    getB(_pre_basis[i][j].B, this->_visu[i][j],k,2);
                     _pre_basis[i][j].ind[0] = ii[0];
                     _pre_basis[i][j].ind[1] = ii[1];
                 }
                 int k = EvaluatorStatic<T>::knotIndex(_t, this->_visu[i][_pre_basis[i].size()-1], 1, true);
                 IndexBsp ii( k, 2, _c.getDim());
-                _pre_basis[i][_pre_basis[i].size()-1].B = getB(this->_visu[i][_pre_basis[i].size()-1],k,2);
+                getB(_pre_basis[i][_pre_basis[i].size()-1].B, this->_visu[i][_pre_basis[i].size()-1],k,2);
                 _pre_basis[i][_pre_basis[i].size()-1].ind[0] = ii[0];
                 _pre_basis[i][_pre_basis[i].size()-1].ind[1] = ii[1];
             }
@@ -717,19 +843,20 @@ namespace GMlib {
             _pre_basis.resize(su.size());
 
             for(unsigned int i=0; i<this->_visu.size(); i++) {
-                computeUniformParamVal(this->_visu[i], su[i], _t[pu[2*i]], _t[pu[2*i+1]]);
+                this->makeSampleValues(this->_visu[i], su[i], _t[pu[2*i]], _t[pu[2*i+1]]);
+                su[i] = int(this->_visu[i].size());   // Adaptive sampling can add samples
                 _pre_basis[i].resize(su[i]);
 
                 for(int j=0; j<su[i]-1; j++) {
                     int k = EvaluatorStatic<T>::knotIndex(_t, this->_visu[i][j], 1, false);
                     IndexBsp ii( k, 2, _c.getDim());
-                    _pre_basis[i][j].B = getB(this->_visu[i][j],k,2);
+                    getB(_pre_basis[i][j].B, this->_visu[i][j],k,2);
                     _pre_basis[i][j].ind[0] = ii[0];
                     _pre_basis[i][j].ind[1] = ii[1];
                 }
                 int k = EvaluatorStatic<T>::knotIndex(_t, this->_visu[i][su[i]-1], 1, true);
                 IndexBsp ii( k, 2, _c.getDim());
-                _pre_basis[i][su[i]-1].B = getB(this->_visu[i][su[i]-1],k,2);
+                getB(_pre_basis[i][su[i]-1].B, this->_visu[i][su[i]-1],k,2);
                 _pre_basis[i][su[i]-1].ind[0] = ii[0];
                 _pre_basis[i][su[i]-1].ind[1] = ii[1];
             }
@@ -879,7 +1006,9 @@ namespace GMlib {
     this->_type_id = GM_SO_TYPE_CURVE_ERBS;
     _cl            = closed;
     _pct           = 0;
-    _evaluator     = new ERBSEvaluator<long double>();
+    _evaluator     = ERBSEvaluator<long double>::getInstance();
+    _pre_outdated  = false;
+    _sphere_growth = 0;
   }
 
 
@@ -96,6 +96,7 @@ namespace GMlib {
     // from PCurve
     bool                   isClosed() const override;
     void                   sample(int m, int d) override;
+    PCurve<T,3>*           makeSnapshot() const override;
 
   protected:
 
@@ -106,36 +107,41 @@ namespace GMlib {
     DVector<T>                   _t;          //!< knot vector
     bool                         _cl;         //!< closed (or open) curve?
 
-    BasisEvaluator<long double>* _evaluator;  //!< Evaluator for Expo-rational B-functions
+    const BasisEvaluator<long double>* _evaluator;  //!< Evaluator for Expo-rational B-functions (shared, read only)
 
     // Pre-evaluation and visualization
     mutable std::vector<CpIndex> _cp_index;   //!< Indices of sample points affected by the local curves.
                                               //!< I.e. _cp_index[local curve nr.][partition nr.][start, end - index in _visu]
     mutable std::vector<int>     _local_change; //!< The local curves that has changed
+    mutable int                  _sphere_growth; //!< Samples updated since the surrounding spheres were made from all samples
 
 
 
     // Partitioning of the curve based on continuity criteria
     mutable int                   _pct;        //!< Partition criteria (continuity C^_pct)
     mutable std::vector<PreEvalB> _pre_basis;  //!< Pre evaluated b-functions for each partitions
+    bool                          _pre_outdated; //!< Samples of another level of detail are swapped in
 
     // Virtual functions from PCurve, which have to be implemented locally
-    void                   eval( T t, int d = 0, bool l = false ) const override;
+    void                   eval( DVector<Vector<T,3>>& p, T t, int d = 0, bool l = false ) const override;
     T                      getEndP()   const override;
     T                      getStartP() const override;
+    void                   lodSwapped() override;
 
     // Local help functions
-    Vector<T,3>&           getB(T t, int k, int d) const;
+    void                   getB(Vector<T,3>& B, T t, int k, int d) const;
 
 
   private:
+    PERBSCurve( const PERBSCurve<T>& copy, bool children );
+
     // Local help functions
     void                   compBlend(int d, const Vector<T,3>& B, DVector<Vector<T,3>>& c0, DVector<Vector<T,3>>& c1) const;
     void                   generateKnotVector(PCurve<T,3>* g, int n, bool closed);
     void                   generateCuLenKnotVector(PCurve<T,3>* g, int n, bool closed);
     void                   insertLocal(PCurve<T,3> *local_curve);
     void                   preSample(int d);
-    void                   updateSamples() const;
+    void                   updateSamples( std::vector<CpIndex>& ind ) const;
     void                   makePartition(int m) const;
     void                   prepareSampling(int d) const;
     void                   multEval(DVector<Vector<T,3>>& p, const Vector<T,3>& B, const Vector<int,2>& ii, int j, int i) const;
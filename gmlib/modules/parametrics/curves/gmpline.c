@@ -62,7 +62,7 @@ namespace GMlib {
    */
   template <typename T>
   inline
-  PLine<T>::PLine( const PLine<T>& copy ) : PCurve<T,3>(copy) {}
+  PLine<T>::PLine( const PLine<T>& copy ) : PCurve<T,3>(copy), _pt(copy._pt), _v(copy._v) {}
 
 
 
@@ -95,30 +95,31 @@ namespace GMlib {
   // Overrided (protected) virtual functons from PCurve **
   //******************************************************
 
-  /*! void PCircle<T>::eval( T t, int d, bool l ) const
+  /*! void PCircle<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *  7 derivatives are implemented
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute
    *  \param  l[in]  (dummy) because left and right are always equal
    */
   template <typename T>
-  void PLine<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PLine<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
-    this->_p.setDim( d + 1 );
+    p.setDim( d + 1 );
 
-    this->_p[0] = _pt + t * _v;
+    p[0] = _pt + t * _v;
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
-      if( d )     this->_p[1] = _v;
-      if( d > 1 ) this->_p[2] = Vector<T,3>(T(0));
-      if( d > 2 ) this->_p[3] = Vector<T,3>(T(0));
-      if( d > 3 ) this->_p[4] = Vector<T,3>(T(0));
-      if( d > 4 ) this->_p[5] = Vector<T,3>(T(0));
-      if( d > 5 ) this->_p[6] = Vector<T,3>(T(0));
-      if( d > 6 ) this->_p[7] = Vector<T,3>(T(0));
+      if( d )     p[1] = _v;
+      if( d > 1 ) p[2] = Vector<T,3>(T(0));
+      if( d > 2 ) p[3] = Vector<T,3>(T(0));
+      if( d > 3 ) p[4] = Vector<T,3>(T(0));
+      if( d > 4 ) p[5] = Vector<T,3>(T(0));
+      if( d > 5 ) p[6] = Vector<T,3>(T(0));
+      if( d > 6 ) p[7] = Vector<T,3>(T(0));
     }
   }
 
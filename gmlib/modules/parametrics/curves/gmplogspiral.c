@@ -182,43 +182,44 @@ namespace GMlib {
   // Overrided (protected) virtual functons from PCurve **
   //******************************************************
 
-  /*! void PLogSpiral<T>::eval( T t, int d, bool l ) const
+  /*! void PLogSpiral<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *  3 derivatives are implemented
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute
    *  \param  l[in]  (dummy) because left and right are always equal
    */
   template <typename T>
-  void PLogSpiral<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PLogSpiral<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
-    this->_p.setDim( d + 1 );
+    p.setDim( d + 1 );
 
     const T ct = cos(t);
     const T st = sin(t);
     const T ex = _a*exp(_b*t);
 
-    this->_p[0][0] = ex*ct;
-    this->_p[0][1] = ex*st;
-    this->_p[0][2] = _c*t;
+    p[0][0] = ex*ct;
+    p[0][1] = ex*st;
+    p[0][2] = _c*t;
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
       if( d > 0 ) {
-        this->_p[1][0] = ex*(_b*ct-st);
-        this->_p[1][1] = ex*(_b*st+ct);
-        this->_p[1][2] =  _c;
+        p[1][0] = ex*(_b*ct-st);
+        p[1][1] = ex*(_b*st+ct);
+        p[1][2] =  _c;
       }
       if( d > 1 ) {
-          this->_p[2][0] = ex*((_b*_b-1)*ct - 2*_b*st);
-          this->_p[2][1] = ex*((_b*_b-1)*st + 2*_b*ct);
-          this->_p[2][2] = T(0);
+          p[2][0] = ex*((_b*_b-1)*ct - 2*_b*st);
+          p[2][1] = ex*((_b*_b-1)*st + 2*_b*ct);
+          p[2][2] = T(0);
       }
       if( d > 2 ) {
-          this->_p[3][0] = ex*((1-3*_b*_b)*st + (_b*_b*_b-3*_b)*ct);
-          this->_p[3][1] = ex*((3*_b*_b-1)*ct + (_b*_b*_b-3*_b)*st);
-          this->_p[3][2] = T(0);
+          p[3][0] = ex*((1-3*_b*_b)*st + (_b*_b*_b-3*_b)*ct);
+          p[3][1] = ex*((3*_b*_b-1)*ct + (_b*_b*_b-3*_b)*st);
+          p[3][2] = T(0);
       }
     }
   }
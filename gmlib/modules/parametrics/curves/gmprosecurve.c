@@ -119,34 +119,35 @@ namespace GMlib {
   //******************************************************
 
 
-  /*! void PRoseCurve<T>::eval( T t, int d, bool l ) const
+  /*! void PRoseCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *  2 derivatives are implemented
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute
    *  \param  l[in]  (dummy) because left and right are always equal
    */
   template <typename T>
-  void PRoseCurve<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PRoseCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
-      this->_p.setDim(d + 1);
+      p.setDim(d + 1);
 
-      this->_p[0][0] = _r * T(cos(t)*cos(1.75*t));
-      this->_p[0][1] = _r * T(sin(t)*cos(1.75*t));
-      this->_p[0][2] = _rize*(this->_p[0][0]*this->_p[0][0] + this->_p[0][1]*this->_p[0][1]);
+      p[0][0] = _r * T(cos(t)*cos(1.75*t));
+      p[0][1] = _r * T(sin(t)*cos(1.75*t));
+      p[0][2] = _rize*(p[0][0]*p[0][0] + p[0][1]*p[0][1]);
 
       if( this->_dm == GM_DERIVATION_EXPLICIT ) {
           if(d > 0) {
-              this->_p[1][0] = _r * T(-1.75*cos(t) * sin(1.75*t) - sin(t)*cos(1.75*t));
-              this->_p[1][1] = _r * T(-1.75*sin(t) * sin(1.75*t) + cos(t)*cos(1.75*t));
-              this->_p[1][2] = 2*_rize*(this->_p[0][0]*this->_p[1][0] + this->_p[0][1]*this->_p[1][1]);
+              p[1][0] = _r * T(-1.75*cos(t) * sin(1.75*t) - sin(t)*cos(1.75*t));
+              p[1][1] = _r * T(-1.75*sin(t) * sin(1.75*t) + cos(t)*cos(1.75*t));
+              p[1][2] = 2*_rize*(p[0][0]*p[1][0] + p[0][1]*p[1][1]);
               if(d > 1) {
-                  this->_p[2][0]= _r * T( 3.5*sin(t)*sin(1.75*t) - 4.0625*cos(t)*cos(1.75*t));
-                  this->_p[2][1]= _r * T(-3.5*cos(t)*sin(1.75*t) - 4.0625*sin(t)*cos(1.75*t));
-                  this->_p[2][2]= 2*_rize*(this->_p[1][0]*this->_p[1][0] + this->_p[0][0]*this->_p[2][0]+
-                                           this->_p[1][1]*this->_p[1][1] + this->_p[0][1]*this->_p[2][1]);
+                  p[2][0]= _r * T( 3.5*sin(t)*sin(1.75*t) - 4.0625*cos(t)*cos(1.75*t));
+                  p[2][1]= _r * T(-3.5*cos(t)*sin(1.75*t) - 4.0625*sin(t)*cos(1.75*t));
+                  p[2][2]= 2*_rize*(p[1][0]*p[1][0] + p[0][0]*p[2][0]+
+                                           p[1][1]*p[1][1] + p[0][1]*p[2][1]);
               }
           }
       }
@@ -54,7 +54,7 @@ namespace GMlib {
 
   protected:
     // Virtual functions from PCurve, which have to be implemented locally
-    void                eval(T t, int d, bool l) const override;
+    void                eval(DVector<Vector<T,3>>& p, T t, int d, bool l) const override;
     T                   getStartP() const override;
     T                   getEndP()   const override;
 
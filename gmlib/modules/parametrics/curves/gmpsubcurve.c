@@ -152,9 +152,10 @@ namespace GMlib {
   void PSubCurve<T>::openClosedChanged(T s, T t, T e)
   {
      set(_c, s, e, t);
-     eval(_t, 0, true);
-     this->translateParent(this->_p[0] - _trans);
-     _trans = this->_p[0];
+     DVector<Vector<T,3>> p;
+     eval(p, _t, 0, true);
+     this->translateParent(p[0] - _trans);
+     _trans = p[0];
   }
 
 
@@ -207,21 +208,22 @@ namespace GMlib {
   //******************************************************
 
 
-  /*! void PArc<T>::eval( T t, int d, bool l ) const
+  /*! void PSubCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool l ) const
    *  Evaluation of the curve at a given parameter value
    *  To compute position and d derivatives at parameter value t on the curve.
    *  The number of derivatives that are implemented is equal The mother curve
    *
+   *  \param  p[out] The position and d derivatives at t
    *  \param  t[in]  The parameter value to evaluate at
    *  \param  d[in]  The number of derivatives to compute
    *  \param  l[in]  To evauate from left or from right
    */
   template <typename T>
-  void PSubCurve<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PSubCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
     if(_parent_closed && t < _t) t += _c->getParDelta();
-    this->_p     = _c->evaluateParent(t , d);
-    this->_p[0] -= _trans;
+    _c->evaluateParent(p, t , d);
+    p[0] -= _trans;
   }
 
 
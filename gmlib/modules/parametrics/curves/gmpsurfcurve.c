@@ -97,26 +97,22 @@ namespace GMlib {
   template <typename T>
   void PSurfCurve<T>::resample( DVector< DVector< Vector<T, 3> > >& p, int m, int d, T start, T end )
   {
+      T du = (end-start)/(m-1);
+      p.setDim(m);
+
       if (_der_curve && _plot)
       {
-        T du = (end-start)/(m-1);
-        p.setDim(m);
-
-        for( int i = 0; i < m - 1; i++ )
+        DVector<Vector<T,3>> q;
+        for( int i = 0; i < m; i++ )
         {
+          const T t = i < m - 1 ? start + i * du : end;
           p[i].setDim(d+1);
-          eval1(start + i * du, 1);
-          p[i][0] = this->_p[0];
-          eval2(start + i * du, d-1);
+          eval1(q, t, 1);
+          p[i][0] = q[0];
+          eval2(q, t, d-1);
           for(int j=1; j<d;j++)
-             p[i][j] = this->_p[j-1];
+             p[i][j] = q[j-1];
         }
-        p[m-1].setDim(d+1);
-        eval1(end, 1);
-        p[m-1][0] = this->_p[0];
-        eval2(end, d-1);
-        for(int j=1; j<d;j++)
-           p[m-1][j] = this->_p[j-1];
 
         switch( this->_dm )
         {
@@ -132,8 +128,11 @@ namespace GMlib {
             break;
         };
       }
-      else
-        PCurve<T,3>::resample(  p, m, d, start, end );
+      else {
+        for( int i = 0; i < m - 1; i++ )
+          this->evaluate( p[i], start + i * du, d );
+        this->evaluate( p[m-1], end, d );
+      }
   }
 
 
@@ -155,11 +154,11 @@ namespace GMlib {
 
   template <typename T>
   inline
-  void PSurfCurve<T>::eval( T t, int d, bool /*l*/ ) const {
+  void PSurfCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
       if (_der_curve)
-          eval2(t,d);
+          eval2(p,t,d);
       else
-          eval1(t,d);
+          eval1(p,t,d);
   }
 
 
@@ -183,18 +182,18 @@ namespace GMlib {
 
   template <typename T>
   inline
-  void PSurfCurve<T>::eval1( T t, int d ) const {
-    this->_p.setDim( d + 1 );
+  void PSurfCurve<T>::eval1( DVector<Vector<T,3>>& p, T t, int d ) const {
+    p.setDim( d + 1 );
 
     DMatrix< Vector<T,3> > m = _s->evaluateParent(_p1 + t*_dv , d);
 
-    this->_p[0] = m[0][0];
+    p[0] = m[0][0];
     if(d>0)
     {
         Matrix<T,3,2> d1;
         d1.setCol(m[1][0], 0);
         d1.setCol(m[0][1], 1);
-        this->_p[1] = d1*_dv;
+        p[1] = d1*_dv;
     }
     if(d>1)
     {
@@ -208,7 +207,7 @@ namespace GMlib {
         Vector<T,3> v2 = d3*_dv;
         d2.setCol(v1, 0);
         d2.setCol(v2, 1);
-        this->_p[2]= d2*_dv;
+        p[2]= d2*_dv;
     }
     if(d>2)
     {
@@ -232,7 +231,7 @@ namespace GMlib {
         v2 = d5*_dv;
         d4.setCol(v1, 0);
         d4.setCol(v2, 1);
-        this->_p[3] = d4*_dv;
+        p[3] = d4*_dv;
     }
   }
 
@@ -240,9 +239,9 @@ namespace GMlib {
 
   template <typename T>
   inline
-  void PSurfCurve<T>::eval2( T t, int d ) const
+  void PSurfCurve<T>::eval2( DVector<Vector<T,3>>& p, T t, int d ) const
   {
-    this->_p.setDim( d + 1 );
+    p.setDim( d + 1 );
 
     Vector<T,2> h  = _p1 + t*(_p2-_p1);
     Vector<T,2> dh = _p2-_p1;
@@ -255,13 +254,13 @@ namespace GMlib {
 //    Matrix<T,3,2> d1, d2, d3;
 //    d1.setCol(m[1][0], 0);
 //    d1.setCol(m[0][1], 1);
-    this->_p[0] = m[1][0]*v[0]+m[0][1]*v[1];
+    p[0] = m[1][0]*v[0]+m[0][1]*v[1];
     if(d>0)
     {
         Vector<T,3> v1 = m[2][0]*dh[0] + m[1][1]*dh[1];
         Vector<T,3> v2 = m[1][1]*dh[0] + m[0][2]*dh[1];
         Vector<T,3> bb = v[0]*v1 + v[1]*v2 + m[1][0]*dh[0] + m[0][1]*dh[1];
-        this->_p[1] = bb;
+        p[1] = bb;
 //        d2.setCol(m[2][0], 0);
 //        d2.setCol(m[1][1], 1);
 //        Vector<T,3> v1 = d2*v;
@@ -270,7 +269,7 @@ namespace GMlib {
 //        Vector<T,3> v2 = d2*v;
 //        d2.setCol(v1, 0);
 //        d2.setCol(v2, 1);
-//        this->_p[1] = d2*_dv;
+//        p[1] = d2*_dv;
     }
     if(d>1)
     {
@@ -294,7 +293,7 @@ namespace GMlib {
         d3.setCol(v5, 1);
         Vector<T,3> v6 = d3*_dv;
 
-        this->_p[2] = v6;
+        p[2] = v6;
     }
   }
 
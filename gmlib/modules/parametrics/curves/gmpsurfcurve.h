@@ -48,8 +48,8 @@ namespace GMlib {
 
 
     void                togglePlot();
-     void               resample( DVector< DVector< Vector<T, 3> > >& p,
-                                      int m, int d, T start, T end ) override;
+    void                resample( DVector< DVector< Vector<T, 3> > >& p,
+                                  int m, int d, T start, T end );
 
 
     //****************************************
@@ -62,7 +62,7 @@ namespace GMlib {
 
   protected:
     // Virtual functions from PCurve, which have to be implemented locally
-    void                eval(T t, int d, bool l) const override;
+    void                eval(DVector<Vector<T,3>>& p, T t, int d, bool l) const override;
     T                   getStartP() const override;
     T                   getEndP()   const override;
 
@@ -80,8 +80,8 @@ namespace GMlib {
     bool                _plot;
 
     // Protected help functions
-    void	            eval1( T t, int d) const;
-    void	            eval2( T t, int d) const;
+    void	            eval1( DVector<Vector<T,3>>& p, T t, int d) const;
+    void	            eval2( DVector<Vector<T,3>>& p, T t, int d) const;
 
   }; // END class PSurfCurve
 
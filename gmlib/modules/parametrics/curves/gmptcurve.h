@@ -50,7 +50,7 @@ namespace GMlib {
 
   protected:
     // Virtual functiions from PCurve, which have to be implemented locally
-    void             eval( T t, int d, bool l = true ) {}
+    void             eval( DVector<Vector<T,3>>& p, T t, int d, bool l = true ) const override {}
     T                getStartP() { return T(0); }
     T                getEndP() { return T(1); }
 
@@ -78,12 +78,12 @@ PTriangCurve<T>::~PTriangCurve() {}
 
 template <typename T>
 inline
-void PTriangCurve<T>::eval( T t, int d, bool /*l*/ ) const
+void PTriangCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const
 {
   if (_der_curve)
-    eval2(t,d);
+    eval2(p,t,d);
   else
-    eval1(t,d);
+    eval1(p,t,d);
 }
 
 
@@ -91,26 +91,26 @@ void PTriangCurve<T>::eval( T t, int d, bool /*l*/ ) const
 
 template <typename T>
 inline
-void PTriangCurve<T>::eval1( T t, int d ) const
+void PTriangCurve<T>::eval1( DVector<Vector<T,3>>& p, T t, int d ) const
 {
-  this->_p.setDim( d + 1 );
+  p.setDim( d + 1 );
 
   Vector<T,3> dh = _p2 - _p1;
   Vector<T,3>  h = _p1 + t*dh;
 
   DVector<Vector<T,3> > m = _s->evaluateParent(h, d);
 
-  this->_p[0] = m[0];
+  p[0] = m[0];
   if(d>0)
   {
-    this->_p[1] = dS(m[1], m[2], m[3], dh);
+    p[1] = dS(m[1], m[2], m[3], dh);
 
     if(d>1)
     {
       Vector<T,3> v1 = dS(m[4], m[5], m[6], dh);
       Vector<T,3> v2 = dS(m[5], m[7], m[8], dh);
       Vector<T,3> v3 = dS(m[6], m[8], m[9], dh);
-      this->_p[2]    = dS(v1, v2, v3, dh);
+      p[2]    = dS(v1, v2, v3, dh);
     }
   }
 }
@@ -119,9 +119,9 @@ void PTriangCurve<T>::eval1( T t, int d ) const
 
 template <typename T>
 inline
-void PTriangCurve<T>::eval2( T t, int d ) const
+void PTriangCurve<T>::eval2( DVector<Vector<T,3>>& p, T t, int d ) const
 {
-  this->_p.setDim( d + 1 );
+  p.setDim( d + 1 );
   double tt = _basis(t);
 
   Vector<T,3> dh  = _p2 - _p1;
@@ -130,14 +130,14 @@ void PTriangCurve<T>::eval2( T t, int d ) const
 
   DVector<Vector<T,3> > m = _s->evaluateParent(h, d+1);
 
-  this->_p[0] = dS(m[1], m[2], m[3], v);
+  p[0] = dS(m[1], m[2], m[3], v);
   if(d>0)
   {
     Vector<T,3> dv = _basis.getDer1()*(_v2 - _v1);
     Vector<T,3> v1 = dS(m[4], m[5], m[6], dh);
     Vector<T,3> v2 = dS(m[5], m[7], m[8], dh);
     Vector<T,3> v3 = dS(m[6], m[8], m[9], dh);
-    this->_p[1] = dS(v1, v2, v3, v) + dS(m[1], m[2], m[3], dv);
+    p[1] = dS(v1, v2, v3, v) + dS(m[1], m[2], m[3], dv);
 
     if(d>1)
     {
@@ -162,7 +162,7 @@ void PTriangCurve<T>::eval2( T t, int d ) const
       Vector<T,3> d3 = dS(v3, v5, v6, dh);  // d(dS_w(dh))(v)
       Vector<T,3> d4 = dS(d1, d2, d3, v) + 2*v0 + dS(m[1], m[2], m[3], d2v);
 
-      this->_p[2] = d4;
+      p[2] = d4;
     }
   }
 }
@@ -171,9 +171,9 @@ void PTriangCurve<T>::eval2( T t, int d ) const
 
 template <typename T>
 inline
-void PTriangCurve<T>::eval123( T t)
+void PTriangCurve<T>::eval123( DVector<Vector<T,3>>& p, T t) const
 {
-  this->_p.setDim(6);
+  p.setDim(6);
   double tt = _basis(t);
   double dt = _basis.getDer1();
   double d2t= _basis.getDer2();
@@ -192,12 +192,12 @@ void PTriangCurve<T>::eval123( T t)
   Vector<T,3> v0 = dS(v1, v2, v3, dv);         // d(dS(dh))(dv)
   Vector<T,3> v4,v5,v6;
 
-  this->_p[0] = m[0];
-  this->_p[2] = dS(m[1], m[2], m[3], dh);
-  this->_p[4] = dS(v1, v2, v3, dh);
+  p[0] = m[0];
+  p[2] = dS(m[1], m[2], m[3], dh);
+  p[4] = dS(v1, v2, v3, dh);
 
-  this->_p[1] = dS(m[1], m[2], m[3], v);
-  this->_p[3] = dS(v1, v2, v3, v) + dS(m[1], m[2], m[3], dv);
+  p[1] = dS(m[1], m[2], m[3], v);
+  p[3] = dS(v1, v2, v3, v) + dS(m[1], m[2], m[3], dv);
   //  [S_uuu  S_uuv  S_uuw]
   v1 = dS(m[10], m[11], m[12], dh);
   //  [S_uuv  S_uvv  S_uvw]
@@ -214,16 +214,16 @@ void PTriangCurve<T>::eval123( T t)
   Vector<T,3> d2 = dS(v2, v4, v5, dh);  // d(dS_v(dh))(dh)
   Vector<T,3> d3 = dS(v3, v5, v6, dh);  // d(dS_w(dh))(dh)
 
-  this->_p[5] = dS(d1, d2, d3, v) + 2*v0 + dS(m[1], m[2], m[3], d2v);
+  p[5] = dS(d1, d2, d3, v) + 2*v0 + dS(m[1], m[2], m[3], d2v);
 }
 
 
 
 template <typename T>
 inline
-void PTriangCurve<T>::eval12( T t)
+void PTriangCurve<T>::eval12( DVector<Vector<T,3>>& p, T t) const
 {
-  this->_p.setDim(4);
+  p.setDim(4);
   double tt = _basis(t);
 
   Vector<T,3> dh = _p2 - _p1;
@@ -237,11 +237,11 @@ void PTriangCurve<T>::eval12( T t)
   Vector<T,3> v2 = dS(m[5], m[7], m[8], dh);
   Vector<T,3> v3 = dS(m[6], m[8], m[9], dh);
 
-  this->_p[0] = m[0];
-  this->_p[2] = dS(m[1], m[2], m[3], dh);
+  p[0] = m[0];
+  p[2] = dS(m[1], m[2], m[3], dh);
 
-  this->_p[1] = dS(m[1], m[2], m[3], v);
-  this->_p[3] = dS(v1, v2, v3, v) + dS(m[1], m[2], m[3], dv);
+  p[1] = dS(m[1], m[2], m[3], v);
+  p[3] = dS(v1, v2, v3, v) + dS(m[1], m[2], m[3], dv);
 }
 
 
@@ -286,21 +286,17 @@ void PTriangCurve<T>::resample( DVector< DVector< Vector<T, 3> > >& p, int m, in
     T du = (end-start)/(m-1);
     p.setDim(m);
 
-    for( int i = 0; i < m - 1; i++ )
+    DVector<Vector<T,3>> q;
+    for( int i = 0; i < m; i++ )
     {
+      const T t = i < m - 1 ? start + i * du : end;
       p[i].setDim(d+2);
-      eval1(start + i * du, 0);
-      p[i][0] = this->_p[0];
-      eval2(start + i * du, d);
+      eval1(q, t, 0);
+      p[i][0] = q[0];
+      eval2(q, t, d);
       for(int j=0; j<=d;j++)
-        p[i][j+1] = this->_p[j];
+        p[i][j+1] = q[j];
     }
-    p[m-1].setDim(d+2);
-    eval1(end, 0);
-    p[m-1][0] = this->_p[0];
-    eval2(end, d);
-    for(int j=0; j<=d;j++)
-      p[m-1][j+1] = this->_p[j];
 
     switch( this->_dm )
     {
@@ -317,7 +313,13 @@ void PTriangCurve<T>::resample( DVector< DVector< Vector<T, 3> > >& p, int m, in
     };
   }
   else
-    PCurve<T,3>::resample(  p, m, d, start, end );
+  {
+    T du = (end-start)/(m-1);
+    p.setDim(m);
+    for( int i = 0; i < m - 1; i++ )
+      this->evaluate( p[i], start + i * du, d );
+    this->evaluate( p[m-1], end, d );
+  }
 }
 
 
@@ -333,8 +335,7 @@ DVector<DVector<Vector<T,3> > >& PTriangCurve<T>::getSample3(int m)
 
   for(int i=0; i<m; i++)
   {
-    eval123(i*du);
-    mat[i] = this->_p;
+    eval123(mat[i], i*du);
   }
   return mat;
 }
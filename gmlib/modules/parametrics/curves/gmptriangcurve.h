@@ -51,13 +51,13 @@ namespace GMlib {
 
     void          togglePlot();
 
-    void  resample( DVector< DVector< Vector<T, 3> > >& p, int m, int d, T start, T end ) override;
+    void  resample( DVector< DVector< Vector<T, 3> > >& p, int m, int d, T start, T end );
 
     DVector<DVector<Vector<T,3> > >& getSample3(int m);
 
   protected:
     // Virtual functions from PCurve, which have to be implemented locally
-    void                eval(T t, int d, bool l) const override;
+    void                eval(DVector<Vector<T,3>>& p, T t, int d, bool l) const override;
     T                   getStartP() const override;
     T                   getEndP()   const override;
 
@@ -77,10 +77,10 @@ namespace GMlib {
 
     private:
 
-    void	     eval1( T t, int d) const;
-    void	     eval2( T t, int d) const;
-    void	     eval12( T t);  // d=1
-    void	     eval123( T t); // d=2
+    void	     eval1( DVector<Vector<T,3>>& p, T t, int d) const;
+    void	     eval2( DVector<Vector<T,3>>& p, T t, int d) const;
+    void	     eval12( DVector<Vector<T,3>>& p, T t) const;  // d=1
+    void	     eval123( DVector<Vector<T,3>>& p, T t) const; // d=2
 
     Vector<T,3>  dS(Vector<T,3>& Su, Vector<T,3>& Sv, Vector<T,3>& Sw, Vector<T,3>& h) const;
 
@@ -40,14 +40,90 @@ namespace GMlib {
   inline
   void BasisEvaluator<T>::_prepare( T t ) {
 
+    _interval( t, _tk, _dtk, _local, _local_dt );
+  }
+
+  template <typename T>
+  inline
+  void BasisEvaluator<T>::_interval( T t, T tk, T dtk, int& j, T& dt ) const {
+
     // Translate/Scale the input paramter
-    t  = ( t - _tk ) / _dtk;
+    t  = ( t - tk ) / dtk;
 
     // Find the local interval
-    _local   = std::min<int>( int(t*_m), _m-1 );
+    j   = std::min<int>( int(t*_m), _m-1 );
 
     // Translate/Scale the local dt parameter
-    _local_dt  = ( t - _local*_dt ) / _dt;
+    dt  = ( t - j*_dt ) / _dt;
+  }
+
+  template <typename T>
+  inline
+  T BasisEvaluator<T>::_value( int j, T dt ) const {
+
+    if( dt > 0.5 )
+      return _scale * (
+        _b(j+1) - _dt * (
+          _a(j)(4) - dt * (
+            _a(j)(0) + dt * (
+              _a(j)(1) / 2 + dt * (
+                _a(j)(2) / 3 + dt * _a(j)(3)/4
+              )
+            )
+          )
+        )
+      );
+    else
+      return _scale * (
+        _b(j) + _dt * dt * (
+          _a(j)(0) + dt * (
+            _a(j)(1)/2 + dt * (
+              _a(j)(2)/3 + dt * _a(j)(3)/4
+            )
+          )
+        )
+      );
+  }
+
+  template <typename T>
+  inline
+  T BasisEvaluator<T>::_der1( int j, T dt ) const {
+
+    return _a(j)(0) + dt * (
+             _a(j)(1) + dt * (
+               _a(j)(2) + dt * _a(j)(3)
+             )
+           );
+  }
+
+  template <typename T>
+  inline
+  T BasisEvaluator<T>::_der2( int j, T dt ) const {
+
+    return _a(j)(1) + dt * (
+             2 * _a(j)(2) + dt *
+               3 * _a(j)(3)
+           );
+  }
+
+  // FNV-1a hash of the bytes of the table, as written by saveTable()
+  template <typename T>
+  uint64_t BasisEvaluator<T>::_checksum( const T& scale, const DVector<T>& b, const DMatrix<T>& a, int m ) {
+
+    uint64_t h = 14695981039346656037ull;
+    auto add = [&h]( const T* p, int n ) {
+      const unsigned char* c = reinterpret_cast<const unsigned char*>(p);
+      for( std::size_t i = 0; i < n*sizeof(T); i++ ) {
+        h ^= c[i];
+        h *= 1099511628211ull;
+      }
+    };
+
+    add( &scale, 1 );
+    add( b.getPtr(), m+1 );
+    for( int i = 0; i < m; i++ )
+      add( a(i).getPtr(), 5 );
+    return h;
   }
 
   template <typename T>
@@ -69,13 +145,7 @@ namespace GMlib {
   inline
   T BasisEvaluator<T>::getDer1() const {
 
-    return _scale1 * (
-      _a(_local)(0) + _local_dt * (
-        _a(_local)(1) + _local_dt * (
-          _a(_local)(2) + _local_dt * _a(_local)(3)
-        )
-      )
-    );
+    return _scale1 * _der1( _local, _local_dt );
   }
 
   template <typename T>
@@ -90,12 +160,7 @@ namespace GMlib {
   inline
   T BasisEvaluator<T>::getDer2() const {
 
-    return _scale2 * (
-      _a(_local)(1) + _local_dt * (
-        2 * _a(_local)(2) + _local_dt *
-          3 * _a(_local)(3)
-      )
-    );
+    return _scale2 * _der2( _local, _local_dt );
   }
 
   template <typename T>
@@ -212,6 +277,113 @@ namespace GMlib {
     _scale = T(1)/_b[m];
   }
 
+  /*! void BasisEvaluator<T>::initTable( int m )
+   *  Builds the table (as init()) unless it is found in the table cache directory.
+   *  A table that has to be computed is written to the cache directory,
+   *  so later runs (and later evaluators with the same parameters) can just read it.
+   *  Without a cache directory, or if getTableName() is empty, this is just init().
+   *
+   *  \param[in] m  The resolution of the table
+   */
+  template <typename T>
+  void BasisEvaluator<T>::initTable( int m ) {
+
+    const std::string name = getTableName();
+    if( _s_table_cache_dir.empty() || name.empty() ) {
+      init( m );
+      return;
+    }
+
+    const std::string file = _s_table_cache_dir + "/" + name + "_m" + std::to_string( m ) +
+                             "_s" + std::to_string( sizeof(T) ) + ".gmbt";
+
+    if( loadTable( file ) && _m == m )
+      return;
+
+    init( m );
+    saveTable( file );
+  }
+
+  /*! Vector<T,3> BasisEvaluator<T>::getMaxError( int n )
+   *  Measures the error of the table, compared to the basis function
+   *  computed directly from getPhi(), getF2() and getIntegral().
+   *  The error is measured in n points inside each of the intervals of the table.
+   *
+   *  \param[in] n  (default 4) Number of test points in each interval
+   *  \return       Max absolute error in B, B' and B'' (on the interval [0,1])
+   */
+  template <typename T>
+  Vector<T,3> BasisEvaluator<T>::getMaxError( int n ) {
+
+    const T scale = _scale;
+
+    Vector<T,3> err( T(0) );
+    for( int j = 0; j < _m; j++ ) {
+
+      const T t0 = _dt * j;
+      const T p0 = getPhi( t0 );
+
+      for( int k = 0; k < n; k++ ) {
+
+        const T t  = t0 + _dt * ( k + T(0.5) ) / n;
+        const T p  = getPhi( t );
+
+        // getF2() is scaled by getScale(), the table is built unscaled (see init())
+        _scale = T(1);
+        const T ex[3] = {
+          _b(j) + getIntegral( t0, t, T(0.5)*(p0+p), 1e-17 ),
+          p,
+          getF2( t ) * p
+        };
+        _scale = scale;
+
+        T b[3];
+        eval( b, t, T(0), T(1), 2 );
+        for( int i = 0; i < 3; i++ )
+          err[i] = std::max( err[i], std::fabs( b[i] - scale * ex[i] ) );
+      }
+    }
+
+    return err;
+  }
+
+  /*! Vector<T,3> BasisEvaluator<T>::initAdaptive( const Vector<T,3>& eps, int m_max )
+   *  Builds the table with the smallest resolution (a power of 2) that keeps
+   *  the error in B, B' and B'' (on [0,1], see getMaxError()) below eps.
+   *  The intervals are kept uniform, so the look-up in the table is not changed.
+   *  The table cache (setTableCacheDir()) is used as in the constructor.
+   *
+   *  \param[in] eps    Max error in B, B' and B''
+   *  \param[in] m_max  (default 65536) Largest resolution to try
+   *  \return           The error of the final table, larger than eps if m_max was not enough
+   */
+  template <typename T>
+  Vector<T,3> BasisEvaluator<T>::initAdaptive( const Vector<T,3>& eps, int m_max ) {
+
+    Vector<T,3> err;
+    for( int m = 8; ; m <<= 1 ) {
+
+      initTable( m );
+      err = getMaxError();
+
+      if( ( err[0] <= eps[0] && err[1] <= eps[1] && err[2] <= eps[2] ) || 2*m > m_max )
+        break;
+    }
+
+    set( _tk, _dtk );
+    return err;
+  }
+
+  /*! std::string BasisEvaluator<T>::getTableName() const
+   *  The name of the table in the table cache, it must identify all the parameters
+   *  of the basis function. An empty name (default) means that the table is not cached.
+   */
+  template <typename T>
+  std::string BasisEvaluator<T>::getTableName() const {
+
+    return std::string();
+  }
+
   template <typename T>
   void BasisEvaluator<T>::interpolate( int i, double p0, double p1, double f0, double f1 ) {
 
@@ -222,6 +394,103 @@ namespace GMlib {
     _a[i][4] = (p0+p1)/2 + (f0-f1)/12;
   }
 
+  /*! bool BasisEvaluator<T>::loadTable( const std::string& filename )
+   *  Reads a table written by saveTable().
+   *  The file must have the right version, be made for the same type T
+   *  and the same basis function (getTableName()), and the checksum of the
+   *  table must match, else nothing is changed.
+   *
+   *  \param[in] filename  The table file
+   *  \return              true if the table is read
+   */
+  template <typename T>
+  bool BasisEvaluator<T>::loadTable( const std::string& filename ) {
+
+    std::ifstream is( filename.c_str(), std::ios::binary );
+    if( !is )
+      return false;
+
+    char          magic[4];
+    uint32_t      header[4];   // version, sizeof(T), m, length of name
+    uint64_t      sum;
+    is.read( magic, 4 );
+    is.read( reinterpret_cast<char*>(header), sizeof(header) );
+    is.read( reinterpret_cast<char*>(&sum), sizeof(sum) );
+    if( !is || std::string( magic, 4 ) != "GMBT" || header[0] != _table_version ||
+        header[1] != sizeof(T) || header[2] == 0 || header[2] > (1u << 20) || header[3] > 1024 )
+      return false;
+
+    std::string name( header[3], ' ' );
+    is.read( &name[0], header[3] );
+    if( !is || name != getTableName() )
+      return false;
+
+    const int  m = header[2];
+    T          scale;
+    DVector<T> b(m+1);
+    DMatrix<T> a(m, 5);
+    is.read( reinterpret_cast<char*>(&scale), sizeof(T) );
+    is.read( reinterpret_cast<char*>(b.getPtr()), (m+1)*sizeof(T) );
+    for( int i = 0; i < m; i++ )
+      is.read( reinterpret_cast<char*>(a[i].getPtr()), 5*sizeof(T) );
+    if( !is || is.peek() != std::ifstream::traits_type::eof() || _checksum( scale, b, a, m ) != sum )
+      return false;
+
+    _m     = m;
+    _dt    = T(1) / m;
+    _scale = scale;
+    _b     = b;
+    _a     = a;
+    return true;
+  }
+
+  /*! bool BasisEvaluator<T>::saveTable( const std::string& filename ) const
+   *  Writes the table to a (versioned) binary file, with a checksum of the table.
+   *  The file is written to a temporary file with a name of its own first, and then
+   *  renamed, so processes writing the same table do not write to the same file and
+   *  a reader sees one of the whole tables. A torn or corrupted file is rejected by loadTable().
+   *
+   *  \param[in] filename  The table file
+   *  \return              true if the table is written
+   */
+  template <typename T>
+  bool BasisEvaluator<T>::saveTable( const std::string& filename ) const {
+
+    const std::string name = getTableName();
+
+    // A random suffix, mixed with the thread, for a temporary file of its own
+    std::random_device rd;
+    const uint64_t     id  = ( uint64_t(rd()) << 32 ^ rd() ) ^ std::hash<std::thread::id>()( std::this_thread::get_id() );
+    const std::string  tmp = filename + "." + std::to_string( id ) + ".tmp";
+    {
+      std::ofstream os( tmp.c_str(), std::ios::binary | std::ios::trunc );
+      if( !os )
+        return false;
+
+      const uint32_t header[4] = { _table_version, uint32_t(sizeof(T)), uint32_t(_m), uint32_t(name.size()) };
+      const uint64_t sum       = _checksum( _scale, _b, _a, _m );
+      os.write( "GMBT", 4 );
+      os.write( reinterpret_cast<const char*>(header), sizeof(header) );
+      os.write( reinterpret_cast<const char*>(&sum), sizeof(sum) );
+      os.write( name.data(), name.size() );
+      os.write( reinterpret_cast<const char*>(&_scale), sizeof(T) );
+      os.write( reinterpret_cast<const char*>(_b.getPtr()), (_m+1)*sizeof(T) );
+      for( int i = 0; i < _m; i++ )
+        os.write( reinterpret_cast<const char*>(_a(i).getPtr()), 5*sizeof(T) );
+      if( !os ) {
+        os.close();
+        std::remove( tmp.c_str() );
+        return false;
+      }
+    }
+
+    if( std::rename( tmp.c_str(), filename.c_str() ) != 0 ) {
+      std::remove( tmp.c_str() );
+      return false;
+    }
+    return true;
+  }
+
   template <typename T>
   inline
   void BasisEvaluator<T>::set( T tk, T dtk ) {
@@ -238,29 +507,94 @@ namespace GMlib {
   T BasisEvaluator<T>::operator () ( T t ) {
 
     _prepare(t);
+    return _value( _local, _local_dt );
+  }
 
-    if( _local_dt > 0.5 )
-      return _scale * (
-        _b[_local+1] - _dt * (
-          _a[_local][4] - _local_dt * (
-            _a[_local][0] + _local_dt * (
-              _a[_local][1] / 2 + _local_dt * (
-                _a[_local][2] / 3 + _local_dt * _a[_local][3]/4
-              )
-            )
-          )
-        )
-      );
-    else
-      return _scale * (
-        _b[_local] + _dt * _local_dt * (
-          _a[_local][0] + _local_dt * (
-            _a[_local][1]/2 + _local_dt * (
-              _a[_local][2]/3 + _local_dt * _a[_local][3]/4
-            )
-          )
-        )
-      );
+  /*! T BasisEvaluator<T>::operator () ( T t, T tk, T dtk, int der ) const
+   *  Reentrant evaluation of the basis function or one of its derivatives.
+   *  Nothing in the evaluator is changed, so the evaluator can be shared between threads.
+   *
+   *  \param[in] t    The parameter value
+   *  \param[in] tk   Start of the knot interval (as in set())
+   *  \param[in] dtk  Length of the knot interval (as in set())
+   *  \param[in] der  (default 0) Which derivative to compute, 0, 1 or 2
+   *  \return         The basis function (or the derivative) at t
+   */
+  template <typename T>
+  inline
+  T BasisEvaluator<T>::operator () ( T t, T tk, T dtk, int der ) const {
+
+    int j;
+    T   dt;
+    _interval( t, tk, dtk, j, dt );
+
+    switch( der ) {
+    case 0:  return _value( j, dt );
+    case 1:  return _scale / dtk * _der1( j, dt );
+    case 2:  return _scale / ( _dt*dtk*dtk ) * _der2( j, dt );
+    }
+    return T(0);
+  }
+
+  /*! void BasisEvaluator<T>::eval( T* b, T t, T tk, T dtk, int d ) const
+   *  Reentrant evaluation of the basis function and d derivatives.
+   *  Nothing in the evaluator is changed, so the evaluator can be shared between threads.
+   *
+   *  \param[out] b    The basis function and the derivatives at t, d+1 elements
+   *  \param[in]  t    The parameter value
+   *  \param[in]  tk   Start of the knot interval (as in set())
+   *  \param[in]  dtk  Length of the knot interval (as in set())
+   *  \param[in]  d    Number of derivatives to compute, 0, 1 or 2
+   */
+  template <typename T>
+  inline
+  void BasisEvaluator<T>::eval( T* b, T t, T tk, T dtk, int d ) const {
+
+    int j;
+    T   dt;
+    _interval( t, tk, dtk, j, dt );
+
+    b[0] = _value( j, dt );
+    if( d > 0 ) b[1] = _scale / dtk * _der1( j, dt );
+    if( d > 1 ) b[2] = _scale / ( _dt*dtk*dtk ) * _der2( j, dt );
+  }
+
+
+
+  //**************************************
+  //   static variable and functions    **
+  //**************************************
+
+
+  template <typename T>
+  std::string BasisEvaluator<T>::_s_table_cache_dir;
+
+  template <typename T>
+  const uint32_t BasisEvaluator<T>::_table_version = 3;   // 3: BFBSEvaluator::getF2() returns phi'/phi
+
+
+  /*! const std::string& BasisEvaluator<T>::getTableCacheDir()
+   *  The directory where the tables are cached, empty if caching is off.
+   */
+  template <typename T>
+  inline
+  const std::string& BasisEvaluator<T>::getTableCacheDir() {
+
+    return _s_table_cache_dir;
+  }
+
+  /*! void BasisEvaluator<T>::setTableCacheDir( const std::string& dir )
+   *  Sets the directory where the tables are cached, the directory must exist.
+   *  An empty string (default) turns the caching off.
+   *  Must be set before the evaluators are made, it is not protected against concurrent access.
+   *
+   *  \param[in] dir  The cache directory
+   */
+  template <typename T>
+  inline
+  void BasisEvaluator<T>::setTableCacheDir( const std::string& dir ) {
+
+    _s_table_cache_dir = dir;
   }
 
 
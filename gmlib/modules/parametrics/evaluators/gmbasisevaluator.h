@@ -30,9 +30,17 @@
 // gmlib
 #include <core/containers/gmdmatrix.h>
 #include <core/containers/gmdvector.h>
+#include <core/types/gmpoint.h>
 
 // stl
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
 
 
 
@@ -61,6 +69,20 @@ namespace GMlib {
 
     T               operator () ( T t );
 
+    // Reentrant evaluation, only reads the (precomputed) table of the evaluator
+    T               operator () ( T t, T tk, T dtk, int der = 0 ) const;
+    void            eval( T* b, T t, T tk, T dtk, int d ) const;
+
+    Vector<T,3>     getMaxError( int n = 4 );
+    Vector<T,3>     initAdaptive( const Vector<T,3>& eps, int m_max = 1 << 16 );
+
+    virtual std::string getTableName() const;
+    bool            loadTable( const std::string& filename );
+    bool            saveTable( const std::string& filename ) const;
+
+    static const std::string&   getTableCacheDir();
+    static void                 setTableCacheDir( const std::string& dir );
+
   protected:
     int             _m;
 
@@ -87,9 +109,20 @@ namespace GMlib {
     virtual void    init( int m );
     virtual void    interpolate( int i, double p0, double p1, double f0, double f1 );
 
+    void                initTable( int m );
+
   private:
     virtual void    _prepare( T t );
 
+    void            _interval( T t, T tk, T dtk, int& j, T& dt ) const;
+    T               _value( int j, T dt ) const;
+    T               _der1( int j, T dt ) const;
+    T               _der2( int j, T dt ) const;
+
+    static uint64_t     _checksum( const T& scale, const DVector<T>& b, const DMatrix<T>& a, int m );
+
+    static std::string  _s_table_cache_dir;
+    static const uint32_t _table_version;   // Of the table files, changed when the file format or the table contents change
 
   }; // END class BasisEvaluator
 
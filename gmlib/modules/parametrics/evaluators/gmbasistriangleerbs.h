@@ -52,6 +52,7 @@ enum BasisTriangleType
     virtual ~BasisTriangleERBS ();
 
     Vector<Vector<T,3>,20>&   eval( T u, T v, T w );
+    void                      eval( Vector<Vector<T,3>,20>& A, T u, T v, T w ) const;
 
     void reset( BasisTriangleType t);
 
@@ -59,18 +60,18 @@ enum BasisTriangleType
     BasisTriangleType            _type;
     Vector<Vector<T,3>,20>       _A;
 
-    BasisEvaluator<long double>* _b;
+    const BasisEvaluator<long double>* _b;
 
-    void    getB( DVector<T>& B, T t, int d );
-    void    computeB1( T u, T v, T w );
-    void    computeB2( T u, T v, T w );
-    void    computeB3( T u, T v, T w );
-    void    computeB4( T u, T v, T w );
+    void    getB( T* B, T t, int d ) const;
+    void    computeB1( Vector<Vector<T,3>,20>& A, T u, T v, T w ) const;
+    void    computeB2( Vector<Vector<T,3>,20>& A, T u, T v, T w ) const;
+    void    computeB3( Vector<Vector<T,3>,20>& A, T u, T v, T w ) const;
+    void    computeB4( Vector<Vector<T,3>,20>& A, T u, T v, T w ) const;
 
-    T       B4_a( T u, T u2, T vw3);
-    T       B4_b( T uuw, T vw, T u);
-    T       B4_c( T u3, T vw, T u);
-    T       B4_d( T u, T vw);
+    T       B4_a( T u, T u2, T vw3) const;
+    T       B4_b( T uuw, T vw, T u) const;
+    T       B4_c( T u3, T vw, T u) const;
+    T       B4_d( T u, T vw) const;
 
   }; // END class BasisTriangleERBS
 
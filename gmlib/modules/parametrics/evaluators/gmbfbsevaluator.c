@@ -32,7 +32,7 @@ namespace GMlib {
 
     texParameters( ik, ikp1 );
 
-    this->init( m );
+    this->initTable( m );
     this->set( 0, 1 );
   }
 
@@ -54,11 +54,8 @@ namespace GMlib {
     T d = t * (1-t);
     if( d < 2.3e-308 )
       return 0.0;
-    else {
-
-      T h = -this->getScale() * ( _ik * (1-t) - _ikp1 * t ) / d;
-      return h * getPhi(t);
-    }
+    else                                  // phi'/phi, as getF2() in ERBSEvaluator
+      return this->getScale() * ( _ik * (1-t) - _ikp1 * t ) / d;
   }
 
   template <typename T>
@@ -72,6 +69,12 @@ namespace GMlib {
       return std::pow(t,_ik) * std::pow( 1-t, _ikp1 ) * getFact(_ik+_ikp1) / c1;
   }
 
+  template <typename T>
+  std::string BFBSEvaluator<T>::getTableName() const {
+
+    return "bfbs_" + std::to_string( _ik ) + "_" + std::to_string( _ikp1 );
+  }
+
   template <typename T>
   void BFBSEvaluator<T>::setIk( int ik ) {
 
@@ -43,6 +43,8 @@ namespace GMlib {
     void      setIkp1( int ikp1 );
     void      texParameters( int ik, int ikp1 );
 
+    std::string getTableName() const override;
+
 
   protected:
     int       _ik;
@@ -36,7 +36,7 @@ namespace GMlib {
   ERBSEvaluator<T>::ERBSEvaluator( int m, T alpha, T beta, T gamma, T lambda ) {
     texParameters( alpha, beta, gamma, lambda );
 
-    this->init(m);
+    this->initTable(m);
     this->set(0, 1);
   }
 
@@ -123,18 +123,17 @@ namespace GMlib {
   //**************************************
 
 
-  template <typename T>
-  ERBSEvaluator<T> *ERBSEvaluator<T>::_s_instance = 0x0;
-
-
-
+  /*! const ERBSEvaluator<T>* ERBSEvaluator<T>::getInstance()
+   *  The shared default evaluator. The table is built (thread safe) on first use,
+   *  and is never changed afterwards, so it can be used from several threads
+   *  through the const functions operator()(t,tk,dtk,der) and eval().
+   */
   template <typename T>
   inline
-  ERBSEvaluator<T>* ERBSEvaluator<T>::getInstance() {
-    if( !_s_instance )
-      _s_instance = new ERBSEvaluator<T>();
+  const ERBSEvaluator<T>* ERBSEvaluator<T>::getInstance() {
 
-    return _s_instance;
+    static ERBSEvaluator<T> instance;
+    return &instance;
   }
 
 
@@ -172,6 +171,18 @@ namespace GMlib {
 
 
 
+  template <typename T>
+  std::string ERBSEvaluator<T>::getTableName() const {
+
+    // The parameters in hexadecimal, so equal names are equal parameters
+    char name[128];
+    std::snprintf( name, sizeof(name), "erbs_%La_%La_%La_%La",
+                   (long double)_alpha, (long double)_beta, (long double)_gamma, (long double)_lambda );
+    return name;
+  }
+
+
+
   template <typename T>
   inline
   T ERBSEvaluator<T>::getPhi( T t ) {
@@ -50,7 +50,9 @@ namespace GMlib {
     void          setLambda( T lambda );
     void          texParameters( T alpha = T(1), T beta = T(1), T gamma = T(1), T lambda = T(0.5) );
 
-    static ERBSEvaluator<T>*    getInstance();
+    std::string   getTableName() const override;
+
+    static const ERBSEvaluator<T>*  getInstance();
 
   protected:
     T             _alpha;
@@ -61,9 +63,6 @@ namespace GMlib {
     T             getF2( T t );
     T             getPhi( T t );
 
-  private:
-    static ERBSEvaluator<T>    *_s_instance;
-
   }; // END class ERBSEvaluator
 
 
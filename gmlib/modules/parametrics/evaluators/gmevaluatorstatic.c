@@ -23,11 +23,89 @@
 
 
 
+// The loops in the degree specialized kernels have compile time bounds.
+// Rolling them out completely lets the compiler keep the whole matrix in registers.
+#if defined(__clang__)
+#  define GM_EVALUATOR_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+#  define GM_EVALUATOR_UNROLL _Pragma("GCC unroll 16")
+#else
+#  define GM_EVALUATOR_UNROLL
+#endif
+
+
+
 namespace GMlib {
 
-template <typename T>               // Described on page 91-92 in "Blend book"
+template <typename T>
+inline
 void EvaluatorStatic<T>::evaluateBhp( DMatrix<T>& mat, int d, T t, T scale ) {
 
+    // Use the unrolled kernels for the most common degrees
+    switch( d ) {
+    case 1:  evaluateBhp<1>( mat, t, scale );  break;
+    case 2:  evaluateBhp<2>( mat, t, scale );  break;
+    case 3:  evaluateBhp<3>( mat, t, scale );  break;
+    case 4:  evaluateBhp<4>( mat, t, scale );  break;
+    case 5:  evaluateBhp<5>( mat, t, scale );  break;
+    default: evaluateBhpGeneric( mat, d, t, scale );
+    }
+}
+
+
+
+template <typename T>
+template <int d>                    // Same as evaluateBhpGeneric, but with a given degree
+void EvaluatorStatic<T>::evaluateBhp( DMatrix<T>& mat, T t, T scale ) {
+
+    static_assert( d > 0, "The degree must be at least 1" );
+
+    // The matrix is computed in local storage, so the compiler can unroll the loops
+    // and keep the values in registers, and then copied to the result matrix.
+    T m[d+1][d+1];
+
+    m[d-1][0] = 1 - t;
+    m[d-1][1] = t;
+
+    GM_EVALUATOR_UNROLL
+    for( int i = d-2; i >= 0; i-- ) {
+        m[i][0] = ( 1 - t) * m[i+1][0];
+        GM_EVALUATOR_UNROLL
+        for( int j = 1; j < d - i; j++ )
+            m[i][j] = t * m[i+1][j-1] + (1 - t) * m[i+1][j];
+        m[i][d-i] = t * m[i+1][d-i-1];
+    }
+
+    m[d][0] = -scale;
+    m[d][1] = scale;
+
+    GM_EVALUATOR_UNROLL
+    for( int k = 2; k <= d; k++ ) {
+        const double s = k * scale;
+        GM_EVALUATOR_UNROLL
+        for( int i = d; i > d - k; i-- ) {
+            m[i][k] = s * m[i][k-1];
+            GM_EVALUATOR_UNROLL
+            for( int j = k - 1; j > 0; j-- )
+                m[i][j] = s * ( m[i][j-1] - m[i][j] );
+            m[i][0] = - s * m[i][0];
+        }
+    }
+
+    mat.setDim( d+1, d+1 );
+    GM_EVALUATOR_UNROLL
+    for( int i = 0; i <= d; i++ ) {
+        GM_EVALUATOR_UNROLL
+        for( int j = 0; j <= d; j++ )
+            mat[i][j] = m[i][j];
+    }
+}
+
+
+
+template <typename T>               // Described on page 91-92 in "Blend book"
+void EvaluatorStatic<T>::evaluateBhpGeneric( DMatrix<T>& mat, int d, T t, T scale ) {
+
     // Initiate result matrix
     mat.setDim( d+1, d+1 );
 
@@ -79,13 +157,89 @@ void EvaluatorStatic<T>::evaluateBhp( DMatrix<T>& mat, int d, T t, T scale ) {
 
 
   template <typename T>
-  void EvaluatorStatic<T>::evaluateBSp2( DMatrix<T>& mat, T t, const DVector<T>& tv, int d, int ii, T scale ){
+  inline
+  void EvaluatorStatic<T>::evaluateBSp2( DMatrix<T>& mat, T t, const DVector<T>& tv, int d, int i, T scale ){
+
+      // Use the unrolled kernels for the most common degrees
+      switch( d ) {
+      case 1:  evaluateBSp2<1>( mat, t, tv, i, scale );  break;
+      case 2:  evaluateBSp2<2>( mat, t, tv, i, scale );  break;
+      case 3:  evaluateBSp2<3>( mat, t, tv, i, scale );  break;
+      case 4:  evaluateBSp2<4>( mat, t, tv, i, scale );  break;
+      case 5:  evaluateBSp2<5>( mat, t, tv, i, scale );  break;
+      default: evaluateBSp2Generic( mat, t, tv, d, i, scale );
+      }
+  }
+
+
+
+  template <typename T>
+  template <int d>                  // Same as evaluateBSp2Generic, but with a given degree
+  void EvaluatorStatic<T>::evaluateBSp2( DMatrix<T>& mat, T t, const DVector<T>& tv, int ii, T scale ){
+
+      static_assert( d > 0, "The degree must be at least 1" );
+
+      // The matrix is computed in local storage, so the compiler can unroll the loops
+      // and keep the values in registers, and then copied to the result matrix.
+      T m[d+1][d+1];
+      T w[d];
+
+      m[d-1][1] = getW( tv, t, ii, 1 );
+      m[d-1][0] = 1 - m[d-1][1];
+
+      GM_EVALUATOR_UNROLL
+      for( int i = d - 2, k = 2; i >= 0; i--, k++ ) {
+          GM_EVALUATOR_UNROLL
+          for( int j = 0; j < k; j++ )
+              w[j] = getW( tv, t, ii-k+j+1, k );
+
+          m[i][0] = ( 1 - w[0]) * m[i+1][0];
+          GM_EVALUATOR_UNROLL
+          for( int j = 1; j < d - i; j++ )
+              m[i][j] = w[j-1] * m[i+1][j-1] + (1 - w[j]) * m[i+1][j];
+          m[i][d-i] = w[k-1] * m[i+1][d-i-1];
+      }
+
+      m[d][1] =  delta( tv, ii, 1, scale );
+      m[d][0] = -m[d][1];
+
+      GM_EVALUATOR_UNROLL
+      for( int k = 2; k <= d; k++ ) {
+          GM_EVALUATOR_UNROLL
+          for( int j = 0; j < k; j++ )
+              w[j] = k * delta( tv, ii-k+j+1, k, scale);
+
+          GM_EVALUATOR_UNROLL
+          for( int i = d; i > d - k; i--) {
+              m[i][k] = w[k-1] * m[i][k-1];
+              GM_EVALUATOR_UNROLL
+              for( int j = k - 1; j > 0; j--)
+                  m[i][j] = w[j-1]*m[i][j-1] - w[j]*m[i][j] ;
+              m[i][0] = - w[0] * m[i][0];
+          }
+      }
+
+      mat.setDim( d+1, d+1 );
+      GM_EVALUATOR_UNROLL
+      for( int i = 0; i <= d; i++ ) {
+          GM_EVALUATOR_UNROLL
+          for( int j = 0; j <= d; j++ )
+              mat[i][j] = m[i][j];
+      }
+  }
+
+
+
+  template <typename T>
+  void EvaluatorStatic<T>::evaluateBSp2Generic( DMatrix<T>& mat, T t, const DVector<T>& tv, int d, int ii, T scale ){
 
       // Knot-index ii must be: tv[ii] <= t <  tv[ii+1] if right-evaluation
       // else                   tv[ii] <  t <= tv[ii+1] if left-evaluation
 
       // For the linar factor - mapping the knot intervalls to [0,1].
-      DVector<T> w(d);
+      // Kept per thread so high degrees do not allocate on every call.
+      static thread_local DVector<T> w;
+      w.setDim(d);
 
       // Compute the B-splines (polynomials), degree 1 -> d, one for each row.
       // Starts from the second bottom row (degree 1), then goes upwards (degree 2,...,d).
@@ -280,3 +434,6 @@ void EvaluatorStatic<T>::evaluateBhp( DMatrix<T>& mat, int d, T t, T scale ) {
   }
 
 } // END namespace GMlib
+
+
+#undef GM_EVALUATOR_UNROLL
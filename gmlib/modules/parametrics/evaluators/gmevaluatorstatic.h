@@ -40,6 +40,16 @@ namespace GMlib {
     static int  evaluateBSp( DMatrix<T>& mat, T t, const DVector<T>& tv, int d, bool left = true, T scale = 1  );
     static void evaluateBSp2( DMatrix<T>& mat, T t, const DVector<T>& tv, int d, int i, T scale = 1 );
 
+    // Kernels for a given (compile time) degree, selected by the functions above for degree 1-5
+    template <int d>
+    static void evaluateBhp( DMatrix<T>& mat, T t, T scale = 1 );
+    template <int d>
+    static void evaluateBSp2( DMatrix<T>& mat, T t, const DVector<T>& tv, int i, T scale = 1 );
+
+    // Kernels for any (run time) degree
+    static void evaluateBhpGeneric( DMatrix<T>& mat, int degree, T t, T scale = 1 );
+    static void evaluateBSp2Generic( DMatrix<T>& mat, T t, const DVector<T>& tv, int d, int i, T scale = 1 );
+
     static void evaluateH3d( DMatrix<T>& mat, int d, T t );
     static void evaluateH5d( DMatrix<T>& mat, int d, T t );
 
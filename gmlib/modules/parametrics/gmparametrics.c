@@ -31,6 +31,12 @@ namespace GMlib {
   Parametrics<T,m,n>::Parametrics() {
 
     _dm = GM_DERIVATION_EXPLICIT;
+    _adapt_eps   = T(0);
+    _adapt_angle = T(0);
+    _adapt_max   = 4096;
+    _lod_pixels    = 8.0f;
+    _lod_no_cached = 3;
+    _lod_level     = -1;
     _initSoType();
   }
 
@@ -38,8 +44,19 @@ namespace GMlib {
 
   template <typename T, int m, int n>
   inline
-  Parametrics<T,m,n>::Parametrics( const Parametrics<T,m,n>& copy )
-    : SceneObject( copy ), _dm{copy._dm}, _A{copy._A} {}
+  Parametrics<T,m,n>::Parametrics( const Parametrics<T,m,n>& copy ) : Parametrics( copy, true ) {}
+
+
+
+  /*! Parametrics<T,m,n>::Parametrics( const Parametrics<T,m,n>& copy, bool children )
+   *  Copy constructor, the children are only copied if children is true.
+   */
+  template <typename T, int m, int n>
+  inline
+  Parametrics<T,m,n>::Parametrics( const Parametrics<T,m,n>& copy, bool children )
+    : SceneObject( static_cast<const SceneObject&>( copy ), children ), _dm{copy._dm}, _adapt_eps{copy._adapt_eps}, _adapt_angle{copy._adapt_angle},
+      _adapt_max{copy._adapt_max}, _lod_size{copy._lod_size}, _lod_pixels{copy._lod_pixels}, _lod_no_cached{copy._lod_no_cached},
+      _lod_level{-1}, _A{copy._A} {}
 
 
 
@@ -81,5 +98,82 @@ namespace GMlib {
 
 
 
+  /*! void Parametrics<T,m,n>::setAdaptiveSampling( T eps, T angle, int max_samples )
+   *  Turns on adaptive sampling for the next sample(), eps = 0 turns it off.
+   *  The number of samples given to sample() is then the initial (minimum) number
+   *  of samples, intervals are split until the chordal deviation is less than eps and
+   *  the turning angle of the sample polyline is less than angle.
+   *
+   *  \param[in] eps          Chordal deviation tolerance
+   *  \param[in] angle        Angle tolerance in radians, 0 to only use the chordal deviation
+   *  \param[in] max_samples  Maximum number of samples in each direction
+   */
+  template <typename T, int m, int n>
+  void Parametrics<T,m,n>::setAdaptiveSampling( T eps, T angle, int max_samples ) {
+
+    _adapt_eps   = eps;
+    _adapt_angle = angle;
+    _adapt_max   = max_samples;
+  }
+
+
+
+  template <typename T, int m, int n>
+  inline
+  bool Parametrics<T,m,n>::isAdaptiveSampling() const {
+
+    return _adapt_eps > T(0);
+  }
+
+
+
+  template <typename T, int m, int n>
+  inline
+  int Parametrics<T,m,n>::getLodLevel() const {
+
+    return _lod_level;
+  }
+
+
+
+  /*! int Parametrics<T,m,n>::selectLodLevel( float radius ) const
+   *  Selects the coarsest level of detail giving at most _lod_pixels pixels
+   *  between the samples, when the object is seen with the given radius on the screen.
+   *  To avoid switching back and forth, a coarser level than the current
+   *  is only selected if it is at least 25% finer than needed.
+   *
+   *  \param[in] radius  The projected radius of the surrounding sphere, in pixels
+   *  \return The level of detail, -1 if there are no levels
+   */
+  template <typename T, int m, int n>
+  int Parametrics<T,m,n>::selectLodLevel( float radius ) const {
+
+    if( _lod_size.empty() ) return -1;
+
+    auto find = [this]( float wanted ) {
+      int l = 0;
+      while( l+1 < int(_lod_size.size()) && float(_lod_size[l]) < wanted ) l++;
+      return l;
+    };
+
+    const float wanted = 2.0f * radius / _lod_pixels;
+    int l = find( wanted );
+    if( l < _lod_level ) l = std::min( _lod_level, find( 1.25f * wanted ) );
+    return l;
+  }
+
+
+
+  template <typename T, int m, int n>
+  void Parametrics<T,m,n>::localUpdateLod( const Camera& cam ) {
+
+    if( _lod_size.empty() ) return;
+
+    const int level = selectLodLevel( cam.getProjectedRadius( this->getSurroundingSphere() ) );
+    if( level != _lod_level ) setLodLevel( level );
+  }
+
+
+
 
 } // END namespace GMlib
@@ -33,9 +33,12 @@
 // gmlib
 #include <core/containers/gmarray.h>
 #include <scene/gmsceneobject.h>
+#include <scene/camera/gmcamera.h>
 #include <scene/utils/gmmaterial.h>
 
 // stl
+#include <algorithm>
+#include <queue>
 #include <string>
 
 
@@ -54,7 +57,8 @@ namespace GMlib {
 
   enum GM_RESAMPLE_MODE {
     GM_RESAMPLE_INLINE,
-    GM_RESAMPLE_PREEVAL
+    GM_RESAMPLE_PREEVAL,
+    GM_RESAMPLE_FIXED_GRID
   };
 
   enum GM_DERIVATION_METHOD {
@@ -78,11 +82,31 @@ namespace GMlib {
 
     void                        setDerivationMethod( GM_DERIVATION_METHOD method );
 
+    void                        setAdaptiveSampling( T eps, T angle = T(0.2), int max_samples = 4096 );
+    bool                        isAdaptiveSampling() const;
+
+    int                         getLodLevel() const;
+    int                         selectLodLevel( float radius ) const;
+    virtual void                setLodLevel( int /*level*/ ) {}
+
   protected:
     GM_DERIVATION_METHOD        _dm;
 
+    T                           _adapt_eps;     //! Chordal deviation tolerance for adaptive sampling (0 - uniform sampling)
+    T                           _adapt_angle;   //! Angle tolerance (radians) for adaptive sampling (0 - not used)
+    int                         _adapt_max;     //! Maximum number of samples (in each direction) for adaptive sampling
+
+    std::vector<int>            _lod_size;      //! Largest number of samples (in one direction) of each level of detail, ascending
+    float                       _lod_pixels;    //! Wanted distance in pixels between the samples on the screen
+    int                         _lod_no_cached; //! Number of recently used levels of detail to keep the samples of
+    int                         _lod_level;     //! The current level of detail (-1 - no level)
+
+    void                        localUpdateLod( const Camera& cam ) override;
+
     HqMatrix<T,m>               _A;   //! Domain transition
 
+    Parametrics( const Parametrics<T,m,n>& copy, bool children );
+
   private:
     void                        _initSoType();
 
@@ -145,7 +169,7 @@ namespace GMlib {
             this->push_back(i);
             for(++i; i <= n; i++) {
                 int j=1;
-                while (eq(t(i+j), t(i))) ++j;
+                while (i+j < t.getDim() && eq(t(i+j), t(i))) ++j;
                 if(i+j-1 >= n) {
                     this->push_back(i);
                     break;
@@ -396,6 +420,104 @@ namespace GMlib {
     }
 
 
+    /*! void computeAdaptiveParamVal( std::vector<T>& sample, int m, T s, T e, int m_max, ErrorFunc error )
+     *  Adaptive parameter values in [s,e].
+     *  Starting with m uniform values, the interval with the largest error is split in two
+     *  until no interval has an error larger than 1, or there are m_max values.
+     *
+     *  \param[out] sample   The parameter values, increasing
+     *  \param[in]  m        Number of initial (uniform) values
+     *  \param[in]  s        Start parameter value
+     *  \param[in]  e        End parameter value
+     *  \param[in]  m_max    Maximum number of values
+     *  \param[in]  error    The error of an interval, called as error(a,b), scaled so 1 is the tolerance
+     */
+    template <typename T, typename ErrorFunc>
+    void computeAdaptiveParamVal( std::vector<T>& sample, int m, T s, T e, int m_max, ErrorFunc error ) {
+
+        computeUniformParamVal( sample, m, s, e );
+        refineAdaptiveParamVal( sample, m_max, error );
+    }
+
+
+    /*! int refineAdaptiveParamVal( std::vector<T>& sample, int m_max, ErrorFunc error )
+     *  As computeAdaptiveParamVal(), but splitting the intervals of the given parameter values.
+     *
+     *  \param[in,out] sample   The parameter values, increasing
+     *  \param[in]     m_max    Maximum number of values
+     *  \param[in]     error    The error of an interval, called as error(a,b), scaled so 1 is the tolerance
+     *  \return                 The number of values added
+     */
+    template <typename T, typename ErrorFunc>
+    int refineAdaptiveParamVal( std::vector<T>& sample, int m_max, ErrorFunc error ) {
+
+        struct Interval {
+            T a, b, err;
+            bool operator < ( const Interval& o ) const { return err < o.err; }
+        };
+
+        const int m = int(sample.size());
+
+        std::priority_queue<Interval> q;
+        for( int i = 1; i < m; i++ )
+            q.push( { sample[i-1], sample[i], error( sample[i-1], sample[i] ) } );
+
+        while( !q.empty() && int(sample.size()) < m_max && q.top().err > T(1) ) {
+            const Interval iv = q.top();
+            q.pop();
+            const T c = (iv.a + iv.b) / 2;
+            sample.push_back( c );
+            q.push( { iv.a, c, error( iv.a, c ) } );
+            q.push( { c, iv.b, error( c, iv.b ) } );
+        }
+
+        std::sort( sample.begin(), sample.end() );
+        return int(sample.size()) - m;
+    }
+
+
+    /*! T polylineError( const Point<T,n>* p, int k, T eps, T angle )
+     *  The error of approximating a curve segment by its chord, from k points
+     *  on the segment (p[0] and p[k-1] are the end points).
+     *  The error is the largest of the chordal deviation divided by eps, and the largest
+     *  turning angle of the polyline p divided by angle (not used if angle is 0).
+     *  The angle is not used for segments shorter than eps, they can not be seen
+     *  (and at a cusp the angle is not reduced by splitting).
+     */
+    template <typename T, int n>
+    T polylineError( const Point<T,n>* p, int k, T eps, T angle ) {
+
+        const Vector<T,n> c  = p[k-1] - p[0];
+        const T           cc = c*c;
+
+        T len = T(0);
+        for( int i = 1; i < k; i++ )
+            len += (p[i] - p[i-1]).getLength();
+
+        T err = T(0);
+        for( int i = 1; i < k-1; i++ ) {
+            Vector<T,n> w = p[i] - p[0];
+            if( cc > T(0) )
+                w -= ((w*c)/cc) * c;
+            err = std::max( err, w.getLength() / eps );
+        }
+
+        if( angle > T(0) && len > eps )
+            for( int i = 1; i < k-1; i++ ) {
+                const Vector<T,n> a = p[i] - p[i-1];
+                const Vector<T,n> b = p[i+1] - p[i];
+                const T la = a.getLength();
+                const T lb = b.getLength();
+                if( la > T(0) && lb > T(0) ) {
+                    const T cs = std::max( T(-1), std::min( T(1), (a*b) / (la*lb) ) );
+                    err = std::max( err, T(std::acos(cs)) / angle );
+                }
+            }
+
+        return err;
+    }
+
+
     template <typename T>
     inline
     int getIntervallInVector( const std::vector<T>& t ) {
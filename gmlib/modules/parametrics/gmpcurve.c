@@ -29,7 +29,9 @@
 #include <core/utils/gmdivideddifferences.h>
 
 // stl
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace GMlib {
 
@@ -56,6 +58,10 @@ namespace GMlib {
 
     this->_lighted       = false;
     _local_pre_eval      = false;
+    _async               = false;
+    _arc_table           = false;
+    _arc_mutex           = std::make_shared<std::mutex>();
+    _clp_dirty           = true;
   }
 
 
@@ -70,7 +76,23 @@ namespace GMlib {
    */
   template <typename T, int n>
   inline
-  PCurve<T,n>::PCurve( const PCurve<T,n>& copy ) : Parametrics<T,1,n>( copy ), _visu(1), _der_implemented(copy._der_implemented) {
+  PCurve<T,n>::PCurve( const PCurve<T,n>& copy ) : PCurve( copy, true ) {}
+
+
+
+
+
+  /*! PCurve<T,n>::PCurve( const PCurve<T,n>& copy, bool children )
+   *  Copy constructor, the children are only copied if children is true.
+   *  Used by makeSnapshot() in curves with local curves as children.
+   *
+   *  \param[in]  copy      The curve to copy
+   *  \param[in]  children  Whether to copy the children
+   */
+  template <typename T, int n>
+  inline
+  PCurve<T,n>::PCurve( const PCurve<T,n>& copy, bool children )
+    : Parametrics<T,1,n>( copy, children ), _visu(1), _der_implemented(copy._der_implemented) {
 
     _visu.no_sample      = copy._visu.no_sample;
     _visu.no_derivatives = copy._visu.no_derivatives;
@@ -81,6 +103,10 @@ namespace GMlib {
     _sc                  = copy._sc;
     _is_scaled           = copy._is_scaled;
     _local_pre_eval      = copy._local_pre_eval;
+    _async               = copy._async;
+    _arc_table           = copy._arc_table;
+    _arc_mutex           = std::make_shared<std::mutex>();
+    _clp_dirty           = true;
 
     _sampler             = &_visu;
     setNoDer(2);
@@ -97,6 +123,9 @@ namespace GMlib {
   template <typename T, int n>
   PCurve<T,n>::~PCurve() {
 
+    cancelAsyncReplot();
+    _releaseCancelled( true );
+
 //    enableDefaultVisualizer( false );
 //    if( _default_visualizer )
 //      delete _default_visualizer;
@@ -227,7 +256,7 @@ namespace GMlib {
   template <typename T, int n>
   DVector<Vector<T,n>>& PCurve<T,n>::evaluateParent( int i, int j ) const {
 
-      static DVector< Vector<T,n> > p;
+      static thread_local DVector< Vector<T,n> > p;
       uint k = getSample_d(i,j);
       p.setDim(k);
 
@@ -248,6 +277,95 @@ namespace GMlib {
 
 
 
+  /*! void PCurve<T,n>::evaluate( DVector<Vector<T,n>>& p, T t, int d, bool left ) const
+   *  Reentrant evaluator for the curve
+   *  Computing values in local coordinate system.
+   *  The result is only written to p, nothing in the curve is changed,
+   *  so different threads can evaluate the same curve at the same time.
+   *
+   *  \param[out] p     Position and d-derivatives in local coordinates
+   *  \param[in]  t     The parameter value to compute at
+   *  \param[in]  d     The number of derivatives to compute
+   *  \param[in]  left  (default true) Compute from left or right side of t
+   */
+  template <typename T, int n>
+  inline
+  void PCurve<T,n>::evaluate( DVector<Vector<T,n>>& p, T t, int d, bool left ) const {
+
+    eval( p, _map(t), d, left );
+    if(_is_scaled) _corrEval(p, _sc, d);
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::evaluate( Vector<T,n>* p, const T* t, int m, int d, bool left ) const
+   *  Reentrant batch evaluator for the curve
+   *  Computing values in local coordinate system for m parameter values.
+   *  The result is packed with one row of m elements for each derivative,
+   *  i.e. the k-th derivative at t[i] is p[k*m+i].
+   *
+   *  \param[out] p     Positions and d-derivatives in local coordinates, (d+1)*m elements
+   *  \param[in]  t     The m parameter values to compute at
+   *  \param[in]  m     The number of parameter values
+   *  \param[in]  d     The number of derivatives to compute
+   *  \param[in]  left  (default true) Compute from left or right side of t
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::evaluate( Vector<T,n>* p, const T* t, int m, int d, bool left ) const {
+
+    // The mapped parameter values are local to the call, since an evalBatch()
+    // may itself batch-evaluate other curves of the same type (e.g. local curves)
+    std::vector<T> tm(m);
+    for( int i = 0; i < m; i++ )
+      tm[i] = _map(t[i]);
+
+    evalBatch( p, tm.data(), m, d, left );
+
+    if(_is_scaled)
+      for( int j = 1; j <= d; j++ )
+        for( int k = j; k <= d; k++ )
+          for( int i = 0; i < m; i++ )
+            p[k*m+i] /= _sc;
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::evaluateParent( DVector<Vector<T,n>>& p, T t, int d, bool left ) const
+   *  Reentrant evaluator for the curve
+   *  Computing values in parent coordinate system.
+   *  The result is only written to p, nothing in the curve is changed,
+   *  so different threads can evaluate the same curve at the same time.
+   *
+   *  \param[out] p     Position and d-derivatives in the coordinate system of the parent
+   *  \param[in]  t     The parameter value to compute at
+   *  \param[in]  d     The number of derivatives to compute
+   *  \param[in]  left  (default true) Compute from left or right side of t
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::evaluateParent( DVector<Vector<T,n>>& p, T t, int d, bool left ) const {
+
+    evaluate( p, t, d, left );
+    const HqMatrix<T,3> mat = this->_matrix.template toType<T>();
+
+    if(this->_scale.isActive()) {
+      const Point<T,3> sc = this->_scale.getScale();
+      for(int i=0; i<p.getDim(); i++)
+        p[i] %= sc;
+    }
+
+    p[0] = mat * p[0].toPoint();
+    for( int i = 1; i < p.getDim(); i++ )
+      p[i] = mat * p[i];
+  }
+
+
+
+
+
   /*! void PCurve<T,n>::estimateClpPar( const Point<T,n>& p, T& t, int m) const
    *  To estimate parameter value for closest point
    *  To be used before getClosestPoint if we do not have a good guess
@@ -312,6 +430,98 @@ namespace GMlib {
 
 
 
+  /*! int PCurve<T,n>::getClosestPoints( const Point<T,n>* q, int m, T* t, T* dist, bool* converged,
+   *                                     double eps, int max_iterations, int no_threads ) const
+   *  Closest points on the curve for m points (in local coordinates, as getClosestPoint()).
+   *  The start guess of each point is the nearest sample, found in a k-d tree over the samples
+   *  of all partitions (over 30 samples if the curve is not sampled). The tree is made again the
+   *  first time it is used after the samples have changed (see invalidateArcLength()).
+   *  Making it is not thread safe, the queries are.
+   *  The Newton iterations are then done in parallel. The parameter is kept in the domain,
+   *  or wrapped around if the curve is closed. If Newton ends farther away than the start guess,
+   *  the start guess is returned and the point is reported as not converged.
+   *
+   *  \param[in]  q               The m points
+   *  \param[in]  m               Number of points
+   *  \param[out] t               The m parameter values of the closest points
+   *  \param[out] dist            (default nullptr) The m distances to the curve, if not nullptr
+   *  \param[out] converged       (default nullptr) Whether each iteration converged, if not nullptr
+   *  \param[in]  eps             (default 10e-6) The tolerance (in parametric space)
+   *  \param[in]  max_iterations  (default 20) The maximum number of iterations for each point
+   *  \param[in]  no_threads      (default 0) Number of threads, 0 uses all cores
+   *  \return The number of points that converged
+   */
+  template <typename T, int n>
+  int PCurve<T,n>::getClosestPoints( const Point<T,n>* q, int m, T* t, T* dist, bool* converged,
+                                     double eps, int max_iterations, int no_threads ) const {
+
+    // The samples to find the start guesses in
+    if( _clp_dirty ) {
+      std::vector<Point<T,n>> sp;
+      _getClpSamples( sp, _clp_par );
+      _clp_tree.build( sp.data(), int(sp.size()) );
+      _clp_dirty = false;
+    }
+    const KdTree<T,n>&    tree = _clp_tree;
+    const std::vector<T>& spar = _clp_par;
+
+    const T    s      = getParStart();
+    const T    e      = getParEnd();
+    const bool closed = isClosed();
+
+    std::atomic<int> no_converged(0);
+    Parallel::forBlocks( 0, m, [&]( int b, int en ) {
+
+      DVector<Vector<T,n>> c;
+      int nc = 0;
+      for( int i = b; i < en; i++ ) {
+
+        T d2;
+        const int k = tree.findNearest( q[i], d2 );
+        T x = spar[k];
+
+        bool ok = false;
+        for( int it = 0; it < max_iterations && !ok; it++ ) {
+
+          evaluate( c, x, 2 );
+          const T den = (c[0] - q[i]) * c[2] + c[1] * c[1];
+          if( den == T(0) ) break;
+
+          T y = x - ( (c[0] - q[i]) * c[1] ) / den;
+          if( closed ) {
+            y = s + std::fmod( y - s, e - s );
+            if( y < s ) y += e - s;
+          }
+          else
+            y = std::max( s, std::min( e, y ) );
+          ok = std::abs(y - x) <= eps;
+          x  = y;
+        }
+
+        evaluate( c, x, 0 );
+        const Vector<T,n> w = q[i] - c[0];
+        T l2 = w*w;
+        if( l2 > d2 ) {
+          x  = spar[k];
+          l2 = d2;
+          ok = false;
+        }
+
+        t[i] = x;
+        if( dist )      dist[i]      = std::sqrt( l2 );
+        if( converged ) converged[i] = ok;
+        if( ok )        nc++;
+      }
+      no_converged += nc;
+    }, no_threads );
+
+    return no_converged;
+  }
+
+
+
+
+
   /*! T PCurve<T,n>::getCurvature( T t ) const
    *  To compute the curvature at a given parameter value
    *
@@ -373,7 +583,9 @@ namespace GMlib {
 
   /*! T PCurve<T,n>::getCurveLength( T a , T b ) const
    *  To compute the curve length on the curve c, from c(a) to c(b)
-   *  Numerical integration is used (Romberg integration)
+   *  Numerical integration is used (adaptive Gauss-Legendre quadrature, see getParAtLength()),
+   *  or with setArcLengthTable() the length is looked up in the arc length table,
+   *  the parameter values are then clamped to the domain of the curve.
    *
    *  \param[in]  a   The parameter value at start
    *  \param[in]  b   The parameter value at end
@@ -383,12 +595,86 @@ namespace GMlib {
   inline
   T PCurve<T,n>::getCurveLength( T a , T b ) const {
 
+    if( _arc_table ) {
+      const std::shared_ptr<const ArcTable> arc = _updateArcLength();
+      if(b<a) return arc->s.back();
+
+      return _arcLength( arc->t, arc->s, b ) - _arcLength( arc->t, arc->s, a );
+    }
+
     if(b<a)	{
       a = getParStart();
       b = getParEnd();
     }
 
-    return _integral( a, b, 1e-10 );
+    std::vector<T> at, as;
+    _makeArcLength( at, as, a, b );
+    return as.back();
+  }
+
+
+
+
+
+  /*! T PCurve<T,n>::getParAtLength( T s ) const
+   *  The parameter value where the curve length from the start of the curve is s,
+   *  e.g. to move along the curve with constant speed.
+   *
+   *  The arc length is tabulated: Gauss-Legendre quadrature over intervals subdivided
+   *  until the result is within 1e-10, summed up from the start. The inverse is found by a
+   *  binary search in the table and safeguarded Newton iteration in one interval.
+   *  Without setArcLengthTable() the table is made for each call.
+   *
+   *  \param[in]  s   The curve length, clamped to [0, getCurveLength()]
+   *  \return         The parameter value
+   */
+  template <typename T, int n>
+  T PCurve<T,n>::getParAtLength( T s ) const {
+
+    if( _arc_table ) {
+      const std::shared_ptr<const ArcTable> arc = _updateArcLength();
+      return _parAtLength( arc->t, arc->s, s );
+    }
+
+    std::vector<T> at, as;
+    _makeArcLength( at, as, getParStart(), getParEnd() );
+    return _parAtLength( at, as, s );
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::setArcLengthTable( bool table )
+   *  Keeps an arc length table for getCurveLength() and getParAtLength(), made the first
+   *  time it is used after the curve is sampled, replotted or the domain is changed.
+   *  A lookup is then a binary search and quadrature over a part of one interval.
+   *  Shape changes that are not followed by sample() or replot(), e.g. PCircle::setRadius(),
+   *  must be followed by invalidateArcLength().
+   *
+   *  getCurveLength() and getParAtLength() may be called from several threads, also while
+   *  invalidateArcLength() is called: each call uses the table that was current when it started,
+   *  and an outdated table is kept alive until the calls using it have returned.
+   *  Changing the curve itself while it is queried is not thread safe.
+   *
+   *  \param[in]  table  Whether to keep the table, the default is to integrate on each call
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::setArcLengthTable( bool table ) {
+
+    _arc_table = table;
+    invalidateArcLength();
+  }
+
+
+
+
+
+  template <typename T, int n>
+  inline
+  bool PCurve<T,n>::isArcLengthTable() const {
+
+    return _arc_table;
   }
 
 
@@ -618,6 +904,31 @@ namespace GMlib {
 
 
 
+  /*! void PCurve<T,n>::getSampleParameters( std::vector<T>& t ) const
+   *  The parameter values of the samples of all partitions,
+   *  sorted and without duplicates. Empty if the curve is not sampled.
+   *
+   *  \param[out] t  The parameter values
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::getSampleParameters( std::vector<T>& t ) const {
+
+    t.clear();
+
+    unsigned int k = _visu.size();
+    if(k>1 && _local_pre_eval) k--;
+
+    for( unsigned int i = 0; i < k; i++ )
+      t.insert( t.end(), _visu[i].begin(), _visu[i].end() );
+
+    std::sort( t.begin(), t.end() );
+    t.erase( std::unique( t.begin(), t.end() ), t.end() );
+  }
+
+
+
+
+
   /*! Point<T,n>  PCurve<T,n>::getSamplePoint(int i, int j) const
    *  Return the sample values for a given partition "j" and point nr. "i"
    *
@@ -710,7 +1021,7 @@ namespace GMlib {
 
   /*! void PCurve<T,n>::preSample( Partition& v, int m, int d, T s, T e ) const
    *  Pre sampling function.
-   *  First  "m" uniform  sample parameter values is computed,
+   *  First  "m" uniform  sample parameter values is computed (or adaptive, see makeSampleValues()),
    *  then  the resample is done, including creating the surounding sphere
    *
    *  \param[out] v   The partition to uppdate with samples
@@ -723,8 +1034,9 @@ namespace GMlib {
   inline
   void PCurve<T,n>::preSample( Partition& v, int m, int d, T s, T e ) const {
 
-      computeUniformParamVal(v, m, s, e);
+      makeSampleValues(v, m, s, e);
       resample( v, d);
+      invalidateArcLength();
       this->setEditDone();
   }
 
@@ -748,6 +1060,7 @@ namespace GMlib {
       if(i< _visu.size()) {
         _visu[i] = sample;
         resample( _visu[i], d);
+        invalidateArcLength();
         this->setEditDone();
       } else
           std::cerr << "Wrong partition number !!";
@@ -786,6 +1099,447 @@ namespace GMlib {
   template <typename T, int n>
   void  PCurve<T,n>::replot() const {
 
+      // The shape is changed, the samples of the other levels of detail are outdated
+      clearLodCache();
+      invalidateArcLength();
+      if( _async ) _replotAsync();
+      else {
+          restartAsyncReplot();
+          _replot();
+      }
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::setLodLevels( const std::vector<int>& levels, float pixels, int no_cached )
+   *  Turns on level of detail, an empty vector turns it off.
+   *  For each frame the level is selected such that the distance between the samples on the
+   *  screen is about the given number of pixels, see Parametrics::selectLodLevel().
+   *  The samples of the most recently used levels are kept, and are swapped in
+   *  without resampling when the level is used again.
+   *
+   *  \param[in] levels     Number of samples of each level, from coarse to fine
+   *  \param[in] pixels     Wanted distance between the samples on the screen
+   *  \param[in] no_cached  Number of levels to keep the samples of, in addition to the current
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::setLodLevels( const std::vector<int>& levels, float pixels, int no_cached ) {
+
+      this->_lod_size      = levels;
+      this->_lod_pixels    = pixels;
+      this->_lod_no_cached = no_cached;
+      this->_lod_level     = -1;
+      clearLodCache();
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::setLodLevel( int level )
+   *  Changes the samples to the given level of detail.
+   *  The samples of the current level are cached. The samples of the new level are
+   *  swapped in at once if they are in the cache, else the level is sampled in the background
+   *  (see setAsyncReplot()) and the current level is drawn until swapAsyncReplot() swaps it in.
+   *  The curve is sampled at once if makeSnapshot() gives no copy.
+   *
+   *  \param[in] level  The level of detail, index in the vector given to setLodLevels()
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::setLodLevel( int level ) {
+
+      if( level < 0 || level >= int(this->_lod_size.size()) ) return;
+
+      // Back to the current level, a pending change of level is dropped
+      if( level == this->_lod_level ) {
+          if( _async_replot && _async_replot->level >= 0 ) cancelAsyncReplot();
+          return;
+      }
+      if( _async_replot && _async_replot->level == level ) return;
+
+      // The current samples are outdated if a resampling is pending
+      const bool keep = !_async_replot || _async_replot->keep;
+
+      auto it = _lod_cache.begin();
+      while( it != _lod_cache.end() && it->level != level ) ++it;
+
+      if( it != _lod_cache.end() && it->parts.size() == _visu.size() ) {
+          std::vector<Partition> parts;
+          parts.swap( it->parts );
+          _lod_cache.erase( it );
+          cancelAsyncReplot();
+          _swapLod( level, parts, keep );
+          return;
+      }
+      if( it != _lod_cache.end() ) _lod_cache.erase( it );
+
+      if( _startAsync( level, keep ) ) return;
+
+      // No copy to sample in the background
+      std::vector<Partition> parts;
+      _swapLod( level, parts, keep );
+  }
+
+
+
+
+
+  template <typename T, int n>
+  inline
+  void PCurve<T,n>::clearLodCache() const {
+
+      _lod_cache.clear();
+  }
+
+
+
+
+  /*! void PCurve<T,n>::invalidateArcLength() const
+   *  The shape or the domain is changed, the arc length table (see setArcLengthTable()) and the
+   *  k-d tree of getClosestPoints() are made again the next time they are used. Done by sample(), replot() and setDomain(),
+   *  curves that update the samples in other ways must call it.
+   *  Curves with control points also call it when these are set or edited, so the length is right
+   *  before the next replot().
+   */
+  template <typename T, int n>
+  inline
+  void PCurve<T,n>::invalidateArcLength() const {
+
+    std::lock_guard<std::mutex> lock( *_arc_mutex );
+    _arc.reset();
+    _clp_dirty = true;
+  }
+
+
+
+
+
+
+  template <typename T, int n>
+  void PCurve<T,n>::localUpdateLod( const Camera& cam ) {
+
+      swapAsyncReplot();
+      Parametrics<T,1,n>::localUpdateLod( cam );
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::setAsyncReplot( bool async )
+   *  In async mode replot() resamples all partitions on a worker thread (Parallel::WorkerPool::getDefault())
+   *  into a back buffer, and returns at once. The visualizers keep the previous samples until the
+   *  finished samples are swapped in by swapAsyncReplot(), which is done before rendering the next frame.
+   *  A new replot() cancels the previous resampling.
+   *  The job samples a copy of the evaluation state of the curve made by makeSnapshot() when it is started,
+   *  so the curve can be edited while the job is running. Objects the curve only refers to are not copied,
+   *  and must not be changed while a resampling is pending.
+   *  Curves makeSnapshot() gives no copy of are replotted at once.
+   *
+   *  \param[in] async  Whether to resample in the background
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::setAsyncReplot( bool async ) {
+
+      _async = async;
+      if( !async && _async_replot && _async_replot->level < 0 ) cancelAsyncReplot();
+  }
+
+
+
+
+
+  template <typename T, int n>
+  inline
+  bool PCurve<T,n>::isAsyncReplot() const {
+
+      return _async;
+  }
+
+
+
+
+
+  template <typename T, int n>
+  inline
+  bool PCurve<T,n>::isAsyncReplotPending() const {
+
+      return bool(_async_replot);
+  }
+
+
+
+
+
+  /*! bool PCurve<T,n>::swapAsyncReplot()
+   *  Swaps in the samples of a finished background resampling, and gives them to the visualizers.
+   *  The samples are dropped if the curve has been sampled with another number of samples since the job was started.
+   *
+   *  \return True if samples were swapped in, false if there were none or the resampling is not done
+   */
+  template <typename T, int n>
+  bool PCurve<T,n>::swapAsyncReplot() {
+
+      _releaseCancelled();
+      if( !_async_replot || !_async_replot->job->isDone() ) return false;
+
+      std::shared_ptr<AsyncReplot> rep;
+      rep.swap( _async_replot );
+
+      if( rep->level >= 0 ) {
+          if( rep->parts.size() != _visu.size() ) rep->parts.clear();
+          _swapLod( rep->level, rep->parts, rep->keep );
+          return true;
+      }
+
+      if( rep->parts.size() != _visu.size() || rep->m != _visu.no_sample ) return false;
+
+      for( unsigned int i = 0; i < _visu.size(); i++ )
+          _swapSamples( rep->parts[i], _visu[i] );
+      _replot();
+      return true;
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::waitAsyncReplot() const
+   *  Waits until the background resampling is done, the samples are not swapped in.
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::waitAsyncReplot() const {
+
+      if( _async_replot ) _async_replot->job->join();
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::_replotAsync() const
+   *  Private, starts the background resampling of all partitions,
+   *  at the same parameter values and with the same number of derivatives as now.
+   *  A pending change of level of detail is started again, on the edited curve.
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::_replotAsync() const {
+
+      const int level = _async_replot ? _async_replot->level : -1;
+      if( !_startAsync( level, false ) ) _replot();
+  }
+
+
+
+
+
+  /*! bool PCurve<T,n>::_startAsync( int level, bool keep ) const
+   *  Private, cancels the pending resampling and starts a new on a snapshot of the curve (makeSnapshot()).
+   *  For level -1 the current partitions are resampled, else the copy is sampled with
+   *  the number of samples of the level.
+   *
+   *  \param[in] level  The level of detail to sample, -1 to resample the current parameter values
+   *  \param[in] keep   Whether the current samples are to be cached when the level is swapped in
+   *  \return False if the curve could not be copied, nothing is then started
+   */
+  template <typename T, int n>
+  bool PCurve<T,n>::_startAsync( int level, bool keep ) const {
+
+      cancelAsyncReplot();
+
+      std::shared_ptr<AsyncReplot> rep = std::make_shared<AsyncReplot>();
+      rep->curve.reset( makeSnapshot() );
+      if( !rep->curve ) return false;
+
+      rep->level = level;
+      rep->keep  = keep;
+      rep->m     = level < 0 ? _visu.no_sample : this->_lod_size[level];
+      const int m = rep->m;
+      const int d = _visu.no_derivatives;
+
+      if( level < 0 ) {
+          rep->parts.resize( _visu.size() );
+          for( unsigned int i = 0; i < _visu.size(); i++ ) {
+              rep->parts[i]     = static_cast<const std::vector<T>&>( _visu[i] );
+              rep->parts[i].s_e = _visu[i].s_e;
+          }
+      }
+
+      // The job does not own rep, so the snapshot is released on this thread (see cancelAsyncReplot())
+      AsyncReplot* r = rep.get();
+      rep->job = Parallel::AsyncJob::submit( [r, m, d]( Parallel::AsyncJob& job ) {
+
+          PCurve<T,n>& curve = *r->curve;
+          if( r->level < 0 ) {
+              for( Partition& part : r->parts ) {
+                  if( job.isCancelled() ) return;
+                  curve.resample( part.sample_val, part.sur_sphere, part, d );
+              }
+          }
+          else {
+              curve.sample( m, d );
+              r->parts.resize( curve._visu.size() );
+              for( unsigned int i = 0; i < r->parts.size(); i++ )
+                  _swapSamples( r->parts[i], curve._visu[i] );
+          }
+      } );
+      _async_replot = rep;
+      return true;
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::restartAsyncReplot() const
+   *  The shape is changed outside replot(). A pending change of level of detail is
+   *  started again on the changed curve, and a pending resampling is cancelled.
+   *  Done by replot(), curves that update the samples in other ways must call it.
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::restartAsyncReplot() const {
+
+      if( _async_replot && _async_replot->level >= 0 )
+          _startAsync( _async_replot->level, _async_replot->keep );
+      else
+          cancelAsyncReplot();
+  }
+
+
+
+
+
+  /*! PCurve<T,n>* PCurve<T,n>::makeSnapshot() const
+   *  A copy of the evaluation state of the curve, sampled by a background resampling
+   *  (see setAsyncReplot()). It has no samples and visualizers.
+   *  The default is the copy made by makeCopy(), which has the children of the curve.
+   *  Curves with local curves as children override it, and only copy the evaluation state of these.
+   *
+   *  \return The copy, or nullptr if makeCopy() does not give a copy of the same class
+   */
+  template <typename T, int n>
+  PCurve<T,n>* PCurve<T,n>::makeSnapshot() const {
+
+      SceneObject* obj   = const_cast<PCurve<T,n>*>( this )->makeCopy();
+      PCurve<T,n>* curve = dynamic_cast<PCurve<T,n>*>( obj );
+      if( !curve || typeid(*curve) != typeid(*this) ) {
+          delete obj;
+          return nullptr;
+      }
+
+      // Classes pre-evaluating for a given number of samples do it again
+      curve->_visu.no_sample = 0;
+      return curve;
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::_swapLod( int level, std::vector<Partition>& parts, bool keep )
+   *  Private, makes the given samples of a level of detail the current samples,
+   *  the curve is sampled if parts does not fit the partitions.
+   *
+   *  \param[in] level  The level of detail of the samples
+   *  \param[in] parts  The samples, get the previous samples
+   *  \param[in] keep   Whether to cache the previous samples
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::_swapLod( int level, std::vector<Partition>& parts, bool keep ) {
+
+      const unsigned int k = _visu.size();
+
+      // Keep the samples of the current level
+      if( keep && this->_lod_level >= 0 ) {
+          _lod_cache.push_front( LodSet() );
+          _lod_cache.front().level = this->_lod_level;
+          _lod_cache.front().parts.resize( k );
+          for( unsigned int i = 0; i < k; i++ )
+              _swapSamples( _lod_cache.front().parts[i], _visu[i] );
+          while( int(_lod_cache.size()) > this->_lod_no_cached ) _lod_cache.pop_back();
+      }
+      this->_lod_level = level;
+
+      int m = this->_lod_size[level];
+      int d = _visu.no_derivatives;
+
+      if( parts.size() == k ) {
+          _checkSampleVal( m, d );
+          for( unsigned int i = 0; i < k; i++ )
+              _swapSamples( parts[i], _visu[i] );
+          lodSwapped();
+      }
+      else
+          sample( m, d );
+
+      _replot();
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::cancelAsyncReplot() const
+   *  Cancels the background resampling, its samples are not swapped in.
+   *  A running job finishes on its own copy of the curve, the copy is released
+   *  by a later swapAsyncReplot() or cancelAsyncReplot(), or by the destructor.
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::cancelAsyncReplot() const {
+
+      if( _async_replot ) {
+          _async_replot->job->cancel();
+          _async_cancelled.push_back( _async_replot );
+          _async_replot.reset();
+      }
+      _releaseCancelled();
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::_releaseCancelled( bool wait ) const
+   *  Private, releases the cancelled resamplings whose jobs have stopped,
+   *  so the copies of the curve are deleted on this thread and not in the worker pool.
+   *
+   *  \param[in] wait  Wait for the running jobs to stop, all are released
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::_releaseCancelled( bool wait ) const {
+
+      for( auto it = _async_cancelled.begin(); it != _async_cancelled.end(); ) {
+          if( wait ) (*it)->job->join();
+          if( (*it)->job->isStopped() ) it = _async_cancelled.erase( it );
+          else                          ++it;
+      }
+  }
+
+
+
+
+
+  /*! void PCurve<T,n>::_swapSamples( Partition& a, Partition& b )
+   *  Private, swaps the sample data (not the visualizers) of two partitions.
+   */
+  template <typename T, int n>
+  void PCurve<T,n>::_swapSamples( Partition& a, Partition& b ) {
+
+      static_cast<std::vector<T>&>(a).swap( b );
+      std::swap( a.s_e, b.s_e );
+      a.sample_val.swap( b.sample_val );
+      std::swap( a.sur_sphere, b.sur_sphere );
+  }
+
+
+
+
+
+  template <typename T, int n>
+  void  PCurve<T,n>::_replot() const {
+
       unsigned int k = _visu.size();
       if(k>1 && _local_pre_eval) k--;
 
@@ -793,6 +1547,7 @@ namespace GMlib {
       for(unsigned int i=0; i<k; i++)
           for(unsigned int j=0; j<_visu[i].vis.size(); j++)
               _visu[i].vis[j]->set(_visu[i].sample_val);
+      _clp_dirty = true;
 
       // Updating surrounding sphere
       Sphere<T,3> sph = this->_visu[0].sur_sphere;
@@ -832,6 +1587,7 @@ namespace GMlib {
   template <typename T, int n>
   inline
   void PCurve<T,n>::setDomainScale( T sc ) {
+    invalidateArcLength();
     _sc = sc;
     if(GMutils::compValueF(sc, T(1)))
       _is_scaled = false;
@@ -852,6 +1608,7 @@ namespace GMlib {
     template <typename T, int n>
     inline
     void PCurve<T,n>::setDomainTrans( T tr ) {
+      invalidateArcLength();
       _tr = tr;
     }
 
@@ -1075,6 +1832,30 @@ namespace GMlib {
 
 
 
+   /*! void PCurve<T,n>::evalBatch( Vector<T,n>* p, const T* t, int m, int d, bool left ) const
+    *  Default batch evaluator, calls eval() for each parameter value.
+    *
+    *  \param[out] p     Positions and d derivatives, the k-th derivative at t[i] is p[k*m+i]
+    *  \param[in]  t     The m parameter values to evaluate
+    *  \param[in]  m     Number of parameter values
+    *  \param[in]  d     Number of derivatives to compute
+    *  \param[in]  left  Whether to evaluate from left or right
+    */
+    template <typename T, int n>
+    void PCurve<T,n>::evalBatch( Vector<T,n>* p, const T* t, int m, int d, bool left ) const {
+
+      DVector<Vector<T,n>> q(d+1);
+      for( int i = 0; i < m; i++ ) {
+        eval( q, t[i], d, left );
+        for( int k = 0; k <= d; k++ )
+          p[k*m+i] = q[k];
+      }
+    }
+
+
+
+
+
    /*! void PCurve<T,n>::resample( std::vector<DVector<Vector<T,n>>>& p, Sphere<T,3>& s, const std::vector<T>& t, int d) const
     *  Resampling when the curve has changed, can be used flexible, for each partition separately
     *
@@ -1087,11 +1868,19 @@ namespace GMlib {
     inline
     void PCurve<T,n>::resample( std::vector<DVector<Vector<T,n>>>& p, Sphere<T,3>& s, const std::vector<T>& t, int d) const {
 
-      p.resize(t.size());
+      const int m = t.size();
+
+      // Evaluate all the samples in one batch, and then spread them out to the samples
+      static thread_local std::vector<Vector<T,n>> q;
+      q.resize( (d+1)*m );
+      evaluate( q.data(), t.data(), m, d, true );
+
+      p.resize(m);
       s.reset();
-      for( uint i = 0; i < t.size(); i++ ) {
-        _eval( t[i], d, true);
-        p[i] = _p;
+      for( int i = 0; i < m; i++ ) {
+        p[i].setDim(d+1);
+        for( int k = 0; k <= d; k++ )
+          p[i][k] = q[k*m+i];
       }
       computeSurroundingSphere(p, s);
       if(d>_der_implemented || (d>0 && this->_dm == GM_DERIVATION_DD))
@@ -1111,6 +1900,8 @@ namespace GMlib {
      template <typename T, int n>
      void PCurve<T,n>::resample( Partition& v, int d ) const {
 
+       cancelAsyncReplot();
+       invalidateArcLength();
        resample( v.sample_val, v.sur_sphere , v, d);
      }
 
@@ -1124,6 +1915,8 @@ namespace GMlib {
      inline
      void PCurve<T,n>::resample() const {
 
+       cancelAsyncReplot();
+       invalidateArcLength();
        resample( _visu[0].sample_val, _visu[0].sur_sphere , _visu[0], _visu.no_derivatives);
      }
 
@@ -1146,6 +1939,40 @@ namespace GMlib {
 
 
 
+   /*! void PCurve<T,n>::makeSampleValues( std::vector<T>& sample, int m, T s, T e ) const
+    *  Parameter values for the sample points in [s,e].
+    *  Uniform, or if setAdaptiveSampling() is used, starting with m uniform values and split
+    *  where the sample polyline deviates too much from the curve (see computeAdaptiveParamVal()).
+    *  The error of an interval is measured at its quarter points.
+    *
+    *  \param[out]  sample    Parameter values for the sample points
+    *  \param[in]   m         Number of (initial) sample points
+    *  \param[in]   s         Start parameter value
+    *  \param[in]   e         End parameter value
+    */
+    template <typename T, int n>
+    void PCurve<T,n>::makeSampleValues( std::vector<T>& sample, int m, T s, T e ) const {
+
+       if( !this->isAdaptiveSampling() ) {
+         computeUniformParamVal( sample, m, s, e );
+         return;
+       }
+
+       DVector<Vector<T,n>> q;
+       auto error = [&]( T a, T b ) {
+         Point<T,n> p[5];
+         for( int i = 0; i < 5; i++ ) {
+           evaluate( q, a + i*(b-a)/4, 0, i > 0 );
+           p[i] = q[0];
+         }
+         return polylineError( p, 5, this->_adapt_eps, this->_adapt_angle );
+       };
+       computeAdaptiveParamVal( sample, m, s, e, this->_adapt_max, error );
+    }
+
+
+
+
     /*! void  PCurve<T,n>::prepareVisualizers()
      *  Private, not for public use
      *  Remove all old visualizers
@@ -1212,48 +2039,191 @@ namespace GMlib {
 
       if( d <= _d && t == _t ) return;
       _t = t; _d = d;
-      eval( _map(t), d, left );
-      if(_is_scaled) _corrEval(_sc, d);
+      evaluate( _p, t, d, left );
     }
 
 
 
-    /*! T PCurve<T,n>::_integral(T a, T b, double eps) const
-     *  Curve integration, using Romberg integration method.
-     *  \param[in]  a    start parameter value
-     *  \param[in]  b    end parameter value
-     *  \param[in]  eps  Tolerance, telling when to stop refinement
+    /*! T PCurve<T,n>::_gaussLegendre( T a, T b ) const
+     *  Private, the curve length from c(a) to c(b) by 5-point Gauss-Legendre quadrature.
      */
     template <typename T, int n>
-    inline
-    T PCurve<T,n>::_integral(T a, T b, double eps) const {
-
-      T t = b - a;
-      T sum = (getSpeed(a)+getSpeed(b))/2;
-
-      T mat[16][16];
-      mat[0][0] = sum * t;
-
-      T s;
-      int i,j,k;
-      for( i = 1; i < 16; i++ ) {
-        s = T(0);
-        k = 1 << i;
-        t /= 2.0;
-        for( j = 1; j < k; j += 2 )
-          s += getSpeed(a + t*j);
-        mat[0][i] = t * (sum += s);
-        for (j=1; j<=i; j++) {
-          b = 1 << (j << 1);
-          mat[j][i-j] = (b*mat[j-1][i-j+1] - mat[j-1][i-j])/(b-1.0);
+    T PCurve<T,n>::_gaussLegendre( T a, T b ) const {
+
+      static const double x[5] = { 0.0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640 };
+      static const double w[5] = { 0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891 };
+
+      const T h = (b - a) / 2;
+      const T c = (b + a) / 2;
+      T t[5];
+      for( int i = 0; i < 5; i++ ) t[i] = c + T(x[i]) * h;
+
+      Vector<T,n> p[10];
+      evaluate( p, t, 5, 1 );
+
+      T sum = T(0);
+      for( int i = 0; i < 5; i++ ) sum += T(w[i]) * p[5+i].getLength();
+      return sum * h;
+    }
+
+
+
+    /*! T PCurve<T,n>::_arcLength( const std::vector<T>& at, const std::vector<T>& as, T t ) const
+     *  Private, the curve length from the start of the curve to c(t), from the table (at, as).
+     */
+    template <typename T, int n>
+    T PCurve<T,n>::_arcLength( const std::vector<T>& at, const std::vector<T>& as, T t ) const {
+
+      const int m = int(at.size()) - 1;
+      if( !(t > at[0]) ) return T(0);
+      if( t >= at[m] )   return as[m];
+
+      const int k = int( std::upper_bound( at.begin(), at.end(), t ) - at.begin() ) - 1;
+      return as[k] + _gaussLegendre( at[k], t );
+    }
+
+
+
+    /*! T PCurve<T,n>::_parAtLength( const std::vector<T>& at, const std::vector<T>& as, T s ) const
+     *  Private, the parameter value where the curve length from the start is s, see getParAtLength().
+     */
+    template <typename T, int n>
+    T PCurve<T,n>::_parAtLength( const std::vector<T>& at, const std::vector<T>& as, T s ) const {
+
+      const int m = int(at.size()) - 1;
+      if( !(s > T(0)) ) return at[0];
+      if( s >= as[m] ) return at[m];
+
+      const int k = std::min( m-1, int( std::upper_bound( as.begin(), as.end(), s ) - as.begin() ) - 1 );
+      T lo = at[k];
+      T hi = at[k+1];
+      const T ds = as[k+1] - as[k];
+      if( !(ds > T(0)) ) return lo;
+
+      const T tol = std::max( T(1e-12) * as[m], 4 * std::numeric_limits<T>::epsilon() * s );
+      T t = lo + (hi - lo) * (s - as[k]) / ds;
+      DVector<Vector<T,n>> p;
+      for( int i = 0; i < 30; i++ ) {
+
+        const T f = as[k] + _gaussLegendre( at[k], t ) - s;
+        if( std::abs(f) <= tol ) break;
+        if( f > T(0) ) hi = t;
+        else           lo = t;
+
+        evaluate( p, t, 1 );
+        const T speed = p[1].getLength();
+        T tn = speed > T(0) ? t - f / speed : lo - T(1);
+        if( !(tn > lo && tn < hi) ) tn = (lo + hi) / 2;
+        if( tn == t ) break;
+        t = tn;
+      }
+      return t;
+    }
+
+
+
+    /*! void PCurve<T,n>::_makeArcLength( std::vector<T>& at, std::vector<T>& as, T a, T b ) const
+     *  Private, makes an arc length table over [a,b], the parameter values at and the curve length as from a.
+     *  The domain is split in 32 intervals, and each interval is halved until
+     *  the quadrature over the halves is close to the quadrature over the interval.
+     */
+    template <typename T, int n>
+    void PCurve<T,n>::_makeArcLength( std::vector<T>& at, std::vector<T>& as, T a, T b ) const {
+
+      const int m0  = 32;
+      const T   eps = T(1e-10);
+
+      at.assign( 1, a );
+      as.assign( 1, T(0) );
+
+      struct Interval { T a, b, len; int depth; };
+      std::vector<Interval> stack;
+      for( int i = m0-1; i >= 0; i-- ) {
+        const T s = a + i * (b - a) / m0;
+        const T e = i == m0-1 ? b : a + (i+1) * (b - a) / m0;
+        stack.push_back( { s, e, _gaussLegendre( s, e ), 0 } );
+      }
+
+      // Depth first, left half first, so the intervals are finished from the start
+      while( !stack.empty() ) {
+
+        const Interval iv = stack.back();
+        stack.pop_back();
+
+        const T c  = (iv.a + iv.b) / 2;
+        const T l  = _gaussLegendre( iv.a, c );
+        const T r  = _gaussLegendre( c, iv.b );
+        const T df = std::abs( l + r - iv.len );
+        if( iv.depth < 20 && df > eps * (iv.b - iv.a) / (b - a) &&
+            df > 16 * std::numeric_limits<T>::epsilon() * (l + r) ) {
+          stack.push_back( { c, iv.b, r, iv.depth+1 } );
+          stack.push_back( { iv.a, c, l, iv.depth+1 } );
+          continue;
         }
-        if(std::abs(mat[i][0] - mat[i-1][0]) < eps) return mat[i][0];
+
+        at.push_back( c );
+        as.push_back( as.back() + l );
+        at.push_back( iv.b );
+        as.push_back( as.back() + r );
       }
-      return mat[15][0];
     }
 
 
 
+    /*! std::shared_ptr<const typename PCurve<T,n>::ArcTable> PCurve<T,n>::_updateArcLength() const
+     *  Private, the arc length table of setArcLengthTable(), made first if it is outdated.
+     *  The table is never changed after it is published, the caller reads its own copy
+     *  of the pointer without the lock.
+     */
+    template <typename T, int n>
+    std::shared_ptr<const typename PCurve<T,n>::ArcTable> PCurve<T,n>::_updateArcLength() const {
+
+      std::lock_guard<std::mutex> lock( *_arc_mutex );
+      if( !_arc ) {
+        std::shared_ptr<ArcTable> arc = std::make_shared<ArcTable>();
+        _makeArcLength( arc->t, arc->s, getParStart(), getParEnd() );
+        _arc = arc;
+      }
+      return _arc;
+    }
+
+
+
+    /*! void PCurve<T,n>::_getClpSamples( std::vector<Point<T,n>>& p, std::vector<T>& t ) const
+     *  Private, the sample positions of all partitions and their parameter values,
+     *  or 30 samples if the curve is not sampled.
+     */
+    template <typename T, int n>
+    void PCurve<T,n>::_getClpSamples( std::vector<Point<T,n>>& p, std::vector<T>& t ) const {
+
+        p.clear();
+        t.clear();
+
+        unsigned int k = _visu.size();
+        if(k>1 && _local_pre_eval) k--;
+
+        for( unsigned int i = 0; i < k; i++ )
+            if( _visu[i].sample_val.size() == _visu[i].size() )
+                for( unsigned int j = 0; j < _visu[i].size(); j++ ) {
+                    p.push_back( _visu[i].sample_val[j][0] );
+                    t.push_back( _visu[i][j] );
+                }
+
+        if( !p.empty() ) return;
+
+        const int m = 30;
+        DVector<Vector<T,n>> c;
+        for( int i = 0; i < m; i++ ) {
+            t.push_back( getParStart() + i * getParDelta() / (m-1) );
+            evaluate( c, t.back(), 0 );
+            p.push_back( c[0] );
+        }
+    }
+
+
+
+
+
     /*! T PCurve<T,n>::_map( T t ) const
      *  Mapping paramerer values from defined value to function value
      *  \param[in]    t   parameter value in defined coordinates
@@ -1268,17 +2238,18 @@ namespace GMlib {
 
 
 
-    /*! void PCurve<T,n>::_corrEval( T s, int d ) const
+    /*! void PCurve<T,n>::_corrEval( DVector<Vector<T,n>>& p, T s, int d ) const
      *  Mapping paramerer values from defined value to function value
-     *  \param[in]    s   scaling value to scale derivatives
-     *  \param[in]    d   number of derivatives to corrigate
+     *  \param[in-out] p   position and derivatives to corrigate
+     *  \param[in]     s   scaling value to scale derivatives
+     *  \param[in]     d   number of derivatives to corrigate
      */
     template <typename T, int n>
     inline
-    void PCurve<T,n>::_corrEval( T s, int d ) const {
+    void PCurve<T,n>::_corrEval( DVector<Vector<T,n>>& p, T s, int d ) const {
         for(int j =1; j<=d; j++)
             for(int i=j; i<=d;i++)
-                _p[i] /=s;
+                p[i] /=s;
     }
 
 
@@ -33,6 +33,14 @@
 // gmlib
 #include <core/containers/gmarray.h>
 #include <core/containers/gmdvector.h>
+#include <core/containers/gmkdtree.h>
+#include <core/utils/gmparallel.h>
+
+// stl
+#include <list>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
 
 
 
@@ -90,16 +98,30 @@ namespace GMlib {
     DVector<Vector<T,n> >&       evaluate( int i, int j=0 ) const;
     DVector<Vector<T,n> >&       evaluateParent( int i, int j=0 ) const;
 
+    //****  Reentrant evaluation functons, result in a buffer owned by the caller  ****
+    void                         evaluate( DVector<Vector<T,n>>& p, T t, int d, bool left = true ) const;
+    void                         evaluateParent( DVector<Vector<T,n>>& p, T t, int d, bool left = true ) const;
+
+    //****  Batch evaluation of m parameter values, result in a buffer owned by the caller  ****
+    void                         evaluate( Vector<T,n>* p, const T* t, int m, int d, bool left = true ) const;
+
     //****  Closest point functons  ****
     virtual void                 estimateClpPar( const Point<T,n>& q, T& t, int m=30) const;
     bool                         getClosestPoint(const Point<T,n>& q, T& t, Point<T,n>& p,
                                                   double eps = 10e-6, int max_iterations = 20) const;
+    int                          getClosestPoints( const Point<T,n>* q, int m, T* t, T* dist = nullptr,
+                                                   bool* converged = nullptr, double eps = 10e-6,
+                                                   int max_iterations = 20, int no_threads = 0 ) const;
 
     //****  Curvature, curve length and speed functons  ****
     T                            getCurvature( T t ) const;
     T                            getRadius( T t ) const;
     T                            getSpeed( T t ) const;
     T                            getCurveLength( T a = 0, T b = -1 ) const;
+    T                            getParAtLength( T s ) const;
+    void                         setArcLengthTable( bool table = true );
+    bool                         isArcLengthTable() const;
+    void                         invalidateArcLength() const;
 
     int                          getNumDerivatives() const;
 
@@ -121,6 +143,7 @@ namespace GMlib {
     int                          getNumSamples() const;
 
     const std::vector<T>&        getSampleValues( int i=0) const;
+    void                         getSampleParameters( std::vector<T>& t ) const;
     virtual Point<T,n>           getSamplePoint( int i, int j) const;
     virtual Vector<T,n>&         getSampleDerivative( int i, int j, int d) const;
     virtual int                  getSample_d( int i, int j) const;
@@ -140,6 +163,19 @@ namespace GMlib {
     void                         replot() const override;
     int                          getNumber() const override {return _number;}
 
+    //****  Level of detail, the number of samples is selected from the size on the screen  ****
+    void                         setLodLevels( const std::vector<int>& levels, float pixels = 8.0f, int no_cached = 3 );
+    void                         setLodLevel( int level ) override;
+
+    //****  Background resampling on replot(), the visualizers show the previous samples meanwhile  ****
+    void                         setAsyncReplot( bool async = true );
+    bool                         isAsyncReplot() const;
+    bool                         isAsyncReplotPending() const;
+    bool                         swapAsyncReplot();
+    void                         waitAsyncReplot() const;
+    void                         cancelAsyncReplot() const;
+    virtual PCurve<T,n>*         makeSnapshot() const;
+
     // To set the actual domain. All mappings (both parametric and scaling of derivatives) will then automatical be done.
     void                         setDomain( T start, T end );
     void                         setDomainScale( T sc );
@@ -171,6 +207,7 @@ namespace GMlib {
 
 
   protected:
+    PCurve( const PCurve<T,n>& copy, bool children );
 
     // Preevaluation/sampling
     mutable Sampler              _visu;        //!< visualizers and vertices ... for plotting
@@ -201,13 +238,31 @@ namespace GMlib {
     // The three following functions defines the curve.
     // The first one is the formula, the two other set the domain conected to the formula
 
-    /*! virtual void PCurve<T,3>::eval( T t, int d, bool left = true  ) const = 0
-     *  Surface evaluator, abstract. Requires implementation of a sub-class.
+    /*! virtual void PCurve<T,3>::eval( DVector<Vector<T,n>>& p, T t, int d, bool left = true  ) const = 0
+     *  Curve evaluator, abstract. Requires implementation of a sub-class.
+     *  The result is only to be written into p, not into any member of the curve,
+     *  so the curve can be evaluated from several threads at the same time.
+     *  \param[out] p     Position and d derivatives at t
      *  \param[in]  t     Parameter value to evaluate
      *  \param[in]  d     Number of derivatives to be computed
      *  \param[in]  left  (default - true) , whether to evaluate from left or right
      */
-    virtual void                 eval(T t, int d, bool left = true ) const = 0;
+    virtual void                 eval( DVector<Vector<T,n>>& p, T t, int d, bool left = true ) const = 0;
+
+
+    /*! virtual void PCurve<T,3>::evalBatch( Vector<T,n>* p, const T* t, int m, int d, bool left ) const
+     *  Batch evaluator, evaluates the curve at m parameter values.
+     *  Default is to call eval() for each parameter value, curves can reimplement it
+     *  to evaluate all the parameter values in one go.
+     *  The result is packed with one row of m elements for each derivative,
+     *  i.e. the k-th derivative at t[i] is p[k*m+i].
+     *  \param[out] p     Positions and d derivatives, (d+1)*m elements
+     *  \param[in]  t     The m parameter values to evaluate
+     *  \param[in]  m     Number of parameter values
+     *  \param[in]  d     Number of derivatives to be computed
+     *  \param[in]  left  Whether to evaluate from left or right
+     */
+    virtual void                 evalBatch( Vector<T,n>* p, const T* t, int m, int d, bool left ) const;
 
 
     /*! virtual T PCurve<T,3>::getStartP() const = 0
@@ -230,18 +285,68 @@ namespace GMlib {
 
     // For preevaluation.
     void                         makeUniformSampleValues( Partition& v, int m ) const;
+    void                         makeSampleValues( std::vector<T>& sample, int m, T s, T e ) const;
     void                         prepareVisualizers();
     void                         cleanVisualizers(unsigned int i=1);
 
 
     T                            _map(T t) const;
     void                         _checkSampleVal( int& m, int& d ) const;
+    void                         clearLodCache() const;
+    void                         restartAsyncReplot() const;
+    virtual void                 lodSwapped() {}                 // Samples of another level are swapped in without sample()
+
+    void                         localUpdateLod( const Camera& cam ) override;
 
 
   private:
+    struct LodSet {                                 //!< The samples of a recently used level of detail
+      int                                level;
+      std::vector<Partition>             parts;     //!< Sample data of all partitions, without visualizers
+    };
+
+    mutable std::list<LodSet>    _lod_cache;        // Most recently used first
+
+    struct AsyncReplot {                            //!< A background resampling of all partitions
+      std::shared_ptr<Parallel::AsyncJob> job;
+      std::unique_ptr<PCurve<T,n>>        curve;     //!< Evaluation state of the curve (makeSnapshot()), sampled by the job
+      std::vector<Partition>             parts;     //!< Back buffer, written by the job
+      int                                level;     //!< The level of detail sampled, -1 for the current parameter values
+      int                                m;         //!< Number of samples the back buffer is made for
+      bool                               keep;      //!< The current samples are cached when the level is swapped in
+    };
+
+    bool                                 _async;        // Resample in the background on replot()
+    mutable std::shared_ptr<AsyncReplot> _async_replot; // The latest background resampling
+    mutable std::list<std::shared_ptr<AsyncReplot>> _async_cancelled; // Cancelled, not released before the job has stopped
+
+    struct ArcTable {                               //!< An arc length table, see setArcLengthTable()
+      std::vector<T>                     t;         //!< Parameter values
+      std::vector<T>                     s;         //!< Curve length from the start of the curve to t[i]
+    };
+
+    bool                                 _arc_table;    // Keep an arc length table, see setArcLengthTable()
+    mutable std::shared_ptr<const ArcTable> _arc;       // The current table, null if outdated; copied and set under _arc_mutex
+    std::shared_ptr<std::mutex>          _arc_mutex;    // Guards _arc, the table is made by one thread at a time
+
+    mutable KdTree<T,n>                  _clp_tree;     // Over the samples of all partitions, see getClosestPoints()
+    mutable std::vector<T>               _clp_par;      // Parameter values of the points in _clp_tree
+    mutable bool                         _clp_dirty;    // The samples have changed since _clp_tree was made
+
     void                         _eval( T t, int d, bool left = true  ) const;
-    T                            _integral(T a, T b, double eps) const;
-    void                         _corrEval(T sc, int d) const;
+    void                         _replot() const;
+    void                         _replotAsync() const;
+    bool                         _startAsync( int level, bool keep ) const;
+    void                         _releaseCancelled( bool wait = false ) const;
+    void                         _swapLod( int level, std::vector<Partition>& parts, bool keep );
+    static void                  _swapSamples( Partition& a, Partition& b );
+    T                            _arcLength( const std::vector<T>& at, const std::vector<T>& as, T t ) const;
+    T                            _parAtLength( const std::vector<T>& at, const std::vector<T>& as, T s ) const;
+    T                            _gaussLegendre( T a, T b ) const;
+    void                         _makeArcLength( std::vector<T>& at, std::vector<T>& as, T a, T b ) const;
+    std::shared_ptr<const ArcTable> _updateArcLength() const;
+    void                         _corrEval(DVector<Vector<T,n>>& p, T sc, int d) const;
+    void                         _getClpSamples( std::vector<Point<T,n>>& p, std::vector<T>& t ) const;
 
   }; // END class PCurve
 
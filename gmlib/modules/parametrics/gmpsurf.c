@@ -27,9 +27,11 @@
 // gmlib
 #include "visualizers/gmpsurfdefaultvisualizer.h"
 #include <core/utils/gmdivideddifferences.h>
+#include <core/utils/gmparallel.h>
 
 
 // stl
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
@@ -59,6 +61,10 @@ namespace GMlib {
     _is_scaled_v                    = false;
 
     _resample                       = false;
+    _no_threads                     = 1;
+    _async                          = false;
+    _bvh_dirty                      = true;
+    _clp_dirty                      = true;
 
     setNoDer( 2 );
 
@@ -68,7 +74,19 @@ namespace GMlib {
 
   template <typename T, int n>
   inline
-  PSurf<T,n>::PSurf( const PSurf<T,n>& copy ) : Parametrics<T,2,n>( copy ) {
+  PSurf<T,n>::PSurf( const PSurf<T,n>& copy ) : PSurf( copy, true ) {}
+
+
+  /*! PSurf<T,n>::PSurf( const PSurf<T,n>& copy, bool children )
+   *  Copy constructor, the children are only copied if children is true.
+   *  Used by makeSnapshot() in surfaces with local patches as children.
+   *
+   *  \param[in]  copy      The surface to copy
+   *  \param[in]  children  Whether to copy the children
+   */
+  template <typename T, int n>
+  inline
+  PSurf<T,n>::PSurf( const PSurf<T,n>& copy, bool children ) : Parametrics<T,2,n>( copy, children ) {
 
     _p            = copy._p;
     _u            = copy._u;
@@ -93,6 +111,11 @@ namespace GMlib {
     _no_der_v     = copy._no_sam_v;
 
     _resample     = false;
+    _no_threads   = copy._no_threads;
+    _lod_samples  = copy._lod_samples;
+    _async        = copy._async;
+    _bvh_dirty    = true;
+    _clp_dirty    = true;
 
 //    _default_visualizer = 0x0;
   }
@@ -100,6 +123,9 @@ namespace GMlib {
   template <typename T, int n>
   PSurf<T,n>::~PSurf() {
 
+    cancelAsyncReplot();
+    _releaseCancelled( true );
+
     enableDefaultVisualizer( false );
     if( _visu.default_visualizer )
       delete _visu.default_visualizer;
@@ -237,7 +263,7 @@ namespace GMlib {
   inline
   DMatrix<Vector<T,n>>& PSurf<T,n>::evaluateParent(  int i, int j  ) const {
 
-    static DMatrix<Vector<T,n> > p;
+    static thread_local DMatrix<Vector<T,n> > p;
     DMatrix<Vector<T,n>>& q = _pre_val[i][j];
     int k1 = q.getDim1();
     int k2 = q.getDim2();
@@ -255,6 +281,90 @@ namespace GMlib {
 
 
 
+  /*! void PSurf<T,n>::evaluate( DMatrix<Vector<T,n>>& p, T u, T v, int d1, int d2, bool lu, bool lv ) const
+   *  Reentrant evaluator for the surface
+   *  Computing values in local coordinate system.
+   *  The result is only written to p, nothing in the surface is changed,
+   *  so different threads can evaluate the same surface at the same time.
+   *
+   *  \param[out] p   Position and partial derivatives in local coordinates
+   *  \param[in]  u   The parameter value in u-direction
+   *  \param[in]  v   The parameter value in v-direction
+   *  \param[in]  d1  The number of derivatives in u-direction
+   *  \param[in]  d2  The number of derivatives in v-direction
+   *  \param[in]  lu  (default true) Compute from left or right side of u
+   *  \param[in]  lv  (default true) Compute from left or right side of v
+   */
+  template <typename T, int n>
+  inline
+  void PSurf<T,n>::evaluate( DMatrix<Vector<T,n>>& p, T u, T v, int d1, int d2, bool lu, bool lv ) const {
+
+    eval( p, _mapU(u), _mapV(v), d1, d2, lu, lv );
+  }
+
+
+
+  /*! void PSurf<T,n>::evaluate( Vector<T,n>* p, const T* u, const T* v, int m, int d1, int d2, bool lu, bool lv ) const
+   *  Reentrant batch evaluator for the surface
+   *  Computing values in local coordinate system for m parameter pairs (u[i],v[i]).
+   *  The result is packed with one row of m elements for each partial derivative,
+   *  i.e. the (k,l) derivative at (u[i],v[i]) is p[(k*(d2+1)+l)*m+i].
+   *
+   *  \param[out] p   Positions and partial derivatives in local coordinates, (d1+1)*(d2+1)*m elements
+   *  \param[in]  u   The m parameter values in u-direction
+   *  \param[in]  v   The m parameter values in v-direction
+   *  \param[in]  m   The number of parameter pairs
+   *  \param[in]  d1  The number of derivatives in u-direction
+   *  \param[in]  d2  The number of derivatives in v-direction
+   *  \param[in]  lu  (default true) Compute from left or right side of u
+   *  \param[in]  lv  (default true) Compute from left or right side of v
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::evaluate( Vector<T,n>* p, const T* u, const T* v, int m, int d1, int d2, bool lu, bool lv ) const {
+
+    // The mapped parameter values are local to the call, since an evalBatch()
+    // may itself batch-evaluate other surfaces of the same type (e.g. local patches)
+    std::vector<T> um(m), vm(m);
+    for( int i = 0; i < m; i++ ) {
+      um[i] = _mapU(u[i]);
+      vm[i] = _mapV(v[i]);
+    }
+
+    evalBatch( p, um.data(), vm.data(), m, d1, d2, lu, lv );
+  }
+
+
+
+  /*! void PSurf<T,n>::evaluateParent( DMatrix<Vector<T,n>>& p, T u, T v, int d1, int d2, bool lu, bool lv ) const
+   *  Reentrant evaluator for the surface
+   *  Computing values in the coordinate system of the parent.
+   *  The result is only written to p, nothing in the surface is changed,
+   *  so different threads can evaluate the same surface at the same time.
+   *
+   *  \param[out] p   Position and partial derivatives in the coordinate system of the parent
+   *  \param[in]  u   The parameter value in u-direction
+   *  \param[in]  v   The parameter value in v-direction
+   *  \param[in]  d1  The number of derivatives in u-direction
+   *  \param[in]  d2  The number of derivatives in v-direction
+   *  \param[in]  lu  (default true) Compute from left or right side of u
+   *  \param[in]  lv  (default true) Compute from left or right side of v
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::evaluateParent( DMatrix<Vector<T,n>>& p, T u, T v, int d1, int d2, bool lu, bool lv ) const {
+
+    evaluate( p, u, v, d1, d2, lu, lv );
+    const HqMatrix<T,3> mat = this->_matrix.template toType<T>();
+
+    p[0][0] = mat * p[0][0].toPoint();
+    for( int j = 1; j < p.getDim2(); j++ )
+      p[0][j] = mat * p[0][j];
+    for( int i = 1; i < p.getDim1(); i++ )
+      for( int j = 0; j < p.getDim2(); j++ )
+        p[i][j] = mat * p[i][j];
+  }
+
+
+
 
   //******************************************************
   //      public closest point functions                **
@@ -336,6 +446,175 @@ namespace GMlib {
 
 
 
+  /*! int PSurf<T,n>::getClosestPoints( const Point<T,n>* q, int m, Point<T,2>* uv, T* dist, bool* converged,
+   *                                    double eps, int max_iterations, int no_threads ) const
+   *  Closest points on the surface for m points (in global coordinates, as getClosestPoint()).
+   *  The start guess of each point is the nearest sample, found in a k-d tree over the samples
+   *  of all partitions (over a 20x20 grid if the surface is not sampled). The tree is made again
+   *  the first time it is used after the surface is sampled or replotted (see invalidateBvh()).
+   *  Making it is not thread safe, the queries are.
+   *  The Newton iterations are then done in parallel. The parameters are kept in the domain,
+   *  or wrapped around if the surface is closed. If Newton ends farther away than the start guess,
+   *  the start guess is returned and the point is reported as not converged.
+   *
+   *  \param[in]  q               The m points
+   *  \param[in]  m               Number of points
+   *  \param[out] uv              The m parameter pairs of the closest points
+   *  \param[out] dist            (default nullptr) The m distances to the surface, if not nullptr
+   *  \param[out] converged       (default nullptr) Whether each iteration converged, if not nullptr
+   *  \param[in]  eps             (default 10e-6) The tolerance (in parametric space)
+   *  \param[in]  max_iterations  (default 20) The maximum number of iterations for each point
+   *  \param[in]  no_threads      (default 0) Number of threads, 0 uses all cores
+   *  \return The number of points that converged
+   */
+  template <typename T, int n>
+  int PSurf<T,n>::getClosestPoints( const Point<T,n>* q, int m, Point<T,2>* uv, T* dist, bool* converged,
+                                    double eps, int max_iterations, int no_threads ) const {
+
+    // The samples to find the start guesses in
+    if( _clp_dirty ) {
+      std::vector<Point<T,n>> sp;
+      _getSamples( sp, _clp_par );
+      _clp_tree.build( sp.data(), int(sp.size()) );
+      _clp_dirty = false;
+    }
+    const KdTree<T,n>&             tree = _clp_tree;
+    const std::vector<Point<T,2>>& spar = _clp_par;
+
+    HqMatrix<T,n> invmat = this->_present.template toType<T>();
+    invmat.invertOrthoNormal();
+
+    const T    s[2]      = { getParStartU(), getParStartV() };
+    const T    e[2]      = { getParEndU(),   getParEndV() };
+    const bool closed[2] = { isClosedU(),    isClosedV() };
+
+    std::atomic<int> no_converged(0);
+    Parallel::forBlocks( 0, m, [&]( int b, int en ) {
+
+      DMatrix<Vector<T,n>> r;
+      int nc = 0;
+      for( int i = b; i < en; i++ ) {
+
+        const Point<T,n> p = invmat * q[i];
+        T d2;
+        const int k = tree.findNearest( p, d2 );
+        Point<T,2> x = spar[k];
+
+        bool ok = false;
+        for( int it = 0; it < max_iterations && !ok; it++ ) {
+
+          evaluate( r, x[0], x[1], 2, 2 );
+          const Vector<T,n> d = p - r[0][0];
+
+          const T a11 =       d*r[2][0] - r[1][0] * r[1][0];
+          const T a12 =       d*r[1][1] - r[1][0] * r[0][1];
+          const T a22 =       d*r[0][2] - r[0][1] * r[0][1];
+          const T b1  = -(d*r[1][0]);
+          const T b2  = -(d*r[0][1]);
+          const T det = a11*a22 - a12*a12;
+          if( det == T(0) ) break;
+
+          Point<T,2> y( x[0] + (b1*a22 - a12*b2) / det, x[1] + (a11*b2 - b1*a12) / det );
+          for( int l = 0; l < 2; l++ ) {
+            if( closed[l] ) {
+              y[l] = s[l] + std::fmod( y[l] - s[l], e[l] - s[l] );
+              if( y[l] < s[l] ) y[l] += e[l] - s[l];
+            }
+            else
+              y[l] = std::max( s[l], std::min( e[l], y[l] ) );
+          }
+          ok = std::abs(y[0] - x[0]) < eps && std::abs(y[1] - x[1]) < eps;
+          x  = y;
+        }
+
+        evaluate( r, x[0], x[1], 0, 0 );
+        const Vector<T,n> w = p - r[0][0];
+        T l2 = w*w;
+        if( l2 > d2 ) {
+          x  = spar[k];
+          l2 = d2;
+          ok = false;
+        }
+
+        uv[i] = x;
+        if( dist )      dist[i]      = std::sqrt( l2 );
+        if( converged ) converged[i] = ok;
+        if( ok )        nc++;
+      }
+      no_converged += nc;
+    }, no_threads );
+
+    return no_converged;
+  }
+
+
+
+
+  /*! const Bvh<T>& PSurf<T,n>::getBvh() const
+   *  A bounding volume hierarchy over the sampled surface, two triangles for each
+   *  square of the sample grid of each partition (over a 20x20 grid if the surface is not sampled).
+   *  The vertices are in local coordinates, and the parameters of the hits are in the domain
+   *  of the surface. The hierarchy is updated the first time it is used after the surface is
+   *  sampled or replotted: refitted if the sample grids have the same size, otherwise rebuilt.
+   *  The update is not thread safe, the queries on the hierarchy are.
+   *
+   *  \return The hierarchy
+   */
+  template <typename T, int n>
+  const Bvh<T>& PSurf<T,n>::getBvh() const {
+
+    if( _bvh_dirty ) {
+
+      std::vector<Point<T,n>>    p;
+      std::vector<Point<T,2>>    uv;
+      std::vector<Vector<int,2>> grids;
+      _getSamples( p, uv, &grids );
+
+      std::vector<Vector<int,3>> tri;
+      int o = 0;
+      for( const Vector<int,2>& g : grids ) {
+        for( int a = 0; a < g(0)-1; a++ )
+          for( int b = 0; b < g(1)-1; b++ ) {
+            const int k = o + a*g(1) + b;
+            tri.push_back( Vector<int,3>( k, k + g(1), k + g(1) + 1 ) );
+            tri.push_back( Vector<int,3>( k, k + g(1) + 1, k + 1 ) );
+          }
+        o += g(0) * g(1);
+      }
+
+      _bvh.update( p, tri, uv );
+      _bvh_dirty = false;
+    }
+    return _bvh;
+  }
+
+
+  /*! bool PSurf<T,n>::getRayIntersection( const Point<T,n>& o, const Vector<T,n>& d, T& u, T& v ) const
+   *  The first intersection of a ray (in global coordinates, as getClosestPoint()) with the sampled surface.
+   *  The result is on the triangles of the samples, use getClosestPoint() from (u,v) to get it onto the surface.
+   *
+   *  \param[in]  o  The origin of the ray
+   *  \param[in]  d  The direction of the ray
+   *  \param[out] u  Parameter in u-direction of the intersection, unchanged if there is none
+   *  \param[out] v  Parameter in v-direction of the intersection, unchanged if there is none
+   *  \return True if the ray hits the surface
+   */
+  template <typename T, int n>
+  bool PSurf<T,n>::getRayIntersection( const Point<T,n>& o, const Vector<T,n>& d, T& u, T& v ) const {
+
+    HqMatrix<T,n> invmat = this->_present.template toType<T>();
+    invmat.invertOrthoNormal();
+
+    typename Bvh<T>::Hit hit;
+    if( !getBvh().intersect( invmat * o, invmat * d, hit ) ) return false;
+
+    u = hit.par[0];
+    v = hit.par[1];
+    return true;
+  }
+
+
+
 
 
   //**************************************************
@@ -591,6 +870,43 @@ namespace GMlib {
   }
 
 
+  /*! void PSurf<T,n>::getSampleParameters( std::vector<T>& u, std::vector<T>& v ) const
+   *  The parameter values of the sample lines of all partitions, in the domain of the surface,
+   *  sorted and without duplicates. Both are empty if the surface is not sampled.
+   *
+   *  \param[out] u  The u-parameter values
+   *  \param[out] v  The v-parameter values
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::getSampleParameters( std::vector<T>& u, std::vector<T>& v ) const {
+
+    u.clear();
+    v.clear();
+
+    for( int i = 0; i < _visu.getDim1(); i++ )
+      for( int j = 0; j < _visu.getDim2(); j++ ) {
+        const Partition& part = _visu[i][j];
+        const int m1 = part(0);
+        const int m2 = part(1);
+        if( m1 < 2 || m2 < 2 ) continue;
+
+        for( int a = 0; a < m1; a++ ) {
+          const T s = part.u.empty() ? part.s_e_u[0] + a * (part.s_e_u[1] - part.s_e_u[0]) / (m1-1) : part.u[a];
+          u.push_back( getStartPU() + _tr_u + (s - getStartPU()) * _sc_u );
+        }
+        for( int b = 0; b < m2; b++ ) {
+          const T s = part.v.empty() ? part.s_e_v[0] + b * (part.s_e_v[1] - part.s_e_v[0]) / (m2-1) : part.v[b];
+          v.push_back( getStartPV() + _tr_v + (s - getStartPV()) * _sc_v );
+        }
+      }
+
+    std::sort( u.begin(), u.end() );
+    u.erase( std::unique( u.begin(), u.end() ), u.end() );
+    std::sort( v.begin(), v.end() );
+    v.erase( std::unique( v.begin(), v.end() ), v.end() );
+  }
+
+
 
   //******************************************
   // Virtual functons for surface properies **
@@ -634,15 +950,27 @@ namespace GMlib {
   template <typename T, int n>
   void PSurf<T,n>::sample( int m1, int m2, int d1, int d2 ) {
 
+    cancelAsyncReplot();
     initSample(m1, m2, d1, d2);
-    _visu[0][0] = {m1,m2};
+    _visu[0][0] = Vector<int,2>(m1,m2);
     _visu[0][0].s_e_u = { getStartPU(), getEndPU()};
     _visu[0][0].s_e_v = { getStartPV(), getEndPV()};
-    DMatrix<DMatrix<Vector<T,n>>>&  p = _visu[0][0].sample_val;
+    DSampleGrid<Vector<T,n>>&       p = _visu[0][0].sample_val;
     DMatrix<Vector<float,n>>& normals = _visu[0][0].normals;
     Sphere<T,3>&                    s = _visu[0][0].sur_sphere;
     // Calculate sample positions, derivatives, normals and surrounding sphere
-    resample( p, m1, m2, d1, d2, _visu[0][0].s_e_u[0], _visu[0][0].s_e_v[0], _visu[0][0].s_e_u[1], _visu[0][0].s_e_v[1] );
+    if( this->isAdaptiveSampling() ) {
+      std::vector<T>& u = _visu[0][0].u;
+      std::vector<T>& v = _visu[0][0].v;
+      makeSampleValues( u, v, m1, m2, _visu[0][0].s_e_u[0], _visu[0][0].s_e_v[0], _visu[0][0].s_e_u[1], _visu[0][0].s_e_v[1] );
+      _visu[0][0] = Vector<int,2>( int(u.size()), int(v.size()) );
+      resample( p, u, v, d1, d2 );
+    }
+    else {
+      _visu[0][0].u.clear();
+      _visu[0][0].v.clear();
+      resample( p, m1, m2, d1, d2, _visu[0][0].s_e_u[0], _visu[0][0].s_e_v[0], _visu[0][0].s_e_u[1], _visu[0][0].s_e_v[1] );
+    }
     resampleNormals( p, normals );
     computeSurroundingSphere(p, s);
 
@@ -661,6 +989,8 @@ namespace GMlib {
   template <typename T, int n>
   void PSurf<T,n>::initSample( int& mu, int& mv, int& du, int& dv )  {
 
+      invalidateBvh();
+
       if( mu != _visu.no_sample[0] && mu > 1) { // u - direction
           _visu.no_sample[0] = mu;
           preSample(1, mu);
@@ -686,6 +1016,416 @@ namespace GMlib {
   template <typename T, int n>
   void PSurf<T,n>::replot() const {
 
+    // The shape is changed, the samples of the other levels of detail are outdated
+    clearLodCache();
+    if( _async ) _replotAsync();
+    else {
+      restartAsyncReplot();
+      _replot();
+    }
+  }
+
+
+
+
+  /*! void PSurf<T,n>::setLodLevels( const std::vector<Vector<int,2>>& levels, float pixels, int no_cached )
+   *  Turns on level of detail, an empty vector turns it off.
+   *  For each frame the level is selected such that the distance between the samples on the
+   *  screen is about the given number of pixels, see Parametrics::selectLodLevel().
+   *  The samples of the most recently used levels are kept, and are swapped in
+   *  without resampling when the level is used again.
+   *
+   *  \param[in] levels     Number of samples in u and v direction of each level, from coarse to fine
+   *  \param[in] pixels     Wanted distance between the samples on the screen
+   *  \param[in] no_cached  Number of levels to keep the samples of, in addition to the current
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::setLodLevels( const std::vector<Vector<int,2>>& levels, float pixels, int no_cached ) {
+
+    _lod_samples = levels;
+    this->_lod_size.resize( levels.size() );
+    for( unsigned int i = 0; i < levels.size(); i++ )
+      this->_lod_size[i] = std::max( levels[i][0], levels[i][1] );
+    this->_lod_pixels    = pixels;
+    this->_lod_no_cached = no_cached;
+    this->_lod_level     = -1;
+    clearLodCache();
+  }
+
+
+
+
+  /*! void PSurf<T,n>::setLodLevel( int level )
+   *  Changes the samples to the given level of detail.
+   *  The samples of the current level are cached. The samples of the new level are
+   *  swapped in at once if they are in the cache, else the level is sampled in the background
+   *  (see setAsyncReplot()) and the current level is drawn until swapAsyncReplot() swaps it in.
+   *  The surface is sampled at once if makeSnapshot() gives no copy.
+   *
+   *  \param[in] level  The level of detail, index in the vector given to setLodLevels()
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::setLodLevel( int level ) {
+
+    if( level < 0 || level >= int(_lod_samples.size()) ) return;
+
+    // Back to the current level, a pending change of level is dropped
+    if( level == this->_lod_level ) {
+      if( _async_replot && _async_replot->level >= 0 ) cancelAsyncReplot();
+      return;
+    }
+    if( _async_replot && _async_replot->level == level ) return;
+
+    // The current samples are outdated if a resampling is pending
+    const bool keep = !_async_replot || _async_replot->keep;
+
+    auto it = _lod_cache.begin();
+    while( it != _lod_cache.end() && it->level != level ) ++it;
+
+    if( it != _lod_cache.end() && int(it->parts.size()) == _visu.getDim1() * _visu.getDim2() ) {
+      std::vector<Partition> parts;
+      parts.swap( it->parts );
+      _lod_cache.erase( it );
+      cancelAsyncReplot();
+      _swapLod( level, parts, keep );
+      return;
+    }
+    if( it != _lod_cache.end() ) _lod_cache.erase( it );
+
+    if( _startAsync( level, keep ) ) return;
+
+    // No copy to sample in the background
+    std::vector<Partition> parts;
+    _swapLod( level, parts, keep );
+  }
+
+
+
+
+  template <typename T, int n>
+  inline
+  void PSurf<T,n>::clearLodCache() const {
+
+    _lod_cache.clear();
+  }
+
+
+
+  /*! void PSurf<T,n>::invalidateBvh() const
+   *  The samples have changed, the hierarchy returned by getBvh() and the k-d tree of getClosestPoints()
+   *  are updated the next time they are used.
+   *  Done by sample() and replot(), surfaces that update the samples in other ways must call it.
+   */
+  template <typename T, int n>
+  inline
+  void PSurf<T,n>::invalidateBvh() const {
+
+    _bvh_dirty = true;
+    _clp_dirty = true;
+  }
+
+
+
+
+  template <typename T, int n>
+  void PSurf<T,n>::localUpdateLod( const Camera& cam ) {
+
+    swapAsyncReplot();
+    Parametrics<T,2,n>::localUpdateLod( cam );
+  }
+
+
+
+
+  /*! void PSurf<T,n>::setAsyncReplot( bool async )
+   *  In async mode replot() resamples all partitions on a worker thread (Parallel::WorkerPool::getDefault())
+   *  into a back buffer, and returns at once. The visualizers keep the previous samples until the
+   *  finished samples are swapped in by swapAsyncReplot(), which is done before rendering the next frame.
+   *  A new replot() cancels the previous resampling.
+   *  The job samples a copy of the evaluation state of the surface made by makeSnapshot() when it is started,
+   *  so the surface can be edited while the job is running. Objects the surface only refers to are not copied,
+   *  and must not be changed while a resampling is pending.
+   *  Surfaces makeSnapshot() gives no copy of are replotted at once.
+   *
+   *  \param[in] async  Whether to resample in the background
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::setAsyncReplot( bool async ) {
+
+    _async = async;
+    if( !async && _async_replot && _async_replot->level < 0 ) cancelAsyncReplot();
+  }
+
+
+
+  template <typename T, int n>
+  inline
+  bool PSurf<T,n>::isAsyncReplot() const {
+
+    return _async;
+  }
+
+
+
+  template <typename T, int n>
+  inline
+  bool PSurf<T,n>::isAsyncReplotPending() const {
+
+    return bool(_async_replot);
+  }
+
+
+
+  /*! bool PSurf<T,n>::swapAsyncReplot()
+   *  Swaps in the samples of a finished background resampling, and gives them to the visualizers.
+   *  The samples are dropped if the surface has been sampled with other numbers of samples since the job was started.
+   *
+   *  \return True if samples were swapped in, false if there were none or the resampling is not done
+   */
+  template <typename T, int n>
+  bool PSurf<T,n>::swapAsyncReplot() {
+
+    _releaseCancelled();
+    if( !_async_replot || !_async_replot->job->isDone() ) return false;
+
+    std::shared_ptr<AsyncReplot> rep;
+    rep.swap( _async_replot );
+
+    const int k = _visu.getDim1() * _visu.getDim2();
+
+    if( rep->level >= 0 ) {
+      if( int(rep->parts.size()) != k ) rep->parts.clear();
+      _swapLod( rep->level, rep->parts, rep->keep );
+      return true;
+    }
+
+    if( int(rep->parts.size()) != k ||
+        rep->m[0] != _visu.no_sample[0] || rep->m[1] != _visu.no_sample[1] ) return false;
+
+    for( int i = 0; i < k; i++ )
+      _swapSamples( rep->parts[i], _visu[i / _visu.getDim2()][i % _visu.getDim2()] );
+    _replot();
+    return true;
+  }
+
+
+
+  /*! void PSurf<T,n>::waitAsyncReplot() const
+   *  Waits until the background resampling is done, the samples are not swapped in.
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::waitAsyncReplot() const {
+
+    if( _async_replot ) _async_replot->job->join();
+  }
+
+
+
+  /*! void PSurf<T,n>::_replotAsync() const
+   *  Private, starts the background resampling of all partitions,
+   *  with the same number of samples, derivatives and parameter values as now.
+   *  A pending change of level of detail is started again, on the edited surface.
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::_replotAsync() const {
+
+    const int level = _async_replot ? _async_replot->level : -1;
+    if( !_startAsync( level, false ) ) _replot();
+  }
+
+
+
+  /*! bool PSurf<T,n>::_startAsync( int level, bool keep ) const
+   *  Private, cancels the pending resampling and starts a new on a snapshot of the surface (makeSnapshot()).
+   *  For level -1 the current partitions are resampled, else the copy is sampled with
+   *  the numbers of samples of the level.
+   *
+   *  \param[in] level  The level of detail to sample, -1 to resample the current parameter values
+   *  \param[in] keep   Whether the current samples are to be cached when the level is swapped in
+   *  \return False if the surface could not be copied, nothing is then started
+   */
+  template <typename T, int n>
+  bool PSurf<T,n>::_startAsync( int level, bool keep ) const {
+
+    cancelAsyncReplot();
+
+    std::shared_ptr<AsyncReplot> rep = std::make_shared<AsyncReplot>();
+    rep->surf.reset( makeSnapshot() );
+    if( !rep->surf ) return false;
+
+    rep->level = level;
+    rep->keep  = keep;
+    if( level < 0 ) rep->m = Vector<int,2>( _visu.no_sample[0], _visu.no_sample[1] );
+    else            rep->m = _lod_samples[level];
+    const Vector<int,2> m  = rep->m;
+    const int           d1 = std::max( 1, _visu.no_derivatives[0] );
+    const int           d2 = std::max( 1, _visu.no_derivatives[1] );
+
+    if( level < 0 ) {
+      rep->parts.resize( _visu.getDim1() * _visu.getDim2() );
+      for( unsigned int i = 0; i < rep->parts.size(); i++ ) {
+        const Partition& part = _visu[i / _visu.getDim2()][i % _visu.getDim2()];
+        rep->parts[i] = Vector<int,2>( part );
+        rep->parts[i].s_e_u = part.s_e_u;
+        rep->parts[i].s_e_v = part.s_e_v;
+        rep->parts[i].u     = part.u;
+        rep->parts[i].v     = part.v;
+      }
+    }
+
+    // The job does not own rep, so the snapshot is released on this thread (see cancelAsyncReplot())
+    AsyncReplot* r = rep.get();
+    rep->job = Parallel::AsyncJob::submit( [r, m, d1, d2]( Parallel::AsyncJob& job ) {
+
+      PSurf<T,n>& surf = *r->surf;
+      int m1 = m[0], m2 = m[1], e1 = d1, e2 = d2;
+      if( r->level < 0 ) {
+        surf.initSample( m1, m2, e1, e2 );
+        for( Partition& part : r->parts ) {
+
+          if( job.isCancelled() ) return;
+          if( part.u.empty() )
+            surf.resample( part.sample_val, part(0), part(1), d1, d2, part.s_e_u[0], part.s_e_v[0], part.s_e_u[1], part.s_e_v[1] );
+          else
+            surf.resample( part.sample_val, part.u, part.v, d1, d2 );
+          surf.resampleNormals( part.sample_val, part.normals );
+          surf.computeSurroundingSphere( part.sample_val, part.sur_sphere );
+        }
+      }
+      else {
+        surf.sample( m1, m2, e1, e2 );
+        r->parts.resize( surf._visu.getDim1() * surf._visu.getDim2() );
+        for( unsigned int i = 0; i < r->parts.size(); i++ )
+          _swapSamples( r->parts[i], surf._visu[i / surf._visu.getDim2()][i % surf._visu.getDim2()] );
+      }
+    } );
+    _async_replot = rep;
+    return true;
+  }
+
+
+
+  /*! PSurf<T,n>* PSurf<T,n>::makeSnapshot() const
+   *  A copy of the evaluation state of the surface, sampled by a background resampling
+   *  (see setAsyncReplot()). It has no samples and visualizers.
+   *  The default is the copy made by makeCopy(), which has the children of the surface.
+   *  Surfaces with local patches as children override it, and only copy the evaluation state of these.
+   *
+   *  \return The copy, or nullptr if makeCopy() does not give a copy of the same class
+   */
+  template <typename T, int n>
+  PSurf<T,n>* PSurf<T,n>::makeSnapshot() const {
+
+    SceneObject* obj  = const_cast<PSurf<T,n>*>( this )->makeCopy();
+    PSurf<T,n>*  surf = dynamic_cast<PSurf<T,n>*>( obj );
+    if( !surf || typeid(*surf) != typeid(*this) ) {
+      delete obj;
+      return nullptr;
+    }
+    return surf;
+  }
+
+
+
+  /*! void PSurf<T,n>::_swapLod( int level, std::vector<Partition>& parts, bool keep )
+   *  Private, makes the given samples of a level of detail the current samples,
+   *  the surface is sampled if parts does not fit the partitions.
+   *
+   *  \param[in] level  The level of detail of the samples
+   *  \param[in] parts  The samples, get the previous samples
+   *  \param[in] keep   Whether to cache the previous samples
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::_swapLod( int level, std::vector<Partition>& parts, bool keep ) {
+
+    const int k = _visu.getDim1() * _visu.getDim2();
+
+    // Keep the samples of the current level
+    if( keep && this->_lod_level >= 0 ) {
+      _lod_cache.push_front( LodSet() );
+      _lod_cache.front().level = this->_lod_level;
+      _lod_cache.front().parts.resize( k );
+      for( int i = 0; i < k; i++ )
+        _swapSamples( _lod_cache.front().parts[i], _visu[i / _visu.getDim2()][i % _visu.getDim2()] );
+      while( int(_lod_cache.size()) > this->_lod_no_cached ) _lod_cache.pop_back();
+    }
+    this->_lod_level = level;
+
+    int m1 = _lod_samples[level][0];
+    int m2 = _lod_samples[level][1];
+    int d1 = std::max( 1, _visu.no_derivatives[0] );
+    int d2 = std::max( 1, _visu.no_derivatives[1] );
+
+    if( int(parts.size()) == k ) {
+      initSample( m1, m2, d1, d2 );
+      for( int i = 0; i < k; i++ )
+        _swapSamples( parts[i], _visu[i / _visu.getDim2()][i % _visu.getDim2()] );
+      lodSwapped();
+    }
+    else
+      sample( m1, m2, d1, d2 );
+
+    _replot();
+  }
+
+
+
+  /*! void PSurf<T,n>::restartAsyncReplot() const
+   *  The shape is changed outside replot(). A pending change of level of detail is
+   *  started again on the changed surface, and a pending resampling is cancelled.
+   *  Done by replot(), surfaces that update the samples in other ways must call it.
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::restartAsyncReplot() const {
+
+    if( _async_replot && _async_replot->level >= 0 )
+      _startAsync( _async_replot->level, _async_replot->keep );
+    else
+      cancelAsyncReplot();
+  }
+
+
+
+  /*! void PSurf<T,n>::cancelAsyncReplot() const
+   *  Cancels the background resampling, its samples are not swapped in.
+   *  A running job finishes on its own copy of the surface, the copy is released
+   *  by a later swapAsyncReplot() or cancelAsyncReplot(), or by the destructor.
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::cancelAsyncReplot() const {
+
+    if( _async_replot ) {
+      _async_replot->job->cancel();
+      _async_cancelled.push_back( _async_replot );
+      _async_replot.reset();
+    }
+    _releaseCancelled();
+  }
+
+
+
+  /*! void PSurf<T,n>::_releaseCancelled( bool wait ) const
+   *  Private, releases the cancelled resamplings whose jobs have stopped,
+   *  so the copies of the surface are deleted on this thread and not in the worker pool.
+   *
+   *  \param[in] wait  Wait for the running jobs to stop, all are released
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::_releaseCancelled( bool wait ) const {
+
+    for( auto it = _async_cancelled.begin(); it != _async_cancelled.end(); ) {
+      if( wait ) (*it)->job->join();
+      if( (*it)->job->isStopped() ) it = _async_cancelled.erase( it );
+      else                          ++it;
+    }
+  }
+
+
+
+
+  template <typename T, int n>
+  void PSurf<T,n>::_replot() const {
+
     // Give reference to updated data to all visualizers
     for( int i=0; i<_visu.getDim1(); i++ )
       for( int j=0; j<_visu.getDim2(); j++ )
@@ -695,6 +1435,7 @@ namespace GMlib {
           _visu[i][j].vis[r]->set(_visu.getDim1()>1? false:isClosedU(), _visu.getDim2()>1? false:isClosedV());
         }
     uppdateSurroundingSphere();
+    invalidateBvh();
     SceneObject::replot();
   }
 
@@ -797,36 +1538,44 @@ namespace GMlib {
 
 
 
+  /*! void PSurf<T,n>::resample( DSampleGrid<Vector<T,n>>& p, int m1, int m2, int d1, int d2, T s_u, T s_v, T e_u, T e_v ) const
+   *  Computing a m1 x m2 grid of samples with d1/d2 derivatives in the domain [s_u,e_u]x[s_v,e_v].
+   *  The last row/column is evaluated from the right side (lu/lv = false).
+   *  The rows are computed in parallel if setResampleThreads() has been set to use more than one thread,
+   *  the result is the same as for the serial computation.
+   *
+   *  \param[out] p    The samples
+   *  \param[in]  m1   The number of samples in u-direction
+   *  \param[in]  m2   The number of samples in v-direction
+   *  \param[in]  d1   The number of derivatives in u-direction
+   *  \param[in]  d2   The number of derivatives in v-direction
+   *  \param[in]  s_u  Start parameter value in u-direction
+   *  \param[in]  s_v  Start parameter value in v-direction
+   *  \param[in]  e_u  End parameter value in u-direction
+   *  \param[in]  e_v  End parameter value in v-direction
+   */
   template <typename T, int n>
-  void PSurf<T,n>::resample( DMatrix< DMatrix < Vector<T,n> > >& p,
+  void PSurf<T,n>::resample( DSampleGrid<Vector<T,n>>& p,
                                     int m1, int m2, int d1, int d2, T s_u, T s_v, T e_u, T e_v ) const {
     _resample = true;
-    p.setDim(m1, m2);
+    p.setDim(m1, m2, d1, d2);
 
     T du = (e_u-s_u)/(m1-1);
     T dv = (e_v-s_v)/(m2-1);
 
-    for(int i=0; i<m1-1; i++) {
-      _ind[0]=i;
-      T u = s_u + i*du;
-      for(int j=0;j<m2-1;j++) {
-        _ind[1]=j;
-        eval(u, s_v + j*dv, d1, d2, true, true );
-        p[i][j] = _p;
+    Parallel::forBlocks( 0, m1, [&]( int b, int e ) {
+      DMatrix<Vector<T,n>> q;     // One evaluation matrix for the whole block
+      for(int i=b; i<e; i++) {
+        const bool lu = i < m1-1;
+        const T    u  = lu ? s_u + i*du : e_u;
+        for(int j=0;j<m2-1;j++) {
+          evalSample( q, i, j, u, s_v + j*dv, d1, d2, lu, true );
+          p.setSample( q, i, j );
+        }
+        evalSample( q, i, m2-1, u, e_v, d1, d2, lu, false );
+        p.setSample( q, i, m2-1 );
       }
-      _ind[1]=m2-1;
-      eval(u, e_v, d1, d2, true, false);
-      p[i][m2-1] = _p;
-    }
-    _ind[0]=m1-1;
-    for(int j=0;j<m2-1;j++) {
-      _ind[1]=j;
-      eval(e_u, s_v + j*dv, d1, d2, false, true);
-      p[m1-1][j] = _p;
-    }
-    _ind[1]=m2-1;
-    eval(e_u, e_v, d1, d2, false, false);
-    p[m1-1][m2-1] = _p;
+    }, _no_threads );
 
     switch( this->_dm ) {
       case GM_DERIVATION_EXPLICIT:
@@ -835,7 +1584,7 @@ namespace GMlib {
         // if( this->_derivation_method == this->EXPLICIT ) { ... eval algorithms for derivatives ... }
         break;
       case GM_DERIVATION_DD:
-        DD::compute2D(p,double(du),double(dv),isClosedU(),isClosedV(),d1,d2);
+        DD::compute2D(p,double(du),double(dv),isClosedU(),isClosedV(),d1,d2,0,0,_no_threads);
         break;
     }
 
@@ -845,26 +1594,153 @@ namespace GMlib {
 
   template <typename T, int n>
   inline
-  void PSurf<T,n>::resample( DMatrix<DMatrix <DMatrix <Vector<T,n> > > >& a,
+  void PSurf<T,n>::resample( DSampleGrid<Vector<T,n>>& a,
                                                 int m1, int m2, int d1, int d2 ) {
 
     resample( a, m1, m2, d1, d2, getStartPU(), getStartPV(), getEndPU(), getEndPV() );
   }
 
 
+  /*! void PSurf<T,n>::resample( DSampleGrid<Vector<T,n>>& p, const std::vector<T>& u, const std::vector<T>& v, int d1, int d2 ) const
+   *  Computing the samples with d1/d2 derivatives at the (non-uniform) parameter values u x v.
+   *  The samples are computed by eval(), the last row/column is evaluated from the right side.
+   *  The rows are computed in parallel as in the uniform resample().
+   *
+   *  \param[out] p    The samples
+   *  \param[in]  u    The parameter values in u-direction, increasing
+   *  \param[in]  v    The parameter values in v-direction, increasing
+   *  \param[in]  d1   The number of derivatives in u-direction
+   *  \param[in]  d2   The number of derivatives in v-direction
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::resample( DSampleGrid<Vector<T,n>>& p, const std::vector<T>& u, const std::vector<T>& v, int d1, int d2 ) const {
+
+    const int m1 = int(u.size());
+    const int m2 = int(v.size());
+    p.setDim(m1, m2, d1, d2);
+
+    Parallel::forBlocks( 0, m1, [&]( int b, int e ) {
+      DMatrix<Vector<T,n>> q;
+      for(int i=b; i<e; i++)
+        for(int j=0; j<m2; j++) {
+          eval( q, u[i], v[j], d1, d2, i < m1-1, j < m2-1 );
+          p.setSample( q, i, j );
+        }
+    }, _no_threads );
+
+    if( this->_dm == GM_DERIVATION_DD )
+      DD::compute2D( p, u, v, isClosedU(), isClosedV(), d1, d2 );
+  }
+
+
+  /*! void PSurf<T,n>::makeSampleValues( std::vector<T>& u, std::vector<T>& v, int m1, int m2, T s_u, T s_v, T e_u, T e_v ) const
+   *  Adaptive parameter values for sampling, see setAdaptiveSampling().
+   *  Starting with m1 x m2 uniform values, the u-intervals are split where the u-curves deviate
+   *  too much from the sample polylines, and then the v-intervals the same way.
+   *  The u-curves are taken at the v-values and in the middle of the v-intervals (and the
+   *  v-curves the same way), so features between the sample rows are also found.
+   *  This is repeated until no values are added.
+   *  The error of an interval is measured at its quarter points.
+   *
+   *  \param[out] u    The parameter values in u-direction
+   *  \param[out] v    The parameter values in v-direction
+   *  \param[in]  m1   The initial number of samples in u-direction
+   *  \param[in]  m2   The initial number of samples in v-direction
+   *  \param[in]  s_u  Start parameter value in u-direction
+   *  \param[in]  s_v  Start parameter value in v-direction
+   *  \param[in]  e_u  End parameter value in u-direction
+   *  \param[in]  e_v  End parameter value in v-direction
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::makeSampleValues( std::vector<T>& u, std::vector<T>& v, int m1, int m2, T s_u, T s_v, T e_u, T e_v ) const {
+
+    computeUniformParamVal( u, m1, s_u, e_u );
+    computeUniformParamVal( v, m2, s_v, e_v );
+
+    // The sample values, and the middle of the intervals, in the other direction
+    std::vector<T> w;
+    auto makeLines = [&w]( const std::vector<T>& t ) {
+      w.resize( 2*t.size() - 1 );
+      for( unsigned int i = 0; i < t.size(); i++ ) {
+        w[2*i] = t[i];
+        if( i > 0 ) w[2*i-1] = (t[i-1] + t[i]) / 2;
+      }
+    };
+
+    DMatrix<Vector<T,n>> q;
+    Point<T,n> p[5];
+
+    auto error_u = [&]( T a, T b ) {
+      T err = T(0);
+      for( unsigned int j = 0; j < w.size(); j++ ) {
+        for( int i = 0; i < 5; i++ ) {
+          eval( q, a + i*(b-a)/4, w[j], 0, 0, i > 0, j > 0 );
+          p[i] = q[0][0];
+        }
+        err = std::max( err, polylineError( p, 5, this->_adapt_eps, this->_adapt_angle ) );
+      }
+      return err;
+    };
+
+    auto error_v = [&]( T a, T b ) {
+      T err = T(0);
+      for( unsigned int j = 0; j < w.size(); j++ ) {
+        for( int i = 0; i < 5; i++ ) {
+          eval( q, w[j], a + i*(b-a)/4, 0, 0, j > 0, i > 0 );
+          p[i] = q[0][0];
+        }
+        err = std::max( err, polylineError( p, 5, this->_adapt_eps, this->_adapt_angle ) );
+      }
+      return err;
+    };
+
+    for( bool refined = true; refined; ) {
+
+      makeLines( v );
+      refined  = refineAdaptiveParamVal( u, this->_adapt_max, error_u ) > 0;
+
+      makeLines( u );
+      refined |= refineAdaptiveParamVal( v, this->_adapt_max, error_v ) > 0;
+    }
+  }
+
+
   template <typename T, int n>
-  void PSurf<T,n>::resampleNormals( const DMatrix<DMatrix<Vector<T,n> > > &p, DMatrix<Vector<float,3> > &normals ) const {
+  void PSurf<T,n>::resampleNormals( const DSampleGrid<Vector<T,n>> &p, DMatrix<Vector<float,3> > &normals ) const {
 
     normals.setDim( p.getDim1(), p.getDim2() );
 
+    const Vector<T,n>* pu = p.getPlane(1,0);
+    const Vector<T,n>* pv = p.getPlane(0,1);
     for( int i = 0; i < p.getDim1(); i++ )
-      for( int j = 0; j < p.getDim2(); j++ ){
-        normals[i][j] = p(i)(j)(1)(0) ^ p(i)(j)(0)(1);
+      for( int j = 0; j < p.getDim2(); j++, pu++, pv++ ){
+        normals[i][j] = *pu ^ *pv;
         normals[i][j].normalize();
       }
   }
 
 
+  template <typename T, int n>
+  inline
+  void PSurf<T,n>::evalSample( DMatrix<Vector<T,n>>& p, int /*i*/, int /*j*/, T u, T v, int d1, int d2, bool lu, bool lv ) const {
+
+    eval( p, u, v, d1, d2, lu, lv );
+  }
+
+
+  template <typename T, int n>
+  void PSurf<T,n>::evalBatch( Vector<T,n>* p, const T* u, const T* v, int m, int d1, int d2, bool lu, bool lv ) const {
+
+    DMatrix<Vector<T,n>> q(d1+1, d2+1);
+    for( int i = 0; i < m; i++ ) {
+      eval( q, u[i], v[i], d1, d2, lu, lv );
+      for( int k = 0; k <= d1; k++ )
+        for( int l = 0; l <= d2; l++ )
+          p[(k*(d2+1)+l)*m+i] = q[k][l];
+    }
+  }
+
+
   template <typename T, int n>
   inline
   void PSurf<T,n>::setDomainU( T start, T end ) {
@@ -933,8 +1809,33 @@ namespace GMlib {
 
 
 
+  /*! void PSurf<T,n>::setResampleThreads( int no_threads )
+   *  Set the number of threads to use when resampling the surface.
+   *  1 (default) is serial resampling, 0 is one thread for each core.
+   *  The result of the resampling is the same for any number of threads.
+   *
+   *  \param[in] no_threads  The number of threads
+   */
+  template <typename T, int n>
+  inline
+  void PSurf<T,n>::setResampleThreads( int no_threads ) {
+
+     _no_threads = no_threads;
+  }
+
+
+
+  template <typename T, int n>
+  inline
+  int PSurf<T,n>::getResampleThreads() const {
+
+     return _no_threads;
+  }
+
+
+
   template <typename T, int n>
-  void PSurf<T,n>::setSurroundingSphere( const DMatrix< DMatrix< Vector<T,n> > >& p ) const {
+  void PSurf<T,n>::setSurroundingSphere( const DSampleGrid<Vector<T,n>>& p ) const {
     Sphere<T,n>&  s = _visu[0][0].sur_sphere;
     computeSurroundingSphere(p, s);
     SceneObject::setSurroundingSphere(s);
@@ -943,7 +1844,7 @@ namespace GMlib {
 
 
   template <typename T, int n>
-  void PSurf<T,n>::computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,n>>>& p, Sphere<T,n>& s ) const {
+  void PSurf<T,n>::computeSurroundingSphere( const DSampleGrid<Vector<T,n>>& p, Sphere<T,n>& s ) const {
 
       int n1 = p.getDim1()-1;
       int m1 = p.getDim2()-1;
@@ -951,27 +1852,27 @@ namespace GMlib {
       int m2 = m1/2;
       s.reset();
       // center
-      s += p(n2)(m2)(0)(0).toPoint();
+      s += p(n2,m2).toPoint();
       // corner
-      s += p( 0)( 0)(0)(0).toPoint();
-      s += p(n1)(m1)(0)(0).toPoint();
-      s += p(n1)( 0)(0)(0).toPoint();
-      s += p( 0)(m1)(0)(0).toPoint();
+      s += p( 0, 0).toPoint();
+      s += p(n1,m1).toPoint();
+      s += p(n1, 0).toPoint();
+      s += p( 0,m1).toPoint();
       // midpoints edge
-      s += p(n1)(m2)(0)(0).toPoint();
-      s += p( 0)(m2)(0)(0).toPoint();
-      s += p(n2)(m1)(0)(0).toPoint();
-      s += p(n2)( 0)(0)(0).toPoint();
+      s += p(n1,m2).toPoint();
+      s += p( 0,m2).toPoint();
+      s += p(n2,m1).toPoint();
+      s += p(n2, 0).toPoint();
       // quater points
       if(n1>4 && n2>4) {
           int n4 = n1/4;
           int n3 = 3*n4;
           int m4 = m1/4;
           int m3 = 3*m4;
-          s += p(n4)(m4)(0)(0).toPoint();
-          s += p(n3)(m3)(0)(0).toPoint();
-          s += p(n4)(m3)(0)(0).toPoint();
-          s += p(n3)(m4)(0)(0).toPoint();
+          s += p(n4,m4).toPoint();
+          s += p(n3,m3).toPoint();
+          s += p(n4,m3).toPoint();
+          s += p(n3,m4).toPoint();
       }
       if(n1>8 && m1>8) {
           n1 /= 8;
@@ -982,30 +1883,49 @@ namespace GMlib {
           int m5 = 5*m1;
           int n7 = 7*n1;
           int m7 = 7*m1;
-          s += p(n1)(m1)(0)(0).toPoint();
-          s += p(n7)(m7)(0)(0).toPoint();
-          s += p(n1)(m7)(0)(0).toPoint();
-          s += p(n7)(m1)(0)(0).toPoint();
-
-          s += p(n3)(m3)(0)(0).toPoint();
-          s += p(n5)(m5)(0)(0).toPoint();
-          s += p(n3)(m5)(0)(0).toPoint();
-          s += p(n5)(m3)(0)(0).toPoint();
-
-          s += p(n1)(m3)(0)(0).toPoint();
-          s += p(n7)(m5)(0)(0).toPoint();
-          s += p(n5)(m7)(0)(0).toPoint();
-          s += p(n3)(m1)(0)(0).toPoint();
-
-          s += p(n7)(m3)(0)(0).toPoint();
-          s += p(n5)(m1)(0)(0).toPoint();
-          s += p(n3)(m7)(0)(0).toPoint();
-          s += p(n1)(m5)(0)(0).toPoint();
+          s += p(n1,m1).toPoint();
+          s += p(n7,m7).toPoint();
+          s += p(n1,m7).toPoint();
+          s += p(n7,m1).toPoint();
+
+          s += p(n3,m3).toPoint();
+          s += p(n5,m5).toPoint();
+          s += p(n3,m5).toPoint();
+          s += p(n5,m3).toPoint();
+
+          s += p(n1,m3).toPoint();
+          s += p(n7,m5).toPoint();
+          s += p(n5,m7).toPoint();
+          s += p(n3,m1).toPoint();
+
+          s += p(n7,m3).toPoint();
+          s += p(n5,m1).toPoint();
+          s += p(n3,m7).toPoint();
+          s += p(n1,m5).toPoint();
       }
       if(n1>2 && m1>2)
           for(int i=1; i<p.getDim1()-2; i+=4)
               for(int j=1; j<p.getDim2()-2; j+=4)
-                  s += p(i)(j)(0)(0).toPoint();
+                  s += p(i,j).toPoint();
+  }
+
+
+
+
+  /*! void PSurf<T,n>::_swapSamples( Partition& a, Partition& b )
+   *  Private, swaps the sample data (not the visualizers) of two partitions.
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::_swapSamples( Partition& a, Partition& b ) {
+
+    std::swap( static_cast<Vector<int,2>&>(a), static_cast<Vector<int,2>&>(b) );
+    std::swap( a.s_e_u, b.s_e_u );
+    std::swap( a.s_e_v, b.s_e_v );
+    std::swap( a.sample_val, b.sample_val );
+    std::swap( a.normals, b.normals );
+    std::swap( a.sur_sphere, b.sur_sphere );
+    a.u.swap( b.u );
+    a.v.swap( b.v );
   }
 
 
@@ -1114,12 +2034,68 @@ namespace GMlib {
       _v  = v;
       _d1 = d1;
       _d2 = d2;
-      eval( _mapU(u), _mapV(v), d1, d2 );
+      eval( _p, _mapU(u), _mapV(v), d1, d2 );
     }
   }
 
 
 
+  /*! void PSurf<T,n>::_getSamples( std::vector<Point<T,n>>& p, std::vector<Point<T,2>>& uv,
+   *                                  std::vector<Vector<int,2>>* grids ) const
+   *  Private, the sample positions (local coordinates) of all partitions and their parameter values,
+   *  or a 20x20 grid if the surface is not sampled. The samples of each grid are row by row,
+   *  and the sizes of the grids are put in grids if it is not nullptr.
+   */
+  template <typename T, int n>
+  void PSurf<T,n>::_getSamples( std::vector<Point<T,n>>& p, std::vector<Point<T,2>>& uv,
+                                std::vector<Vector<int,2>>* grids ) const {
+
+    p.clear();
+    uv.clear();
+    if( grids ) grids->clear();
+
+    // From formula domain to the domain of the surface
+    auto par = [this]( T u, T v ) {
+      return Point<T,2>( getStartPU() + _tr_u + (u - getStartPU()) * _sc_u,
+                         getStartPV() + _tr_v + (v - getStartPV()) * _sc_v );
+    };
+
+    for( int i = 0; i < _visu.getDim1(); i++ )
+      for( int j = 0; j < _visu.getDim2(); j++ ) {
+        const Partition&                part = _visu[i][j];
+        const DSampleGrid<Vector<T,n>>& g    = part.sample_val;
+        const int m1 = g.getDim1();
+        const int m2 = g.getDim2();
+        if( m1 < 2 || m2 < 2 || m1 != part(0) || m2 != part(1) ) continue;
+        if( grids ) grids->push_back( Vector<int,2>( m1, m2 ) );
+
+        const T du = (part.s_e_u[1] - part.s_e_u[0]) / (m1-1);
+        const T dv = (part.s_e_v[1] - part.s_e_v[0]) / (m2-1);
+        for( int a = 0; a < m1; a++ )
+          for( int b = 0; b < m2; b++ ) {
+            p.push_back( g(a,b) );
+            uv.push_back( par( part.u.empty() ? part.s_e_u[0] + a*du : part.u[a],
+                               part.v.empty() ? part.s_e_v[0] + b*dv : part.v[b] ) );
+          }
+      }
+
+    if( !p.empty() ) return;
+
+    const int m = 20;
+    if( grids ) grids->push_back( Vector<int,2>( m, m ) );
+    DMatrix<Vector<T,n>> r;
+    for( int a = 0; a < m; a++ )
+      for( int b = 0; b < m; b++ ) {
+        const T u = getParStartU() + a * getParDeltaU() / (m-1);
+        const T v = getParStartV() + b * getParDeltaV() / (m-1);
+        evaluate( r, u, v, 0, 0 );
+        p.push_back( r[0][0] );
+        uv.push_back( Point<T,2>( u, v ) );
+      }
+  }
+
+
+
   template <typename T, int n>
   inline
   void PSurf<T,n>::_computeEFGefg( T u, T v, T& E, T& F, T& G, T& e, T& f, T& g ) const {
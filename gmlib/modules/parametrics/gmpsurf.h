@@ -31,10 +31,17 @@
 
 // gmlib
 #include <core/containers/gmarray.h>
+#include <core/containers/gmbvh.h>
 #include <core/containers/gmdmatrix.h>
+#include <core/containers/gmdsamplegrid.h>
+#include <core/containers/gmkdtree.h>
+#include <core/utils/gmparallel.h>
 
 // stl
 #include <fstream>
+#include <list>
+#include <memory>
+#include <typeinfo>
 
 
 namespace GMlib {
@@ -62,10 +69,12 @@ namespace GMlib {
     struct Partition: public Vector<int,2> {         //!< Number of samples in u and v direction.
       Vector<T,2>                        s_e_u;      //!< Start and end u-parameter values for this partition
       Vector<T,2>                        s_e_v;      //!< Start and end v-parameter values for this partition
-      DMatrix<DMatrix<Vector<T,3>>>      sample_val; //!< Vertices and derivatives for plotting
+      DSampleGrid<Vector<T,n>>           sample_val; //!< Vertices and derivatives for plotting
       DMatrix<Vector<float,n>>           normals;    //!< Surface normals for plotting
       Sphere<T,3>                        sur_sphere; //!< Surrounding sphere of this partition
       std::vector<PSurfVisualizer<T,n>*> vis;        //!< Visualizers for plotting (default always first)
+      std::vector<T>                     u;          //!< u-parameter values of the samples (adaptive sampling only)
+      std::vector<T>                     v;          //!< v-parameter values of the samples (adaptive sampling only)
       const Vector<int,2>& operator=(const Vector<int,2>& p) { return Vector<int,2>::operator=(p); }
     };
 
@@ -98,12 +107,26 @@ namespace GMlib {
     DMatrix<Vector<T,n> >&        evaluate( int i, int j ) const;
     DMatrix<Vector<T,n> >&        evaluateParent( int i, int j  ) const;
 
+    //****  Reentrant evaluation functons, result in a buffer owned by the caller  ****
+    void                          evaluate( DMatrix<Vector<T,n>>& p, T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const;
+    void                          evaluateParent( DMatrix<Vector<T,n>>& p, T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const;
+
+    //****  Batch evaluation of m parameter pairs, result in a buffer owned by the caller  ****
+    void                          evaluate( Vector<T,n>* p, const T* u, const T* v, int m, int d1, int d2, bool lu = true, bool lv = true ) const;
+
     //****  Closest point functons  ****
     virtual void                  estimateClpPar( const Point<T,n>& p, T& u, T& v, int m=20 ) const;
     virtual bool                  getClosestPoint( const Point<T,n>& q, T& u, T& v,
                                                    double eps = 10e-6, int max_iterations = 20 ) const;
     bool                          getClosestPoint( const Point<T,n>& q, Point<T,2>& uv,
                                                    double eps = 10e-6, int max_iterations = 20 ) const;
+    int                           getClosestPoints( const Point<T,n>* q, int m, Point<T,2>* uv, T* dist = nullptr,
+                                                    bool* converged = nullptr, double eps = 10e-6,
+                                                    int max_iterations = 20, int no_threads = 0 ) const;
+
+    //****  Spatial queries on the samples, a bounding volume hierarchy over the sampled triangles  ****
+    const Bvh<T>&                 getBvh() const;
+    bool                          getRayIntersection( const Point<T,n>& o, const Vector<T,n>& d, T& u, T& v ) const;
 
     //****  Curvature functons  ****
     virtual T                     getCurvatureGauss( T u, T v ) const;
@@ -139,6 +162,7 @@ namespace GMlib {
     int                           getSamPV( int i = 0 ) const;
     int                           getSamplesU() const;
     int                           getSamplesV() const;
+    void                          getSampleParameters( std::vector<T>& u, std::vector<T>& v ) const;
 
     //****  Virtual to see if the surface is open or closed, must be implemented local if closed ****
     virtual bool                  isClosedU() const;
@@ -150,6 +174,19 @@ namespace GMlib {
     // virtual from SceneObject, must be implemented in the specific surface if it is editable/ changing shape
     void                          replot() const override;
 
+    //****  Level of detail, the number of samples is selected from the size on the screen  ****
+    void                          setLodLevels( const std::vector<Vector<int,2>>& levels, float pixels = 8.0f, int no_cached = 3 );
+    void                          setLodLevel( int level ) override;
+
+    //****  Background resampling on replot(), the visualizers show the previous samples meanwhile  ****
+    void                          setAsyncReplot( bool async = true );
+    bool                          isAsyncReplot() const;
+    bool                          isAsyncReplotPending() const;
+    bool                          swapAsyncReplot();
+    void                          waitAsyncReplot() const;
+    void                          cancelAsyncReplot() const;
+    virtual PSurf<T,n>*           makeSnapshot() const;
+
     // To set the actual domain. All mappings (both parametric and scaling of derivatives) will then automatical be done.
     void                          setDomainU( T start, T end );
     void                          setDomainUScale( T sc );
@@ -159,7 +196,9 @@ namespace GMlib {
     void                          setDomainVTrans( T tr );
 
     void                          setNoDer( int d );
-    void                          setSurroundingSphere( const DMatrix< DMatrix< Vector<T,n> > >& p ) const;
+    void                          setResampleThreads( int no_threads );
+    int                           getResampleThreads() const;
+    void                          setSurroundingSphere( const DSampleGrid<Vector<T,n>>& p ) const;
     virtual Parametrics<T,2,n>*   split( T t, int uv );
 
     //****  To handle visualizers to the surface  ****
@@ -178,6 +217,7 @@ namespace GMlib {
 
 
   protected:
+    PSurf( const PSurf<T,n>& copy, bool children );
 
     mutable int                   _no_sam_u;    // Number of samples u for single sampling
     mutable int                   _no_sam_v;    // Number of samples v for single sampling
@@ -194,8 +234,8 @@ namespace GMlib {
     mutable int                   _default_d;   // Used by operator() for number of derivative to evaluate.
 
     // Can be used by resample -- index in pre-eval
-    mutable int                   _ind[2];
     mutable bool                  _resample;
+    int                           _no_threads;  // Number of threads used by resample (1 - serial, 0 - one per core)
     mutable int                   _pre_eval_kode;
 
     // Preevaluation/sampling
@@ -233,9 +273,12 @@ namespace GMlib {
 
 
 
-    /*! virtual void PSurf<T,3>::eval( T u, T v, int d1, int d2, bool lu , bool lv ) const = 0
+    /*! virtual void PSurf<T,3>::eval( DMatrix<Vector<T,n>>& p, T u, T v, int d1, int d2, bool lu , bool lv ) const = 0
      *  Surface evaluator, the formula of the surface definition
      *  Requires implementation in PSurf sub-classes.
+     *  The result is only to be written into p, not into any member of the surface,
+     *  so the surface can be evaluated (and resampled) from several threads at the same time.
+     *  \param[out] p   Position and partial derivatives, dimension (d1+1)x(d2+1).
      *  \param[in]  u   Evaluation parameter in u-direction.
      *  \param[in]  v   Evaluation parameter in v-direction.
      *  \param[in]  d1  Number of derivatives to be computed for u.
@@ -243,7 +286,42 @@ namespace GMlib {
      *  \param[in]  lu  (default true) Whether to evaluate from left (or right) at u.
      *  \param[in]  lv  (default true) Whether to evaluate from left (or right) at v.
      */
-    virtual void        eval( T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const = 0;
+    virtual void        eval( DMatrix<Vector<T,n>>& p, T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const = 0;
+
+
+    /*! virtual void PSurf<T,3>::evalSample( DMatrix<Vector<T,n>>& p, int i, int j, T u, T v, int d1, int d2, bool lu, bool lv ) const
+     *  Evaluator used by resample() for the sample (i,j) of the sample grid.
+     *  Default is eval(), surfaces with pre-evaluated basis functions can reimplement it.
+     *  Is called from several threads at the same time if resample is running in parallel.
+     *  \param[out] p   Position and partial derivatives, dimension (d1+1)x(d2+1).
+     *  \param[in]  i   Sample index in u-direction.
+     *  \param[in]  j   Sample index in v-direction.
+     *  \param[in]  u   Evaluation parameter in u-direction.
+     *  \param[in]  v   Evaluation parameter in v-direction.
+     *  \param[in]  d1  Number of derivatives to be computed for u.
+     *  \param[in]  d2  Number of derivatives to be computed for v.
+     *  \param[in]  lu  Whether to evaluate from left (or right) at u.
+     *  \param[in]  lv  Whether to evaluate from left (or right) at v.
+     */
+    virtual void        evalSample( DMatrix<Vector<T,n>>& p, int i, int j, T u, T v, int d1, int d2, bool lu, bool lv ) const;
+
+
+    /*! virtual void PSurf<T,3>::evalBatch( Vector<T,n>* p, const T* u, const T* v, int m, int d1, int d2, bool lu, bool lv ) const
+     *  Batch evaluator, evaluates the surface at m parameter pairs (u[i],v[i]).
+     *  Default is to call eval() for each pair, surfaces can reimplement it
+     *  to evaluate all the parameter pairs in one go.
+     *  The result is packed with one row of m elements for each partial derivative,
+     *  i.e. the (k,l) derivative at (u[i],v[i]) is p[(k*(d2+1)+l)*m+i].
+     *  \param[out] p   Positions and partial derivatives, (d1+1)*(d2+1)*m elements.
+     *  \param[in]  u   The m evaluation parameters in u-direction.
+     *  \param[in]  v   The m evaluation parameters in v-direction.
+     *  \param[in]  m   Number of parameter pairs.
+     *  \param[in]  d1  Number of derivatives to be computed for u.
+     *  \param[in]  d2  Number of derivatives to be computed for v.
+     *  \param[in]  lu  Whether to evaluate from left (or right) at u.
+     *  \param[in]  lv  Whether to evaluate from left (or right) at v.
+     */
+    virtual void        evalBatch( Vector<T,n>* p, const T* u, const T* v, int m, int d1, int d2, bool lu, bool lv ) const;
 
 
     /*! virtual T PSurf<T,3>::getStartPU() const = 0
@@ -283,13 +361,21 @@ namespace GMlib {
     virtual void      preSample( int dir, int m );
     virtual void      preSample( int m1, int m2, int d1, int d2, T s_u = T(0), T s_v = T(0), T e_u = T(0), T e_v = T(0) );
 
-    void              resample(DMatrix<DMatrix <DMatrix <Vector<T,n> > > >	& a, int m1, int m2, int d1, int d2 );
-    virtual void      resample(DMatrix<DMatrix <Vector<T,n> > >& a, int m1, int m2, int d1, int d2,
+    void              resample(DSampleGrid<Vector<T,n>>& a, int m1, int m2, int d1, int d2 );
+    virtual void      resample(DSampleGrid<Vector<T,n>>& a, int m1, int m2, int d1, int d2,
                                                                 T s_u = T(0), T s_v = T(0), T e_u = T(0), T e_v = T(0)) const;
-    virtual void      resampleNormals( const DMatrix<DMatrix<Vector<T,n>>> &sample, DMatrix<Vector<float,3>> &normals ) const;
-    virtual void      computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,n>>>& p, Sphere<T,n>& s ) const;
+    void              resample(DSampleGrid<Vector<T,n>>& a, const std::vector<T>& u, const std::vector<T>& v, int d1, int d2 ) const;
+    void              makeSampleValues( std::vector<T>& u, std::vector<T>& v, int m1, int m2, T s_u, T s_v, T e_u, T e_v ) const;
+    virtual void      resampleNormals( const DSampleGrid<Vector<T,n>> &sample, DMatrix<Vector<float,3>> &normals ) const;
+    virtual void      computeSurroundingSphere( const DSampleGrid<Vector<T,n>>& p, Sphere<T,n>& s ) const;
     void              initSample( int& m1, int& m2, int& d1, int& d2 );
     void              uppdateSurroundingSphere() const;
+    void              clearLodCache() const;
+    void              restartAsyncReplot() const;
+    virtual void      lodSwapped() {}                 // Samples of another level are swapped in without sample()
+    void              invalidateBvh() const;
+
+    void              localUpdateLod( const Camera& cam ) override;
 
     void              prepareVisualizers();
     void              cleanVisualizers(int k=1);
@@ -298,9 +384,44 @@ namespace GMlib {
     T                 _mapV(T v) const;
 
   private:
+    struct LodSet {                                  //!< The samples of a recently used level of detail
+      int                                level;
+      std::vector<Partition>             parts;      //!< Sample data of all partitions, without visualizers
+    };
+
+    std::vector<Vector<int,2>>    _lod_samples; // Number of samples in u and v of each level of detail
+    mutable std::list<LodSet>     _lod_cache;   // Most recently used first
+
+    struct AsyncReplot {                             //!< A background resampling of all partitions
+      std::shared_ptr<Parallel::AsyncJob> job;
+      std::unique_ptr<PSurf<T,n>>         surf;       //!< Evaluation state of the surface (makeSnapshot()), sampled by the job
+      std::vector<Partition>             parts;      //!< Back buffer, written by the job
+      int                                level;      //!< The level of detail sampled, -1 for the current parameter values
+      Vector<int,2>                      m;          //!< Number of samples the back buffer is made for
+      bool                               keep;       //!< The current samples are cached when the level is swapped in
+    };
+
+    bool                                 _async;        // Resample in the background on replot()
+    mutable std::shared_ptr<AsyncReplot> _async_replot; // The latest background resampling
+    mutable std::list<std::shared_ptr<AsyncReplot>> _async_cancelled; // Cancelled, not released before the job has stopped
+
+    mutable Bvh<T>                       _bvh;          // Over the samples of all partitions, in local coordinates
+    mutable bool                         _bvh_dirty;    // The samples have changed since _bvh was updated
+
+    mutable KdTree<T,n>                  _clp_tree;     // Over the samples of all partitions, see getClosestPoints()
+    mutable std::vector<Point<T,2>>      _clp_par;      // Parameters of the points in _clp_tree
+    mutable bool                         _clp_dirty;    // The samples have changed since _clp_tree was made
 
     void              _eval( T u, T v, int d1, int d2 ) const;
+    void              _replot() const;
+    void              _replotAsync() const;
+    bool              _startAsync( int level, bool keep ) const;
+    void              _releaseCancelled( bool wait = false ) const;
+    void              _swapLod( int level, std::vector<Partition>& parts, bool keep );
+    static void       _swapSamples( Partition& a, Partition& b );
     void              _computeEFGefg( T u, T v, T& E, T& F, T& G, T& e, T& f, T& g ) const;
+    void              _getSamples( std::vector<Point<T,n>>& p, std::vector<Point<T,2>>& uv,
+                                   std::vector<Vector<int,2>>* grids = nullptr ) const;
 
   }; // END class PSurf
 
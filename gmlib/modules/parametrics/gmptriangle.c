@@ -38,6 +38,9 @@ namespace GMlib {
     _init();
     setEval(0);
 
+    _bvh_m     = 0;
+    _bvh_dirty = true;
+
     _default_visualizer = nullptr;
   }
 
@@ -55,6 +58,10 @@ namespace GMlib {
 
     _default_d    = copy._default_d;
 
+    _bvh_p        = copy._bvh_p;
+    _bvh_m        = copy._bvh_m;
+    _bvh_dirty    = true;
+
     _default_visualizer = nullptr;
   }
 
@@ -376,12 +383,68 @@ namespace GMlib {
 
     setSurroundingSphere( p );
 
+    // Keep the positions for getBvh()
+    _bvh_m = m;
+    _bvh_p.resize( p.getDim() );
+    for( int k = 0; k < p.getDim(); k++ ) _bvh_p[k] = p[k][0];
+    _bvh_dirty = true;
+
     // Replot Visaulizers
     for( int i = 0; i < this->_ptriangle_visualizers.getSize(); i++ )
       this->_ptriangle_visualizers[i]->replot( p, m);
   }
 
 
+  /*! const Bvh<T>& PTriangle<T,n>::getBvh() const
+   *  A bounding volume hierarchy over the triangles of the samples of the last replot().
+   *  The parameters of the hits are the (u,v) of the triangle, w = 1-u-v.
+   *  The hierarchy is updated the first time it is used after replot(), refitted if the
+   *  number of samples is the same. The update is not thread safe, the queries on the hierarchy are.
+   *
+   *  \return The hierarchy, empty if the triangle is not plotted
+   */
+  template <typename T, int n>
+  const Bvh<T>& PTriangle<T,n>::getBvh() const {
+
+    if( _bvh_dirty ) {
+
+      const int m  = _bvh_m;
+      const T   du = m > 1 ? T(1)/(m-1) : T(0);
+
+      // The parameters as in resample1() and resample2()
+      const int a = _t_nr == 1 ? 1 : ( _t_nr == 2 ? 2 : 3 );
+      const int b = _t_nr == 1 ? 2 : ( _t_nr == 2 ? 3 : 1 );
+      std::vector<Point<T,2> > par;
+      for( int i = 0; i < m; i++ )
+        for( int j = 0; j <= i; j++ ) {
+          if( _all )
+            par.push_back( Point<T,2>( (i-j)*du, j*du ) );
+          else {
+            const T v = j*du;
+            const T u = i*du - v;
+            const T w = 1 - i*du;
+            Point<T,n> pr = u*_pt[0] + v*_pt[a] + w*_pt[b];
+            par.push_back( Point<T,2>( pr[0], pr[1] ) );
+          }
+        }
+
+      // Row i has i+1 samples, and starts at sample _sum(i)
+      std::vector<Vector<int,3> > tri;
+      for( int i = 0; i < m-1; i++ )
+        for( int j = 0; j <= i; j++ ) {
+          const int k = _sum(i) + j;
+          const int l = _sum(i+1) + j;
+          tri.push_back( Vector<int,3>( k, l, l+1 ) );
+          if( j < i ) tri.push_back( Vector<int,3>( k, l+1, k+1 ) );
+        }
+
+      _bvh.update( _bvh_p, tri, par );
+      _bvh_dirty = false;
+    }
+    return _bvh;
+  }
+
+
   template <typename T, int n>
   inline
   void PTriangle<T,n>::setTriangNr(bool all, int nr)
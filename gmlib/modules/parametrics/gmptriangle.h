@@ -31,8 +31,12 @@
 
 // gmlib
 #include <core/types/gmpoint.h>
+#include <core/containers/gmbvh.h>
 #include <core/containers/gmdvector.h>
 
+// stl
+#include <vector>
+
 
 namespace GMlib {
 
@@ -117,6 +121,8 @@ namespace GMlib {
 
     virtual Vector<Point<T,n>,3>      getPoints() const;
 
+    const Bvh<T>&                     getBvh() const;
+
   protected:
     Array< PTriangleVisualizer<T,n>* >  _ptriangle_visualizers;
     PTriangleVisualizer<T,n>            *_default_visualizer;
@@ -146,6 +152,11 @@ namespace GMlib {
 
     void                              _fuForm( T u, T v, T& E, T& F, T& G, T& e, T& f, T& g) const;
 
+    std::vector<Point<T,n> >          _bvh_p;       // Sample positions of the last replot()
+    int                               _bvh_m;       // Number of samples along each edge in the last replot()
+    mutable Bvh<T>                    _bvh;
+    mutable bool                      _bvh_dirty;
+
     void                              resample1( DVector<DVector<Vector<T,n> > > &p, int m, int d );
     void                              resample2( DVector<DVector<Vector<T,n> > > &p, int m, int a, int b );
   }; // END class PTriangle
@@ -68,9 +68,9 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PApple<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PApple<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T cu = cos(u);
     T su = sin(u);
@@ -81,9 +81,9 @@ namespace GMlib {
     T v2 = 3.8 * sv;
 
 
-    this->_p[0][0][0] =	 _r * ( cu * ( 4 + v1 ) );
-    this->_p[0][0][1] =	 _r * ( su * ( 4 + v1 ) );
-    this->_p[0][0][2] =	 _r * ((cv+sv-1)*(1+sv)*log(a) + 7.5*sv);
+    p[0][0][0] =	 _r * ( cu * ( 4 + v1 ) );
+    p[0][0][1] =	 _r * ( su * ( 4 + v1 ) );
+    p[0][0][2] =	 _r * ((cv+sv-1)*(1+sv)*log(a) + 7.5*sv);
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
@@ -96,44 +96,44 @@ namespace GMlib {
       T la = log(a);
 
       if(d1){                   // du
-        this->_p[1][0][0] = -su * (4 + v1);
-        this->_p[1][0][1] =  cu * (4 + v1);
-        this->_p[1][0][2] = T(0);
+        p[1][0][0] = -su * (4 + v1);
+        p[1][0][1] =  cu * (4 + v1);
+        p[1][0][2] = T(0);
       }
       if(d1>1){                 //duu
-        this->_p[2][0][0] = -cu * (4 + v1);
-        this->_p[2][0][1] = -su * (4 + v1);
-        this->_p[2][0][2] =	T(0);
+        p[2][0][0] = -cu * (4 + v1);
+        p[2][0][1] = -su * (4 + v1);
+        p[2][0][2] =	T(0);
       }
       if(d2){                   //dv
-        this->_p[0][1][0] = -cu * v2;
-        this->_p[0][1][1] = -su * v2;
-        this->_p[0][1][2] = -cv*d - sv*la + 0.5*(2*c2v*la - s2v*d + d + 2*s2v*la + c2v*d) + 7.5*cv;
+        p[0][1][0] = -cu * v2;
+        p[0][1][1] = -su * v2;
+        p[0][1][2] = -cv*d - sv*la + 0.5*(2*c2v*la - s2v*d + d + 2*s2v*la + c2v*d) + 7.5*cv;
       }
       if(d2>1){                 //dvv
-        this->_p[0][2][0] = -cu * v1;
-        this->_p[0][2][1] = -su * v1;
-        this->_p[0][2][2] = 2*sv*d - cv*e - cv*la - 2*c2v*d + 0.5*e*(1+c2v-s2v) + 2*la*(c2v-s2v) - 2*s2v*d - 7.5*sv;
+        p[0][2][0] = -cu * v1;
+        p[0][2][1] = -su * v1;
+        p[0][2][2] = 2*sv*d - cv*e - cv*la - 2*c2v*d + 0.5*e*(1+c2v-s2v) + 2*la*(c2v-s2v) - 2*s2v*d - 7.5*sv;
       }
       if(d1 && d2){             //duv/dvu
-        this->_p[1][1][0] =  su * v2;
-        this->_p[1][1][1] = -cu * v2;
-        this->_p[1][1][2] = T(0);
+        p[1][1][0] =  su * v2;
+        p[1][1][1] = -cu * v2;
+        p[1][1][2] = T(0);
       }
       if(d1 && d2>1){           //duvv
-        this->_p[1][2][0] =  su * v1;
-        this->_p[1][2][1] = -cu * v1;
-        this->_p[1][2][2] = T(0);
+        p[1][2][0] =  su * v1;
+        p[1][2][1] = -cu * v1;
+        p[1][2][2] = T(0);
       }
       if(d1>1 && d2){           //duuv
-        this->_p[2][1][0] = cu * v2;
-        this->_p[2][1][1] = su * v2;
-        this->_p[2][1][2] = T(0);
+        p[2][1][0] = cu * v2;
+        p[2][1][1] = su * v2;
+        p[2][1][2] = T(0);
       }
       if(d1>1 && d2>1){         //duuvv
-        this->_p[2][2][0] = cu * v1;
-        this->_p[2][2][1] = su * v1;
-        this->_p[2][2][2] = T(0);
+        p[2][2][0] = cu * v1;
+        p[2][2][1] = su * v1;
+        p[2][2][2] = T(0);
       }
     }
   }
@@ -164,7 +164,7 @@ namespace GMlib {
 
 
   template <typename T>
-  void PApple<T>::computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,3>>>& /*p*/, Sphere<T,3>& s ) const {
+  void PApple<T>::computeSurroundingSphere( const DSampleGrid<Vector<T,3>>& /*p*/, Sphere<T,3>& s ) const {
 
       s.resetPos(Point<T,3>(T(0), T(0), -0.1*_r));
       s.resetRadius(8.8*_r);
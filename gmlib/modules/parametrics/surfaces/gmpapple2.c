@@ -70,18 +70,18 @@ template <typename T>
   //*****************************************************
 
   template <typename T>
-  void PApple2<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PApple2<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T cu = cos(u);
     T su = sin(u);
     T cv = cos(v);
     T sv = sin(v);
 
-    this->_p[0][0][0] =	 2*_r*cu*(1+cv)*sv;
-    this->_p[0][0][1] =	 2*_r*su*(1+cv)*sv;
-    this->_p[0][0][2] =	-2*_r*cv*(1+cv);
+    p[0][0][0] =	 2*_r*cu*(1+cv)*sv;
+    p[0][0][1] =	 2*_r*su*(1+cv)*sv;
+    p[0][0][2] =	-2*_r*cv*(1+cv);
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
@@ -93,45 +93,45 @@ template <typename T>
       }
 
       if(d1) {                          //u
-        this->_p[1][0][0] = -2*_r*su*(1+cv)*sv;
-        this->_p[1][0][1] =  2*_r*cu*(1+cv)*sv;
-        this->_p[1][0][2] =  T(0);
+        p[1][0][0] = -2*_r*su*(1+cv)*sv;
+        p[1][0][1] =  2*_r*cu*(1+cv)*sv;
+        p[1][0][2] =  T(0);
       }
       if(d1>1) {                        //uu
-        this->_p[2][0][0] =	-2*_r*cu*(1+cv)*sv;
-        this->_p[2][0][1] =	-2*_r*su*(1+cv)*sv;
-        this->_p[2][0][2] =	 T(0);
+        p[2][0][0] =	-2*_r*cu*(1+cv)*sv;
+        p[2][0][1] =	-2*_r*su*(1+cv)*sv;
+        p[2][0][2] =	 T(0);
       }
       if(d2) {                          //v
-        this->_p[0][1][0] =	 2*_r*cu*(2*cv-1)*(cv+1);
-        this->_p[0][1][1] =	 2*_r*su*(2*cv-1)*(cv+1);
-        this->_p[0][1][2] =	 2*_r*sv*(1+2*cv);
+        p[0][1][0] =	 2*_r*cu*(2*cv-1)*(cv+1);
+        p[0][1][1] =	 2*_r*su*(2*cv-1)*(cv+1);
+        p[0][1][2] =	 2*_r*sv*(1+2*cv);
       }
       if(d2>1) {                        //vv
-        this->_p[0][2][0] =	-2*_r*cu*sv*(1+4*cv);
-        this->_p[0][2][1] =	-2*_r*su*sv*(1+4*cv);
-        this->_p[0][2][2] =	 2*_r*(cv+2*(cv*cv-sv*sv));
+        p[0][2][0] =	-2*_r*cu*sv*(1+4*cv);
+        p[0][2][1] =	-2*_r*su*sv*(1+4*cv);
+        p[0][2][2] =	 2*_r*(cv+2*(cv*cv-sv*sv));
       }
       if(d1 && d2) {                    //uv
-        this->_p[1][1][0] =	-2*_r*su*(2*cv*(cv+1)-1);
-        this->_p[1][1][1] =	 2*_r*cu*(2*cv*(cv+1)-1);
-        this->_p[1][1][2] =	 T(0);
+        p[1][1][0] =	-2*_r*su*(2*cv*(cv+1)-1);
+        p[1][1][1] =	 2*_r*cu*(2*cv*(cv+1)-1);
+        p[1][1][2] =	 T(0);
       }
       if(d1>1 && d2) {                  //uuv
-        this->_p[2][1][0] =	-2*_r*cu*(2*cv*(cv+1)-1);
-        this->_p[2][1][1] =	-2*_r*su*(2*cv*(cv+1)-1);
-        this->_p[2][1][2] =	 T(0);
+        p[2][1][0] =	-2*_r*cu*(2*cv*(cv+1)-1);
+        p[2][1][1] =	-2*_r*su*(2*cv*(cv+1)-1);
+        p[2][1][2] =	 T(0);
       }
       if(d1 && d2>1) {                  //uvv
-        this->_p[1][2][0] =	 2*_r*su*sv*(4*cv+2);
-        this->_p[1][2][1] =	-2*_r*cu*sv*(4*cv+2);
-        this->_p[1][2][2] =	 T(0);
+        p[1][2][0] =	 2*_r*su*sv*(4*cv+2);
+        p[1][2][1] =	-2*_r*cu*sv*(4*cv+2);
+        p[1][2][2] =	 T(0);
       }
       if(d1>1 && d2>1) {                //uuvv
 
-        this->_p[2][2][0] =	 2*_r*cu*sv*(4*cv+2);
-        this->_p[2][2][1] =	 2*_r*su*sv*(4*cv+2);
-        this->_p[2][2][2] =	 T(0);
+        p[2][2][0] =	 2*_r*cu*sv*(4*cv+2);
+        p[2][2][1] =	 2*_r*su*sv*(4*cv+2);
+        p[2][2][2] =	 T(0);
       }
     }
   }
@@ -164,7 +164,7 @@ template <typename T>
 
 
   template <typename T>
-  void PApple2<T>::computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,3>>>& /*p*/, Sphere<T,3>& s ) const {
+  void PApple2<T>::computeSurroundingSphere( const DSampleGrid<Vector<T,3>>& /*p*/, Sphere<T,3>& s ) const {
 
       s.resetPos(Point<T,3>(T(0), T(0), -1.68*_r));
       s.resetRadius(2.635*_r);
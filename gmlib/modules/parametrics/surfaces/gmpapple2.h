@@ -49,13 +49,13 @@ namespace GMlib {
 
   protected:
     // Virtual function from PSurf that has to be implemented locally
-    void             eval(T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const override;
+    void             eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const override;
     T                getStartPU() const override;
     T                getEndPU()   const override;
     T                getStartPV() const override;
     T                getEndPV()   const override;
 
-    void            computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,3>>>& p, Sphere<T,3>& s ) const override;
+    void            computeSurroundingSphere( const DSampleGrid<Vector<T,3>>& p, Sphere<T,3>& s ) const override;
 
     // Help function to ensure consistent initialization
     virtual void     init();
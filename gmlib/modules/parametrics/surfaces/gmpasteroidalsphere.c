@@ -78,9 +78,9 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PAsteroidalSphere<T>::eval( T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PAsteroidalSphere<T>::eval( DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T cu = cos(u);
     T cv = cos(v);
@@ -88,51 +88,51 @@ namespace GMlib {
     T sv = sin(v);
 
 
-    this->_p[0][0][0] =	T(pow(_a * cu*cv, T(3)));
-    this->_p[0][0][1] =	T(pow(_b * su*cv, T(3)));
-    this->_p[0][0][2] =	T(pow(_c * sv, T(3)));
+    p[0][0][0] =	T(pow(_a * cu*cv, T(3)));
+    p[0][0][1] =	T(pow(_b * su*cv, T(3)));
+    p[0][0][2] =	T(pow(_c * sv, T(3)));
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                      //u
-        this->_p[1][0][0] =	-T(3)*_a*_a*_a*cu*cu*cv*cv*cv*su;
-        this->_p[1][0][1] =	-T(3)*_b*_b*_b*(-1.0+cu*cu)*cv*cv*cv*cu;
-        this->_p[1][0][2] =	T(0);
+        p[1][0][0] =	-T(3)*_a*_a*_a*cu*cu*cv*cv*cv*su;
+        p[1][0][1] =	-T(3)*_b*_b*_b*(-1.0+cu*cu)*cv*cv*cv*cu;
+        p[1][0][2] =	T(0);
       }
       if(d1>1) {                    //uu
-        this->_p[2][0][0] = -T(3)*_a*_a*_a*cu*cv*cv*cv*(T(3)*cu*cu - T(2));
-        this->_p[2][0][1] =	 T(3)*_b*_b*_b*su*cv*cv*cv*(T(3)*cu*cu - T(1));
-        this->_p[2][0][2] =	 T(0);
+        p[2][0][0] = -T(3)*_a*_a*_a*cu*cv*cv*cv*(T(3)*cu*cu - T(2));
+        p[2][0][1] =	 T(3)*_b*_b*_b*su*cv*cv*cv*(T(3)*cu*cu - T(1));
+        p[2][0][2] =	 T(0);
       }
       if(d2) {                      //v
-        this->_p[0][1][0] =	-T(3)*_a*_a*_a*cu*cu*cu*cv*cv*sv;
-        this->_p[0][1][1] =	-T(3)*_b*_b*_b*cu*cu*su*cv*cv*sv;
-        this->_p[0][1][2] =	 T(3)*_c*_c*_c*cv*cv*cv;
+        p[0][1][0] =	-T(3)*_a*_a*_a*cu*cu*cu*cv*cv*sv;
+        p[0][1][1] =	-T(3)*_b*_b*_b*cu*cu*su*cv*cv*sv;
+        p[0][1][2] =	 T(3)*_c*_c*_c*cv*cv*cv;
       }
       if(d2>1) {                    //vv
-        this->_p[0][2][0] =	-T(3)*_a*_a*_a*cu*cu*cu*cv*(T(3)*cv*cv - T(2));
-        this->_p[0][2][1] =	 T(3)*_b*_b*_b*(cu*cu - T(1))*su*cv*(T(3)*cv*cv - T(2));
-        this->_p[0][2][2] =	 T(3)*_c*_c*_c*sv*(T(3)*cv*cv - T(1));
+        p[0][2][0] =	-T(3)*_a*_a*_a*cu*cu*cu*cv*(T(3)*cv*cv - T(2));
+        p[0][2][1] =	 T(3)*_b*_b*_b*(cu*cu - T(1))*su*cv*(T(3)*cv*cv - T(2));
+        p[0][2][2] =	 T(3)*_c*_c*_c*sv*(T(3)*cv*cv - T(1));
       }
       if(d1 && d2) {                //uv
-        this->_p[1][1][0] = T(9)*_a*_a*_a*cu*cu*cv*cv*su*sv;
-        this->_p[1][1][1] =	T(9)*_b*_b*_b*(cu*cu - T(1))*cv*cv*cu*sv;
-        this->_p[1][1][2] =	T(0);
+        p[1][1][0] = T(9)*_a*_a*_a*cu*cu*cv*cv*su*sv;
+        p[1][1][1] =	T(9)*_b*_b*_b*(cu*cu - T(1))*cv*cv*cu*sv;
+        p[1][1][2] =	T(0);
       }
       if(d1>1 && d2) {              //uuv
-        this->_p[2][1][0] =	 T(9)*_a*_a*_a*cu*cv*cv*sv*(T(3)*cu*cu - T(2));
-        this->_p[2][1][1] =	-T(9)*_b*_b*_b*su*cv*cv*sv*(T(3)*cu*cu - T(1));
-        this->_p[2][1][2] =	T(0);
+        p[2][1][0] =	 T(9)*_a*_a*_a*cu*cv*cv*sv*(T(3)*cu*cu - T(2));
+        p[2][1][1] =	-T(9)*_b*_b*_b*su*cv*cv*sv*(T(3)*cu*cu - T(1));
+        p[2][1][2] =	T(0);
       }
       if(d1 && d2>1) {              //uvv
-        this->_p[1][2][0] =	T(9)*_a*_a*_a*cu*cu*cv*su*(T(3)*cv*cv - T(2));
-        this->_p[1][2][1] =	T(9)*_b*_b*_b*(cu*cu - T(1))*cv*cu*(T(3)*cv*cv - T(2));
-        this->_p[1][2][2] =	T(0);
+        p[1][2][0] =	T(9)*_a*_a*_a*cu*cu*cv*su*(T(3)*cv*cv - T(2));
+        p[1][2][1] =	T(9)*_b*_b*_b*(cu*cu - T(1))*cv*cu*(T(3)*cv*cv - T(2));
+        p[1][2][2] =	T(0);
       }
       if(d1>1 && d2>1) {            //uuvv
-        this->_p[2][2][0] =	 T(9)*_a*_a*_a*cu*cv*(T(4) - T(6)*cv*cv - T(6)*cu*cu + T(9)*cu*cu*cv*cv);
-        this->_p[2][2][1] =	-T(9)*_b*_b*_b*su*cv*(T(9)*cu*cu*cv*cv - T(6)*cu*cu + T(2) - T(3)*cv*cv);
-        this->_p[2][2][2] =	 T(0);
+        p[2][2][0] =	 T(9)*_a*_a*_a*cu*cv*(T(4) - T(6)*cv*cv - T(6)*cu*cu + T(9)*cu*cu*cv*cv);
+        p[2][2][1] =	-T(9)*_b*_b*_b*su*cv*(T(9)*cu*cu*cv*cv - T(6)*cu*cu + T(2) - T(3)*cv*cv);
+        p[2][2][2] =	 T(0);
       }
     }
   }
@@ -165,7 +165,7 @@ namespace GMlib {
 
 
   template <typename T>
-  void PAsteroidalSphere<T>::computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,3>>>& /*p*/, Sphere<T,3>& s ) const {
+  void PAsteroidalSphere<T>::computeSurroundingSphere( const DSampleGrid<Vector<T,3>>& /*p*/, Sphere<T,3>& s ) const {
 
       s.resetPos(Point<T,3>(T(0), T(0), 0));
       s.resetRadius(std::max(std::pow(_a,3),std::max(std::pow(_b,3),std::pow(_c,3))));
@@ -67,9 +67,9 @@ template <typename T>
   //*****************************************************
 
   template <typename T>
-  void PBentHorns<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PBentHorns<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T cu	 = cos(u);
     T cv	 = cos(v);
@@ -83,87 +83,87 @@ template <typename T>
     T v3s	 = (v-3*sv)/3;
     T v3c	 = (3*cv-1)/3;
 
-    this->_p[0][0][0] = (2+cu)*v3s;
-    this->_p[0][0][1] = (2+cu2pm3)*cv1;
-    this->_p[0][0][2] = (2+cu2pp3)*cv1;
+    p[0][0][0] = (2+cu)*v3s;
+    p[0][0][1] = (2+cu2pm3)*cv1;
+    p[0][0][2] = (2+cu2pp3)*cv1;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {				//Su
-        this->_p[1][0][0] = -su*v3s;
-        this->_p[1][0][1] = -su2pm3*cv1;
-        this->_p[1][0][2] = -su2pp3*cv1;
+        p[1][0][0] = -su*v3s;
+        p[1][0][1] = -su2pm3*cv1;
+        p[1][0][2] = -su2pp3*cv1;
       }
       if(d1>1) {			//Suu
-        this->_p[2][0][0] = -cu*v3s;
-        this->_p[2][0][1] = -cu2pm3*cv1;
-        this->_p[2][0][2] = -cu2pp3*cv1;
+        p[2][0][0] = -cu*v3s;
+        p[2][0][1] = -cu2pm3*cv1;
+        p[2][0][2] = -cu2pp3*cv1;
       }
       if(d2) {				//Sv
-        this->_p[0][1][0] = -(2+cu)*v3c;
-        this->_p[0][1][1] = -(2+cu2pm3)*sv;
-        this->_p[0][1][2] = -(2+cu2pp3)*sv;
+        p[0][1][0] = -(2+cu)*v3c;
+        p[0][1][1] = -(2+cu2pm3)*sv;
+        p[0][1][2] = -(2+cu2pp3)*sv;
       }
       if(d2>1) {			//Svv
-        this->_p[0][2][0] =	(2+cu)*sv;
-        this->_p[0][2][1] = -(2+cu2pm3)*cv;
-        this->_p[0][2][2] = -(2+cu2pp3)*cv;
+        p[0][2][0] =	(2+cu)*sv;
+        p[0][2][1] = -(2+cu2pm3)*cv;
+        p[0][2][2] = -(2+cu2pp3)*cv;
       }
       if(d1 && d2) {		//Suv
-        this->_p[1][1][0] =	su*v3c;
-        this->_p[1][1][1] =	su2pm3*sv;
-        this->_p[1][1][2] =	su2pp3*sv;
+        p[1][1][0] =	su*v3c;
+        p[1][1][1] =	su2pm3*sv;
+        p[1][1][2] =	su2pp3*sv;
       }
       if(d1>1 && d2) {		//Suuv
-        this->_p[2][1][0] =	cu*v3c;
-        this->_p[2][1][1] =	cu2pm3*sv;
-        this->_p[2][1][2] =	cu2pp3*sv;
+        p[2][1][0] =	cu*v3c;
+        p[2][1][1] =	cu2pm3*sv;
+        p[2][1][2] =	cu2pp3*sv;
       }
       if(d1 && d2>1) {		//Suvv
-        this->_p[1][2][0] = -su*sv;
-        this->_p[1][2][1] =	su2pm3*cv;
-        this->_p[1][2][2] =	su2pp3*cv;
+        p[1][2][0] = -su*sv;
+        p[1][2][1] =	su2pm3*cv;
+        p[1][2][2] =	su2pp3*cv;
       }
       if(d1>1 && d2>1) {	//Suuvv
-        this->_p[2][2][0] = -cu*sv;
-        this->_p[2][2][1] =	cu2pm3*cv;
-        this->_p[2][2][2] =	cu2pp3*cv;
+        p[2][2][0] = -cu*sv;
+        p[2][2][1] =	cu2pm3*cv;
+        p[2][2][2] =	cu2pp3*cv;
       }
       if(d1>2 && d2) {		//Suuuv
-        this->_p[3][1][0] = -su*v3c;
-        this->_p[3][1][1] = -su2pm3*sv;
-        this->_p[3][1][2] = -su2pp3*sv;
+        p[3][1][0] = -su*v3c;
+        p[3][1][1] = -su2pm3*sv;
+        p[3][1][2] = -su2pp3*sv;
       }
       if(d1>2 && d2>1) {	//Suuuvv
-        this->_p[3][2][0] =  su*sv;
-        this->_p[3][2][1] = -su2pm3*cv;
-        this->_p[3][2][2] = -su2pp3*cv;
+        p[3][2][0] =  su*sv;
+        p[3][2][1] = -su2pm3*cv;
+        p[3][2][2] = -su2pp3*cv;
       }
       if(d1>2 && d2>2) {	//Suuuvvv
-        this->_p[3][3][0] =  su*cv;
-        this->_p[3][3][1] =  su2pm3*sv;
-        this->_p[3][3][2] =  su2pp3*sv;
+        p[3][3][0] =  su*cv;
+        p[3][3][1] =  su2pm3*sv;
+        p[3][3][2] =  su2pp3*sv;
       }
       if(d1 && d2>2) {		//Suvvv
-        this->_p[1][3][0] = -su*cv;
-        this->_p[1][3][1] = -su2pm3*sv;
-        this->_p[1][3][2] = -su2pp3*sv;
+        p[1][3][0] = -su*cv;
+        p[1][3][1] = -su2pm3*sv;
+        p[1][3][2] = -su2pp3*sv;
       }
       if(d1>1 && d2>2) {	//Suuvvv
-        this->_p[2][3][0] = -cu*cv;
-        this->_p[2][3][1] = -cu2pm3*sv;
-        this->_p[2][3][2] = -cu2pp3*sv;
+        p[2][3][0] = -cu*cv;
+        p[2][3][1] = -cu2pm3*sv;
+        p[2][3][2] = -cu2pp3*sv;
       }
       if(d1>2) {			//Suuu
-        this->_p[3][0][0] =  su*v3s;
-        this->_p[3][0][1] =  su2pm3*cv1;
-        this->_p[3][0][2] =  su2pp3*cv1;
+        p[3][0][0] =  su*v3s;
+        p[3][0][1] =  su2pm3*cv1;
+        p[3][0][2] =  su2pp3*cv1;
       }
       if(d2>2) {			//Svvv
-        this->_p[0][3][0] =	(2+cu)*cv;
-        this->_p[0][3][1] = (2+cu2pm3)*sv;
-        this->_p[0][3][2] = (2+cu2pp3)*sv;
+        p[0][3][0] =	(2+cu)*cv;
+        p[0][3][1] = (2+cu2pm3)*sv;
+        p[0][3][2] = (2+cu2pp3)*sv;
       }
     }
   }
@@ -195,7 +195,7 @@ template <typename T>
 
 
   template <typename T>
-  void PBentHorns<T>::computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,3>>>& /*p*/, Sphere<T,3>& s ) const {
+  void PBentHorns<T>::computeSurroundingSphere( const DSampleGrid<Vector<T,3>>& /*p*/, Sphere<T,3>& s ) const {
 
       s.resetPos(Point<T,3>(0, -2.5, -2));
       s.resetRadius(8.3);
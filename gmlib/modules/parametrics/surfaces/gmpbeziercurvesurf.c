@@ -122,7 +122,7 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PBezierCurveSurf<T>::eval(T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PBezierCurveSurf<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
 
       if(_swap_par) {
           std::swap(u,v);
@@ -132,19 +132,18 @@ namespace GMlib {
       DMatrix<Vector<T,3> > c(_cu.getSize(), d2+1);
 
       for(int i=0; i < _cu.getSize(); i++)
-          c[i] = _cu(i)->evaluateParent(v, d2);
+          _cu(i)->evaluateParent(c[i], v, d2);
 
       // Compute the Bernstein-Hermite Polynomials
       DMatrix< T > bhp;
       EvaluatorStatic<T>::evaluateBhp( bhp, _cu.getSize()-1, u, 1);
 
-      DMatrix< Vector<T,3> >    p = bhp * c;
+      p = bhp * c;
       p.resetDim(d1+1,d2+1);
 
-      if(_swap_par) this->_p = p.transpose();
-      else          this->_p = p;
+      if(_swap_par) p.transpose();
 
-      this->_p.resetDim(d1+1,d2+1);
+      p.resetDim(d1+1,d2+1);
   }
 
 
@@ -26,6 +26,7 @@
 
 // gmlib
 #include <core/containers/gmdmatrix.h>
+#include <core/utils/gmparallel.h>
 #include <scene/selector/gmselector.h>
 #include <scene/visualizers/gmselectorgridvisualizer.h>
 
@@ -229,6 +230,9 @@ namespace GMlib {
   template <typename T>
   void PBezierSurf<T>::replot() const {
 
+      this->clearLodCache();
+      this->restartAsyncReplot();
+      this->invalidateBvh();
       updateSamples();
       this->resampleNormals( this->_visu[0][0].sample_val, this->_visu[0][0].normals );
       this->setSurroundingSphere( this->_visu[0][0].sample_val );
@@ -324,20 +328,21 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PBezierSurf<T>::eval( T u, T v, int du, int dv, bool /*lu*/, bool /*lv*/ ) const {
+  void PBezierSurf<T>::eval( DMatrix<Vector<T,3>>& p, T u, T v, int du, int dv, bool /*lu*/, bool /*lv*/ ) const {
 if(u<0 || u>1)
     std::cout << "(u,v) = (" << u << ", " << v << ")" << " U-domene= (" << this->getParStartU() << ", " << this->getParEndU() << ")"<< std::endl;
 if(v<0 || v>1)
     std::cout << "(u,v) = (" << u << ", " << v << ")" << " V-domene= (" << this->getParStartV() << ", " << this->getParEndV() << ")"<< std::endl;
 
       // Set Dimensions
-      this->_p.setDim( du+1, dv+1 );
+      p.setDim( du+1, dv+1 );
 
-      DMatrix<T> bu, bv;
+      // The Bernstein-Hermite matrices are kept per thread, so high degrees do not allocate memory
+      static thread_local DMatrix<T> bu, bv;
       EvaluatorStatic<T>::evaluateBhp( bu, this->getDegreeU(), u, _su );
       EvaluatorStatic<T>::evaluateBhp( bv, this->getDegreeV(), v, _sv );
 
-      multEval( bu, bv, du, dv);
+      multEval( p, bu, bv, du, dv);
   }
 
 
@@ -403,16 +408,14 @@ if(v<0 || v>1)
                   es.dp += _pos_change[i].dp;
                   _pos_change.erase(_pos_change.begin()+i);
               }
-          for(uint i=0; i<_pre_u.size(); i++)
-            for(uint j=0; j<_pre_v.size(); j++)
-              comp(this->_visu[0][0].sample_val[i][j], _pre_u[i], _pre_v[j], es.dp, es.ind);
+          comp(this->_visu[0][0].sample_val, es.dp, es.ind);
           _pos_change.pop_back();
 //          if(_local_pre_eval) {
 //              resample( this->_visu[1].sample_val, this->_visu[1].sur_sphere , this->_visu[1], this->_visu[1].sample_val[0].getDim()-1);
 //              this->setEditDone();
 //          }
       }
-      setSurroundingSphere(this->_visu[0][0].sample_val);
+      this->setSurroundingSphere(this->_visu[0][0].sample_val);
   }
 
 
@@ -422,17 +425,18 @@ if(v<0 || v>1)
   //******************************************
 
   template <typename T>
-  void PBezierSurf<T>::resample( DMatrix< DMatrix < Vector<T,3> > >& p,
+  void PBezierSurf<T>::resample( DSampleGrid<Vector<T,3>>& p,
                                  int m1, int m2, int d1, int d2, T s_u, T s_v, T e_u, T e_v ) const{
-      // Set Dimensions
-      this->_p.setDim(d1+1,d2+1);
-      p.setDim(m1, m2);
-
-      for(int i=0; i<m1; i++)
-          for(int j=0; j<m2; j++) {
-              multEval( _pre_u[i], _pre_v[j], d1, d2);
-              p[i][j] = this->_p;
-          }
+      p.setDim(m1, m2, d1, d2);
+
+      Parallel::forBlocks( 0, m1, [&]( int b, int e ) {
+          DMatrix<Vector<T,3>> q(d1+1,d2+1);
+          for(int i=b; i<e; i++)
+              for(int j=0; j<m2; j++) {
+                  multEval( q, _pre_u[i], _pre_v[j], d1, d2);
+                  p.setSample( q, i, j );
+              }
+      }, this->_no_threads );
   }
 
 
@@ -469,12 +473,13 @@ if(v<0 || v>1)
 
   template <typename T>
   inline
-  void PBezierSurf<T>::multEval(const DMatrix<T>& bu, const DMatrix<T>& bv, int du, int dv) const {
+  void PBezierSurf<T>::multEval(DMatrix<Vector<T,3>>& p, const DMatrix<T>& bu, const DMatrix<T>& bv, int du, int dv) const {
 
       int ku = this->getDegreeU()+1;
       int kv = this->getDegreeV()+1;
 
-      DMatrix<Vector<T,3>> c(ku, dv+1);
+      static thread_local DMatrix<Vector<T,3>> c;
+      c.setDim(ku, dv+1);
 
       // We do these two operations manually here!
       //    bv.transpose();
@@ -487,38 +492,40 @@ if(v<0 || v>1)
               for(int k=1; k<kv; k++)
                   c[i][j] += _c(i)(k)*bv(j)(k);
           }
-      //    _p = bu * c
-      for(int i=0; i<=dv; i++)
-          for(int j=0; j<=du; j++) {
-              this->_p[i][j] = bu(i)(0)*c[0][j];
+      //    p = bu * c
+      for(int i=0; i<=du; i++)
+          for(int j=0; j<=dv; j++) {
+              p[i][j] = bu(i)(0)*c[0][j];
               for(int k=1; k<ku; k++)
-                  this->_p[i][j] += bu(i)(k)*c[k][j];
+                  p[i][j] += bu(i)(k)*c[k][j];
           }
   }
 
 
 
 
-  /*! void PBezierSurf<T>::comp(DVector<Vector<T,3>>& p, const DMatrix<T>& B, const Vector<T,3>& c, int k) const
+  /*! void PBezierSurf<T>::comp(DSampleGrid<Vector<T,3>>& p, const Vector<T,3>& c, Point<int,2> k) const
    *  Protected,
-   *  Partial vector-matrix computation, ie. actually a vector-vector innerproduct.
-   *  where vi compute a vector vith a column vector with index k in the matrix B,
-   *  i.e. p = v * B_column[k]
+   *  Updating all samples when one control point has been moved,
+   *  i.e. p += Bu_column[ku] * Bv_column[kv] * c, plane by plane.
    *
-   *  \param[out]  p  Updating the position and d derivatives
-   *  \param[in]   Bu The Bernstein-Hermite matrix in u - direction.
-   *  \param[in]   Bv The Bernstein-Hermite matrix in v - direction.
+   *  \param[out]  p  Updating the positions and derivatives
    *  \param[in]   c  The distance vector, one control point has been moved
-   *  \param[in]   ku the u-index of the column to compute with, also the index of the control point that has been moved
-   *  \param[in]   ku the v-index of the column to compute with, also the index of the control point that has been moved
+   *  \param[in]   k  The (u,v)-index of the control point that has been moved
    */
   template <typename T>
   inline
-  void  PBezierSurf<T>::comp(DMatrix<Vector<T,3>>& p, const DMatrix<T>& Bu, const DMatrix<T>& Bv, const Vector<T,3>& c, Point<int,2> k) const {
-
-      for(int i=0; i<p.getDim1(); i++)
-        for(int j=0; j<p.getDim2(); j++)
-          p[i][j] += (Bu(i)(k[0])*Bv(j)(k[1]))*c;
+  void  PBezierSurf<T>::comp(DSampleGrid<Vector<T,3>>& p, const Vector<T,3>& c, Point<int,2> k) const {
+
+      const int m1 = std::min<int>( p.getDim1(), _pre_u.size() );
+      const int m2 = std::min<int>( p.getDim2(), _pre_v.size() );
+      for(int a=0; a<p.getDerDim1(); a++)
+        for(int b=0; b<p.getDerDim2(); b++) {
+          Vector<T,3>* q = p.getPlane(a,b);
+          for(int i=0; i<m1; i++)
+            for(int j=0; j<m2; j++)
+              q[i*p.getDim2()+j] += (_pre_u[i](a)(k[0])*_pre_v[j](b)(k[1]))*c;
+        }
   }
 
 
@@ -120,7 +120,7 @@ namespace GMlib {
 
 
       // Virtual function from PSurf that has to be implemented locally
-      void                       eval( T u, T v, int d1 = 0, int d2 = 0, bool lu = false, bool lv = false ) const override;
+      void                       eval( DMatrix<Vector<T,3>>& p, T u, T v, int d1 = 0, int d2 = 0, bool lu = false, bool lv = false ) const override;
       T                          getStartPU() const override;
       T                          getEndPU()   const override;
       T                          getStartPV() const override;
@@ -130,17 +130,17 @@ namespace GMlib {
       virtual void               init();
       void                       updateSamples() const;
 
-  private:
-
       // Virtual function from PSurf
-      void                       resample(DMatrix<DMatrix <Vector<T,3> > >& a, int m1, int m2, int d1, int d2, T s_u = T(0), T s_v = T(0), T e_u = T(0), T e_v = T(0)) const override;
+      void                       resample(DSampleGrid<Vector<T,3>>& a, int m1, int m2, int d1, int d2, T s_u = T(0), T s_v = T(0), T e_u = T(0), T e_v = T(0)) const override;
       void                       preSample( int dir, int m ) override;
 
+  private:
+
       // Help functions
       void                       internalPreSample( std::vector< DMatrix< T > >& p, int m, int d, T scale, T start, T end );
-      void                       multEval(const DMatrix<T>& bu, const DMatrix<T>& bv, int du, int dv) const;
+      void                       multEval(DMatrix<Vector<T,3>>& p, const DMatrix<T>& bu, const DMatrix<T>& bv, int du, int dv) const;
 
-      void                       comp(DMatrix<Vector<T,3>>& p, const DMatrix<T>& Bu, const DMatrix<T>& Bv, const Vector<T,3>& c, Point<int,2> k) const;
+      void                       comp(DSampleGrid<Vector<T,3>>& p, const Vector<T,3>& c, Point<int,2> k) const;
       Point<int,2>               mapIndex(int i);
 
 
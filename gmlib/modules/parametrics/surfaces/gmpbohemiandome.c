@@ -78,61 +78,61 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PBohemianDome<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PBohemianDome<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T cu  = cos(u);
     T cv  = cos(v);
     T su  = sin(u);
     T sv  = sin(v);
 
-    this->_p[0][0][0] =	_r*cu;
-    this->_p[0][0][1] =	_r*su+_w*cv;
-    this->_p[0][0][2] =	_h*sv;
+    p[0][0][0] =	_r*cu;
+    p[0][0][1] =	_r*su+_w*cv;
+    p[0][0][2] =	_h*sv;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {              //u
-        this->_p[1][0][0] =	-_r*su;
-        this->_p[1][0][1] =	_r*cu;
-        this->_p[1][0][2] =	T(0);
+        p[1][0][0] =	-_r*su;
+        p[1][0][1] =	_r*cu;
+        p[1][0][2] =	T(0);
       }
       if(d1>1) {            //uu
-        this->_p[2][0][0] =	-_r*cu;
-        this->_p[2][0][1] =	-_r*su;
-        this->_p[2][0][2] =	T(0);
+        p[2][0][0] =	-_r*cu;
+        p[2][0][1] =	-_r*su;
+        p[2][0][2] =	T(0);
       }
       if(d2) {              //v
-        this->_p[0][1][0] =	T(0);
-        this->_p[0][1][1] =	-_w*sv;
-        this->_p[0][1][2] =	 _h*cv;
+        p[0][1][0] =	T(0);
+        p[0][1][1] =	-_w*sv;
+        p[0][1][2] =	 _h*cv;
       }
       if(d2>1) {            //vv
-        this->_p[0][2][0] =	T(0);
-        this->_p[0][2][1] =	-_w*cv;
-        this->_p[0][2][2] =	-_h*sv;
+        p[0][2][0] =	T(0);
+        p[0][2][1] =	-_w*cv;
+        p[0][2][2] =	-_h*sv;
       }
       if(d1 && d2) {        //uv
-        this->_p[1][1][0] =	T(0);
-        this->_p[1][1][1] =	T(0);
-        this->_p[1][1][2] =	T(0);
+        p[1][1][0] =	T(0);
+        p[1][1][1] =	T(0);
+        p[1][1][2] =	T(0);
       }
       if(d1>1 && d2) {      //uuv
-        this->_p[2][1][0] =	T(0);
-        this->_p[2][1][1] =	T(0);
-        this->_p[2][1][2] =	T(0);
+        p[2][1][0] =	T(0);
+        p[2][1][1] =	T(0);
+        p[2][1][2] =	T(0);
       }
       if(d1 && d2>1) {      //uvv
-        this->_p[1][2][0] =	T(0);
-        this->_p[1][2][1] =	T(0);
-        this->_p[1][2][2] =	T(0);
+        p[1][2][0] =	T(0);
+        p[1][2][1] =	T(0);
+        p[1][2][2] =	T(0);
       }
       if(d1>1 && d2>1) {    //uuvv
-        this->_p[2][2][0] =	T(0);
-        this->_p[2][2][1] =	T(0);
-        this->_p[2][2][2] =	T(0);
+        p[2][2][0] =	T(0);
+        p[2][2][1] =	T(0);
+        p[2][2][2] =	T(0);
       }
     }
   }
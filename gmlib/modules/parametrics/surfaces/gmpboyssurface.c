@@ -73,9 +73,9 @@ namespace GMlib {
   //**************************************************
 
   template <typename T>
-  void PBoysSurface<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PBoysSurface<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
       T sq2 = T(M_SQRT2);
       T cu  = cos(u);
@@ -107,25 +107,25 @@ namespace GMlib {
 
 
 
-    this->_p[0][0][0] =	cu*(sq2/T(3)*cu*c2v + t23*su*cv) / (T(1) - sqv);
-    this->_p[0][0][1] =	cu*(sq2/T(3)*cu*s2v - t23*suv) / (T(1) - sqv);
-    this->_p[0][0][2] =	cu/(T(1) - sqv)*cu - T(1);
+    p[0][0][0] =	cu*(sq2/T(3)*cu*c2v + t23*su*cv) / (T(1) - sqv);
+    p[0][0][1] =	cu*(sq2/T(3)*cu*s2v - t23*suv) / (T(1) - sqv);
+    p[0][0][2] =	cu/(T(1) - sqv)*cu - T(1);
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {              //u
           T hq = -c2u*sq2*s3v;
-        this->_p[1][0][0] =	-su*(T(1)/T(3)*sq2*cu*c2v + t23*su*cv) / (T(1)-sqv) + cu*(-T(1)/T(3)*sq2*su*c2v + t23*cuv) / (T(1)-sqv)
+        p[1][0][0] =	-su*(T(1)/T(3)*sq2*cu*c2v + t23*su*cv) / (T(1)-sqv) + cu*(-T(1)/T(3)*sq2*su*c2v + t23*cuv) / (T(1)-sqv)
                             - cu*(T(1)/T(3)*sq2*cu*c2v + t23*su*cv)*(-hq) / pow((T(1)-sqv),T(2));
-        this->_p[1][0][1] =	-su*(T(1)/T(3)*cu*s2v*sq2 - t23*suv) / (T(1)-sqv) + cu*(-T(1)/T(3)*su*s2v*sq2 + t23*cu*sv) / (T(1)-sqv)
+        p[1][0][1] =	-su*(T(1)/T(3)*cu*s2v*sq2 - t23*suv) / (T(1)-sqv) + cu*(-T(1)/T(3)*su*s2v*sq2 + t23*cu*sv) / (T(1)-sqv)
                             - cu*(T(1)/T(3)*cu*s2v*sq2 - t23*suv)*(-hq) / pow((T(1)-sqv),T(2));
-        this->_p[1][0][2] =	-T(2)*cu*su/(T(1)-sqv) - (cuu*(-hq)) / pow((T(1)-sqv),T(2));
+        p[1][0][2] =	-T(2)*cu*su/(T(1)-sqv) - (cuu*(-hq)) / pow((T(1)-sqv),T(2));
       }
 
       if(d1>1)//uu
       {
-        this->_p[2][0][0] =	-cu*(sq2*cu*c2v/T(3)+t23*su*cv)
+        p[2][0][0] =	-cu*(sq2*cu*c2v/T(3)+t23*su*cv)
                 /(T(1.0)-sqv)-T(2)*su*(-sq2*su*c2v
                 /T(3)+t23*cuv)/(T(1.0)-sqv)
                 +T(2)*su*(sq2*cu*c2v/T(3)+t23*su*cv)
@@ -141,7 +141,7 @@ namespace GMlib {
                 *c2v/T(3)+t23*su*cv)
                 /pow(T(1.0)-sqv,	T(2))*sq2*su*s3v;
 
-        this->_p[2][0][1] =	-cu*(sq2*cu*s2v/T(3)-t23*suv)
+        p[2][0][1] =	-cu*(sq2*cu*s2v/T(3)-t23*suv)
                 /(T(1.0)-sqv)-T(2)*su*(-sq2*su*s2v
                 /T(3)-t23*cu*sv)/(T(1.0)-sqv)
                 +T(2)*su*(sq2*cu*s2v/T(3)-t23*suv)
@@ -157,7 +157,7 @@ namespace GMlib {
                 *(sq2*cu*s2v/T(3)-t23*suv)
                 /pq2*sq2*su*s3v;
 
-        this->_p[2][0][2] =	T(2)*ps2/(T(1.0)-sqv)+T(4.0)*cu
+        p[2][0][2] =	T(2)*ps2/(T(1.0)-sqv)+T(4.0)*cu
                 /pq2*su*(-sq2*pc2
                 *s3v+sq2*ps2*s3v)-T(2)*pc2
                 /(T(1.0)-sqv)+T(2)*pc2
@@ -168,16 +168,16 @@ namespace GMlib {
 
       if(d2) //v
       {
-        this->_p[0][1][0] =	cu*(-t23*cu*s2v*sq2 - t23*suv) / (T(1)-sqv) + T(3)*cuu*(T(1)/T(3)*sq2*cu*c2v + t23*su*cv)*sq2*su*c3v / pow((T(1)-sqv),T(2));
+        p[0][1][0] =	cu*(-t23*cu*s2v*sq2 - t23*suv) / (T(1)-sqv) + T(3)*cuu*(T(1)/T(3)*sq2*cu*c2v + t23*su*cv)*sq2*su*c3v / pow((T(1)-sqv),T(2));
 
-        this->_p[0][1][1] =	cu*(t23*sq2*cu*c2v - t23*su*cv) / (T(1)-sq2*su*cu*sin(3*v)) + T(3)*cuu*(T(1)/T(3)*cu*s2v*sq2 - t23*suv)*sq2*su*c3v / pow((T(1)-sqv),T(2));
+        p[0][1][1] =	cu*(t23*sq2*cu*c2v - t23*su*cv) / (T(1)-sq2*su*cu*sin(3*v)) + T(3)*cuu*(T(1)/T(3)*cu*s2v*sq2 - t23*suv)*sq2*su*c3v / pow((T(1)-sqv),T(2));
 
-        this->_p[0][1][2] =	T(3)*cuu*cu*sq2*su*c3v / pow((T(1)-sqv),T(2));
+        p[0][1][2] =	T(3)*cuu*cu*sq2*su*c3v / pow((T(1)-sqv),T(2));
       }
 
       if(d2>1) //vv
       {
-        this->_p[0][2][0] =	cu*(-T(4.0)/T(3)*sq2*cu*c2v-t23*su*cv)
+        p[0][2][0] =	cu*(-T(4.0)/T(3)*sq2*cu*c2v-t23*su*cv)
                 /(T(1.0)-sqv)+T(6.0)*pc2
                 *(-t23*sqrt(T(2))*cu*s2v-t23*suv)
                 /pq2*sq2*su*c3v
@@ -187,7 +187,7 @@ namespace GMlib {
                 +t23*su*cv)/pq2
                 *sq2*su*s3v;
 
-        this->_p[0][2][1] =	cu*(-T(4.0)/T(3)*sq2*cu*s2v+t23*suv)
+        p[0][2][1] =	cu*(-T(4.0)/T(3)*sq2*cu*s2v+t23*suv)
                 /(T(1.0)-sqv)+T(6.0)*pc2
                 *(t23*sq2*cu*c2v-t23*su*cv)
                 /pq2*sq2*su*c3v
@@ -197,13 +197,13 @@ namespace GMlib {
                 /T(3)-t23*suv)/pq2
                 *sq2*su*s3v;
 
-        this->_p[0][2][2] =	T(36.0)*pow(cu,T(4.0))/pq3
+        p[0][2][2] =	T(36.0)*pow(cu,T(4.0))/pq3
                 *ps2*pow(c3v,T(2))-T(9.0)*pc3
                 /pq2*sq2*su*s3v;
       }
       if(d1 && d2) //uv
       {
-        this->_p[1][1][0] =	-su*(-t23*sq2*cu*s2v-t23*suv)
+        p[1][1][0] =	-su*(-t23*sq2*cu*s2v-t23*suv)
                 /(T(1.0)-sqv)-T(3)*ps2*(sq2*cu
                 *c2v/T(3)+t23*su*cv)
                 /pq2*sq2*cu*c3v
@@ -220,7 +220,7 @@ namespace GMlib {
                 /pq2*(-T(3)*sq2
                 *pc2*c3v+T(3)*sq2*ps2*c3v);
 
-        this->_p[1][1][1] =	-su*(t23*sq2*cu*c2v-t23*su*cv)
+        p[1][1][1] =	-su*(t23*sq2*cu*c2v-t23*su*cv)
                 /(T(1.0)-sqv)-T(3)*ps2*(sq2*cu
                 *s2v/T(3)-t23*suv)
                 /pq2*sq2*cu*c3v
@@ -238,7 +238,7 @@ namespace GMlib {
                 /pq2*(-T(3)*sq2
                 *pc2*c3v+T(3)*sq2*ps2*c3v);
 
-        this->_p[1][1][2] =	-T(6.0)*pc2/pq2
+        p[1][1][2] =	-T(6.0)*pc2/pq2
                 *ps2*sq2*c3v-T(6.0)*pc3
                 /pq3*(-sq2*pc2
                 *s3v+sq2*ps2*s3v)*sq2*su*c3v
@@ -275,7 +275,7 @@ namespace GMlib {
 
               s2 =	1/T(3)/pow((T)-T(1.0)+sqv,T(4));
 
-        this->_p[2][1][0] =	s1*s2;
+        p[2][1][0] =	s1*s2;
 
           s3 =	2.0*T(2)*sq2*c2v+4.0*cu*T(2)*su*cv
             -16.0*pc4*sq2*c3v*T(6)*sv
@@ -310,8 +310,8 @@ namespace GMlib {
 
           s2 =	1/T(3)/pow((T)-T(1.0)+sqv,T(4));
 
-        this->_p[2][1][1] =	s1*s2;
-        this->_p[2][1][2] =	-2.0*sq2*cu*c3v*T(3)*(-4.0*pc5*sq2*s3v
+        p[2][1][1] =	s1*s2;
+        p[2][1][2] =	-2.0*sq2*cu*c3v*T(3)*(-4.0*pc5*sq2*s3v
                 +8.0*su*cuu-pc4*su*T(2)+pc4
                 *su*T(2)*T(9)+2.0*pc3*sq2*s3v
                 -3.0*su)/pow((T)-T(1.0)+sqv,T(4));
@@ -377,7 +377,7 @@ namespace GMlib {
 
         s2 =	1/T(3)/pow((T)T(1.0)-sqv,T(4));
 
-        this->_p[1][2][0] =	s1*s2;
+        p[1][2][0] =	s1*s2;
 
           s4 =	-T(2)*sv-2.0*su*sq2*cu*s3v*T(9)*T(2)
             *sv-4.0*T(2)*T(2)*cuu*c3v*T(3)*cv
@@ -435,8 +435,8 @@ namespace GMlib {
 
           s2 =	1/T(3)/pow((T)-T(1.0)+sqv,T(4));
 
-        this->_p[1][2][1] =	s1*s2;
-        this->_p[1][2][2] =	-cuu*sq2*T(9)*(4.0*s3v*cuu
+        p[1][2][1] =	s1*s2;
+        p[1][2][2] =	-cuu*sq2*T(9)*(4.0*s3v*cuu
                 +pc4*T(2)*T(9)*s3v-3.0*s3v
                 -s3v*T(2)*cuu+s3v*T(2)
                 *pc4-4.0*su*sq2*pc3+4.0*su*sq2
@@ -558,7 +558,7 @@ namespace GMlib {
 
           s2 =	1/T(3)/pow((T)-T(1.0)+sqv,T(5));
 
-        this->_p[2][2][0] =	s1*s2;
+        p[2][2][0] =	s1*s2;
 
           s5 =	16.0*pc6*T(2)*sq3*s3v*c3v*T(3)*c2v
             +32.0*pc3*T(2)*T(2)*c3v*T(3)*su*c2v
@@ -660,7 +660,7 @@ namespace GMlib {
 
           s2 = 1/T(3)/pow((T)-T(1.0)+sqv,T(5));
 
-        this->_p[2][2][1] =	s1*s2;
+        p[2][2][1] =	s1*s2;
 
         T s6 =	8.0*su*s3v*cuu+32.0*pc5*sq2*T(9)
             +8.0*pc6*T(2)*s3v*su*T(9)
@@ -678,7 +678,7 @@ namespace GMlib {
 
           s4 = T(9)*s5*s6;
 
-        this->_p[2][2][2] =	-2.0*sq2*cu*s4;
+        p[2][2][2] =	-2.0*sq2*cu*s4;
       }
     }
   }
@@ -27,6 +27,7 @@
 
 // gmlib
 #include <core/containers/gmdmatrix.h>
+#include <core/utils/gmparallel.h>
 #include <scene/selector/gmselector.h>
 
 namespace GMlib {
@@ -267,7 +268,7 @@ namespace GMlib {
       makePartition();
       for(int i=0; i < _visu.getDim1(); i++)
         for(int j=0; j < _visu.getDim2(); j++) {
-          DMatrix<DMatrix<Vector<T,3>>>&  p = _visu[i][j].sample_val;
+          DSampleGrid<Vector<T,3>>&       p = _visu[i][j].sample_val;
           DMatrix<Vector<float,3>>& normals = _visu[i][j].normals;
           Sphere<T,3>&                    s = _visu[i][j].sur_sphere;
           // Calculate sample positions, derivatives, normals and surrounding sphere
@@ -425,7 +426,7 @@ namespace GMlib {
 
 
   template <typename T>
-  void PBSplineSurf<T>::eval( T u, T v, int du, int dv, bool lu, bool lv ) const {
+  void PBSplineSurf<T>::eval( DMatrix<Vector<T,3>>& p, T u, T v, int du, int dv, bool lu, bool lv ) const {
 
       DMatrix<T>   bu, bv;
       std::vector<int> ind_i(_ku), ind_j(_kv);
@@ -436,7 +437,7 @@ namespace GMlib {
       makeIndex(ind_i, i, _ku, _c.getDim1());
       makeIndex(ind_j, j, _kv, _c.getDim2());
 
-      multEval( this->_p, bu, bv, ind_i, ind_j, du, dv);
+      multEval( p, bu, bv, ind_i, ind_j, du, dv);
   }
 
 
@@ -535,16 +536,32 @@ namespace GMlib {
 
 
 
+  // The samples of another level of detail are swapped in, the indices of the
+  // samples affected by the control points are made for them
+  //*****************************************************************
+  template <typename T>
+  void  PBSplineSurf<T>::lodSwapped() {
+
+    preSample();
+  }
+
+
+
 
 
   template <typename T>
-  void PBSplineSurf<T>::resample( DMatrix< DMatrix< Vector<T,3> > >& p, const PreBasis<T>& bu, const PreBasis<T>& bv, int m1, int m2, int d1, int d2 ) const {
+  void PBSplineSurf<T>::resample( DSampleGrid<Vector<T,3>>& p, const PreBasis<T>& bu, const PreBasis<T>& bv, int m1, int m2, int d1, int d2 ) const {
 
-      p.setDim(m1, m2);
+      p.setDim(m1, m2, d1, d2);
 
-      for(int i=0; i<m1; i++)
-          for(int j=0; j<m2; j++)
-              multEval( p[i][j], bu[i], bv[j], bu[i].ind, bv[j].ind, d1, d2);
+      Parallel::forBlocks( 0, m1, [&]( int b, int e ) {
+          DMatrix<Vector<T,3>> q;
+          for(int i=b; i<e; i++)
+              for(int j=0; j<m2; j++) {
+                  multEval( q, bu[i], bv[j], bu[i].ind, bv[j].ind, d1, d2);
+                  p.setSample( q, i, j );
+              }
+      }, this->_no_threads );
   }
 
 
@@ -594,8 +611,8 @@ namespace GMlib {
                   c[i][j] += _c(ii[i])(ij[k])*bv(j)(k);
           }
       //    p = bu * c
-      for(int i=0; i<=dv; i++)
-          for(int j=0; j<=du; j++) {
+      for(int i=0; i<=du; i++)
+          for(int j=0; j<=dv; j++) {
               p[i][j] = bu(i)(0)*c[0][j];
               for(int k=1; k<_ku; k++)
                   p[i][j] += bu(i)(k)*c[k][j];
@@ -682,14 +699,14 @@ namespace GMlib {
           for(int i1 =_cp_index[ind[0]][ind[1]][i][j][0][0]; i1 <= _cp_index[ind[0]][ind[1]][i][j][0][1]; i1++)
             for(int j1 =_cp_index[ind[0]][ind[1]][i][j][1][0]; j1 <= _cp_index[ind[0]][ind[1]][i][j][1][1]; j1++) {
               // for each sample value
-              DMatrix<Vector<T,3>>&  sp = p.sample_val[i1][j1];
+              DSampleGrid<Vector<T,3>>&  sp = p.sample_val;
               for(uint ku=0; ku < _pre_basis_u[i][i1].ind.size(); ku++)
                 for(uint kv=0; kv < _pre_basis_v[j][j1].ind.size(); kv++)
                   if(_pre_basis_u[i][i1].ind[ku] == ind[0] && _pre_basis_v[j][j1].ind[kv] == ind[1])
-                    comp(sp, _pre_basis_u[i][i1],  _pre_basis_v[j][j1], es.dp, ku, kv);
-              p.normals[i1][j1] = sp(1)(0) ^ sp(0)(1);
+                    comp(sp, i1, j1, _pre_basis_u[i][i1],  _pre_basis_v[j][j1], es.dp, ku, kv);
+              p.normals[i1][j1] = sp(i1,j1,1,0) ^ sp(i1,j1,0,1);
               p.normals[i1][j1].normalize();
-              p.sur_sphere += sp(0)(0);
+              p.sur_sphere += sp(i1,j1);
             }
         }
       _pos_change.pop_back();
@@ -698,13 +715,15 @@ namespace GMlib {
 
 
 
-  /*! void PBSplineSurf<T>::comp(DVector<Vector<T,3>>& p, const DMatrix<T>& B, const Vector<T,3>& d, int k) const
+  /*! void PBSplineSurf<T>::comp(DSampleGrid<Vector<T,3>>& p, int i, int j, const DMatrix<T>& Bu, const DMatrix<T>& Bv, const Vector<T,3>& d, int ku, int kv) const
    *  Protected,
    *  Partial vector-matrix computation, ie. actually a vector-vector innerproduct.
    *  where vi compute a vector vith a column vector with index ku in the matrix Bu,
    *  i.e. p = Bu^T_row[ku] * d * Bv_column[kv]
    *
-   *  \param[out]  p  Updating the position and d derivatives
+   *  \param[out]  p  Updating the position and d derivatives of sample (i,j)
+   *  \param[in]   i  The sample index in u - direction.
+   *  \param[in]   j  The sample index in v - direction.
    *  \param[in]   Bu The Bernstein-Hermite matrix in u - direction.
    *  \param[in]   Bv The Bernstein-Hermite matrix in v - direction.
    *  \param[in]   d  The distance vector, one control point has been moved
@@ -713,11 +732,11 @@ namespace GMlib {
    */
   template <typename T>
   inline
-  void  PBSplineSurf<T>::comp(DMatrix<Vector<T,3>>& p, const DMatrix<T>& Bu, const DMatrix<T>& Bv, const Vector<T,3>& d, int ku, int kv) const {
+  void  PBSplineSurf<T>::comp(DSampleGrid<Vector<T,3>>& p, int i, int j, const DMatrix<T>& Bu, const DMatrix<T>& Bv, const Vector<T,3>& d, int ku, int kv) const {
 
-      for(int i=0; i<p.getDim1(); i++)
-        for(int j=0; j<p.getDim2(); j++)
-          p[i][j] += (Bu(i)(ku)*Bv(j)(kv))*d;
+      for(int a=0; a<p.getDerDim1(); a++)
+        for(int b=0; b<p.getDerDim2(); b++)
+          p(i,j,a,b) += (Bu(a)(ku)*Bv(b)(kv))*d;
   }
 
 
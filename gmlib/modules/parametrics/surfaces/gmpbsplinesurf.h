@@ -139,7 +139,7 @@ namespace GMlib {
       mutable std::vector<EditSet> _pos_change;     //!< The step vector of control points that is moved
 
       // Virtual function from PSurf that has to be implemented locally
-      void                       eval( T u, T v, int d1 = 0, int d2 = 0, bool lu = false, bool lv = false ) const override; // Abstract in PSurf
+      void                       eval( DMatrix<Vector<T,3>>& p, T u, T v, int d1 = 0, int d2 = 0, bool lu = false, bool lv = false ) const override; // Abstract in PSurf
       T                          getStartPU() const override;
       T                          getEndPU()   const override;
       T                          getStartPV() const override;
@@ -152,7 +152,8 @@ namespace GMlib {
 
       // Virtual function from PSurf
       void                       preSample( int dir, int m ) override;
-      void                       resample( DMatrix<DMatrix <Vector<T,3> > >& p, const PreBasis<T>& bu, const PreBasis<T>& bv, int m1, int m2, int d1, int d2 ) const;
+      void                       lodSwapped() override;
+      void                       resample( DSampleGrid<Vector<T,3>>& p, const PreBasis<T>& bu, const PreBasis<T>& bv, int m1, int m2, int d1, int d2 ) const;
 
       // Help functions
       void                       makeIndex( std::vector<int>& ind, int i, int k, int n) const;
@@ -165,7 +166,7 @@ namespace GMlib {
       void                       updateSamples() const;
       void                       makePartition();
 
-      void                       comp(DMatrix<Vector<T,3>>& p, const DMatrix<T>& Bu, const DMatrix<T>& Bv, const Vector<T,3>& c, int k1, int k2) const;
+      void                       comp(DSampleGrid<Vector<T,3>>& p, int i, int j, const DMatrix<T>& Bu, const DMatrix<T>& Bv, const Vector<T,3>& c, int k1, int k2) const;
       Vector<int,2>              _map1(int i) const;
       int                        _map2(int i, int j) const;
 
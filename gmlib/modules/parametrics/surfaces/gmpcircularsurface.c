@@ -44,6 +44,8 @@ namespace GMlib {
   inline
   PCircularSurface<T>::PCircularSurface( const PCircularSurface<T>& copy ) : PSurf<T,3>( copy ) {
     init();
+
+    _radius = copy._radius;
   }
 
 
@@ -94,56 +96,56 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PCircularSurface<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PCircularSurface<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
-    this->_p[0][0][0] = u * cos( v );
-    this->_p[0][0][1] = u * sin( v );
-    this->_p[0][0][2] = T(0);
+    p[0][0][0] = u * cos( v );
+    p[0][0][1] = u * sin( v );
+    p[0][0][2] = T(0);
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {
-        this->_p[1][0][0] = cos(v);         // S_u
-        this->_p[1][0][1] = sin(v);
-        this->_p[1][0][2] =  T(0);
+        p[1][0][0] = cos(v);         // S_u
+        p[1][0][1] = sin(v);
+        p[1][0][2] =  T(0);
       }
       if(d2) {
-        this->_p[0][1][0] = u * -sin(v);	// S_v
-        this->_p[0][1][1] = u *  cos(v);
-        this->_p[0][1][2] = T(0);
+        p[0][1][0] = u * -sin(v);	// S_v
+        p[0][1][1] = u *  cos(v);
+        p[0][1][2] = T(0);
       }
       if(d1 && d2) {
-        this->_p[1][1][0] = -sin(v);        // S_uv
-        this->_p[1][1][1] =  cos(v);
-        this->_p[1][1][2] =  T(0);
+        p[1][1][0] = -sin(v);        // S_uv
+        p[1][1][1] =  cos(v);
+        p[1][1][2] =  T(0);
       }
       if(d1>1) {
-        this->_p[2][0][0] =  T(0);          // S_uu
-        this->_p[2][0][1] =  T(0);
-        this->_p[2][0][2] =  T(0);
+        p[2][0][0] =  T(0);          // S_uu
+        p[2][0][1] =  T(0);
+        p[2][0][2] =  T(0);
       }
       if(d2>1) {
-        this->_p[0][2][0] = u * -cos(v);	// S_vv
-        this->_p[0][2][1] = u * -sin(v);
-        this->_p[0][2][2] =  T(0);
+        p[0][2][0] = u * -cos(v);	// S_vv
+        p[0][2][1] = u * -sin(v);
+        p[0][2][2] =  T(0);
       }
       if(d1>1 && d2) {
-        this->_p[2][1][0] =  T(0);          // S_uuv
-        this->_p[2][1][1] =  T(0);
-        this->_p[2][1][2] =  T(0);
+        p[2][1][0] =  T(0);          // S_uuv
+        p[2][1][1] =  T(0);
+        p[2][1][2] =  T(0);
       }
       if(d1 && d2>1) {
-        this->_p[1][2][0] = -cos(v);        // S_uvv
-        this->_p[1][2][1] = -sin(v);
-        this->_p[1][2][2] =  T(0);
+        p[1][2][0] = -cos(v);        // S_uvv
+        p[1][2][1] = -sin(v);
+        p[1][2][2] =  T(0);
       }
       if(d1>1 && d2>1) {
-        this->_p[2][2][0] =  T(0);          // S_uuvv
-        this->_p[2][2][1] =  T(0);
-        this->_p[2][2][2] =  T(0);
+        p[2][2][0] =  T(0);          // S_uuvv
+        p[2][2][1] =  T(0);
+        p[2][2][2] =  T(0);
 
       }
     }
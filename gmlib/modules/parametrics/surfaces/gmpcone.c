@@ -79,57 +79,57 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PCone<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PCone<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
 
-    this->_p[0][0][0] =	(_h-u)*_r*cos(v)/_h;
-    this->_p[0][0][1] =	(_h-u)*_r*sin(v)/_h;
-    this->_p[0][0][2] =	u;
+    p[0][0][0] =	(_h-u)*_r*cos(v)/_h;
+    p[0][0][1] =	(_h-u)*_r*sin(v)/_h;
+    p[0][0][2] =	u;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                      //u
-        this->_p[1][0][0] =	-_r*cos(v)/_h;
-        this->_p[1][0][1] =	-_r*sin(v)/_h;
-        this->_p[1][0][2] =	T(1);
+        p[1][0][0] =	-_r*cos(v)/_h;
+        p[1][0][1] =	-_r*sin(v)/_h;
+        p[1][0][2] =	T(1);
       }
       if(d1>1) {                    //uu
-        this->_p[2][0][0] =	T(0);
-        this->_p[2][0][1] =	T(0);
-        this->_p[2][0][2] =	T(0);
+        p[2][0][0] =	T(0);
+        p[2][0][1] =	T(0);
+        p[2][0][2] =	T(0);
       }
       if(d2) {                      //v
-        this->_p[0][1][0] =	-(_h-u)*_r*sin(v)/_h;
-        this->_p[0][1][1] =	(_h-u)*_r*cos(v)/_h;
-        this->_p[0][1][2] =	T(0);
+        p[0][1][0] =	-(_h-u)*_r*sin(v)/_h;
+        p[0][1][1] =	(_h-u)*_r*cos(v)/_h;
+        p[0][1][2] =	T(0);
       }
       if(d2>1) {                    //vv
-        this->_p[0][2][0] =	-(_h-u)*_r*cos(v)/_h;
-        this->_p[0][2][1] =	-(_h-u)*_r*sin(v)/_h;
-        this->_p[0][2][2] =	T(0);
+        p[0][2][0] =	-(_h-u)*_r*cos(v)/_h;
+        p[0][2][1] =	-(_h-u)*_r*sin(v)/_h;
+        p[0][2][2] =	T(0);
       }
       if(d1>1 && d2>1) {            //uv
-        this->_p[1][1][0] =	_r*sin(v)/_h;
-        this->_p[1][1][1] =	-_r*cos(v)/_h;
-        this->_p[1][1][2] =	T(0);
+        p[1][1][0] =	_r*sin(v)/_h;
+        p[1][1][1] =	-_r*cos(v)/_h;
+        p[1][1][2] =	T(0);
       }
       if(d1>2) {                    //uuv
-        this->_p[2][1][0] =	T(0);
-        this->_p[2][1][1] =	T(0);
-        this->_p[2][1][2] =	T(0);
+        p[2][1][0] =	T(0);
+        p[2][1][1] =	T(0);
+        p[2][1][2] =	T(0);
       }
       if(d2>2) {                    //uvv
-        this->_p[1][2][0] =	_r*cos(v)/_h;
-        this->_p[1][2][1] =	_r*sin(v)/_h;
-        this->_p[1][2][2] =	T(0);
+        p[1][2][0] =	_r*cos(v)/_h;
+        p[1][2][1] =	_r*sin(v)/_h;
+        p[1][2][2] =	T(0);
       }
       if(d1>2 && d2>2) {            //uuvv
-        this->_p[2][2][0] =	T(0);
-        this->_p[2][2][1] =	T(0);
-        this->_p[2][2][2] =	T(0);
+        p[2][2][0] =	T(0);
+        p[2][2][1] =	T(0);
+        p[2][2][2] =	T(0);
       }
     }
   }
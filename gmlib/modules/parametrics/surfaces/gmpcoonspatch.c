@@ -80,9 +80,14 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PCoonsPatch<T>::eval(T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
-
-    this->_p=_s1->evaluate(u, v, d1, d2) + _s2->evaluate(u, v, d1, d2) - _s3->evaluate(u, v, d1, d2);
+  void PCoonsPatch<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
+
+    DMatrix<Vector<T,3>> q;
+    _s1->evaluate(p, u, v, d1, d2);
+    _s2->evaluate(q, u, v, d1, d2);
+    p += q;
+    _s3->evaluate(q, u, v, d1, d2);
+    p -= q;
   }
 
 
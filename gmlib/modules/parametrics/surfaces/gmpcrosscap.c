@@ -77,17 +77,17 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PCrossCap<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PCrossCap<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T a = _r*_r*cos(u)*sin(u)*sin(v);
     T b = _r*_r*sin(2*v)*cos(u)*cos(u);
     T c = _r*_r*cos(2*v)*cos(u)*cos(u);
 
-    this->_p[0][0][0] =	a;
-    this->_p[0][0][1] =	b;
-    this->_p[0][0][2] =	c;
+    p[0][0][0] =	a;
+    p[0][0][1] =	b;
+    p[0][0][2] =	c;
 
     T d, e, f, g;
 
@@ -97,53 +97,53 @@ namespace GMlib {
       {
         d = 2*_r*_r*sin(2*v)*cos(u)*sin(u);
         e = 2*_r*_r*cos(2*v)*cos(u)*sin(u);
-        this->_p[1][0][0] =	-_r*_r*sin(u)*sin(u)*sin(v) + _r*_r*cos(u)*cos(u)*sin(v);
-        this->_p[1][0][1] =	-d;
-        this->_p[1][0][2] =	-e;
+        p[1][0][0] =	-_r*_r*sin(u)*sin(u)*sin(v) + _r*_r*cos(u)*cos(u)*sin(v);
+        p[1][0][1] =	-d;
+        p[1][0][2] =	-e;
       }
       if(d1>1)//uu
       {
         f = 2*_r*_r*sin(2*v)*sin(u)*sin(u);
         g = 2*_r*_r*cos(2*v)*sin(u)*sin(u);
-        this->_p[2][0][0] =	-4*a;
-        this->_p[2][0][1] =	 f - 2*b;
-        this->_p[2][0][2] =	 g - 2*c;
+        p[2][0][0] =	-4*a;
+        p[2][0][1] =	 f - 2*b;
+        p[2][0][2] =	 g - 2*c;
       }
       if(d2) //v
       {
-        this->_p[0][1][0] =	 _r*_r*cos(u)*sin(u)*cos(v);
-        this->_p[0][1][1] =	 2*c;
-        this->_p[0][1][2] =	-2*b;
+        p[0][1][0] =	 _r*_r*cos(u)*sin(u)*cos(v);
+        p[0][1][1] =	 2*c;
+        p[0][1][2] =	-2*b;
       }
       if(d2>1) //vv
       {
-        this->_p[0][2][0] =	  -a;
-        this->_p[0][2][1] =	-4*b;
-        this->_p[0][2][2] =	-4*c;
+        p[0][2][0] =	  -a;
+        p[0][2][1] =	-4*b;
+        p[0][2][2] =	-4*c;
       }
       if(d1 && d2) //uv
       {
-        this->_p[1][1][0] =	 -_r*_r*sin(u)*sin(u)*cos(v) + _r*_r*cos(u)*cos(u)*cos(v);
-        this->_p[1][1][1] =	 -2*e;
-        this->_p[1][1][2] =	  2*d;
+        p[1][1][0] =	 -_r*_r*sin(u)*sin(u)*cos(v) + _r*_r*cos(u)*cos(u)*cos(v);
+        p[1][1][1] =	 -2*e;
+        p[1][1][2] =	  2*d;
       }
       if(d1>1 && d2)//uuv
       {
-        this->_p[2][1][0] =	-4*this->_p[0][1][0];
-        this->_p[2][1][1] =	 2*g - 4*c;
-        this->_p[2][1][2] =	-2*f + 4*b;
+        p[2][1][0] =	-4*p[0][1][0];
+        p[2][1][1] =	 2*g - 4*c;
+        p[2][1][2] =	-2*f + 4*b;
       }
       if(d1 && d2>1) //uvv
       {
-        this->_p[1][2][0] =	 -this->_p[1][0][0];
-        this->_p[1][2][1] =	 4*d;
-        this->_p[1][2][2] =	 4*e;
+        p[1][2][0] =	 -p[1][0][0];
+        p[1][2][1] =	 4*d;
+        p[1][2][2] =	 4*e;
       }
       if(d1>1 && d2>1) //uuvv
       {
-        this->_p[2][2][0] =	 4*a;
-        this->_p[2][2][1] =	-4*f + 8*b;
-        this->_p[2][2][2] =	-4*g + 8*c;
+        p[2][2][0] =	 4*a;
+        p[2][2][1] =	-4*f + 8*b;
+        p[2][2][2] =	-4*g + 8*c;
       }
     }
   }
@@ -115,55 +115,55 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PCylinder<T>::eval( T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PCylinder<T>::eval( DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
-    this->_p[0][0][0] =		_rx * sin( v );
-    this->_p[0][0][1] =		_ry * cos( v );
-    this->_p[0][0][2] =		_h * u;
+    p[0][0][0] =		_rx * sin( v );
+    p[0][0][1] =		_ry * cos( v );
+    p[0][0][2] =		_h * u;
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                  //u
-        this->_p[1][0][0] =	T(0);
-        this->_p[1][0][1] =	T(0);
-        this->_p[1][0][2] =	_h;
+        p[1][0][0] =	T(0);
+        p[1][0][1] =	T(0);
+        p[1][0][2] =	_h;
       }
       if(d1>1) {                //uu
-        this->_p[2][0][0] =	T(0);
-        this->_p[2][0][1] =	T(0);
-        this->_p[2][0][2] =	T(0);
+        p[2][0][0] =	T(0);
+        p[2][0][1] =	T(0);
+        p[2][0][2] =	T(0);
       }
       if(d2) {                  //v
-        this->_p[0][1][0] = _ry * cos(v);
-        this->_p[0][1][1] = -_rx *sin(v);
-        this->_p[0][1][2] =	T(0);
+        p[0][1][0] = _ry * cos(v);
+        p[0][1][1] = -_rx *sin(v);
+        p[0][1][2] =	T(0);
       }
       if(d2>1) {                //vv
-        this->_p[0][2][0] = -_ry * sin(v);
-        this->_p[0][2][1] =	-_rx * cos(v);
-        this->_p[0][2][2] =	T(0);
+        p[0][2][0] = -_ry * sin(v);
+        p[0][2][1] =	-_rx * cos(v);
+        p[0][2][2] =	T(0);
       }
       if(d1 && d2) {            //uv
-        this->_p[1][1][0] =	T(0);
-        this->_p[1][1][1] =	T(0);
-        this->_p[1][1][2] =	T(0);
+        p[1][1][0] =	T(0);
+        p[1][1][1] =	T(0);
+        p[1][1][2] =	T(0);
       }
       if(d1>1 && d2) {          //uuv
-        this->_p[2][1][0] = T(0);
-        this->_p[2][1][1] = T(0);
-        this->_p[2][1][2] = T(0);
+        p[2][1][0] = T(0);
+        p[2][1][1] = T(0);
+        p[2][1][2] = T(0);
       }
       if(d1 && d2>1) {          //uvv
-        this->_p[1][2][0] =	T(0);
-        this->_p[1][2][1] =	T(0);
-        this->_p[1][2][2] =	T(0);
+        p[1][2][0] =	T(0);
+        p[1][2][1] =	T(0);
+        p[1][2][2] =	T(0);
       }
       if(d1>1 && d2>1) {        //uuvv
-        this->_p[2][2][0] =	T(0);
-        this->_p[2][2][1] =	T(0);
-        this->_p[2][2][2] =	T(0);
+        p[2][2][0] =	T(0);
+        p[2][2][1] =	T(0);
+        p[2][2][2] =	T(0);
       }
     }
   }
@@ -75,58 +75,58 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PDiniSurface<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PDiniSurface<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
 
-    this->_p[0][0][0] =  	_r1*cos(u)*sin(v);
-    this->_p[0][0][1] =  	_r1*sin(u)*sin(v);
-    this->_p[0][0][2] =  	_r1*(cos(v)+log(tan((T(0.5)*v))))+_r2*u;
+    p[0][0][0] =  	_r1*cos(u)*sin(v);
+    p[0][0][1] =  	_r1*sin(u)*sin(v);
+    p[0][0][2] =  	_r1*(cos(v)+log(tan((T(0.5)*v))))+_r2*u;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {              //u
-        this->_p[1][0][0] =	-_r1*sin(u)*sin(v);
-        this->_p[1][0][1] =	_r1*cos(u)*sin(v);
-        this->_p[1][0][2] =	_r2;
+        p[1][0][0] =	-_r1*sin(u)*sin(v);
+        p[1][0][1] =	_r1*cos(u)*sin(v);
+        p[1][0][2] =	_r2;
       }
       if(d1>1) {            //uu
-        this->_p[2][0][0] =	-_r1*cos(u)*sin(v);
-        this->_p[2][0][1] =	-_r1*sin(u)*sin(v);
-        this->_p[2][0][2] =	T(0);
+        p[2][0][0] =	-_r1*cos(u)*sin(v);
+        p[2][0][1] =	-_r1*sin(u)*sin(v);
+        p[2][0][2] =	T(0);
       }
       if(d2) {              //v
-        this->_p[0][1][0] =	_r1*cos(u)*cos(v);
-        this->_p[0][1][1] =	_r1*sin(u)*cos(v);
-        this->_p[0][1][2] =	_r1*(-sin(v)+(1+tan(T(.5)*v)*tan(T(.5)*v))*T(.5)/tan(T(.5)*v));
+        p[0][1][0] =	_r1*cos(u)*cos(v);
+        p[0][1][1] =	_r1*sin(u)*cos(v);
+        p[0][1][2] =	_r1*(-sin(v)+(1+tan(T(.5)*v)*tan(T(.5)*v))*T(.5)/tan(T(.5)*v));
       }
       if(d2>1) {            //vv
-        this->_p[0][2][0] =	-_r1*cos(u)*sin(v);
-        this->_p[0][2][1] =	-_r1*sin(u)*sin(v);
-        this->_p[0][2][2] =	-0.25*_r1*(-4.0*cos(v)*pow(cos(T(0.5)*v),T(2.0))+4.0*cos(v)*pow(cos(T(0.5)*v),T(4.0))+1.0
+        p[0][2][0] =	-_r1*cos(u)*sin(v);
+        p[0][2][1] =	-_r1*sin(u)*sin(v);
+        p[0][2][2] =	-0.25*_r1*(-4.0*cos(v)*pow(cos(T(0.5)*v),T(2.0))+4.0*cos(v)*pow(cos(T(0.5)*v),T(4.0))+1.0
                 -2.0*pow(cos(T(0.5)*v),T(2.0)))/pow(cos(T(0.5)*v),T(2.0))/(-1.0+pow(cos(T(0.5)*v),T(2.0)));
       }
       if(d1 && d2) {        //uv
-        this->_p[1][1][0] =	-_r1*sin(u)*cos(v);
-        this->_p[1][1][1] =	_r1*cos(u)*cos(v);
-        this->_p[1][1][2] =	T(0);
+        p[1][1][0] =	-_r1*sin(u)*cos(v);
+        p[1][1][1] =	_r1*cos(u)*cos(v);
+        p[1][1][2] =	T(0);
       }
       if(d1>1 && d2) {      //uuv
-        this->_p[2][1][0] =	-_r1*cos(u)*cos(v);
-        this->_p[2][1][1] =	-_r1*sin(u)*cos(v);
-        this->_p[2][1][2] =	T(0);
+        p[2][1][0] =	-_r1*cos(u)*cos(v);
+        p[2][1][1] =	-_r1*sin(u)*cos(v);
+        p[2][1][2] =	T(0);
       }
       if(d1 && d2>1) {      //uvv
-        this->_p[1][2][0] =	_r1*sin(u)*sin(v);
-        this->_p[1][2][1] =	-_r1*cos(u)*sin(v);
-        this->_p[1][2][2] =	T(0);
+        p[1][2][0] =	_r1*sin(u)*sin(v);
+        p[1][2][1] =	-_r1*cos(u)*sin(v);
+        p[1][2][2] =	T(0);
       }
       if(d1>1 && d2>1) {    //uuvv
-        this->_p[2][2][0] =	_r1*cos(u)*sin(v);
-        this->_p[2][2][1] =	_r1*sin(u)*sin(v);
-        this->_p[2][2][2] =	T(0);
+        p[2][2][0] =	_r1*cos(u)*sin(v);
+        p[2][2][1] =	_r1*sin(u)*sin(v);
+        p[2][2][2] =	T(0);
       }
     }
   }
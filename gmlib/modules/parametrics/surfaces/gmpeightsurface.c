@@ -74,57 +74,57 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PEightSurface<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PEightSurface<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
 
-    this->_p[0][0][0] =	cos(u)*sin(v)*cos(v);
-    this->_p[0][0][1] =	sin(u)*sin(v)*cos(v);
-    this->_p[0][0][2] =	sin(v);
+    p[0][0][0] =	cos(u)*sin(v)*cos(v);
+    p[0][0][1] =	sin(u)*sin(v)*cos(v);
+    p[0][0][2] =	sin(v);
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                  //u
-        this->_p[1][0][0] =	-sin(u)*sin(v)*cos(v);
-        this->_p[1][0][1] =	cos(u)*sin(v)*cos(v);
-        this->_p[1][0][2] =	T(0);
+        p[1][0][0] =	-sin(u)*sin(v)*cos(v);
+        p[1][0][1] =	cos(u)*sin(v)*cos(v);
+        p[1][0][2] =	T(0);
       }
       if(d1>1) {                //uu
-        this->_p[2][0][0] =	-cos(u)*sin(v)*cos(v);
-        this->_p[2][0][1] =	-sin(u)*sin(v)*cos(v);
-        this->_p[2][0][2] =	T(0);
+        p[2][0][0] =	-cos(u)*sin(v)*cos(v);
+        p[2][0][1] =	-sin(u)*sin(v)*cos(v);
+        p[2][0][2] =	T(0);
       }
       if(d2) {                  //v
-        this->_p[0][1][0] =	cos(u)*(T(2)*cos(v)*cos(v)-T(1));
-        this->_p[0][1][1] =	sin(u)*(T(2)*cos(v)*cos(v)-T(1));
-        this->_p[0][1][2] =	cos(v);
+        p[0][1][0] =	cos(u)*(T(2)*cos(v)*cos(v)-T(1));
+        p[0][1][1] =	sin(u)*(T(2)*cos(v)*cos(v)-T(1));
+        p[0][1][2] =	cos(v);
       }
       if(d2>1) {                //vv
-        this->_p[0][2][0] =	-T(4)*cos(u)*sin(v)*cos(v);
-        this->_p[0][2][1] =	-T(4)*sin(u)*sin(v)*cos(v);
-        this->_p[0][2][2] =	-sin(v);
+        p[0][2][0] =	-T(4)*cos(u)*sin(v)*cos(v);
+        p[0][2][1] =	-T(4)*sin(u)*sin(v)*cos(v);
+        p[0][2][2] =	-sin(v);
       }
       if(d1 && d2) {            //uv
-        this->_p[1][1][0] =	-sin(u)*(T(2)*cos(v)*cos(v)-T(1));
-        this->_p[1][1][1] =	cos(u)*(T(2)*cos(v)*cos(v)-T(1));
-        this->_p[1][1][2] =	T(0);
+        p[1][1][0] =	-sin(u)*(T(2)*cos(v)*cos(v)-T(1));
+        p[1][1][1] =	cos(u)*(T(2)*cos(v)*cos(v)-T(1));
+        p[1][1][2] =	T(0);
       }
       if(d1>1 && d2) {          //uuv
-        this->_p[2][1][0] =	-cos(u)*(T(2)*cos(v)*cos(v)-T(1));
-        this->_p[2][1][1] =	-sin(u)*(T(2)*cos(v)*cos(v)-T(1));
-        this->_p[2][1][2] =	T(0);
+        p[2][1][0] =	-cos(u)*(T(2)*cos(v)*cos(v)-T(1));
+        p[2][1][1] =	-sin(u)*(T(2)*cos(v)*cos(v)-T(1));
+        p[2][1][2] =	T(0);
       }
       if(d1 && d2>1) {          //uvv
-        this->_p[1][2][0] =	T(4)*sin(u)*sin(v)*cos(v);
-        this->_p[1][2][1] =	-T(4)*cos(u)*sin(v)*cos(v);
-        this->_p[1][2][2] =	T(0);
+        p[1][2][0] =	T(4)*sin(u)*sin(v)*cos(v);
+        p[1][2][1] =	-T(4)*cos(u)*sin(v)*cos(v);
+        p[1][2][2] =	T(0);
       }
       if(d1>1 && d2>1) {        //uuvv
-        this->_p[2][2][0] =	T(4)*cos(u)*sin(v)*cos(v);
-        this->_p[2][2][1] =	T(4)*sin(u)*sin(v)*cos(v);
-        this->_p[2][2][2] =	T(0);
+        p[2][2][0] =	T(4)*cos(u)*sin(v)*cos(v);
+        p[2][2][1] =	T(4)*sin(u)*sin(v)*cos(v);
+        p[2][2][2] =	T(0);
       }
     }
   }
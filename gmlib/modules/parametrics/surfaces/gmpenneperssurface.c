@@ -76,58 +76,58 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PEnnepersSurface<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PEnnepersSurface<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T a = T(3.3333333e-01);
 
-    this->_p[0][0][0] =  -a*(u*u*u) + (v*v)*u + u;
-    this->_p[0][0][1] =  -v - v*(u*u) + a*(v*v*v);
-    this->_p[0][0][2] =  (u*u) - (v*v);
+    p[0][0][0] =  -a*(u*u*u) + (v*v)*u + u;
+    p[0][0][1] =  -v - v*(u*u) + a*(v*v*v);
+    p[0][0][2] =  (u*u) - (v*v);
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                      //u
-        this->_p[1][0][0] =	-T(3)*a*u*u + v*v + T(1);
-        this->_p[1][0][1] =	-T(2)*v*u;
-        this->_p[1][0][2] =	 T(2)*u;
+        p[1][0][0] =	-T(3)*a*u*u + v*v + T(1);
+        p[1][0][1] =	-T(2)*v*u;
+        p[1][0][2] =	 T(2)*u;
       }
       if(d1>1) {                    //uu
-        this->_p[2][0][0] =	-T(6)*a*u;
-        this->_p[2][0][1] =	-T(2)*v;
-        this->_p[2][0][2] =	 T(2);
+        p[2][0][0] =	-T(6)*a*u;
+        p[2][0][1] =	-T(2)*v;
+        p[2][0][2] =	 T(2);
       }
       if(d2) {                      //v
-        this->_p[0][1][0] =	 T(2)*v*u;
-        this->_p[0][1][1] =	-T(1) - u*u + T(3)*a*v*v;
-        this->_p[0][1][2] =	-T(2)*v;
+        p[0][1][0] =	 T(2)*v*u;
+        p[0][1][1] =	-T(1) - u*u + T(3)*a*v*v;
+        p[0][1][2] =	-T(2)*v;
       }
       if(d2>1) {                    //vv
-        this->_p[0][2][0] =  T(2)*u;
-        this->_p[0][2][1] =  T(6)*a*v;
-        this->_p[0][2][2] =	-T(2);
+        p[0][2][0] =  T(2)*u;
+        p[0][2][1] =  T(6)*a*v;
+        p[0][2][2] =	-T(2);
       }
       if(d1 && d2) {                //uv
-        this->_p[1][1][0] =	 T(2)*v;
-        this->_p[1][1][1] =	-T(2)*u;
-        this->_p[1][1][2] =	 T(0);
+        p[1][1][0] =	 T(2)*v;
+        p[1][1][1] =	-T(2)*u;
+        p[1][1][2] =	 T(0);
       }
       if(d1>1 && d2) {              //uuv
-        this->_p[2][1][0] =	 T(0);
-        this->_p[2][1][1] =	-T(2);
-        this->_p[2][1][2] =	 T(0);
+        p[2][1][0] =	 T(0);
+        p[2][1][1] =	-T(2);
+        p[2][1][2] =	 T(0);
       }
       if(d1 && d2>1) {              //uvv
-        this->_p[1][2][0] =	T(2);
-        this->_p[1][2][1] =	T(0);
-        this->_p[1][2][2] =	T(0);
+        p[1][2][0] =	T(2);
+        p[1][2][1] =	T(0);
+        p[1][2][2] =	T(0);
       }
       if(d1>1 && d2>1) {            //uuvv
-        this->_p[2][2][0] =	T(0);
-        this->_p[2][2][1] =	T(0);
-        this->_p[2][2][2] =	T(0);
+        p[2][2][0] =	T(0);
+        p[2][2][1] =	T(0);
+        p[2][2][2] =	T(0);
       }
     }
   }
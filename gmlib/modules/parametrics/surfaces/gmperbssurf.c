@@ -434,7 +434,21 @@ namespace GMlib {
    */
   template <typename T>
   inline
-  PERBSSurf<T>::PERBSSurf( const PERBSSurf<T>& copy ) : PSurf<T,3>( copy ) {
+  PERBSSurf<T>::PERBSSurf( const PERBSSurf<T>& copy ) : PERBSSurf( copy, true ) {}
+
+
+  /*! PERBSSurf<T>::PERBSSurf( const PERBSSurf<T>& copy, bool children )
+   *
+   *  Private, copy constructor.
+   *  Without children the local patches are snapshots (see makeSnapshot()),
+   *  owned by the copy but not inserted in it.
+   *
+   *  \param[in]  copy      Parametric Expo-Rational surface to copy.
+   *  \param[in]  children  Whether to copy the local patches as children.
+   */
+  template <typename T>
+  inline
+  PERBSSurf<T>::PERBSSurf( const PERBSSurf<T>& copy, bool children ) : PSurf<T,3>( copy, children ) {
 
     init(copy._closed_u, copy._closed_v);
 
@@ -454,6 +468,14 @@ namespace GMlib {
     // sync local patches
     const DMatrix< PSurf<T,3>* >  &c = copy._c;
     _c.setDim( c.getDim1(), c.getDim2() );
+
+    if( !children ) {
+      _own_c = true;
+      for( int i = 0; i < c.getDim1(); ++i )
+        for( int j = 0; j < c.getDim2(); ++j )
+          _c[i][j] = c(i)(j)->makeSnapshot();
+      return;
+    }
     Array< unsigned int > cl;
     Array< std::pair<int,int> > cli;
 
@@ -495,16 +517,49 @@ namespace GMlib {
   PERBSSurf<T>::~PERBSSurf() {
 
     for( int i = 0; i < _c.getDim1(); i++ )
-      for( int j = 0; j < _c.getDim2(); j++ )
+      for( int j = 0; j < _c.getDim2(); j++ ) {
         SceneObject::remove( _c[i][j] );
+        if( _own_c ) delete _c[i][j];
+      }
+  }
 
-    delete _evaluator;
+
+  /*! PSurf<T,3>* PERBSSurf<T>::makeSnapshot() const
+   *
+   *  A copy of the knot vectors and snapshots of the local patches,
+   *  for a background resampling (see PSurf::setAsyncReplot()).
+   *  The local patches are not copied as children, so their children are not copied.
+   *
+   *  Classes derived from PERBSSurf get the copy made by makeCopy().
+   *
+   *  \return The copy, or nullptr if a local patch gives no snapshot
+   */
+  template <typename T>
+  PSurf<T,3>* PERBSSurf<T>::makeSnapshot() const {
+
+    if( typeid(*this) != typeid(PERBSSurf<T>) ) return PSurf<T,3>::makeSnapshot();
+
+    PERBSSurf<T>* surf = new PERBSSurf<T>( *this, false );
+    for( int i = 0; i < surf->_c.getDim1(); i++ )
+      for( int j = 0; j < surf->_c.getDim2(); j++ )
+        if( !surf->_c[i][j] ) {
+          delete surf;
+          return nullptr;
+        }
+    return surf;
   }
 
   template <typename T>
   inline
   void PERBSSurf<T>::edit( SceneObject* obj ) {
 
+    // New edit generation of the local patch, its samples in the fixed sampling grids are recomputed
+    if( _c_gen.getDim1() == _c.getDim1() && _c_gen.getDim2() == _c.getDim2() )
+      for( int i = 0; i < _c.getDim1(); i++ )
+        for( int j = 0; j < _c.getDim2(); j++ )
+          if( _c[i][j] == obj )
+            _c_gen[i][j]++;
+
     int i, j;
     for( i = 0; i < _c.getDim1()-1; i++ )
       for( j = 0; j < _c.getDim2()-1; j++ )
@@ -517,7 +572,26 @@ namespace GMlib {
     if( bezier )
       bezier->updateCoeffs( _c[i][j]->getPos() - _c[i][j]->evaluateParent( _u[i+1], _v[j+1], 0, 0 )[0][0] );
 
+    _editing = true;
     this->replot();
+    _editing = false;
+  }
+
+  /*! void PERBSSurf<T>::replot() const
+   *
+   *  As PSurf::replot(). A replot not made by edit() may follow any change of the
+   *  local patches, e.g. PBezierSurf::setControlPoints(), so all local patches get a
+   *  new edit generation, and are sampled again in the fixed sampling grids.
+   */
+  template <typename T>
+  void PERBSSurf<T>::replot() const {
+
+    if( !_editing )
+      for( int i = 0; i < _c_gen.getDim1(); i++ )
+        for( int j = 0; j < _c_gen.getDim2(); j++ )
+          _c_gen[i][j]++;
+
+    PSurf<T,3>::replot();
   }
 
 
@@ -575,17 +649,44 @@ namespace GMlib {
 
   template <typename T>
   inline
-  void PERBSSurf<T>::eval( T u, T v, int d1, int d2, bool lu, bool lv ) const {
+  void PERBSSurf<T>::evalSample( DMatrix<Vector<T,3>>& p, int i, int j, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+
+      // Fixed sampling grid, only the transformation of the local patch samples and the blending is left
+      if( _grid >= 0 ) {
+
+          const FixedGrid& g = _grids[_grid];
+          if( g.knot_v[j] ) {
+              getCGrid( p, g, i, j, 0 );
+              return;
+          }
 
+          DMatrix< Vector<T,3> > s0, s1;
+          getCGrid( s0, g, i, j, 0 );
+          getCGrid( s1, g, i, j, 1 );
 
-      if(this->_resample) {
-          int i = this->_ind[0];
-          int j = this->_ind[1];
+          // Same blending as below
+          const DVector<T>& B = g.rv(j).m;
+          DVector<T> a( B.getDim() );
+          s0 -= s1;
+          s0.transpose(); s1.transpose();
+          for( int i = 0; i <= d2; i++ ) {
 
+              a[i] = 1;
+              for( int j = i-1; j > 0; j-- )
+                  a[j] += a(j-1);
 
-          // Find Knot Indices u_k and v_k
-          int uk = _ru(i).ind;
-          int vk = _rv(j).ind;
+              for( int j = 0; j <= i; j++ )
+                  s1[i] += (a(j)*B(j)) * s0(i-j);
+          }
+          s1.transpose();
+
+          p = s1;
+          return;
+      }
+
+      // Find Knot Indices u_k and v_k
+      int uk = _ru(i).ind;
+      int vk = _rv(j).ind;
 
 //          if(this->isClosedU() && u > _u[_u.getDim()-3]) u -= getParDeltaU();
 //          if(this->isClosedV() && v > _v[_v.getDim()-3]) v -= (_v[_v.getDim()-2] - _v[1]);
@@ -594,47 +695,53 @@ namespace GMlib {
 //std::cout << "vk=" << vk << "(_u[uk], _v[vk])= (" << _u[uk] << ", " << _v[vk] << ") \t" ;
 
 //if(u == _u[4]) {std::cout << "\n****u= " << u << std::endl;}// u -= getParDeltaU();}
-          // Get result of inner loop for first patch in v
-          DMatrix< Vector<T,3> > s0 = getC( u, v, uk, vk, d1, d2 );
+      // Get result of inner loop for first patch in v
+      DMatrix< Vector<T,3> > s0 = getC( u, v, uk, vk, d1, d2, i );
 //std::cout << " s0= " << s0[0][0] << ", ";;
 
-          // If placed on a knot, return only first patch result
-          if( std::abs(v - _v(vk)) < 1e-5 ) {
-              this->_p = s0;
-//std::cout << "p= " << this->_p[0][0] << "  (knot)" << std::endl;
-              return;
-          }
-          else {    // Blend Patches
+      // If placed on a knot, return only first patch result
+      if( std::abs(v - _v(vk)) < 1e-5 ) {
+          p = s0;
+//std::cout << "p= " << p[0][0] << "  (knot)" << std::endl;
+          return;
+      }
+      else {    // Blend Patches
 
-              // Get result of inner loop for second patch in v
-              DMatrix< Vector<T,3> > s1 = getC( u, v, uk, vk+1, d1, d2 );
+          // Get result of inner loop for second patch in v
+          DMatrix< Vector<T,3> > s1 = getC( u, v, uk, vk+1, d1, d2, i );
 //std::cout << "s1= " << s1[0][0] << "  \t";
 
-              // Evaluate ERBS-basis in v direction
-              const DVector<T>& B = _rv(j).m;
-
-              // Compute "Pascals triangle"-numbers and correct patch matrix
-              DVector<T> a( B.getDim() );
-              s0 -= s1;
-              s0.transpose(); s1.transpose();
-              for( int i = 0; i <= d2; i++ ) {
+          // Evaluate ERBS-basis in v direction
+          const DVector<T>& B = _rv(j).m;
 
-                  a[i] = 1;
-                  for( int j = i-1; j > 0; j-- )
-                      a[j] += a(j-1);                           // Compute "Pascals triangle"-numbers
+          // Compute "Pascals triangle"-numbers and correct patch matrix
+          DVector<T> a( B.getDim() );
+          s0 -= s1;
+          s0.transpose(); s1.transpose();
+          for( int i = 0; i <= d2; i++ ) {
 
-                  for( int j = 0; j <= i; j++ )
-                      s1[i] += (a(j)*B(j)) * s0(i-j);       // "column += scalar x column"
-              }
-              s1.transpose();
+              a[i] = 1;
+              for( int j = i-1; j > 0; j-- )
+                  a[j] += a(j-1);                           // Compute "Pascals triangle"-numbers
 
-              this->_p = s1;
-//std::cout << "p= " << this->_p[0][0] << std::endl;
+              for( int j = 0; j <= i; j++ )
+                  s1[i] += (a(j)*B(j)) * s0(i-j);       // "column += scalar x column"
           }
+          s1.transpose();
+
+          p = s1;
+//std::cout << "p= " << p[0][0] << std::endl;
       }
+  }
 
 
 
+  template <typename T>
+  inline
+  void PERBSSurf<T>::eval( DMatrix<Vector<T,3>>& /*p*/, T /*u*/, T /*v*/, int /*d1*/, int /*d2*/, bool /*lu*/, bool /*lv*/ ) const {
+
+    // Only evaluated through the pre-evaluated basis when resampling, see evalSample()
+
 //    // Find Knot Indices u_k and v_k
 //    int uk, vk;
 //    for( uk = 1; uk < _u.getDim()-2; ++uk ) if( u < _u[uk+1] ) break;
@@ -705,7 +812,7 @@ namespace GMlib {
 
   template <typename T>
   inline
-  void PERBSSurf<T>::internalPreSample( DVector< PreVec > & p, const DVector<T>& t, int m, T start, T end ) {
+  void PERBSSurf<T>::internalPreSample( DVector< PreVec > & p, const DVector<T>& t, int m, T start, T end ) const {
 
     // compute dt (step in parameter)
     const T dt = ( end - start ) / T(m-1);
@@ -719,7 +826,7 @@ namespace GMlib {
 
         for(; i < t.getDim()-2; ++i ) if( s < t(i+1) ) break;
       //  if(i==t.getDim()-2) i--;
-        if( i== t.getDim()-2) while( std::abs( t(i) - t(i-1) ) < 1e-5 ) --i;
+        if( i== t.getDim()-2) while( std::abs( t(i+1) - t(i) ) < 1e-5 ) --i;
 
         p[j].ind = i;
         getB( p[j].m, t, i, start+dt*j, 2);
@@ -818,9 +925,9 @@ namespace GMlib {
   void PERBSSurf<T>::generateKnotVector( DVector<T>& t, const T sp, const T ep, int n, bool closed ) {
 
     if(closed) {
-        const T  dt = (ep-sp)/n;      // n- the number of intervalls (one extra between the last and the first)
-        t.setDim(n+3);
-        for(int i=0; i<n+3; i++ )
+        const T  dt = (ep-sp)/(n-1);  // (n-1)- is the number of intervalls (the last local patch is the first)
+        t.setDim(n+2);
+        for(int i=0; i<n+2; i++ )
             t[i] = sp + (i-1)*dt;     // Equal distance between all knots
     }
     else {
@@ -883,64 +990,256 @@ namespace GMlib {
 
   template <typename T>
   inline
-  void PERBSSurf<T>::getB( DVector<T>& B, const DVector<T>& kv, int tk, T t, int d ) {
+  void PERBSSurf<T>::getB( DVector<T>& B, const DVector<T>& kv, int tk, T t, int d ) const {
 
     B.setDim(d+1);
 
-    _evaluator->set( kv(tk), kv(tk+1) - kv(tk) );
-    B[0] = 1 - _evaluator->operator()(t);
-    B[1] = - _evaluator->getDer1();
-    B[2] = - _evaluator->getDer2();
+    long double b[3];
+    _evaluator->eval( b, t, kv(tk), kv(tk+1) - kv(tk), 2 );
+    B[0] = 1 - b[0];
+    B[1] = - b[1];
+    B[2] = - b[2];
   }
 
   template <typename T>
   inline
-  DMatrix< Vector<T,3> > PERBSSurf<T>::getC( T u, T v, int uk, int vk, T du, T dv ) const {
+  DMatrix< Vector<T,3> > PERBSSurf<T>::getC( T u, T v, int uk, int vk, int du, int dv, int iu ) const {
 
-      if(this->_resample) {
-          // Init Indexes and get local u/v values
-          const int cu = uk-1;
-          const int cv = vk-1;
+      // Init Indexes and get local u/v values
+      const int cu = uk-1;
+      const int cv = vk-1;
 
-          if(this->isClosedV() && cv == _v.getDim()-3) v -= this->getParDeltaV();
+      if(this->isClosedV() && cv == _v.getDim()-3) v -= this->getParDeltaV();
 
-          T dm = 0;
-          if(this->isClosedU() && u == _u[_u.getDim()-2]) dm = this->getParDeltaU();
+      T dm = 0;
+      if(this->isClosedU() && u == _u[_u.getDim()-2]) dm = this->getParDeltaU();
 
-          // Evaluate First local patch
-          DMatrix< Vector<T,3> > c0 = _c(cu)(cv)->evaluateParent(u-dm, v, du, dv);
-          // If on a interpolation point return only first patch evaluation
-          if( std::abs(u - _u(uk)) < 1e-5 ) {
+      // Evaluate First local patch
+      DMatrix< Vector<T,3> > c0;
+      _c(cu)(cv)->evaluateParent(c0, u-dm, v, du, dv);
+      // If on a interpolation point return only first patch evaluation
+      if( std::abs(u - _u(uk)) < 1e-5 ) {
 //std::cout << " knot-value: " << u << std::endl;
-              return c0;
-          }
-          // Select next local patch in u direction
+          return c0;
+      }
+      // Select next local patch in u direction
 
-          if(this->isClosedU() && cu == _u.getDim()-4) u -= this->getParDeltaU();
+      if(this->isClosedU() && cu == _u.getDim()-4) u -= this->getParDeltaU();
 
-          // Evaluate Second local patch
-          DMatrix< Vector<T,3> > c1 = _c(cu+1)(cv)->evaluateParent(u, v, du, dv);
+      // Evaluate Second local patch
+      DMatrix< Vector<T,3> > c1;
+      _c(cu+1)(cv)->evaluateParent(c1, u, v, du, dv);
 
-          DVector<T> a(du+1);
+      DVector<T> a(du+1);
 
-          // Evaluate ERBS-basis in u direction
-          const DVector<T>& B = _ru(uk).m;
+      // Evaluate ERBS-basis in u direction
+      const DVector<T>& B = _ru(iu).m;
 
-          // Compute "Pascals triangle"-numbers and correct patch matrix
-          c0 -= c1;
-          for( int i = 0; i < B.getDim(); i++ ) {
+      // Compute "Pascals triangle"-numbers and correct patch matrix
+      c0 -= c1;
+      for( int i = 0; i <= du; i++ ) {
 
-              a[i] = 1;
-              for( int j = i-1; j > 0; j-- )
-                  a[j] += a[j-1];
+          a[i] = 1;
+          for( int j = i-1; j > 0; j-- )
+              a[j] += a[j-1];
 
-              for( int j = 0; j <= i; j++ )
-                  c1[i] += (a(j) * B(j)) * c0(i-j);
+          for( int j = 0; j <= i; j++ )
+              c1[i] += (a(j) * B(j)) * c0(i-j);
+      }
+      return c1 ;
+  }
+
+  /*! FixedGrid& PERBSSurf<T>::getFixedGrid( int m1, int m2, int d1, int d2, T s_u, T s_v, T e_u, T e_v ) const
+   *
+   *  Returns the fixed sampling grid for the given sampling, it is made if it does not exist.
+   *  All grids are removed if the knot vectors or the local patches are changed.
+   *  The samples of a local patch are recomputed if it has a new edit generation.
+   */
+  template <typename T>
+  typename PERBSSurf<T>::FixedGrid& PERBSSurf<T>::getFixedGrid( int m1, int m2, int d1, int d2, T s_u, T s_v, T e_u, T e_v ) const {
+
+    bool same = _grid_u.getDim() == _u.getDim() && _grid_v.getDim() == _v.getDim() &&
+                _grid_c.getDim1() == _c.getDim1() && _grid_c.getDim2() == _c.getDim2();
+    for( int i = 0; same && i < _u.getDim(); i++ )  same = _grid_u(i) == _u(i);
+    for( int i = 0; same && i < _v.getDim(); i++ )  same = _grid_v(i) == _v(i);
+    for( int i = 0; same && i < _c.getDim1(); i++ )
+      for( int j = 0; same && j < _c.getDim2(); j++ )
+        same = _grid_c(i)(j) == _c(i)(j);
+
+    if( !same ) {
+      _grids.clear();
+      _grid_u = _u;
+      _grid_v = _v;
+      _grid_c = _c;
+      _c_gen.setDim( _c.getDim1(), _c.getDim2() );
+      for( int i = 0; i < _c.getDim1(); i++ )
+        for( int j = 0; j < _c.getDim2(); j++ )
+          _c_gen[i][j] = 1;
+    }
+
+    for( unsigned int k = 0; k < _grids.size(); k++ ) {
+      FixedGrid& g = _grids[k];
+      if( g.m[0] == m1 && g.m[1] == m2 && g.d[0] == d1 && g.d[1] == d2 &&
+          g.s[0] == s_u && g.s[1] == s_v && g.e[0] == e_u && g.e[1] == e_v ) {
+        sampleLocalPatches( g );
+        return g;
+      }
+    }
+
+    // A new grid, the number of grids is limited (one for each visualizer segment is the normal use)
+    if( _grids.size() >= 16 )
+      _grids.clear();
+
+    _grids.push_back( FixedGrid() );
+    FixedGrid& g = _grids.back();
+    g.m[0] = m1;  g.m[1] = m2;
+    g.d[0] = d1;  g.d[1] = d2;
+    g.s[0] = s_u; g.s[1] = s_v;
+    g.e[0] = e_u; g.e[1] = e_v;
+
+    internalPreSample( g.ru, _u, m1, s_u, e_u );
+    internalPreSample( g.rv, _v, m2, s_v, e_v );
+
+    // The parameter values in the local patches, as in evalSample() and getC()
+    const T du = (e_u-s_u)/(m1-1);
+    const T dv = (e_v-s_v)/(m2-1);
+
+    g.u[0].resize(m1);  g.u[1].resize(m1);  g.knot_u.resize(m1);
+    for( int i = 0; i < m1; i++ ) {
+      const T   u  = i < m1-1 ? s_u + i*du : e_u;
+      const int uk = g.ru(i).ind;
+      const int cu = uk-1;
+      g.u[0][i] = this->isClosedU() && u == _u[_u.getDim()-2] ? u - this->getParDeltaU() : u;
+      g.u[1][i] = this->isClosedU() && cu == _u.getDim()-4    ? u - this->getParDeltaU() : u;
+      g.knot_u[i] = std::abs(u - _u(uk)) < 1e-5;
+    }
+
+    g.v[0].resize(m2);  g.v[1].resize(m2);  g.knot_v.resize(m2);
+    for( int j = 0; j < m2; j++ ) {
+      const T   v  = j < m2-1 ? s_v + j*dv : e_v;
+      const int vk = g.rv(j).ind;
+      g.v[0][j] = this->isClosedV() && vk-1 == _v.getDim()-3 ? v - this->getParDeltaV() : v;
+      g.v[1][j] = this->isClosedV() && vk   == _v.getDim()-3 ? v - this->getParDeltaV() : v;
+      g.knot_v[j] = std::abs(v - _v(vk)) < 1e-5;
+    }
+
+    g.c.resize( size_t(m1) * m2 * 4 * (d1+1) * (d2+1) );
+    g.gen.setDim( _c.getDim1(), _c.getDim2() );
+    for( int i = 0; i < _c.getDim1(); i++ )
+      for( int j = 0; j < _c.getDim2(); j++ )
+        g.gen[i][j] = 0;      // Not sampled
+
+    sampleLocalPatches( g );
+    return g;
+  }
+
+  /*! void PERBSSurf<T>::sampleLocalPatches( FixedGrid& g ) const
+   *
+   *  Samples the local patches, in their own coordinates, on the part of the grid they cover.
+   *  Only local patches edited since they were sampled (new edit generation) are sampled.
+   *  For each grid point there are four samples, the local patches (cu,cv), (cu+1,cv), (cu,cv+1) and (cu+1,cv+1).
+   *  A moved local patch is not resampled, the samples are transformed by the local patch matrix when used.
+   */
+  template <typename T>
+  void PERBSSurf<T>::sampleLocalPatches( FixedGrid& g ) const {
+
+    bool dirty = false;
+    for( int i = 0; i < g.gen.getDim1(); i++ )
+      for( int j = 0; j < g.gen.getDim2(); j++ )
+        dirty |= g.gen(i)(j) != _c_gen(i)(j);
+    if( !dirty )
+      return;
+
+    const int m1 = g.m[0], m2 = g.m[1];
+    const int d1 = g.d[0], d2 = g.d[1];
+    const int s  = (d1+1)*(d2+1);
+
+    Parallel::forBlocks( 0, m1, [&]( int b, int e ) {
+      DMatrix< Vector<T,3> > q;
+      for( int i = b; i < e; i++ )
+        for( int j = 0; j < m2; j++ )
+          for( int r = 0; r < 4; r++ ) {
+
+            const int qu = r & 1;
+            const int qv = r >> 1;
+            if( ( qu && g.knot_u[i] ) || ( qv && g.knot_v[j] ) )
+              continue;     // Not used
+
+            const int cu = g.ru(i).ind - 1 + qu;
+            const int cv = g.rv(j).ind - 1 + qv;
+            if( g.gen(cu)(cv) == _c_gen(cu)(cv) )
+              continue;
+
+            _c(cu)(cv)->evaluate( q, g.u[qu][i], g.v[qv][j], d1, d2 );
+
+            Vector<T,3>* c = &g.c[ ( size_t(i*m2+j)*4 + r ) * s ];
+            for( int k = 0; k <= d1; k++ )
+              for( int l = 0; l <= d2; l++ )
+                *c++ = q[k][l];
           }
-          return c1 ;
+    }, this->getResampleThreads() );
+
+    g.gen = _c_gen;
+  }
+
+  /*! void PERBSSurf<T>::getLocalSample( DMatrix< Vector<T,3> >& p, const FixedGrid& g, int i, int j, int q, int cu, int cv ) const
+   *
+   *  A local patch sample from the grid, in the coordinates of the surface (as evaluateParent()).
+   */
+  template <typename T>
+  inline
+  void PERBSSurf<T>::getLocalSample( DMatrix< Vector<T,3> >& p, const FixedGrid& g, int i, int j, int q, int cu, int cv ) const {
+
+    const int d1 = g.d[0], d2 = g.d[1];
+    const HqMatrix<T,3> mat = _c(cu)(cv)->getMatrix().template toType<T>();
+    const Vector<T,3>* c = &g.c[ ( size_t(i*g.m[1]+j)*4 + q ) * (d1+1)*(d2+1) ];
+
+    p.setDim( d1+1, d2+1 );
+    p[0][0] = mat * c[0].toPoint();
+    for( int l = 1; l <= d2; l++ )
+      p[0][l] = mat * c[l];
+    for( int k = 1; k <= d1; k++ )
+      for( int l = 0; l <= d2; l++ )
+        p[k][l] = mat * c[k*(d2+1)+l];
+  }
+
+  /*! void PERBSSurf<T>::getCGrid( DMatrix< Vector<T,3> >& p, const FixedGrid& g, int i, int j, int r ) const
+   *
+   *  As getC(), but using the local patch samples of the grid.
+   *  r = 0 for the first and r = 1 for the second row of local patches.
+   */
+  template <typename T>
+  inline
+  void PERBSSurf<T>::getCGrid( DMatrix< Vector<T,3> >& p, const FixedGrid& g, int i, int j, int r ) const {
+
+      const int cu = g.ru(i).ind - 1;
+      const int cv = g.rv(j).ind - 1 + r;
+
+      if( g.knot_u[i] ) {
+          getLocalSample( p, g, i, j, 2*r, cu, cv );
+          return;
+      }
+
+      DMatrix< Vector<T,3> > c0;
+      getLocalSample( c0, g, i, j, 2*r,   cu,   cv );
+      getLocalSample( p,  g, i, j, 2*r+1, cu+1, cv );
+
+      DVector<T> a(g.d[0]+1);
+
+      // Evaluate ERBS-basis in u direction
+      const DVector<T>& B = g.ru(i).m;
+
+      // Compute "Pascals triangle"-numbers and correct patch matrix
+      c0 -= p;
+      for( int i = 0; i <= g.d[0]; i++ ) {
+
+          a[i] = 1;
+          for( int j = i-1; j > 0; j-- )
+              a[j] += a[j-1];
+
+          for( int j = 0; j <= i; j++ )
+              p[i] += (a(j) * B(j)) * c0(i-j);
       }
-      else
-      return DMatrix< Vector<T,3> >();
   }
 
   template <typename T>
@@ -1268,6 +1567,48 @@ namespace GMlib {
 //  }
 
 
+  /*! void PERBSSurf<T>::invalidateLocalSamples()
+   *
+   *  Removes all fixed sampling grids (GM_RESAMPLE_FIXED_GRID).
+   *  Must be used if the shape of a local patch is changed without edit() or replot(),
+   *  moving (and rotating) local patches does not require this.
+   */
+  template <typename T>
+  inline
+  void PERBSSurf<T>::invalidateLocalSamples() {
+
+    _grids.clear();
+  }
+
+  /*! void PERBSSurf<T>::resample( DSampleGrid<Vector<T,3>>& p, int m1, int m2, int d1, int d2, T s_u, T s_v, T e_u, T e_v ) const
+   *
+   *  As PSurf::resample().
+   *  In the GM_RESAMPLE_FIXED_GRID resample mode the ERBS basis values, the local parameter values
+   *  and the samples of the local patches (in their own coordinates) are computed once for each
+   *  sampling grid, and reused as long as the knot vectors are not changed.
+   *  Resampling is then a transformation of the local patch samples by the local patch matrices,
+   *  and the blending. The samples of a local patch are recomputed when it is edited (see edit()).
+   */
+  template <typename T>
+  void PERBSSurf<T>::resample( DSampleGrid<Vector<T,3>>& p, int m1, int m2, int d1, int d2, T s_u, T s_v, T e_u, T e_v ) const {
+
+    if( _resamp_mode != GM_RESAMPLE_FIXED_GRID || d1 > 2 || d2 > 2 ) {
+      PSurf<T,3>::resample( p, m1, m2, d1, d2, s_u, s_v, e_u, e_v );
+      return;
+    }
+
+    const FixedGrid& g = getFixedGrid( m1, m2, d1, d2, s_u, s_v, e_u, e_v );
+    _grid = int( &g - &_grids[0] );
+    PSurf<T,3>::resample( p, m1, m2, d1, d2, s_u, s_v, e_u, e_v );
+    _grid = -1;
+  }
+
+  /*! void PERBSSurf<T>::setResampleMode( GM_RESAMPLE_MODE mode )
+   *
+   *  GM_RESAMPLE_PREEVAL (the default) evaluates the local patches for every sample.
+   *  GM_RESAMPLE_FIXED_GRID reuses the local patch samples, see resample(). The shape of a
+   *  local patch must then be changed through edit(), or followed by replot() or invalidateLocalSamples().
+   */
   template <typename T>
   inline
   void PERBSSurf<T>::setResampleMode( GM_RESAMPLE_MODE mode ) {
@@ -1382,7 +1723,7 @@ namespace GMlib {
 
     // Insert new visualizers and replot
     Sphere<T,3>  s;
-    DMatrix< DMatrix< Vector<T,3> > > p;
+    DSampleGrid< Vector<T,3> > p;
     DMatrix< Vector<T,3> > normals;
 
     for( int i = 0; i < _pvi.getDim1(); ++i ) {
@@ -1412,18 +1753,18 @@ namespace GMlib {
 
         // Surrounding sphere
         if( i == 0 && j == 0 )
-          s.resetPos( p(0)(0)(0)(0) );
+          s.resetPos( p(0,0) );
         else
-          s += p(0)(0)(0)(0);
-
-        s += Point<T,3>( p( p.getDim1()-1 )( p.getDim2()-1 )(0)(0) );
-        s += Point<T,3>( p( p.getDim1()/2 )( p.getDim2()/2 )(0)(0) );
-        s += Point<T,3>( p( p.getDim1()-1 )( 0             )(0)(0) );
-        s += Point<T,3>( p( 0             )( p.getDim2()-1 )(0)(0) );
-        s += Point<T,3>( p( p.getDim1()-1 )( p.getDim2()/2 )(0)(0) );
-        s += Point<T,3>( p( p.getDim1()/2 )( p.getDim2()-1 )(0)(0) );
-        s += Point<T,3>( p( 0             )( p.getDim2()/2 )(0)(0) );
-        s += Point<T,3>( p( p.getDim1()/2 )( 0             )(0)(0) );
+          s += p(0,0);
+
+        s += Point<T,3>( p( p.getDim1()-1, p.getDim2()-1 ) );
+        s += Point<T,3>( p( p.getDim1()/2, p.getDim2()/2 ) );
+        s += Point<T,3>( p( p.getDim1()-1, 0 ) );
+        s += Point<T,3>( p( 0, p.getDim2()-1 ) );
+        s += Point<T,3>( p( p.getDim1()-1, p.getDim2()/2 ) );
+        s += Point<T,3>( p( p.getDim1()/2, p.getDim2()-1 ) );
+        s += Point<T,3>( p( 0, p.getDim2()/2 ) );
+        s += Point<T,3>( p( p.getDim1()/2, 0 ) );
       }
     }
 
@@ -1699,10 +2040,13 @@ namespace GMlib {
     this->_type_id = GM_SO_TYPE_SURFACE_ERBS;
     _closed_u   = closed_u;
     _closed_v   = closed_v;
-    _evaluator = new ERBSEvaluator<long double>();
+    _evaluator = ERBSEvaluator<long double>::getInstance();
 
     _resamp_mode = GM_RESAMPLE_PREEVAL;
     _pre_eval = true;
+    _grid = -1;
+    _editing = false;
+    _own_c   = false;
     _no_sam_u   = 20;
     _no_der_u   = 1;
     _no_sam_v   = 20;
@@ -82,6 +82,21 @@ namespace GMlib {
         DVector< T > m;
         int ind; };
 
+    struct FixedGrid { // Pre-evaluated data for one sampling grid (GM_RESAMPLE_FIXED_GRID)
+        int                       m[2];     //!< Number of samples in u and v
+        int                       d[2];     //!< Number of derivatives in u and v
+        T                         s[2];     //!< Start parameter values in u and v
+        T                         e[2];     //!< End parameter values in u and v
+        DVector< PreVec >         ru;       //!< Knot index and ERBS basis for each column
+        DVector< PreVec >         rv;       //!< Knot index and ERBS basis for each row
+        std::vector< T >          u[2];     //!< Parameter value in the first/second local patch for each column
+        std::vector< T >          v[2];     //!< Parameter value in the first/second local patch for each row
+        std::vector< char >       knot_u;   //!< Column is on a knot (only the first local patch is used)
+        std::vector< char >       knot_v;   //!< Row is on a knot (only the first local patch is used)
+        std::vector< Vector<T,3> > c;       //!< Local patch samples (in the local patch coordinates), 4 for each grid point
+        DMatrix< unsigned int >   gen;      //!< Edit generation of the local patch samples
+    };
+
   public:
     enum SURF_TYPE {
       SUB_SURF    = 0,
@@ -104,6 +119,7 @@ namespace GMlib {
     DVector<T>&                         getKnotsU();
     DVector<T>&                         getKnotsV();
     void                                setResampleMode( GM_RESAMPLE_MODE mode );
+    void                                invalidateLocalSamples();
 
     // Local patches
     DMatrix<PSurf<T,3>* >&              getLocalPatches();
@@ -128,10 +144,12 @@ namespace GMlib {
 
     // virtual functions from PSurf
     void                                edit( SceneObject *obj ) override;
+    void                                replot() const override;
     bool                                isClosedU() const override;
     bool                                isClosedV() const override;
 //    void                                preSample( int m1, int m2, int d1, int d2, T s_u, T s_v, T e_u, T e_v ) override;
     void                                sample(int m1 = 0, int m2 = 0, int d1 = 0, int d2 = 0) override;
+    PSurf<T,3>*                         makeSnapshot() const override;
 
   protected:
 
@@ -143,7 +161,7 @@ namespace GMlib {
     bool                                _closed_u;
     bool                                _closed_v;
 
-    ERBSEvaluator<long double>          *_evaluator;
+    const ERBSEvaluator<long double>    *_evaluator;  // Shared, read only
 
     DVector< PreVec >                   _ru;
     DVector< PreVec >                   _rv;
@@ -157,8 +175,23 @@ namespace GMlib {
     GM_RESAMPLE_MODE                    _resamp_mode;
     bool                                _pre_eval;
 
+    // Fixed sampling grids (GM_RESAMPLE_FIXED_GRID)
+    mutable std::vector< FixedGrid >    _grids;
+    mutable int                         _grid;       // The grid in use while resampling, -1 if none
+    mutable DVector<T>                  _grid_u;     // The knot vectors and local patches the grids are made for
+    mutable DVector<T>                  _grid_v;
+    mutable DMatrix< PSurf<T,3>* >      _grid_c;
+    mutable DMatrix< unsigned int >     _c_gen;      // Edit generation of each local patch, see edit()
+    bool                                _editing;    // In edit(), the edited local patch has a new edit generation
+    bool                                _own_c;      // The local patches are snapshots owned by this, see makeSnapshot()
+
+    using PSurf<T,3>::resample;
+    void                                resample( DSampleGrid<Vector<T,3>>& p, int m1, int m2, int d1, int d2,
+                                                  T s_u = T(0), T s_v = T(0), T e_u = T(0), T e_v = T(0) ) const override;
 
-    void	                            eval( T u, T v, int d1=0, int d2=0, bool lu=false, bool lv=false ) const override;
+
+    void	                            eval( DMatrix<Vector<T,3>>& p, T u, T v, int d1=0, int d2=0, bool lu=false, bool lv=false ) const override;
+    void                                evalSample( DMatrix<Vector<T,3>>& p, int i, int j, T u, T v, int d1, int d2, bool lu, bool lv ) const override;
     T                                   getStartPU() const override;
     T                                   getEndPU()   const override;
     T                                   getStartPV() const override;
@@ -167,13 +200,15 @@ namespace GMlib {
     void                                evalPre( T u, T v, int d1 = 0, int d2 = 0, bool lu = false, bool lv = false );
     void                                findIndex( T u, T v, int& iu, int& iv );
     void                                generateKnotVector( DVector<T>& kv, const T s, const T d, int kvd, bool closed );
-    void                                getB( DVector<T>& B, const DVector<T>& kv, int tk, T t, int d );
-    DMatrix< Vector<T,3> >              getC( T u, T v, int uk, int vk, T du, T dv ) const;
+    void                                getB( DVector<T>& B, const DVector<T>& kv, int tk, T t, int d ) const;
+    DMatrix< Vector<T,3> >              getC( T u, T v, int uk, int vk, int du, int dv, int iu ) const;
     DMatrix< Vector<T,3> >              getCPre( T u, T v, int uk, int vk, T du, T dv, int iu, int iv );
     void                                insertPatch( PSurf<T,3> *patch );
     void                                padKnotVector( DVector<T>& kv, bool closed );
 
   private:
+    PERBSSurf( const PERBSSurf<T>& copy, bool children );
+
     int                                 _no_sam_u;    // Number of samples u for single sampling
     int                                 _no_sam_v;    // Number of samples v for single sampling
 
@@ -191,7 +226,12 @@ namespace GMlib {
     // Help functions
     Point<T,2>                          mapToLocal( T u, T v, int uk, int vk ) const;
 
-    void                                internalPreSample( DVector< PreVec >& p, const DVector<T>& t, int m, T start, T end );
+    void                                internalPreSample( DVector< PreVec >& p, const DVector<T>& t, int m, T start, T end ) const;
+
+    FixedGrid&                          getFixedGrid( int m1, int m2, int d1, int d2, T s_u, T s_v, T e_u, T e_v ) const;
+    void                                sampleLocalPatches( FixedGrid& g ) const;
+    void                                getCGrid( DMatrix< Vector<T,3> >& p, const FixedGrid& g, int i, int j, int r ) const;
+    void                                getLocalSample( DMatrix< Vector<T,3> >& p, const FixedGrid& g, int i, int j, int q, int cu, int cv ) const;
 
     void                                init(bool closed_u, bool closed_v);
 
@@ -75,59 +75,59 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PHeart<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PHeart<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
 
-    this->_p[0][0][0] =	(T(4)*std::sqrt((T)(T(1) - u*u))*std::pow( (T)std::sin((T)std::abs(v)) , (T)std::abs(v)))*std::sin(v);
-    this->_p[0][0][1] =	(T(4)*std::sqrt((T)(T(1) - u*u))*std::pow( (T)std::sin((T)std::abs(v)) , (T)std::abs(v)))*std::cos(v);
-    this->_p[0][0][2] =	u;
+    p[0][0][0] =	(T(4)*std::sqrt((T)(T(1) - u*u))*std::pow( (T)std::sin((T)std::abs(v)) , (T)std::abs(v)))*std::sin(v);
+    p[0][0][1] =	(T(4)*std::sqrt((T)(T(1) - u*u))*std::pow( (T)std::sin((T)std::abs(v)) , (T)std::abs(v)))*std::cos(v);
+    p[0][0][2] =	u;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                      //u
-        this->_p[1][0][0] =	-T(4)*std::pow(std::sin(std::abs(v)),std::abs(v))*std::sin(v)*u/(std::sqrt(T(1)-u*u));
-        this->_p[1][0][1] =	-T(4)*std::pow(std::sin(std::abs(v)),std::abs(v))*std::cos(v)*u/(std::sqrt(T(1)-u*u));
-        this->_p[1][0][2] =	T(1);
+        p[1][0][0] =	-T(4)*std::pow(std::sin(std::abs(v)),std::abs(v))*std::sin(v)*u/(std::sqrt(T(1)-u*u));
+        p[1][0][1] =	-T(4)*std::pow(std::sin(std::abs(v)),std::abs(v))*std::cos(v)*u/(std::sqrt(T(1)-u*u));
+        p[1][0][2] =	T(1);
       }
       if(d1>1) {                    //uu
-        this->_p[2][0][0] =	T(0);
-        this->_p[2][0][1] =	T(0);
-        this->_p[2][0][2] =	T(0);
+        p[2][0][0] =	T(0);
+        p[2][0][1] =	T(0);
+        p[2][0][2] =	T(0);
       }
       if(d2) {                      //v
-        this->_p[0][1][0] =	T(4)*std::sqrt(T(1)-u*u)*std::pow(std::sin(std::abs(v)),std::abs(v))*(/*abs(1,v)*/log(std::sin(std::abs(v)))+std::abs(v)*std::cos(std::abs(v))
+        p[0][1][0] =	T(4)*std::sqrt(T(1)-u*u)*std::pow(std::sin(std::abs(v)),std::abs(v))*(/*abs(1,v)*/log(std::sin(std::abs(v)))+std::abs(v)*std::cos(std::abs(v))
                 /*abs(1,v)*//std::sin(std::abs(v)))*std::sin(v)+T(4)*std::sqrt(T(1)-u*u)*std::pow(std::sin(std::abs(v)),std::abs(v))*std::cos(v);
-        this->_p[0][1][1] =	T(4)*std::sqrt(T(1)-u*u)*std::pow(std::sin(std::abs(v)),std::abs(v))*(/*abs(1,v)*/log(std::sin(std::abs(v)))+std::abs(v)*std::cos(std::abs(v))
+        p[0][1][1] =	T(4)*std::sqrt(T(1)-u*u)*std::pow(std::sin(std::abs(v)),std::abs(v))*(/*abs(1,v)*/log(std::sin(std::abs(v)))+std::abs(v)*std::cos(std::abs(v))
                 /*abs(1,v)*//(std::abs(v)))*std::cos(v)-T(4)*std::sqrt(T(1)-u*u)*std::pow(std::sin(std::abs(v)),std::abs(v))*std::sin(v);
-        this->_p[0][1][2] =	T(0);
+        p[0][1][2] =	T(0);
       }
       if(d2>1) {                    //vv
-        this->_p[0][2][0] =	T(0);
-        this->_p[0][2][1] =	T(0);
-        this->_p[0][2][2] =	T(0);
+        p[0][2][0] =	T(0);
+        p[0][2][1] =	T(0);
+        p[0][2][2] =	T(0);
       }
       if(d1 && d2) {                //uv
-        this->_p[1][1][0] =	T(0);
-        this->_p[1][1][1] =	T(0);
-        this->_p[1][1][2] =	T(0);
+        p[1][1][0] =	T(0);
+        p[1][1][1] =	T(0);
+        p[1][1][2] =	T(0);
       }
       if(d1>1 && d2) {              //uuv
-        this->_p[2][1][0] =	T(0);
-        this->_p[2][1][1] =	T(0);
-        this->_p[2][1][2] =	T(0);
+        p[2][1][0] =	T(0);
+        p[2][1][1] =	T(0);
+        p[2][1][2] =	T(0);
       }
       if(d1 && d2>1) {              //uvv
-        this->_p[1][2][0] =	T(0);
-        this->_p[1][2][1] =	T(0);
-        this->_p[1][2][2] =	T(0);
+        p[1][2][0] =	T(0);
+        p[1][2][1] =	T(0);
+        p[1][2][2] =	T(0);
       }
       if(d1>1 && d2>1) {            //uuvv
-        this->_p[2][2][0] =	T(0);
-        this->_p[2][2][1] =	T(0);
-        this->_p[2][2][2] =	T(0);
+        p[2][2][0] =	T(0);
+        p[2][2][1] =	T(0);
+        p[2][2][2] =	T(0);
       }
     }
   }
@@ -163,7 +163,7 @@ bool PHermiteCurveSurf<T>::isClosedV() const {
 //*****************************************************
 
 template <typename T>
-void PHermiteCurveSurf<T>::eval(T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
+void PHermiteCurveSurf<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
   if(_swap_par)
   {
     std::swap(u,v);
@@ -174,7 +174,7 @@ void PHermiteCurveSurf<T>::eval(T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*
 
   for(int i=0; i< _cu.getSize(); i++)
   {
-    c[i] = _cu(i)->evaluateParent(v,d2);
+    _cu(i)->evaluateParent(c[i], v, d2);
 
 //    cout << "c["<< i << "]=" << c[i] << endl;
   }
@@ -182,10 +182,9 @@ void PHermiteCurveSurf<T>::eval(T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*
   DMatrix< T > hp; // Storing the Hermite Polynomials
   EvaluatorStatic<T>::evaluateH3d( hp, d1, u);
 
-  DMatrix< Vector<T,3> >   p = hp * c;
+  p = hp * c;
 
-  if(_swap_par) this->_p = p.transpose();
-  else          this->_p = p;
+  if(_swap_par) p.transpose();
 }
 
 
@@ -99,8 +99,8 @@ namespace GMlib {
 
   template <typename T>
   inline
-  void PHermiteSurf<T>::eval( T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
-    this->_p.setDim( d1+1, d2+1 );
+  void PHermiteSurf<T>::eval( DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+    p.setDim( d1+1, d2+1 );
 
     DMatrix<T> hu, hv;
     EvaluatorStatic<T>::evaluateH3d( hu, d1, u);
@@ -108,7 +108,7 @@ namespace GMlib {
 
     for( int i = 0; i < hu.getDim1(); i++ )
       for( int j = 0; j < hv.getDim1(); j++ )
-        this->_p[i][j] = hu(i) * ( _m^hv(j) );
+        p[i][j] = hu(i) * ( _m^hv(j) );
   }
 
 
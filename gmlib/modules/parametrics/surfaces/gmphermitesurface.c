@@ -133,102 +133,119 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PHermiteSurface<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/) const {
+  void PHermiteSurface<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/) const {
 
     // set result set dim
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     // vars
-    Point<float,3> p(0.0f);
+    Point<float,3> q(0.0f);
+    DVector<Vector<T,3>> c;
 
     // interpolate u in v direction
-    for( int i = 0; i < _c1.getSize(); i++ )
-      p += getH( _c2.getSize()/2, i, v ) * (_c1(i)->evaluateParent(u, 1))(0);
+    for( int i = 0; i < _c1.getSize(); i++ ) {
+      _c1(i)->evaluateParent(c, u, 1);
+      q += getH( _c2.getSize()/2, i, v ) * c(0);
+    }
 
     // interpolate v in u direction
-    for( int i = 0; i < _c2.getSize(); i++ )
-      p += getH( _c1.getSize()/2, i, u ) * (_c2(i)->evaluateParent(v, 1))(0);
+    for( int i = 0; i < _c2.getSize(); i++ ) {
+      _c2(i)->evaluateParent(c, v, 1);
+      q += getH( _c1.getSize()/2, i, u ) * c(0);
+    }
 
     // bi-linear interpolation
-    p -=
+    q -=
         _b(0)(0) * (1.0f - u) * (1.0f - v) +
         _b(0)(1) * (1.0f - u) * v +
         _b(1)(0) * u * (1.0f - v) +
         _b(1)(1) * u * v;
 
-    this->_p[0][0] = p;
+    p[0][0] = q;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if( d1 > 0 ) {    // Su
 
-        p = Point<float,3>(0.0f);
+        q = Point<float,3>(0.0f);
 
         // interpolate u in v direction
-        for( int i = 0; i < _c1.getSize(); i++ )
-          p += getH( _c2.getSize()/2, i, v ) * (_c1(i)->evaluateParent(u, 1))(1);
+        for( int i = 0; i < _c1.getSize(); i++ ) {
+          _c1(i)->evaluateParent(c, u, 1);
+          q += getH( _c2.getSize()/2, i, v ) * c(1);
+        }
 
         // interpolate v in u direction
-        for( int i = 0; i < _c2.getSize(); i++ )
-          p += getHder( _c1.getSize()/2, i, u ) * (_c2(i)->evaluateParent(v, 1))(0);
+        for( int i = 0; i < _c2.getSize(); i++ ) {
+          _c2(i)->evaluateParent(c, v, 1);
+          q += getHder( _c1.getSize()/2, i, u ) * c(0);
+        }
 
         // bi-linear interpolation
-        p -=
+        q -=
             _b(0)(0) * ( v - 1.0f ) +
             _b(0)(1) * ( -v ) +
             _b(1)(0) * (1.0f - v) +
             _b(1)(1) * v;
 
-        this->_p[1][0] = p;
+        p[1][0] = q;
       }
 
 
 
       if( d2 > 0 ) {    // Sv
 
-        p = Point<float,3>(0.0f);
+        q = Point<float,3>(0.0f);
 
         // interpolate u in v direction
-        for( int i = 0; i < _c1.getSize(); i++ )
-          p += getHder( _c2.getSize()/2, i, v ) * (_c1(i)->evaluateParent(u, 1))(0);
+        for( int i = 0; i < _c1.getSize(); i++ ) {
+          _c1(i)->evaluateParent(c, u, 1);
+          q += getHder( _c2.getSize()/2, i, v ) * c(0);
+        }
 
         // interpolate v in u direction
-        for( int i = 0; i < _c2.getSize(); i++ )
-          p += getH( _c1.getSize()/2, i, u ) * (_c2(i)->evaluateParent(v, 1))(1);
+        for( int i = 0; i < _c2.getSize(); i++ ) {
+          _c2(i)->evaluateParent(c, v, 1);
+          q += getH( _c1.getSize()/2, i, u ) * c(1);
+        }
 
         // bi-linear interpolation
-        p -=
+        q -=
             _b(0)(0) * (u - 1.0f) +
             _b(0)(1) * (1.0f - u) +
             _b(1)(0) * ( -u ) +
             _b(1)(1) * u;
 
-        this->_p[0][1] = p;
+        p[0][1] = q;
       }
 
 
 
       if( d1 > 0 && d2 > 0 ) {
 
-        p = Point<float,3>(0.0f);
+        q = Point<float,3>(0.0f);
 
         // interpolate u in v direction
-        for( int i = 0; i < _c1.getSize(); i++ )
-          p += getHder( _c2.getSize()/2, i, v ) * (_c1(i)->evaluateParent(u, 1))(1);
+        for( int i = 0; i < _c1.getSize(); i++ ) {
+          _c1(i)->evaluateParent(c, u, 1);
+          q += getHder( _c2.getSize()/2, i, v ) * c(1);
+        }
 
         // interpolate v in u direction
-        for( int i = 0; i < _c2.getSize(); i++ )
-          p += getHder( _c1.getSize()/2, i, u ) * (_c2(i)->evaluateParent(v, 1))(1);
+        for( int i = 0; i < _c2.getSize(); i++ ) {
+          _c2(i)->evaluateParent(c, v, 1);
+          q += getHder( _c1.getSize()/2, i, u ) * c(1);
+        }
 
         // bi-linear interpolation
-        p -=
+        q -=
             _b(0)(0) * (1.0f - u) * (1.0f - v) +
             _b(0)(1) * (1.0f - u) * v +
             _b(1)(0) * u * (1.0f - v) +
             _b(1)(1) * u * v;
 
-        this->_p[1][1] = p;
+        p[1][1] = q;
       }
     }
   }
@@ -80,56 +80,56 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PInsideOutTorus<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PInsideOutTorus<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
-    this->_p[0][0][0] =			cos(u)*(_b*cos(v)+_a);
-    this->_p[0][0][1] =			sin(u)*(_b*cos(v)+_a);
-    this->_p[0][0][2] =			_c*sin(v);
+    p[0][0][0] =			cos(u)*(_b*cos(v)+_a);
+    p[0][0][1] =			sin(u)*(_b*cos(v)+_a);
+    p[0][0][2] =			_c*sin(v);
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                          //u
-        this->_p[1][0][0] =		-sin(u)*(_b*cos(v)+_a);
-        this->_p[1][0][1] =		cos(u)*(_b*cos(v)+_a);
-        this->_p[1][0][2] =		T(0);
+        p[1][0][0] =		-sin(u)*(_b*cos(v)+_a);
+        p[1][0][1] =		cos(u)*(_b*cos(v)+_a);
+        p[1][0][2] =		T(0);
       }
       if(d1>1) {                        //uu
-        this->_p[2][0][0] =		-cos(u)*(_b*cos(v)+_a);
-        this->_p[2][0][1] =		-sin(u)*(_b*cos(v)+_a);
-        this->_p[2][0][2] =		T(0);
+        p[2][0][0] =		-cos(u)*(_b*cos(v)+_a);
+        p[2][0][1] =		-sin(u)*(_b*cos(v)+_a);
+        p[2][0][2] =		T(0);
       }
       if(d2) {                          //v
-        this->_p[0][1][0] =		-_b*cos(u)*sin(v);
-        this->_p[0][1][1] =		-_b*sin(u)*sin(v);
-        this->_p[0][1][2] =		_c*cos(v);
+        p[0][1][0] =		-_b*cos(u)*sin(v);
+        p[0][1][1] =		-_b*sin(u)*sin(v);
+        p[0][1][2] =		_c*cos(v);
       }
       if(d2>1) {                        //vv
-        this->_p[0][2][0] =		-_b*cos(u)*cos(v);
-        this->_p[0][2][1] =		-_b*sin(u)*cos(v);
-        this->_p[0][2][2] =		-_c*sin(v);
+        p[0][2][0] =		-_b*cos(u)*cos(v);
+        p[0][2][1] =		-_b*sin(u)*cos(v);
+        p[0][2][2] =		-_c*sin(v);
       }
       if(d1 && d2) {                    //uv
-        this->_p[1][1][0] =		_b*sin(u)*sin(v);
-        this->_p[1][1][1] =		-_b*cos(u)*sin(v);
-        this->_p[1][1][2] =		T(0);
+        p[1][1][0] =		_b*sin(u)*sin(v);
+        p[1][1][1] =		-_b*cos(u)*sin(v);
+        p[1][1][2] =		T(0);
       }
       if(d1>1 && d2) {                  //uuv
-        this->_p[2][1][0] =		_b*cos(u)*sin(v);
-        this->_p[2][1][1] =		_b*sin(u)*sin(v);
-        this->_p[2][1][2] =		T(0);
+        p[2][1][0] =		_b*cos(u)*sin(v);
+        p[2][1][1] =		_b*sin(u)*sin(v);
+        p[2][1][2] =		T(0);
       }
       if(d1 && d2>1) {                  //uvv
-        this->_p[1][2][0] =		_b*sin(u)*cos(v);
-        this->_p[1][2][1] =		-_b*cos(u)*cos(v);
-        this->_p[1][2][2] =		T(0);
+        p[1][2][0] =		_b*sin(u)*cos(v);
+        p[1][2][1] =		-_b*cos(u)*cos(v);
+        p[1][2][2] =		T(0);
       }
       if(d1>1 && d2>1) {                //uuvv
-        this->_p[2][2][0] =		_b*cos(u)*cos(v);
-        this->_p[2][2][1] =		_b*sin(u)*cos(v);
-        this->_p[2][2][2] =		T(0);
+        p[2][2][0] =		_b*cos(u)*cos(v);
+        p[2][2][1] =		_b*sin(u)*cos(v);
+        p[2][2][2] =		T(0);
       }
     }
   }
@@ -84,95 +84,95 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PKleinsBottle<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PKleinsBottle<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
 
-    if(u>=0.0 && u<=M_PI) this->_p[0][0][0] = _sx*cos(u)*(T(1)+sin(u))+_r*(T(1)-cos(u)*T(.5))*cos(u)*cos(v);
-    else				  this->_p[0][0][0] = _sx*cos(u)*(T(1)+sin(u))+_r*(T(1)-cos(u)*T(.5))*cos(v+M_PI);
-    if(u>=0.0 && u<=M_PI) this->_p[0][0][1] = _sy*sin(u)+_r*(T(1)-cos(u)*T(.5))*sin(u)*cos(v);
-    else				  this->_p[0][0][1] = _sy*sin(u);
-                this->_p[0][0][2] = _r*(T(1)-cos(u)*T(.5))*sin(v);
+    if(u>=0.0 && u<=M_PI) p[0][0][0] = _sx*cos(u)*(T(1)+sin(u))+_r*(T(1)-cos(u)*T(.5))*cos(u)*cos(v);
+    else				  p[0][0][0] = _sx*cos(u)*(T(1)+sin(u))+_r*(T(1)-cos(u)*T(.5))*cos(v+M_PI);
+    if(u>=0.0 && u<=M_PI) p[0][0][1] = _sy*sin(u)+_r*(T(1)-cos(u)*T(.5))*sin(u)*cos(v);
+    else				  p[0][0][1] = _sy*sin(u);
+                p[0][0][2] = _r*(T(1)-cos(u)*T(.5))*sin(v);
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1)	//u
       {
-        if(u>=0.0 && u<=M_PI) this->_p[1][0][0] = -_sx*sin(u)*T(1)-_sx+T(2)*_sx*cos(u)*cos(u)
+        if(u>=0.0 && u<=M_PI) p[1][0][0] = -_sx*sin(u)*T(1)-_sx+T(2)*_sx*cos(u)*cos(u)
                            +T(2)*_r*sin(u)*T(.5)*cos(u)*cos(v)-_r*sin(u)*cos(v)*T(1);
-        else				  this->_p[1][0][0] = -_sx*sin(u)*T(1)-_sx+T(2)*_sx*cos(u)*cos(u)
+        else				  p[1][0][0] = -_sx*sin(u)*T(1)-_sx+T(2)*_sx*cos(u)*cos(u)
                            +_r*sin(u)*T(.5)*cos(v+M_PI);
-        if(u>=0.0 && u<=M_PI) this->_p[1][0][1] = _sy*cos(u)+_r*T(.5)*cos(v)-T(2)*_r*cos(u)*cos(u)*cos(v)*T(.5)
+        if(u>=0.0 && u<=M_PI) p[1][0][1] = _sy*cos(u)+_r*T(.5)*cos(v)-T(2)*_r*cos(u)*cos(u)*cos(v)*T(.5)
                            +_r*cos(u)*cos(v)*T(1);
-        else				  this->_p[1][0][1] = _sy*cos(u);
-                    this->_p[1][0][2] = _r*sin(u)*T(.5)*sin(v);
+        else				  p[1][0][1] = _sy*cos(u);
+                    p[1][0][2] = _r*sin(u)*T(.5)*sin(v);
       }
 
       if(d1>1)//uu
       {
-        if(u>=0.0 && u<=M_PI) this->_p[2][0][0] = -_sx*cos(u)*T(1)-T(4)*_sx*sin(u)*cos(u)+T(4)*_r*cos(u)*cos(u)*T(.5)*cos(v)
+        if(u>=0.0 && u<=M_PI) p[2][0][0] = -_sx*cos(u)*T(1)-T(4)*_sx*sin(u)*cos(u)+T(4)*_r*cos(u)*cos(u)*T(.5)*cos(v)
                            -T(2)*_r*T(.5)*cos(v)-_r*cos(u)*cos(v)*T(1);
-        else				  this->_p[2][0][0] = -cos(u)*(_sx*T(1)+T(4)*_sx*sin(u)-_r*T(.5)*cos(v+M_PI));
-        if(u>=0.0 && u<=M_PI) this->_p[2][0][1] = -sin(u)*(_sy-T(4)*_r*cos(v)*cos(u)*T(.5)+_r*cos(v)*T(1));
-        else				  this->_p[2][0][1] = -_sy*sin(u);
-                    this->_p[2][0][2] = _r*cos(u)*T(.5)*sin(v);
+        else				  p[2][0][0] = -cos(u)*(_sx*T(1)+T(4)*_sx*sin(u)-_r*T(.5)*cos(v+M_PI));
+        if(u>=0.0 && u<=M_PI) p[2][0][1] = -sin(u)*(_sy-T(4)*_r*cos(v)*cos(u)*T(.5)+_r*cos(v)*T(1));
+        else				  p[2][0][1] = -_sy*sin(u);
+                    p[2][0][2] = _r*cos(u)*T(.5)*sin(v);
       }
 
       if(d2)	//v
       {
-        if(u>=0.0 && u<=M_PI) this->_p[0][1][0] = -_r*(T(1)-cos(u)*T(.5))*cos(u)*sin(v);
-        else				  this->_p[0][1][0] = -_r*(T(1)-cos(u)*T(.5))*sin(v+M_PI);
-        if(u>=0.0 && u<=M_PI) this->_p[0][1][1] = -_r*(T(1)-cos(u)*T(.5))*sin(u)*sin(v);
-        else				  this->_p[0][1][1] = T(0);
-                    this->_p[0][1][2] = _r*(T(1)-cos(u)*T(.5))*cos(v);
+        if(u>=0.0 && u<=M_PI) p[0][1][0] = -_r*(T(1)-cos(u)*T(.5))*cos(u)*sin(v);
+        else				  p[0][1][0] = -_r*(T(1)-cos(u)*T(.5))*sin(v+M_PI);
+        if(u>=0.0 && u<=M_PI) p[0][1][1] = -_r*(T(1)-cos(u)*T(.5))*sin(u)*sin(v);
+        else				  p[0][1][1] = T(0);
+                    p[0][1][2] = _r*(T(1)-cos(u)*T(.5))*cos(v);
 
       }
 
       if(d2>1) //vv
       {
-        if(u>=0.0 && u<=M_PI) this->_p[0][2][0] = -_r*(T(1)-cos(u)*T(.5))*cos(u)*cos(v);
-        else				  this->_p[0][2][0] = _r*(-T(1)+cos(u)*T(.5))*cos(v+M_PI);
-        if(u>=0.0 && u<=M_PI) this->_p[0][2][1] = -_r*(T(1)-cos(u)*T(.5))*sin(u)*cos(v);
-        else				  this->_p[0][2][1] = T(0);
-                    this->_p[0][2][2] = _r*(-T(1)+cos(u)*T(.5))*sin(v);
+        if(u>=0.0 && u<=M_PI) p[0][2][0] = -_r*(T(1)-cos(u)*T(.5))*cos(u)*cos(v);
+        else				  p[0][2][0] = _r*(-T(1)+cos(u)*T(.5))*cos(v+M_PI);
+        if(u>=0.0 && u<=M_PI) p[0][2][1] = -_r*(T(1)-cos(u)*T(.5))*sin(u)*cos(v);
+        else				  p[0][2][1] = T(0);
+                    p[0][2][2] = _r*(-T(1)+cos(u)*T(.5))*sin(v);
       }
 
       if(d1 && d2) //uv
       {
-        if(u>=0.0 && u<=M_PI) this->_p[1][1][0] = -_r*sin(u)*sin(v)*(T(2)*cos(u)*T(.5)-T(1));
-        else				  this->_p[1][1][0] = -_r*sin(u)*T(.5)*sin(v+M_PI);
-        if(u>=0.0 && u<=M_PI) this->_p[1][1][1] = _r*sin(v)*(-T(.5)+cos(u)*cos(u)-cos(u));
-        else				  this->_p[1][1][1] = T(0);
-                    this->_p[1][1][2] = _r*sin(u)*T(.5)*cos(v);
+        if(u>=0.0 && u<=M_PI) p[1][1][0] = -_r*sin(u)*sin(v)*(T(2)*cos(u)*T(.5)-T(1));
+        else				  p[1][1][0] = -_r*sin(u)*T(.5)*sin(v+M_PI);
+        if(u>=0.0 && u<=M_PI) p[1][1][1] = _r*sin(v)*(-T(.5)+cos(u)*cos(u)-cos(u));
+        else				  p[1][1][1] = T(0);
+                    p[1][1][2] = _r*sin(u)*T(.5)*cos(v);
       }
 
       if(d1>1 && d2)//uuv
       {
-        if(u>=0.0 && u<=M_PI) this->_p[2][1][0] = -_r*sin(v)*(T(2)*cos(u)*cos(u)-2.0*T(.5)-cos(u));
-        else				  this->_p[2][1][0] = -_r*cos(u)*T(.5)*sin(v+M_PI);
-        if(u>=0.0 && u<=M_PI) this->_p[2][1][1] = -_r*sin(u)*sin(v)*(T(2)*cos(u)-T(1));
-        else				  this->_p[2][1][1] = T(0);
-                    this->_p[2][1][2] =  _r*cos(u)*T(.5)*cos(v);
+        if(u>=0.0 && u<=M_PI) p[2][1][0] = -_r*sin(v)*(T(2)*cos(u)*cos(u)-2.0*T(.5)-cos(u));
+        else				  p[2][1][0] = -_r*cos(u)*T(.5)*sin(v+M_PI);
+        if(u>=0.0 && u<=M_PI) p[2][1][1] = -_r*sin(u)*sin(v)*(T(2)*cos(u)-T(1));
+        else				  p[2][1][1] = T(0);
+                    p[2][1][2] =  _r*cos(u)*T(.5)*cos(v);
       }
 
       if(d1 && d2>1) //uvv
       {
-        if(u>=0.0 && u<=M_PI) this->_p[1][2][0] = -_r*sin(u)*cos(v)*(cos(u)-T(1));
-        else				  this->_p[1][2][0] = -_r*sin(u)*T(.5)*cos(v+M_PI);
-        if(u>=0.0 && u<=M_PI) this->_p[1][2][1] = _r*cos(v)*(-T(.5)+cos(u)*cos(u)-cos(u));
-        else				  this->_p[1][2][1] = T(0);
-                    this->_p[1][2][2] = -_r*sin(u)*T(.5)*sin(v);
+        if(u>=0.0 && u<=M_PI) p[1][2][0] = -_r*sin(u)*cos(v)*(cos(u)-T(1));
+        else				  p[1][2][0] = -_r*sin(u)*T(.5)*cos(v+M_PI);
+        if(u>=0.0 && u<=M_PI) p[1][2][1] = _r*cos(v)*(-T(.5)+cos(u)*cos(u)-cos(u));
+        else				  p[1][2][1] = T(0);
+                    p[1][2][2] = -_r*sin(u)*T(.5)*sin(v);
       }
 
       if(d1>1 && d2>1) //uuvv
       {
-        if(u>=0.0 && u<=M_PI) this->_p[2][2][0] = -_r*cos(v)*(T(2)*cos(u)*cos(u)-T(1)-cos(u));
-        else				  this->_p[2][2][0] = -_r*cos(u)*T(.5)*cos(v+M_PI);
-        if(u>=0.0 && u<=M_PI) this->_p[2][2][1] = -_r*sin(u)*cos(v)*(T(2)*cos(u)-T(1));
-        else				  this->_p[2][2][1] = T(0);
-                    this->_p[2][2][2] = -_r*cos(u)*T(.5)*sin(v);
+        if(u>=0.0 && u<=M_PI) p[2][2][0] = -_r*cos(v)*(T(2)*cos(u)*cos(u)-T(1)-cos(u));
+        else				  p[2][2][0] = -_r*cos(u)*T(.5)*cos(v+M_PI);
+        if(u>=0.0 && u<=M_PI) p[2][2][1] = -_r*sin(u)*cos(v)*(T(2)*cos(u)-T(1));
+        else				  p[2][2][1] = T(0);
+                    p[2][2][2] = -_r*cos(u)*T(.5)*sin(v);
 
       }
     }
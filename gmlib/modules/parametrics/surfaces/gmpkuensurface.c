@@ -78,31 +78,31 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PKuenSurface<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PKuenSurface<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
 
-    this->_p[0][0][0] =	T(2)*_r*(cos(u)+u*sin(u))*sin(v)/(T(1)+u*u*sin(v)*sin(v));
-    this->_p[0][0][1] =	T(2)*_r*(sin(u)-u*cos(u))*sin(v)/(T(1)+u*u*sin(v)*sin(v));
-    this->_p[0][0][2] =	_r*(log(tan(v/T(2)))+T(2)*cos(v)/(T(1)+u*u*sin(v)*sin(v)));
+    p[0][0][0] =	T(2)*_r*(cos(u)+u*sin(u))*sin(v)/(T(1)+u*u*sin(v)*sin(v));
+    p[0][0][1] =	T(2)*_r*(sin(u)-u*cos(u))*sin(v)/(T(1)+u*u*sin(v)*sin(v));
+    p[0][0][2] =	_r*(log(tan(v/T(2)))+T(2)*cos(v)/(T(1)+u*u*sin(v)*sin(v)));
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) //u
       {
-        this->_p[1][0][0] =	T(2)*_r*u*sin(v)*(cos(u)+cos(u)*u*u-cos(u)*u*u*cos(v)*cos(v)
+        p[1][0][0] =	T(2)*_r*u*sin(v)*(cos(u)+cos(u)*u*u-cos(u)*u*u*cos(v)*cos(v)
                 -T(2)*cos(u)+T(2)*cos(u)*cos(v)*cos(v)-T(2)*u*sin(u)+T(2)*u*sin(u)*cos(v)*cos(v))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(2));
-        this->_p[1][0][1] =	-T(T(2))*_r*u*sin(v)*(-sin(u)-sin(u)*u*u+sin(u)*u*u*cos(v)*cos(v)
+        p[1][0][1] =	-T(T(2))*_r*u*sin(v)*(-sin(u)-sin(u)*u*u+sin(u)*u*u*cos(v)*cos(v)
                 +T(2)*sin(u)-T(2)*sin(u)*cos(v)*cos(v)-T(2)*u*cos(u)+T(2)*u*cos(u)*cos(v)*cos(v))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(2));
-        this->_p[1][0][2] =	T(2)*_r*T(T(2))*cos(v)*u*(-1.0+cos(v)*cos(v))/pow((T)T(1.0)+u*u*sin(v)*sin(v),T(2));
+        p[1][0][2] =	T(2)*_r*T(T(2))*cos(v)*u*(-1.0+cos(v)*cos(v))/pow((T)T(1.0)+u*u*sin(v)*sin(v),T(2));
       }
       if(d1>1)//uu
       {
-        this->_p[2][0][0] =	-T(2)*_r*sin(v)*(-cos(u)+T(2)*cos(u)*u*u-T(2)*cos(u)*u*u*cos(v)*cos(v)
+        p[2][0][0] =	-T(2)*_r*sin(v)*(-cos(u)+T(2)*cos(u)*u*u-T(2)*cos(u)*u*u*cos(v)*cos(v)
                 +3.0*cos(u)*u*u*u*u-6.0*cos(u)*u*u*u*u*cos(v)*cos(v)+3.0*cos(u)*u*u*u*u*pow((T)cos(v),T(4))
                 +u*sin(u)+T(2)*u*u*u*sin(u)-T(2)*u*u*u*sin(u)*cos(v)*cos(v)
                 +u*u*u*u*u*sin(u)-T(2)*u*u*u*u*u*sin(u)*cos(v)*cos(v)+u*u*u*u*u*sin(u)*pow((T)cos(v),T(4))
@@ -110,7 +110,7 @@ namespace GMlib {
                 +T(12)*u*u*u*sin(u)*cos(v)*cos(v)-6.0*u*u*u*sin(u)*pow((T)cos(v),T(4))+T(2)*cos(u)
                 -T(2)*cos(u)*cos(v)*cos(v)+T(2)*u*sin(u)-T(2)*u*sin(u)*cos(v)*cos(v))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(3));
-        this->_p[2][0][1] =	-T(2)*_r*sin(v)*(-sin(u)*pow(T(1.0),T(2))+T(2)*sin(u)*u*u-T(2)*sin(u)*u*u*cos(v)*cos(v)
+        p[2][0][1] =	-T(2)*_r*sin(v)*(-sin(u)*pow(T(1.0),T(2))+T(2)*sin(u)*u*u-T(2)*sin(u)*u*u*cos(v)*cos(v)
                 +3.0*sin(u)*u*u*u*u-6.0*sin(u)*u*u*u*u*cos(v)*cos(v)+3.0*sin(u)*u*u*u*u*pow((T)cos(v),T(4))
                 -u*cos(u)*pow(T(1.0),T(2))-T(2)*u*u*u*cos(u)+T(2)*u*u*u*cos(u)*cos(v)*cos(v)
                 -u*u*u*u*u*cos(u)+T(2)*u*u*u*u*u*cos(u)*cos(v)*cos(v)-u*u*u*u*u*cos(u)*pow((T)cos(v),T(4))
@@ -118,16 +118,16 @@ namespace GMlib {
                 -T(12)*u*u*u*cos(u)*cos(v)*cos(v)+6.0*u*u*u*cos(u)*pow((T)cos(v),T(4))+T(2)*sin(u)
                 -T(2)*sin(u)*cos(v)*cos(v)-T(2)*u*cos(u)+T(2)*u*cos(u)*cos(v)*cos(v))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(3));
-        this->_p[2][0][2] =	T(2)*_r*T(2)*cos(v)*(-1.0+cos(v)*cos(v))*(-3.0*u*u+3.0*u*u*cos(v)*cos(v)+T(1.0))
+        p[2][0][2] =	T(2)*_r*T(2)*cos(v)*(-1.0+cos(v)*cos(v))*(-3.0*u*u+3.0*u*u*cos(v)*cos(v)+T(1.0))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(3));
       }
       if(d2) //v
       {
-        this->_p[0][1][0] =	T(T(2))*_r*(cos(u)+u*sin(u))*cos(v)*(T(1.0)-u*u+u*u*cos(v)*cos(v))
+        p[0][1][0] =	T(T(2))*_r*(cos(u)+u*sin(u))*cos(v)*(T(1.0)-u*u+u*u*cos(v)*cos(v))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(2));
-        this->_p[0][1][1] =	T(T(2))*_r*(sin(u)-u*cos(u))*cos(v)*(T(1.0)-u*u+u*u*cos(v)*cos(v))
+        p[0][1][1] =	T(T(2))*_r*(sin(u)-u*cos(u))*cos(v)*(T(1.0)-u*u+u*u*cos(v)*cos(v))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(2));
-        this->_p[0][1][2] =	-_r*(-T(1)-T(2)*u*u+T(2)*u*u*cos(v)*cos(v)
+        p[0][1][2] =	-_r*(-T(1)-T(2)*u*u+T(2)*u*u*cos(v)*cos(v)
                 -u*u*u*u+T(2)*u*u*u*u*cos(v)*cos(v)-u*u*u*u*pow((T)cos(v),T(4))
                 +pow(T(T(2)),T(2))*sin(v)*cos(T(.5)*v)*sin(T(.5)*v)
                 +pow(T(T(2)),T(2))*sin(v)*cos(T(.5)*v)*sin(T(.5)*v)*u*u
@@ -136,9 +136,9 @@ namespace GMlib {
       }
       if(d2>1) //vv
       {
-        this->_p[0][2][0] =	-T(2.0)*_r*(cos(u)+u*sin(u))*sin(v)*(T(1)-u*u*u*u+u*u*u*u*pow((T)cos(v),T(4))
+        p[0][2][0] =	-T(2.0)*_r*(cos(u)+u*sin(u))*sin(v)*(T(1)-u*u*u*u+u*u*u*u*pow((T)cos(v),T(4))
                 +6.0*u*u*cos(v)*cos(v))/pow((T)T(1.0)+u*u*sin(v)*sin(v),T(3));
-        this->_p[0][2][1] =	-T(2.0)*_r*(sin(u)-u*cos(u))*sin(v)*(T(1)-u*u*u*u+u*u*u*u*pow((T)cos(v),T(4))
+        p[0][2][1] =	-T(2.0)*_r*(sin(u)-u*cos(u))*sin(v)*(T(1)-u*u*u*u+u*u*u*u*pow((T)cos(v),T(4))
                 +6.0*u*u*cos(v)*cos(v))/pow((T)T(1.0)+u*u*sin(v)*sin(v),T(3));
 
             T s6 =	3.0*u*u*u*u*pow((T)cos(v),T(4))+6.0*u*u*u*u*u*u*cos(T(.5)*v)*cos(T(.5)*v)*cos(v)*cos(v)
@@ -167,23 +167,23 @@ namespace GMlib {
             T s2 =	1/cos(T(.5)*v)*cos(T(.5)*v)/T(4)/(-1.0+cos(T(.5)*v)*cos(T(.5)*v))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(3));
 
-        this->_p[0][2][2] =	-s3*s2;
+        p[0][2][2] =	-s3*s2;
       }
       if(d1 && d2) //uv
       {
-        this->_p[1][1][0] =	T(2.0)*_r*u*cos(v)*(cos(u)-cos(u)*u*u*u*u+2.0*cos(u)*u*u*u*u*cos(v)*cos(v)
+        p[1][1][0] =	T(2.0)*_r*u*cos(v)*(cos(u)-cos(u)*u*u*u*u+2.0*cos(u)*u*u*u*u*cos(v)*cos(v)
                 -cos(u)*u*u*u*u*pow((T)cos(v),T(4))-6.0*cos(u)+6.0*cos(u)*cos(v)*cos(v)
                 +2.0*u*u*cos(u)-4.0*u*u*cos(u)*cos(v)*cos(v)+2.0*u*u*cos(u)*pow((T)cos(v),T(4))
                 -6.0*u*sin(u)+6.0*u*sin(u)*cos(v)*cos(v)+2.0*u*u*u*sin(u)
                 -4.0*u*u*u*sin(u)*cos(v)*cos(v)+2.0*u*u*u*sin(u)*pow((T)cos(v),T(4)))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(3));
-        this->_p[1][1][1] =	-T(2.0)*_r*u*cos(v)*(-sin(u)+sin(u)*u*u*u*u-2.0*sin(u)*u*u*u*u*cos(v)*cos(v)
+        p[1][1][1] =	-T(2.0)*_r*u*cos(v)*(-sin(u)+sin(u)*u*u*u*u-2.0*sin(u)*u*u*u*u*cos(v)*cos(v)
                 +sin(u)*u*u*u*u*pow((T)cos(v),T(4))+6.0*sin(u)-6.0*sin(u)*cos(v)*cos(v)
                 -2.0*u*u*sin(u)+4.0*u*u*sin(u)*cos(v)*cos(v)-2.0*u*u*sin(u)*pow((T)cos(v),T(4))
                 -6.0*u*cos(u)+6.0*u*cos(u)*cos(v)*cos(v)+2.0*u*u*u*cos(u)
                 -4.0*u*u*u*cos(u)*cos(v)*cos(v)+2.0*u*u*u*cos(u)*pow((T)cos(v),T(4)))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(3));
-        this->_p[1][1][2] =	-2.0*_r*T(2.0)*sin(v)*u*(-T(1.0)+3.0*cos(v)*cos(v)-u*u+u*u*pow((T)cos(v),T(4)))
+        p[1][1][2] =	-2.0*_r*T(2.0)*sin(v)*u*(-T(1.0)+3.0*cos(v)*cos(v)-u*u+u*u*pow((T)cos(v),T(4)))
                 /pow((T)T(1.0)+u*u*sin(v)*sin(v),T(3));
 
       }
@@ -214,7 +214,7 @@ namespace GMlib {
 
         //s2 = cos(v)*s5*s6;
 
-        this->_p[2][1][0] =	T(2.0)*_r*cos(v)*s5*s6;
+        p[2][1][0] =	T(2.0)*_r*cos(v)*s5*s6;
 
         //  s1 = T(2.0)*_r;
         //  s3 = cos(v);
@@ -239,18 +239,18 @@ namespace GMlib {
       //	s4 = ;
           //s2 = cos(v)*s4;
          // t0 =
-        this->_p[2][1][1] =	T(2.0)*_r*cos(v)*s5*s6;
+        p[2][1][1] =	T(2.0)*_r*cos(v)*s5*s6;
 
 
 
-        this->_p[2][1][2] =	-2.0*_r*T(2.0)*sin(v)*(2.0*u*u-20.0*u*u*cos(v)*cos(v)
+        p[2][1][2] =	-2.0*_r*T(2.0)*sin(v)*(2.0*u*u-20.0*u*u*cos(v)*cos(v)
                 +18.0*u*u*pow((T)cos(v),T(4))+3.0*u*u*u*u-3.0*u*u*u*u*cos(v)*cos(v)
                 -3.0*u*u*u*u*pow((T)cos(v),T(4))+3.0*u*u*u*u*pow((T)cos(v),T(6))-T(1)+3.0
                 *cos(v)*cos(v))/pow((T)T(1)+u*u*pow((T)sin(v),T(2)),T(4));
       }
       if(d1 && d2>1) //uvv
       {
-        this->_p[1][2][0] = -T(2.0)*_r*u*sin(v)*(cos(u)-6.0*cos(u)-2.0*cos(u)*u*u*u*u*pow((T)cos(v),T(4))
+        p[1][2][0] = -T(2.0)*_r*u*sin(v)*(cos(u)-6.0*cos(u)-2.0*cos(u)*u*u*u*u*pow((T)cos(v),T(4))
                 +2.0*cos(u)*u*u*u*u-cos(u)*u*u*u*u*u*u+2.0*u*u*u*u*u*sin(u)+18.0*u*sin(u)*cos(v)*cos(v)
                 +6.0*cos(u)*u*u*u*u*cos(v)*cos(v)-5.0*cos(u)*u*u*u*u*pow((T)cos(v),T(4))
                 +5.0*cos(u)*u*u*cos(v)*cos(v)-24.0*u*u*cos(u)*cos(v)*cos(v)+28.0*u*u*cos(u)
@@ -262,7 +262,7 @@ namespace GMlib {
                 -4.0*u*u*cos(u)-4.0*u*u*u*sin(u)-cos(u)*u*u*u*u+cos(u)*u*u
                 -6.0*u*sin(u))/pow((T)T(1)+u*u*pow((T)sin(v),T(2)),T(4));
 
-        this->_p[1][2][1] =	T(2.0)*_r*u*sin(v)*(5.0*sin(u)*u*u*u*u*pow((T)cos(v),T(4))+18.0*u*cos(u)
+        p[1][2][1] =	T(2.0)*_r*u*sin(v)*(5.0*sin(u)*u*u*u*u*pow((T)cos(v),T(4))+18.0*u*cos(u)
                 *cos(v)*cos(v)-5.0*sin(u)*u*u*cos(v)*cos(v)-6.0*sin(u)*u*u*u*u*cos(v)*cos(v)
                 -28.0*u*u*sin(u)*pow((T)cos(v),T(4))+24.0*u*u*sin(u)*cos(v)*cos(v)
                 +sin(u)*u*u*u*u*u*u+28.0*u*u*u*cos(u)*pow((T)cos(v),T(4))-6.0*u*cos(u)
@@ -275,7 +275,7 @@ namespace GMlib {
                 /pow((T)T(1)+u*u*pow((T)sin(v),T(2)),T(4));
 
 
-        this->_p[1][2][2] =	-2.0*_r*T(2.0)*cos(v)*u*(-7.0+9.0*cos(v)*cos(v)-2.0*u*u
+        p[1][2][2] =	-2.0*_r*T(2.0)*cos(v)*u*(-7.0+9.0*cos(v)*cos(v)-2.0*u*u
                 -12.0*u*u*cos(v)*cos(v)+14.0*u*u*pow((T)cos(v),T(4))+5.0*u*u*u*u-9.0*u*u*u*u
                 *cos(v)*cos(v)+3.0*u*u*u*u*pow((T)cos(v),T(4))+u*u*u*u*pow((T)cos(v),T(6)))
                 /pow((T)T(1)+u*u*pow((T)sin(v),T(2)),T(4));
@@ -309,7 +309,7 @@ namespace GMlib {
 
           s6 = 1/(pow((T)T(1.0)+u*u*pow((T)sin(v),T(2)),T(5)));
 
-        this->_p[2][2][0] =	T(2.0)*_r*sin(v)*s5*s6;
+        p[2][2][0] =	T(2.0)*_r*sin(v)*s5*s6;
 
         // s1 = -T(2.0)*_r;      s3 = sin(v);
           s6 = -270.0*sin(u)*u*u*u*u*pow((T)cos(v),T(4))-240.0*sin(u)*u*u*cos(v)*cos(v)
@@ -337,9 +337,9 @@ namespace GMlib {
 
           s6 = 1/(pow((T)T(1.0)+u*u*pow((T)sin(v),T(2)),T(5)));
 
-        this->_p[2][2][1] =	-T(2.0)*_r*sin(v)*s5*s6;
+        p[2][2][1] =	-T(2.0)*_r*sin(v)*s5*s6;
 
-        this->_p[2][2][2] =	-2.0*_r*T(2.0)*cos(v)*(43.0*u*u-148.0*cos(v)*cos(v)*u*u+105.0*u*u*pow((T)cos(v),T(4))
+        p[2][2][2] =	-2.0*_r*T(2.0)*cos(v)*(43.0*u*u-148.0*cos(v)*cos(v)*u*u+105.0*u*u*pow((T)cos(v),T(4))
                 +35.0*u*u*u*u+5.0*cos(v)*cos(v)*u*u*u*u-115.0*u*u*u*u*pow((T)cos(v),T(4))
                 +75.0*u*u*u*u*pow((T)cos(v),T(6))-15.0*u*u*u*u*u*u+42.0*cos(v)*cos(v)*u*u*u*u*u*u
                 -36.0*u*u*u*u*u*u*pow((T)cos(v),T(4))+6.0*u*u*u*u*u*u*pow((T)cos(v),T(6))+3.0*u*u*u*u*u*u
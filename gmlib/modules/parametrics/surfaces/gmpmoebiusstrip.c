@@ -83,9 +83,9 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PMoebiusStrip<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PMoebiusStrip<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T sv = sin(v);
     T cv = cos(v);
@@ -93,52 +93,52 @@ namespace GMlib {
     T c5v = cos(T(.5)*v);
     T wu  = _w*u;
 
-    this->_p[0][0][0] =	(_r + wu*c5v)*cv;
-    this->_p[0][0][1] =	(_r + wu*c5v)*sv;
-    this->_p[0][0][2] =	wu*s5v;
+    p[0][0][0] =	(_r + wu*c5v)*cv;
+    p[0][0][1] =	(_r + wu*c5v)*sv;
+    p[0][0][2] =	wu*s5v;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                                      //u
-        this->_p[1][0][0] =	_w*c5v*cv;
-        this->_p[1][0][1] =	_w*c5v*sv;
-        this->_p[1][0][2] =	_w*s5v;
+        p[1][0][0] =	_w*c5v*cv;
+        p[1][0][1] =	_w*c5v*sv;
+        p[1][0][2] =	_w*s5v;
       }
       if(d1>1) {                                     //uu
-        this->_p[2][0][0] =	T(0);
-        this->_p[2][0][1] =	T(0);
-        this->_p[2][0][2] =	T(0);
+        p[2][0][0] =	T(0);
+        p[2][0][1] =	T(0);
+        p[2][0][2] =	T(0);
       }
       if(d2) {                                       //v
-        this->_p[0][1][0] =	-T(.5)*wu*s5v*cv - sv*_r - sv*wu*c5v;
-        this->_p[0][1][1] =	-T(.5)*wu*s5v*sv + cv*_r + cv*wu*c5v;
-        this->_p[0][1][2] =	 T(.5)*wu*c5v;
+        p[0][1][0] =	-T(.5)*wu*s5v*cv - sv*_r - sv*wu*c5v;
+        p[0][1][1] =	-T(.5)*wu*s5v*sv + cv*_r + cv*wu*c5v;
+        p[0][1][2] =	 T(.5)*wu*c5v;
       }
       if(d2>1) {                                    //vv
-        this->_p[0][2][0] =	-T(.25)*wu*c5v*cv + wu*s5v*sv - cv*_r - cv*wu*c5v;
-        this->_p[0][2][1] =	-T(.25)*wu*c5v*sv - wu*s5v*cv - sv*_r - sv*wu*c5v;
-        this->_p[0][2][2] =	-T(.25)*wu*s5v;
+        p[0][2][0] =	-T(.25)*wu*c5v*cv + wu*s5v*sv - cv*_r - cv*wu*c5v;
+        p[0][2][1] =	-T(.25)*wu*c5v*sv - wu*s5v*cv - sv*_r - sv*wu*c5v;
+        p[0][2][2] =	-T(.25)*wu*s5v;
       }
       if(d1 && d2) {                                //uv
-        this->_p[1][1][0] =	-_w*(s5v*T(.5)*cv + c5v*sv);
-        this->_p[1][1][1] =	-_w*(s5v*T(.5)*sv - c5v*cv);
-        this->_p[1][1][2] =	 _w*c5v*T(.5);
+        p[1][1][0] =	-_w*(s5v*T(.5)*cv + c5v*sv);
+        p[1][1][1] =	-_w*(s5v*T(.5)*sv - c5v*cv);
+        p[1][1][2] =	 _w*c5v*T(.5);
       }
       if(d1>1 && d2) {                              //uuv
-        this->_p[2][1][0] =	T(0);
-        this->_p[2][1][1] =	T(0);
-        this->_p[2][1][2] =	T(0);
+        p[2][1][0] =	T(0);
+        p[2][1][1] =	T(0);
+        p[2][1][2] =	T(0);
       }
       if(d1 && d2>1) {                              //uvv
-        this->_p[1][2][0] =	-_w*(c5v*T(.25)*cv - s5v*sv + c5v*cv);
-        this->_p[1][2][1] =	-_w*(c5v*T(.25)*sv + s5v*cv + c5v*sv) ;
-        this->_p[1][2][2] =	-_w*s5v*T(.25);
+        p[1][2][0] =	-_w*(c5v*T(.25)*cv - s5v*sv + c5v*cv);
+        p[1][2][1] =	-_w*(c5v*T(.25)*sv + s5v*cv + c5v*sv) ;
+        p[1][2][2] =	-_w*s5v*T(.25);
       }
       if(d1>1 && d2>1) {                            //uuvv
-        this->_p[2][2][0] =	T(0);
-        this->_p[2][2][1] =	T(0);
-        this->_p[2][2][2] =	T(0);
+        p[2][2][0] =	T(0);
+        p[2][2][1] =	T(0);
+        p[2][2][2] =	T(0);
       }
     }
   }
@@ -130,34 +130,34 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PPlane<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PPlane<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
-    this->_p[0][0] = _pt + u*_u + v*_v ;
+    p[0][0] = _pt + u*_u + v*_v ;
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       // 1st
-      if(d1)            this->_p[1][0] = _u; // S_u
-      if(d2)            this->_p[0][1] = _v; // S_v
-      if(d1>1 && d2>1)  this->_p[1][1] = Vector<T,3>(T(0)); // S_uv
+      if(d1)            p[1][0] = _u; // S_u
+      if(d2)            p[0][1] = _v; // S_v
+      if(d1>1 && d2>1)  p[1][1] = Vector<T,3>(T(0)); // S_uv
 
       // 2nd
-      if(d1>1)          this->_p[2][0] = Vector<T,3>(T(0)); // S_uu
-      if(d2>1)          this->_p[0][2] = Vector<T,3>(T(0)); // S_vv
-      if(d1>1 && d2)    this->_p[2][1] = Vector<T,3>(T(0)); // S_uuv
-      if(d1   && d2>1)  this->_p[1][2] = Vector<T,3>(T(0)); // S_uvv
-      if(d1>1 && d2>1)  this->_p[2][2] = Vector<T,3>(T(0)); // S_uuvv
+      if(d1>1)          p[2][0] = Vector<T,3>(T(0)); // S_uu
+      if(d2>1)          p[0][2] = Vector<T,3>(T(0)); // S_vv
+      if(d1>1 && d2)    p[2][1] = Vector<T,3>(T(0)); // S_uuv
+      if(d1   && d2>1)  p[1][2] = Vector<T,3>(T(0)); // S_uvv
+      if(d1>1 && d2>1)  p[2][2] = Vector<T,3>(T(0)); // S_uuvv
 
       // 3rd
-      if(d1>2)          this->_p[3][0] = Vector<T,3>(T(0)); // S_uuu
-      if(d2>2)          this->_p[0][3] = Vector<T,3>(T(0)); // S_vvv
-      if(d1>2 && d2)    this->_p[3][1] = Vector<T,3>(T(0)); // S_uuuv
-      if(d1   && d2>2)  this->_p[1][3] = Vector<T,3>(T(0)); // S_uvvv
-      if(d1>2 && d2>1)  this->_p[3][2] = Vector<T,3>(T(0)); // S_uuuvv
-      if(d1>1 && d2>2)  this->_p[2][3] = Vector<T,3>(T(0)); // S_uuvvv
-      if(d1>2 && d2>2)  this->_p[3][3] = Vector<T,3>(T(0)); // S_uuuvvv
+      if(d1>2)          p[3][0] = Vector<T,3>(T(0)); // S_uuu
+      if(d2>2)          p[0][3] = Vector<T,3>(T(0)); // S_vvv
+      if(d1>2 && d2)    p[3][1] = Vector<T,3>(T(0)); // S_uuuv
+      if(d1   && d2>2)  p[1][3] = Vector<T,3>(T(0)); // S_uvvv
+      if(d1>2 && d2>1)  p[3][2] = Vector<T,3>(T(0)); // S_uuuvv
+      if(d1>1 && d2>2)  p[2][3] = Vector<T,3>(T(0)); // S_uuvvv
+      if(d1>2 && d2>2)  p[3][3] = Vector<T,3>(T(0)); // S_uuuvvv
     }
   }
 
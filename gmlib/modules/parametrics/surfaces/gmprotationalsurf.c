@@ -47,6 +47,9 @@ namespace GMlib {
   inline
   PRotationalSurf<T>::PRotationalSurf( const PRotationalSurf<T>& copy ) : PSurf<T,3>( copy ) {
 
+    _cu = copy._cu;
+    _start_par = copy._start_par;
+    _end_par = copy._end_par;
   }
 
 
@@ -77,75 +80,75 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PRotationalSurf<T>::eval(T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PRotationalSurf<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim(d1+1,d2+1);
+    p.setDim(d1+1,d2+1);
     DVector<Vector<T,3> > uu =  _cu->evaluate( u, d1 );
     T sv = sin(v);
     T cv = cos(v);
 
     // S
-    this->_p[0][0][0] =    uu[0][0]*cv;
-    this->_p[0][0][1] =    uu[0][0]*sv;
-    this->_p[0][0][2] =    uu[0][1];
+    p[0][0][0] =    uu[0][0]*cv;
+    p[0][0][1] =    uu[0][0]*sv;
+    p[0][0][2] =    uu[0][1];
 
     if( this->_dm == GM_DERIVATION_EXPLICIT )
     {
       if(d1) {                            // Su
-        this->_p[1][0][0] =   uu[1][0]*cv;
-        this->_p[1][0][1] =   uu[1][0]*sv;
-        this->_p[1][0][2] =   uu[1][1];   
+        p[1][0][0] =   uu[1][0]*cv;
+        p[1][0][1] =   uu[1][0]*sv;
+        p[1][0][2] =   uu[1][1];   
         if(d2)  {                         // Suv
-          this->_p[1][1][0] =  -uu[1][0]*sv;
-          this->_p[1][1][1] =   uu[1][0]*cv;
-          this->_p[1][1][2] =   T(0);
+          p[1][1][0] =  -uu[1][0]*sv;
+          p[1][1][1] =   uu[1][0]*cv;
+          p[1][1][2] =   T(0);
           if(d2>1) {                      // Suvv
-            this->_p[1][2][0] =  -uu[1][0]*cv;
-            this->_p[1][2][1] =  -uu[1][0]*sv;
-            this->_p[1][2][2] =   T(0);
+            p[1][2][0] =  -uu[1][0]*cv;
+            p[1][2][1] =  -uu[1][0]*sv;
+            p[1][2][2] =   T(0);
             if(d2>2) {                    // Suvvv
-              this->_p[1][3][0] =   uu[1][0]*sv;
-              this->_p[1][3][1] =  -uu[1][0]*cv;
-              this->_p[1][3][2] =   T(0);
+              p[1][3][0] =   uu[1][0]*sv;
+              p[1][3][1] =  -uu[1][0]*cv;
+              p[1][3][2] =   T(0);
             }
           }
         }
         if(d1>1) {                        // Suu
-          this->_p[2][0][0] =   uu[2][0]*cv;
-          this->_p[2][0][1] =   uu[2][0]*sv;
-          this->_p[2][0][2] =   uu[2][1];
+          p[2][0][0] =   uu[2][0]*cv;
+          p[2][0][1] =   uu[2][0]*sv;
+          p[2][0][2] =   uu[2][1];
           if(d2) {                        // Suuv
-            this->_p[2][1][0] =  -uu[2][0]*sv;
-            this->_p[2][1][1] =   uu[2][0]*cv;
-            this->_p[2][1][2] =   T(0);
+            p[2][1][0] =  -uu[2][0]*sv;
+            p[2][1][1] =   uu[2][0]*cv;
+            p[2][1][2] =   T(0);
             if(d2>1) {                    // Suuvv
-              this->_p[2][2][0] =  -uu[2][0]*cv;
-              this->_p[2][2][1] =  -uu[2][0]*sv;
-              this->_p[2][2][2] =   T(0);
+              p[2][2][0] =  -uu[2][0]*cv;
+              p[2][2][1] =  -uu[2][0]*sv;
+              p[2][2][2] =   T(0);
               if(d2>2) {                  // Suuvvv
-                this->_p[2][3][0] =   uu[2][0]*sv;
-                this->_p[2][3][1] =  -uu[2][0]*cv;
-                this->_p[2][3][2] =   T(0);
+                p[2][3][0] =   uu[2][0]*sv;
+                p[2][3][1] =  -uu[2][0]*cv;
+                p[2][3][2] =   T(0);
               }
             }
           }
 
           if(d1>2) {                      // Suuu
-            this->_p[3][0][0] =   uu[3][0]*cv;
-            this->_p[3][0][1] =   uu[3][0]*sv;
-            this->_p[3][0][2] =   uu[3][1];
+            p[3][0][0] =   uu[3][0]*cv;
+            p[3][0][1] =   uu[3][0]*sv;
+            p[3][0][2] =   uu[3][1];
             if(d2) {                      // Suuuv
-              this->_p[3][1][0] =  -uu[3][0]*sv;
-              this->_p[3][1][1] =   uu[3][0]*cv;
-              this->_p[3][1][2] =   T(0);
+              p[3][1][0] =  -uu[3][0]*sv;
+              p[3][1][1] =   uu[3][0]*cv;
+              p[3][1][2] =   T(0);
               if(d2>1)  {                 // Suuuvv
-                this->_p[3][2][0] =  -uu[3][0]*cv;
-                this->_p[3][2][1] =  -uu[3][0]*sv;
-                this->_p[3][2][2] =   T(0);
+                p[3][2][0] =  -uu[3][0]*cv;
+                p[3][2][1] =  -uu[3][0]*sv;
+                p[3][2][2] =   T(0);
                 if(d2>2) {                // Suuuvvv
-                  this->_p[3][3][0] =   uu[3][0]*sv;
-                  this->_p[3][3][1] =  -uu[3][0]*cv;
-                  this->_p[3][3][2] =   T(0);
+                  p[3][3][0] =   uu[3][0]*sv;
+                  p[3][3][1] =  -uu[3][0]*cv;
+                  p[3][3][2] =   T(0);
                 }
               }
             }
@@ -154,17 +157,17 @@ namespace GMlib {
       }
 
       if(d2) {                            // Sv
-        this->_p[0][1][0] =  -uu[0][0]*sv;
-        this->_p[0][1][1] =   uu[0][0]*cv;
-        this->_p[0][1][2] =   T(0);
+        p[0][1][0] =  -uu[0][0]*sv;
+        p[0][1][1] =   uu[0][0]*cv;
+        p[0][1][2] =   T(0);
         if(d2>1) {                        // Svv
-          this->_p[0][2][0] =  -uu[0][0]*cv;
-          this->_p[0][2][1] =  -uu[0][0]*sv;
-          this->_p[0][2][2] =   T(0);
+          p[0][2][0] =  -uu[0][0]*cv;
+          p[0][2][1] =  -uu[0][0]*sv;
+          p[0][2][2] =   T(0);
           if(d2>2) {                      // Svvv
-            this->_p[0][3][0] =   uu[0][0]*sv;
-            this->_p[0][3][1] =  -uu[0][0]*cv;
-            this->_p[0][3][2] =   T(0);
+            p[0][3][0] =   uu[0][0]*sv;
+            p[0][3][1] =  -uu[0][0]*cv;
+            p[0][3][2] =   T(0);
           }
         }
       }
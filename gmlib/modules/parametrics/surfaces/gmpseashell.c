@@ -73,9 +73,9 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PSeashell<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PSeashell<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T a = 0.51449576;
     T b = 0.085749293;
@@ -90,87 +90,87 @@ namespace GMlib {
     T susv = su*sv;
 
     //S
-    this->_p[0][0][0] =	    cv+v1*(cucv+a*susv);
-    this->_p[0][0][1] =     sv+v1*(cusv-a*sucv);
-    this->_p[0][0][2] =     (b*su+0.6)*v;
+    p[0][0][0] =	    cv+v1*(cucv+a*susv);
+    p[0][0][1] =     sv+v1*(cusv-a*sucv);
+    p[0][0][2] =     (b*su+0.6)*v;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                  //Su
-        this->_p[1][0][0] =  v1*(-sucv+a*cusv);
-        this->_p[1][0][1] =  v1*(-susv-a*cucv);
-        this->_p[1][0][2] =  b*v*cu;
+        p[1][0][0] =  v1*(-sucv+a*cusv);
+        p[1][0][1] =  v1*(-susv-a*cucv);
+        p[1][0][2] =  b*v*cu;
       }
       if(d2) {                  //Sv
-        this->_p[0][1][0] =  v1*(a*sucv-cusv)+0.1*(cucv+a*susv)-sv;
-        this->_p[0][1][1] =  v1*(a*susv+cucv)+0.1*(cusv-a*sucv)+cv;
-        this->_p[0][1][2] =  b*su+0.6;
+        p[0][1][0] =  v1*(a*sucv-cusv)+0.1*(cucv+a*susv)-sv;
+        p[0][1][1] =  v1*(a*susv+cucv)+0.1*(cusv-a*sucv)+cv;
+        p[0][1][2] =  b*su+0.6;
       }
       if(d1>1) {                //Suu
-        this->_p[2][0][0] =  v1*(-cucv-a*susv);
-        this->_p[2][0][1] =  v1*(-cusv+a*sucv);
-        this->_p[2][0][2] = -b*v*su;
+        p[2][0][0] =  v1*(-cucv-a*susv);
+        p[2][0][1] =  v1*(-cusv+a*sucv);
+        p[2][0][2] = -b*v*su;
       }
       if(d1 && d2) {            //Suv
-        this->_p[1][1][0] =  v1*(a*cucv+susv)-0.1*(sucv+a*cusv);
-        this->_p[1][1][1] =  v1*(a*cusv-sucv)-0.1*(susv+a*cucv);
-        this->_p[1][1][2] =  b*cu;
+        p[1][1][0] =  v1*(a*cucv+susv)-0.1*(sucv+a*cusv);
+        p[1][1][1] =  v1*(a*cusv-sucv)-0.1*(susv+a*cucv);
+        p[1][1][2] =  b*cu;
       }
       if(d2>1) {                //Svv
-        this->_p[0][2][0] =  0.2*(a*sucv-cusv)+v1*(-cucv-a*susv)-cv;
-        this->_p[0][2][1] =  0.2*(a*susv+cucv)+v1*(a*sucv-cusv)-sv;
-        this->_p[0][2][2] =  0.0;
+        p[0][2][0] =  0.2*(a*sucv-cusv)+v1*(-cucv-a*susv)-cv;
+        p[0][2][1] =  0.2*(a*susv+cucv)+v1*(a*sucv-cusv)-sv;
+        p[0][2][2] =  0.0;
       }
       if(d1>2) {                //Suuu
-        this->_p[3][0][0] =  v1*(sucv-a*cusv);
-        this->_p[3][0][1] =  v1*(susv+a*cucv);
-        this->_p[3][0][2] = -b*v*cu;
+        p[3][0][0] =  v1*(sucv-a*cusv);
+        p[3][0][1] =  v1*(susv+a*cucv);
+        p[3][0][2] = -b*v*cu;
       }
       if(d1>1 && d2) {          //Suuv
-        this->_p[2][1][0] =  v1*(cusv-a*sucv)-0.1*(cucv-a*susv);
-        this->_p[2][1][1] =  v1*(-cucv-a*susv)-0.1*(cusv+a*sucv);
-        this->_p[2][1][2] = -b*su;
+        p[2][1][0] =  v1*(cusv-a*sucv)-0.1*(cucv-a*susv);
+        p[2][1][1] =  v1*(-cucv-a*susv)-0.1*(cusv+a*sucv);
+        p[2][1][2] = -b*su;
       }
       if(d1 && d2>1) {          //Suvv
-        this->_p[1][2][0] =  0.2*(a*cucv+susv)+v1*(sucv-a*cusv);
-        this->_p[1][2][1] =  0.2*(a*cusv-sucv)+v1*(susv+a*cucv);
-        this->_p[1][2][2] =  0;
+        p[1][2][0] =  0.2*(a*cucv+susv)+v1*(sucv-a*cusv);
+        p[1][2][1] =  0.2*(a*cusv-sucv)+v1*(susv+a*cucv);
+        p[1][2][2] =  0;
       }
       if(d2>2) {                //Svvv
-        this->_p[0][3][0] =  0.3*(-a*susv-cucv)+v1*(cusv-a*sucv)+sv;
-        this->_p[0][3][1] =  0.3*(a*sucv-cusv)+v1*(-a*susv-cucv)-cv;
-        this->_p[0][3][2] =  0;
+        p[0][3][0] =  0.3*(-a*susv-cucv)+v1*(cusv-a*sucv)+sv;
+        p[0][3][1] =  0.3*(a*sucv-cusv)+v1*(-a*susv-cucv)-cv;
+        p[0][3][2] =  0;
       }
       if(d1>2 && d2) {          //Suuuv
-        this->_p[3][1][0] =  v1*(-susv-a*cucv)-0.1*(-sucv-a*cusv);
-        this->_p[3][1][1] =  v1*(sucv-a*cusv)-0.1*(-susv+a*cucv);
-        this->_p[3][1][2] =  -b*cu;
+        p[3][1][0] =  v1*(-susv-a*cucv)-0.1*(-sucv-a*cusv);
+        p[3][1][1] =  v1*(sucv-a*cusv)-0.1*(-susv+a*cucv);
+        p[3][1][2] =  -b*cu;
       }
       if(d1>1 && d2>1) {        //Suuvv
-        this->_p[2][2][0] =  0.2*(cusv-a*sucv)+v1*(cucv+a*susv);
-        this->_p[2][2][1] =  0.2*(-a*susv-cucv)+v1*(-a*sucv+cusv);
-        this->_p[2][2][2] =  0;
+        p[2][2][0] =  0.2*(cusv-a*sucv)+v1*(cucv+a*susv);
+        p[2][2][1] =  0.2*(-a*susv-cucv)+v1*(-a*sucv+cusv);
+        p[2][2][2] =  0;
       }
       if(d1>2 && d2>1) {        //Suuuvv
-        this->_p[3][2][0] =  0.2*(-susv-a*cucv)+v1*(-sucv+a*cusv);
-        this->_p[3][2][1] =  0.2*(-a*cusv+sucv)+v1*(-a*cucv-susv);
-        this->_p[3][2][2] =  0;
+        p[3][2][0] =  0.2*(-susv-a*cucv)+v1*(-sucv+a*cusv);
+        p[3][2][1] =  0.2*(-a*cusv+sucv)+v1*(-a*cucv-susv);
+        p[3][2][2] =  0;
       }
       if(d1 && d2>2) {          //Suvvv
-        this->_p[1][3][0] =  0.3*(-a*cusv+sucv)+v1*(-susv-a*cucv);
-        this->_p[1][3][1] =  0.3*(a*cucv+susv)+v1*(-a*cusv+sucv);
-        this->_p[1][3][2] =  0;
+        p[1][3][0] =  0.3*(-a*cusv+sucv)+v1*(-susv-a*cucv);
+        p[1][3][1] =  0.3*(a*cucv+susv)+v1*(-a*cusv+sucv);
+        p[1][3][2] =  0;
       }
       if(d1>1 && d2>2) {        //Suuvvv
-        this->_p[2][3][0] =  0.3*(a*susv+cucv)+v1*(-cusv+a*sucv);
-        this->_p[2][3][1] =  0.3*(-a*sucv+cusv)+v1*(a*susv+cucv);
-        this->_p[2][3][2] =  0;
+        p[2][3][0] =  0.3*(a*susv+cucv)+v1*(-cusv+a*sucv);
+        p[2][3][1] =  0.3*(-a*sucv+cusv)+v1*(a*susv+cucv);
+        p[2][3][2] =  0;
       }
       if(d1>2 && d2>2) {        //Suuuvvv
-        this->_p[3][3][0] =  0.3*(a*cusv-sucv)+v1*(susv+a*cucv);
-        this->_p[3][3][1] =  0.3*(-a*cucv-susv)+v1*(a*cusv-sucv);
-        this->_p[3][3][2] =  0;
+        p[3][3][0] =  0.3*(a*cusv-sucv)+v1*(susv+a*cucv);
+        p[3][3][1] =  0.3*(-a*cucv-susv)+v1*(a*cusv-sucv);
+        p[3][3][2] =  0;
       }
     }
   }
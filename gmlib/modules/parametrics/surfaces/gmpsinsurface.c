@@ -79,18 +79,18 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PSinSurface<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PSinSurface<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T su  = _r*sin(u);
     T sv  = _r*sin(v);
     T suv = _r*sin(v+u);
 
     //	S(u,v)
-    this->_p[0][0][0] =	su;
-    this->_p[0][0][1] =	sv;
-    this->_p[0][0][2] =	suv;
+    p[0][0][0] =	su;
+    p[0][0][1] =	sv;
+    p[0][0][2] =	suv;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
@@ -99,44 +99,44 @@ namespace GMlib {
         T cuv = _r*cos(v+u);
 
       if(d1)   {                        //u
-        this->_p[1][0][0] =	cu;
-        this->_p[1][0][1] =	0.0;
-        this->_p[1][0][2] =	cuv;
+        p[1][0][0] =	cu;
+        p[1][0][1] =	0.0;
+        p[1][0][2] =	cuv;
       }
       if(d1>1) {                        //uu
-        this->_p[2][0][0] =	-su;
-        this->_p[2][0][1] =	0.0;
-        this->_p[2][0][2] =	-suv;
+        p[2][0][0] =	-su;
+        p[2][0][1] =	0.0;
+        p[2][0][2] =	-suv;
       }
       if(d2)   {                        //v
-        this->_p[0][1][0] =	0.0;
-        this->_p[0][1][1] =	cv;
-        this->_p[0][1][2] =	cuv;
+        p[0][1][0] =	0.0;
+        p[0][1][1] =	cv;
+        p[0][1][2] =	cuv;
       }
       if(d2>1) {                        //vv
-        this->_p[0][2][0] =	0.0;
-        this->_p[0][2][1] =	-sv;
-        this->_p[0][2][2] =	-suv;
+        p[0][2][0] =	0.0;
+        p[0][2][1] =	-sv;
+        p[0][2][2] =	-suv;
       }
       if(d1 && d2) {                    //uv
-        this->_p[1][1][0] =	0.0;
-        this->_p[1][1][1] =	0.0;
-        this->_p[1][1][2] =	-suv;
+        p[1][1][0] =	0.0;
+        p[1][1][1] =	0.0;
+        p[1][1][2] =	-suv;
       }
       if(d1>1 && d2) {                  //uuv
-        this->_p[2][1][0] =	0.0;
-        this->_p[2][1][1] =	0.0;
-        this->_p[2][1][2] =	-cuv;
+        p[2][1][0] =	0.0;
+        p[2][1][1] =	0.0;
+        p[2][1][2] =	-cuv;
       }
       if(d1 && d2>1) {                  //uvv
-        this->_p[1][2][0] =	0.0;
-        this->_p[1][2][1] =	0.0;
-        this->_p[1][2][2] =	-cuv;
+        p[1][2][0] =	0.0;
+        p[1][2][1] =	0.0;
+        p[1][2][2] =	-cuv;
       }
       if(d1>1 && d2>1) {                //uuvv
-        this->_p[2][2][0] =	0.0;
-        this->_p[2][2][1] =	0.0;
-        this->_p[2][2][2] =	suv;
+        p[2][2][0] =	0.0;
+        p[2][2][1] =	0.0;
+        p[2][2][2] =	suv;
       }
     }
   }
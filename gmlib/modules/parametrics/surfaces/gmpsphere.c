@@ -138,9 +138,9 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PSphere<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PSphere<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
     T cos_u =  cos(u);
     T sin_u =  sin(u);
@@ -150,9 +150,9 @@ namespace GMlib {
     T cos_v_z = _radius2 * cos(v);
 
 
-    this->_p[0][0][0] =  cos_u * cos_v_e;	// S
-    this->_p[0][0][1] =  sin_u * cos_v_e;
-    this->_p[0][0][2] =  sin_v_z;
+    p[0][0][0] =  cos_u * cos_v_e;	// S
+    p[0][0][1] =  sin_u * cos_v_e;
+    p[0][0][2] =  sin_v_z;
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
@@ -164,79 +164,127 @@ namespace GMlib {
       T su_sv = sin_u * sin_v_e;
 
       if(d1) {
-        this->_p[1][0][0] = -su_cv;	// S_u
-        this->_p[1][0][1] =  cu_cv;
-        this->_p[1][0][2] =  T(0);
+        p[1][0][0] = -su_cv;	// S_u
+        p[1][0][1] =  cu_cv;
+        p[1][0][2] =  T(0);
       }
       if(d2) {
-        this->_p[0][1][0] = -cu_sv;	// S_v
-        this->_p[0][1][1] = -su_sv;
-        this->_p[0][1][2] =  cos_v_z;
+        p[0][1][0] = -cu_sv;	// S_v
+        p[0][1][1] = -su_sv;
+        p[0][1][2] =  cos_v_z;
       }
       if(d1 && d2) {
-        this->_p[1][1][0] =  su_sv;	// S_uv
-        this->_p[1][1][1] = -cu_sv;
-        this->_p[1][1][2] =  T(0);
+        p[1][1][0] =  su_sv;	// S_uv
+        p[1][1][1] = -cu_sv;
+        p[1][1][2] =  T(0);
       }
       if(d1>1) {
-        this->_p[2][0][0] = -cu_cv;	// S_uu
-        this->_p[2][0][1] = -su_cv;
-        this->_p[2][0][2] =  T(0);
+        p[2][0][0] = -cu_cv;	// S_uu
+        p[2][0][1] = -su_cv;
+        p[2][0][2] =  T(0);
       }
       if(d2>1) {
-        this->_p[0][2][0] = -cu_cv;	// S_vv
-        this->_p[0][2][1] = -su_cv;
-        this->_p[0][2][2] = -sin_v_z;
+        p[0][2][0] = -cu_cv;	// S_vv
+        p[0][2][1] = -su_cv;
+        p[0][2][2] = -sin_v_z;
       }
       if(d1>1 && d2) {
-        this->_p[2][1][0] =  cu_sv;	// S_uuv
-        this->_p[2][1][1] =  su_sv;
-        this->_p[2][1][2] =  T(0);
+        p[2][1][0] =  cu_sv;	// S_uuv
+        p[2][1][1] =  su_sv;
+        p[2][1][2] =  T(0);
       }
       if(d1 && d2>1) {
-        this->_p[1][2][0] =  su_cv;	// S_uvv
-        this->_p[1][2][1] = -cu_cv;
-        this->_p[1][2][2] =  T(0);
+        p[1][2][0] =  su_cv;	// S_uvv
+        p[1][2][1] = -cu_cv;
+        p[1][2][2] =  T(0);
       }
       if(d1>1 && d2>1) {
-        this->_p[2][2][0] =  cu_cv;	// S_uuvv
-        this->_p[2][2][1] =  su_cv;
-        this->_p[2][2][2] =  T(0);
+        p[2][2][0] =  cu_cv;	// S_uuvv
+        p[2][2][1] =  su_cv;
+        p[2][2][2] =  T(0);
       }
       if(d1>2) {
-        this->_p[3][0][0] =  su_cv;	// S_uuu
-        this->_p[3][0][1] = -cu_cv;
-        this->_p[3][0][2] =  T(0);
+        p[3][0][0] =  su_cv;	// S_uuu
+        p[3][0][1] = -cu_cv;
+        p[3][0][2] =  T(0);
       }
       if(d2>2) {
-        this->_p[0][3][0] =  cu_sv;	// S_vvv
-        this->_p[0][3][1] =  su_sv;
-        this->_p[0][3][2] = -cos_v_z;
+        p[0][3][0] =  cu_sv;	// S_vvv
+        p[0][3][1] =  su_sv;
+        p[0][3][2] = -cos_v_z;
       }
       if(d1>2 && d2) {
-        this->_p[3][1][0] = -su_sv;	// S_uuuv
-        this->_p[3][1][1] =  cu_sv;
-        this->_p[3][1][2] =  T(0);
+        p[3][1][0] = -su_sv;	// S_uuuv
+        p[3][1][1] =  cu_sv;
+        p[3][1][2] =  T(0);
       }
       if(d1>2 && d2>1) {
-        this->_p[3][2][0] = -su_cv;	// S_uuuvv
-        this->_p[3][2][1] =  cu_cv;
-        this->_p[3][2][2] =  T(0);
+        p[3][2][0] = -su_cv;	// S_uuuvv
+        p[3][2][1] =  cu_cv;
+        p[3][2][2] =  T(0);
       }
       if(d1 && d2>2) {
-        this->_p[1][3][0] = -su_sv;	// S_uvvv
-        this->_p[1][3][1] =  cu_sv;
-        this->_p[1][3][2] =  T(0);
+        p[1][3][0] = -su_sv;	// S_uvvv
+        p[1][3][1] =  cu_sv;
+        p[1][3][2] =  T(0);
       }
       if(d1>1 && d2>2) {
-        this->_p[2][3][0] = -cu_sv;	// S_uuvvv
-        this->_p[2][3][1] = -su_sv;
-        this->_p[2][3][2] =  T(0);
+        p[2][3][0] = -cu_sv;	// S_uuvvv
+        p[2][3][1] = -su_sv;
+        p[2][3][2] =  T(0);
       }
       if(d1>2 && d2>2) {
-        this->_p[3][3][0] =  su_sv;	// S_uuuvvv
-        this->_p[3][3][1] = -cu_sv;
-        this->_p[3][3][2] =  T(0);
+        p[3][3][0] =  su_sv;	// S_uuuvvv
+        p[3][3][1] = -cu_sv;
+        p[3][3][2] =  T(0);
+      }
+    }
+  }
+
+
+  // Batch evaluation, the same as eval() for each parameter pair.
+  // Position and first derivatives run in one loop, all other cases use the default evalBatch().
+  template <typename T>
+  void PSphere<T>::evalBatch( Vector<T,3>* p, const T* u, const T* v, int m, int d1, int d2, bool lu, bool lv ) const {
+
+    if( this->_dm != GM_DERIVATION_EXPLICIT || d1 > 1 || d2 > 1 ) {
+      PSurf<T,3>::evalBatch( p, u, v, m, d1, d2, lu, lv );
+      return;
+    }
+
+    Vector<T,3>* p00 = p;
+    Vector<T,3>* p01 = p + m;
+    Vector<T,3>* p10 = p + (d2+1)*m;
+    Vector<T,3>* p11 = p + (d2+2)*m;
+
+    for( int i = 0; i < m; i++ ) {
+      T cos_u =  cos(u[i]);
+      T sin_u =  sin(u[i]);
+      T cos_v_e = _radius1 * cos(v[i]);
+      T sin_v_z = _radius2 * sin(v[i]);
+      T sin_v_e = _radius1 * sin(v[i]);
+      T cos_v_z = _radius2 * cos(v[i]);
+
+      p00[i][0] =  cos_u * cos_v_e;	// S
+      p00[i][1] =  sin_u * cos_v_e;
+      p00[i][2] =  sin_v_z;
+
+      if(GMutils::compValueF(cos_v_e,T(0))) cos_v_e = T(1e-4);
+
+      if(d1) {
+        p10[i][0] = -(sin_u * cos_v_e);	// S_u
+        p10[i][1] =  cos_u * cos_v_e;
+        p10[i][2] =  T(0);
+      }
+      if(d2) {
+        p01[i][0] = -(cos_u * sin_v_e);	// S_v
+        p01[i][1] = -(sin_u * sin_v_e);
+        p01[i][2] =  cos_v_z;
+      }
+      if(d1 && d2) {
+        p11[i][0] =  sin_u * sin_v_e;	// S_uv
+        p11[i][1] = -(cos_u * sin_v_e);
+        p11[i][2] =  T(0);
       }
     }
   }
@@ -267,7 +315,7 @@ namespace GMlib {
 
 
   template <typename T>
-  void PSphere<T>::resampleNormals(const DMatrix<DMatrix<Vector<T,3>>>& p, DMatrix<Vector<T,3> >& n) const {
+  void PSphere<T>::resampleNormals(const DSampleGrid<Vector<T,3>>& p, DMatrix<Vector<T,3> >& n) const {
 //    if(_nmap.getDim1() == 0) makeNmap(64,64);
     makeNmap(p.getDim1(), p.getDim2());
     n = _nmap;
@@ -275,7 +323,7 @@ namespace GMlib {
 
 
   template <typename T>
-  void PSphere<T>::computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,3>>>& /*p*/, Sphere<T,3>& s ) const {
+  void PSphere<T>::computeSurroundingSphere( const DSampleGrid<Vector<T,3>>& /*p*/, Sphere<T,3>& s ) const {
 
     s.resetPos(Point<T,3>(T(0)));
     s.resetRadius(_radius1 > _radius2 ? _radius1 : _radius2);
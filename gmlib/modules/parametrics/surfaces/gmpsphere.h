@@ -55,7 +55,8 @@ namespace GMlib {
 
   protected:
     // Virtual function from PSurf that has to be implemented locally
-    void          eval(T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const override;
+    void          eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const override;
+    void          evalBatch( Vector<T,3>* p, const T* u, const T* v, int m, int d1, int d2, bool lu, bool lv ) const override;
     T             getStartPU() const override;
     T             getEndPU()   const override;
     T             getStartPV() const override;
@@ -69,8 +70,8 @@ namespace GMlib {
 
   private:
     // Virtual function from PSurf
-    void   resampleNormals( const DMatrix<DMatrix<Vector<T,3> > >& sample, DMatrix<Vector<T,3> >& normals ) const override;
-    void   computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,3>>>& p, Sphere<T,3>& s ) const override;
+    void   resampleNormals( const DSampleGrid<Vector<T,3>>& sample, DMatrix<Vector<T,3> >& normals ) const override;
+    void   computeSurroundingSphere( const DSampleGrid<Vector<T,3>>& p, Sphere<T,3>& s ) const override;
 
     // Help function to initiate
     void   makeNmap( int s = 64, int t = 64) const;
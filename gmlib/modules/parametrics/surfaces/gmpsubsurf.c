@@ -123,22 +123,24 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PSubSurf<T>::eval( T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/) const {
+  void PSubSurf<T>::eval( DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/) const {
 
-    this->_p.setDim(3,3);
+    p.setDim(3,3);
 
-    DMatrix< Vector<T,3> > p = _s->evaluateParent(S(u,v), d1+1);
-    this->_p[0][0] = p[0][0] - _trans;
+    const Point<T,2>       s = S(u,v);
+    DMatrix< Vector<T,3> > q;
+    _s->evaluateParent(q, s(0), s(1), d1+1, d1+1);
+    p[0][0] = q[0][0] - _trans;
 
     if(d1 || d2)
     {
       Vector<T,2> bu  = Su(u,v);
       Vector<T,2> bv  = Sv(u,v);
       Matrix<T,3,2> S1;
-      S1.setCol(p[1][0], 0);
-      S1.setCol(p[0][1], 1);
-      if(d1) this->_p[1][0] = S1*bu;        // Q_u
-      if(d2) this->_p[0][1] = S1*bv;        // Q_v
+      S1.setCol(q[1][0], 0);
+      S1.setCol(q[0][1], 1);
+      if(d1) p[1][0] = S1*bu;        // Q_u
+      if(d2) p[0][1] = S1*bv;        // Q_v
 //*************************************************
       if(d1>1 || d2>1)
       {
@@ -146,42 +148,42 @@ namespace GMlib {
 
         Matrix<T,3,2> S2;
         // S2 = dS_u = [S_uu  S_uv]
-        S2.setCol(p[2][0], 0);
-        S2.setCol(p[1][1], 1);
+        S2.setCol(q[2][0], 0);
+        S2.setCol(q[1][1], 1);
         Vector<T,3> a1 = S2*bu;
         Vector<T,3> b1 = S2*bv;
 
         // S2 = dS_v = [S_uv  S_vv]
-        S2.setCol(p[1][1], 0);
-        S2.setCol(p[0][2], 1);
+        S2.setCol(q[1][1], 0);
+        S2.setCol(q[0][2], 1);
         Vector<T,3> a2 = S2*bu;
         Vector<T,3> b2 = S2*bv;
 
         // S2 = [dS_u*bu  dS_v*bu]
         S2.setCol(a1, 0);
         S2.setCol(a2, 1);
-        this->_p[2][0] = S2*bu;             // Q_uu
-        this->_p[1][1] = S2*bv +S1*buv;     // Q_uv
+        p[2][0] = S2*bu;             // Q_uu
+        p[1][1] = S2*bv +S1*buv;     // Q_uv
         Vector<T,3> s2buv = S2*buv;
 
         // S2 = [dS_u*bv  dS_v*bv]
         S2.setCol(b1, 0);
         S2.setCol(b2, 1);
-        this->_p[0][2] = S2*bv;             // Q_vv
+        p[0][2] = S2*bv;             // Q_vv
         Vector<T,3> s22buv = S2*buv;
 
 //*************************************************
         Matrix<T,3,2> S3;
-        S3.setCol(p[3][0], 0);
-        S3.setCol(p[2][1], 1);
+        S3.setCol(q[3][0], 0);
+        S3.setCol(q[2][1], 1);
         a1 = S3*bu;
 
-        S3.setCol(p[2][1], 0);
-        S3.setCol(p[1][2], 1);
+        S3.setCol(q[2][1], 0);
+        S3.setCol(q[1][2], 1);
         a2 = S3*bu;
 
-        S3.setCol(p[1][2], 0);
-        S3.setCol(p[0][3], 1);
+        S3.setCol(q[1][2], 0);
+        S3.setCol(q[0][3], 1);
         Vector<T,3> a3 = S3*bu;
 
         S3.setCol(a1, 0);
@@ -196,26 +198,26 @@ namespace GMlib {
 
         S3.setCol(a1, 0);
         S3.setCol(a2, 1);
-        this->_p[2][1] = S3*bv + s2buv;    // Q_uuv
+        p[2][1] = S3*bv + s2buv;    // Q_uuv
 
         //Vector<T,3> s3buv = 2*(S3*buv);
 
         S3.setCol(b1, 0);
         S3.setCol(b2, 1);
-        this->_p[1][2] = S3*bv + s22buv;    // Q_uvv
+        p[1][2] = S3*bv + s22buv;    // Q_uvv
 
         Vector<T,3> NNL(0,0,0);
         Matrix<T,3,2> S4;
         S4.setCol(NNL, 0);
-        S4.setCol(p[3][1], 1);
+        S4.setCol(q[3][1], 1);
         a1 = S4*bu;
-        S4.setCol(p[3][1], 0);
-        S4.setCol(p[2][2], 1);
+        S4.setCol(q[3][1], 0);
+        S4.setCol(q[2][2], 1);
         a2 = S4*bu;
-        S4.setCol(p[2][2], 0);
-        S4.setCol(p[1][3], 1);
+        S4.setCol(q[2][2], 0);
+        S4.setCol(q[1][3], 1);
         a3 = S4*bu;
-        S4.setCol(p[1][3], 0);
+        S4.setCol(q[1][3], 0);
         S4.setCol(NNL, 1);
         Vector<T,3> a4 = S4*bu;
 
@@ -238,10 +240,10 @@ namespace GMlib {
 
         S4.setCol(a1, 0);
         S4.setCol(a2, 1);
-        this->_p[2][2] = S4*bv;             // Q_uuvv
+        p[2][2] = S4*bv;             // Q_uuvv
       }
     }
-//    std::cout << this->_p << std::endl;
+//    std::cout << p << std::endl;
 
   }
 
@@ -71,65 +71,65 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PSwallowTail<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PSwallowTail<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
 
-    this->_p[0][0][0] =	u*v*v + T(3)*v*v*v*v;
-    this->_p[0][0][1] =	-T(2)*u*v - T(4)*v*v*v;
-    this->_p[0][0][2] =	u;
+    p[0][0][0] =	u*v*v + T(3)*v*v*v*v;
+    p[0][0][1] =	-T(2)*u*v - T(4)*v*v*v;
+    p[0][0][2] =	u;
 
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) //u
       {
-        this->_p[1][0][0] =	v*v;
-        this->_p[1][0][1] =	-T(2)*v;
-        this->_p[1][0][2] =	T(1);
+        p[1][0][0] =	v*v;
+        p[1][0][1] =	-T(2)*v;
+        p[1][0][2] =	T(1);
       }
       if(d1>1)//uu
       {
-        this->_p[2][0][0] =	T(0);
-        this->_p[2][0][1] =	T(0);
-        this->_p[2][0][2] =	T(0);
+        p[2][0][0] =	T(0);
+        p[2][0][1] =	T(0);
+        p[2][0][2] =	T(0);
       }
       if(d2) //v
       {
-        this->_p[0][1][0] =	2*u*v+12*v*v*v;
-        this->_p[0][1][1] =	-2*u-12*v*v;
-        this->_p[0][1][2] =	T(0);
+        p[0][1][0] =	2*u*v+12*v*v*v;
+        p[0][1][1] =	-2*u-12*v*v;
+        p[0][1][2] =	T(0);
       }
       if(d2>1) //vv
       {
-        this->_p[0][2][0] =	T(2)*u+T(36)*v*v;
-        this->_p[0][2][1] =	-T(24)*v;
-        this->_p[0][2][2] =	T(0);
+        p[0][2][0] =	T(2)*u+T(36)*v*v;
+        p[0][2][1] =	-T(24)*v;
+        p[0][2][2] =	T(0);
       }
       if(d1 && d2) //uv
       {
-        this->_p[1][1][0] =	T(2)*v;
-        this->_p[1][1][1] =	-T(2);
-        this->_p[1][1][2] =	T(0);
+        p[1][1][0] =	T(2)*v;
+        p[1][1][1] =	-T(2);
+        p[1][1][2] =	T(0);
       }
       if(d1>1 && d2)//uuv
       {
-        this->_p[2][1][0] =	T(0);
-        this->_p[2][1][1] =	T(0);
-        this->_p[2][1][2] =	T(0);
+        p[2][1][0] =	T(0);
+        p[2][1][1] =	T(0);
+        p[2][1][2] =	T(0);
       }
       if(d1 && d2>1) //uvv
       {
-        this->_p[1][2][0] =	T(2);
-        this->_p[1][2][1] =	T(0);
-        this->_p[1][2][2] =	T(0);
+        p[1][2][0] =	T(2);
+        p[1][2][1] =	T(0);
+        p[1][2][2] =	T(0);
       }
       if(d1>1 && d2>1) //uuvv
       {
-        this->_p[2][2][0] =	T(0);
-        this->_p[2][2][1] =	T(0);
-        this->_p[2][2][2] =	T(0);
+        p[2][2][0] =	T(0);
+        p[2][2][1] =	T(0);
+        p[2][2][2] =	T(0);
       }
     }
   }
@@ -52,6 +52,8 @@ namespace GMlib {
       _profile = copy._profile;
       _spine   = copy._spine;
       _RMF     = copy._RMF;
+      _spv     = copy._spv;
+      _omega   = copy._omega;
   }
 
 
@@ -131,12 +133,13 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PSweepSurf<T>::eval(T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PSweepSurf<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim(d1+1,d2+1);
+    p.setDim(d1+1,d2+1);
     int i;
 
-    DVector<Vector<T,3> > h = _spine->evaluate(v,3);
+    DVector<Vector<T,3> > h;
+    _spine->evaluate(h, v, 3);
 
     Vector<T,3> h12 = h[1]^h[2];
 
@@ -185,16 +188,17 @@ namespace GMlib {
         Av  = Av*m;
     }
 
-    DVector<Vector<T,3> > g = _profile->evaluate(u,d1);
+    DVector<Vector<T,3> > g;
+    _profile->evaluate(g, u, d1);
 
-    this->_p[0][0] = h[0] + Av*(g[0] - _spv);       //S
+    p[0][0] = h[0] + Av*(g[0] - _spv);       //S
 
     if( this->_dm == GM_DERIVATION_EXPLICIT)
     {
       if(d1)
-        this->_p[1][0] = Av*g[1];                   //Su
+        p[1][0] = Av*g[1];                   //Su
       if(d2)
-        this->_p[0][1] = h[1] + dAv*(g[0] - _spv);  //Sv
+        p[0][1] = h[1] + dAv*(g[0] - _spv);  //Sv
     }
   }
 
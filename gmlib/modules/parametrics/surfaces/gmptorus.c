@@ -118,9 +118,9 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PTorus<T>::eval(T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PTorus<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1,int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim(d1+1,d2+1);
+    p.setDim(d1+1,d2+1);
 
     T su = sin(u);
     T sv = sin(v);
@@ -137,86 +137,137 @@ namespace GMlib {
     su *= bcva;
 
     //S
-    this->_p[0][0][0] =	   cu;
-    this->_p[0][0][1] =    su;
-    this->_p[0][0][2] =    sv;
+    p[0][0][0] =	   cu;
+    p[0][0][1] =    su;
+    p[0][0][2] =    sv;
 
     if( this->_dm == GM_DERIVATION_EXPLICIT ) {
 
       if(d1) {                  //Su
-        this->_p[1][0][0] =  -su;
-        this->_p[1][0][1] =   cu;
-        this->_p[1][0][2] =   T(0);
+        p[1][0][0] =  -su;
+        p[1][0][1] =   cu;
+        p[1][0][2] =   T(0);
       }
       if(d1>1) {                //Suu
-        this->_p[2][0][0] =  -cu;
-        this->_p[2][0][1] =  -su;
-        this->_p[2][0][2] =   T(0);
+        p[2][0][0] =  -cu;
+        p[2][0][1] =  -su;
+        p[2][0][2] =   T(0);
       }
       if(d2) {                  //Sv
-        this->_p[0][1][0] =  -cusv;
-        this->_p[0][1][1] =  -susv;
-        this->_p[0][1][2] =   cv;
+        p[0][1][0] =  -cusv;
+        p[0][1][1] =  -susv;
+        p[0][1][2] =   cv;
       }
       if(d2>1) {                //Svv
-        this->_p[0][2][0] =  -cucv;
-        this->_p[0][2][1] =  -sucv;
-        this->_p[0][2][2] =  -sv;
+        p[0][2][0] =  -cucv;
+        p[0][2][1] =  -sucv;
+        p[0][2][2] =  -sv;
       }
       if(d1 && d2) {            //Suv
-        this->_p[1][1][0] =   susv;
-        this->_p[1][1][1] =  -cusv;
-        this->_p[1][1][2] =   T(0);
+        p[1][1][0] =   susv;
+        p[1][1][1] =  -cusv;
+        p[1][1][2] =   T(0);
       }
       if(d1>1 && d2) {          //Suuv
-        this->_p[2][1][0] =   cusv;
-        this->_p[2][1][1] =   susv;
-        this->_p[2][1][2] =   T(0);
+        p[2][1][0] =   cusv;
+        p[2][1][1] =   susv;
+        p[2][1][2] =   T(0);
       }
       if(d1 && d2>1) {          //Suvv
-        this->_p[1][2][0] =   sucv;
-        this->_p[1][2][1] =  -cucv;
-        this->_p[1][2][2] =   T(0);
+        p[1][2][0] =   sucv;
+        p[1][2][1] =  -cucv;
+        p[1][2][2] =   T(0);
       }
       if(d1>1 && d2>1) {        //Suuvv
-        this->_p[2][2][0] =   cucv;
-        this->_p[2][2][1] =   sucv;
-        this->_p[2][2][2] =   T(0);
+        p[2][2][0] =   cucv;
+        p[2][2][1] =   sucv;
+        p[2][2][2] =   T(0);
       }
       if(d1>2 && d2) {          //Suuuv
-        this->_p[3][1][0] =  -susv;
-        this->_p[3][1][1] =   cusv;
-        this->_p[3][1][2] =   T(0);
+        p[3][1][0] =  -susv;
+        p[3][1][1] =   cusv;
+        p[3][1][2] =   T(0);
       }
       if(d1>2 && d2>1) {        //Suuuvv
-        this->_p[3][2][0] =  -sucv;
-        this->_p[3][2][1] =   cucv;
-        this->_p[3][2][2] =   T(0);
+        p[3][2][0] =  -sucv;
+        p[3][2][1] =   cucv;
+        p[3][2][2] =   T(0);
       }
       if(d1>2 && d2>1) {        //Suuuvvv
-        this->_p[3][3][0] =   susv;
-        this->_p[3][3][1] =  -cusv;
-        this->_p[3][3][2] =   T(0);
+        p[3][3][0] =   susv;
+        p[3][3][1] =  -cusv;
+        p[3][3][2] =   T(0);
       }
       if(d1 && d2>2) {          //Suvvv
-        this->_p[1][3][0] =  -susv;
-        this->_p[1][3][1] =   cusv;
-        this->_p[1][3][2] =   T(0);
+        p[1][3][0] =  -susv;
+        p[1][3][1] =   cusv;
+        p[1][3][2] =   T(0);
       }
       if(d1>1 && d2>2) {        //Suuvvv
-        this->_p[2][3][0] =  -cusv;
-        this->_p[2][3][1] =  -susv;
-        this->_p[2][3][2] =   T(0);
+        p[2][3][0] =  -cusv;
+        p[2][3][1] =  -susv;
+        p[2][3][2] =   T(0);
       }
       if(d1>2) {                //Suuu
-        this->_p[3][0][0] =   su;
-        this->_p[3][0][1] =  -cu;
-        this->_p[3][0][2] =   T(0);
+        p[3][0][0] =   su;
+        p[3][0][1] =  -cu;
+        p[3][0][2] =   T(0);
       }
       if(d2>2) {                //Svvv
-        this->_p[0][3][0] =   cusv;
-        this->_p[0][3][1] =   susv;
-        this->_p[0][3][2] =  -cv;
+        p[0][3][0] =   cusv;
+        p[0][3][1] =   susv;
+        p[0][3][2] =  -cv;
+      }
+    }
+  }
+
+
+  // Batch evaluation, the same as eval() for each parameter pair.
+  // Position and first derivatives run in one loop, all other cases use the default evalBatch().
+  template <typename T>
+  void PTorus<T>::evalBatch( Vector<T,3>* p, const T* u, const T* v, int m, int d1, int d2, bool lu, bool lv ) const {
+
+    if( this->_dm != GM_DERIVATION_EXPLICIT || d1 > 1 || d2 > 1 ) {
+      PSurf<T,3>::evalBatch( p, u, v, m, d1, d2, lu, lv );
+      return;
+    }
+
+    Vector<T,3>* p00 = p;
+    Vector<T,3>* p01 = p + m;
+    Vector<T,3>* p10 = p + (d2+1)*m;
+    Vector<T,3>* p11 = p + (d2+2)*m;
+
+    for( int i = 0; i < m; i++ ) {
+      T su = sin(u[i]);
+      T sv = sin(v[i]);
+      T cu = cos(u[i]);
+      T cv = cos(v[i]);
+      T bcva = _b*cv+_a;
+      T cusv = _b*cu*sv;
+      T susv = _b*su*sv;
+      sv *= _c;
+      cv *= _c;
+      cu *= bcva;
+      su *= bcva;
+
+      p00[i][0] =  cu;
+      p00[i][1] =  su;
+      p00[i][2] =  sv;
+
+      if(d1) {
+        p10[i][0] = -su;
+        p10[i][1] =  cu;
+        p10[i][2] =  T(0);
+      }
+      if(d2) {
+        p01[i][0] = -cusv;
+        p01[i][1] = -susv;
+        p01[i][2] =  cv;
+      }
+      if(d1 && d2) {
+        p11[i][0] =  susv;
+        p11[i][1] = -cusv;
+        p11[i][2] =  T(0);
       }
     }
   }
@@ -248,7 +299,7 @@ namespace GMlib {
 
 
   template <typename T>
-  void PTorus<T>::computeSurroundingSphere( const DMatrix<DMatrix<Vector<T,3>>>& /*p*/, Sphere<T,3>& s ) const {
+  void PTorus<T>::computeSurroundingSphere( const DSampleGrid<Vector<T,3>>& /*p*/, Sphere<T,3>& s ) const {
 
       s.resetPos(Point<T,3>(T(0)));
       s.resetRadius(_max_r);
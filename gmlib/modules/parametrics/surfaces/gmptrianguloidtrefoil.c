@@ -72,9 +72,9 @@ namespace GMlib {
   //*****************************************************
 
   template <typename T>
-  void PTrianguloidTrefoil<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
+  void PTrianguloidTrefoil<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/ ) const {
 
-    this->_p.setDim( d1+1, d2+1 );
+    p.setDim( d1+1, d2+1 );
 
 
     T su = sin(u);
@@ -127,7 +127,7 @@ namespace GMlib {
 
     for(int i=0; i<fu.getDim();i++)
       for(int j=0; j<fv.getDim(); j++)
-        this->_p[i][j] = fu[i]%fv[j];
+        p[i][j] = fu[i]%fv[j];
   }
 
 
@@ -79,7 +79,8 @@ namespace GMlib {
      DVector< Vector<T,3> > c1 = _c[1]->evaluateParent( v, w, d); // (v,w,u)
      DVector< Vector<T,3> > c2 = _c[2]->evaluateParent( w, u, d); // (w,u,v)
 
-     Vector<Vector<T,3>,20> B = _B->eval(u,v,w);
+     Vector<Vector<T,3>,20> B;
+     _B->eval(B,u,v,w);
 
      this->_p[0] = c0[0] * B[0][0] + c1[0] * B[0][1] + c2[0] * B[0][2];
      if(d>0)
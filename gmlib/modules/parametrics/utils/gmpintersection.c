@@ -0,0 +1,689 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+// gmlib
+#include <core/utils/gmparallel.h>
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+
+namespace GMlib {
+
+  namespace GMPintersection {
+
+    namespace Private {
+
+
+      // Parameter interval of a curve, or rectangle of a surface (only index 0 is used for a curve)
+      template <typename T>
+      struct Cell {
+        Point<T,2>    lo;
+        Point<T,2>    hi;
+      };
+
+
+      template <typename T>
+      inline
+      void inflate( Box<T,3>& b, T r ) {
+
+        const Vector<T,3> v( r );
+        b.insert( b.getPointMin() - v );
+        b.insert( b.getPointMax() + v );
+      }
+
+
+
+      /*! \class CurveObj
+       *  A curve in global coordinates, as seen by the Solver
+       */
+      template <typename T>
+      class CurveObj {
+      public:
+        static const int  k = 1;
+        typedef DVector<Vector<T,3>>  Buffer;
+
+        explicit CurveObj( const PCurve<T,3>& c )
+          : _c(c), _m( c.getMatrixGlobal().template toType<T>() ),
+            _s( c.getParStart() ), _e( c.getParEnd() ), _closed( c.isClosed() ), _tol( c.getParDelta() ) {}
+
+        // The intervals between the samples
+        void getCells( std::vector<Cell<T>>& cells ) {
+
+          std::vector<T> t;
+          _c.getSampleParameters( t );
+          if( t.size() < 2 ) {
+            t.resize( 65 );
+            for( int i = 0; i < 65; i++ ) t[i] = _s + i * (_e - _s) / 64;
+          }
+
+          cells.resize( t.size() - 1 );
+          _tol = T(0);
+          for( unsigned int i = 0; i < cells.size(); i++ ) {
+            cells[i].lo[0] = t[i];
+            cells[i].hi[0] = t[i+1];
+            _tol = std::max( _tol, t[i+1] - t[i] );
+          }
+        }
+
+        // A box around the points at the ends and the middle of the interval, grown by the
+        // error bound of the broken line through them, (h/2)^2/8 max|c''|. max|c''| is taken as
+        // twice the largest of |c''| at the three points and of the difference quotients of c'
+        // between them, so |c''| must not be more than twice that anywhere in the interval.
+        Box<T,3> getBox( const Cell<T>& c, T eps, Buffer& buf ) const {
+
+          const T a = c.lo[0], b = c.hi[0], h = b - a;
+          Point<T,3>  p[3];
+          Vector<T,3> d[3][2];
+          eval( a,           p[0], d[0], buf, false, 2 );
+          eval( (a + b) / 2, p[1], d[1], buf, true,  2 );
+          eval( b,           p[2], d[2], buf, true,  2 );
+
+          T dd = T(0);
+          for( int i = 0; i < 3; i++ ) dd = std::max( dd, d[i][1].getLength() );
+          if( h > T(0) )
+            for( int i = 0; i < 2; i++ ) dd = std::max( dd, T(2) * (d[i+1][0] - d[i][0]).getLength() / h );
+
+          Box<T,3> box( p[0], p[1], p[2] );
+          inflate( box, T(2) * dd * h * h / 32 + eps );
+          return box;
+        }
+
+        // The position and no_d derivatives (if d is not nullptr)
+        void eval( T t, Point<T,3>& p, Vector<T,3>* d, Buffer& buf, bool left = true, int no_d = 1 ) const {
+
+          _c.evaluate( buf, t, d ? no_d : 0, left );
+          p = _m * Point<T,3>( buf[0] );
+          if( d )
+            for( int i = 0; i < no_d; i++ ) d[i] = _m * buf[i+1];
+        }
+
+        void eval( const Point<T,2>& x, Point<T,3>& p, Vector<T,3>* d, Buffer& buf ) const { eval( x[0], p, d, buf ); }
+
+        // Into the domain, around if closed
+        void wrap( Point<T,2>& x ) const {
+
+          if( _closed ) {
+            x[0] = _s + std::fmod( x[0] - _s, _e - _s );
+            if( x[0] < _s ) x[0] += _e - _s;
+          }
+          else
+            x[0] = std::max( _s, std::min( _e, x[0] ) );
+        }
+
+        // Distance between parameter values, around if closed
+        T getParDist( const Point<T,2>& x, const Point<T,2>& y, int ) const {
+
+          const T d = std::abs( x[0] - y[0] );
+          return _closed ? std::min( d, (_e - _s) - d ) : d;
+        }
+
+        // The longest sample interval
+        T getParTol( int ) const { return _tol; }
+
+        void split( const Cell<T>& c, Cell<T>& c1, Cell<T>& c2 ) const {
+
+          c1 = c2 = c;
+          c1.hi[0] = c2.lo[0] = (c.lo[0] + c.hi[0]) / 2;
+        }
+
+      private:
+        const PCurve<T,3>&  _c;
+        HqMatrix<T,3>       _m;
+        T                   _s;
+        T                   _e;
+        bool                _closed;
+        T                   _tol;
+      };
+
+
+
+      /*! \class SurfObj
+       *  A surface in global coordinates, as seen by the Solver
+       */
+      template <typename T>
+      class SurfObj {
+      public:
+        static const int  k = 2;
+        typedef DMatrix<Vector<T,3>>  Buffer;
+
+        explicit SurfObj( const PSurf<T,3>& s ) : _s(s), _m( s.getMatrixGlobal().template toType<T>() ) {
+          _start[0]  = s.getParStartU();   _end[0] = s.getParEndU();   _closed[0] = s.isClosedU();
+          _start[1]  = s.getParStartV();   _end[1] = s.getParEndV();   _closed[1] = s.isClosedV();
+          _tol[0]    = s.getParDeltaU();   _tol[1] = s.getParDeltaV();
+        }
+
+        // The patches of the sample grid
+        void getCells( std::vector<Cell<T>>& cells ) {
+
+          std::vector<T> u, v;
+          _s.getSampleParameters( u, v );
+          if( u.size() < 2 || v.size() < 2 ) {
+            u.resize( 33 );
+            v.resize( 33 );
+            for( int i = 0; i < 33; i++ ) {
+              u[i] = _start[0] + i * (_end[0] - _start[0]) / 32;
+              v[i] = _start[1] + i * (_end[1] - _start[1]) / 32;
+            }
+          }
+
+          cells.resize( (u.size() - 1) * (v.size() - 1) );
+          _tol[0] = _tol[1] = T(0);
+          for( unsigned int i = 0; i < u.size() - 1; i++ )
+            for( unsigned int j = 0; j < v.size() - 1; j++ ) {
+              Cell<T>& c = cells[i * (v.size() - 1) + j];
+              c.lo = Point<T,2>( u[i], v[j] );
+              c.hi = Point<T,2>( u[i+1], v[j+1] );
+              _tol[1] = std::max( _tol[1], v[j+1] - v[j] );
+            }
+          for( unsigned int i = 0; i < u.size() - 1; i++ )
+            _tol[0] = std::max( _tol[0], u[i+1] - u[i] );
+        }
+
+        // A box around the 3x3 points at the corners, the middle of the edges and the middle
+        // of the patch, grown by the error bound of the bilinear patches between them,
+        // (du/2)^2/8 max|S_uu| + (dv/2)^2/8 max|S_vv|. The maxima are estimated as for a curve.
+        Box<T,3> getBox( const Cell<T>& c, T eps, Buffer& buf ) const {
+
+          const T h[2] = { c.hi[0] - c.lo[0], c.hi[1] - c.lo[1] };
+
+          Point<T,3>  p[3][3];
+          Vector<T,3> d[3][3][4];
+          for( int i = 0; i < 3; i++ )
+            for( int j = 0; j < 3; j++ )
+              eval( Point<T,2>( c.lo[0] + i * h[0] / 2, c.lo[1] + j * h[1] / 2 ), p[i][j], d[i][j], buf, 2 );
+
+          T dd[2] = { T(0), T(0) };
+          Box<T,3> box( p[0][0] );
+          for( int i = 0; i < 3; i++ )
+            for( int j = 0; j < 3; j++ ) {
+              box.insert( p[i][j] );
+              for( int k = 0; k < 2; k++ ) {
+                dd[k] = std::max( dd[k], d[i][j][2+k].getLength() );
+                const int in = k ? i : i+1, jn = k ? j+1 : j;
+                if( in < 3 && jn < 3 && h[k] > T(0) )
+                  dd[k] = std::max( dd[k], T(2) * (d[in][jn][k] - d[i][j][k]).getLength() / h[k] );
+              }
+            }
+          inflate( box, T(2) * ( dd[0] * h[0] * h[0] + dd[1] * h[1] * h[1] ) / 32 + eps );
+          return box;
+        }
+
+        // The position and the no_d first derivatives in u and in v (S_u, S_v, S_uu, S_vv) if d is not nullptr
+        void eval( const Point<T,2>& x, Point<T,3>& p, Vector<T,3>* d, Buffer& buf, int no_d = 1 ) const {
+
+          const int dd = d ? no_d : 0;
+          _s.evaluate( buf, x[0], x[1], dd, dd );
+          p = _m * Point<T,3>( buf[0][0] );
+          if( d )
+            for( int i = 0; i < no_d; i++ ) {
+              d[2*i]   = _m * buf[i+1][0];
+              d[2*i+1] = _m * buf[0][i+1];
+            }
+        }
+
+        void wrap( Point<T,2>& x ) const {
+
+          for( int i = 0; i < 2; i++ )
+            if( _closed[i] ) {
+              x[i] = _start[i] + std::fmod( x[i] - _start[i], _end[i] - _start[i] );
+              if( x[i] < _start[i] ) x[i] += _end[i] - _start[i];
+            }
+            else
+              x[i] = std::max( _start[i], std::min( _end[i], x[i] ) );
+        }
+
+        T getParDist( const Point<T,2>& x, const Point<T,2>& y, int i ) const {
+
+          const T d = std::abs( x[i] - y[i] );
+          return _closed[i] ? std::min( d, (_end[i] - _start[i]) - d ) : d;
+        }
+
+        T getParTol( int i ) const { return _tol[i]; }
+
+        // Halves the patch in the direction where it is widest compared to the sample patches
+        void split( const Cell<T>& c, Cell<T>& c1, Cell<T>& c2 ) const {
+
+          const int i = (c.hi[0] - c.lo[0]) * _tol[1] >= (c.hi[1] - c.lo[1]) * _tol[0] ? 0 : 1;
+          c1 = c2 = c;
+          c1.hi[i] = c2.lo[i] = (c.lo[i] + c.hi[i]) / 2;
+        }
+
+      private:
+        const PSurf<T,3>&   _s;
+        HqMatrix<T,3>       _m;
+        T                   _start[2];
+        T                   _end[2];
+        bool                _closed[2];
+        T                   _tol[2];
+      };
+
+
+
+      /*! \class BoxTree
+       *  A binary tree of boxes over the cells of an object, split at the median
+       *  of the box centers along the longest axis. The root is node 0.
+       */
+      template <typename T>
+      class BoxTree {
+      public:
+        struct Node {
+          Box<T,3>    box;
+          int         left;     //!< Child nodes, -1 for a leaf
+          int         right;
+          int         cell;     //!< The cell of a leaf, -1 for an inner node
+        };
+
+        void build( const std::vector<Box<T,3>>& boxes ) {
+
+          _nodes.clear();
+          if( boxes.empty() ) return;
+          _nodes.reserve( 2 * boxes.size() );
+          std::vector<int> idx( boxes.size() );
+          for( unsigned int i = 0; i < idx.size(); i++ ) idx[i] = i;
+          _build( boxes, idx, 0, int(idx.size()) );
+        }
+
+        bool                isEmpty() const       { return _nodes.empty(); }
+        const Node&         operator[]( int i ) const { return _nodes[i]; }
+
+      private:
+        std::vector<Node>   _nodes;
+
+        int _build( const std::vector<Box<T,3>>& boxes, std::vector<int>& idx, int b, int e ) {
+
+          const int ni = int(_nodes.size());
+          _nodes.push_back( Node() );
+          Box<T,3> box = boxes[idx[b]];
+          Box<T,3> cb( box.getPointCenter() );
+          for( int i = b+1; i < e; i++ ) {
+            box.insert( boxes[idx[i]] );
+            cb.insert( boxes[idx[i]].getPointCenter() );
+          }
+          _nodes[ni].box.reset( box.getPointMin() );
+          _nodes[ni].box.insert( box.getPointMax() );
+
+          if( e - b == 1 ) {
+            _nodes[ni].left = _nodes[ni].right = -1;
+            _nodes[ni].cell = idx[b];
+            return ni;
+          }
+
+          int axis = 0;
+          for( int i = 1; i < 3; i++ )
+            if( cb.getValueDelta(i) > cb.getValueDelta(axis) ) axis = i;
+
+          const int mid = (b + e) / 2;
+          std::nth_element( idx.begin() + b, idx.begin() + mid, idx.begin() + e, [&]( int i, int j ) {
+            return boxes[i].getValueCenter(axis) < boxes[j].getValueCenter(axis);
+          } );
+
+          _nodes[ni].cell  = -1;
+          const int left   = _build( boxes, idx, b, mid );
+          const int right  = _build( boxes, idx, mid, e );
+          _nodes[ni].left  = left;
+          _nodes[ni].right = right;
+          return ni;
+        }
+      };
+
+
+
+      /*! \class Solver
+       *  Finds the points where two objects A and B (curves or surfaces) meet,
+       *  by a broad phase on the box trees of the cells and Newton iteration on the pairs.
+       */
+      template <typename T, typename A, typename B>
+      class Solver {
+      public:
+        struct Hit {
+          Point<T,2>    x;      //!< Parameters on A
+          Point<T,2>    y;      //!< Parameters on B
+          Point<T,3>    pos;
+          T             dist;
+        };
+
+        Solver( A& a, B& b, T eps, int no_threads ) : _a(a), _b(b), _eps(eps), _no_threads(no_threads) {}
+
+        void solve( std::vector<Hit>& hits ) {
+
+          hits.clear();
+          _a.getCells( _ca );
+          _b.getCells( _cb );
+          _makeBoxes( _a, _ca, _ba );
+          _makeBoxes( _b, _cb, _bb );
+          _ta.build( _ba );
+          _tb.build( _bb );
+
+          // Broad phase
+          std::vector<Vector<int,2>> pairs;
+          _findPairs( pairs );
+
+          // Refinement, the hits of each pair kept apart to have the same order for any number of threads
+          std::vector<std::vector<Hit>> res( pairs.size() );
+          Parallel::forBlocks( 0, int(pairs.size()), [&]( int bi, int ei ) {
+            typename A::Buffer bufa;
+            typename B::Buffer bufb;
+            for( int i = bi; i < ei; i++ ) {
+              const int ia = pairs[i][0], ib = pairs[i][1];
+              _refine( _ca[ia], _cb[ib], _ba[ia], _bb[ib], 0, res[i], bufa, bufb );
+            }
+          }, _no_threads );
+
+          for( const std::vector<Hit>& r : res )
+            hits.insert( hits.end(), r.begin(), r.end() );
+          _removeDuplicates( hits );
+        }
+
+      private:
+        A&                          _a;
+        B&                          _b;
+        T                           _eps;
+        int                         _no_threads;
+        std::vector<Cell<T>>        _ca, _cb;
+        std::vector<Box<T,3>>       _ba, _bb;
+        BoxTree<T>                  _ta, _tb;
+
+        static const int            _max_depth = 16;
+        static const int            _max_iterations = 30;
+
+
+        template <typename O>
+        void _makeBoxes( const O& o, const std::vector<Cell<T>>& cells, std::vector<Box<T,3>>& boxes ) const {
+
+          boxes.resize( cells.size() );
+          Parallel::forBlocks( 0, int(cells.size()), [&]( int bi, int ei ) {
+            typename O::Buffer buf;
+            for( int i = bi; i < ei; i++ ) {
+              const Box<T,3> box = o.getBox( cells[i], _eps, buf );
+              boxes[i].reset( box.getPointMin() );
+              boxes[i].insert( box.getPointMax() );
+            }
+          }, _no_threads );
+        }
+
+
+        // Descends the two trees, first to a front of pairs to share between the threads
+        void _findPairs( std::vector<Vector<int,2>>& pairs ) const {
+
+          pairs.clear();
+          if( _ta.isEmpty() || _tb.isEmpty() || !_ta[0].box.isIntersecting( _tb[0].box ) ) return;
+
+          std::vector<Vector<int,2>> front( 1, Vector<int,2>( 0, 0 ) );
+          const unsigned int min_front = 64 * Parallel::getNoThreads( _no_threads );
+          for( bool split = true; split && front.size() < min_front; ) {
+
+            split = false;
+            std::vector<Vector<int,2>> next;
+            for( const Vector<int,2>& p : front ) {
+              if( _ta[p[0]].cell >= 0 && _tb[p[1]].cell >= 0 ) { next.push_back( p ); continue; }
+              _splitPair( p, next );
+              split = true;
+            }
+            front.swap( next );
+          }
+
+          std::vector<std::vector<Vector<int,2>>> res( front.size() );
+          Parallel::forBlocks( 0, int(front.size()), [&]( int bi, int ei ) {
+            std::vector<Vector<int,2>> stack;
+            for( int i = bi; i < ei; i++ ) {
+              stack.assign( 1, front[i] );
+              while( !stack.empty() ) {
+                const Vector<int,2> p = stack.back();
+                stack.pop_back();
+                const int ca = _ta[p[0]].cell, cb = _tb[p[1]].cell;
+                if( ca >= 0 && cb >= 0 ) res[i].push_back( Vector<int,2>( ca, cb ) );
+                else                     _splitPair( p, stack );
+              }
+            }
+          }, _no_threads );
+
+          for( const std::vector<Vector<int,2>>& r : res )
+            pairs.insert( pairs.end(), r.begin(), r.end() );
+        }
+
+        // The child pairs with overlapping boxes, the node with the larger box is split
+        void _splitPair( const Vector<int,2>& p, std::vector<Vector<int,2>>& out ) const {
+
+          const typename BoxTree<T>::Node& na = _ta[p[0]];
+          const typename BoxTree<T>::Node& nb = _tb[p[1]];
+          const bool split_a = nb.cell >= 0 ||
+              ( na.cell < 0 && na.box.getPointDelta() * na.box.getPointDelta() >= nb.box.getPointDelta() * nb.box.getPointDelta() );
+
+          if( split_a ) {
+            if( _ta[na.left].box.isIntersecting( nb.box ) )  out.push_back( Vector<int,2>( na.left, p[1] ) );
+            if( _ta[na.right].box.isIntersecting( nb.box ) ) out.push_back( Vector<int,2>( na.right, p[1] ) );
+          }
+          else {
+            if( na.box.isIntersecting( _tb[nb.left].box ) )  out.push_back( Vector<int,2>( p[0], nb.left ) );
+            if( na.box.isIntersecting( _tb[nb.right].box ) ) out.push_back( Vector<int,2>( p[0], nb.right ) );
+          }
+        }
+
+
+        // Newton on the pair, if it fails the larger cell is halved and the halves are tried
+        void _refine( const Cell<T>& ca, const Cell<T>& cb, const Box<T,3>& ba, const Box<T,3>& bb, int depth,
+                      std::vector<Hit>& hits, typename A::Buffer& bufa, typename B::Buffer& bufb ) const {
+
+          if( !ba.isIntersecting( bb ) ) return;
+
+          Hit hit;
+          if( _newton( ca, cb, hit, bufa, bufb ) ) {
+            hits.push_back( hit );
+            return;
+          }
+          if( depth >= _max_depth ) return;
+
+          Cell<T> c1, c2;
+          if( ba.getPointDelta() * ba.getPointDelta() >= bb.getPointDelta() * bb.getPointDelta() ) {
+            _a.split( ca, c1, c2 );
+            _refine( c1, cb, _a.getBox( c1, _eps, bufa ), bb, depth+1, hits, bufa, bufb );
+            _refine( c2, cb, _a.getBox( c2, _eps, bufa ), bb, depth+1, hits, bufa, bufb );
+          }
+          else {
+            _b.split( cb, c1, c2 );
+            _refine( ca, c1, ba, _b.getBox( c1, _eps, bufb ), depth+1, hits, bufa, bufb );
+            _refine( ca, c2, ba, _b.getBox( c2, _eps, bufb ), depth+1, hits, bufa, bufb );
+          }
+        }
+
+
+        // Gauss-Newton on A(x) - B(y) = 0 from the middle of the cells (Newton when A::k + B::k = 3),
+        // the solution must be within the cells grown by a quarter
+        bool _newton( const Cell<T>& ca, const Cell<T>& cb, Hit& hit,
+                      typename A::Buffer& bufa, typename B::Buffer& bufb ) const {
+
+          const int ka = A::k, kb = B::k, m = ka + kb;
+
+          Point<T,2> x = (ca.lo + ca.hi) * T(0.5);
+          Point<T,2> y = (cb.lo + cb.hi) * T(0.5);
+          Point<T,3>  pa, pb;
+          Vector<T,3> da[2], db[2];
+
+          const T tiny = T(1e-3) * _eps;
+          for( int it = 0; it < _max_iterations; it++ ) {
+
+            _a.eval( x, pa, da, bufa );
+            _b.eval( y, pb, db, bufb );
+            const Vector<T,3> f = pa - pb;
+            if( f * f <= tiny * tiny ) break;
+
+            // The columns of the Jacobian, and the normal equations
+            Vector<T,3> j[3];
+            for( int i = 0; i < ka; i++ ) j[i]    =  da[i];
+            for( int i = 0; i < kb; i++ ) j[ka+i] = -db[i];
+
+            T mat[3][4];
+            for( int r = 0; r < m; r++ ) {
+              for( int c = 0; c < m; c++ ) mat[r][c] = j[r] * j[c];
+              mat[r][m] = -(j[r] * f);
+            }
+            T dz[3];
+            if( !_solve( mat, m, dz ) ) return false;
+
+            bool small = true;
+            for( int i = 0; i < ka; i++ ) {
+              x[i] += dz[i];
+              small = small && std::abs( dz[i] ) <= T(1e-12) * _a.getParTol(i);
+            }
+            for( int i = 0; i < kb; i++ ) {
+              y[i] += dz[ka+i];
+              small = small && std::abs( dz[ka+i] ) <= T(1e-12) * _b.getParTol(i);
+            }
+            _a.wrap( x );
+            _b.wrap( y );
+            if( !_inside( _a, ca, x ) || !_inside( _b, cb, y ) ) return false;
+            if( small ) break;
+          }
+
+          _a.eval( x, pa, nullptr, bufa );
+          _b.eval( y, pb, nullptr, bufb );
+          hit.x    = x;
+          hit.y    = y;
+          hit.pos  = (pa + pb) * T(0.5);
+          hit.dist = (pa - pb).getLength();
+          return hit.dist <= _eps;
+        }
+
+        template <typename O>
+        static bool _inside( const O& o, const Cell<T>& c, const Point<T,2>& x ) {
+
+          for( int i = 0; i < O::k; i++ ) {
+            const T w = (c.hi[i] - c.lo[i]) / 4;
+            const Point<T,2> mid = (c.lo + c.hi) * T(0.5);
+            if( o.getParDist( x, mid, i ) > (c.hi[i] - c.lo[i]) / 2 + w ) return false;
+          }
+          return true;
+        }
+
+        // Gaussian elimination with partial pivoting on the augmented m x (m+1) matrix
+        static bool _solve( T mat[3][4], int m, T* z ) {
+
+          for( int c = 0; c < m; c++ ) {
+            int p = c;
+            for( int r = c+1; r < m; r++ )
+              if( std::abs( mat[r][c] ) > std::abs( mat[p][c] ) ) p = r;
+            if( !( std::abs( mat[p][c] ) > std::numeric_limits<T>::min() ) ) return false;
+            if( p != c )
+              for( int i = 0; i <= m; i++ ) std::swap( mat[p][i], mat[c][i] );
+            for( int r = c+1; r < m; r++ ) {
+              const T f = mat[r][c] / mat[c][c];
+              for( int i = c; i <= m; i++ ) mat[r][i] -= f * mat[c][i];
+            }
+          }
+          for( int r = m-1; r >= 0; r-- ) {
+            T s = mat[r][m];
+            for( int i = r+1; i < m; i++ ) s -= mat[r][i] * z[i];
+            z[r] = s / mat[r][r];
+          }
+          return true;
+        }
+
+        // The same intersection found from neighbouring pairs: close in space and in parameters
+        void _removeDuplicates( std::vector<Hit>& hits ) const {
+
+          std::sort( hits.begin(), hits.end(), []( const Hit& h1, const Hit& h2 ) {
+            return h1.pos[0] < h2.pos[0];
+          } );
+
+          // hits[i] stays in place while the window after it is searched, the closest of the group is kept
+          const T tol = 10 * _eps;
+          std::vector<bool> dup( hits.size(), false );
+          std::vector<Hit>  res;
+          for( unsigned int i = 0; i < hits.size(); i++ ) {
+            if( dup[i] ) continue;
+            unsigned int best = i;
+            for( unsigned int j = i+1; j < hits.size() && hits[j].pos[0] - hits[i].pos[0] <= tol; j++ ) {
+              if( dup[j] || (hits[j].pos - hits[i].pos).getLength() > tol ) continue;
+              bool same = true;
+              for( int k = 0; k < A::k; k++ ) same = same && _a.getParDist( hits[i].x, hits[j].x, k ) <= _a.getParTol(k);
+              for( int k = 0; k < B::k; k++ ) same = same && _b.getParDist( hits[i].y, hits[j].y, k ) <= _b.getParTol(k);
+              if( !same ) continue;
+              if( hits[j].dist < hits[best].dist ) best = j;
+              dup[j] = true;
+            }
+            res.push_back( hits[best] );
+          }
+          hits.swap( res );
+
+          std::sort( hits.begin(), hits.end(), []( const Hit& h1, const Hit& h2 ) {
+            return h1.x[0] < h2.x[0] || ( h1.x[0] == h2.x[0] && h1.y[0] < h2.y[0] );
+          } );
+        }
+      };
+
+    } // END namespace Private
+
+
+
+
+    template <typename T>
+    std::vector<CurveCurve<T>> getIntersections( const PCurve<T,3>& c1, const PCurve<T,3>& c2, double eps, int no_threads ) {
+
+      Private::CurveObj<T> a( c1 );
+      Private::CurveObj<T> b( c2 );
+      typedef Private::Solver<T, Private::CurveObj<T>, Private::CurveObj<T>> Solver;
+
+      std::vector<typename Solver::Hit> hits;
+      Solver( a, b, T(eps), no_threads ).solve( hits );
+
+      std::vector<CurveCurve<T>> res( hits.size() );
+      for( unsigned int i = 0; i < hits.size(); i++ ) {
+        res[i].t1   = hits[i].x[0];
+        res[i].t2   = hits[i].y[0];
+        res[i].pos  = hits[i].pos;
+        res[i].dist = hits[i].dist;
+      }
+      return res;
+    }
+
+
+
+
+    template <typename T>
+    std::vector<CurveSurf<T>> getIntersections( const PCurve<T,3>& c, const PSurf<T,3>& s, double eps, int no_threads ) {
+
+      Private::CurveObj<T> a( c );
+      Private::SurfObj<T>  b( s );
+      typedef Private::Solver<T, Private::CurveObj<T>, Private::SurfObj<T>> Solver;
+
+      std::vector<typename Solver::Hit> hits;
+      Solver( a, b, T(eps), no_threads ).solve( hits );
+
+      std::vector<CurveSurf<T>> res( hits.size() );
+      for( unsigned int i = 0; i < hits.size(); i++ ) {
+        res[i].t    = hits[i].x[0];
+        res[i].uv   = hits[i].y;
+        res[i].pos  = hits[i].pos;
+        res[i].dist = hits[i].dist;
+      }
+      return res;
+    }
+
+  } // END namespace GMPintersection
+
+} // END namespace GMlib
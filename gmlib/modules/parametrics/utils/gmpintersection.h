@@ -0,0 +1,118 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+#ifndef GM_PARAMETRICS_UTILS_PINTERSECTION_H
+#define GM_PARAMETRICS_UTILS_PINTERSECTION_H
+
+
+// gmlib
+#include "../gmpcurve.h"
+#include "../gmpsurf.h"
+
+// stl
+#include <vector>
+
+
+namespace GMlib {
+
+  namespace GMPintersection {
+
+    /*!
+     * An intersection point of two curves.
+     */
+    template <typename T>
+    struct CurveCurve {
+      T                   t1;     //!< Parameter value on the first curve
+      T                   t2;     //!< Parameter value on the second curve
+      Point<T,3>          pos;    //!< The intersection point (global coordinates)
+      T                   dist;   //!< Distance between the curves at t1 and t2
+    };
+
+    /*!
+     * An intersection point of a curve and a surface.
+     */
+    template <typename T>
+    struct CurveSurf {
+      T                   t;      //!< Parameter value on the curve
+      Point<T,2>          uv;     //!< Parameter values on the surface
+      Point<T,3>          pos;    //!< The intersection point (global coordinates)
+      T                   dist;   //!< Distance between the curve and the surface at t and uv
+    };
+
+
+    /*!
+     * All intersections of two curves, sorted by the parameter on the first curve.
+     *
+     * The curves are compared in global coordinates. The intervals between the samples of
+     * all partitions (64 uniform intervals if a curve is not sampled) are bounded by boxes,
+     * the boxes are put in one hierarchy for each curve and the two hierarchies are traversed
+     * to find the pairs of intervals that may intersect. Each pair is refined by Newton
+     * iteration from the midpoints; if it does not converge inside the intervals, the larger
+     * interval is halved and the halves are tried, down to 1/2^16 of the sample interval.
+     * Both the broad phase and the refinement run in parallel over the pairs, the result
+     * does not depend on the number of threads.
+     *
+     * A box holds the points at the ends and the middle of an interval, grown by the error bound of
+     * the broken line through them, with the largest second derivative in the interval taken as twice
+     * the largest one seen at these points. The box can only miss a part of a curve where the second
+     * derivative is larger than that, e.g. a narrow spike between the points, so the samples must
+     * resolve the curvature of the curves. Intersections closer
+     * than 10*eps to each other and with parameters in neighbouring intervals are reported once.
+     * Tangential intersections converge slowly and may be missed, overlapping parts of the curves
+     * give a set of points along the overlap.
+     *
+     * \param[in] c1          The first curve
+     * \param[in] c2          The second curve
+     * \param[in] eps         (default 1e-6) The largest distance between the curves in an intersection
+     * \param[in] no_threads  (default 0) Number of threads, 0 uses all cores
+     * \return The intersections
+     */
+    template <typename T>
+    std::vector<CurveCurve<T>>  getIntersections( const PCurve<T,3>& c1, const PCurve<T,3>& c2,
+                                                  double eps = 1e-6, int no_threads = 0 );
+
+    /*!
+     * All intersections of a curve and a surface, sorted by the parameter on the curve.
+     * As for two curves, with the sample grid of the surface split in patches
+     * (a 32x32 grid of patches if the surface is not sampled).
+     *
+     * \param[in] c           The curve
+     * \param[in] s           The surface
+     * \param[in] eps         (default 1e-6) The largest distance between the curve and the surface in an intersection
+     * \param[in] no_threads  (default 0) Number of threads, 0 uses all cores
+     * \return The intersections
+     */
+    template <typename T>
+    std::vector<CurveSurf<T>>   getIntersections( const PCurve<T,3>& c, const PSurf<T,3>& s,
+                                                  double eps = 1e-6, int no_threads = 0 );
+
+  } // END namespace GMPintersection
+
+} // END namespace GMlib
+
+
+// Including template definition file.
+#include "gmpintersection.c"
+
+#endif // GM_PARAMETRICS_UTILS_PINTERSECTION_H
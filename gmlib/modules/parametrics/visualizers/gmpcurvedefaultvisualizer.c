@@ -143,4 +143,19 @@ namespace GMlib {
 
 
 
+
+  template <typename T, int n>
+  void PCurveDefaultVisualizer<T,n>::update( int first, int last ) {
+
+    // The number of samples is changed, the VBO must be rebuilt
+    if( _no_vertices != int((*(this->_p)).size()) ) {
+      update();
+      return;
+    }
+
+    this->fillStandardVBO( _vbo, *(this->_p), first, last );
+  }
+
+
+
 } // END namespace GMlib
@@ -51,6 +51,7 @@ namespace GMlib {
 
     void          replot( const std::vector< DVector< Vector<T, n> > >& p, int m, int d, bool closed = false ) override;
     void          update() override;
+    void          update( int first, int last ) override;
 
   protected:
     GL::Program               _prog;
@@ -76,8 +76,56 @@ namespace GMlib {
     vbo.unmapBuffer();
   }
 
+  /*! void PCurveVisualizer<T,n>::fillStandardVBO( GL::VertexBufferObject& vbo, const std::vector<DVector<Vector<T,n>>>& p, int first, int last, int d, bool scale, const Vector<T,n>& s )
+   *  Updates the vertices first to last (included) of a VBO filled by fillStandardVBO() above.
+   *  The scaling must be the same as when the VBO was filled.
+   *
+   *  \param[in] vbo    The vertex buffer object, already holding all the samples
+   *  \param[in] p      The samples
+   *  \param[in] first  The first sample to update
+   *  \param[in] last   The last sample to update
+   *  \param[in] d      (default 0) Which derivative to use
+   *  \param[in] scale  (default false) Whether the samples are scaled by s
+   *  \param[in] s      The scaling factors
+   */
+  template <typename T, int n>
+  void PCurveVisualizer<T,n>::fillStandardVBO( GL::VertexBufferObject &vbo,
+                                               const std::vector< DVector< Vector<T, n>>>& p,
+                                               int first, int last,
+                                               int d,
+                                               bool scale,
+                                               const Vector<T,n>& s ) {
+
+    std::vector<GL::GLVertex> vertices( last - first + 1 );
+    for( int i = first; i <= last; i++ ) {
+      GL::GLVertex& v = vertices[i-first];
+      if(scale) {
+        v.x = (GLfloat)(s(0) * p[i](d)(0));
+        v.y = (GLfloat)(s(1) * p[i](d)(1));
+        v.z = (GLfloat)(s(2) * p[i](d)(2));
+      }
+      else {
+        v.x = (GLfloat)p[i](d)(0);
+        v.y = (GLfloat)p[i](d)(1);
+        v.z = (GLfloat)p[i](d)(2);
+      }
+    }
+
+    vbo.bufferSubData( first * sizeof(GL::GLVertex), vertices.size() * sizeof(GL::GLVertex), vertices.data() );
+  }
+
   template <typename T, int n>
   void PCurveVisualizer<T,n>::replot( const std::vector< DVector< Vector<T, n> > >& /*p*/,
                                       int /*m*/, int /*d*/, bool /*closed*/ ) {}
 
+  /*! void PCurveVisualizer<T,n>::update( int first, int last )
+   *  Called when only the samples first to last (included) are changed.
+   *  The default is to update everything, see update().
+   */
+  template <typename T, int n>
+  void PCurveVisualizer<T,n>::update( int /*first*/, int /*last*/ ) {
+
+    update();
+  }
+
 } // END namespace GMlib
@@ -53,6 +53,8 @@ namespace GMlib {
     void set( std::vector<DVector<Vector<T,3>>>& p ) { _p = &p; }
 
     virtual void  replot( const std::vector< DVector< Vector<T, n> > >& p, int m, int d, bool closed = false);
+    virtual void  update( int first, int last );
+    using Visualizer::update;
 
 
     static void   fillStandardVBO( GL::VertexBufferObject& vbo,
@@ -61,6 +63,13 @@ namespace GMlib {
                                    bool scale = false,
                                    const Vector<T,n>& s = Vector<T,n>());
 
+    static void   fillStandardVBO( GL::VertexBufferObject& vbo,
+                                   const std::vector<DVector<Vector<T, n>>>& p,
+                                   int first, int last,
+                                   int d = 0,
+                                   bool scale = false,
+                                   const Vector<T,n>& s = Vector<T,n>() );
+
   protected:
     std::vector<DVector<Vector<T,3>>>* _p;
 
@@ -200,7 +200,7 @@ namespace GMlib {
   template <typename T, int n>
   void PSurfContoursVisualizer<T,n>::update() {
 
-    DMatrix< DMatrix< Vector<T, n>>>& p = *(this->_p);
+    DSampleGrid< Vector<T, n> >&      p = *(this->_p);
     DMatrix<Vector<float,n>>&   normals = *(this->_n);
 
     _tri_strips = PSurfVisualizer<T>::getNoTriangleStrips( p.getDim1(), p.getDim2() );
@@ -269,13 +269,12 @@ namespace GMlib {
     Vertex data[p.getDim1()*p.getDim2()];
 
     // Fill vertex point data.
-    for( int i = 0; i < p.getDim1(); i++ )
-      for( int j = 0; j < p.getDim2(); j++ ) {
-        const int idx = i * p.getDim2() + j;
-        data[idx].x = p[i][j][0][0][0];
-        data[idx].y = p[i][j][0][0][1];
-        data[idx].z = p[i][j][0][0][2];
-      }
+    const Vector<T,n>* pos = p.getPlane(0,0);
+    for( int idx = 0; idx < p.getPlaneSize(); idx++ ) {
+      data[idx].x = pos[idx][0];
+      data[idx].y = pos[idx][1];
+      data[idx].z = pos[idx][2];
+    }
 
     // Fill vertex color data
     switch( _method ) {
@@ -313,43 +312,46 @@ namespace GMlib {
 
   template <typename T, int n>
   inline
-  T PSurfContoursVisualizer<T,n>::getValue( DMatrix< DMatrix< Vector<T, 3> > >& p, int i, int j ) {
+  T PSurfContoursVisualizer<T,n>::getValue( DSampleGrid< Vector<T, 3> >& p, int i, int j ) {
 
     switch( _mapping ) {
     case GM_PSURF_CONTOURSVISUALIZER_X:
-      return p[i][j][0][0][0];
+      return p(i,j)[0];
     case GM_PSURF_CONTOURSVISUALIZER_Y:
-      return p[i][j][0][0][1];
+      return p(i,j)[1];
     case GM_PSURF_CONTOURSVISUALIZER_Z:
-      return p[i][j][0][0][2];
+      return p(i,j)[2];
     default: break;
     }
 
     // Values requireing 1st derivatives
-    if( p[i][j].getDim1() < 2 || p[i][j].getDim2() < 2 )
+    if( p.getDerDim1() < 2 || p.getDerDim2() < 2 )
       return T(0);
 
     switch( _mapping ) {
     case GM_PSURF_CONTOURSVISUALIZER_U:
-      return p[i][j][1][0].getLength();
+      return p(i,j,1,0).getLength();
     case GM_PSURF_CONTOURSVISUALIZER_V:
-      return p[i][j][0][1].getLength();
+      return p(i,j,0,1).getLength();
     default: break;
     }
 
     // Values requireing 2nd derivatives
-    if( p[i][j].getDim1() < 3 || p[i][j].getDim2() < 3 )
+    if( p.getDerDim1() < 3 || p.getDerDim2() < 3 )
       return T(0);
 
+    DMatrix< Vector<T,3> > s;
+    p.getSample( s, i, j );
+
     switch( _mapping ) {
     case GM_PSURF_CONTOURSVISUALIZER_CURVATURE_GAUSS:
-      return getCurvatureGauss(p[i][j]);
+      return getCurvatureGauss(s);
     case GM_PSURF_CONTOURSVISUALIZER_CURVATURE_MEAN:
-      return getCurvatureMean(p[i][j]);
+      return getCurvatureMean(s);
     case GM_PSURF_CONTOURSVISUALIZER_CURVATURE_PRINCIPAL_MAX:
-      return getCurvaturePrincipalMax( p[i][j] );
+      return getCurvaturePrincipalMax( s );
     case GM_PSURF_CONTOURSVISUALIZER_CURVATURE_PRINCIPAL_MIN:
-      return getCurvaturePrincipalMin( p[i][j] );
+      return getCurvaturePrincipalMin( s );
     default: break;
     }
     return T(0);
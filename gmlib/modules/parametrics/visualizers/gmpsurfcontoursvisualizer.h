@@ -110,7 +110,7 @@ namespace GMlib {
     T                                 getCurvatureMean( DMatrix< Vector<T,3> >& p );
     T                                 getCurvaturePrincipalMax( DMatrix< Vector<T,3> >& p );
     T                                 getCurvaturePrincipalMin( DMatrix< Vector<T,3> >& p );
-    T                                 getValue( DMatrix< DMatrix< Vector<T, 3> > >& p, int i, int j );
+    T                                 getValue( DSampleGrid< Vector<T, 3> >& p, int i, int j );
 
   };
 
@@ -57,7 +57,7 @@ namespace GMlib {
 
   template <typename T, int n>
   inline
-  PSurfDefaultVisualizer<T,n>::PSurfDefaultVisualizer(DMatrix<DMatrix<Vector<T,n>>>& p, DMatrix<Vector<float,n>>& no)
+  PSurfDefaultVisualizer<T,n>::PSurfDefaultVisualizer(DSampleGrid<Vector<T,n>>& p, DMatrix<Vector<float,n>>& no)
     : PSurfVisualizer<T,n>(p, no), _no_strips(0), _no_strip_indices(0), _strip_size(0) {
 
     _mode = GL_TRIANGLE_STRIP;
@@ -47,7 +47,7 @@ namespace GMlib {
     GM_VISUALIZER(PSurfDefaultVisualizer)
   public:
     PSurfDefaultVisualizer();
-    PSurfDefaultVisualizer( DMatrix<DMatrix<Vector<T,n>>>& p, DMatrix<Vector<float,n>>& no );
+    PSurfDefaultVisualizer( DSampleGrid<Vector<T,n>>& p, DMatrix<Vector<float,n>>& no );
     PSurfDefaultVisualizer( const PSurfDefaultVisualizer<T,n>& copy );
 
     void    render( const SceneObject* obj, const DefaultRenderer* renderer ) const override;
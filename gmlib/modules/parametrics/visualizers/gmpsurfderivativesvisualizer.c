@@ -118,11 +118,11 @@ namespace GMlib {
   inline
   void PSurfDerivativesVisualizer<T,n>::update() {
 
-    DMatrix< DMatrix< Vector<T, n> > >& p = *(this->_p);
+    DSampleGrid< Vector<T, n> >& p = *(this->_p);
     int      no_derivatives = p.getDim1() * p.getDim2();
     _no_elements = no_derivatives * 2;
 
-    assert( p(0)(0).getDim1() >= (_u+1) && p(0)(0).getDim2() >= (_v+1) );
+    assert( p.getDerDim1() >= (_u+1) && p.getDerDim2() >= (_v+1) );
     _vbo.bufferData(no_derivatives * 2 * 3 * sizeof(GLfloat), 0x0, GL_DYNAMIC_DRAW);
 
     Vector<GLfloat,3>* ptr = _vbo.mapBuffer< Vector<GLfloat,3> >();
@@ -132,8 +132,8 @@ namespace GMlib {
 
           for( int i = 0; i < p.getDim1(); i++ )
             for( int j = 0; j < p.getDim2(); j++ ) {
-              const Point<T,3> &pos = p(i)(j)(0)(0);
-              const Vector<T,3> &v = p(i)(j)(_u)(_v) * _size;
+              const Point<T,3> &pos = p(i,j);
+              const Vector<T,3> &v = p(i,j,_u,_v) * _size;
               *(ptr++) = pos;
               *(ptr++) = pos + v;
             }
@@ -143,8 +143,8 @@ namespace GMlib {
 
           for( int i = 0; i < p.getDim1(); i++ )
             for( int j = 0; j < p.getDim2(); j++ ) {
-              const Point<T,3> &pos = p(i)(j)(0)(0);
-              const Vector<T,3> &v = p(i)(j)(_u)(_v).getNormalized() * _size;
+              const Point<T,3> &pos = p(i,j);
+              const Vector<T,3> &v = p(i,j,_u,_v).getNormalized() * _size;
               *(ptr++) = pos;
               *(ptr++) = pos + v;
             }
@@ -154,8 +154,8 @@ namespace GMlib {
 
           for( int i = 0; i < p.getDim1(); i++ )
             for( int j = 0; j < p.getDim2(); j++ ) {
-              const Point<T,3> &pos = p(i)(j)(0)(0);
-              const UnitVector<T,3> &v = p(i)(j)(_u)(_v);
+              const Point<T,3> &pos = p(i,j);
+              const UnitVector<T,3> &v = p(i,j,_u,_v);
               *(ptr++) = pos;
               *(ptr++) = pos + v;
             }
@@ -107,7 +107,7 @@ namespace GMlib {
   }
 
 
-  /*! void PSurfNormalsVisualizer<T,n>::makePlotAll( DMatrix< DMatrix< Vector<T, 3> > >& p, DMatrix< Vector<float, 3> >& normals )
+  /*! void PSurfNormalsVisualizer<T,n>::makePlotAll( DSampleGrid< Vector<T, 3> >& p, DMatrix< Vector<float, 3> >& normals )
    *
    *  Generates the plot data for all normals.
    *
@@ -115,7 +115,7 @@ namespace GMlib {
    *  \param[in]  normals   Evaluated Normal data.
    */
   template <typename T, int n>
-  void PSurfNormalsVisualizer<T,n>::makePlotAll( const DMatrix< DMatrix< Vector<T, 3> > >& p, const DMatrix< Vector<float, 3> >& normals ) {
+  void PSurfNormalsVisualizer<T,n>::makePlotAll( const DSampleGrid< Vector<T, 3> >& p, const DMatrix< Vector<float, 3> >& normals ) {
 
     int no_normals = p.getDim1() * p.getDim2();
     _no_elements = no_normals * 2;
@@ -129,7 +129,7 @@ namespace GMlib {
       for( int i = 0; i < p.getDim1(); i++ ) {
         for( int j = 0; j < p.getDim2(); j++ ) {
 
-          const Point<T,3> &pos = p(i)(j)(0)(0);
+          const Point<T,3> &pos = p(i,j);
           (*ptr).x = float(pos(0));
           (*ptr).y = float(pos(1));
           (*ptr).z = float(pos(2));
@@ -149,7 +149,7 @@ namespace GMlib {
   }
 
 
-  /*! void PSurfNormalsVisualizer<T,n>::makePlotInterior( DMatrix< DMatrix< Vector<T, 3> > >& p, DMatrix< Vector<float, 3> >& normals )
+  /*! void PSurfNormalsVisualizer<T,n>::makePlotInterior( DSampleGrid< Vector<T, 3> >& p, DMatrix< Vector<float, 3> >& normals )
    *
    *  Generates the plot data for all interior normals.
    *
@@ -157,7 +157,7 @@ namespace GMlib {
    *  \param[in]  normals   Evaluated Normal data.
    */
   template <typename T, int n>
-  void PSurfNormalsVisualizer<T,n>::makePlotInterior( const DMatrix< DMatrix< Vector<T, 3> > >& p, const DMatrix< Vector<float, 3> >& normals ) {
+  void PSurfNormalsVisualizer<T,n>::makePlotInterior( const DSampleGrid< Vector<T, 3> >& p, const DMatrix< Vector<float, 3> >& normals ) {
 
     int no_normals = ( p.getDim1() - 2 ) * ( p.getDim2() - 2 );
     _no_elements = no_normals * 2;
@@ -170,7 +170,7 @@ namespace GMlib {
       for( int i = 1; i < p.getDim1()-1; i++ ) {
         for( int j = 1; j < p.getDim2()-1; j++ ) {
 
-          const Point<T,3> &pos = p(i)(j)(0)(0);
+          const Point<T,3> &pos = p(i,j);
           (*ptr).x = float(pos(0));
           (*ptr).y = float(pos(1));
           (*ptr).z = float(pos(2));
@@ -189,7 +189,7 @@ namespace GMlib {
   }
 
 
-  /*! void PSurfNormalsVisualizer<T,n>::makePlotBoundary( DMatrix< DMatrix< Vector<T, 3> > >& p, DMatrix< Vector<float, 3> >& normals )
+  /*! void PSurfNormalsVisualizer<T,n>::makePlotBoundary( DSampleGrid< Vector<T, 3> >& p, DMatrix< Vector<float, 3> >& normals )
    *
    *  Generates the plot data for all boundary normals.
    *
@@ -197,7 +197,7 @@ namespace GMlib {
    *  \param[in]  normals   Evaluated Normal data.
    */
   template <typename T, int n>
-  void PSurfNormalsVisualizer<T,n>::makePlotBoundary( const DMatrix< DMatrix< Vector<T, 3> > >& p, const DMatrix< Vector<float, 3> >& normals ) {
+  void PSurfNormalsVisualizer<T,n>::makePlotBoundary( const DSampleGrid< Vector<T, 3> >& p, const DMatrix< Vector<float, 3> >& normals ) {
 
     int no_normals = ( p.getDim1() + p.getDim2() ) * 2 - 4;
     _no_elements = no_normals * 2;
@@ -213,7 +213,7 @@ namespace GMlib {
         // j = 0
         j = 0;
 
-        const Point<T,3> &pos = p(i)(j)(0)(0);
+        const Point<T,3> &pos = p(i,j);
         (*ptr).x = float(pos(0));
         (*ptr).y = float(pos(1));
         (*ptr).z = float(pos(2));
@@ -228,7 +228,7 @@ namespace GMlib {
         // j = p.getDim2() -1
         j = p.getDim2() - 1;
 
-        const Point<T,3> &pos2 = p(i)(j)(0)(0);
+        const Point<T,3> &pos2 = p(i,j);
         (*ptr).x = float(pos2(0));
         (*ptr).y = float(pos2(1));
         (*ptr).z = float(pos2(2));
@@ -246,7 +246,7 @@ namespace GMlib {
         // i = 0
         i = 0;
 
-        const Point<T,3> &pos = p(i)(j)(0)(0);
+        const Point<T,3> &pos = p(i,j);
         (*ptr).x = float(pos(0));
         (*ptr).y = float(pos(1));
         (*ptr).z = float(pos(2));
@@ -261,7 +261,7 @@ namespace GMlib {
         // j = p.getDim1() -1
         i = p.getDim1() - 1;
 
-        const Point<T,3> &pos2 = p(i)(j)(0)(0);
+        const Point<T,3> &pos2 = p(i,j);
         (*ptr).x = float(pos2(0));
         (*ptr).y = float(pos2(1));
         (*ptr).z = float(pos2(2));
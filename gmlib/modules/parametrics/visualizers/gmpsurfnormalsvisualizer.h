@@ -77,9 +77,9 @@ namespace GMlib {
 
     GM_SURF_NORMALSVISUALIZER_MODE    _mode;
 
-    void                              makePlotAll( const DMatrix< DMatrix< Vector<T, 3> > >& p, const DMatrix< Vector<float, 3> >& normals );
-    void                              makePlotInterior( const DMatrix< DMatrix< Vector<T, 3> > >& p, const DMatrix< Vector<float, 3> >& normals );
-    void                              makePlotBoundary( const DMatrix< DMatrix< Vector<T, 3> > >& p, const DMatrix< Vector<float, 3> >& normals );
+    void                              makePlotAll( const DSampleGrid< Vector<T, 3> >& p, const DMatrix< Vector<float, 3> >& normals );
+    void                              makePlotInterior( const DSampleGrid< Vector<T, 3> >& p, const DMatrix< Vector<float, 3> >& normals );
+    void                              makePlotBoundary( const DSampleGrid< Vector<T, 3> >& p, const DMatrix< Vector<float, 3> >& normals );
 
 
   };
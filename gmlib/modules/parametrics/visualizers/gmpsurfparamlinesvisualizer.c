@@ -139,7 +139,7 @@ void PSurfParamLinesVisualizer<T,n>::draw() const {
 template <typename T, int n>
 void PSurfParamLinesVisualizer<T,n>::update() {
 
-  DMatrix< DMatrix< Vector<T, n>>>& p = *(this->_p);
+  DSampleGrid< Vector<T, n> >& p = *(this->_p);
   DMatrix<Vector<float,n>>&   normals = *(this->_n);
 
   PSurfVisualizer<T,n>::fillStandardVBO( _vbo, p );
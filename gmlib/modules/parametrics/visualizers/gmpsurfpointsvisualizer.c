@@ -93,7 +93,7 @@ namespace GMlib {
   inline
   void PSurfPointsVisualizer<T,n>::update() {
 
-    DMatrix< DMatrix< Vector<T, n> > >& p = *(this->_p);
+    DSampleGrid< Vector<T, n> >& p = *(this->_p);
 
     _no_points = p.getDim1() * p.getDim2();
     _vbo.bufferData( _no_points * sizeof(GL::GLVertex), 0x0, GL_STATIC_DRAW );
@@ -102,7 +102,7 @@ namespace GMlib {
     if( vtx ) {
       for( int i = 0; i < p.getDim1(); i++ ) {
         for( int j = 0; j < p.getDim2(); j++ ) {
-          const Point<T,3> &pos = p(i)(j)(0)(0);
+          const Point<T,3> &pos = p(i,j);
           (*vtx).x = pos(0);
           (*vtx).y = pos(1);
           (*vtx).z = pos(2);
@@ -163,7 +163,7 @@ namespace GMlib {
   inline
   void PSurfTexVisualizer<T,n>::update() {
 
-    DMatrix< DMatrix< Vector<T, n> > >& p = *(this->_p);
+    DSampleGrid< Vector<T, n> >& p = *(this->_p);
     DMatrix<Vector<float,n>>&     normals = *(this->_n);
 
     PSurfVisualizer<T,n>::fillStandardVBO( _vbo, p );
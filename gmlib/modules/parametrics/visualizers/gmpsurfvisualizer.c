@@ -44,7 +44,7 @@ template <typename T, int n>
 PSurfVisualizer<T,n>::PSurfVisualizer(): _p(nullptr), _n(nullptr) {_closed[0]=_closed[1]=false;}
 
 template <typename T, int n>
-PSurfVisualizer<T,n>::PSurfVisualizer(DMatrix<DMatrix<Vector<T,n>>>& p, DMatrix<Vector<float,n>>& no): _p(&p), _n(&no) {_closed[0]=_closed[1]=false;}
+PSurfVisualizer<T,n>::PSurfVisualizer(DSampleGrid<Vector<T,n>>& p, DMatrix<Vector<float,n>>& no): _p(&p), _n(&no) {_closed[0]=_closed[1]=false;}
 
 template <typename T, int n>
 PSurfVisualizer<T,n>::PSurfVisualizer(const PSurfVisualizer<T,n>& copy): Visualizer(copy), _p(copy._p), _n(copy._n)  {_closed[0]=_closed[1]=false;}
@@ -55,7 +55,7 @@ PSurfVisualizer<T,n>::~PSurfVisualizer() {}
 
 template <typename T, int n>
 inline
-void PSurfVisualizer<T,n>::fillMap(GL::Texture& map, const DMatrix<DMatrix<Vector<T,n> > > &p, int d1, int d2, bool closed_u, bool closed_v) {
+void PSurfVisualizer<T,n>::fillMap(GL::Texture& map, const DSampleGrid<Vector<T,n>> &p, int d1, int d2, bool closed_u, bool closed_v) {
 
   int m1 = closed_u ? p.getDim1()-1 : p.getDim1();
   int m2 = closed_v ? p.getDim2()-1 : p.getDim2();
@@ -63,9 +63,10 @@ void PSurfVisualizer<T,n>::fillMap(GL::Texture& map, const DMatrix<DMatrix<Vecto
   DVector< Vector<float,3> > tex_data(m1*m2);
   Vector<float,3> *ptr = tex_data.getPtr();
 
-  for( int j = 0; j < m1; ++j )
+  const Vector<T,n>* q = p.getPlane(d1,d2);
+  for( int j = 0; j < m1; ++j, q += p.getDim2() )
     for( int i = 0; i < m2; ++i )
-      *ptr++ = p(i)(j)(d1)(d2);
+      *ptr++ = q[i];
 
   // Create Normal map texture and set texture parameters
   map.texImage2D( 0, GL_RGB16F, m2, m1, 0, GL_RGB, GL_FLOAT, tex_data.getPtr()->getPtr() );
@@ -140,19 +141,20 @@ void PSurfVisualizer<T,n>::fillStandardIBO( GLuint ibo_id, int m1, int m2 ) {
 template <typename T, int n>
 inline
 void PSurfVisualizer<T,n>::fillStandardVBO(GL::VertexBufferObject &vbo,
-                                       const DMatrix<DMatrix<Vector<T,n> > > &p) {
+                                       const DSampleGrid<Vector<T,n>> &p) {
 
   GLsizeiptr no_vertices = p.getDim1() * p.getDim2() * sizeof(GL::GLVertexTex2D);
 
   vbo.bufferData( no_vertices, 0x0, GL_STATIC_DRAW );
   GL::GLVertexTex2D *ptr = vbo.mapBuffer<GL::GLVertexTex2D>();
+  const Vector<T,n> *q = p.getPlane(0,0);
   for( int i = 0; i < p.getDim1(); i++ ) {
     float s = i/float(p.getDim1()-1);
-    for( int j = 0; j < p.getDim2(); j++, ptr++ ) {
+    for( int j = 0; j < p.getDim2(); j++, ptr++, q++ ) {
       // vertex position
-      ptr->x = p(i)(j)(0)(0)(0);
-      ptr->y = p(i)(j)(0)(0)(1);
-      ptr->z = p(i)(j)(0)(0)(2);
+      ptr->x = (*q)(0);
+      ptr->y = (*q)(1);
+      ptr->z = (*q)(2);
       // tex coords
       ptr->s = s;
       ptr->t = j/float(p.getDim2()-1);
@@ -285,7 +287,7 @@ void PSurfVisualizer<T,n>::fillTriangleStripTexVBO( GLuint vbo_id, int m1, int m
 
 template <typename T, int n>
 inline
-void PSurfVisualizer<T,n>::fillTriangleStripVBO( GLuint vbo_id, DMatrix< DMatrix< Vector<T,n> > >& p, int d1, int d2 ) {
+void PSurfVisualizer<T,n>::fillTriangleStripVBO( GLuint vbo_id, DSampleGrid< Vector<T,n> >& p, int d1, int d2 ) {
 
   int no_dp;
   int no_strips;
@@ -298,6 +300,7 @@ void PSurfVisualizer<T,n>::fillTriangleStripVBO( GLuint vbo_id, DMatrix< DMatrix
   float *ptr = static_cast<float*>(glMapBuffer( GL_ARRAY_BUFFER, GL_WRITE_ONLY ));
 
   if( ptr ) {
+    const Vector<T,n>* q = p.getPlane(d1,d2);
     for( int i = 0; i < p.getDim1()-1; i++ ) {
       const int idx_i = i*p.getDim2()*2;
       for( int j = 0; j < p.getDim2(); j++ ) {
@@ -305,8 +308,8 @@ void PSurfVisualizer<T,n>::fillTriangleStripVBO( GLuint vbo_id, DMatrix< DMatrix
         const int idx_j = (idx_i + (j*2))*3;
         for( int k = 0; k < 3; k++ ) {
           const int idx_k = idx_j + k;
-          ptr[idx_k]   = p[ i   ][j][d1][d2][k];
-          ptr[idx_k+3] = p[ i+1 ][j][d1][d2][k];
+          ptr[idx_k]   = q[  i   *p.getDim2()+j][k];
+          ptr[idx_k+3] = q[ (i+1)*p.getDim2()+j][k];
         }
       }
     }
@@ -331,7 +334,7 @@ void PSurfVisualizer<T,n>::compTriangleStripProperties(int m1, int m2, GLuint &n
 
 template <typename T, int n>
 inline
-void PSurfVisualizer<T,n>::getTriangleStripDataInfo( const DMatrix< DMatrix< Vector<T,n> > >& p, int& no_dp, int& no_strips, int& no_verts_per_strips ) {
+void PSurfVisualizer<T,n>::getTriangleStripDataInfo( const DSampleGrid< Vector<T,n> >& p, int& no_dp, int& no_strips, int& no_verts_per_strips ) {
 
   no_dp = (p.getDim1()-1) * p.getDim2() * 2;
   no_strips = p.getDim1()-1;
@@ -31,6 +31,7 @@
 // gmlib
 #include <core/types/gmpoint.h>
 #include <core/containers/gmdmatrix.h>
+#include <core/containers/gmdsamplegrid.h>
 #include <opengl/gmtexture.h>
 #include <opengl/bufferobjects/gmvertexbufferobject.h>
 #include <opengl/bufferobjects/gmindexbufferobject.h>
@@ -46,12 +47,12 @@ namespace GMlib {
   class PSurfVisualizer : public Visualizer {
   public:
     PSurfVisualizer();
-    PSurfVisualizer( DMatrix<DMatrix<Vector<T,n>>>& p, DMatrix<Vector<float,n>>& no );
+    PSurfVisualizer( DSampleGrid<Vector<T,n>>& p, DMatrix<Vector<float,n>>& no );
     PSurfVisualizer( const PSurfVisualizer<T,n>& copy );
 
     virtual ~PSurfVisualizer();
 
-    void set( DMatrix<DMatrix<Vector<T,n>>>& p ) { _p = &p; }
+    void set( DSampleGrid<Vector<T,n>>& p )      { _p = &p; }
     void set( DMatrix<Vector<float,n>>& no )      { _n = &no; }
     void set( bool closed_u, bool closed_v )     { _closed[0]=closed_u; _closed[1]=closed_v; }
 
@@ -61,21 +62,21 @@ namespace GMlib {
     virtual void  replot( const DVector<DVector<Vector<T, n>>>& p, const DMatrix<Vector<float,3>>& normals, int m, bool closed_u, bool closed_v );
 
 
-    static void   fillStandardVBO(GL::VertexBufferObject &vbo, const DMatrix< DMatrix< Vector<T,n> > >& p );
+    static void   fillStandardVBO(GL::VertexBufferObject &vbo, const DSampleGrid< Vector<T,n> >& p );
     static void   fillStandardVBO(GL::VertexBufferObject &vbo, const DVector<DVector<Vector<T,n> > >& p );
 
     static void   fillTriangleStripIBO(GL::IndexBufferObject& ibo, int m1, int m2, GLuint& no_strips, GLuint& no_strip_indices, GLsizei& strip_size );
     static void   fillNMap( GL::Texture& nmap, const DMatrix<Vector<float,3>>& normals, bool closed_u, bool closed_v);
     static void   compTriangleStripProperties( int m1, int m2, GLuint& no_strips, GLuint& no_strip_indices, GLsizei& strip_size );
 
-    static void   fillMap( GL::Texture& map, const DMatrix<DMatrix<Vector<T,n>>>& p, int d1, int d2, bool closed_u, bool closed_v );
+    static void   fillMap( GL::Texture& map, const DSampleGrid<Vector<T,n>>& p, int d1, int d2, bool closed_u, bool closed_v );
     static void   fillStandardIBO( GLuint vbo_id, int m1, int m2 );
     static void   fillTriangleStripTexVBO( GLuint vbo_id, int m1, int m2 );
     static void   fillTriangleStripNormalVBO( GLuint vbo_id, DMatrix< Vector<float,3> >& normals );
-    static void   fillTriangleStripVBO( GLuint vbo_id, DMatrix< DMatrix< Vector<T,n> > >& p, int d1 = 0, int d2 = 0 );
-    static void   getTriangleStripDataInfo( const DMatrix< DMatrix< Vector<T,n> > >& p, int& no_dp, int& no_strips, int& no_verts_per_strips );
+    static void   fillTriangleStripVBO( GLuint vbo_id, DSampleGrid< Vector<T,n> >& p, int d1 = 0, int d2 = 0 );
+    static void   getTriangleStripDataInfo( const DSampleGrid< Vector<T,n> >& p, int& no_dp, int& no_strips, int& no_verts_per_strips );
 
-    DMatrix<DMatrix<Vector<T,n>>>* _p;
+    DSampleGrid<Vector<T,n>>*      _p;
     DMatrix<Vector<float,n>>*      _n;
     bool                           _closed[2];
 
@@ -156,6 +156,25 @@ namespace GMlib {
   }
 
 
+  /*! float Camera::getProjectedRadius(const Sphere<float,3>& s) const
+   *  \brief The radius of a sphere on the screen, in pixels
+   *
+   *  The sphere is given in scene coordinates, and is projected using the vertical
+   *  opening angle and the height of the viewport. A sphere containing the camera
+   *  covers the whole viewport. Cameras with another projection override this.
+   *  \param[in] s  A sphere in scene coordinates
+   *  \return The projected radius in pixels
+   */
+  float Camera::getProjectedRadius(const Sphere<float,3>& s) const {
+
+    const HqMatrix<float,3> mat = _matrix*_matrix_scene_inv;
+    const float d = (mat*s.getPos()).getLength();
+
+    if(d <= s.getRadius()) return float(_h);
+    return 0.5f * _h * s.getRadius() / (d * _frustum_angle_tan);
+  }
+
+
   /*! HqMatrix<float,3>& Camera::getMatrix()
    *  \brief Pending Documentation
    *
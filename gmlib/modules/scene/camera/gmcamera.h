@@ -119,6 +119,7 @@ namespace GMlib {
     virtual double              deltaTranslate(SceneObject * obj);
     double                      getDistanceToObject(int, int);
     double                      getDistanceToObject(SceneObject* obj);
+    virtual float               getProjectedRadius(const Sphere<float,3>& s) const;
     virtual SceneObject*        lockTargetAtPixel(int,int);
 
     bool                        isCulling() const;
@@ -92,6 +92,20 @@ namespace GMlib {
   }
 
 
+  /*! float IsoCamera::getProjectedRadius(const Sphere<float,3>& s) const
+   *  \brief The radius of a sphere on the screen, in pixels
+   *
+   *  The orthographic projection does not depend on the distance, the viewport
+   *  height covers the view height 2*_horizontal.
+   *  \param[in] s  A sphere in scene coordinates
+   *  \return The projected radius in pixels
+   */
+  float IsoCamera::getProjectedRadius(const Sphere<float,3>& s) const {
+
+    return float(0.5 * getViewportH() * s.getRadius() / _horizontal);
+  }
+
+
 //  /*! void IsoCamera::go(bool stereo)
 //   *  \brief Pending Documentation
 //   *
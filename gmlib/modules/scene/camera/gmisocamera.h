@@ -60,6 +60,7 @@ namespace GMlib {
     ~IsoCamera();
 
     double          deltaTranslate(SceneObject *) override;
+    float           getProjectedRadius(const Sphere<float,3>& s) const override;
 
 //    void             go(bool stereo=false);
     void            lock(SceneObject* /*obj*/) override {}         //!< Disable locking
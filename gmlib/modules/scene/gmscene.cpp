@@ -366,6 +366,15 @@ namespace GMlib {
     }
   }
 
+  /*! void Scene::updateLod(const Camera& cam)
+   *  \brief Selects the level of detail of all objects seen from a camera
+   */
+  void Scene::updateLod(const Camera& cam) {
+
+    for( int i=0; i< _scene.getSize(); i++ )
+      _scene[i]->updateLod(cam);
+  }
+
   void Scene::init() {
 
     _timer_active   = false;
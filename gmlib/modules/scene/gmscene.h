@@ -101,6 +101,7 @@ namespace GMlib{
 
     void                        prepare();
     void                        simulate();
+    void                        updateLod(const Camera& cam);
     bool                        isRunning() const;
     virtual bool                toggleRun();
     void                        enabledFixedDt();
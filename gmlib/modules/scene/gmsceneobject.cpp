@@ -122,7 +122,17 @@ namespace GMlib {
    *
    *  Copy constructor
    */
-  SceneObject::SceneObject( const SceneObject& copy ) {
+  SceneObject::SceneObject( const SceneObject& copy ) : SceneObject( copy, true ) {}
+
+
+  /*! SceneObject::SceneObject( const SceneObject& copy, bool children )
+   *  Copy constructor, for copies that only need the object itself
+   *  (e.g. the evaluation state of a parametric object).
+   *
+   *  \param[in] copy      The object to copy
+   *  \param[in] children  Whether to copy the children
+   */
+  SceneObject::SceneObject( const SceneObject& copy, bool children ) {
 
     _copy_of          = &copy;
 
@@ -159,7 +169,7 @@ namespace GMlib {
     _dir_length             = -1;
 
     // update children
-    for( int i = 0; i < copy._children.getSize(); i++ ) {
+    for( int i = 0; children && i < copy._children.getSize(); i++ ) {
       SceneObject *child_copy = copy._children(i)->makeCopy();
       if( child_copy )
         _children += child_copy;
@@ -369,6 +379,13 @@ namespace GMlib {
     }
   }
 
+  /*! void SceneObject::localUpdateLod( const Camera& cam )
+   *  \brief Selects the level of detail of this object
+   *
+   *  Objects with more than one level of detail reimplement this.
+   */
+  void SceneObject::localUpdateLod( const Camera& /*cam*/ ) {}
+
   /*! void localSimulate(double dt)
    *  \brief Pending Documentation
    *
@@ -810,6 +827,21 @@ namespace GMlib {
   }
 
 
+  /*! void SceneObject::updateLod( const Camera& cam )
+   *  \brief Selects the level of detail of this object and its children
+   *
+   *  Called once for each frame, before the rendering using the camera.
+   *  \param[in] cam  The camera the scene is rendered with
+   */
+  void SceneObject::updateLod( const Camera& cam ) {
+
+    localUpdateLod(cam);
+
+    for(int i=0; i< _children.size(); i++)
+      _children[i]->updateLod(cam);
+  }
+
+
   void SceneObject::translate(const Vector<float,3>& trans_vector, bool propagate) {
 
     move(getMatrix()*trans_vector,propagate);
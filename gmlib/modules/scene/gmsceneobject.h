@@ -338,6 +338,7 @@ namespace GMlib{
     virtual void                        replot() const;
 
     virtual void                        simulate( double dt );
+    void                                updateLod( const Camera& cam );
 
     void                                getRenderList( Array<const SceneObject*>&, const Camera& ) const;
     void                                getRenderList( Array<const SceneObject*>& ) const;
@@ -402,6 +403,8 @@ namespace GMlib{
     ArrayT<SceneObjectAttribute*>       _scene_object_attributes;
 
 
+    SceneObject( const SceneObject& copy, bool children );
+
     void                                reset();
 
     void                                setSurroundingSphere( const Sphere<float,3>& b ) const;
@@ -421,6 +424,7 @@ namespace GMlib{
                                                      const Point<float,3>& pos);
 
     virtual void                        localSimulate(double dt);
+    virtual void                        localUpdateLod(const Camera& cam);
 
 
   friend void Scene::prepare();
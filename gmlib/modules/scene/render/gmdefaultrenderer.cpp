@@ -432,6 +432,9 @@ namespace GMlib {
     Scene *scene = cam->getScene();
     assert(scene);
 
+    // Level of detail, before the objects are displayed
+    scene->updateLod( *cam );
+
     // Get displayable objects
     _objs.resetSize();
     scene->getRenderList( _objs, cam );
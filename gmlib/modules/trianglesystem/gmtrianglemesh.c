@@ -0,0 +1,1463 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+// gmlib
+#include "../core/utils/gmparallel.h"
+#include "../core/utils/gmpredicates.h"
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <random>
+#include <utility>
+
+
+namespace GMlib {
+
+
+
+  template <typename T>
+  inline
+  TriangleMesh<T>::TriangleMesh() : _no_strips(0) {}
+
+
+  template <typename T>
+  TriangleMesh<T>::TriangleMesh( const ArrayLX<TSVertex<T> >& v ) : _no_strips(0) {
+
+    reserve( v.size() );
+    for( int i = 0; i < v.size(); i++ )
+      insertVertex( v(i).getPosition() );
+  }
+
+
+  template <typename T>
+  TriangleMesh<T>::TriangleMesh( const std::vector<Point<T,3> >& p ) : _no_strips(0) {
+
+    reserve( int(p.size()) );
+    for( unsigned int i = 0; i < p.size(); i++ )
+      insertVertex( p[i] );
+  }
+
+
+  /** void TriangleMesh<T>::clear( bool vertices )
+   *  \brief Removes the triangles, and the vertices and constant edges if vertices is true
+   *
+   *  The memory is kept to be used again.
+   */
+  template <typename T>
+  void TriangleMesh<T>::clear( bool vertices ) {
+
+    if( vertices ) {
+      _pos.clear();
+      _nor.clear();
+      _vhe.clear();
+      _const.clear();
+    }
+    else
+      std::fill( _vhe.begin(), _vhe.end(), -1 );
+
+    _org.clear();
+    _twin.clear();
+  }
+
+
+  /** void TriangleMesh<T>::computeNormals()
+   *  \brief The normals of the vertices, the area weighted mean of the normals of the triangles
+   *
+   *  The normals are unit vectors, a vertex that is not in any triangle keeps its normal.
+   */
+  template <typename T>
+  void TriangleMesh<T>::computeNormals() {
+
+    std::vector<Vector<T,3> > sum( _pos.size(), Vector<T,3>( T(0) ) );
+    for( int t = 0; t < getNoTriangles(); t++ ) {
+      const Vector<T,3> n = getNormalTriangle( t );
+      for( int k = 0; k < 3; k++ )
+        sum[_org[3*t+k]] += n;
+    }
+
+    for( unsigned int i = 0; i < _pos.size(); i++ ) {
+      const T l = sum[i].getLength();
+      if( l > T(0) ) _nor[i] = sum[i] / l;
+    }
+  }
+
+
+  template <typename T>
+  Box<T,3> TriangleMesh<T>::getBoundBox() const {
+
+    if( _pos.empty() ) return Box<T,3>();
+
+    Box<T,3> box( _pos[0] );
+    for( unsigned int i = 1; i < _pos.size(); i++ )
+      box.insert( _pos[i] );
+    return box;
+  }
+
+
+  /** std::size_t TriangleMesh<T>::getMemoryUsage() const
+   *  \brief The number of bytes allocated for the vertices and half-edges
+   */
+  template <typename T>
+  std::size_t TriangleMesh<T>::getMemoryUsage() const {
+
+    return sizeof(*this)
+        + _pos.capacity()  * sizeof(Point<T,3>)
+        + _nor.capacity()  * sizeof(Vector<T,3>)
+        + _vhe.capacity()  * sizeof(int)
+        + _org.capacity()  * sizeof(int)
+        + _twin.capacity() * sizeof(int);
+  }
+
+
+  template <typename T>
+  int TriangleMesh<T>::getNoEdges() const {
+
+    int b = 0;
+    for( unsigned int h = 0; h < _twin.size(); h++ )
+      if( _twin[h] < 0 ) b++;
+
+    return ( int(_twin.size()) + b ) / 2;
+  }
+
+
+  /** int TriangleMesh<T>::getNoStrips() const
+   *  \brief The number of strips the last triangulateDelaunay() was made in
+   *
+   *  1 if it was made on one thread, or if the strips did not make a triangulation
+   *  of a convex polygon and it was made again on one thread. 0 before the first one.
+   */
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getNoStrips() const {
+
+    return _no_strips;
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getNoTriangles() const {
+
+    return int(_org.size()) / 3;
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getNoVertices() const {
+
+    return int(_pos.size());
+  }
+
+
+  /** int TriangleMesh<T>::insertVertex( const Point<T,3>& p )
+   *  \brief Adds a vertex, not connected to any triangle until the next triangulation
+   *
+   *  \return The index of the vertex
+   */
+  template <typename T>
+  int TriangleMesh<T>::insertVertex( const Point<T,3>& p ) {
+
+    _pos.push_back( p );
+    _nor.push_back( Vector<T,3>( T(0), T(0), T(1) ) );
+    _vhe.push_back( -1 );
+    return int(_pos.size()) - 1;
+  }
+
+
+  /** void TriangleMesh<T>::removeTriangle( int t )
+   *  \brief Removes a triangle, the last triangle is moved to index t
+   */
+  template <typename T>
+  void TriangleMesh<T>::removeTriangle( int t ) {
+
+    // The old twins, and unlink them
+    int tw[3];
+    for( int k = 0; k < 3; k++ ) {
+      tw[k] = _twin[3*t+k];
+      if( tw[k] >= 0 ) _twin[tw[k]] = -1;
+    }
+
+    // The vertices are now on the boundary, the outgoing half-edge in the neighbour over
+    // the previous edge is a boundary half-edge, else the vertex keeps its half-edge if it is
+    // in another triangle, or gets one from the neighbour over the next edge
+    for( int k = 0; k < 3; k++ ) {
+      const int v = _org[3*t+k];
+      const int p = tw[(k+2)%3];
+      const int n = tw[k];
+      if( p >= 0 )                  _vhe[v] = p;
+      else if( _vhe[v] / 3 != t )   continue;
+      else if( n >= 0 ) {
+        int g = getNext( n );
+        for( int i = 0; _twin[g] >= 0 && i < 1000000; i++ ) g = getNext( _twin[g] );
+        _vhe[v] = g;
+      }
+      else                          _vhe[v] = -1;
+    }
+
+    // Move the last triangle into the hole
+    const int l = getNoTriangles() - 1;
+    if( l != t )
+      for( int k = 0; k < 3; k++ ) {
+        const int h = 3*t+k, g = 3*l+k;
+        _org[h]  = _org[g];
+        _twin[h] = _twin[g];
+        if( _twin[h] >= 0 )      _twin[_twin[h]] = h;
+        if( _vhe[_org[h]] == g ) _vhe[_org[h]] = h;
+      }
+
+    _org.resize( 3*l );
+    _twin.resize( 3*l );
+  }
+
+
+  /** void TriangleMesh<T>::reserve( int no_vertices )
+   *  \brief Allocates the memory for no_vertices vertices and their triangulation in one go
+   */
+  template <typename T>
+  void TriangleMesh<T>::reserve( int no_vertices ) {
+
+    _pos.reserve( no_vertices + 3 );
+    _nor.reserve( no_vertices + 3 );
+    _vhe.reserve( no_vertices + 3 );
+    _org.reserve( 3 * (2*no_vertices + 2) );
+    _twin.reserve( 3 * (2*no_vertices + 2) );
+  }
+
+
+  /** void TriangleMesh<T>::set( const std::vector<Point<T,3> >& p, const std::vector<Vector<int,3> >& tri )
+   *  \brief Makes the mesh from the vertices and consistently oriented triangles
+   *
+   *  The twins are found by sorting the edges.
+   */
+  template <typename T>
+  void TriangleMesh<T>::set( const std::vector<Point<T,3> >& p, const std::vector<Vector<int,3> >& tri ) {
+
+    clear();
+    reserve( int(p.size()) );
+    for( unsigned int i = 0; i < p.size(); i++ )
+      insertVertex( p[i] );
+
+    for( unsigned int i = 0; i < tri.size(); i++ )
+      _setTriangle( _newTriangle(), tri[i](0), tri[i](1), tri[i](2) );
+
+    // Half-edges sorted by their (smallest, largest) vertex, twins are next to each other
+    std::vector<std::pair<std::pair<int,int>,int> > key( _org.size() );
+    for( unsigned int h = 0; h < _org.size(); h++ ) {
+      const int a = _org[h], b = getTarget( h );
+      key[h] = std::make_pair( std::make_pair( std::min( a, b ), std::max( a, b ) ), int(h) );
+    }
+    std::sort( key.begin(), key.end() );
+
+    for( unsigned int i = 0; i + 1 < key.size(); i++ )
+      if( key[i].first == key[i+1].first && _org[key[i].second] != _org[key[i+1].second] ) {
+        _link( key[i].second, key[i+1].second );
+        i++;
+      }
+
+    _updateVertexHalfEdges();
+  }
+
+
+  /** void TriangleMesh<T>::setConstEdge( int v0, int v1 )
+   *  \brief Makes the edge between vertex v0 and v1 constant, from the next triangulation
+   */
+  template <typename T>
+  void TriangleMesh<T>::setConstEdge( int v0, int v1 ) {
+
+    if( v0 != v1 )
+      _const.insert( std::make_pair( std::min( v0, v1 ), std::max( v0, v1 ) ) );
+  }
+
+
+  /** bool TriangleMesh<T>::triangulateDelaunay( int no_threads )
+   *  \brief The Delaunay triangulation of the vertices in (x,y)
+   *
+   *  As TriangleFacets<T>::triangulateDelaunay(): the vertices are inserted one by one into a
+   *  surrounding triangle, and the triangles are split and the edges swapped until they are
+   *  Delaunay. The surrounding triangle is then removed and the boundary is filled to be convex.
+   *
+   *  The vertices are inserted in a biased randomized insertion order (BRIO): rounds of random
+   *  samples doubling in size, each round sorted along a Hilbert curve. A new vertex is found by
+   *  walking from the triangle of the previous vertex, which is close by, so the expected time
+   *  is O(n log n) also for clustered points. The orientation and in-circle tests are exact.
+   *  Of vertices equal in (x,y) only the first one inserted is used.
+   *
+   *  With more than one thread the vertices are split in strips along x, one for each thread,
+   *  and the strips are triangulated concurrently. The triangles with a circumcircle inside their
+   *  strip are Delaunay for all the vertices. The rest of the vertices, along the seams and the
+   *  boundary, are triangulated again with the edges of those triangles as constant edges,
+   *  and fill the gaps. For vertices in general position (no four on a circle) this is the same
+   *  triangulation as with one thread. If the strips do not fit together, the triangulation is
+   *  made again on one thread, getNoStrips() then returns 1.
+   *
+   *  The constant edges are then inserted by edge swaps and the other edges swapped until the
+   *  triangulation is constrained Delaunay. A constant edge over a vertex is split at the vertex,
+   *  and one crossing a constant edge inserted before it (or at a vertex left out) is dropped,
+   *  it is then no longer a constant edge.
+   *
+   *  \param[in] no_threads  Number of threads, 0 uses all cores
+   *  \return False if a constant edge was dropped
+   */
+  template <typename T>
+  bool TriangleMesh<T>::triangulateDelaunay( int no_threads ) {
+
+    no_threads = Parallel::getNoThreads( no_threads );
+
+    // Strips of at least 1024 vertices
+    _no_strips = std::min( no_threads, getNoVertices() / 1024 );
+    if( _no_strips < 2 || !_triangulateStrips( _no_strips, no_threads ) ) {
+      _no_strips = 1;
+      _triangulate();
+    }
+
+    return _insertConstEdges();
+  }
+
+
+  /** bool TriangleMesh<T>::triangulateDelaunay( const std::vector<std::pair<int,int> >& border, std::vector<char>& covered )
+   *  \brief The Delaunay triangulation with border edges, to join it to triangles made before
+   *
+   *  The vertices are triangulated on one thread, with the border edges and the edges set by
+   *  setConstEdge() as constant edges. A border edge (a,b) is an edge of a triangle made before,
+   *  which is on its left. The triangles on the left of a border edge, and those connected to them
+   *  over edges that are not constant, are where the triangles made before are: they are covered.
+   *  The rest fill the gaps between them.
+   *
+   *  \param[in]  border   The border edges, pairs of vertices
+   *  \param[out] covered  For each triangle, if it is covered
+   *  \return False if a constant edge was dropped, the covered triangles may then be wrong
+   */
+  template <typename T>
+  bool TriangleMesh<T>::triangulateDelaunay( const std::vector<std::pair<int,int> >& border, std::vector<char>& covered ) {
+
+    _no_strips = 1;
+    return _triangulateBorder( border, covered );
+  }
+
+
+  template <typename T>
+  inline
+  const Vector<T,3>& TriangleMesh<T>::getNormal( int v ) const {
+
+    return _nor[v];
+  }
+
+
+  template <typename T>
+  inline
+  Point<T,2> TriangleMesh<T>::getParameter( int v ) const {
+
+    return Point<T,2>( _pos[v] );
+  }
+
+
+  template <typename T>
+  inline
+  const Point<T,3>& TriangleMesh<T>::getPosition( int v ) const {
+
+    return _pos[v];
+  }
+
+
+  /** void TriangleMesh<T>::getNeighbours( int v, std::vector<int>& nv ) const
+   *  \brief The vertices connected to vertex v by an edge, counter-clockwise
+   */
+  template <typename T>
+  void TriangleMesh<T>::getNeighbours( int v, std::vector<int>& nv ) const {
+
+    nv.clear();
+    const int h0 = _vhe[v];
+    if( h0 < 0 ) return;
+
+    int h = h0;
+    do {
+      nv.push_back( getTarget( h ) );
+      const int p = getPrev( h );
+      if( _twin[p] < 0 ) {
+        nv.push_back( _org[p] );
+        break;
+      }
+      h = _twin[p];
+    } while( h != h0 );
+  }
+
+
+  /** void TriangleMesh<T>::getOuterEdges( int v, std::vector<int>& he ) const
+   *  \brief The half-edges opposite to vertex v in its triangles, counter-clockwise
+   */
+  template <typename T>
+  void TriangleMesh<T>::getOuterEdges( int v, std::vector<int>& he ) const {
+
+    he.clear();
+    const int h0 = _vhe[v];
+    if( h0 < 0 ) return;
+
+    int h = h0;
+    do {
+      he.push_back( getNext( h ) );
+      h = _twin[getPrev( h )];
+    } while( h >= 0 && h != h0 );
+  }
+
+
+  /** void TriangleMesh<T>::getTriangles( int v, std::vector<int>& tri ) const
+   *  \brief The triangles around vertex v, counter-clockwise
+   */
+  template <typename T>
+  void TriangleMesh<T>::getTriangles( int v, std::vector<int>& tri ) const {
+
+    tri.clear();
+    const int h0 = _vhe[v];
+    if( h0 < 0 ) return;
+
+    int h = h0;
+    do {
+      tri.push_back( h / 3 );
+      h = _twin[getPrev( h )];
+    } while( h >= 0 && h != h0 );
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getVertexHalfEdge( int v ) const {
+
+    return _vhe[v];
+  }
+
+
+  template <typename T>
+  inline
+  bool TriangleMesh<T>::isBoundary( int v ) const {
+
+    return _vhe[v] >= 0 && _twin[_vhe[v]] < 0;
+  }
+
+
+  /** int TriangleMesh<T>::getAdjacent( int t, int k ) const
+   *  \brief The triangle on the other side of half-edge k (0, 1 or 2) of triangle t, -1 on the boundary
+   */
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getAdjacent( int t, int k ) const {
+
+    const int g = _twin[3*t+k];
+    return g < 0 ? -1 : g / 3;
+  }
+
+
+  template <typename T>
+  Vector<T,3> TriangleMesh<T>::getNormalTriangle( int t ) const {
+
+    const Point<T,3>& a = _pos[_org[3*t]];
+    return Vector<T,3>( _pos[_org[3*t+1]] - a ) ^ Vector<T,3>( _pos[_org[3*t+2]] - a );
+  }
+
+
+  template <typename T>
+  inline
+  Vector<int,3> TriangleMesh<T>::getTriangle( int t ) const {
+
+    return Vector<int,3>( _org[3*t], _org[3*t+1], _org[3*t+2] );
+  }
+
+
+  /** bool TriangleMesh<T>::isCircleInside( int t, double xmin, double xmax ) const
+   *  \brief True if the circumcircle of triangle t is inside xmin < x < xmax
+   *
+   *  The circle is computed in double, with a margin for the rounding errors,
+   *  so the answer is false if it is not certain. A triangle with its circumcircle between two
+   *  vertices is Delaunay for all the vertices in between, as in the strips of triangulateDelaunay().
+   */
+  template <typename T>
+  bool TriangleMesh<T>::isCircleInside( int t, double xmin, double xmax ) const {
+
+    const Point<T,3>& a = _pos[_org[3*t]];
+    const Point<T,3>& b = _pos[_org[3*t+1]];
+    const Point<T,3>& c = _pos[_org[3*t+2]];
+
+    const double bx = double(b[0]) - a[0], by = double(b[1]) - a[1];
+    const double cx = double(c[0]) - a[0], cy = double(c[1]) - a[1];
+    const double d  = bx*cy - by*cx;
+    const double b2 = bx*bx + by*by, c2 = cx*cx + cy*cy;
+    const double ux = ( cy*b2 - by*c2 ) / ( 2.0*d );
+    const double uy = ( bx*c2 - cx*b2 ) / ( 2.0*d );
+
+    const double x    = a[0] + ux;
+    const double r    = std::sqrt( ux*ux + uy*uy );
+    const double cond = ( std::fabs( bx*cy ) + std::fabs( by*cx ) ) / std::fabs( d );
+    const double eps  = 1e-12 * cond * ( std::fabs( x ) + r );
+
+    // False also for d = 0, the comparisons with NaN are false
+    return x - r - eps > xmin && x + r + eps < xmax;
+  }
+
+
+  /** void TriangleMesh<T>::getBoundary( std::vector<int>& he ) const
+   *  \brief The boundary half-edges, one loop after the other, counter-clockwise
+   */
+  template <typename T>
+  void TriangleMesh<T>::getBoundary( std::vector<int>& he ) const {
+
+    he.clear();
+    std::vector<char> done( _twin.size(), 0 );
+    for( unsigned int h0 = 0; h0 < _twin.size(); h0++ ) {
+
+      if( _twin[h0] >= 0 || done[h0] ) continue;
+      int h = h0;
+      do {
+        he.push_back( h );
+        done[h] = 1;
+
+        // The next boundary half-edge, around the target vertex
+        h = getNext( h );
+        while( _twin[h] >= 0 ) h = getNext( _twin[h] );
+      } while( !done[h] );
+    }
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getFace( int h ) const {
+
+    return h / 3;
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getNext( int h ) const {
+
+    return h % 3 == 2 ? h - 2 : h + 1;
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getOrigin( int h ) const {
+
+    return _org[h];
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getPrev( int h ) const {
+
+    return h % 3 == 0 ? h + 2 : h - 1;
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getTarget( int h ) const {
+
+    return _org[getNext( h )];
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::getTwin( int h ) const {
+
+    return _twin[h];
+  }
+
+
+  template <typename T>
+  inline
+  bool TriangleMesh<T>::isBoundaryEdge( int h ) const {
+
+    return _twin[h] < 0;
+  }
+
+
+  template <typename T>
+  inline
+  bool TriangleMesh<T>::isConstEdge( int h ) const {
+
+    if( _const.empty() ) return false;
+
+    const int a = _org[h], b = getTarget( h );
+    return _const.count( std::make_pair( std::min( a, b ), std::max( a, b ) ) ) > 0;
+  }
+
+
+
+
+  /** void TriangleMesh<T>::_brioOrder( std::vector<int>& order ) const
+   *  \brief The insertion order of the vertices
+   *
+   *  The vertices are shuffled (with a fixed seed, so the triangulation is reproducible),
+   *  the last half is the last round, the quarter before it the round before, and so on.
+   *  Each round is sorted along a Hilbert curve through the bounding box.
+   */
+  template <typename T>
+  void TriangleMesh<T>::_brioOrder( std::vector<int>& order ) const {
+
+    const int n = getNoVertices();
+    order.resize( n );
+    for( int i = 0; i < n; i++ ) order[i] = i;
+
+    std::mt19937 rnd( 5489u );
+    for( int i = n-1; i > 0; i-- )
+      std::swap( order[i], order[ rnd() % (i+1) ] );
+
+    const Box<T,3> box = getBoundBox();
+    const double sx = box.getValueDelta(0) > T(0) ? 65535.0 / box.getValueDelta(0) : 0.0;
+    const double sy = box.getValueDelta(1) > T(0) ? 65535.0 / box.getValueDelta(1) : 0.0;
+
+    std::vector<std::pair<unsigned int,int> > key( n );
+    for( int i = 0; i < n; i++ ) {
+      const Point<T,3>& p = _pos[order[i]];
+      key[i] = std::make_pair( _hilbert( (unsigned int)( ( p[0] - box.getValueMin(0) ) * sx ),
+                                         (unsigned int)( ( p[1] - box.getValueMin(1) ) * sy ) ), order[i] );
+    }
+
+    for( int end = n; end > 0; ) {
+      const int begin = end > 64 ? end / 2 : 0;
+      std::sort( key.begin() + begin, key.begin() + end );
+      end = begin;
+    }
+
+    for( int i = 0; i < n; i++ ) order[i] = key[i].second;
+  }
+
+
+  /** void TriangleMesh<T>::_fillConvex()
+   *  \brief Adds triangles where the boundary turns clockwise, until it is convex
+   *
+   *  The new triangles are made Delaunay by edge swaps after each round.
+   */
+  template <typename T>
+  void TriangleMesh<T>::_fillConvex() {
+
+    std::vector<int> stack;
+    for( bool changed = true; changed; ) {
+
+      changed = false;
+      int h0 = -1;
+      for( unsigned int h = 0; h < _twin.size() && h0 < 0; h++ )
+        if( _twin[h] < 0 ) h0 = h;
+      if( h0 < 0 ) return;
+
+      int h1 = h0;
+      do {
+        int h2 = getNext( h1 );
+        while( _twin[h2] >= 0 ) h2 = getNext( _twin[h2] );
+
+        const int a = _org[h1], b = _org[h2], c = getTarget( h2 );
+        if( a != c && _orient( _pos[a], _pos[b], Point<T,2>( _pos[c] ) ) < 0.0 ) {
+
+          // The triangle (a,c,b) over the two boundary edges
+          const int t = _newTriangle();
+          _setTriangle( t, a, c, b );
+          _link( 3*t+1, h2 );
+          _link( 3*t+2, h1 );
+          stack.push_back( 3*t+1 );
+          stack.push_back( 3*t+2 );
+
+          if( h1 == h0 || h2 == h0 ) h0 = 3*t;
+          h1 = 3*t;
+          changed = true;
+        }
+        else
+          h1 = h2;
+      } while( h1 != h0 );
+
+      // The swaps move the half-edges, so they are done after the walk around the boundary
+      _legalize( stack );
+    }
+  }
+
+
+  // The half-edge from a to b, or from b to a if there is only that one, -1 if a and b are not connected
+  template <typename T>
+  int TriangleMesh<T>::_findEdge( int a, int b ) const {
+
+    const int h0 = _vhe[a];
+    if( h0 < 0 ) return -1;
+
+    for( int h = h0; ; ) {
+      if( getTarget( h ) == b ) return h;
+      const int p = getPrev( h );
+      if( _twin[p] < 0 ) return _org[p] == b ? p : -1;
+      h = _twin[p];
+      if( h == h0 ) return -1;
+    }
+  }
+
+
+  /** void TriangleMesh<T>::_flip( int h, std::vector<int>& stack )
+   *  \brief Swaps the edge of half-edge h to the other diagonal of its two triangles
+   *
+   *  The four outer half-edges are pushed on the stack, to be checked.
+   */
+  template <typename T>
+  void TriangleMesh<T>::_flip( int h, std::vector<int>& stack ) {
+
+    const int g  = _twin[h];
+    const int t  = h / 3,  u = g / 3;
+    const int a  = _org[h], b = _org[g];
+    const int c  = _org[getPrev( h )];
+    const int d  = _org[getPrev( g )];
+    const int bc = _twin[getNext( h )], ca = _twin[getPrev( h )];
+    const int ad = _twin[getNext( g )], db = _twin[getPrev( g )];
+
+    _setTriangle( t, a, d, c );
+    _setTriangle( u, d, b, c );
+    _link( 3*t,   ad );
+    _link( 3*t+1, 3*u+2 );
+    _link( 3*t+2, ca );
+    _link( 3*u,   db );
+    _link( 3*u+1, bc );
+
+    stack.push_back( 3*t );
+    stack.push_back( 3*u );
+    stack.push_back( 3*t+2 );
+    stack.push_back( 3*u+1 );
+  }
+
+
+  // True if the vertex opposite of h in the twin triangle is inside the circumcircle of the triangle of h
+  template <typename T>
+  inline
+  bool TriangleMesh<T>::_inCircle( int h ) const {
+
+    const int g = _twin[h];
+    return _inCircle( _pos[_org[h]], _pos[_org[g]], _pos[_org[getPrev( h )]], _pos[_org[getPrev( g )]] ) > 0.0;
+  }
+
+
+  /** bool TriangleMesh<T>::_insertConstEdge( int a, int b, std::vector<std::pair<int,int> >& seg )
+   *  \brief Makes the edge from vertex a to b by edge swaps, and makes it constant
+   *
+   *  The edges crossing the segment from a to b are found by walking from a, and are swapped
+   *  one by one, a swap is put off while the two triangles are not convex, until none cross
+   *  (Sloan's algorithm). If the segment goes through a vertex, the two parts are pushed
+   *  on seg instead. If it crosses a constant edge or leaves the triangulation it is dropped.
+   *
+   *  \return False if the edge is dropped
+   */
+  template <typename T>
+  bool TriangleMesh<T>::_insertConstEdge( int a, int b, std::vector<std::pair<int,int> >& seg ) {
+
+    if( a == b ) return true;
+    if( _vhe[a] < 0 || _vhe[b] < 0 ) return false;
+
+    const Point<T,2> pb( _pos[b] );
+    const Vector<T,2> ab = pb - Point<T,2>( _pos[a] );
+
+    // True if vertex v is on the segment, it is then split at v
+    auto onSegment = [&]( int v ) -> bool {
+      const Point<T,2> pv( _pos[v] );
+      if( _orient( _pos[a], _pos[b], pv ) != 0.0 || ( pv - Point<T,2>( _pos[a] ) ) * ab <= T(0) )
+        return false;
+      seg.push_back( std::make_pair( v, b ) );
+      seg.push_back( std::make_pair( a, v ) );
+      return true;
+    };
+
+    // The triangle at a the segment goes into, and the edge it goes out over
+    int e = -1;
+    const int h0 = _vhe[a];
+    int h = h0;
+    do {
+      const int x = getTarget( h ), y = _org[getPrev( h )];
+      if( x == b || y == b ) break;
+      if( onSegment( x ) || onSegment( y ) ) return true;
+      if( _orient( _pos[a], _pos[b], Point<T,2>( _pos[x] ) ) < 0.0 &&
+          _orient( _pos[a], _pos[b], Point<T,2>( _pos[y] ) ) > 0.0 ) {
+        e = getNext( h );
+        break;
+      }
+      h = _twin[getPrev( h )];
+    } while( h >= 0 && h != h0 );
+
+    // The edges crossing the segment, each from the right to the left side
+    std::deque<std::pair<int,int> > cross;
+    for( ; e >= 0; ) {
+      if( isConstEdge( e ) ) return false;
+      cross.push_back( std::make_pair( _org[e], getTarget( e ) ) );
+
+      const int g = _twin[e];
+      if( g < 0 ) return false;
+      const int z = _org[getPrev( g )];
+      if( z == b ) break;
+      if( onSegment( z ) ) return true;
+      e = _orient( _pos[a], _pos[b], Point<T,2>( _pos[z] ) ) > 0.0 ? getNext( g ) : getPrev( g );
+    }
+
+    std::vector<int> stack;
+    while( !cross.empty() ) {
+
+      const int k = _findEdge( cross.front().first, cross.front().second );
+      const int x = _org[k], y = getTarget( k );
+      const int c = _org[getPrev( k )], d = _org[getPrev( _twin[k] )];
+      cross.pop_front();
+
+      // The two triangles after the swap must be counter-clockwise
+      if( _orient( _pos[x], _pos[d], Point<T,2>( _pos[c] ) ) <= 0.0 ||
+          _orient( _pos[d], _pos[y], Point<T,2>( _pos[c] ) ) <= 0.0 ) {
+        cross.push_back( std::make_pair( x, y ) );
+        continue;
+      }
+
+      const int t = k / 3, u = _twin[k] / 3;
+      _flip( k, stack );
+      stack.clear();
+      _updateVertexHalfEdges( t );
+      _updateVertexHalfEdges( u );
+
+      const double oc = _orient( _pos[a], _pos[b], Point<T,2>( _pos[c] ) );
+      const double od = _orient( _pos[a], _pos[b], Point<T,2>( _pos[d] ) );
+      if( ( oc < 0.0 && od > 0.0 ) || ( oc > 0.0 && od < 0.0 ) )
+        cross.push_back( std::make_pair( c, d ) );
+    }
+
+    if( _findEdge( a, b ) < 0 ) return false;
+    _const.insert( std::make_pair( std::min( a, b ), std::max( a, b ) ) );
+    return true;
+  }
+
+
+  /** bool TriangleMesh<T>::_insertConstEdges()
+   *  \brief Inserts the constant edges into the Delaunay triangulation
+   *
+   *  The other edges are then swapped until they are Delaunay, or
+   *  Delaunay but for the constant edges.
+   *
+   *  \return False if a constant edge (or a part of it) was dropped, see _insertConstEdge()
+   */
+  template <typename T>
+  bool TriangleMesh<T>::_insertConstEdges() {
+
+    if( _const.empty() ) return true;
+
+    const std::vector<std::pair<int,int> > edges( _const.begin(), _const.end() );
+    _const.clear();
+
+    bool all = true;
+    std::vector<std::pair<int,int> > seg;
+    for( unsigned int i = 0; i < edges.size(); i++ ) {
+      seg.push_back( edges[i] );
+      while( !seg.empty() ) {
+        const std::pair<int,int> s = seg.back();
+        seg.pop_back();
+        if( !_insertConstEdge( s.first, s.second, seg ) ) all = false;
+      }
+    }
+
+    std::vector<int> stack;
+    for( unsigned int h = 0; h < _twin.size(); h++ )
+      if( int(h) < _twin[h] ) stack.push_back( h );
+    _legalize( stack, true );
+
+    _updateVertexHalfEdges();
+    return all;
+  }
+
+
+  /** void TriangleMesh<T>::_insertLeftOut( const std::vector<char>& inserted )
+   *  \brief Inserts the vertices that were inserted, but are not in the triangulation of the convex hull
+   *
+   *  When the triangles of the surrounding triangle are removed in _triangulate(), a vertex at the end
+   *  of a line of vertices on the boundary can be left without triangles: the surrounding triangle
+   *  was on both sides of it. Such a vertex is inserted in the convex polygon again. A vertex inside
+   *  the polygon splits the triangle or the edge it is on, one outside of it gets a triangle on each
+   *  boundary edge it is on the outside of, so the polygon stays convex. If there are no triangles,
+   *  the first one is made of the first vertices not on a line.
+   *
+   *  The vertex half-edges must be up to date, they are updated again if a vertex is inserted.
+   */
+  template <typename T>
+  void TriangleMesh<T>::_insertLeftOut( const std::vector<char>& inserted ) {
+
+    std::vector<int> left;
+    for( int v = 0; v < int( inserted.size() ); v++ )
+      if( inserted[v] && _vhe[v] < 0 ) left.push_back( v );
+    if( left.empty() ) return;
+
+    std::vector<int>  stack, fan;
+    std::vector<char> done( left.size(), 0 );
+
+    if( getNoTriangles() == 0 ) {
+      unsigned int i = 1, j;
+      while( i < left.size() && Point<T,2>( _pos[left[i]] ) == Point<T,2>( _pos[left[0]] ) ) i++;
+      for( j = i+1; j < left.size(); j++ )
+        if( _orient( _pos[left[0]], _pos[left[i]], Point<T,2>( _pos[left[j]] ) ) != 0.0 ) break;
+      if( j >= left.size() ) return;
+
+      if( _orient( _pos[left[0]], _pos[left[i]], Point<T,2>( _pos[left[j]] ) ) > 0.0 )
+        _setTriangle( _newTriangle(), left[0], left[i], left[j] );
+      else
+        _setTriangle( _newTriangle(), left[0], left[j], left[i] );
+      done[0] = done[i] = done[j] = 1;
+    }
+
+    for( unsigned int i = 0; i < left.size(); i++ ) {
+      if( done[i] ) continue;
+
+      const int v = left[i];
+      const Point<T,2> p( _pos[v] );
+
+      int k;
+      const int t = _locate( p, 0, k );
+      if( t >= 0 ) {
+        _insertPoint( v, t, stack );
+        continue;
+      }
+
+      stack.clear();
+      fan.clear();
+      const int nh = int( _twin.size() );
+      for( int h = 0; h < nh; h++ )
+        if( _twin[h] < 0 && _orient( _pos[_org[h]], _pos[getTarget( h )], p ) < 0.0 ) {
+          const int u = _newTriangle();
+          _setTriangle( u, getTarget( h ), _org[h], v );
+          _link( 3*u, h );
+          stack.push_back( 3*u );
+          fan.push_back( u );
+        }
+
+      for( unsigned int a = 0; a < fan.size(); a++ )
+        for( unsigned int b = 0; b < fan.size(); b++ )
+          if( _org[3*fan[a]] == _org[3*fan[b]+1] )
+            _link( 3*fan[a]+2, 3*fan[b]+1 );
+
+      _legalize( stack );
+    }
+
+    _updateVertexHalfEdges();
+  }
+
+
+  /** int TriangleMesh<T>::_insertPoint( int v, int t, std::vector<int>& stack )
+   *  \brief Inserts vertex v into the triangulation, searching from triangle t
+   *
+   *  \return A triangle at the vertex, to start the next search from
+   */
+  template <typename T>
+  int TriangleMesh<T>::_insertPoint( int v, int t, std::vector<int>& stack ) {
+
+    int k;
+    t = _locate( Point<T,2>( _pos[v] ), t, k );
+    if( t < 0 || k >= 3 ) return std::max( t, 0 );     // Outside or on a vertex
+
+    stack.clear();
+    if( k < 0 ) _splitTriangle( v, t, stack );
+    else        _splitEdge( v, 3*t+k, stack );
+    _legalize( stack );
+
+    return t;
+  }
+
+
+  // Swaps the edges on the stack until they are Delaunay, not the constant edges if keep_const is true
+  template <typename T>
+  void TriangleMesh<T>::_legalize( std::vector<int>& stack, bool keep_const ) {
+
+    while( !stack.empty() ) {
+      const int h = stack.back();
+      stack.pop_back();
+      if( _twin[h] >= 0 && !( keep_const && isConstEdge( h ) ) && _inCircle( h ) )
+        _flip( h, stack );
+    }
+  }
+
+
+  template <typename T>
+  inline
+  void TriangleMesh<T>::_link( int h, int g ) {
+
+    _twin[h] = g;
+    if( g >= 0 ) _twin[g] = h;
+  }
+
+
+  /** int TriangleMesh<T>::_locate( const Point<T,2>& p, int t, int& k ) const
+   *  \brief Walks from triangle t to the triangle containing p
+   *
+   *  A remembering stochastic walk: it goes over the first edge p is on the outside of,
+   *  not back over the edge it came from, and the first edge tested is chosen at random,
+   *  so the walk can not go in circles.
+   *
+   *  \param[out] k  -1 if p is inside the triangle, 0-2 if p is on half-edge k,
+   *                 3-5 if p is on vertex k-3
+   *  \return The triangle, -1 if p is outside the triangulation
+   */
+  template <typename T>
+  int TriangleMesh<T>::_locate( const Point<T,2>& p, int t, int& k ) const {
+
+    unsigned int r = 2463534242u;     // xorshift
+    int from = -1;
+    for( ;; ) {
+
+      r ^= r << 13;  r ^= r >> 17;  r ^= r << 5;
+
+      double o[3];
+      int next = -1;
+      for( int j = 0; j < 3 && next < 0; j++ ) {
+        const int i = (j + r) % 3;
+        const int h = 3*t+i;
+        if( h == from ) {       // p is on the inside of the edge it came over
+          o[i] = 1.0;
+          continue;
+        }
+        o[i] = _orient( _pos[_org[h]], _pos[_org[getNext( h )]], p );
+        if( o[i] < 0.0 ) next = h;
+      }
+
+      if( next >= 0 ) {
+        from = _twin[next];
+        if( from < 0 ) return -1;
+        t = from / 3;
+        continue;
+      }
+
+      // Inside, or on an edge or a vertex
+      k = -1;
+      for( int i = 0; i < 3; i++ )
+        if( o[i] == 0.0 ) {
+          if( k >= 0 ) { k = 3 + ( i == (k+1)%3 ? i : k ); break; }
+          k = i;
+        }
+      return t;
+    }
+  }
+
+
+  template <typename T>
+  inline
+  int TriangleMesh<T>::_newTriangle() {
+
+    _org.resize( _org.size() + 3, -1 );
+    _twin.resize( _twin.size() + 3, -1 );
+    return getNoTriangles() - 1;
+  }
+
+
+  template <typename T>
+  inline
+  void TriangleMesh<T>::_setTriangle( int t, int v0, int v1, int v2 ) {
+
+    _org[3*t]   = v0;
+    _org[3*t+1] = v1;
+    _org[3*t+2] = v2;
+  }
+
+
+  /** void TriangleMesh<T>::_splitEdge( int v, int h, std::vector<int>& stack )
+   *  \brief Splits the edge of half-edge h at vertex v, and the one or two triangles of the edge
+   *
+   *  The edges opposite to v are pushed on the stack.
+   */
+  template <typename T>
+  void TriangleMesh<T>::_splitEdge( int v, int h, std::vector<int>& stack ) {
+
+    const int t  = h / 3;
+    const int a  = _org[h], b = _org[getNext( h )], c = _org[getPrev( h )];
+    const int bc = _twin[getNext( h )], ca = _twin[getPrev( h )];
+    const int g  = _twin[h];
+
+    const int t2 = _newTriangle();
+    _setTriangle( t,  a, v, c );
+    _setTriangle( t2, v, b, c );
+    _link( 3*t+2,  ca );
+    _link( 3*t2+1, bc );
+    _link( 3*t+1,  3*t2+2 );
+    stack.push_back( 3*t+2 );
+    stack.push_back( 3*t2+1 );
+
+    if( g < 0 ) {
+      _twin[3*t]  = -1;
+      _twin[3*t2] = -1;
+      return;
+    }
+
+    const int u  = g / 3;
+    const int d  = _org[getPrev( g )];
+    const int ad = _twin[getNext( g )], db = _twin[getPrev( g )];
+
+    const int u2 = _newTriangle();
+    _setTriangle( u,  b, v, d );
+    _setTriangle( u2, v, a, d );
+    _link( 3*u+2,  db );
+    _link( 3*u2+1, ad );
+    _link( 3*u+1,  3*u2+2 );
+    _link( 3*t,    3*u2 );
+    _link( 3*t2,   3*u );
+    stack.push_back( 3*u+2 );
+    stack.push_back( 3*u2+1 );
+  }
+
+
+  /** void TriangleMesh<T>::_splitTriangle( int v, int t, std::vector<int>& stack )
+   *  \brief Splits triangle t in three at vertex v
+   *
+   *  The edges opposite to v are pushed on the stack.
+   */
+  template <typename T>
+  void TriangleMesh<T>::_splitTriangle( int v, int t, std::vector<int>& stack ) {
+
+    const int a  = _org[3*t], b = _org[3*t+1], c = _org[3*t+2];
+    const int ab = _twin[3*t], bc = _twin[3*t+1], ca = _twin[3*t+2];
+
+    const int t1 = _newTriangle();
+    const int t2 = _newTriangle();
+    _setTriangle( t,  a, b, v );
+    _setTriangle( t1, b, c, v );
+    _setTriangle( t2, c, a, v );
+    _link( 3*t,    ab );
+    _link( 3*t1,   bc );
+    _link( 3*t2,   ca );
+    _link( 3*t+1,  3*t1+2 );
+    _link( 3*t1+1, 3*t2+2 );
+    _link( 3*t2+1, 3*t+2 );
+
+    stack.push_back( 3*t );
+    stack.push_back( 3*t1 );
+    stack.push_back( 3*t2 );
+  }
+
+
+  /** void TriangleMesh<T>::_triangulate()
+   *  \brief The Delaunay triangulation, inserting the vertices one by one
+   */
+  template <typename T>
+  void TriangleMesh<T>::_triangulate() {
+
+    clear( false );
+
+    const int n = getNoVertices();
+    if( n < 3 ) return;
+
+    reserve( n );
+
+    // The surrounding triangle
+    const Box<T,3> box = getBoundBox();
+    const T dx    = box.getValueDelta(0);
+    const T dy    = box.getValueDelta(1);
+    const T delta = dx > dy ? dx : dy;
+    if( delta <= T(0) ) return;
+
+    std::vector<int> order, stack;
+    _brioOrder( order );
+
+    insertVertex( Point<T,3>( box.getValueMin(0) - delta,   box.getValueMin(1) - delta,   T(0) ) );
+    insertVertex( Point<T,3>( box.getValueMax(0) + 3*delta, box.getValueMin(1) - delta,   T(0) ) );
+    insertVertex( Point<T,3>( box.getValueMin(0) - delta,   box.getValueMax(1) + 3*delta, T(0) ) );
+    _setTriangle( _newTriangle(), n, n+1, n+2 );
+
+    int t = 0;
+    for( int i = 0; i < n; i++ )
+      t = _insertPoint( order[i], t, stack );
+
+    // Remove the triangles of the surrounding triangle, the vertices in none of them were not inserted
+    _updateVertexHalfEdges();
+    std::vector<char> inserted( n );
+    for( int v = 0; v < n; v++ ) inserted[v] = _vhe[v] >= 0;
+
+    for( int i = getNoTriangles()-1; i >= 0; i-- )
+      if( _org[3*i] >= n || _org[3*i+1] >= n || _org[3*i+2] >= n )
+        removeTriangle( i );
+
+    _pos.resize( n );
+    _nor.resize( n );
+    _vhe.resize( n );
+
+    _fillConvex();
+    _updateVertexHalfEdges();
+    _insertLeftOut( inserted );
+  }
+
+
+  /** bool TriangleMesh<T>::_triangulateBorder( const std::vector<std::pair<int,int> >& border, std::vector<char>& covered )
+   *  \brief The Delaunay triangulation with border edges, see triangulateDelaunay( border, covered )
+   *
+   *  Used for the seams of the strips of _triangulateStrips(), and for the tiles of TriangleStream.
+   */
+  template <typename T>
+  bool TriangleMesh<T>::_triangulateBorder( const std::vector<std::pair<int,int> >& border, std::vector<char>& covered ) {
+
+    for( unsigned int i = 0; i < border.size(); i++ )
+      setConstEdge( border[i].first, border[i].second );
+    _triangulate();
+    const bool all = _insertConstEdges();
+
+    // The triangles on the left of a border edge, and those connected to them over edges that are not constant
+    covered.assign( getNoTriangles(), 0 );
+    std::vector<int> stack;
+    for( unsigned int i = 0; i < border.size(); i++ ) {
+      const int h = _findEdge( border[i].first, border[i].second );
+      if( h >= 0 && _org[h] == border[i].first && !covered[h/3] ) {
+        covered[h/3] = 1;
+        stack.push_back( h/3 );
+      }
+    }
+    while( !stack.empty() ) {
+      const int t = stack.back();
+      stack.pop_back();
+      for( int h = 3*t; h < 3*t+3; h++ ) {
+        const int g = _twin[h];
+        if( g >= 0 && !covered[g/3] && !isConstEdge( h ) ) {
+          covered[g/3] = 1;
+          stack.push_back( g/3 );
+        }
+      }
+    }
+
+    return all;
+  }
+
+
+  /** bool TriangleMesh<T>::_triangulateStrips( int k, int no_threads )
+   *  \brief The Delaunay triangulation made in k strips along x, triangulated concurrently
+   *
+   *  The strips are split between vertices of different x, so a triangle with its circumcircle
+   *  between the last vertex of the strip before and the first vertex of the strip after is
+   *  Delaunay for all the vertices, it is final. The vertices on the boundary of a strip or
+   *  in a triangle that is not final (and those not in any triangle, if the strip has no triangles)
+   *  are triangulated again, with the edges of the final triangles as constant edges.
+   *  The triangles of it on the same side of those edges as the final triangles are dropped,
+   *  the rest fill the gaps.
+   *
+   *  \return False if an edge of a final triangle could not be inserted in the seams,
+   *          or the triangles do not make a triangulation of a convex polygon
+   */
+  template <typename T>
+  bool TriangleMesh<T>::_triangulateStrips( int k, int no_threads ) {
+
+    clear( false );
+
+    const int n = getNoVertices();
+
+    // The vertices sorted by x, split in strips from first[s] to first[s+1]
+    std::vector<int> order( n );
+    {
+      std::vector<std::pair<T,int> > key( n );
+      for( int i = 0; i < n; i++ ) key[i] = std::make_pair( _pos[i][0], i );
+      std::sort( key.begin(), key.end() );
+      for( int i = 0; i < n; i++ ) order[i] = key[i].second;
+    }
+
+    std::vector<int> first( 1, 0 );
+    for( int s = 1; s < k; s++ ) {
+      int i = std::max( int( (long long)n * s / k ), first.back() + 1 );
+      while( i < n && _pos[order[i]][0] == _pos[order[i-1]][0] ) i++;
+      if( i < n ) first.push_back( i );
+    }
+    first.push_back( n );
+    k = int(first.size()) - 1;
+    if( k < 2 ) return false;
+
+    // Each strip is triangulated, and its final triangles and seam vertices are found
+    std::vector<TriangleMesh<T> >  strip( k );
+    std::vector<std::vector<char> > fixed( k );
+    std::vector<std::vector<int> >  seam( k );
+
+    Parallel::forBlocks( 0, k, [&]( int b, int e ) {
+      for( int s = b; s < e; s++ ) {
+
+        TriangleMesh<T>& m = strip[s];
+        m.reserve( first[s+1] - first[s] );
+        for( int i = first[s]; i < first[s+1]; i++ )
+          m.insertVertex( _pos[order[i]] );
+        m._triangulate();
+
+        const double inf  = std::numeric_limits<double>::infinity();
+        const double xmin = s > 0   ? double( _pos[order[first[s]-1]][0] ) : -inf;
+        const double xmax = s < k-1 ? double( _pos[order[first[s+1]]][0] ) : inf;
+
+        std::vector<char> in_seam( m.getNoVertices(), m.getNoTriangles() == 0 );
+        fixed[s].resize( m.getNoTriangles() );
+        for( int t = 0; t < m.getNoTriangles(); t++ ) {
+          fixed[s][t] = m.isCircleInside( t, xmin, xmax );
+          for( int j = 3*t; j < 3*t+3; j++ )
+            if( !fixed[s][t] || m._twin[j] < 0 )
+              in_seam[m._org[j]] = 1;
+        }
+
+        for( int v = 0; v < m.getNoVertices(); v++ )
+          if( in_seam[v] ) seam[s].push_back( v );
+      }
+    }, no_threads, 1 );
+
+    // The seam vertices, and the edges between a final triangle and the rest as constant edges
+    std::vector<int> index( n, -1 );
+    TriangleMesh<T> sm;
+    std::vector<int> sv;
+    for( int s = 0; s < k; s++ )
+      for( unsigned int i = 0; i < seam[s].size(); i++ ) {
+        const int v = order[first[s] + seam[s][i]];
+        index[v] = sm.insertVertex( _pos[v] );
+        sv.push_back( v );
+      }
+
+    std::vector<std::pair<int,int> > border;
+    for( int s = 0; s < k; s++ ) {
+      const TriangleMesh<T>& m = strip[s];
+      for( int h = 0; h < 3*m.getNoTriangles(); h++ ) {
+        const int g = m._twin[h];
+        if( fixed[s][h/3] && ( g < 0 || !fixed[s][g/3] ) )
+          border.push_back( std::make_pair( index[order[first[s] + m._org[h]]], index[order[first[s] + m.getTarget( h )]] ) );
+      }
+    }
+
+    // The seam triangles covered by the final triangles are left out
+    std::vector<char> covered;
+    if( !sm._triangulateBorder( border, covered ) ) return false;
+
+    // The final triangles of the strips, then the seam triangles in the gaps, and the twins in them
+    std::vector<std::vector<int> > tri( k );
+    std::vector<int> seam_tri( sm.getNoTriangles(), -1 );
+    int no_tri = 0;
+    for( int s = 0; s < k; s++ ) {
+      tri[s].resize( fixed[s].size() );
+      for( unsigned int t = 0; t < fixed[s].size(); t++ )
+        tri[s][t] = fixed[s][t] ? no_tri++ : -1;
+    }
+    for( int t = 0; t < sm.getNoTriangles(); t++ )
+      if( !covered[t] ) seam_tri[t] = no_tri++;
+
+    _org.resize( 3*no_tri );
+    _twin.resize( 3*no_tri, -1 );
+
+    Parallel::forBlocks( 0, k, [&]( int b, int e ) {
+      for( int s = b; s < e; s++ ) {
+        const TriangleMesh<T>& m = strip[s];
+        for( int h = 0; h < 3*m.getNoTriangles(); h++ ) {
+          const int t = tri[s][h/3], g = m._twin[h];
+          if( t < 0 ) continue;
+          _org[3*t + h%3] = order[first[s] + m._org[h]];
+          if( g >= 0 && tri[s][g/3] >= 0 )
+            _twin[3*t + h%3] = 3*tri[s][g/3] + g%3;
+        }
+        strip[s] = TriangleMesh<T>();
+      }
+    }, no_threads, 1 );
+
+    for( int h = 0; h < 3*sm.getNoTriangles(); h++ ) {
+      const int t = seam_tri[h/3], g = sm._twin[h];
+      if( t < 0 ) continue;
+      _org[3*t + h%3] = sv[sm._org[h]];
+      if( g >= 0 && seam_tri[g/3] >= 0 )
+        _twin[3*t + h%3] = 3*seam_tri[g/3] + g%3;
+    }
+
+    // The twins between the strips and the seam, found by sorting the edges
+    std::vector<std::pair<std::pair<int,int>,int> > key;
+    for( int h = 0; h < 3*no_tri; h++ )
+      if( _twin[h] < 0 ) {
+        const int a = _org[h], c = getTarget( h );
+        key.push_back( std::make_pair( std::make_pair( std::min( a, c ), std::max( a, c ) ), h ) );
+      }
+    std::sort( key.begin(), key.end() );
+
+    int no_bnd = int(key.size());
+    for( unsigned int i = 0; i + 1 < key.size(); i++ )
+      if( key[i].first == key[i+1].first ) {
+        if( _org[key[i].second] == _org[key[i+1].second] ) return false;
+        if( i + 2 < key.size() && key[i+2].first == key[i].first ) return false;
+        _link( key[i].second, key[i+1].second );
+        no_bnd -= 2;
+        i++;
+      }
+
+    // A convex polygon (a disk) has no_tri = 2 V - B - 2, for V vertices and B boundary edges
+    _updateVertexHalfEdges();
+    const int no_ver = n - int( std::count( _vhe.begin(), _vhe.end(), -1 ) );
+    return no_tri == 2*no_ver - no_bnd - 2;
+  }
+
+
+  // Each vertex gets an outgoing half-edge, a boundary half-edge if there is one
+  template <typename T>
+  void TriangleMesh<T>::_updateVertexHalfEdges() {
+
+    std::fill( _vhe.begin(), _vhe.end(), -1 );
+    for( unsigned int h = 0; h < _org.size(); h++ )
+      if( _vhe[_org[h]] < 0 || _twin[h] < 0 )
+        _vhe[_org[h]] = h;
+  }
+
+
+  // As _updateVertexHalfEdges(), for the vertices of triangle t, after a swap
+  template <typename T>
+  void TriangleMesh<T>::_updateVertexHalfEdges( int t ) {
+
+    for( int h = 3*t; h < 3*t+3; h++ ) {
+      const int v = _org[h];
+      if( _vhe[v] < 0 || _org[_vhe[v]] != v || _twin[h] < 0 )
+        _vhe[v] = h;
+    }
+  }
+
+
+  // Positive if d is inside the circle through a, b and c (counter-clockwise), in (x,y)
+  template <typename T>
+  inline
+  double TriangleMesh<T>::_inCircle( const Point<T,3>& a, const Point<T,3>& b, const Point<T,3>& c, const Point<T,3>& d ) {
+
+    return Predicates::inCircle( a[0], a[1], b[0], b[1], c[0], c[1], d[0], d[1] );
+  }
+
+
+  // Positive if c is to the left of the line from a to b, in (x,y)
+  template <typename T>
+  inline
+  double TriangleMesh<T>::_orient( const Point<T,3>& a, const Point<T,3>& b, const Point<T,2>& c ) {
+
+    return Predicates::orient2D( a[0], a[1], b[0], b[1], c[0], c[1] );
+  }
+
+
+  // The index along a Hilbert curve through a 2^16 x 2^16 grid
+  template <typename T>
+  unsigned int TriangleMesh<T>::_hilbert( unsigned int x, unsigned int y ) {
+
+    const unsigned int n = 1u << 16;
+    unsigned int d = 0;
+    for( unsigned int s = n / 2; s > 0; s /= 2 ) {
+      const unsigned int rx = ( x & s ) > 0;
+      const unsigned int ry = ( y & s ) > 0;
+      d += s * s * ( (3 * rx) ^ ry );
+      if( ry == 0 ) {
+        if( rx == 1 ) {
+          x = n-1 - x;
+          y = n-1 - y;
+        }
+        std::swap( x, y );
+      }
+    }
+    return d;
+  }
+
+
+} // END namespace GMlib
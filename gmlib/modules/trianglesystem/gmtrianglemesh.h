@@ -0,0 +1,161 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+#ifndef GM_TRIANGLESYSTEM_TRIANGLEMESH_H
+#define GM_TRIANGLESYSTEM_TRIANGLEMESH_H
+
+
+// gmlib
+#include "../core/containers/gmarraylx.h"
+#include "../core/types/gmpoint.h"
+#include "gmtrianglesystem.h"
+
+// stl
+#include <cstddef>
+#include <set>
+#include <utility>
+#include <vector>
+
+
+namespace GMlib {
+
+
+  /** \class  TriangleMesh gmtrianglemesh.h <gmTriangleMesh>
+   *  \brief  A compact half-edge storage of a triangulation
+   *
+   *  An alternative to the TSVertex/TSEdge/TSTriangle objects of TriangleFacets,
+   *  with the same triangulation and queries, for large point sets.
+   *  Everything is kept in a few flat arrays of 32-bit indices:
+   *  triangle t owns the half-edges 3t, 3t+1 and 3t+2 (counter-clockwise in (x,y)),
+   *  so the next and previous half-edge are found without storage, and each half-edge
+   *  stores its origin vertex and its twin (-1 on the boundary). Each vertex stores
+   *  its position, normal and one outgoing half-edge (the boundary one if the vertex is
+   *  on the boundary, -1 if the vertex is not in any triangle).
+   *
+   *  The arrays are pools: a removed triangle is replaced by the last one, so the
+   *  triangles stay contiguous (and triangle indices are not stable over a removal),
+   *  and clear() keeps the memory to be used by the next triangulation.
+   *
+   *  Edges between given vertices can be made constant, as setConstEdge() of TriangleFacets:
+   *  the triangulation is then the constrained Delaunay triangulation.
+   */
+  template <typename T>
+  class TriangleMesh {
+  public:
+    TriangleMesh();
+    explicit TriangleMesh( const ArrayLX<TSVertex<T> >& v );
+    explicit TriangleMesh( const std::vector<Point<T,3> >& p );
+
+    void                              clear( bool vertices = true );
+    void                              computeNormals();
+    Box<T,3>                          getBoundBox() const;
+    std::size_t                       getMemoryUsage() const;
+    int                               getNoEdges() const;
+    int                               getNoStrips() const;
+    int                               getNoTriangles() const;
+    int                               getNoVertices() const;
+    int                               insertVertex( const Point<T,3>& p );
+    void                              removeTriangle( int t );
+    void                              reserve( int no_vertices );
+    void                              set( const std::vector<Point<T,3> >& p, const std::vector<Vector<int,3> >& tri );
+    void                              setConstEdge( int v0, int v1 );
+    bool                              triangulateDelaunay( int no_threads = 1 );
+    bool                              triangulateDelaunay( const std::vector<std::pair<int,int> >& border,
+                                                           std::vector<char>& covered );
+
+    // Vertices
+    const Vector<T,3>&                getNormal( int v ) const;
+    Point<T,2>                        getParameter( int v ) const;
+    const Point<T,3>&                 getPosition( int v ) const;
+    void                              getNeighbours( int v, std::vector<int>& nv ) const;
+    void                              getOuterEdges( int v, std::vector<int>& he ) const;
+    void                              getTriangles( int v, std::vector<int>& tri ) const;
+    int                               getVertexHalfEdge( int v ) const;
+    bool                              isBoundary( int v ) const;
+
+    // Triangles
+    int                               getAdjacent( int t, int k ) const;
+    Vector<T,3>                       getNormalTriangle( int t ) const;
+    Vector<int,3>                     getTriangle( int t ) const;
+    bool                              isCircleInside( int t, double xmin, double xmax ) const;
+
+    // Half-edges
+    void                              getBoundary( std::vector<int>& he ) const;
+    int                               getFace( int h ) const;
+    int                               getNext( int h ) const;
+    int                               getOrigin( int h ) const;
+    int                               getPrev( int h ) const;
+    int                               getTarget( int h ) const;
+    int                               getTwin( int h ) const;
+    bool                              isBoundaryEdge( int h ) const;
+    bool                              isConstEdge( int h ) const;
+
+  private:
+    std::vector<Point<T,3> >          _pos;       // Vertex positions
+    std::vector<Vector<T,3> >         _nor;       // Vertex normals
+    std::vector<int>                  _vhe;       // An outgoing half-edge of each vertex
+    std::vector<int>                  _org;       // Origin vertex of each half-edge
+    std::vector<int>                  _twin;      // Twin of each half-edge, -1 on the boundary
+    std::set<std::pair<int,int> >     _const;     // Constant edges, (smallest, largest) vertex
+    int                               _no_strips; // Strips of the last triangulateDelaunay()
+
+    void                              _brioOrder( std::vector<int>& order ) const;
+    int                               _findEdge( int a, int b ) const;
+    void                              _flip( int h, std::vector<int>& stack );
+    bool                              _inCircle( int h ) const;
+    bool                              _insertConstEdge( int a, int b, std::vector<std::pair<int,int> >& seg );
+    bool                              _insertConstEdges();
+    void                              _insertLeftOut( const std::vector<char>& inserted );
+    int                               _insertPoint( int v, int t, std::vector<int>& stack );
+    void                              _legalize( std::vector<int>& stack, bool keep_const = false );
+    void                              _link( int h, int g );
+    int                               _locate( const Point<T,2>& p, int t, int& k ) const;
+    int                               _newTriangle();
+    void                              _fillConvex();
+    void                              _setTriangle( int t, int v0, int v1, int v2 );
+    void                              _splitEdge( int v, int h, std::vector<int>& stack );
+    void                              _splitTriangle( int v, int t, std::vector<int>& stack );
+    void                              _triangulate();
+    bool                              _triangulateBorder( const std::vector<std::pair<int,int> >& border,
+                                                          std::vector<char>& covered );
+    bool                              _triangulateStrips( int k, int no_threads );
+    void                              _updateVertexHalfEdges();
+    void                              _updateVertexHalfEdges( int t );
+
+    static double                     _inCircle( const Point<T,3>& a, const Point<T,3>& b,
+                                                 const Point<T,3>& c, const Point<T,3>& d );
+    static double                     _orient( const Point<T,3>& a, const Point<T,3>& b, const Point<T,2>& c );
+    static unsigned int               _hilbert( unsigned int x, unsigned int y );
+
+  }; // END class TriangleMesh
+
+
+} // END namespace GMlib
+
+
+// Include TriangleMesh class function implementations
+#include "gmtrianglemesh.c"
+
+
+#endif // GM_TRIANGLESYSTEM_TRIANGLEMESH_H
@@ -0,0 +1,409 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+// stl
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+
+namespace GMlib {
+
+
+
+  template <typename T>
+  inline
+  void TriangleStreamSink<T>::finalizeVertex( long long /*v*/ ) {}
+
+
+
+
+  template <typename T>
+  TriangleStream<T>::TriangleStream( int tile_size, int chunk_size )
+    : _chunk_size( std::max( chunk_size, 2 ) ), _tile_size( std::max( tile_size, 3 ) ),
+      _max_no_vertices( 0 ), _no_triangles( 0 ), _no_vertices( 0 ), _buffer( 0 ) {}
+
+
+  template <typename T>
+  inline
+  int TriangleStream<T>::getMaxNoVertices() const {
+
+    return _max_no_vertices;
+  }
+
+
+  template <typename T>
+  inline
+  long long TriangleStream<T>::getNoTriangles() const {
+
+    return _no_triangles;
+  }
+
+
+  template <typename T>
+  inline
+  long long TriangleStream<T>::getNoVertices() const {
+
+    return _no_vertices;
+  }
+
+
+  /** bool TriangleStream<T>::triangulate( std::istream& in, TriangleStreamSink<T>& sink, Format format )
+   *  \brief Reads the points of in to the end, and gives their Delaunay triangulation to sink
+   *
+   *  Of points equal in (x,y) only the first one is used.
+   *
+   *  \return False if a temporary file could not be made or written, nothing is given to sink then,
+   *          or if the tiles did not fit together (an edge between them could not be inserted),
+   *          the triangles given to sink may then overlap or leave gaps
+   */
+  template <typename T>
+  bool TriangleStream<T>::triangulate( std::istream& in, TriangleStreamSink<T>& sink, Format format ) {
+
+    _max_no_vertices = 0;
+    _no_triangles    = 0;
+    _no_vertices     = 0;
+
+    bool ok = _sortRuns( in, format ) && _mergeRuns();
+    if( ok ) {
+      _heapBegin();
+      ok = _triangulate( sink );
+    }
+
+    _closeRuns();
+    return ok;
+  }
+
+
+  // True if the next point of run i is after the next point of run j, for a heap with the first point on top
+  template <typename T>
+  inline
+  bool TriangleStream<T>::_after( int i, int j ) const {
+
+    return _less( _runs[j].buf[_runs[j].pos], _runs[i].buf[_runs[i].pos] );
+  }
+
+
+  template <typename T>
+  void TriangleStream<T>::_closeRuns() {
+
+    for( unsigned int i = 0; i < _runs.size(); i++ )
+      if( _runs[i].file ) std::fclose( _runs[i].file );
+
+    _runs.clear();
+    _heap.clear();
+  }
+
+
+  // Reads the next points of the run if all in buf are used, false if there are none left.
+  // The file holds (x,y,z) triples of T.
+  template <typename T>
+  bool TriangleStream<T>::_fill( Run& r ) {
+
+    if( r.pos < r.buf.size() ) return true;
+    if( !r.file )              return false;
+
+    std::vector<T> raw( 3*_buffer );
+    const std::size_t no = std::fread( raw.data(), 3*sizeof(T), _buffer, r.file );
+    r.buf.resize( no );
+    for( std::size_t i = 0; i < no; i++ )
+      r.buf[i] = Point<T,3>( raw[3*i], raw[3*i+1], raw[3*i+2] );
+    r.pos = 0;
+    return !r.buf.empty();
+  }
+
+
+  // Starts merging the runs, each run has a part of a chunk in memory at a time
+  template <typename T>
+  void TriangleStream<T>::_heapBegin() {
+
+    _buffer = std::max( std::size_t(1024), std::size_t(_chunk_size) / std::max( std::size_t(1), _runs.size() ) );
+
+    _heap.clear();
+    for( unsigned int i = 0; i < _runs.size(); i++ )
+      if( _fill( _runs[i] ) ) _heap.push_back( int(i) );
+
+    std::make_heap( _heap.begin(), _heap.end(), [this]( int i, int j ) { return _after( i, j ); } );
+  }
+
+
+  // The next point of the merged runs, false if there are none left
+  template <typename T>
+  bool TriangleStream<T>::_heapNext( Point<T,3>& p ) {
+
+    if( _heap.empty() ) return false;
+
+    const auto after = [this]( int i, int j ) { return _after( i, j ); };
+
+    std::pop_heap( _heap.begin(), _heap.end(), after );
+    Run& r = _runs[_heap.back()];
+    p = r.buf[r.pos++];
+
+    if( _fill( r ) ) std::push_heap( _heap.begin(), _heap.end(), after );
+    else             _heap.pop_back();
+
+    return true;
+  }
+
+
+  // The point _heapNext() gives next, NULL if there are none left
+  template <typename T>
+  inline
+  const Point<T,3>* TriangleStream<T>::_heapTop() const {
+
+    if( _heap.empty() ) return NULL;
+
+    const Run& r = _runs[_heap.front()];
+    return &r.buf[r.pos];
+  }
+
+
+  /** bool TriangleStream<T>::_mergeRuns()
+   *  \brief Merges the runs into fewer runs, until they can be merged at the same time
+   *
+   *  \return False if a temporary file could not be made or written
+   */
+  template <typename T>
+  bool TriangleStream<T>::_mergeRuns() {
+
+    const unsigned int max_runs = 64;
+
+    while( _runs.size() > max_runs ) {
+
+      std::vector<Run> rest( _runs.begin() + max_runs, _runs.end() );
+      _runs.resize( max_runs );
+      _heapBegin();
+
+      Run r;
+      r.file = NULL;
+      r.pos  = 0;
+      std::vector<Point<T,3> > p;
+      p.reserve( _buffer );
+      Point<T,3> q;
+      bool ok = true;
+      while( _heapNext( q ) ) {
+        p.push_back( q );
+        if( p.size() == _buffer ) {
+          ok = ok && _writeRun( r, p );
+          p.clear();
+        }
+      }
+      ok = ok && _writeRun( r, p );
+      if( ok ) std::rewind( r.file );
+
+      _closeRuns();
+      _runs.swap( rest );
+      if( !ok ) {
+        if( r.file ) std::fclose( r.file );
+        return false;
+      }
+      _runs.push_back( r );
+    }
+
+    return true;
+  }
+
+
+  template <typename T>
+  bool TriangleStream<T>::_read( std::istream& in, Format format, Point<T,3>& p ) const {
+
+    if( format == BINARY )
+      return bool( in.read( reinterpret_cast<char*>( p.getPtr() ), 3*sizeof(T) ) );
+
+    return bool( in >> p[0] >> p[1] >> p[2] );
+  }
+
+
+  /** bool TriangleStream<T>::_sortRuns( std::istream& in, Format format )
+   *  \brief Reads the points in chunks, sorts each chunk and writes it to a temporary file as a run
+   *
+   *  If all the points are in the first chunk, it is kept in memory.
+   *
+   *  \return False if a temporary file could not be made or written
+   */
+  template <typename T>
+  bool TriangleStream<T>::_sortRuns( std::istream& in, Format format ) {
+
+    _closeRuns();
+
+    std::vector<Point<T,3> > chunk;
+    Point<T,3> p;
+    bool more = true;
+    while( more ) {
+
+      chunk.clear();
+      while( int(chunk.size()) < _chunk_size && ( more = _read( in, format, p ) ) )
+        chunk.push_back( p );
+      if( chunk.empty() ) break;
+
+      std::sort( chunk.begin(), chunk.end(), _less );
+
+      Run r;
+      r.file = NULL;
+      r.pos  = 0;
+      if( !more && _runs.empty() )
+        r.buf.swap( chunk );
+      else if( !_writeRun( r, chunk ) ) {
+        if( r.file ) std::fclose( r.file );
+        return false;
+      }
+      else
+        std::rewind( r.file );
+
+      _runs.push_back( r );
+    }
+
+    return true;
+  }
+
+
+  /** bool TriangleStream<T>::_triangulate( TriangleStreamSink<T>& sink )
+   *  \brief Triangulates the points of the merged runs tile by tile
+   *
+   *  Each tile is triangulated by TriangleMesh::triangulateDelaunay( border, covered ), the triangles
+   *  covered by the final triangles are dropped. Of the rest, those with a circumcircle to the left
+   *  of the next point are final.
+   *
+   *  \return False if an edge between the final triangles and the rest was dropped in a tile
+   */
+  template <typename T>
+  bool TriangleStream<T>::_triangulate( TriangleStreamSink<T>& sink ) {
+
+    enum { OPEN, DROPPED, FINAL };
+
+    const double inf = std::numeric_limits<double>::infinity();
+
+    TriangleMesh<T>                   m;
+    std::vector<long long>            id, next_id;          // The number of each vertex of m
+    std::vector<std::pair<int,int> >  border, next_border;  // Constant edges, the final triangle on the left
+    std::vector<Point<T,3> >          keep_pos;
+    std::vector<char>                 state, keep, covered;
+    std::vector<int>                  index;
+    bool                              ok = true;
+
+    Point<T,3> p, last;
+    bool has_last = false;
+    for( double xmax = -inf; xmax < inf; ) {
+
+      // The next tile
+      for( int k = 0; k < _tile_size && _heapNext( p ); ) {
+        if( has_last && p[0] == last[0] && p[1] == last[1] ) continue;
+        last     = p;
+        has_last = true;
+        m.insertVertex( p );
+        id.push_back( _no_vertices );
+        sink.vertex( _no_vertices++, p );
+        k++;
+      }
+      _max_no_vertices = std::max( _max_no_vertices, m.getNoVertices() );
+
+      const Point<T,3>* next = _heapTop();
+      xmax = next ? double( (*next)[0] ) : inf;
+
+      // The triangles where the final triangles were are dropped
+      if( !m.triangulateDelaunay( border, covered ) ) ok = false;
+      const int nt = m.getNoTriangles();
+      state.assign( nt, OPEN );
+      for( int t = 0; t < nt; t++ )
+        if( covered[t] ) state[t] = DROPPED;
+
+      // The final triangles
+      for( int t = 0; t < nt; t++ )
+        if( state[t] == OPEN && m.isCircleInside( t, -inf, xmax ) ) {
+          state[t] = FINAL;
+          const Vector<int,3> v = m.getTriangle( t );
+          sink.triangle( id[v[0]], id[v[1]], id[v[2]] );
+          _no_triangles++;
+        }
+
+      // The vertices in a triangle that is not final or on an edge between a final triangle and the rest,
+      // or all if there are no triangles, are kept for the next tile
+      const int nv = m.getNoVertices();
+      keep.assign( nv, nt == 0 && xmax < inf );
+      next_border.clear();
+      for( int h = 0; h < 3*nt; h++ ) {
+        const int g = m.getTwin( h );
+        if( state[h/3] == OPEN )
+          keep[m.getOrigin( h )] = 1;
+        else if( ( g < 0 || state[g/3] == OPEN ) && xmax < inf ) {
+          next_border.push_back( std::make_pair( m.getOrigin( h ), m.getTarget( h ) ) );
+          keep[m.getOrigin( h )] = keep[m.getTarget( h )] = 1;
+        }
+      }
+
+      index.assign( nv, -1 );
+      keep_pos.clear();
+      next_id.clear();
+      for( int v = 0; v < nv; v++ )
+        if( keep[v] ) {
+          index[v] = int( keep_pos.size() );
+          keep_pos.push_back( m.getPosition( v ) );
+          next_id.push_back( id[v] );
+        }
+        else
+          sink.finalizeVertex( id[v] );
+
+      border.clear();
+      for( unsigned int i = 0; i < next_border.size(); i++ )
+        border.push_back( std::make_pair( index[next_border[i].first], index[next_border[i].second] ) );
+      id.swap( next_id );
+
+      m.clear();
+      for( unsigned int i = 0; i < keep_pos.size(); i++ )
+        m.insertVertex( keep_pos[i] );
+    }
+
+    return ok;
+  }
+
+
+  // Writes the points to the end of the run as (x,y,z) triples of T, makes the temporary file of the run if it has none
+  template <typename T>
+  bool TriangleStream<T>::_writeRun( Run& r, const std::vector<Point<T,3> >& p ) const {
+
+    if( !r.file ) {
+      r.file = std::tmpfile();
+      r.pos  = 0;
+      r.buf.clear();
+    }
+    if( !r.file ) return false;
+
+    std::vector<T> raw( 3*p.size() );
+    for( std::size_t i = 0; i < p.size(); i++ )
+      for( int k = 0; k < 3; k++ ) raw[3*i+k] = p[i][k];
+
+    return std::fwrite( raw.data(), 3*sizeof(T), p.size(), r.file ) == p.size();
+  }
+
+
+  // Sorted by x, then by y
+  template <typename T>
+  inline
+  bool TriangleStream<T>::_less( const Point<T,3>& a, const Point<T,3>& b ) {
+
+    return a[0] < b[0] || ( a[0] == b[0] && a[1] < b[1] );
+  }
+
+
+} // END namespace GMlib
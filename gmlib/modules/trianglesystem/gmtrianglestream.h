@@ -0,0 +1,135 @@
+/**********************************************************************************
+**
+** Copyright (C) 1994 Narvik University College
+** Contact: GMlib Online Portal at http://episteme.hin.no
+**
+** This file is part of the Geometric Modeling Library, GMlib.
+**
+** GMlib is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** GMlib is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with GMlib.  If not, see <http://www.gnu.org/licenses/>.
+**
+**********************************************************************************/
+
+
+
+#ifndef GM_TRIANGLESYSTEM_TRIANGLESTREAM_H
+#define GM_TRIANGLESYSTEM_TRIANGLESTREAM_H
+
+
+// gmlib
+#include "../core/types/gmpoint.h"
+#include "gmtrianglemesh.h"
+
+// stl
+#include <cstddef>
+#include <cstdio>
+#include <istream>
+#include <vector>
+
+
+namespace GMlib {
+
+
+
+  /** \class  TriangleStreamSink gmtrianglestream.h <gmTriangleStream>
+   *  \brief  Receives the vertices and triangles of a TriangleStream
+   *
+   *  The vertices are numbered from 0 in the order they are given, sorted by x.
+   *  A triangle is given after its vertices, counter-clockwise in (x,y), and a vertex
+   *  is finalized when all its triangles have been given.
+   */
+  template <typename T>
+  class TriangleStreamSink {
+  public:
+    virtual ~TriangleStreamSink() {}
+
+    virtual void                      finalizeVertex( long long v );
+    virtual void                      triangle( long long v0, long long v1, long long v2 ) = 0;
+    virtual void                      vertex( long long v, const Point<T,3>& p ) = 0;
+
+  }; // END class TriangleStreamSink
+
+
+
+  /** \class  TriangleStream gmtrianglestream.h <gmTriangleStream>
+   *  \brief  The Delaunay triangulation of more points than there is memory for
+   *
+   *  The points are read from a stream, as text or binary (x,y,z) triples of T, in chunks.
+   *  Each chunk is sorted by x and written to a temporary file, and the files are merged,
+   *  so the points come sorted by x and only a chunk of them is in memory.
+   *
+   *  The points are then triangulated in tiles along x, by a TriangleMesh, and a triangle
+   *  with its circumcircle to the left of the next point is Delaunay for all the points.
+   *  It is final: it is given to the sink, and its vertices are only kept while they are in
+   *  a triangle that is not final or on the boundary. The next tile is triangulated with
+   *  the kept vertices, with the edges between the final triangles and the rest as constant
+   *  edges, as the strips of TriangleMesh::triangulateDelaunay(). The memory used is then
+   *  about the size of a tile and of the front of the triangulation.
+   */
+  template <typename T>
+  class TriangleStream {
+  public:
+    enum Format {
+      TEXT,
+      BINARY
+    };
+
+    explicit TriangleStream( int tile_size = 1<<16, int chunk_size = 1<<22 );
+
+    int                               getMaxNoVertices() const;
+    long long                         getNoTriangles() const;
+    long long                         getNoVertices() const;
+    bool                              triangulate( std::istream& in, TriangleStreamSink<T>& sink, Format format = TEXT );
+
+  private:
+    struct Run {
+      std::FILE*                      file;       // The sorted points, NULL if they all are in buf
+      std::vector<Point<T,3> >        buf;        // The points read from the file
+      std::size_t                     pos;        // The next point in buf
+    };
+
+    int                               _chunk_size;      // Points sorted in memory at a time
+    int                               _tile_size;       // Points added to the triangulation at a time
+    int                               _max_no_vertices; // Most vertices in the triangulation at a time
+    long long                         _no_triangles;
+    long long                         _no_vertices;
+
+    std::vector<Run>                  _runs;      // The sorted chunks
+    std::vector<int>                  _heap;      // The runs with points left, by their next point
+    std::size_t                       _buffer;    // Points read from a run at a time
+
+    bool                              _after( int i, int j ) const;
+    void                              _closeRuns();
+    bool                              _fill( Run& r );
+    void                              _heapBegin();
+    bool                              _heapNext( Point<T,3>& p );
+    const Point<T,3>*                 _heapTop() const;
+    bool                              _mergeRuns();
+    bool                              _read( std::istream& in, Format format, Point<T,3>& p ) const;
+    bool                              _sortRuns( std::istream& in, Format format );
+    bool                              _triangulate( TriangleStreamSink<T>& sink );
+    bool                              _writeRun( Run& r, const std::vector<Point<T,3> >& p ) const;
+
+    static bool                       _less( const Point<T,3>& a, const Point<T,3>& b );
+
+  }; // END class TriangleStream
+
+
+} // END namespace GMlib
+
+
+// Include TriangleStream class function implementations
+#include "gmtrianglestream.c"
+
+
+#endif // GM_TRIANGLESYSTEM_TRIANGLESTREAM_H
@@ -23,10 +23,12 @@
 
 
 #include "visualizers/gmtrianglefacetsdefaultvisualizer.h"
+#include "gmtrianglemesh.h"
 
 // stl
 #include <cmath>
 #include <iostream>
+#include <unordered_map>
 
 
 namespace GMlib {
@@ -46,6 +48,8 @@ namespace GMlib {
     glGenBuffers( 1, &_ibo );
 
     _default_visualizer = 0x0;
+    _bvh_dirty          = true;
+    _vertex_hashed      = 0;
   }
 
 
@@ -62,6 +66,8 @@ namespace GMlib {
     glGenBuffers( 1, &_ibo );
 
     _default_visualizer = 0x0;
+    _bvh_dirty          = true;
+    _vertex_hashed      = 0;
   }
 
 
@@ -243,33 +249,128 @@ namespace GMlib {
   }
 
 
+  /** TSVertex<T>* TriangleFacets<T>::_find( const Point<T,3>& p ) const
+   *  \brief The first vertex at p, NULL if there is none
+   *
+   *  The vertices near p in (x,y) are found by _vertex_hash.
+   */
   template <typename T>
   TSVertex<T>*  TriangleFacets<T>::_find( const Point<T,3>& p ) const {
 
-    int i;
-    for( i = 0; i < this->getSize(); i++ )
-      if( this->getElement(i).getPosition() == p) break;
+    _hashUpdate();
+
+    int k = -1;
+    for( int di = -1; di <= 1; di++ )
+      for( int dj = -1; dj <= 1; dj++ ) {
+        const auto r = _vertex_hash.equal_range( _hashKey( Point<T,2>( p(0), p(1) ), di, dj ) );
+        for( auto it = r.first; it != r.second; ++it )
+          if( ( k < 0 || it->second < k ) && this->getElement(it->second).getPosition() == p )
+            k = it->second;
+      }
 
-    if (i < this->getSize()) return &( this->getElement(i));
+    if (k >= 0) return &( this->getElement(k));
     else			return NULL;
   }
 
 
+  // The edge between the vertex at p1 and a vertex at p2, found among the edges of the vertex
   template <typename T>
   TSEdge<T>*   TriangleFacets<T>::_find( const Point<T,3>& p1, const Point<T,3>& p2 ) const {
 
-    int i;
-    for(i=0; i<_edges.getSize(); i++)
-      if( _edges(i)->hasPoints( p1, p2 ) ) break;
+    TSVertex<T>* v = _find( p1 );
+    if( v == NULL ) return NULL;
 
-    if (i < _edges.getSize()) return _edges(i);
-    else			return NULL;
+    ArrayT<TSEdge<T>*>& edges = v->getEdges();
+    for( int i = 0; i < edges.getSize(); i++ )
+      if( edges[i]->getOtherVertex(*v)->getPosition() == p2 )
+        return edges[i];
+
+    return NULL;
+  }
+
+
+  /** int TriangleFacets<T>::_getIndex( const Point<T,2>& p ) const
+   *  \brief The index of the first vertex equal to p in (x,y), -1 if there is none
+   *
+   *  As getIndex() of the array, but the vertices are found by _vertex_hash.
+   *  Vertices are equal if the square of their distance is less than POS_TOLERANCE,
+   *  so the vertices equal to p are in the 3x3 cells around the cell of p.
+   */
+  template <typename T>
+  int TriangleFacets<T>::_getIndex( const Point<T,2>& p ) const {
+
+    _hashUpdate();
+
+    int k = -1;
+    for( int di = -1; di <= 1; di++ )
+      for( int dj = -1; dj <= 1; dj++ ) {
+        const auto r = _vertex_hash.equal_range( _hashKey( p, di, dj ) );
+        for( auto it = r.first; it != r.second; ++it )
+          if( ( k < 0 || it->second < k ) && this->getElement(it->second).getParameter() == p )
+            k = it->second;
+      }
+
+    return k;
+  }
+
+
+  template <typename T>
+  inline
+  void TriangleFacets<T>::_hashInsert( int i ) const {
+
+    _vertex_hash.insert( std::make_pair( _hashKey( this->getElement(i).getParameter() ), i ) );
+  }
+
+
+  // The key of the cell at p, or the cell (di,dj) cells from it. The cells are of size sqrt(POS_TOLERANCE).
+  template <typename T>
+  std::size_t TriangleFacets<T>::_hashKey( const Point<T,2>& p, int di, int dj ) const {
+
+    const double s = 1.0 / std::sqrt( double(POS_TOLERANCE) );
+    const long long i = (long long)( std::floor( p(0) * s ) ) + di;
+    const long long j = (long long)( std::floor( p(1) * s ) ) + dj;
+    return std::size_t( i * 0x9E3779B97F4A7C15ull ) ^ std::size_t( j );
+  }
+
+
+  template <typename T>
+  void TriangleFacets<T>::_hashRemove( int i ) const {
+
+    const auto r = _vertex_hash.equal_range( _hashKey( this->getElement(i).getParameter() ) );
+    for( auto it = r.first; it != r.second; ++it )
+      if( it->second == i ) {
+        _vertex_hash.erase( it );
+        return;
+      }
+  }
+
+
+  /** void TriangleFacets<T>::_hashUpdate() const
+   *  \brief Puts the vertices added to the array since the last time into _vertex_hash
+   *
+   *  If the array has fewer vertices than _vertex_hash, they have been removed directly
+   *  from the array, and _vertex_hash is made again. The vertices are hashed by their (x,y),
+   *  so replot() and triangulateDelaunay() clear it, in case a vertex has been moved.
+   */
+  template <typename T>
+  void TriangleFacets<T>::_hashUpdate() const {
+
+    if( _vertex_hashed > this->getSize() ) {
+      _vertex_hash.clear();
+      _vertex_hashed = 0;
+    }
+
+    if( _vertex_hash.empty() ) _vertex_hash.reserve( this->getSize() );
+    for( ; _vertex_hashed < this->getSize(); _vertex_hashed++ )
+      _hashInsert( _vertex_hashed );
   }
 
 
   template <typename T>
   void TriangleFacets<T>::_insertTriangle( TSTriangle<T>* t ) {
 
+    _bvh_dirty = true;
+
     _triangles += t;
 
     t->_updateBox( _u, _v, _d );
@@ -282,6 +383,45 @@ namespace GMlib {
   }
 
 
+  /** void TriangleFacets<T>::_makeTriOrder()
+   *  \brief Makes the empty grid of triangle lists used to find the triangle around a vertex
+   *
+   *  The grid covers _box, its size depends on the number of vertices.
+   */
+  template <typename T>
+  void TriangleFacets<T>::_makeTriOrder() {
+
+    if(this->getSize() < 200)         _d = 2;
+    else if(this->getSize() < 800)    _d = 3;
+    else if(this->getSize() < 3200)   _d = 4;
+    else if(this->getSize() < 12800)  _d = 5;
+    else if(this->getSize() < 51200)  _d = 6;
+    else if(this->getSize() < 204800) _d = 7;
+    else                              _d = 8;
+
+    int n = 1 << _d;
+
+    // The grid of a previous triangulation is not reused
+    _tri_order.setDim(n,n);
+    _u.resetSize();
+    _v.resetSize();
+    _u.setMaxSize(n+1);
+    _v.setMaxSize(n+1);
+
+    for(int i=0; i<= n; i++)
+    {
+      _u += _box.getValueMin(0) + i*_box.getValueDelta(0)/n;
+      _v += _box.getValueMin(1) + i*_box.getValueDelta(1)/n;
+    }
+
+    for(int i=0; i< n; i++)
+      for(int j=0; j< n; j++) {
+        _tri_order[i][j].resetSize();
+        _tri_order[i][j].setMaxSize(20);//,10);
+      }
+  }
+
+
   template <typename T>
   inline
   bool TriangleFacets<T>::_removeLastVertex() {
@@ -293,6 +433,8 @@ namespace GMlib {
   template <typename T>
   void TriangleFacets<T>::_removeTriangle( TSTriangle<T>* t ) {
 
+    _bvh_dirty = true;
+
     _triangles.remove(t);
 
     Box<unsigned char,2> b	= t->_getBox();
@@ -328,6 +470,42 @@ namespace GMlib {
   }
 
 
+  /** void TriangleFacets<T>::_set( const TriangleMesh<T>& mesh )
+   *  \brief Makes the edges and triangles from a triangulation of the vertices
+   *
+   *  The vertices of the mesh are the vertices of this, in the same order.
+   *  An edge goes as its first half-edge, so its first triangle is on the left,
+   *  and is constant if it is constant in the mesh.
+   */
+  template <typename T>
+  void TriangleFacets<T>::_set( const TriangleMesh<T>& mesh ) {
+
+    ArrayLX<TSVertex<T> >& vertex = *this;
+
+    const int nh = 3 * mesh.getNoTriangles();
+    std::vector<TSEdge<T>*> edge( nh, static_cast<TSEdge<T>*>(NULL) );
+    for( int h = 0; h < nh; h++ )
+      if( !edge[h] ) {
+        edge[h] = new TSEdge<T>( vertex[mesh.getOrigin(h)], vertex[mesh.getTarget(h)] );
+        if( mesh.isConstEdge(h) )  edge[h]->setConst();
+        if( mesh.getTwin(h) >= 0 ) edge[mesh.getTwin(h)] = edge[h];
+        _edges += edge[h];
+      }
+
+    std::vector<TSTriangle<T>*> tri( mesh.getNoTriangles() );
+    for( int t = 0; t < mesh.getNoTriangles(); t++ ) {
+      tri[t] = new TSTriangle<T>( edge[3*t], edge[3*t+1], edge[3*t+2] );
+      _insertTriangle( tri[t] );
+    }
+
+    for( int h = 0; h < nh; h++ ) {
+      const int g = mesh.getTwin(h);
+      if( g < 0 )     edge[h]->_setTriangle( tri[h/3], NULL );
+      else if( h < g) edge[h]->_setTriangle( tri[h/3], tri[g/3] );
+    }
+  }
+
+
   template <typename T>
   int  TriangleFacets<T>::_surroundingTriangle( TSTriangle<T>*& t, const TSVertex<T>& v ) {
 
@@ -404,6 +582,8 @@ namespace GMlib {
   template <typename T>
   void TriangleFacets<T>::clear( int d ) {
 
+    _bvh_dirty = true;
+
     __e.set(*this);
 
     while( _triangles.getSize() > 0 )
@@ -420,6 +600,9 @@ namespace GMlib {
 
     ArrayLX<TSVertex<T>>::clear();
 
+    _vertex_hash.clear();
+    _vertex_hashed = 0;
+
     if (d >= 0)
       _d = d;
 
@@ -511,6 +694,42 @@ namespace GMlib {
   }
 
 
+  /** const Bvh<T>& TriangleFacets<T>::getBvh() const
+   *  \brief A bounding volume hierarchy over the triangles
+   *
+   *  The parameters of the hits are the 2D (x,y) parameters of the vertices.
+   *  The hierarchy is updated the first time it is used after the triangulation is changed
+   *  or after replot(), refitted if the triangles are the same, otherwise rebuilt.
+   *  The update is not thread safe, the queries on the hierarchy are.
+   */
+  template <typename T>
+  const Bvh<T>& TriangleFacets<T>::getBvh() const {
+
+    if( _bvh_dirty ) {
+
+      std::vector<Point<T,3> >  p( this->getSize() );
+      std::vector<Point<T,2> >  par( this->getSize() );
+      std::unordered_map<const TSVertex<T>*, int> index;
+      for( int i = 0; i < this->getSize(); i++ ) {
+        const TSVertex<T>* v = getVertex(i);
+        p[i]     = v->getPosition();
+        par[i]   = v->getParameter();
+        index[v] = i;
+      }
+
+      std::vector<Vector<int,3> > tri( getNoTriangles() );
+      for( int i = 0; i < getNoTriangles(); i++ ) {
+        Array<TSVertex<T>*> v = getTriangle(i)->getVertices();
+        tri[i] = Vector<int,3>( index[v[0]], index[v[1]], index[v[2]] );
+      }
+
+      _bvh.update( p, tri, par );
+      _bvh_dirty = false;
+    }
+    return _bvh;
+  }
+
+
   template <typename T>
   inline
   TSEdge<T>* TriangleFacets<T>::getEdge( int i )	const	{
@@ -586,7 +805,7 @@ namespace GMlib {
     for(i=0; i<pwl.getSize()-1; i++)
     {
       insertVertex(pwl[i]);
-      j = index(pwl[i]);
+      j = _getIndex(pwl[i].getParameter());
       Point<T,2> p  = (*this)[j].getParameter();		// current point
       Point<T,2> np = pwl[i+1].getParameter();		// next new point
 
@@ -647,7 +866,7 @@ namespace GMlib {
             TSVertex<T> vt = pwl.interpolate(i,tt);///FEILLLL
             vt.setConst();
             insertVertex(vt);
-            j = this->getIndex(vt);
+            j = _getIndex(vt.getParameter());
             p  = (*this)[j].getParameter();
 
             edges = (*this)[j].getEdges();
@@ -670,11 +889,13 @@ namespace GMlib {
   template <typename T>
   bool TriangleFacets<T>::insertVertex( const TSVertex<T>& v, bool c ) {
 
+    _bvh_dirty = true;
+
     __e.set( *this );
 
     bool inserted = true;
 
-    int i = this->getIndex( v );
+    int i = _getIndex( v.getParameter() );
 
     if (i<0) {
 
@@ -686,7 +907,9 @@ namespace GMlib {
 
     if (!inserted)
     {
+      _hashRemove(i);
       (*this)[i]._set(v);			// Vertex is already a vertex
+      _hashInsert(i);
       return inserted;
     }
 
@@ -704,9 +927,11 @@ namespace GMlib {
   template <typename T>
   bool TriangleFacets<T>::removeVertex( TSVertex<T>& v ) {
 
+    _bvh_dirty = true;
+
     __e.set(*this);
 
-    int id = this->getIndex(v);
+    int id = _getIndex(v.getParameter());
     if( id < 0 ) return false;
 
     v._deleteEdges();
@@ -715,7 +940,17 @@ namespace GMlib {
     for ( int i=0; i < edges.getSize(); i++ )
       edges[i]->_swapVertex((*this)[this->getSize() - 1],(*this)[id]);
 
-    return this->removeIndex(id);
+    // The last vertex is moved to index id
+    const int last = this->getSize() - 1;
+    _hashRemove(id);
+    if( last != id ) _hashRemove(last);
+
+    bool removed = this->removeIndex(id);
+
+    if( last != id ) _hashInsert(id);
+    _vertex_hashed = this->getSize();
+
+    return removed;
   }
 
 
@@ -799,6 +1034,13 @@ namespace GMlib {
 
   template <typename T>
   void TriangleFacets<T>::replot() {
+
+    _bvh_dirty = true;
+
+    // The vertices may have been moved, _vertex_hash is made again when it is used
+    _vertex_hash.clear();
+    _vertex_hashed = 0;
+
     Sphere<float,3> s( getVertex(0)->getPos() );
     for( int j = 1; j < this->getSize(); j++ )
       s+= getVertex(j)->getPos();
@@ -832,8 +1074,26 @@ namespace GMlib {
   }
 
 
+  /** void TriangleFacets<T>::triangulateDelaunay( bool ordered, int no_threads )
+   *  \brief Makes the Delaunay triangulation of the vertices
+   *
+   *  The vertices are inserted in the given order, each one found by the grid _tri_order.
+   *  If ordered is true the triangulation is made by a TriangleMesh instead, which inserts
+   *  the vertices in a biased randomized Hilbert curve order with a walking search and exact
+   *  predicates, much faster for large or clustered sets of vertices, in strips along x on
+   *  no_threads threads. The edges and triangles are then made from it. The constant edges
+   *  of an earlier triangulation (setConstEdge(), insertLine()) are kept as constant edges,
+   *  the rest of its edges and triangles are removed.
+   *
+   *  \param[in] ordered     Triangulate by a TriangleMesh
+   *  \param[in] no_threads  Number of threads if ordered, 0 uses all cores
+   */
   template <typename T>
-  void TriangleFacets<T>::triangulateDelaunay() {
+  void TriangleFacets<T>::triangulateDelaunay( bool ordered, int no_threads ) {
+
+    _bvh_dirty = true;
+    _vertex_hash.clear();
+    _vertex_hashed = 0;
 
     __e.set( *this );
 
@@ -856,6 +1116,31 @@ namespace GMlib {
     for (i=1; i<vertex.getSize(); i++)
       _box += vertex[i].getPosition();
 
+    if( ordered ) {
+
+      TriangleMesh<T> mesh( vertex );
+
+      if( _edges.getSize() > 0 ) {
+        std::unordered_map<const TSVertex<T>*, int> index;
+        for( i = 0; i < vertex.getSize(); i++ )
+          index[getVertex(i)] = i;
+
+        for( i = 0; i < _edges.getSize(); i++ )
+          if( _edges[i]->_const )
+            mesh.setConstEdge( index[_edges[i]->_vertex[0]], index[_edges[i]->_vertex[1]] );
+
+        while( _triangles.getSize() > 0 )
+          delete _triangles[0];
+        while( _edges.getSize() > 0 )
+          delete _edges[0];
+      }
+
+      mesh.triangulateDelaunay( no_threads );
+      _makeTriOrder();
+      _set( mesh );
+      return;
+    }
+
     double dx	  = _box.getValueDelta(0);
     double dy	  = _box.getValueDelta(1);
     double delta  = dx>dy?dx:dy;
@@ -886,32 +1171,11 @@ namespace GMlib {
     // Here we constuct the dervided structure for speeding up the algoritm
     //**********************************************************************
 
-    if(this->getSize() < 200)         _d = 2;
-    else if(this->getSize() < 800)    _d = 3;
-    else if(this->getSize() < 3200)   _d = 4;
-    else if(this->getSize() < 12800)  _d = 5;
-    else if(this->getSize() < 51200)  _d = 6;
-    else if(this->getSize() < 204800) _d = 7;
-    else                              _d = 8;
-
-    int n = 1 << _d;
-
-    _tri_order.setDim(n,n);
-    _u.setMaxSize(n+1);
-    _v.setMaxSize(n+1);
+    _makeTriOrder();
 
-    for(i=0; i<= n; i++)
-    {
-      _u += _box.getValueMin(0) + i*_box.getValueDelta(0)/n;
-      _v += _box.getValueMin(1) + i*_box.getValueDelta(1)/n;
-    }
-
-    for(i=0; i< n; i++)
-      for(j=0; j< n; j++)
-      {
-        _tri_order[i][j].setMaxSize(20);//,10);
+    for(i=0; i< _tri_order.getDim1(); i++)
+      for(j=0; j< _tri_order.getDim2(); j++)
         _tri_order[i][j] += _triangles[0];
-      }
 
     //*****************************************************
     // End dervided structure for speeding up the algoritm
@@ -34,9 +34,14 @@
 #include "../core/containers/gmarray.h"
 #include "../core/containers/gmarrayt.h"
 #include "../core/containers/gmarraylx.h"
+#include "../core/containers/gmbvh.h"
 #include "../core/containers/gmdmatrix.h"
 #include "../scene/gmsceneobject.h"
 
+// stl
+#include <cstddef>
+#include <unordered_map>
+
 
 namespace GMlib {
 
@@ -75,6 +80,9 @@ namespace GMlib {
   template <typename T>
   class TSVEdge;
 
+  template <typename T>
+  class TriangleMesh;
+
 
   /** \class  TriangleFacets gmtrianglesystem.h <gmTriangleSystem>
    *  \brief  The storage class of the Triangle system
@@ -106,6 +114,7 @@ namespace GMlib {
 
     void                              createVoronoi();
     Box<T,3>                          getBoundBox() const;
+    const Bvh<T>&                     getBvh() const;
 
     TSEdge<T>*                        getEdge(int i) const;
     int                               getNoVertices() const;
@@ -113,7 +122,7 @@ namespace GMlib {
     int                               getNoTriangles() const;
 
     TSTriangle<T>*                    getTriangle(int i) const;
-    TSVertex<T>*                      getVertex(int i) const;
+    TSVertex<T>*                      getVertex(int i) const;   // Call replot() or triangulateDelaunay() after moving it in (x,y)
 
     const Array<TSVEdge<T> >&         getVoronoiEdges() const;
     const Array<Point<T,2> >&         getVoronoiPoints() const;
@@ -128,7 +137,7 @@ namespace GMlib {
 
     bool                              setConstEdge(const TSVertex<T>& v1, const TSVertex<T>& v2);
 
-    void                              triangulateDelaunay();
+    void                              triangulateDelaunay( bool ordered = false, int no_threads = 1 );
 
 
     void                              enableDefaultVisualizer( bool enable = true );
@@ -158,13 +167,26 @@ namespace GMlib {
     ArrayT<T>                         _v;
     Box<T,3>                          _box;
 
+    mutable Bvh<T>                    _bvh;
+    mutable bool                      _bvh_dirty;   // The triangles or vertices have changed since _bvh was updated
+
+    mutable std::unordered_multimap<std::size_t,int>  _vertex_hash;     // Vertex indices by their (x,y) cell
+    mutable int                                       _vertex_hashed;   // The vertices before it are in _vertex_hash
+
     TSVertex<T>                       __v;  // dummy because of MS-VC++ compiler
     TSEdge<T>                         __e;  // dummy because of MS-VC++ compiler
     TSTriangle<T>                     __t;  // dummy because of MS-VC++ compiler
 
     bool                              _fillPolygon(Array<TSEdge<T>*>&);
+    int                               _getIndex( const Point<T,2>& p ) const;
+    void                              _hashInsert( int i ) const;
+    std::size_t                       _hashKey( const Point<T,2>& p, int di = 0, int dj = 0 ) const;
+    void                              _hashRemove( int i ) const;
+    void                              _hashUpdate() const;
+    void                              _makeTriOrder();
     bool                              _removeLastVertex();
     void                              _set(int i);
+    void                              _set(const TriangleMesh<T>& mesh);
     int                               _surroundingTriangle(TSTriangle<T>*&, const TSVertex<T>&);// const;
 
 
@@ -22,6 +22,9 @@
 
 
 
+// stl
+#include <unordered_map>
+
 
 namespace GMlib {
 
@@ -69,13 +72,16 @@ namespace GMlib {
     DVector<GLuint> indices(no_indices);
     GLuint *iptr = indices.getPtr();
 
+    // The index of each vertex
+    std::unordered_map<const TSVertex<float>*, GLuint> index;
+    for( int k = 0; k < tf->getSize(); k++ )
+      index[tf->getVertex(k)] = k;
+
     for( int i = 0; i < tf->getNoTriangles(); i++ ) {
 
       Array< TSVertex<float>* > tri_verts = tf->getTriangle(i)->getVertices();
       for( int j = 0; j < tri_verts.getSize(); j++ )
-        for( int k = 0; k < tf->getSize(); k++ )
-          if( tri_verts[j] == tf->getVertex(k) )
-            *iptr++ = k;
+        *iptr++ = index[tri_verts[j]];
     }
 
     ibo.bufferData( no_indices * sizeof(GLuint), indices.getPtr(), GL_STATIC_DRAW );
@@ -0,0 +1,238 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <core/containers/gmbvh.h>
+#include <parametrics/surfaces/gmptorus.h>
+#include <parametrics/triangles/gmpbeziertriangle.h>
+using namespace GMlib;
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  // A wavy height field on [0,1]x[0,1], with the (x,y) of the vertices as parameters
+  struct Mesh {
+    std::vector<Point<double,3>>  p;
+    std::vector<Vector<int,3>>    tri;
+    std::vector<Point<double,2>>  par;
+
+    Mesh( int m, double a ) {
+      for( int i = 0; i < m; i++ )
+        for( int j = 0; j < m; j++ ) {
+          const double x = double(i)/(m-1), y = double(j)/(m-1);
+          p.push_back( Point<double,3>( x, y, a * std::sin( 7*x ) * std::cos( 5*y ) ) );
+          par.push_back( Point<double,2>( x, y ) );
+        }
+      for( int i = 0; i < m-1; i++ )
+        for( int j = 0; j < m-1; j++ ) {
+          const int k = i*m + j;
+          tri.push_back( Vector<int,3>( k, k+m, k+m+1 ) );
+          tri.push_back( Vector<int,3>( k, k+m+1, k+1 ) );
+        }
+    }
+  };
+
+
+  // Brute force references
+  double rayTriangle( const Mesh& mesh, int i, const Point<double,3>& o, const Vector<double,3>& d ) {
+
+    const Point<double,3>& a = mesh.p[mesh.tri[i][0]];
+    const Vector<double,3> e1 = mesh.p[mesh.tri[i][1]] - a;
+    const Vector<double,3> e2 = mesh.p[mesh.tri[i][2]] - a;
+    const Vector<double,3> n  = e1 ^ e2;
+    const double t = ((a - o) * n) / (d * n);
+    if( !(t >= 0.0) ) return -1.0;
+
+    // Inside if on the same side of all edges
+    const Point<double,3> x = o + t*d;
+    const Point<double,3>& b = mesh.p[mesh.tri[i][1]];
+    const Point<double,3>& c = mesh.p[mesh.tri[i][2]];
+    if( ((b - a) ^ (x - a)) * n < 0.0 ) return -1.0;
+    if( ((c - b) ^ (x - b)) * n < 0.0 ) return -1.0;
+    if( ((a - c) ^ (x - c)) * n < 0.0 ) return -1.0;
+    return t;
+  }
+
+  double pointTriangleDist( const Mesh& mesh, int i, const Point<double,3>& q ) {
+
+    // Dense sampling of the triangle, an upper bound close to the distance
+    double d = std::numeric_limits<double>::max();
+    const Point<double,3>& a = mesh.p[mesh.tri[i][0]];
+    const Vector<double,3> e1 = mesh.p[mesh.tri[i][1]] - a;
+    const Vector<double,3> e2 = mesh.p[mesh.tri[i][2]] - a;
+    for( int k = 0; k <= 40; k++ )
+      for( int l = 0; k + l <= 40; l++ )
+        d = std::min( d, (q - (a + (k/40.0)*e1 + (l/40.0)*e2)).getLength() );
+    return d;
+  }
+
+
+
+  TEST(Core_Containers, Bvh__Intersect) {
+
+    const Mesh mesh( 25, 0.1 );
+    Bvh<double> bvh;
+    bvh.build( mesh.p, mesh.tri, mesh.par );
+    EXPECT_EQ( int(mesh.tri.size()), bvh.getNoTriangles() );
+    EXPECT_LT( bvh.getNoNodes(), int(2*mesh.tri.size()) );
+
+    for( int r = 0; r < 200; r++ ) {
+
+      const Point<double,3>  o( 0.5 + 0.4*std::sin( 1.7*r ), 0.5 + 0.4*std::cos( 2.3*r ), 1.0 );
+      const Vector<double,3> d( 0.2*std::sin( 0.3*r ), 0.2*std::cos( 0.9*r ), -1.0 );
+
+      double gold = -1.0;
+      for( unsigned int i = 0; i < mesh.tri.size(); i++ ) {
+        const double t = rayTriangle( mesh, i, o, d );
+        if( t >= 0.0 && ( gold < 0.0 || t < gold ) ) gold = t;
+      }
+
+      Bvh<double>::Hit hit;
+      ASSERT_EQ( gold >= 0.0, bvh.intersect( o, d, hit ) );
+      if( gold < 0.0 ) continue;
+      EXPECT_NEAR( gold, hit.t, 1e-9 );
+
+      // The parameters are the (x,y) of the hit
+      EXPECT_NEAR( hit.pos[0], hit.par[0], 1e-9 );
+      EXPECT_NEAR( hit.pos[1], hit.par[1], 1e-9 );
+
+      // A ray shorter than the hit does not hit
+      EXPECT_FALSE( bvh.intersect( o, d, hit, 0.99*gold ) );
+    }
+  }
+
+
+
+  TEST(Core_Containers, Bvh__FindNearest) {
+
+    const Mesh mesh( 15, 0.2 );
+    Bvh<double> bvh;
+    bvh.build( mesh.p, mesh.tri, mesh.par );
+
+    for( int r = 0; r < 50; r++ ) {
+
+      const Point<double,3> q( 1.4*std::sin( 1.1*r ), 0.5 + 0.8*std::cos( 0.7*r ), 0.5*std::sin( 3.1*r ) );
+
+      double gold = std::numeric_limits<double>::max();
+      for( unsigned int i = 0; i < mesh.tri.size(); i++ )
+        gold = std::min( gold, pointTriangleDist( mesh, i, q ) );
+
+      Bvh<double>::Hit hit;
+      ASSERT_TRUE( bvh.findNearest( q, hit ) );
+      EXPECT_LE( hit.dist, gold + 1e-12 );
+      EXPECT_NEAR( gold, hit.dist, 1e-3 );
+      EXPECT_NEAR( hit.dist, (q - hit.pos).getLength(), 1e-12 );
+      EXPECT_FALSE( bvh.findNearest( q, hit, 0.99*hit.dist ) );
+    }
+  }
+
+
+
+  TEST(Core_Containers, Bvh__FindOverlapping) {
+
+    const Mesh mesh( 20, 0.1 );
+    Bvh<double> bvh;
+    bvh.build( mesh.p, mesh.tri, mesh.par );
+
+    const Box<double,3> b( Point<double,3>( 0.2, 0.3, -1.0 ), Point<double,3>( 0.45, 0.5, 0.02 ) );
+    std::vector<int> tri;
+    const int no = bvh.findOverlapping( b, tri );
+    EXPECT_EQ( int(tri.size()), no );
+
+    std::vector<int> gold;
+    for( unsigned int i = 0; i < mesh.tri.size(); i++ )
+      if( Box<double,3>( mesh.p[mesh.tri[i][0]], mesh.p[mesh.tri[i][1]], mesh.p[mesh.tri[i][2]] ).isIntersecting( b ) )
+        gold.push_back( i );
+
+    std::sort( tri.begin(), tri.end() );
+    EXPECT_GT( gold.size(), 0u );
+    EXPECT_EQ( gold, tri );
+  }
+
+
+
+  // A refitted hierarchy gives the same hits as a new one
+  TEST(Core_Containers, Bvh__Refit) {
+
+    const Mesh mesh( 20, 0.0 );
+    const Mesh moved( 20, 0.3 );
+
+    Bvh<double> bvh, gold;
+    EXPECT_TRUE( bvh.update( mesh.p, mesh.tri, mesh.par ) );
+    EXPECT_FALSE( bvh.update( moved.p, moved.tri, moved.par ) );
+    gold.build( moved.p, moved.tri, moved.par );
+
+    for( int r = 0; r < 100; r++ ) {
+
+      const Point<double,3>  o( 0.5 + 0.45*std::sin( 1.3*r ), 0.5 + 0.45*std::cos( 2.9*r ), 1.0 );
+      const Vector<double,3> d( 0.0, 0.0, -1.0 );
+
+      Bvh<double>::Hit h1, h2;
+      ASSERT_EQ( gold.intersect( o, d, h2 ), bvh.intersect( o, d, h1 ) );
+      EXPECT_EQ( h2.t, h1.t );
+
+      ASSERT_TRUE( bvh.findNearest( o, h1 ) );
+      ASSERT_TRUE( gold.findNearest( o, h2 ) );
+      EXPECT_EQ( h2.dist, h1.dist );
+    }
+  }
+
+
+
+  // Rays along the normals of a sampled torus must hit near the foot points
+  TEST(Parametrics_Bvh, PSurf) {
+
+    PTorus<float> torus( 3.0f, 1.0f, 1.0f );
+    torus.sample( 60, 40, 1, 1 );
+    EXPECT_EQ( 2*59*39, torus.getBvh().getNoTriangles() );
+
+    for( int i = 0; i < 100; i++ ) {
+
+      const float gu = 0.1f + 0.06f*i, gv = 0.2f + 0.059f*((i*37) % 100);
+      DMatrix<Vector<float,3>> r = torus.evaluate( gu, gv, 1, 1 );
+      const Vector<float,3> nrm = Vector<float,3>( r[1][0] ^ r[0][1] ).getNormalized();
+
+      float u, v;
+      ASSERT_TRUE( torus.getRayIntersection( r[0][0] + 0.5f * nrm, -nrm, u, v ) );
+      EXPECT_NEAR( gu, u, 1e-2f );
+      EXPECT_NEAR( gv, v, 1e-2f );
+    }
+
+    // A new sampling replaces the hierarchy
+    torus.sample( 20, 10, 1, 1 );
+    EXPECT_EQ( 2*19*9, torus.getBvh().getNoTriangles() );
+  }
+
+
+
+  TEST(Parametrics_Bvh, PTriangle) {
+
+    DVector<Vector<float,3>> c(3);
+    c[0] = Vector<float,3>( 0.0f, 0.0f, 0.0f );
+    c[1] = Vector<float,3>( 1.0f, 0.0f, 0.0f );
+    c[2] = Vector<float,3>( 0.0f, 1.0f, 0.0f );
+    PBezierTriangle<float> triangle( c );
+    EXPECT_TRUE( triangle.getBvh().isEmpty() );
+
+    triangle.replot( 10 );
+    const Bvh<float>& bvh = triangle.getBvh();
+    EXPECT_EQ( 81, bvh.getNoTriangles() );
+
+    // The parameters of the hit are the barycentric coordinates
+    Bvh<float>::Hit hit;
+    const Point<float,3> q = triangle.evaluate( 0.2f, 0.3f, 0 )[0];
+    ASSERT_TRUE( bvh.intersect( q + Vector<float,3>( 0.0f, 0.0f, 1.0f ), Vector<float,3>( 0.0f, 0.0f, -1.0f ), hit ) );
+    EXPECT_NEAR( 0.2f, hit.par[0], 1e-5f );
+    EXPECT_NEAR( 0.3f, hit.par[1], 1e-5f );
+  }
+
+}
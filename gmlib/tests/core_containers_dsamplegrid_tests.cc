@@ -0,0 +1,134 @@
+
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <core/containers/gmdsamplegrid.h>
+#include <core/utils/gmdivideddifferences.h>
+using namespace GMlib;
+
+// stl
+#include <cmath>
+#include <vector>
+
+namespace {
+
+  typedef Vector<float,3> Vec3;
+
+
+  TEST(Core_Containers, DSampleGrid__Layout) {
+
+    DSampleGrid<Vec3> p(5, 4, 1, 2);
+
+    EXPECT_EQ( 5,  p.getDim1() );
+    EXPECT_EQ( 4,  p.getDim2() );
+    EXPECT_EQ( 2,  p.getDerDim1() );
+    EXPECT_EQ( 3,  p.getDerDim2() );
+    EXPECT_EQ( 20, p.getPlaneSize() );
+
+    // Each plane is m1*m2 elements, row by row
+    for( int k = 0; k < 2; k++ )
+      for( int l = 0; l < 3; l++ )
+        for( int i = 0; i < 5; i++ )
+          for( int j = 0; j < 4; j++ )
+            EXPECT_EQ( &p(i,j,k,l), p.getPlane(k,l) + i*4 + j );
+
+    EXPECT_EQ( p.getPlane(0,0) + 20, p.getPlane(0,1) );
+    EXPECT_EQ( p.getPlane(0,0) + 60, p.getPlane(1,0) );
+  }
+
+
+  TEST(Core_Containers, DSampleGrid__Get_Set_Sample) {
+
+    DSampleGrid<Vec3> p(3, 3, 1, 1);
+
+    DMatrix<Vec3> s(2,2);
+    s[0][0] = Vec3(1,2,3);
+    s[0][1] = Vec3(4,5,6);
+    s[1][0] = Vec3(7,8,9);
+    s[1][1] = Vec3(10,11,12);
+    p.setSample( s, 1, 2 );
+
+    EXPECT_EQ( Vec3(1,2,3),    p(1,2) );
+    EXPECT_EQ( Vec3(4,5,6),    p(1,2,0,1) );
+    EXPECT_EQ( Vec3(7,8,9),    p(1,2,1,0) );
+    EXPECT_EQ( Vec3(10,11,12), p(1,2,1,1) );
+
+    DMatrix<Vec3> r;
+    p.getSample( r, 1, 2 );
+    EXPECT_EQ( 2, r.getDim1() );
+    EXPECT_EQ( 2, r.getDim2() );
+    for( int k = 0; k < 2; k++ )
+      for( int l = 0; l < 2; l++ )
+        EXPECT_EQ( s[k][l], r[k][l] );
+  }
+
+
+  TEST(Core_Containers, DSampleGrid__SetDim_Keeps_Memory) {
+
+    DSampleGrid<Vec3> p(64, 64, 1, 1);
+    const Vec3* ptr = p.getPlane(0,0);
+
+    p.setDim( 32, 48, 1, 1 );
+    EXPECT_EQ( ptr, p.getPlane(0,0) );
+
+    p.setDim( 64, 64, 1, 1 );
+    EXPECT_EQ( ptr, p.getPlane(0,0) );
+  }
+
+
+  // The divided differences on the sample grid must give the same result as
+  // the generic implementation on a matrix of matrices.
+  // The result must not depend on the number of threads.
+  TEST(Core_Utils, DD__Compute2D_DSampleGrid) {
+
+    const int m1 = 12;
+    const int m2 = 9;
+    const double du = 0.3;
+    const double dv = 0.2;
+
+    for( int nt : { 1, 2, 5, 0 } )
+    for( int closed = 0; closed < 2; closed++ ) {
+
+      DSampleGrid<Vec3>       p(m1, m2, 2, 2);
+      DMatrix<DMatrix<Vec3>>  gold(m1, m2, DMatrix<Vec3>(3,3));
+      for( int i = 0; i < m1; i++ )
+        for( int j = 0; j < m2; j++ ) {
+          const double u = i*du, v = j*dv;
+          p(i,j) = gold[i][j][0][0] = Vec3( std::cos(u)*(2+std::cos(v)), std::sin(u)*(2+std::cos(v)), std::sin(v) );
+        }
+
+      DD::compute2D( gold, du, dv, closed, closed, 2, 2 );
+      DD::compute2D( p,    du, dv, closed, closed, 2, 2, 0, 0, nt );
+
+      for( int i = 0; i < m1; i++ )
+        for( int j = 0; j < m2; j++ )
+          for( int k = 0; k < 3; k++ )
+            for( int l = 0; l < 3; l++ )
+              EXPECT_EQ( gold[i][j][k][l], p(i,j,k,l) );
+    }
+  }
+
+
+  // The three point divided differences on a non-uniform grid are exact for quadratic functions.
+  TEST(Core_Utils, DD__Compute2D_DSampleGrid_NonUniform) {
+
+    const std::vector<double> u = { 0.0, 0.1, 0.3, 0.35, 0.6, 1.0 };
+    const std::vector<double> v = { -1.0, -0.2, 0.0, 0.5, 0.55, 1.5, 2.0 };
+
+    DSampleGrid<Vec3> p( int(u.size()), int(v.size()), 1, 1 );
+    for( unsigned int i = 0; i < u.size(); i++ )
+      for( unsigned int j = 0; j < v.size(); j++ )
+        p(i,j) = Vec3( u[i]*u[i], v[j]*v[j], u[i]*v[j] );
+
+    DD::compute2D( p, u, v, false, false, 1, 1 );
+
+    for( unsigned int i = 0; i < u.size(); i++ )
+      for( unsigned int j = 0; j < v.size(); j++ ) {
+        EXPECT_NEAR( 0.0f, ( p(i,j,1,0) - Vec3( 2*u[i], 0, v[j] ) ).getLength(), 1e-4f );
+        EXPECT_NEAR( 0.0f, ( p(i,j,0,1) - Vec3( 0, 2*v[j], u[i] ) ).getLength(), 1e-4f );
+        EXPECT_NEAR( 0.0f, ( p(i,j,1,1) - Vec3( 0, 0, 1 ) ).getLength(), 1e-4f );
+      }
+  }
+
+}
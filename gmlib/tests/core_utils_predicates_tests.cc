@@ -0,0 +1,60 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <core/utils/gmpredicates.h>
+using namespace GMlib;
+
+// stl
+#include <cmath>
+
+
+
+namespace {
+
+
+
+  int sign( double d ) { return d > 0.0 ? 1 : ( d < 0.0 ? -1 : 0 ); }
+
+
+
+  // Points close to the line y = x, where the double precision determinant often has the wrong sign
+  TEST(Core_Utils_Predicates, Orient2D) {
+
+    const double u = std::ldexp( 1.0, -53 );
+    for( int i = 0; i < 64; i++ )
+      for( int j = 0; j < 64; j++ ) {
+
+        // The exact determinant is 12(y - x)
+        const double x = 0.5 + i*u, y = 0.5 + j*u;
+        ASSERT_EQ( sign( j - i ), sign( Predicates::orient2D( x, y, 12.0, 12.0, 24.0, 24.0 ) ) );
+        ASSERT_EQ( sign( i - j ), sign( Predicates::orient2D( 12.0, 12.0, x, y, 24.0, 24.0 ) ) );
+        ASSERT_EQ( sign( j - i ), sign( Predicates::orient2D( 24.0, 24.0, x, y, 12.0, 12.0 ) ) );
+      }
+
+    EXPECT_GT( Predicates::orient2D( 0.0, 0.0, 1.0, 0.0, 0.0, 1.0 ), 0.0 );
+    EXPECT_LT( Predicates::orient2D( 0.0, 0.0, 0.0, 1.0, 1.0, 0.0 ), 0.0 );
+  }
+
+
+
+  TEST(Core_Utils_Predicates, InCircle) {
+
+    // On the unit circle
+    EXPECT_EQ( 0.0, Predicates::inCircle( 1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, -1.0 ) );
+    EXPECT_GT( Predicates::inCircle( 1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, 0.0 ), 0.0 );
+    EXPECT_LT( Predicates::inCircle( 1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 2.0, 2.0 ), 0.0 );
+
+    // One unit in the last place inside or outside of the circle
+    const double u = std::ldexp( 1.0, -53 );
+    for( int k = 1; k < 32; k++ ) {
+      EXPECT_GT( Predicates::inCircle( 1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, -1.0 + k*u ), 0.0 );
+      EXPECT_LT( Predicates::inCircle( 1.0, 0.0, 0.0, 1.0, -1.0, 0.0, k*u, -1.0 ), 0.0 );
+      EXPECT_GT( Predicates::inCircle( 1.0, 0.0, 0.0, 1.0, -1.0, 0.0, k*u, -1.0 + 4*k*u ), 0.0 );
+    }
+
+    // Clockwise turns the sign
+    EXPECT_LT( Predicates::inCircle( 0.0, 1.0, 1.0, 0.0, -1.0, 0.0, 0.0, 0.0 ), 0.0 );
+  }
+
+}
@@ -0,0 +1,286 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/curves/gmpbutterfly.h>
+#include <parametrics/curves/gmperbscurve.h>
+#include <parametrics/surfaces/gmpboyssurface.h>
+#include <parametrics/surfaces/gmpseashell.h>
+#include <parametrics/surfaces/gmptorus.h>
+using namespace GMlib;
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  // Gives access to the (protected) samples of a surface
+  template <typename Surf>
+  class SampledSurf : public Surf {
+  public:
+    using Surf::Surf;
+
+    typedef typename PSurf<float,3>::Partition Partition;
+
+    const Partition& getPartition() const { return this->_visu[0][0]; }
+  };
+
+
+
+  // Two line segments with a jump at t = 1, the side is given by the left flag of eval()
+  class Step : public PCurve<double,3> {
+    GM_SCENEOBJECT(Step)
+  public:
+    Step() {}
+
+  protected:
+    void eval( DVector<Vector<double,3>>& p, double t, int d, bool l ) const override {
+
+      p.setDim( d+1 );
+      p[0] = Vector<double,3>( t, ( t > 1.0 || ( t == 1.0 && !l ) ) ? 1.0 : 0.0, 0.0 );
+      for( int k = 1; k <= d; k++ )
+        p[k] = Vector<double,3>( k == 1 ? 1.0 : 0.0, 0.0, 0.0 );
+    }
+
+    double getStartP() const override { return 0.0; }
+    double getEndP()   const override { return 2.0; }
+  };
+
+
+
+  // A flat square with a narrow bump between the rows and columns of an 8 x 8 uniform sampling
+  class Bump : public PSurf<float,3> {
+    GM_SCENEOBJECT(Bump)
+  public:
+    Bump() {}
+
+    typedef PSurf<float,3>::Partition Partition;
+
+    const Partition& getPartition() const { return this->_visu[0][0]; }
+
+  protected:
+    void eval( DMatrix<Vector<float,3>>& p, float u, float v, int d1, int d2, bool, bool ) const override {
+
+      const float c = 1.5f / 7.0f;
+      const float s = 0.02f;
+      const float e = std::exp( -( (u-c)*(u-c) + (v-c)*(v-c) ) / (2*s*s) );
+
+      p.setDim( d1+1, d2+1 );
+      p[0][0] = Vector<float,3>( u, v, 0.5f * e );
+      if( d1 > 0 ) p[1][0] = Vector<float,3>( 1.0f, 0.0f, -0.5f * e * (u-c) / (s*s) );
+      if( d2 > 0 ) p[0][1] = Vector<float,3>( 0.0f, 1.0f, -0.5f * e * (v-c) / (s*s) );
+      if( d1 > 0 && d2 > 0 ) p[1][1] = Vector<float,3>( 0.0f, 0.0f, 0.5f * e * (u-c)*(v-c) / (s*s*s*s) );
+    }
+
+    float getStartPU() const override { return 0.0f; }
+    float getEndPU()   const override { return 1.0f; }
+    float getStartPV() const override { return 0.0f; }
+    float getEndPV()   const override { return 1.0f; }
+  };
+
+
+
+  // The largest distance from the surface to the bilinear patches through the samples,
+  // measured at 3 x 3 points in each cell.
+  float gridDeviation( const PSurf<float,3>& s, const std::vector<float>& u, const std::vector<float>& v ) {
+
+    float err = 0.0f;
+    for( unsigned int i = 1; i < u.size(); i++ )
+      for( unsigned int j = 1; j < v.size(); j++ ) {
+
+        const Point<float,3> p00 = s.evaluate( u[i-1], v[j-1], 0, 0 )[0][0];
+        const Point<float,3> p10 = s.evaluate( u[i],   v[j-1], 0, 0 )[0][0];
+        const Point<float,3> p01 = s.evaluate( u[i-1], v[j],   0, 0 )[0][0];
+        const Point<float,3> p11 = s.evaluate( u[i],   v[j],   0, 0 )[0][0];
+
+        for( int k = 1; k < 4; k++ )
+          for( int l = 1; l < 4; l++ ) {
+            const float a = k / 4.0f, b = l / 4.0f;
+            const Point<float,3> q = (1-a)*(1-b)*p00 + a*(1-b)*p10 + (1-a)*b*p01 + a*b*p11;
+            const Point<float,3> p = s.evaluate( u[i-1] + a*(u[i]-u[i-1]), v[j-1] + b*(v[j]-v[j-1]), 0, 0 )[0][0];
+            err = std::max( err, ( p - q ).getLength() );
+          }
+      }
+    return err;
+  }
+
+
+
+  // The largest distance from the curve to the polyline through the samples,
+  // measured at 8 points in each interval.
+  double polylineDeviation( const PCurve<double,3>& c, const std::vector<double>& t ) {
+
+    double err = 0.0;
+    DVector<Vector<double,3>> p;
+    for( unsigned int i = 1; i < t.size(); i++ ) {
+
+      c.evaluate( p, t[i-1], 0 );   const Point<double,3> a = p[0];
+      c.evaluate( p, t[i],   0 );   const Point<double,3> b = p[0];
+      const Vector<double,3> ab = b - a;
+
+      for( int k = 1; k < 9; k++ ) {
+        c.evaluate( p, t[i-1] + k*(t[i]-t[i-1])/9, 0 );
+        const Vector<double,3> w = p[0] - a;
+        const double s = std::max( 0.0, std::min( 1.0, (w*ab) / (ab*ab) ) );
+        err = std::max( err, (w - s*ab).getLength() );
+      }
+    }
+    return err;
+  }
+
+
+
+  // Adaptive sampling must reach the tolerance, with fewer samples than uniform sampling
+  // with the same error.
+  TEST(Parametrics_Adaptive_Sampling, PButterfly) {
+
+    const double eps = 1e-2;
+
+    PButterfly<double> curve;
+    curve.setAdaptiveSampling( eps );
+    curve.sample( 16, 0 );
+
+    const std::vector<double>& t = curve.getSampleValues();
+    ASSERT_GT( t.size(), 16u );
+    ASSERT_LT( t.size(), 4096u );
+    EXPECT_EQ( curve.getParStart(), t.front() );
+    EXPECT_EQ( curve.getParEnd(),   t.back() );
+    EXPECT_TRUE( std::is_sorted( t.begin(), t.end() ) );
+
+    const double err = polylineDeviation( curve, t );
+    EXPECT_LT( err, 2*eps );
+
+    // Uniform sampling with the same number of samples has a larger error
+    std::vector<double> u;
+    computeUniformParamVal( u, int(t.size()), curve.getParStart(), curve.getParEnd() );
+    EXPECT_GT( polylineDeviation( curve, u ), 2*err );
+
+    // Turning adaptive sampling off gives uniform samples
+    curve.setAdaptiveSampling( 0.0 );
+    curve.sample( 16, 0 );
+    EXPECT_EQ( 16u, curve.getSampleValues().size() );
+  }
+
+
+
+  TEST(Parametrics_Adaptive_Sampling, PERBSCurve) {
+
+    const double eps = 1e-2;
+
+    PButterfly<double> butterfly;
+    PERBSCurve<double> curve( &butterfly, 20, 2 );
+    curve.setAdaptiveSampling( eps );
+    curve.sample( 40, 0 );
+
+    std::vector<double> t;
+    for( unsigned int i = 0; i < curve.getSampler()->size(); i++ ) {
+      const std::vector<double>& ti = curve.getSampleValues(i);
+      t.insert( t.end(), ti.begin() + (t.empty() ? 0 : 1), ti.end() );
+    }
+    EXPECT_TRUE( std::is_sorted( t.begin(), t.end() ) );
+    EXPECT_LT( polylineDeviation( curve, t ), 2*eps );
+  }
+
+
+
+  // The end points of an interval are evaluated from inside the interval,
+  // so a jump at a sample does not split the intervals next to it.
+  TEST(Parametrics_Adaptive_Sampling, Discontinuous) {
+
+    Step curve;
+    curve.setAdaptiveSampling( 1e-3 );
+    curve.sample( 5, 0 );
+    EXPECT_EQ( 5u, curve.getSampleValues().size() );
+  }
+
+
+
+  // The samples of an adaptive sampled surface must be the surface evaluated at the
+  // (non-uniform) parameter values, and the curved direction must get the extra samples.
+  TEST(Parametrics_Adaptive_Sampling, PSurf) {
+
+    SampledSurf<PTorus<float>> torus( 3.0f, 1.0f, 1.0f );
+    torus.setAdaptiveSampling( 1e-2f, 0.0f );
+    torus.sample( 8, 8, 1, 1 );
+
+    const SampledSurf<PTorus<float>>::Partition& part = torus.getPartition();
+    const DSampleGrid<Vector<float,3>>& p = part.sample_val;
+    ASSERT_EQ( part.u.size(), size_t(p.getDim1()) );
+    ASSERT_EQ( part.v.size(), size_t(p.getDim2()) );
+    EXPECT_EQ( part(0), p.getDim1() );
+    EXPECT_EQ( part(1), p.getDim2() );
+
+    // The big circle (u) needs more samples than the small circle (v)
+    EXPECT_GT( part.u.size(), part.v.size() );
+
+    DMatrix<Vector<float,3>> q;
+    for( int i = 0; i < p.getDim1(); i++ )
+      for( int j = 0; j < p.getDim2(); j++ ) {
+        q = torus.evaluate( part.u[i], part.v[j], 1, 1 );
+        for( int k = 0; k < 2; k++ )
+          for( int l = 0; l < 2; l++ )
+            EXPECT_NEAR( 0.0f, ( q[k][l] - p(i,j,k,l) ).getLength(), 1e-4f );
+      }
+  }
+
+  TEST(Parametrics_Adaptive_Sampling, PSeashell) {
+
+    SampledSurf<PSeashell<float>> shell;
+    shell.setAdaptiveSampling( 1e-2f );
+    shell.sample( 10, 10, 1, 1 );
+
+    const SampledSurf<PSeashell<float>>::Partition& part = shell.getPartition();
+    EXPECT_TRUE( std::is_sorted( part.u.begin(), part.u.end() ) );
+    EXPECT_TRUE( std::is_sorted( part.v.begin(), part.v.end() ) );
+    EXPECT_GE( part.u.size(), 10u );
+    EXPECT_GE( part.v.size(), 10u );
+    EXPECT_LE( part.u.size(), 4096u );
+    EXPECT_LE( part.v.size(), 4096u );
+    EXPECT_LT( gridDeviation( shell, part.u, part.v ), 3e-2f );
+  }
+
+  TEST(Parametrics_Adaptive_Sampling, PBoysSurface) {
+
+    const float eps = 1e-2f;
+
+    SampledSurf<PBoysSurface<float>> boys;
+    boys.setAdaptiveSampling( eps );
+    boys.sample( 8, 8, 1, 1 );
+
+    const SampledSurf<PBoysSurface<float>>::Partition& part = boys.getPartition();
+    const float err = gridDeviation( boys, part.u, part.v );
+    EXPECT_LT( err, 3*eps );
+
+    // Uniform sampling with the same number of samples has a larger error
+    std::vector<float> u, v;
+    computeUniformParamVal( u, int(part.u.size()), boys.getParStartU(), boys.getParEndU() );
+    computeUniformParamVal( v, int(part.v.size()), boys.getParStartV(), boys.getParEndV() );
+    EXPECT_GT( gridDeviation( boys, u, v ), err );
+  }
+
+  // A bump between the initial sample rows and columns must be found
+  TEST(Parametrics_Adaptive_Sampling, Between_Samples) {
+
+    Bump bump;
+    bump.setAdaptiveSampling( 1e-2f, 0.0f );
+    bump.sample( 8, 8, 1, 1 );
+
+    const Bump::Partition& part = bump.getPartition();
+    EXPECT_GT( part.u.size(), 8u );
+    EXPECT_GT( part.v.size(), 8u );
+
+    // The top of the bump (height 0.5) is sampled
+    float top = 0.0f;
+    const DSampleGrid<Vector<float,3>>& p = part.sample_val;
+    for( int i = 0; i < p.getDim1(); i++ )
+      for( int j = 0; j < p.getDim2(); j++ )
+        top = std::max( top, p(i,j,0,0)[2] );
+    EXPECT_GT( top, 0.4f );
+  }
+}
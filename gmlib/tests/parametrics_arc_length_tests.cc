@@ -0,0 +1,186 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/curves/gmpbeziercurve.h>
+#include <parametrics/curves/gmpbsplinecurve.h>
+#include <parametrics/curves/gmpbutterfly.h>
+#include <parametrics/curves/gmpcircle.h>
+#include <parametrics/curves/gmperbscurve.h>
+using namespace GMlib;
+
+// stl
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  // The curve length by composite Simpson with many intervals
+  double simpsonLength( const PCurve<double,3>& c, double a, double b, int m = 400000 ) {
+
+    DVector<Vector<double,3>> p;
+    const double h = (b - a) / m;
+    double sum = 0.0;
+    for( int i = 0; i <= m; i++ ) {
+      c.evaluate( p, a + i*h, 1 );
+      sum += ( i == 0 || i == m ? 1.0 : ( i % 2 ? 4.0 : 2.0 ) ) * p[1].getLength();
+    }
+    return sum * h / 3.0;
+  }
+
+
+
+  TEST(Parametrics_Arc_Length, PCircle) {
+
+    PCircle<double> circle( 2.0 );
+    EXPECT_NEAR( 4*M_PI, circle.getCurveLength(), 1e-10 );
+    EXPECT_NEAR( 2.0,    circle.getCurveLength( 0.5, 1.5 ), 1e-10 );
+
+    for( int i = 0; i <= 20; i++ ) {
+      const double s = i * 4*M_PI / 20;
+      EXPECT_NEAR( s / 2.0, circle.getParAtLength( s ), 1e-10 );
+    }
+    EXPECT_EQ( circle.getParStart(), circle.getParAtLength( -1.0 ) );
+    EXPECT_EQ( circle.getParEnd(),   circle.getParAtLength( 100.0 ) );
+
+    // Without the table the length follows the shape at once
+    circle.setRadius( 3.0 );
+    EXPECT_NEAR( 6*M_PI, circle.getCurveLength(), 1e-10 );
+    EXPECT_NEAR( 1.0,    circle.getParAtLength( 3.0 ), 1e-10 );
+  }
+
+
+
+  TEST(Parametrics_Arc_Length, PCircle_Table) {
+
+    PCircle<double> circle( 2.0 );
+    circle.setArcLengthTable();
+    EXPECT_TRUE( circle.isArcLengthTable() );
+    EXPECT_NEAR( 4*M_PI, circle.getCurveLength(), 1e-10 );
+    EXPECT_NEAR( 2.0,    circle.getCurveLength( 0.5, 1.5 ), 1e-10 );
+
+    for( int i = 0; i <= 20; i++ ) {
+      const double s = i * 4*M_PI / 20;
+      EXPECT_NEAR( s / 2.0, circle.getParAtLength( s ), 1e-10 );
+    }
+    EXPECT_EQ( circle.getParStart(), circle.getParAtLength( -1.0 ) );
+    EXPECT_EQ( circle.getParEnd(),   circle.getParAtLength( 100.0 ) );
+
+    // The table is made again after sampling, when the domain is changed and when invalidated
+    circle.setRadius( 3.0 );
+    circle.sample( 20, 0 );
+    EXPECT_NEAR( 6*M_PI, circle.getCurveLength(), 1e-10 );
+
+    circle.setDomain( 0.0, 1.0 );
+    EXPECT_NEAR( 6*M_PI,   circle.getCurveLength(), 1e-10 );
+    EXPECT_NEAR( 0.25,     circle.getParAtLength( 1.5*M_PI ), 1e-10 );
+
+    circle.setRadius( 1.0 );
+    circle.invalidateArcLength();
+    EXPECT_NEAR( 2*M_PI, circle.getCurveLength(), 1e-10 );
+  }
+
+
+
+  // Queries from several threads while the table is invalidated from another
+  TEST(Parametrics_Arc_Length, PCircle_Table_Threads) {
+
+    PCircle<double> circle( 2.0 );
+    circle.setArcLengthTable();
+
+    std::atomic<bool> stop(false);
+    std::atomic<int>  errors(0);
+    std::atomic<int>  queries(0);
+
+    std::vector<std::thread> threads;
+    for( int k = 0; k < 4; k++ )
+      threads.push_back( std::thread( [&circle,&stop,&errors,&queries,k]() {
+        for( int i = 0; !stop || i < 50; i++ ) {
+          const double s = ( (i + k) % 21 ) * 4*M_PI / 20;
+          if( std::abs( circle.getCurveLength() - 4*M_PI ) > 1e-10 ) errors++;
+          if( std::abs( circle.getParAtLength( s ) - s / 2.0 ) > 1e-10 ) errors++;
+          queries++;
+        }
+      } ) );
+
+    for( int i = 0; i < 200; i++ ) {
+      circle.invalidateArcLength();
+      std::this_thread::yield();
+    }
+    stop = true;
+    for( auto& th : threads ) th.join();
+
+    EXPECT_EQ( 0, errors.load() );
+    EXPECT_LE( 200, queries.load() );
+    EXPECT_NEAR( 4*M_PI, circle.getCurveLength(), 1e-10 );
+  }
+
+
+
+  // A curve with a varying speed, with and without the table
+  TEST(Parametrics_Arc_Length, PButterfly) {
+
+    PButterfly<double> curve;
+    const double a = curve.getParStart();
+    const double d = curve.getParDelta();
+
+    for( bool table : { false, true } ) {
+
+      curve.setArcLengthTable( table );
+      EXPECT_NEAR( simpsonLength( curve, a, a + d ), curve.getCurveLength(), 1e-6 );
+      EXPECT_NEAR( simpsonLength( curve, a + 0.3*d, a + 0.7*d ), curve.getCurveLength( a + 0.3*d, a + 0.7*d ), 1e-6 );
+
+      // The inverse
+      const double len = curve.getCurveLength();
+      for( int i = 1; i < 50; i += table ? 1 : 7 ) {
+        const double t = curve.getParAtLength( i * len / 50 );
+        EXPECT_NEAR( i * len / 50, curve.getCurveLength( a, t ), 1e-8 );
+      }
+    }
+  }
+
+
+
+  // Edits of the control points and of the local curves update the arc length table
+  // without a replot() in between.
+  TEST(Parametrics_Arc_Length, Edit) {
+
+    DVector<Vector<double,3>> c( 5 );
+    for( int i = 0; i < 5; i++ )
+      c[i] = Vector<double,3>( i, i % 2, 0.0 );
+
+    PBSplineCurve<double> bspline( c, 2, false );
+    PBezierCurve<double>  bezier( c );
+    bspline.setArcLengthTable();
+    bezier.setArcLengthTable();
+    const double bspline_len = bspline.getCurveLength();
+    const double bezier_len  = bezier.getCurveLength();
+
+    DVector<Vector<double,3>> c2( c );
+    for( int i = 0; i < 5; i++ )
+      c2[i] *= 2.0;
+    bspline.setControlPoints( c2 );
+    bezier.setControlPoints( c2 );
+    EXPECT_NEAR( 2.0 * bspline_len, bspline.getCurveLength(), 1e-8 );
+    EXPECT_NEAR( 2.0 * bezier_len,  bezier.getCurveLength(),  1e-8 );
+
+    PCircle<double> circle( 2.0 );
+    PERBSCurve<double> erbs( &circle, 6, 2 );
+    erbs.setArcLengthTable();
+    const double a = erbs.getParStart();
+    const double b = erbs.getParEnd();
+    EXPECT_NEAR( simpsonLength( erbs, a, b, 20000 ), erbs.getCurveLength(), 1e-6 );
+
+    const double len = erbs.getCurveLength();
+    erbs.getLocalCurves()[2]->translateParent( Vector<float,3>( 0.0f, 0.0f, 1.0f ) );
+    EXPECT_GT( erbs.getCurveLength(), len + 0.1 );
+    EXPECT_NEAR( simpsonLength( erbs, a, b, 20000 ), erbs.getCurveLength(), 1e-6 );
+  }
+
+}
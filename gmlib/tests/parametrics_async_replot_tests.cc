@@ -0,0 +1,397 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <core/utils/gmparallel.h>
+#include <parametrics/gmpcurve.h>
+#include <parametrics/gmpsurf.h>
+#include <parametrics/curves/gmpcircle.h>
+#include <parametrics/curves/gmperbscurve.h>
+#include <parametrics/surfaces/gmperbssurf.h>
+#include <parametrics/surfaces/gmptorus.h>
+using namespace GMlib;
+
+// stl
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  // A surface and a curve with a shape parameter that may be changed while
+  // a background resampling is running.
+  class Wave : public PSurf<float,3> {
+  public:
+    Wave() : _a(1.0f) {}
+    Wave( const Wave& copy ) : PSurf<float,3>( copy ), _a( copy._a ) {}
+
+    SceneObject* makeCopy() override { return new Wave( *this ); }
+    std::string  getIdentity() const override { return "Wave"; }
+
+    void setAmplitude( float a ) { _a = a; }
+
+    const DSampleGrid<Vector<float,3>>& getSamples() const { return this->_visu[0][0].sample_val; }
+    const Sphere<float,3>&              getSphere()  const { return this->_visu[0][0].sur_sphere; }
+
+  protected:
+    void eval( DMatrix<Vector<float,3>>& p, float u, float v, int d1, int d2, bool, bool ) const override {
+
+      p.setDim( d1+1, d2+1 );
+      for( int k = 0; k <= d1; k++ )
+        for( int l = 0; l <= d2; l++ )
+          p[k][l] = Vector<float,3>( k+l == 0 ? u : (k == 1 && l == 0 ? 1.0f : 0.0f),
+                                     k+l == 0 ? v : (k == 0 && l == 1 ? 1.0f : 0.0f),
+                                     _a * std::sin( u + k*float(M_PI_2) ) * std::cos( v + l*float(M_PI_2) ) );
+    }
+
+    float getStartPU() const override { return 0.0f; }
+    float getEndPU()   const override { return 6.0f; }
+    float getStartPV() const override { return 0.0f; }
+    float getEndPV()   const override { return 3.0f; }
+
+  private:
+    float _a;
+  };
+
+
+  class Ring : public PCurve<double,3> {
+  public:
+    Ring() : PCurve<double,3>( 20, 0, 7 ), _r(1.0) {}
+    Ring( const Ring& copy ) : PCurve<double,3>( copy ), _r( copy._r ) {}
+
+    SceneObject* makeCopy() override { return new Ring( *this ); }
+    std::string  getIdentity() const override { return "Ring"; }
+
+    void setRadius( double r ) { _r = r; }
+
+    const std::vector<DVector<Vector<double,3>>>& getSamples() const { return this->_visu[0].sample_val; }
+
+  protected:
+    void eval( DVector<Vector<double,3>>& p, double t, int d, bool ) const override {
+
+      p.setDim( d+1 );
+      for( int k = 0; k <= d; k++ )
+        p[k] = Vector<double,3>( _r * std::cos( t + k*M_PI_2 ), _r * std::sin( t + k*M_PI_2 ), 0.0 );
+    }
+
+    double getStartP() const override { return 0.0; }
+    double getEndP()   const override { return M_2PI; }
+
+  private:
+    double _r;
+  };
+
+
+
+  // A curve that can not be copied
+  class FixedRing : public Ring {
+  public:
+    SceneObject* makeCopy() override { return nullptr; }
+  };
+
+
+
+  // A slow curve counting the evaluations made after its destructor has started
+  class SlowRing : public PCurve<double,3> {
+  public:
+    SlowRing( std::shared_ptr<std::atomic<int>> late )
+      : PCurve<double,3>( 20, 0, 7 ), _r( 40, 1.0 ), _dying( false ), _late( late ) {}
+    ~SlowRing() { _dying = true; }
+
+    SceneObject* makeCopy() override { return new SlowRing( _late ); }
+    std::string  getIdentity() const override { return "SlowRing"; }
+
+  protected:
+    void eval( DVector<Vector<double,3>>& p, double t, int d, bool ) const override {
+
+      if( _dying ) (*_late)++;
+      std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+
+      const double r = _r[ int( 6.0 * t ) % _r.size() ];
+      p.setDim( d+1 );
+      for( int k = 0; k <= d; k++ )
+        p[k] = Vector<double,3>( r * std::cos( t + k*M_PI_2 ), r * std::sin( t + k*M_PI_2 ), 0.0 );
+    }
+
+    double getStartP() const override { return 0.0; }
+    double getEndP()   const override { return M_2PI; }
+
+  private:
+    std::vector<double>                _r;
+    std::atomic<bool>                  _dying;
+    std::shared_ptr<std::atomic<int>>  _late;
+  };
+
+
+
+  // A slow curve recording the threads its copies are deleted on
+  class ThreadRing : public PCurve<double,3> {
+  public:
+    struct Log {
+      std::mutex                    mutex;
+      std::vector<std::thread::id>  deleted;
+    };
+
+    ThreadRing( std::shared_ptr<Log> log ) : PCurve<double,3>( 20, 0, 7 ), _log( log ) {}
+    ~ThreadRing() {
+      std::lock_guard<std::mutex> lock( _log->mutex );
+      _log->deleted.push_back( std::this_thread::get_id() );
+    }
+
+    SceneObject* makeCopy() override { return new ThreadRing( _log ); }
+    std::string  getIdentity() const override { return "ThreadRing"; }
+
+  protected:
+    void eval( DVector<Vector<double,3>>& p, double t, int d, bool ) const override {
+
+      std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+      p.setDim( d+1 );
+      for( int k = 0; k <= d; k++ )
+        p[k] = Vector<double,3>( std::cos( t + k*M_PI_2 ), std::sin( t + k*M_PI_2 ), 0.0 );
+    }
+
+    double getStartP() const override { return 0.0; }
+    double getEndP()   const override { return M_2PI; }
+
+  private:
+    std::shared_ptr<Log> _log;
+  };
+
+
+
+  ::testing::AssertionResult sameSamples( const DSampleGrid<Vector<float,3>>& p, const DSampleGrid<Vector<float,3>>& q ) {
+
+    if( p.getDim1() != q.getDim1() || p.getDim2() != q.getDim2() ||
+        p.getDerDim1() != q.getDerDim1() || p.getDerDim2() != q.getDerDim2() )
+      return ::testing::AssertionFailure() << "dim mismatch";
+
+    for( int i = 0; i < p.getDim1(); i++ )
+      for( int j = 0; j < p.getDim2(); j++ )
+        for( int k = 0; k < p.getDerDim1(); k++ )
+          for( int l = 0; l < p.getDerDim2(); l++ )
+            if( p(i,j,k,l) != q(i,j,k,l) )
+              return ::testing::AssertionFailure() << "sample (" << i << "," << j << ") der (" << k << "," << l << ") differs";
+    return ::testing::AssertionSuccess();
+  }
+
+
+
+  // A cancelled job is not started, and join() returns at once.
+  TEST(Core_Utils, Parallel__AsyncJob) {
+
+    Parallel::WorkerPool pool(1);
+    std::atomic<bool> go(false);
+    std::atomic<int>  count(0);
+
+    auto block = Parallel::AsyncJob::submit( [&]( Parallel::AsyncJob& ) { while( !go ) std::this_thread::yield(); count++; }, pool );
+    auto job1  = Parallel::AsyncJob::submit( [&]( Parallel::AsyncJob& ) { count += 10; }, pool );
+    auto job2  = Parallel::AsyncJob::submit( [&]( Parallel::AsyncJob& ) { count += 100; }, pool );
+
+    job1->cancel();
+    job1->join();
+    EXPECT_FALSE( job2->isDone() );
+
+    go = true;
+    job2->join();
+    pool.wait();
+    EXPECT_TRUE( block->isDone() );
+    EXPECT_TRUE( job2->isDone() );
+    EXPECT_EQ( 101, int(count) );
+  }
+
+
+
+  // The visualizer data must keep the previous samples until the background
+  // resampling is swapped in, and then be equal to a synchronous resampling.
+  TEST(Parametrics_Async_Replot, PSurf) {
+
+    Wave gold;
+    gold.setAmplitude( 2.0f );
+    gold.sample( 40, 30, 1, 1 );
+
+    Wave wave;
+    wave.sample( 40, 30, 1, 1 );
+    const DSampleGrid<Vector<float,3>> before = wave.getSamples();
+    wave.setAsyncReplot();
+
+    wave.setAmplitude( 2.0f );
+    wave.replot();
+    EXPECT_TRUE( wave.isAsyncReplotPending() );
+    EXPECT_TRUE( sameSamples( before, wave.getSamples() ) );
+
+    wave.waitAsyncReplot();
+    EXPECT_TRUE( sameSamples( before, wave.getSamples() ) );
+    EXPECT_TRUE( wave.swapAsyncReplot() );
+    EXPECT_FALSE( wave.isAsyncReplotPending() );
+    EXPECT_TRUE( sameSamples( gold.getSamples(), wave.getSamples() ) );
+    EXPECT_EQ( gold.getSphere().getPos(),    wave.getSphere().getPos() );
+    EXPECT_EQ( gold.getSphere().getRadius(), wave.getSphere().getRadius() );
+    EXPECT_FALSE( wave.swapAsyncReplot() );
+
+    // A new edit cancels the running resampling, the last shape is shown
+    gold.setAmplitude( 4.0f );
+    gold.sample( 40, 30, 1, 1 );
+    wave.setAmplitude( 3.0f );
+    wave.replot();
+    wave.setAmplitude( 4.0f );
+    wave.replot();
+    wave.waitAsyncReplot();
+    EXPECT_TRUE( wave.swapAsyncReplot() );
+    EXPECT_TRUE( sameSamples( gold.getSamples(), wave.getSamples() ) );
+
+    // The job samples the surface as it was at replot()
+    wave.setAmplitude( 2.0f );
+    wave.replot();
+    wave.setAmplitude( 6.0f );
+    wave.waitAsyncReplot();
+    EXPECT_TRUE( wave.swapAsyncReplot() );
+    gold.setAmplitude( 2.0f );
+    gold.sample( 40, 30, 1, 1 );
+    EXPECT_TRUE( sameSamples( gold.getSamples(), wave.getSamples() ) );
+
+    // Sampling cancels the background resampling
+    wave.setAmplitude( 5.0f );
+    wave.replot();
+    wave.sample( 20, 20, 1, 1 );
+    EXPECT_FALSE( wave.isAsyncReplotPending() );
+    EXPECT_FALSE( wave.swapAsyncReplot() );
+    EXPECT_EQ( 20, wave.getSamples().getDim1() );
+  }
+
+
+
+  TEST(Parametrics_Async_Replot, PCurve) {
+
+    Ring ring;
+    ring.sample( 50, 1 );
+    ring.setAsyncReplot();
+
+    ring.setRadius( 3.0 );
+    ring.replot();
+    ring.setRadius( 2.0 );
+    ring.replot();
+    EXPECT_NEAR( 1.0, ring.getSamples()[7][0].getLength(), 1e-12 );
+
+    ring.waitAsyncReplot();
+    EXPECT_TRUE( ring.swapAsyncReplot() );
+    ASSERT_EQ( 50u, ring.getSamples().size() );
+    for( unsigned int i = 0; i < 50; i++ ) {
+      EXPECT_NEAR( 2.0, ring.getSamples()[i][0].getLength(), 1e-12 );
+      EXPECT_NEAR( 2.0, ring.getSamples()[i][1].getLength(), 1e-12 );
+    }
+
+    // Without a copy the curve is replotted at once
+    FixedRing fixed;
+    fixed.sample( 50, 1 );
+    fixed.setAsyncReplot();
+    fixed.replot();
+    EXPECT_FALSE( fixed.isAsyncReplotPending() );
+  }
+
+
+
+  // A curve can be deleted while it is resampled, the job samples a copy
+  // and never calls the deleted curve.
+  TEST(Parametrics_Async_Replot, Delete) {
+
+    std::shared_ptr<std::atomic<int>> late = std::make_shared<std::atomic<int>>( 0 );
+    for( int i = 0; i < 5; i++ ) {
+      SlowRing* ring = new SlowRing( late );
+      ring->sample( 200, 1 );
+      ring->setAsyncReplot();
+      ring->replot();
+      std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+      delete ring;
+    }
+
+    PCircle<double>* circle = new PCircle<double>( 2.0 );
+    circle->sample( 2000, 2 );
+    circle->setAsyncReplot();
+    circle->replot();
+    delete circle;
+
+    Parallel::WorkerPool::getDefault().wait();
+    EXPECT_EQ( 0, int(*late) );
+  }
+
+
+
+  // The copy sampled by a cancelled job is deleted on the thread owning the curve,
+  // not in the worker pool when the job finishes.
+  TEST(Parametrics_Async_Replot, Release) {
+
+    std::shared_ptr<ThreadRing::Log> log = std::make_shared<ThreadRing::Log>();
+    ThreadRing* ring = new ThreadRing( log );
+    ring->sample( 200, 1 );
+    ring->setAsyncReplot();
+
+    ring->replot();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+    ring->replot();
+    ring->replot();
+    Parallel::WorkerPool::getDefault().wait();
+    EXPECT_TRUE( ring->swapAsyncReplot() );
+
+    ring->replot();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+    delete ring;
+
+    Parallel::WorkerPool::getDefault().wait();
+    ASSERT_EQ( 5u, log->deleted.size() );
+    for( const std::thread::id& id : log->deleted )
+      EXPECT_EQ( std::this_thread::get_id(), id );
+  }
+
+
+
+  // The snapshot of an ERBS curve or surface has copies of the local curves/patches,
+  // which are not children of it, and samples as the curve/surface.
+  TEST(Parametrics_Async_Replot, PERBS) {
+
+    PCircle<double> circle( 2.0 );
+    PERBSCurve<double> curve( &circle, 6, 3 );
+    curve.sample( 60, 1 );
+
+    std::unique_ptr<PCurve<double,3>> c( curve.makeSnapshot() );
+    ASSERT_TRUE( bool(c) );
+    EXPECT_EQ( 6, curve.getChildren().getSize() );
+    EXPECT_EQ( 0, c->getChildren().getSize() );
+    for( int i = 0; i <= 20; i++ ) {
+      const double t = curve.getParStart() + i * curve.getParDelta() / 20;
+      EXPECT_NEAR( 0.0, ( curve.evaluate( t, 1 )[0] - c->evaluate( t, 1 )[0] ).getLength(), 1e-12 );
+      EXPECT_NEAR( 0.0, ( curve.evaluate( t, 1 )[1] - c->evaluate( t, 1 )[1] ).getLength(), 1e-12 );
+    }
+
+    PTorus<float> torus( 3.0f, 1.0f, 1.5f );
+    PERBSSurf<float> surf( &torus, 4, 5, 1, 1 );
+    surf.sample( 20, 20, 1, 1 );
+
+    std::unique_ptr<PSurf<float,3>> s( surf.makeSnapshot() );
+    ASSERT_TRUE( bool(s) );
+    EXPECT_EQ( 20, surf.getChildren().getSize() );
+    EXPECT_EQ( 0, s->getChildren().getSize() );
+
+    // Only sampled through the pre-evaluated basis functions
+    s->sample( 20, 20, 1, 1 );
+    EXPECT_NEAR( 0.0f, ( surf.getSurroundingSphere().getPos() - s->getSurroundingSphere().getPos() ).getLength(), 1e-5f );
+    EXPECT_NEAR( surf.getSurroundingSphere().getRadius(), s->getSurroundingSphere().getRadius(), 1e-5f );
+
+    // Resampled in the background as in the foreground
+    const Sphere<float,3> before = curve.getSurroundingSphere();
+    curve.setAsyncReplot();
+    curve.replot();
+    curve.waitAsyncReplot();
+    EXPECT_TRUE( curve.swapAsyncReplot() );
+    EXPECT_NEAR( 0.0f, ( before.getPos() - curve.getSurroundingSphere().getPos() ).getLength(), 1e-5f );
+    EXPECT_NEAR( before.getRadius(), curve.getSurroundingSphere().getRadius(), 1e-5f );
+  }
+
+}
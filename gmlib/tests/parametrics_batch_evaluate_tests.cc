@@ -0,0 +1,227 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/curves/gmpcircle.h>
+#include <parametrics/curves/gmpline.h>
+#include <parametrics/curves/gmpbeziercurve.h>
+#include <parametrics/curves/gmpbsplinecurve.h>
+#include <parametrics/surfaces/gmptorus.h>
+#include <parametrics/surfaces/gmpsphere.h>
+#include <parametrics/surfaces/gmpbeziersurf.h>
+using namespace GMlib;
+
+// stl
+#include <vector>
+
+
+
+namespace {
+
+
+
+  DVector<Vector<double,3>> controlPoints( int n ) {
+
+    DVector<Vector<double,3>> c(n);
+    for( int i = 0; i < n; i++ )
+      c[i] = Vector<double,3>( i, (i*5)%3, (i*7)%4 - 1.5 );
+    return c;
+  }
+
+
+
+  // Parameter values over the whole domain, in sorted order or shuffled
+  template <typename T>
+  std::vector<T> parameters( T s, T delta, int m, bool shuffled ) {
+
+    std::vector<T> t(m);
+    for( int i = 0; i < m; i++ )
+      t[i] = s + delta * ( shuffled ? (i*7)%m : i ) / (m-1);
+    return t;
+  }
+
+
+
+  // The batch evaluation must give exactly the same result as the single evaluation
+  ::testing::AssertionResult batchTest( const PCurve<double,3>& curve, int d, bool shuffled = false ) {
+
+    const int m = 37;
+    const std::vector<double> t = parameters<double>( curve.getParStart(), curve.getParDelta(), m, shuffled );
+
+    std::vector<Vector<double,3>> p( (d+1)*m );
+    curve.evaluate( p.data(), t.data(), m, d );
+
+    for( int i = 0; i < m; i++ ) {
+
+      DVector<Vector<double,3>> gold;
+      curve.evaluate( gold, t[i], d );
+
+      for( int k = 0; k <= d; k++ )
+        if( p[k*m+i] != gold[k] )
+          return ::testing::AssertionFailure() << "value mismatch at t = " << t[i] << ", der " << k;
+    }
+    return ::testing::AssertionSuccess();
+  }
+
+
+  ::testing::AssertionResult batchTest( const PSurf<float,3>& surf, int d1, int d2 ) {
+
+    const int m = 41;
+    const std::vector<float> u = parameters<float>( surf.getParStartU(), surf.getParDeltaU(), m, false );
+    const std::vector<float> v = parameters<float>( surf.getParStartV(), surf.getParDeltaV(), m, true );
+
+    std::vector<Vector<float,3>> p( (d1+1)*(d2+1)*m );
+    surf.evaluate( p.data(), u.data(), v.data(), m, d1, d2 );
+
+    for( int i = 0; i < m; i++ ) {
+
+      DMatrix<Vector<float,3>> gold;
+      surf.evaluate( gold, u[i], v[i], d1, d2 );
+
+      for( int k = 0; k <= d1; k++ )
+        for( int l = 0; l <= d2; l++ )
+          if( p[(k*(d2+1)+l)*m+i] != gold[k][l] )
+            return ::testing::AssertionFailure()
+                << "value mismatch at (" << u[i] << "," << v[i] << "), der (" << k << "," << l << ")";
+    }
+    return ::testing::AssertionSuccess();
+  }
+
+
+
+  // A helix made from a circle, batch-evaluating the circle inside its own batch evaluator
+  class Helix : public PCurve<double,3> {
+  public:
+    Helix() : PCurve<double,3>( 20, 0, 7 ), _circle( 2.0 ) { _circle.setDomain( 1.0, 4.0 ); }
+    Helix( const Helix& copy ) : PCurve<double,3>( copy ), _circle( copy._circle ) {}
+
+    SceneObject* makeCopy() override { return new Helix( *this ); }
+    std::string  getIdentity() const override { return "Helix"; }
+
+  protected:
+    void eval( DVector<Vector<double,3>>& p, double t, int d, bool l ) const override {
+
+      _circle.evaluate( p, 1.0 + 3.0*t/M_2PI, d, l );
+      p[0][2] += t;
+      if( d > 0 ) p[1][2] += 1.0;
+    }
+
+    void evalBatch( Vector<double,3>* p, const double* t, int m, int d, bool l ) const override {
+
+      // Use more parameter values than the outer call, so a shared buffer would be reallocated
+      std::vector<double> s( 2*m );
+      for( int i = 0; i < m; i++ )
+        s[i] = s[m+i] = 1.0 + 3.0*t[i]/M_2PI;
+
+      std::vector<Vector<double,3>> q( (d+1)*2*m );
+      _circle.evaluate( q.data(), s.data(), 2*m, d, l );
+
+      for( int k = 0; k <= d; k++ )
+        for( int i = 0; i < m; i++ )
+          p[k*m+i] = q[k*2*m+i];
+      for( int i = 0; i < m; i++ ) {
+        p[i][2] += t[i];
+        if( d > 0 ) p[m+i][2] += 1.0;
+      }
+    }
+
+    double getStartP() const override { return 0.0; }
+    double getEndP()   const override { return M_2PI; }
+
+  private:
+    PCircle<double> _circle;
+  };
+
+
+
+  TEST(Parametrics_Batch_Evaluate, PCircle) {
+
+    PCircle<double> circle(2.0, 3.0);
+    EXPECT_TRUE( batchTest( circle, 0 ) );
+    EXPECT_TRUE( batchTest( circle, 3 ) );
+    EXPECT_TRUE( batchTest( circle, 7 ) );
+
+    circle.setDomain( 1.0, 4.0 );
+    EXPECT_TRUE( batchTest( circle, 2 ) );
+
+    circle.setDerivationMethod( GM_DERIVATION_DD );
+    EXPECT_TRUE( batchTest( circle, 0 ) );
+  }
+
+
+  TEST(Parametrics_Batch_Evaluate, PLine) {
+
+    PLine<double> line( Point<double,3>(1,2,3), Vector<double,3>(1,-1,2) );
+    EXPECT_TRUE( batchTest( line, 1 ) );
+  }
+
+
+  TEST(Parametrics_Batch_Evaluate, PBezierCurve) {
+
+    PBezierCurve<double> bezier3( controlPoints(4) );
+    EXPECT_TRUE( batchTest( bezier3, 2 ) );
+
+    PBezierCurve<double> bezier6( controlPoints(7) );
+    EXPECT_TRUE( batchTest( bezier6, 3 ) );
+
+    bezier6.setDomain( -1.0, 2.0 );
+    EXPECT_TRUE( batchTest( bezier6, 1 ) );
+  }
+
+
+  TEST(Parametrics_Batch_Evaluate, PBSplineCurve) {
+
+    for( int d = 1; d <= 4; d++ ) {
+      PBSplineCurve<double> open( controlPoints(9), d, false );
+      EXPECT_TRUE( batchTest( open, 1 ) ) << "degree " << d;
+      EXPECT_TRUE( batchTest( open, d, true ) ) << "degree " << d;
+
+      PBSplineCurve<double> closed( controlPoints(9), d, true );
+      EXPECT_TRUE( batchTest( closed, 1 ) ) << "degree " << d;
+      EXPECT_TRUE( batchTest( closed, 1, true ) ) << "degree " << d;
+    }
+  }
+
+
+  TEST(Parametrics_Batch_Evaluate, Nested) {
+
+    Helix helix;
+    EXPECT_TRUE( batchTest( helix, 0 ) );
+    EXPECT_TRUE( batchTest( helix, 2, true ) );
+
+    helix.setDomain( -1.0, 1.0 );
+    EXPECT_TRUE( batchTest( helix, 1 ) );
+  }
+
+
+  TEST(Parametrics_Batch_Evaluate, PTorus) {
+
+    PTorus<float> torus( 3.0f, 1.0f, 1.5f );
+    EXPECT_TRUE( batchTest( torus, 0, 0 ) );
+    EXPECT_TRUE( batchTest( torus, 1, 0 ) );
+    EXPECT_TRUE( batchTest( torus, 1, 1 ) );
+    EXPECT_TRUE( batchTest( torus, 2, 2 ) );
+  }
+
+
+  TEST(Parametrics_Batch_Evaluate, PSphere) {
+
+    PSphere<float> sphere( 2.0f );
+    EXPECT_TRUE( batchTest( sphere, 0, 1 ) );
+    EXPECT_TRUE( batchTest( sphere, 1, 1 ) );
+    EXPECT_TRUE( batchTest( sphere, 3, 2 ) );
+  }
+
+
+  TEST(Parametrics_Batch_Evaluate, PBezierSurf) {
+
+    DMatrix<Vector<float,3>> c(4,3);
+    for( int i = 0; i < 4; i++ )
+      for( int j = 0; j < 3; j++ )
+        c[i][j] = Vector<float,3>( i, j, float((i*j) % 3) - 1.0f );
+
+    PBezierSurf<float> bezier(c);
+    EXPECT_TRUE( batchTest( bezier, 1, 1 ) );
+  }
+
+}
@@ -0,0 +1,188 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <core/containers/gmkdtree.h>
+#include <parametrics/curves/gmpcircle.h>
+#include <parametrics/surfaces/gmptorus.h>
+#include <parametrics/surfaces/gmpplane.h>
+using namespace GMlib;
+
+// stl
+#include <cmath>
+#include <memory>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  std::vector<Point<float,3>> points( int m, float scale ) {
+
+    std::vector<Point<float,3>> p(m);
+    for( int i = 0; i < m; i++ )
+      p[i] = Point<float,3>( scale * std::sin( 1.3f*i ), scale * std::cos( 0.7f*i + 1.0f ), scale * std::sin( 0.37f*i*i ) );
+    return p;
+  }
+
+
+
+  // The nearest point must be the same as found by a linear search.
+  TEST(Core_Containers, KdTree__FindNearest) {
+
+    const std::vector<Point<float,3>> p = points( 500, 1.0f );
+    const std::vector<Point<float,3>> q = points( 200, 1.2f );
+
+    KdTree<float,3> tree( p.data(), int(p.size()) );
+    EXPECT_EQ( 500, tree.getSize() );
+
+    for( const Point<float,3>& x : q ) {
+
+      int   gold = 0;
+      float d2   = (x - p[0]) * (x - p[0]);
+      for( unsigned int i = 1; i < p.size(); i++ )
+        if( (x - p[i]) * (x - p[i]) < d2 ) {
+          gold = i;
+          d2   = (x - p[i]) * (x - p[i]);
+        }
+
+      float dist2;
+      EXPECT_EQ( gold, tree.findNearest( x, dist2 ) );
+      EXPECT_EQ( d2, dist2 );
+    }
+
+    KdTree<float,3> empty;
+    EXPECT_EQ( -1, empty.findNearest( q[0] ) );
+  }
+
+
+
+  // Points on the normals of a torus must be projected back to the foot points,
+  // from the samples of the surface and without samples.
+  TEST(Parametrics_Closest_Point, PTorus) {
+
+    PTorus<float> torus( 3.0f, 1.0f, 1.0f );
+
+    const int m = 300;
+    std::vector<Point<float,3>> q(m);
+    std::vector<Point<float,2>> gold(m);
+    for( int i = 0; i < m; i++ ) {
+      gold[i] = Point<float,2>( 0.1f + 6.0f * i / m, 0.2f + 5.9f * ((i*37) % m) / m );
+      DMatrix<Vector<float,3>> r = torus.evaluate( gold[i][0], gold[i][1], 1, 1 );
+      q[i] = r[0][0] + 0.3f * Vector<float,3>( r[1][0] ^ r[0][1] ).getNormalized();
+    }
+
+    for( int sampled = 0; sampled < 2; sampled++ ) {
+
+      if( sampled ) torus.sample( 30, 20, 1, 1 );
+
+      std::vector<Point<float,2>> uv(m);
+      std::vector<float>          dist(m);
+      std::unique_ptr<bool[]>     conv( new bool[m] );
+      EXPECT_EQ( m, torus.getClosestPoints( q.data(), m, uv.data(), dist.data(), conv.get(), 1e-5, 20, 3 ) );
+
+      for( int i = 0; i < m; i++ ) {
+        EXPECT_TRUE( conv[i] );
+        EXPECT_NEAR( gold[i][0], uv[i][0], 1e-3f );
+        EXPECT_NEAR( gold[i][1], uv[i][1], 1e-3f );
+        EXPECT_NEAR( 0.3f, dist[i], 1e-4f );
+
+        // Same result as the single point function from the same start guess
+        float u = uv[i][0], v = uv[i][1];
+        EXPECT_TRUE( torus.getClosestPoint( q[i], u, v ) );
+        EXPECT_NEAR( u, uv[i][0], 1e-4f );
+        EXPECT_NEAR( v, uv[i][1], 1e-4f );
+      }
+    }
+  }
+
+
+
+  // Points outside an open surface are projected to the boundary.
+  TEST(Parametrics_Closest_Point, PPlane) {
+
+    PPlane<float> plane( Point<float,3>(0,0,0), Vector<float,3>(2,0,0), Vector<float,3>(0,1,0) );
+
+    const Point<float,3> q[2] = { Point<float,3>( 1.0f, 0.5f, 2.0f ), Point<float,3>( 5.0f, -1.0f, 1.0f ) };
+    Point<float,2> uv[2];
+    float          dist[2];
+    EXPECT_EQ( 2, plane.getClosestPoints( q, 2, uv, dist ) );
+
+    EXPECT_NEAR( 0.5f, uv[0][0], 1e-5f );
+    EXPECT_NEAR( 0.5f, uv[0][1], 1e-5f );
+    EXPECT_NEAR( 2.0f, dist[0],  1e-5f );
+    EXPECT_NEAR( 1.0f, uv[1][0], 1e-5f );
+    EXPECT_NEAR( 0.0f, uv[1][1], 1e-5f );
+    EXPECT_NEAR( std::sqrt( 11.0f ), dist[1], 1e-5f );
+  }
+
+
+
+  TEST(Parametrics_Closest_Point, PCircle) {
+
+    PCircle<double> circle( 2.0 );
+    circle.sample( 40, 0 );
+
+    const int m = 100;
+    std::vector<Point<double,3>> q(m);
+    for( int i = 0; i < m; i++ )
+      q[i] = Point<double,3>( 3.0 * std::cos( 0.05 + 0.06*i ), 3.0 * std::sin( 0.05 + 0.06*i ), 1.0 );
+
+    std::vector<double> t(m), dist(m);
+    EXPECT_EQ( m, circle.getClosestPoints( q.data(), m, t.data(), dist.data() ) );
+    for( int i = 0; i < m; i++ ) {
+      EXPECT_NEAR( 0.05 + 0.06*i, t[i], 1e-6 );
+      EXPECT_NEAR( std::sqrt( 2.0 ), dist[i], 1e-9 );
+    }
+  }
+
+
+
+  // The k-d tree over the samples is kept between the calls, and made again
+  // when the curve/surface is sampled again.
+  TEST(Parametrics_Closest_Point, Replot) {
+
+    PCircle<double> circle( 2.0 );
+    circle.sample( 40, 0 );
+
+    const int m = 50;
+    std::vector<Point<double,3>> q(m);
+    for( int i = 0; i < m; i++ )
+      q[i] = Point<double,3>( 2.1 * std::cos( 0.05 + 0.12*i ), 2.1 * std::sin( 0.05 + 0.12*i ), 0.0 );
+
+    std::vector<double> t(m), dist(m);
+    EXPECT_EQ( m, circle.getClosestPoints( q.data(), m, t.data(), dist.data() ) );
+    EXPECT_NEAR( 0.1, dist[0], 1e-9 );
+
+    circle.setRadius( 5.0 );
+    circle.sample( 40, 0 );
+    EXPECT_EQ( m, circle.getClosestPoints( q.data(), m, t.data(), dist.data() ) );
+    for( int i = 0; i < m; i++ ) {
+      EXPECT_NEAR( 0.05 + 0.12*i, t[i], 1e-6 );
+      EXPECT_NEAR( 2.9, dist[i], 1e-9 );
+    }
+
+    PPlane<float> plane( Point<float,3>(0,0,0), Vector<float,3>(2,0,0), Vector<float,3>(0,1,0) );
+    plane.sample( 10, 10, 1, 1 );
+
+    std::vector<Point<float,3>> p(m);
+    for( int i = 0; i < m; i++ )
+      p[i] = Point<float,3>( 0.04f * i, 0.5f + 0.4f * std::sin( float(i) ), 0.1f );
+
+    std::vector<Point<float,2>> uv(m);
+    std::vector<float>          d(m);
+    EXPECT_EQ( m, plane.getClosestPoints( p.data(), m, uv.data(), d.data() ) );
+    EXPECT_NEAR( 0.1f, d[0], 1e-5f );
+
+    plane.setP( Point<float,3>(0,0,5) );
+    plane.sample( 10, 10, 1, 1 );
+    EXPECT_EQ( m, plane.getClosestPoints( p.data(), m, uv.data(), d.data() ) );
+    for( int i = 0; i < m; i++ ) {
+      EXPECT_NEAR( 0.02f * i, uv[i][0], 1e-4f );
+      EXPECT_NEAR( 4.9f, d[i], 1e-4f );
+    }
+  }
+
+}
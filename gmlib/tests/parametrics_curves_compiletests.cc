@@ -25,7 +25,7 @@ namespace {
 template <typename T>
 inline
 void testPCurveStandardMethodCalls( PCurve<T,3>& curve ) {
-  curve.evaluate( curve.getParStart() + curve.getParDelta() * 0.5, 0 );
+  curve.evaluate( T(curve.getParStart() + curve.getParDelta() * 0.5), 0 );
 }
 
 
@@ -118,7 +118,7 @@ TEST(Parametrics_Curves, PBSplineCurveCompile) {
   vec[4]=GMlib::Vector<float,3>(3,1,0);
   vec[5]=GMlib::Vector<float,3>(4,0,0);
 
-  auto pbspline = PBSplineCurve<float>(vec, 1);
+  auto pbspline = PBSplineCurve<float>(vec, 2, false);
   testPCurveStandardMethodCalls(pbspline);
 }
 
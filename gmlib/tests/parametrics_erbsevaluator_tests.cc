@@ -0,0 +1,252 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/evaluators/gmerbsevaluator.h>
+#include <parametrics/evaluators/gmbfbsevaluator.h>
+using namespace GMlib;
+
+// stl
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  // The const (reentrant) evaluation must give exactly the same values as
+  // set() followed by operator(), getDer1() and getDer2().
+  ::testing::AssertionResult statelessTest( BasisEvaluator<long double>& e ) {
+
+    const long double tk[]  = { 0.0l, 0.0l, -1.0l, 2.5l };
+    const long double dtk[] = { 1.0l, 0.3l,  2.0l, 0.7l };
+
+    for( int k = 0; k < 4; k++ ) {
+
+      e.set( tk[k], dtk[k] );
+      for( int i = 0; i <= 100; i++ ) {
+
+        const long double t = tk[k] + i * dtk[k] / 100;
+
+        const long double b0 = e(t);
+        const long double b1 = e.getDer1();
+        const long double b2 = e.getDer2();
+
+        long double b[3];
+        e.eval( b, t, tk[k], dtk[k], 2 );
+
+        if( b[0] != b0 || b[1] != b1 || b[2] != b2 )
+          return ::testing::AssertionFailure() << "eval() differs at t = " << double(t);
+
+        if( e(t, tk[k], dtk[k], 0) != b0 ||
+            e(t, tk[k], dtk[k], 1) != b1 ||
+            e(t, tk[k], dtk[k], 2) != b2 )
+          return ::testing::AssertionFailure() << "operator() differs at t = " << double(t);
+      }
+    }
+
+    return ::testing::AssertionSuccess();
+  }
+
+
+
+  TEST(Parametrics_Evaluators, ERBSEvaluator__Stateless) {
+
+    ERBSEvaluator<long double> e;
+    EXPECT_TRUE( statelessTest( e ) );
+  }
+
+  TEST(Parametrics_Evaluators, BFBSEvaluator__Stateless) {
+
+    BFBSEvaluator<long double> e;
+    EXPECT_TRUE( statelessTest( e ) );
+  }
+
+
+
+  // Several threads using the shared instance must all get the serial result.
+  TEST(Parametrics_Evaluators, ERBSEvaluator__Shared_Instance) {
+
+    const ERBSEvaluator<long double>* e = ERBSEvaluator<long double>::getInstance();
+    EXPECT_EQ( e, ERBSEvaluator<long double>::getInstance() );
+
+    const int m  = 2000;
+    const int nt = 4;
+
+    std::vector<long double> gold(3*m);
+    for( int i = 0; i < m; i++ )
+      e->eval( &gold[3*i], 0.5l + i * 0.001l, 0.5l, 2.0l, 2 );
+
+    std::vector<std::vector<long double>> res( nt, std::vector<long double>(3*m) );
+    std::vector<std::thread> threads;
+    for( int k = 0; k < nt; k++ )
+      threads.push_back( std::thread( [e,&res,k,m]() {
+        for( int i = 0; i < m; i++ )
+          e->eval( &res[k][3*i], 0.5l + i * 0.001l, 0.5l, 2.0l, 2 );
+      } ) );
+    for( auto& th : threads )
+      th.join();
+
+    for( int k = 0; k < nt; k++ )
+      EXPECT_TRUE( res[k] == gold ) << "thread " << k;
+  }
+
+
+
+  // The adaptive table must be the smallest table within the error bounds.
+  TEST(Parametrics_Evaluators, ERBSEvaluator__Adaptive_Table) {
+
+    const Vector<long double,3> eps( 1e-8l, 1e-6l, 1e-3l );
+
+    ERBSEvaluator<long double> e(8);
+    const Vector<long double,3> err = e.initAdaptive( eps );
+
+    EXPECT_LE( err[0], eps[0] );
+    EXPECT_LE( err[1], eps[1] );
+    EXPECT_LE( err[2], eps[2] );
+    EXPECT_EQ( err, e.getMaxError() );
+
+    ERBSEvaluator<long double> half( e.getResolution() / 2 );
+    const Vector<long double,3> err_half = half.getMaxError();
+    EXPECT_TRUE( err_half[0] > eps[0] || err_half[1] > eps[1] || err_half[2] > eps[2] );
+
+    EXPECT_TRUE( statelessTest( e ) );
+
+    // Not reachable within m_max
+    ERBSEvaluator<long double> e1(8);
+    const Vector<long double,3> err1 = e1.initAdaptive( Vector<long double,3>( 0.0l ), 64 );
+    EXPECT_EQ( 64, e1.getResolution() );
+    EXPECT_GT( err1[2], 0.0l );
+  }
+
+
+  TEST(Parametrics_Evaluators, BFBSEvaluator__Adaptive_Table) {
+
+    const Vector<long double,3> eps( 1e-8l, 1e-6l, 1e-3l );
+
+    BFBSEvaluator<long double> e(8);
+    const Vector<long double,3> err = e.initAdaptive( eps, 4096 );
+
+    EXPECT_LE( err[0], eps[0] );
+    EXPECT_LE( err[1], eps[1] );
+    EXPECT_LE( err[2], eps[2] );
+    EXPECT_LT( e.getResolution(), 4096 );
+
+    // For (3,3) the derivative is B'(t) = 140 t^3 (1-t)^3, i.e. B'(1/2) = 140/64
+    long double b[3];
+    e.eval( b, 0.5l, 0, 1, 2 );
+    EXPECT_NEAR( 0.5l, b[0], 1e-8l );
+    EXPECT_NEAR( 2.1875l, b[1], 1e-6l );
+    EXPECT_NEAR( 0.0l, b[2], 1e-3l );
+  }
+
+
+
+  bool sameTable( const BasisEvaluator<long double>& e0, const BasisEvaluator<long double>& e1 ) {
+
+    if( e0.getResolution() != e1.getResolution() || e0.getScale() != e1.getScale() )
+      return false;
+
+    for( int i = 0; i <= 1000; i++ ) {
+
+      long double b0[3], b1[3];
+      e0.eval( b0, i / 1000.0l, 0, 1, 2 );
+      e1.eval( b1, i / 1000.0l, 0, 1, 2 );
+      if( b0[0] != b1[0] || b0[1] != b1[1] || b0[2] != b1[2] )
+        return false;
+    }
+    return true;
+  }
+
+
+
+  // A table read from the cache must be identical to the computed table,
+  // and a table file not matching the evaluator must be rejected.
+  TEST(Parametrics_Evaluators, ERBSEvaluator__Table_Cache) {
+
+    const std::string dir = ::testing::TempDir();
+    ASSERT_TRUE( BasisEvaluator<long double>::getTableCacheDir().empty() );
+
+    ERBSEvaluator<long double> gold( 256, 1.5l );
+
+    BasisEvaluator<long double>::setTableCacheDir( dir );
+    ERBSEvaluator<long double> e0( 256, 1.5l );   // Computed and written
+    ERBSEvaluator<long double> e1( 256, 1.5l );   // Read
+    BasisEvaluator<long double>::setTableCacheDir( "" );
+
+    EXPECT_TRUE( sameTable( gold, e0 ) );
+    EXPECT_TRUE( sameTable( gold, e1 ) );
+
+    const std::string cached = dir + "/" + gold.getTableName() + "_m256_s" + std::to_string( sizeof(long double) ) + ".gmbt";
+    EXPECT_TRUE( std::ifstream( cached.c_str() ).good() );
+    std::remove( cached.c_str() );
+
+    const std::string file = dir + "/" + "test_table.gmbt";
+    ASSERT_TRUE( gold.saveTable( file ) );
+
+    ERBSEvaluator<long double> e2( 16, 1.5l );
+    EXPECT_TRUE( e2.loadTable( file ) );
+    EXPECT_TRUE( sameTable( gold, e2 ) );
+
+    // Other parameters, other basis function, missing and broken files
+    ERBSEvaluator<long double> e3( 16 );
+    BFBSEvaluator<long double> e4( 16 );
+    EXPECT_FALSE( e3.loadTable( file ) );
+    EXPECT_FALSE( e4.loadTable( file ) );
+    EXPECT_FALSE( e3.loadTable( dir + "/" + "no_such_table.gmbt" ) );
+
+    // A changed byte in the table, and a cut table, do not match the checksum
+    {
+      std::fstream fs( file.c_str(), std::ios::binary | std::ios::in | std::ios::out );
+      fs.seekp( -3, std::ios::end );
+      fs.put( '\x5a' );
+    }
+    ERBSEvaluator<long double> e5( 16, 1.5l );
+    EXPECT_FALSE( e5.loadTable( file ) );
+    EXPECT_EQ( 16, e5.getResolution() );
+
+    std::ofstream( file.c_str(), std::ios::binary | std::ios::trunc ) << "GMBT";
+    EXPECT_FALSE( e2.loadTable( file ) );
+    EXPECT_TRUE( sameTable( gold, e2 ) );
+
+    std::remove( file.c_str() );
+  }
+
+
+
+  // Tables written to the same file at the same time, each to a temporary file of its own,
+  // and read meanwhile: what is read is a whole table
+  TEST(Parametrics_Evaluators, ERBSEvaluator__Table_Cache_Concurrent) {
+
+    const std::string file = ::testing::TempDir() + "/" + "test_table_concurrent.gmbt";
+    ERBSEvaluator<long double> gold( 256, 1.5l );
+
+    std::vector<std::thread> threads;
+    std::vector<char>        saved( 8, 0 );
+    for( int k = 0; k < 8; k++ )
+      threads.push_back( std::thread( [&gold,&file,&saved,k]() {
+        for( int i = 0; i < 20; i++ )
+          saved[k] = gold.saveTable( file ) || saved[k];
+      } ) );
+
+    int no_bad = 0;
+    for( int i = 0; i < 50; i++ ) {
+      ERBSEvaluator<long double> e( 16, 1.5l );
+      if( e.loadTable( file ) && !sameTable( gold, e ) ) no_bad++;
+    }
+    for( auto& th : threads ) th.join();
+
+    EXPECT_EQ( 0, no_bad );
+    for( int k = 0; k < 8; k++ ) EXPECT_TRUE( saved[k] );
+
+    ERBSEvaluator<long double> e( 16, 1.5l );
+    EXPECT_TRUE( e.loadTable( file ) );
+    EXPECT_TRUE( sameTable( gold, e ) );
+    std::remove( file.c_str() );
+  }
+
+}
@@ -0,0 +1,104 @@
+
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/evaluators/gmevaluatorstatic.h>
+using namespace GMlib;
+
+
+
+namespace {
+
+
+  // A knot vector with different knot intervals, for degree d
+  DVector<double> knotVector( int d, int n ) {
+
+    DVector<double> t(n+d+1);
+    for( int i = 0; i <= d; i++ ) {
+      t[i]     = 0.0;
+      t[n+i]   = 1.0 + n;
+    }
+    for( int i = d+1; i < n; i++ )
+      t[i] = (i-d) + 0.25*((i*7)%3);
+    return t;
+  }
+
+
+  template <typename T>
+  ::testing::AssertionResult equal( const DMatrix<T>& a, const DMatrix<T>& b ) {
+
+    if( a.getDim1() != b.getDim1() || a.getDim2() != b.getDim2() )
+      return ::testing::AssertionFailure() << "dim mismatch";
+
+    for( int i = 0; i < a.getDim1(); i++ )
+      for( int j = 0; j < a.getDim2(); j++ )
+        if( a(i)(j) != b(i)(j) )
+          return ::testing::AssertionFailure() << "element (" << i << "," << j << ") differs: "
+                                               << a(i)(j) << " != " << b(i)(j);
+    return ::testing::AssertionSuccess();
+  }
+
+
+
+  // The degree specialized kernels must give exactly the same matrices as the generic kernels
+  TEST(Parametrics_EvaluatorStatic, EvaluateBhp_Degree_Specialized) {
+
+    for( int d = 1; d <= 7; d++ )
+      for( int i = 0; i <= 20; i++ ) {
+
+        const double t = i/20.0;
+        DMatrix<double> a, b;
+        EvaluatorStatic<double>::evaluateBhp( a, d, t, 2.5 );
+        EvaluatorStatic<double>::evaluateBhpGeneric( b, d, t, 2.5 );
+        EXPECT_TRUE( equal( a, b ) ) << "degree " << d << ", t = " << t;
+
+        DMatrix<float> af, bf;
+        EvaluatorStatic<float>::evaluateBhp( af, d, float(t) );
+        EvaluatorStatic<float>::evaluateBhpGeneric( bf, d, float(t) );
+        EXPECT_TRUE( equal( af, bf ) ) << "degree " << d << ", t = " << t;
+      }
+  }
+
+
+  TEST(Parametrics_EvaluatorStatic, EvaluateBSp2_Degree_Specialized) {
+
+    for( int d = 1; d <= 7; d++ ) {
+
+      const int n = 12;
+      const DVector<double> tv = knotVector( d, n );
+
+      for( int i = 0; i <= 50; i++ ) {
+
+        const double t = tv(d) + i*(tv(n)-tv(d))/50.0;
+        for( int left = 0; left < 2; left++ ) {
+
+          const int k = EvaluatorStatic<double>::knotIndex( tv, t, d, left );
+          DMatrix<double> a, b;
+          EvaluatorStatic<double>::evaluateBSp2( a, t, tv, d, k, 0.5 );
+          EvaluatorStatic<double>::evaluateBSp2Generic( b, t, tv, d, k, 0.5 );
+          EXPECT_TRUE( equal( a, b ) ) << "degree " << d << ", t = " << t;
+        }
+      }
+    }
+  }
+
+
+  // Check some known values of the Bernstein-Hermite matrix
+  TEST(Parametrics_EvaluatorStatic, EvaluateBhp_Values) {
+
+    DMatrix<double> m;
+    EvaluatorStatic<double>::evaluateBhp( m, 2, 0.5 );
+
+    EXPECT_DOUBLE_EQ(  0.25, m(0)(0) );
+    EXPECT_DOUBLE_EQ(  0.5,  m(0)(1) );
+    EXPECT_DOUBLE_EQ(  0.25, m(0)(2) );
+    EXPECT_DOUBLE_EQ( -1.0,  m(1)(0) );
+    EXPECT_DOUBLE_EQ(  0.0,  m(1)(1) );
+    EXPECT_DOUBLE_EQ(  1.0,  m(1)(2) );
+    EXPECT_DOUBLE_EQ(  2.0,  m(2)(0) );
+    EXPECT_DOUBLE_EQ( -4.0,  m(2)(1) );
+    EXPECT_DOUBLE_EQ(  2.0,  m(2)(2) );
+  }
+
+}
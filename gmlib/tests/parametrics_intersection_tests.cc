@@ -0,0 +1,168 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/curves/gmpbeziercurve.h>
+#include <parametrics/curves/gmpcircle.h>
+#include <parametrics/curves/gmperbscurve.h>
+#include <parametrics/curves/gmpline.h>
+#include <parametrics/surfaces/gmptorus.h>
+#include <parametrics/utils/gmpintersection.h>
+using namespace GMlib;
+
+// stl
+#include <cmath>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  // The circle of radius 2 and the ellipse with radii 3 and 1 meet where cos(a) = +-sqrt(3/8) on the ellipse
+  std::vector<double> ellipsePars() {
+
+    const double a = std::acos( std::sqrt( 3.0/8.0 ) );
+    return std::vector<double>{ a, M_PI - a, M_PI + a, 2*M_PI - a };
+  }
+
+  double circlePar( double a ) {
+
+    const double t = std::atan2( std::sin( a ), 3.0 * std::cos( a ) );
+    return t < 0.0 ? t + 2*M_PI : t;
+  }
+
+
+
+  TEST(Parametrics_Intersection, PCircle_PLine) {
+
+    PCircle<double> circle( 2.0 );
+    PLine<double>   line( Point<double,3>( -3.0, 0.0, 0.0 ), Point<double,3>( 3.0, 0.0, 0.0 ) );
+
+    // One of them at the start/end of the closed circle
+    const std::vector<GMPintersection::CurveCurve<double>> x = GMPintersection::getIntersections( line, circle );
+    ASSERT_EQ( 2u, x.size() );
+    EXPECT_NEAR( 1.0/6.0, x[0].t1, 1e-9 );
+    EXPECT_NEAR( M_PI,    x[0].t2, 1e-9 );
+    EXPECT_NEAR( 5.0/6.0, x[1].t1, 1e-9 );
+    EXPECT_NEAR( 0.0, std::sin( x[1].t2 ), 1e-9 );
+    EXPECT_NEAR( 2.0, x[1].pos[0], 1e-9 );
+    EXPECT_LE( x[1].dist, 1e-6 );
+
+    // Apart
+    PLine<double> above( Point<double,3>( -3.0, 0.0, 0.5 ), Point<double,3>( 3.0, 0.0, 0.5 ) );
+    EXPECT_TRUE( GMPintersection::getIntersections( above, circle ).empty() );
+  }
+
+
+
+  TEST(Parametrics_Intersection, PCircle_Ellipse) {
+
+    PCircle<double> circle( 2.0 );
+    PCircle<double> ellipse( 3.0, 1.0 );
+    const std::vector<double> gold = ellipsePars();
+
+    // Unsampled, and sampled with the samples as the intervals
+    for( int sampled = 0; sampled < 2; sampled++ ) {
+
+      if( sampled ) {
+        circle.sample( 30, 0 );
+        ellipse.sample( 50, 0 );
+      }
+
+      const std::vector<GMPintersection::CurveCurve<double>> x = GMPintersection::getIntersections( ellipse, circle, 1e-8 );
+      ASSERT_EQ( 4u, x.size() );
+      for( int i = 0; i < 4; i++ ) {
+        EXPECT_NEAR( gold[i], x[i].t1, 1e-8 );
+        EXPECT_NEAR( circlePar( gold[i] ), x[i].t2, 1e-8 );
+        EXPECT_NEAR( 2.0, std::sqrt( x[i].pos * x[i].pos ), 1e-8 );
+      }
+    }
+  }
+
+
+
+  // One sample interval with a bulge that the ends and the middle of the interval do not show:
+  // y(s) = 100 s^2 (1-s)^2 (s - 1/2) is 0 with 0 derivative at the ends, and 0 in the middle
+  TEST(Parametrics_Intersection, Bulge) {
+
+    DVector<Vector<double,3>> cp( 6 );
+    const double y[6] = { 0.0, 0.0, -5.0, 5.0, 0.0, 0.0 };
+    for( int i = 0; i < 6; i++ ) cp[i] = Vector<double,3>( i / 5.0, y[i], 0.0 );
+    PBezierCurve<double> bulge( cp );
+    bulge.sample( 2, 0 );
+
+    std::vector<double> t;
+    bulge.getSampleParameters( t );
+    ASSERT_EQ( 2u, t.size() );
+
+    const double s  = 0.5 - std::sqrt( 0.05 );
+    const double ys = 100.0 * s*s * (1.0-s)*(1.0-s) * (s - 0.5);
+    PLine<double> line( Point<double,3>( s, -2.0, 0.0 ), Point<double,3>( s, -0.5, 0.0 ) );
+
+    const std::vector<GMPintersection::CurveCurve<double>> x = GMPintersection::getIntersections( bulge, line );
+    ASSERT_EQ( 1u, x.size() );
+    EXPECT_NEAR( s,  x[0].t1, 1e-8 );
+    EXPECT_NEAR( ys, x[0].pos[1], 1e-8 );
+  }
+
+
+
+  // Many intervals on both curves, and the same result for any number of threads
+  TEST(Parametrics_Intersection, PERBSCurve) {
+
+    PCircle<double> circle( 2.0 );
+    PCircle<double> ellipse( 3.0, 1.0 );
+    PERBSCurve<double> c1( &circle, 300 );
+    PERBSCurve<double> c2( &ellipse, 200 );
+    const std::vector<double> gold = ellipsePars();
+
+    const std::vector<GMPintersection::CurveCurve<double>> x = GMPintersection::getIntersections( c2, c1, 1e-7, 1 );
+    ASSERT_EQ( 4u, x.size() );
+    for( int i = 0; i < 4; i++ )
+      EXPECT_NEAR( 2.0, std::sqrt( x[i].pos * x[i].pos ), 1e-5 );
+
+    const std::vector<GMPintersection::CurveCurve<double>> y = GMPintersection::getIntersections( c2, c1, 1e-7, 3 );
+    ASSERT_EQ( x.size(), y.size() );
+    for( unsigned int i = 0; i < x.size(); i++ ) {
+      EXPECT_EQ( x[i].t1, y[i].t1 );
+      EXPECT_EQ( x[i].t2, y[i].t2 );
+    }
+  }
+
+
+
+  TEST(Parametrics_Intersection, PLine_PTorus) {
+
+    PTorus<double> torus( 3.0, 1.0, 1.0 );
+
+    // Through the hole, along the seams of the torus (u = 0 and v = 0)
+    PLine<double> line( Point<double,3>( -5.0, 0.0, 0.0 ), Point<double,3>( 5.0, 0.0, 0.0 ) );
+    std::vector<GMPintersection::CurveSurf<double>> x = GMPintersection::getIntersections( line, torus );
+    ASSERT_EQ( 4u, x.size() );
+    const double t[4] = { 0.1, 0.3, 0.7, 0.9 };
+    for( int i = 0; i < 4; i++ ) {
+      EXPECT_NEAR( t[i], x[i].t, 1e-9 );
+      EXPECT_NEAR( 0.0, std::sin( x[i].uv[0] ), 1e-9 );
+      EXPECT_NEAR( 0.0, std::sin( x[i].uv[1] ), 1e-9 );
+    }
+
+    // Above the middle, where sin(v) = 1/2
+    torus.sample( 20, 20, 1, 1 );
+    PLine<double> above( Point<double,3>( -5.0, 0.0, 0.5 ), Point<double,3>( 5.0, 0.0, 0.5 ) );
+    x = GMPintersection::getIntersections( above, torus );
+    ASSERT_EQ( 4u, x.size() );
+    const double c = std::cos( M_PI/6 );
+    const double px[4] = { -3.0 - c, -3.0 + c, 3.0 - c, 3.0 + c };
+    for( int i = 0; i < 4; i++ ) {
+      EXPECT_NEAR( px[i], x[i].pos[0], 1e-9 );
+      EXPECT_NEAR( 0.5,   std::sin( x[i].uv[1] ), 1e-9 );
+    }
+
+    // Inside the tube
+    PCircle<double> inside( 3.0 );
+    EXPECT_TRUE( GMPintersection::getIntersections( inside, torus ).empty() );
+  }
+
+}
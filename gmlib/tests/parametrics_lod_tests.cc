@@ -0,0 +1,325 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/curves/gmpbeziercurve.h>
+#include <parametrics/curves/gmpbsplinecurve.h>
+#include <parametrics/curves/gmpcircle.h>
+#include <parametrics/surfaces/gmptorus.h>
+#include <scene/gmscene.h>
+#include <scene/camera/gmcamera.h>
+#include <scene/camera/gmisocamera.h>
+using namespace GMlib;
+
+// stl
+#include <vector>
+
+
+
+namespace {
+
+
+
+  // Gives access to the (protected) samples
+  class LodTorus : public PTorus<float> {
+    GM_SCENEOBJECT(LodTorus)
+  public:
+    using PTorus<float>::PTorus;
+
+    const DSampleGrid<Vector<float,3>>& getSamples() const { return this->_visu[0][0].sample_val; }
+  };
+
+  class LodCircle : public PCircle<double> {
+    GM_SCENEOBJECT(LodCircle)
+  public:
+    using PCircle<double>::PCircle;
+
+    const std::vector<DVector<Vector<double,3>>>& getSamples() const { return this->_visu[0].sample_val; }
+  };
+
+  // Moves a control point as a selector does
+  class LodBezier : public PBezierCurve<double> {
+    GM_SCENEOBJECT(LodBezier)
+  public:
+    using PBezierCurve<double>::PBezierCurve;
+
+    const std::vector<DVector<Vector<double,3>>>& getSamples() const { return this->_visu[0].sample_val; }
+    void move( int i, const Vector<double,3>& dp ) { this->_c[i] += dp; this->edit( i, dp ); this->replot(); }
+  };
+
+  class LodBSpline : public PBSplineCurve<double> {
+    GM_SCENEOBJECT(LodBSpline)
+  public:
+    using PBSplineCurve<double>::PBSplineCurve;
+
+    const std::vector<DVector<Vector<double,3>>>& getSamples() const { return this->_visu[0].sample_val; }
+    void move( int i, const Vector<double,3>& dp ) { this->_c[i] += dp; this->edit( i, dp ); this->replot(); }
+  };
+
+
+
+  // Waits for the background sampling of a new level, and swaps it in
+  template <typename O>
+  bool swapLevel( O& obj ) {
+
+    obj.waitAsyncReplot();
+    return obj.swapAsyncReplot();
+  }
+
+
+
+  // Moves a control point, the samples must still be on the curve
+  template <typename C>
+  void moveAndCheck( C& curve, unsigned int m ) {
+
+    curve.move( 2, Vector<double,3>( 0.0, 0.0, 1.0 ) );
+    ASSERT_EQ( m, curve.getSamples().size() );
+    for( unsigned int i = 0; i < m; i++ ) {
+      const Vector<double,3> p = curve.evaluate( curve.getSampleValues()[i], 0 )[0];
+      EXPECT_NEAR( 0.0, (curve.getSamples()[i][0] - p).getLength(), 1e-9 );
+    }
+  }
+
+  // Edits after a level is swapped in from the background sampling and from the cache
+  template <typename C>
+  void editSwappedLevel( C& curve ) {
+
+    curve.sample( 10, 1 );
+    curve.setLodLevels( { 10, 40 } );
+    curve.setLodLevel( 1 );
+    ASSERT_TRUE( swapLevel( curve ) );
+    moveAndCheck( curve, 40 );
+
+    curve.setLodLevel( 0 );
+    ASSERT_TRUE( swapLevel( curve ) );
+    curve.setLodLevel( 1 );
+    moveAndCheck( curve, 40 );
+  }
+
+
+
+  TEST(Parametrics_Lod, SelectLodLevel) {
+
+    LodCircle circle( 1.0 );
+    EXPECT_EQ( -1, circle.selectLodLevel( 100.0f ) );
+
+    // 10 pixels between the samples, 2*radius/10 samples are wanted
+    circle.setLodLevels( { 8, 16, 32, 64 }, 10.0f );
+    EXPECT_EQ( 0, circle.selectLodLevel( 10.0f ) );
+    EXPECT_EQ( 1, circle.selectLodLevel( 50.0f ) );
+    EXPECT_EQ( 2, circle.selectLodLevel( 150.0f ) );
+    EXPECT_EQ( 3, circle.selectLodLevel( 1000.0f ) );
+
+    // A coarser level is only selected when it has a margin
+    circle.setLodLevel( 2 );
+    EXPECT_TRUE( swapLevel( circle ) );
+    EXPECT_EQ( 2, circle.getLodLevel() );
+    EXPECT_EQ( 2, circle.selectLodLevel( 75.0f ) );
+    EXPECT_EQ( 1, circle.selectLodLevel( 60.0f ) );
+    EXPECT_EQ( 3, circle.selectLodLevel( 170.0f ) );
+  }
+
+
+
+  // Changing level must give the same samples as sampling, and a recently used
+  // level must be swapped in from the cache.
+  TEST(Parametrics_Lod, PSurf) {
+
+    LodTorus torus( 3.0f, 1.0f, 1.0f );
+    torus.sample( 10, 10, 1, 1 );
+    torus.setLodLevels( { Vector<int,2>(8,6), Vector<int,2>(24,12), Vector<int,2>(48,24) }, 8.0f, 1 );
+
+    // A new level is sampled in the background, the current samples are kept until it is swapped in
+    torus.setLodLevel( 1 );
+    EXPECT_TRUE( torus.isAsyncReplotPending() );
+    EXPECT_EQ( -1, torus.getLodLevel() );
+    EXPECT_EQ( 10, torus.getSamples().getDim1() );
+    EXPECT_TRUE( swapLevel( torus ) );
+    EXPECT_EQ( 1, torus.getLodLevel() );
+    EXPECT_EQ( 24, torus.getSamples().getDim1() );
+    EXPECT_EQ( 12, torus.getSamples().getDim2() );
+    const Vector<float,3>* level1 = torus.getSamples().getPlane(0,0);
+
+    torus.setLodLevel( 0 );
+    EXPECT_TRUE( swapLevel( torus ) );
+    EXPECT_EQ( 8, torus.getSamples().getDim1() );
+    EXPECT_EQ( 6, torus.getSamples().getDim2() );
+
+    // Level 1 is cached, and swapped in at once
+    torus.setLodLevel( 1 );
+    EXPECT_FALSE( torus.isAsyncReplotPending() );
+    EXPECT_EQ( 1, torus.getLodLevel() );
+    EXPECT_EQ( level1, torus.getSamples().getPlane(0,0) );
+    EXPECT_EQ( 24, torus.getSamples().getDim1() );
+
+    LodTorus gold( 3.0f, 1.0f, 1.0f );
+    gold.sample( 24, 12, 1, 1 );
+    for( int i = 0; i < 24; i++ )
+      for( int j = 0; j < 12; j++ )
+        for( int k = 0; k < 2; k++ )
+          for( int l = 0; l < 2; l++ )
+            EXPECT_EQ( gold.getSamples()(i,j,k,l), torus.getSamples()(i,j,k,l) );
+
+    // Going back to the current level drops the pending level
+    torus.setLodLevel( 2 );
+    torus.setLodLevel( 1 );
+    EXPECT_FALSE( torus.isAsyncReplotPending() );
+    EXPECT_EQ( 24, torus.getSamples().getDim1() );
+
+    // Only one level is kept, level 0 is sampled again
+    torus.setLodLevel( 2 );
+    EXPECT_TRUE( swapLevel( torus ) );
+    torus.setLodLevel( 0 );
+    EXPECT_TRUE( torus.isAsyncReplotPending() );
+    EXPECT_TRUE( swapLevel( torus ) );
+    EXPECT_EQ( 8, torus.getSamples().getDim1() );
+    torus.setLodLevel( 2 );
+    EXPECT_FALSE( torus.isAsyncReplotPending() );
+    EXPECT_EQ( 48, torus.getSamples().getDim1() );
+    EXPECT_EQ( 24, torus.getSamples().getDim2() );
+  }
+
+
+
+  TEST(Parametrics_Lod, PCurve) {
+
+    LodCircle circle( 2.0 );
+    circle.sample( 10, 1 );
+    circle.setLodLevels( { 10, 40 } );
+
+    circle.setLodLevel( 1 );
+    EXPECT_EQ( 10u, circle.getSamples().size() );
+    EXPECT_TRUE( swapLevel( circle ) );
+    ASSERT_EQ( 40u, circle.getSamples().size() );
+    ASSERT_EQ( 40u, circle.getSampleValues().size() );
+    const Vector<double,3>* level1 = circle.getSamples()[0].getPtr();
+
+    circle.setLodLevel( 0 );
+    EXPECT_TRUE( swapLevel( circle ) );
+    EXPECT_EQ( 10u, circle.getSamples().size() );
+    EXPECT_EQ( 10u, circle.getSampleValues().size() );
+
+    circle.setLodLevel( 1 );
+    ASSERT_EQ( 40u, circle.getSamples().size() );
+    EXPECT_EQ( level1, circle.getSamples()[0].getPtr() );
+    EXPECT_EQ( 40, circle.getNumSamples() );
+
+    for( unsigned int i = 0; i < 40; i++ )
+      EXPECT_NEAR( 2.0, circle.getSamples()[i][0].getLength(), 1e-12 );
+
+    // An edit while a level is sampled starts the sampling again
+    circle.setLodLevels( { 10, 40, 80 } );
+    circle.setLodLevel( 2 );
+    circle.setRadius( 3.0 );
+    circle.replot();
+    EXPECT_TRUE( swapLevel( circle ) );
+    ASSERT_EQ( 80u, circle.getSamples().size() );
+    for( unsigned int i = 0; i < 80; i++ )
+      EXPECT_NEAR( 3.0, circle.getSamples()[i][0].getLength(), 1e-12 );
+  }
+
+
+
+  TEST(Parametrics_Lod, EditSwappedLevel) {
+
+    DVector<Vector<double,3>> c( 5 );
+    for( int i = 0; i < 5; i++ )
+      c[i] = Vector<double,3>( double(i), double(i % 2), 0.0 );
+
+    LodBezier bezier( c );
+    editSwappedLevel( bezier );
+
+    LodBSpline spline( c, 3, false );
+    editSwappedLevel( spline );
+  }
+
+
+
+  // The level follows the size of each object on the screen, also when a
+  // larger object is updated before it.
+  TEST(Parametrics_Lod, LocalUpdateLod) {
+
+    Scene scene;
+    LodCircle* big   = new LodCircle( 4.0 );
+    LodCircle* small = new LodCircle( 1.0 );
+    big->sample( 64, 1 );
+    big->replot();
+    small->sample( 64, 1 );
+    small->replot();
+    big->setLodLevels( { 8, 16, 32, 64 }, 10.0f );
+    small->setLodLevels( { 8, 16, 32, 64 }, 10.0f );
+    scene.insert( big );
+    scene.insert( small );
+    scene.prepare();
+
+    // 400 pixels high viewport, tan of the half opening angle 13/50
+    Camera cam( Point<float,3>( 0.0f, 0.0f, 40.0f ), Point<float,3>( 0.0f, 0.0f, 0.0f ) );
+    cam.reshape( 0, 0, 400, 400 );
+
+    const float r_big   = big->getSurroundingSphere().getRadius();
+    const float r_small = small->getSurroundingSphere().getRadius();
+    EXPECT_NEAR( 4.0f, r_big, 0.1f );
+    EXPECT_NEAR( 1.0f, r_small, 0.1f );
+    EXPECT_NEAR( 0.5f * 400.0f * r_big / (40.0f * 0.26f), cam.getProjectedRadius( big->getSurroundingSphere() ), 1e-3f );
+    EXPECT_NEAR( 0.5f * 400.0f * r_small / (40.0f * 0.26f), cam.getProjectedRadius( small->getSurroundingSphere() ), 1e-3f );
+
+    // About 77 and 19 pixels, 15 and 4 samples are wanted.
+    // The levels are sampled in the background, and swapped in by the next update.
+    scene.updateLod( cam );
+    EXPECT_EQ( -1, big->getLodLevel() );
+    big->waitAsyncReplot();
+    small->waitAsyncReplot();
+    scene.updateLod( cam );
+    EXPECT_EQ( 1, big->getLodLevel() );
+    EXPECT_EQ( 0, small->getLodLevel() );
+
+    // Updating again does not change anything
+    scene.updateLod( cam );
+    EXPECT_EQ( 1, big->getLodLevel() );
+    EXPECT_EQ( 0, small->getLodLevel() );
+
+    // Four times closer, about 308 and 77 pixels
+    Camera near_cam( Point<float,3>( 0.0f, 0.0f, 10.0f ), Point<float,3>( 0.0f, 0.0f, 0.0f ) );
+    near_cam.reshape( 0, 0, 400, 400 );
+    small->updateLod( near_cam );
+    small->waitAsyncReplot();
+    small->updateLod( near_cam );
+    EXPECT_EQ( 1, small->getLodLevel() );
+    EXPECT_EQ( 16u, small->getSamples().size() );
+    big->updateLod( near_cam );
+    big->waitAsyncReplot();
+    big->updateLod( near_cam );
+    EXPECT_EQ( 3, big->getLodLevel() );
+  }
+
+
+
+  // With an orthographic camera the size on the screen, and the level, does not depend on the distance.
+  TEST(Parametrics_Lod, IsoCamera) {
+
+    Scene scene;
+    LodCircle* circle = new LodCircle( 4.0 );
+    circle->sample( 64, 1 );
+    circle->replot();
+    circle->setLodLevels( { 8, 16, 32, 64 }, 10.0f );
+    scene.insert( circle );
+    scene.prepare();
+
+    const float r = circle->getSurroundingSphere().getRadius();
+    EXPECT_NEAR( 4.0f, r, 0.1f );
+
+    // The 400 pixels high viewport shows 2 * 8 units, i.e. about 100 pixels and 20 samples are wanted
+    for( float z : { 10.0f, 40.0f, 400.0f } ) {
+
+      IsoCamera cam( Point<float,3>( 0.0f, 0.0f, z ), Vector<float,3>( 0.0f, 0.0f, -1.0f ), Vector<float,3>( 0.0f, 1.0f, 0.0f ), 8.0f );
+      cam.reshape( 0, 0, 400, 400 );
+      EXPECT_NEAR( 0.5f * 400.0f * r / 8.0f, cam.getProjectedRadius( circle->getSurroundingSphere() ), 1e-3f );
+
+      scene.updateLod( cam );
+      circle->waitAsyncReplot();
+      scene.updateLod( cam );
+      EXPECT_EQ( 2, circle->getLodLevel() ) << "distance " << z;
+    }
+  }
+
+}
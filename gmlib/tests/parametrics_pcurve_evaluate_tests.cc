@@ -0,0 +1,148 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/curves/gmpcircle.h>
+#include <parametrics/curves/gmpbeziercurve.h>
+#include <parametrics/curves/gmpbsplinecurve.h>
+#include <parametrics/curves/gmperbscurve.h>
+#include <parametrics/curves/gmpsubcurve.h>
+using namespace GMlib;
+
+// stl
+#include <thread>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  DVector<Vector<double,3>> controlPoints() {
+
+    DVector<Vector<double,3>> c(6);
+    c[0] = Vector<double,3>(0,0,0);
+    c[1] = Vector<double,3>(1,1,0);
+    c[2] = Vector<double,3>(2,0,1);
+    c[3] = Vector<double,3>(2,1,0);
+    c[4] = Vector<double,3>(3,1,2);
+    c[5] = Vector<double,3>(4,0,0);
+    return c;
+  }
+
+
+
+  // The reentrant evaluator must give the same result as the cached one,
+  // and must not touch the cached result of the curve.
+  ::testing::AssertionResult reentrantTest( PCurve<double,3>& curve, int d ) {
+
+    const int    m  = 17;
+    const double dt = curve.getParDelta() / (m-1);
+
+    for( int i = 0; i < m; i++ ) {
+
+      const double t = curve.getParStart() + i * dt;
+
+      const DVector<Vector<double,3>> gold = curve.evaluate( t, d );
+
+      DVector<Vector<double,3>> p;
+      curve.evaluate( p, t, d );
+
+      if( p.getDim() != gold.getDim() )
+        return ::testing::AssertionFailure() << "dim mismatch at t = " << t;
+
+      for( int j = 0; j < p.getDim(); j++ )
+        for( int k = 0; k < 3; k++ )
+          if( p[j][k] != gold[j][k] )
+            return ::testing::AssertionFailure() << "value mismatch at t = " << t << ", der " << j;
+    }
+
+    const double     t = curve.getParStart() + 0.25 * curve.getParDelta();
+    const Point<double,3> pos = curve.getPosition( t );
+
+    DVector<Vector<double,3>> p;
+    curve.evaluate( p, curve.getParEnd(), d );
+    curve.evaluateParent( p, curve.getParEnd(), d );
+
+    if( curve.getPosition( t ) != pos )
+      return ::testing::AssertionFailure() << "cached evaluation altered";
+
+    return ::testing::AssertionSuccess();
+  }
+
+
+
+  // Several threads evaluating the same curve must all get the serial result.
+  ::testing::AssertionResult concurrentTest( const PCurve<double,3>& curve, int d ) {
+
+    const int    m  = 1000;
+    const int    nt = 4;
+    const double dt = curve.getParDelta() / (m-1);
+
+    std::vector<DVector<Vector<double,3>>> gold(m);
+    for( int i = 0; i < m; i++ )
+      curve.evaluate( gold[i], curve.getParStart() + i * dt, d );
+
+    std::vector<std::vector<DVector<Vector<double,3>>>> res(nt, std::vector<DVector<Vector<double,3>>>(m));
+    std::vector<std::thread> threads;
+    for( int k = 0; k < nt; k++ )
+      threads.push_back( std::thread( [&curve,&res,k,m,dt,d]() {
+        for( int i = 0; i < m; i++ )
+          curve.evaluate( res[k][i], curve.getParStart() + i * dt, d );
+      } ) );
+    for( auto& th : threads )
+      th.join();
+
+    for( int k = 0; k < nt; k++ )
+      for( int i = 0; i < m; i++ )
+        for( int j = 0; j <= d; j++ )
+          if( res[k][i][j] != gold[i][j] )
+            return ::testing::AssertionFailure() << "thread " << k << " differs at sample " << i;
+
+    return ::testing::AssertionSuccess();
+  }
+
+
+
+  TEST(Parametrics_PCurve_Evaluate, PCircle) {
+
+    PCircle<double> curve(2.0);
+    EXPECT_TRUE( reentrantTest( curve, 2 ) );
+    EXPECT_TRUE( concurrentTest( curve, 2 ) );
+
+    curve.setDomain( 1.0, 3.0 );
+    EXPECT_TRUE( reentrantTest( curve, 2 ) );
+  }
+
+  TEST(Parametrics_PCurve_Evaluate, PBezierCurve) {
+
+    PBezierCurve<double> curve( controlPoints() );
+    EXPECT_TRUE( reentrantTest( curve, 3 ) );
+    EXPECT_TRUE( concurrentTest( curve, 3 ) );
+  }
+
+  TEST(Parametrics_PCurve_Evaluate, PBSplineCurve) {
+
+    PBSplineCurve<double> curve( controlPoints(), 3, false );
+    EXPECT_TRUE( reentrantTest( curve, 2 ) );
+    EXPECT_TRUE( concurrentTest( curve, 2 ) );
+  }
+
+  TEST(Parametrics_PCurve_Evaluate, PSubCurve) {
+
+    PCircle<double> circle(2.0);
+    PSubCurve<double> curve( &circle, 0.5, 2.5, 1.0 );
+    EXPECT_TRUE( reentrantTest( curve, 2 ) );
+    EXPECT_TRUE( concurrentTest( curve, 2 ) );
+  }
+
+  TEST(Parametrics_PCurve_Evaluate, PERBSCurve) {
+
+    PCircle<double> circle(2.0);
+    PERBSCurve<double> curve( &circle, 6, 2 );
+    EXPECT_TRUE( reentrantTest( curve, 1 ) );
+    EXPECT_TRUE( concurrentTest( curve, 2 ) );
+  }
+
+}
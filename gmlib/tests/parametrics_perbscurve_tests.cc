@@ -0,0 +1,108 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/curves/gmpcircle.h>
+#include <parametrics/curves/gmperbscurve.h>
+using namespace GMlib;
+
+// stl
+#include <cmath>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  // Gives access to the (protected) samples and surrounding sphere of the curve
+  class SampledERBSCurve : public PERBSCurve<double> {
+  public:
+    using PERBSCurve<double>::PERBSCurve;
+
+    typedef PCurve<double,3>::Sampler Sampler;
+
+    const Sampler&         getSamples() const { return this->_visu; }
+    const Sphere<float,3>& getSphere()  const { return this->_sphere; }
+  };
+
+
+
+  // All the samples must be inside the surrounding sphere of the curve
+  bool insideSphere( const SampledERBSCurve& curve ) {
+
+    const Sphere<float,3>& sph = curve.getSphere();
+    for( const auto& part : curve.getSamples() )
+      for( const auto& p : part.sample_val )
+        if( ( Point<float,3>( p[0] ) - sph.getPos() ).getLength() > sph.getRadius() + 1e-4f )
+          return false;
+    return true;
+  }
+
+
+
+  // Editing a local curve must only change the samples in the support of the local curve,
+  // and the changed samples must be the same as when evaluating the edited curve.
+  TEST(Parametrics_PERBSCurve, Edit_Local_Curve) {
+
+    PCircle<double> circle(2.0);
+    SampledERBSCurve curve( &circle, 12, 2 );
+    curve.sample( 240, 1 );
+    curve.replot();
+    const Sphere<float,3> sphere = curve.getSphere();
+
+    const SampledERBSCurve::Sampler& s = curve.getSamples();
+    std::vector<std::vector<DVector<Vector<double,3>>>> before;
+    for( unsigned int i = 0; i < s.size(); i++ )
+      before.push_back( s[i].sample_val );
+
+    PCurve<double,3>* local = curve.getLocalCurves()[5];
+    local->translateParent( Vector<float,3>( 0.1f, 0.2f, 0.3f ) );
+    curve.edit( local );
+    curve.replot();
+
+    int changed = 0, unchanged = 0;
+    for( unsigned int i = 0; i < s.size(); i++ )
+      for( unsigned int j = 0; j < s[i].size(); j++ ) {
+
+        if( s[i].sample_val[j][0] == before[i][j][0] ) {
+          unchanged++;
+          continue;
+        }
+        changed++;
+
+        DVector<Vector<double,3>> p;
+        curve.evaluate( p, s[i][j], 1, j+1 == s[i].size() );
+        for( int d = 0; d < 2; d++ )
+          for( int k = 0; k < 3; k++ )
+            EXPECT_NEAR( p[d][k], s[i].sample_val[j][d][k], 1e-9 ) << "partition " << i << ", sample " << j;
+      }
+
+    // The local curve has support on 2 of the 12 knot intervals
+    EXPECT_GT( changed, 0 );
+    EXPECT_GT( unchanged, 3 * changed );
+
+    // The surrounding sphere grows with the changed samples
+    local->translateParent( Vector<float,3>( -0.1f, -0.2f, 3.7f ) );
+    curve.edit( local );
+    curve.replot();
+    EXPECT_GT( curve.getSphere().getRadius(), sphere.getRadius() );
+    EXPECT_TRUE( insideSphere( curve ) );
+
+    // Moving the local curve back, the sphere shrinks when it is made again from all samples,
+    // i.e. at the latest after as many sample updates as there are samples
+    local->translateParent( Vector<float,3>( 0.0f, 0.0f, -4.0f ) );
+    int edits = 0;
+    do {
+      curve.edit( local );
+      curve.replot();
+      EXPECT_TRUE( insideSphere( curve ) );
+    } while( ++edits < 20 && curve.getSphere().getRadius() > sphere.getRadius() + 1e-5f );
+
+    EXPECT_LT( edits, 20 );
+    EXPECT_NEAR( sphere.getRadius(), curve.getSphere().getRadius(), 1e-5f );
+    EXPECT_NEAR( 0.0f, ( sphere.getPos() - curve.getSphere().getPos() ).getLength(), 1e-5f );
+  }
+
+}
@@ -0,0 +1,178 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <parametrics/surfaces/gmptorus.h>
+#include <parametrics/surfaces/gmpsphere.h>
+#include <parametrics/surfaces/gmpbeziersurf.h>
+#include <parametrics/surfaces/gmperbssurf.h>
+using namespace GMlib;
+
+// stl
+#include <cmath>
+
+
+
+namespace {
+
+
+
+  // Gives access to the (protected) resample function of a surface
+  template <typename Surf>
+  class Resampler : public Surf {
+  public:
+    using Surf::Surf;
+    using PSurf<float,3>::resample;
+
+    void getSamples( DSampleGrid<Vector<float,3>>& p, int m1, int m2, int d1, int d2 ) {
+
+      this->sample( m1, m2, d1, d2 );
+      this->resample( p, m1, m2, d1, d2,
+                      this->getParStartU(), this->getParStartV(), this->getParEndU(), this->getParEndV() );
+    }
+  };
+
+
+
+  DMatrix<Vector<float,3>> controlNet() {
+
+    DMatrix<Vector<float,3>> c(4,4);
+    for( int i = 0; i < 4; i++ )
+      for( int j = 0; j < 4; j++ )
+        c[i][j] = Vector<float,3>( i, j, float((i*j) % 3) - 1.0 );
+    return c;
+  }
+
+
+
+  // Resampling in parallel must give exactly the same samples as the serial resampling,
+  // including the right-evaluated last row and column.
+  template <typename Surf>
+  ::testing::AssertionResult parallelTest( Resampler<Surf>& surf, int d1, int d2 ) {
+
+    const int m1 = 23;
+    const int m2 = 17;
+
+    DSampleGrid<Vector<float,3>> gold;
+    surf.setResampleThreads(1);
+    surf.getSamples( gold, m1, m2, d1, d2 );
+
+    for( int nt : { 2, 3, 4, 0 } ) {
+
+      DSampleGrid<Vector<float,3>> p;
+      surf.setResampleThreads(nt);
+      surf.getSamples( p, m1, m2, d1, d2 );
+
+      if( p.getDim1() != m1 || p.getDim2() != m2 )
+        return ::testing::AssertionFailure() << "dim mismatch using " << nt << " threads";
+
+      for( int i = 0; i < m1; i++ )
+        for( int j = 0; j < m2; j++ )
+          for( int k = 0; k <= d1; k++ )
+            for( int l = 0; l <= d2; l++ )
+              if( p(i,j,k,l) != gold(i,j,k,l) )
+                return ::testing::AssertionFailure()
+                    << "sample (" << i << "," << j << ") der (" << k << "," << l << ") differs using " << nt << " threads";
+    }
+
+    surf.setResampleThreads(1);
+    return ::testing::AssertionSuccess();
+  }
+
+
+
+  TEST(Parametrics_PSurf_Resample, PTorus) {
+
+    Resampler<PTorus<float>> surf( 3.0f, 1.0f, 1.5f );
+    EXPECT_TRUE( parallelTest( surf, 1, 1 ) );
+    EXPECT_TRUE( parallelTest( surf, 2, 2 ) );
+  }
+
+  TEST(Parametrics_PSurf_Resample, PTorus_DD) {
+
+    Resampler<PTorus<float>> surf( 3.0f, 1.0f, 1.5f );
+    surf.setDerivationMethod( GM_DERIVATION_DD );
+    EXPECT_TRUE( parallelTest( surf, 1, 1 ) );
+  }
+
+  TEST(Parametrics_PSurf_Resample, PSphere) {
+
+    Resampler<PSphere<float>> surf( 2.0f );
+    EXPECT_TRUE( parallelTest( surf, 1, 1 ) );
+  }
+
+  TEST(Parametrics_PSurf_Resample, PBezierSurf) {
+
+    Resampler<PBezierSurf<float>> surf( controlNet() );
+    EXPECT_TRUE( parallelTest( surf, 1, 1 ) );
+  }
+
+  TEST(Parametrics_PSurf_Resample, PERBSSurf) {
+
+    PTorus<float> torus( 3.0f, 1.0f, 1.5f );
+    Resampler<PERBSSurf<float>> surf( &torus, 4, 5, 1, 1 );
+    EXPECT_TRUE( parallelTest( surf, 1, 1 ) );
+  }
+
+
+
+  // The fixed sampling grid must give exactly the same samples as the normal
+  // resampling, also after moving and editing a local patch.
+  ::testing::AssertionResult fixedGridTest( Resampler<PERBSSurf<float>>& surf, int d1, int d2 ) {
+
+    const int m1 = 23;
+    const int m2 = 17;
+
+    DSampleGrid<Vector<float,3>> gold, p;
+    surf.setResampleMode( GM_RESAMPLE_PREEVAL );
+    surf.getSamples( gold, m1, m2, d1, d2 );
+    surf.setResampleMode( GM_RESAMPLE_FIXED_GRID );
+    surf.getSamples( p, m1, m2, d1, d2 );
+
+    for( int i = 0; i < m1; i++ )
+      for( int j = 0; j < m2; j++ )
+        for( int k = 0; k <= d1; k++ )
+          for( int l = 0; l <= d2; l++ )
+            if( p(i,j,k,l) != gold(i,j,k,l) )
+              return ::testing::AssertionFailure()
+                  << "sample (" << i << "," << j << ") der (" << k << "," << l << ") differs";
+
+    return ::testing::AssertionSuccess();
+  }
+
+  TEST(Parametrics_PSurf_Resample, PERBSSurf_FixedGrid) {
+
+    PTorus<float> torus( 3.0f, 1.0f, 1.5f );
+    Resampler<PERBSSurf<float>> surf( &torus, 4, 5, 1, 1 );
+    EXPECT_TRUE( fixedGridTest( surf, 1, 1 ) );
+    EXPECT_TRUE( fixedGridTest( surf, 2, 2 ) );
+    EXPECT_TRUE( fixedGridTest( surf, 1, 1 ) );
+
+    // Moving a local patch only changes its matrix
+    PSurf<float,3>* patch = surf.getLocalPatches()[1][2];
+    patch->translateParent( Vector<float,3>( 0.3f, -0.2f, 0.5f ) );
+    EXPECT_TRUE( fixedGridTest( surf, 1, 1 ) );
+
+    // Editing a local patch changes its shape
+    PBezierSurf<float>* bezier = dynamic_cast<PBezierSurf<float>*>( patch );
+    ASSERT_TRUE( bezier );
+    DMatrix<Vector<float,3>> c = bezier->getControlPoints();
+    c[1][1] += Vector<float,3>( 0.2f, 0.1f, -0.3f );
+    bezier->setControlPoints( c );
+    surf.edit( patch );
+    EXPECT_TRUE( fixedGridTest( surf, 1, 1 ) );
+
+    // Changing a local patch without edit() is followed by replot()
+    c[0][1] += Vector<float,3>( 0.1f, -0.2f, 0.1f );
+    bezier->setControlPoints( c );
+    surf.replot();
+    EXPECT_TRUE( fixedGridTest( surf, 1, 1 ) );
+
+    // ... or requires invalidation
+    c[1][0] += Vector<float,3>( -0.1f, 0.3f, 0.2f );
+    bezier->setControlPoints( c );
+    surf.invalidateLocalSamples();
+    EXPECT_TRUE( fixedGridTest( surf, 1, 1 ) );
+  }
+
+}
@@ -0,0 +1,111 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <trianglesystem/gmtrianglesystem.h>
+using namespace GMlib;
+
+
+
+namespace {
+
+
+
+  // Gives the tests the protected find() of the triangle system
+  class TSFinder : public TriangleSystem<float> {
+  public:
+    explicit TSFinder( TriangleFacets<float>& ts ) { set( ts ); }
+
+    TSVertex<float>*  vertex( const Point<float,3>& p ) const { return find( p ); }
+    TSEdge<float>*    edge( const Point<float,3>& p1, const Point<float,3>& p2 ) { return find( p1, p2 ); }
+  };
+
+
+  // m x m points, each one jittered in [shift, shift+0.2] of its grid cell (in x and y)
+  ArrayLX<TSVertex<float>> gridVertices( int m, float shift, unsigned int seed ) {
+
+    ArrayLX<TSVertex<float>> v;
+    for( int i = 0; i < m; i++ )
+      for( int j = 0; j < m; j++ ) {
+        seed = seed * 1103515245u + 12345u;  const float x = (i + shift + 0.2f * (seed >> 8) / float(1 << 24)) / m;
+        seed = seed * 1103515245u + 12345u;  const float y = (j + shift + 0.2f * (seed >> 8) / float(1 << 24)) / m;
+        v += TSVertex<float>( x, y, x * y );
+      }
+    return v;
+  }
+
+
+
+  TEST(TriangleSystem_TriangleFacets, InsertVertex) {
+
+    ArrayLX<TSVertex<float>> v;
+    v += TSVertex<float>( 0.0f, 0.0f );
+    v += TSVertex<float>( 1.0f, 0.0f );
+    v += TSVertex<float>( 1.0f, 1.0f );
+    v += TSVertex<float>( 0.0f, 1.0f );
+    v.insertAlways( gridVertices( 20, 0.1f, 3u ) );
+
+    TriangleFacets<float> facets( v );
+    facets.triangulateDelaunay();
+
+    // New vertices are inserted, vertices equal to one already there are not
+    const ArrayLX<TSVertex<float>> w = gridVertices( 18, 0.6f, 5u );
+    for( int i = 0; i < w.getSize(); i++ )
+      EXPECT_TRUE( facets.insertVertex( w(i) ) );
+    EXPECT_EQ( 728, facets.getNoVertices() );
+    EXPECT_EQ( facets.getNoVertices() + facets.getNoTriangles() - 1, facets.getNoEdges() );
+
+    for( int i = 0; i < w.getSize(); i += 10 ) {
+      const Point<float,3> p = w(i).getPosition();
+      EXPECT_FALSE( facets.insertVertex( TSVertex<float>( p[0] + 1e-4f, p[1], 2.0f ) ) );
+    }
+    EXPECT_EQ( 728, facets.getNoVertices() );
+
+    // The moved vertex is found at its new position
+    const Point<float,3> p = w(0).getPosition();
+    TSVertex<float>* f = TSFinder( facets ).vertex( Point<float,3>( p[0] + 1e-4f, p[1], 2.0f ) );
+    ASSERT_TRUE( f != NULL );
+    EXPECT_FLOAT_EQ( 2.0f, f->getPosition()[2] );
+  }
+
+
+
+  TEST(TriangleSystem_TriangleFacets, Find) {
+
+    TriangleFacets<float> facets( gridVertices( 32, 0.4f, 7u ) );
+    facets.triangulateDelaunay();
+
+    TSFinder find( facets );
+    for( int i = 0; i < facets.getNoVertices(); i++ )
+      EXPECT_EQ( facets.getVertex( i ), find.vertex( facets.getVertex( i )->getPosition() ) );
+    EXPECT_TRUE( find.vertex( Point<float,3>( 2.0f, 2.0f, 0.0f ) ) == NULL );
+
+    for( int i = 0; i < facets.getNoEdges(); i += 7 ) {
+      TSEdge<float>* e = facets.getEdge( i );
+      EXPECT_EQ( e, find.edge( e->getFirstVertex()->getPosition(), e->getLastVertex()->getPosition() ) );
+      EXPECT_EQ( e, find.edge( e->getLastVertex()->getPosition(), e->getFirstVertex()->getPosition() ) );
+    }
+
+    // Removing a vertex moves the last vertex to its index
+    TriangleFacets<float> points( gridVertices( 10, 0.4f, 9u ) );
+    const Point<float,3> removed = points.getVertex( 10 )->getPosition();
+    const Point<float,3> last    = points.getVertex( 99 )->getPosition();
+    EXPECT_TRUE( points.removeVertex( *points.getVertex( 10 ) ) );
+    EXPECT_EQ( 99, points.getNoVertices() );
+
+    TSFinder find_points( points );
+    EXPECT_TRUE( find_points.vertex( removed ) == NULL );
+    EXPECT_EQ( points.getVertex( 10 ), find_points.vertex( last ) );
+    for( int i = 0; i < points.getNoVertices(); i++ )
+      EXPECT_EQ( points.getVertex( i ), find_points.vertex( points.getVertex( i )->getPosition() ) );
+
+    // A vertex moved in (x,y) is found at its new position after replot()
+    TSVertex<float>* v = points.getVertex( 20 );
+    const Point<float,3> old = v->getPosition();
+    v->setPos( Point<float,3>( old[0] + 0.05f, old[1] - 0.03f, old[2] ) );
+    points.replot();
+    EXPECT_EQ( v, find_points.vertex( v->getPosition() ) );
+    EXPECT_TRUE( find_points.vertex( old ) == NULL );
+  }
+
+}
@@ -0,0 +1,565 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <trianglesystem/gmtrianglemesh.h>
+#include <trianglesystem/gmtrianglesystem.h>
+using namespace GMlib;
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  std::vector<Point<double,3>> randomPoints( int n, unsigned int seed ) {
+
+    std::vector<Point<double,3>> p;
+    for( int i = 0; i < n; i++ ) {
+      seed = seed * 1103515245u + 12345u;  const double x = (seed >> 8) / double(1 << 24);
+      seed = seed * 1103515245u + 12345u;  const double y = (seed >> 8) / double(1 << 24);
+      p.push_back( Point<double,3>( x, y, std::sin( 3*x ) * y ) );
+    }
+    return p;
+  }
+
+
+  // The triangles of a TriangleFacets as sorted vertex indices
+  std::set<std::vector<int>> triangles( const TriangleFacets<float>& facets ) {
+
+    std::map<const TSVertex<float>*, int> index;
+    for( int i = 0; i < facets.getNoVertices(); i++ )
+      index[facets.getVertex( i )] = i;
+
+    std::set<std::vector<int>> tri;
+    for( int i = 0; i < facets.getNoTriangles(); i++ ) {
+      const Array<TSVertex<float>*> v = facets.getTriangle( i )->getVertices();
+      std::vector<int> t;
+      for( int k = 0; k < v.getSize(); k++ ) t.push_back( index[v(k)] );
+      std::sort( t.begin(), t.end() );
+      tri.insert( t );
+    }
+    return tri;
+  }
+
+
+  // The triangles of a TriangleMesh as sorted vertex indices
+  std::set<std::vector<int>> triangles( const TriangleMesh<double>& mesh ) {
+
+    std::set<std::vector<int>> tri;
+    for( int t = 0; t < mesh.getNoTriangles(); t++ ) {
+      const Vector<int,3> k = mesh.getTriangle( t );
+      std::vector<int> s( k.getPtr(), k.getPtr() + 3 );
+      std::sort( s.begin(), s.end() );
+      tri.insert( s );
+    }
+    return tri;
+  }
+
+
+  // The twins, the vertex half-edges and the orientation of the triangles
+  void checkTopology( const TriangleMesh<double>& mesh ) {
+
+    for( int h = 0; h < 3*mesh.getNoTriangles(); h++ ) {
+      const int g = mesh.getTwin( h );
+      if( g < 0 ) continue;
+      ASSERT_EQ( h, mesh.getTwin( g ) );
+      ASSERT_EQ( mesh.getOrigin( h ), mesh.getTarget( g ) );
+      ASSERT_EQ( mesh.getTarget( h ), mesh.getOrigin( g ) );
+    }
+
+    for( int t = 0; t < mesh.getNoTriangles(); t++ ) {
+      const Vector<double,3> n = mesh.getNormalTriangle( t );
+      ASSERT_GT( n[2], 0.0 );
+    }
+
+    for( int v = 0; v < mesh.getNoVertices(); v++ ) {
+      const int h = mesh.getVertexHalfEdge( v );
+      if( h >= 0 ) {
+        ASSERT_EQ( v, mesh.getOrigin( h ) );
+      }
+    }
+  }
+
+
+
+  TEST(TriangleSystem_TriangleMesh, TriangulateDelaunay) {
+
+    const std::vector<Point<double,3>> p = randomPoints( 2000, 7u );
+    TriangleMesh<double> mesh( p );
+    mesh.triangulateDelaunay();
+    checkTopology( mesh );
+
+    // One boundary loop around the convex hull, and Euler's formula
+    std::vector<int> bnd;
+    mesh.getBoundary( bnd );
+    for( unsigned int i = 0; i < bnd.size(); i++ ) {
+      const Point<double,3>& a = mesh.getPosition( mesh.getOrigin( bnd[i] ) );
+      const Point<double,3>& b = mesh.getPosition( mesh.getTarget( bnd[i] ) );
+      const Point<double,3>& c = mesh.getPosition( mesh.getTarget( bnd[(i+1) % bnd.size()] ) );
+      EXPECT_EQ( mesh.getOrigin( bnd[(i+1) % bnd.size()] ), mesh.getTarget( bnd[i] ) );
+      EXPECT_GE( (b[0]-a[0])*(c[1]-a[1]) - (b[1]-a[1])*(c[0]-a[0]), -1e-12 );
+    }
+    EXPECT_EQ( 2*mesh.getNoVertices() - int(bnd.size()) - 2, mesh.getNoTriangles() );
+    EXPECT_EQ( mesh.getNoVertices() + mesh.getNoTriangles() - 1, mesh.getNoEdges() );
+
+    // No vertex is inside the circumcircle of a triangle (tested over each edge)
+    for( int h = 0; h < 3*mesh.getNoTriangles(); h++ ) {
+      const int g = mesh.getTwin( h );
+      if( g < 0 ) continue;
+
+      const Point<double,3>& a = mesh.getPosition( mesh.getOrigin( h ) );
+      const Point<double,3>& b = mesh.getPosition( mesh.getTarget( h ) );
+      const Point<double,3>& c = mesh.getPosition( mesh.getOrigin( mesh.getPrev( h ) ) );
+      const Point<double,3>& d = mesh.getPosition( mesh.getOrigin( mesh.getPrev( g ) ) );
+      const double adx = a[0]-d[0], ady = a[1]-d[1], bdx = b[0]-d[0], bdy = b[1]-d[1], cdx = c[0]-d[0], cdy = c[1]-d[1];
+      const double det = (adx*adx + ady*ady) * (bdx*cdy - cdx*bdy)
+                       + (bdx*bdx + bdy*bdy) * (cdx*ady - adx*cdy)
+                       + (cdx*cdx + cdy*cdy) * (adx*bdy - bdx*ady);
+      EXPECT_LE( det, 1e-12 );
+    }
+
+    // A new triangulation of the same vertices gives the same triangles
+    std::vector<Vector<int,3>> tri;
+    for( int t = 0; t < mesh.getNoTriangles(); t++ ) tri.push_back( mesh.getTriangle( t ) );
+    mesh.triangulateDelaunay();
+    ASSERT_EQ( int(tri.size()), mesh.getNoTriangles() );
+    for( int t = 0; t < mesh.getNoTriangles(); t++ )
+      EXPECT_EQ( tri[t], mesh.getTriangle( t ) );
+  }
+
+
+
+  // Points on a grid, with many points on edges and on the circles of other points
+  TEST(TriangleSystem_TriangleMesh, TriangulateDelaunay__Grid) {
+
+    TriangleMesh<double> mesh;
+    for( int i = 0; i < 30; i++ )
+      for( int j = 0; j < 20; j++ )
+        mesh.insertVertex( Point<double,3>( i * 0.1, j * 0.1, 0.0 ) );
+
+    // One of two equal vertices is left out
+    mesh.insertVertex( Point<double,3>( 1.0, 1.0, 1.0 ) );
+    mesh.triangulateDelaunay();
+    checkTopology( mesh );
+
+    EXPECT_EQ( 2*29*19, mesh.getNoTriangles() );
+    EXPECT_NE( mesh.getVertexHalfEdge( 210 ) < 0, mesh.getVertexHalfEdge( 600 ) < 0 );
+
+    std::vector<int> bnd;
+    mesh.getBoundary( bnd );
+    EXPECT_EQ( 2*(29+19), int(bnd.size()) );
+  }
+
+
+
+  // Vertices on a line on the boundary are all in the triangulation, also the one at the end:
+  // a skew line, and a column of equal x with the last vertex on either side of it
+  TEST(TriangleSystem_TriangleMesh, TriangulateDelaunay__Line) {
+
+    for( int c = 0; c < 3; c++ )
+      for( int n = 3; n <= 50; n++ ) {
+        TriangleMesh<double> mesh;
+        for( int i = 0; i < n; i++ )
+          mesh.insertVertex( c == 0 ? Point<double,3>( i, 2.0 * i, 0.0 ) : Point<double,3>( 0.0, i, 0.0 ) );
+        if( c == 0 ) mesh.insertVertex( Point<double,3>( 0.3 * n, 0.0, 0.0 ) );
+        else         mesh.insertVertex( Point<double,3>( c == 1 ? 1.0 : -1.0, 0.3 * n, 0.0 ) );
+        mesh.triangulateDelaunay();
+        checkTopology( mesh );
+
+        EXPECT_EQ( n-1, mesh.getNoTriangles() );
+        for( int v = 0; v <= n; v++ )
+          EXPECT_GE( mesh.getVertexHalfEdge( v ), 0 );
+      }
+  }
+
+
+
+  // The strips triangulated on several threads give the same triangulation
+  TEST(TriangleSystem_TriangleMesh, TriangulateDelaunay__Threads) {
+
+    TriangleMesh<double> serial( randomPoints( 20000, 11u ) );
+    serial.triangulateDelaunay();
+
+    for( int no_threads = 2; no_threads <= 5; no_threads += 3 ) {
+      TriangleMesh<double> mesh( randomPoints( 20000, 11u ) );
+      mesh.triangulateDelaunay( no_threads );
+      checkTopology( mesh );
+      EXPECT_EQ( triangles( serial ), triangles( mesh ) );
+    }
+
+    // A grid, where the triangulation is not unique
+    TriangleMesh<double> grid;
+    for( int i = 0; i < 100; i++ )
+      for( int j = 0; j < 50; j++ )
+        grid.insertVertex( Point<double,3>( i * 0.1, j * 0.1, 0.0 ) );
+    EXPECT_TRUE( grid.triangulateDelaunay( 4 ) );
+    checkTopology( grid );
+    EXPECT_EQ( 4, grid.getNoStrips() );
+    EXPECT_EQ( 2*99*49, grid.getNoTriangles() );
+  }
+
+
+
+  // A gridded terrain, the four vertices of each grid cell on one circle, split in strips between
+  // columns for any number of threads: the strips fit together and no seam edge is dropped
+  TEST(TriangleSystem_TriangleMesh, TriangulateDelaunay__Terrain) {
+
+    const int nx = 240, ny = 160;
+    for( int no_threads = 2; no_threads <= 7; no_threads++ ) {
+
+      TriangleMesh<double> mesh;
+      for( int i = 0; i < nx; i++ )
+        for( int j = 0; j < ny; j++ )
+          mesh.insertVertex( Point<double,3>( i * 0.5, j * 0.5, std::sin( 0.1*i ) * std::cos( 0.07*j ) ) );
+      EXPECT_TRUE( mesh.triangulateDelaunay( no_threads ) );
+      checkTopology( mesh );
+
+      EXPECT_EQ( no_threads, mesh.getNoStrips() );
+      EXPECT_EQ( 2*(nx-1)*(ny-1), mesh.getNoTriangles() );
+      for( int v = 0; v < nx*ny; v++ )
+        EXPECT_GE( mesh.getVertexHalfEdge( v ), 0 );
+
+      // Each triangle is half a grid cell
+      for( int t = 0; t < mesh.getNoTriangles(); t++ ) {
+        const Vector<int,3>    k = mesh.getTriangle( t );
+        const Point<double,3>& a = mesh.getPosition( k[0] );
+        const Point<double,3>& b = mesh.getPosition( k[1] );
+        const Point<double,3>& c = mesh.getPosition( k[2] );
+        ASSERT_NEAR( 0.125, 0.5 * ( (b[0]-a[0])*(c[1]-a[1]) - (c[0]-a[0])*(b[1]-a[1]) ), 1e-12 );
+      }
+    }
+  }
+
+
+
+  TEST(TriangleSystem_TriangleMesh, ConstEdges) {
+
+    const std::vector<Point<double,3>> p = randomPoints( 5000, 5u );
+
+    // The vertex closest to (x,y)
+    auto closest = [&p]( double x, double y ) {
+      int k = 0;
+      for( unsigned int i = 1; i < p.size(); i++ )
+        if( std::hypot( p[i][0]-x, p[i][1]-y ) < std::hypot( p[k][0]-x, p[k][1]-y ) ) k = int(i);
+      return k;
+    };
+    const int a = closest( 0.1, 0.1 ), b = closest( 0.9, 0.8 );
+    const int c = closest( 0.2, 0.9 ), d = closest( 0.8, 0.2 );
+    const int e = closest( 0.1, 0.5 ), f = closest( 0.3, 0.5 );
+
+    TriangleMesh<double> serial( p ), mesh( p );
+    for( TriangleMesh<double>* m : { &serial, &mesh } ) {
+      m->setConstEdge( a, b );
+      m->setConstEdge( c, d );      // Crosses a-b, inserted after it
+      m->setConstEdge( f, e );
+    }
+    EXPECT_FALSE( serial.triangulateDelaunay() );     // c-d is dropped
+    EXPECT_FALSE( mesh.triangulateDelaunay( 3 ) );
+    checkTopology( mesh );
+    EXPECT_EQ( 3, mesh.getNoStrips() );
+    EXPECT_EQ( triangles( serial ), triangles( mesh ) );
+
+    // The constant edges are edges, all the others are Delaunay
+    int no_const = 0;
+    std::set<std::pair<int,int>> edges;
+    for( int h = 0; h < 3*mesh.getNoTriangles(); h++ ) {
+      const int v0 = mesh.getOrigin( h ), v1 = mesh.getTarget( h );
+      edges.insert( std::make_pair( std::min( v0, v1 ), std::max( v0, v1 ) ) );
+      if( mesh.isConstEdge( h ) ) { no_const++; continue; }
+
+      const int g = mesh.getTwin( h );
+      if( g < 0 ) continue;
+      const Point<double,3>& pa = mesh.getPosition( v0 );
+      const Point<double,3>& pb = mesh.getPosition( v1 );
+      const Point<double,3>& pc = mesh.getPosition( mesh.getOrigin( mesh.getPrev( h ) ) );
+      const Point<double,3>& pd = mesh.getPosition( mesh.getOrigin( mesh.getPrev( g ) ) );
+      const double adx = pa[0]-pd[0], ady = pa[1]-pd[1], bdx = pb[0]-pd[0], bdy = pb[1]-pd[1], cdx = pc[0]-pd[0], cdy = pc[1]-pd[1];
+      const double det = (adx*adx + ady*ady) * (bdx*cdy - cdx*bdy)
+                       + (bdx*bdx + bdy*bdy) * (cdx*ady - adx*cdy)
+                       + (cdx*cdx + cdy*cdy) * (adx*bdy - bdx*ady);
+      EXPECT_LE( det, 1e-12 );
+    }
+    EXPECT_EQ( 2*2, no_const );
+    EXPECT_EQ( 1u, edges.count( std::make_pair( std::min( a, b ), std::max( a, b ) ) ) );
+    EXPECT_EQ( 1u, edges.count( std::make_pair( std::min( e, f ), std::max( e, f ) ) ) );
+    EXPECT_EQ( 0u, edges.count( std::make_pair( std::min( c, d ), std::max( c, d ) ) ) );
+    EXPECT_EQ( mesh.getNoVertices() + mesh.getNoTriangles() - 1, mesh.getNoEdges() );
+
+    // A constant edge over other vertices is split at them
+    TriangleMesh<double> grid;
+    for( int i = 0; i < 10; i++ )
+      for( int j = 0; j < 10; j++ )
+        grid.insertVertex( Point<double,3>( i, j, 0.0 ) );
+    grid.setConstEdge( 0, 99 );
+    EXPECT_TRUE( grid.triangulateDelaunay() );
+    checkTopology( grid );
+
+    no_const = 0;
+    for( int h = 0; h < 3*grid.getNoTriangles(); h++ )
+      if( grid.isConstEdge( h ) ) {
+        EXPECT_EQ( 11, std::abs( grid.getTarget( h ) - grid.getOrigin( h ) ) );
+        no_const++;
+      }
+    EXPECT_EQ( 2*9, no_const );
+  }
+
+
+
+  // The triangles on the left of a border edge, and those connected to them, are covered
+  TEST(TriangleSystem_TriangleMesh, TriangulateDelaunay__Border) {
+
+    TriangleMesh<double> mesh;
+    mesh.insertVertex( Point<double,3>( 0.0, 0.0, 0.0 ) );
+    mesh.insertVertex( Point<double,3>( 1.0, 0.0, 0.0 ) );
+    mesh.insertVertex( Point<double,3>( 1.0, 1.0, 0.0 ) );
+    mesh.insertVertex( Point<double,3>( 0.0, 1.0, 0.0 ) );
+    mesh.insertVertex( Point<double,3>( 2.0, 0.5, 0.0 ) );
+
+    std::vector<char> covered;
+    EXPECT_TRUE( mesh.triangulateDelaunay( std::vector<std::pair<int,int>>( 1, std::make_pair( 1, 2 ) ), covered ) );
+    checkTopology( mesh );
+    EXPECT_EQ( 1, mesh.getNoStrips() );
+    ASSERT_EQ( 3, mesh.getNoTriangles() );
+    ASSERT_EQ( 3u, covered.size() );
+
+    for( int t = 0; t < 3; t++ ) {
+      const Vector<int,3> v = mesh.getTriangle( t );
+      EXPECT_EQ( v[0] != 4 && v[1] != 4 && v[2] != 4, bool( covered[t] ) );
+    }
+  }
+
+
+
+  // The same triangulation as TriangleFacets (which is only made for float)
+  TEST(TriangleSystem_TriangleMesh, TriangleFacets) {
+
+    // The points are inside a square, TriangleFacets leaves out thin triangles where the boundary is nearly straight
+    const std::vector<Point<double,3>> p = randomPoints( 500, 3u );
+    ArrayLX<TSVertex<float>> v;
+    v += TSVertex<float>( -0.1f, -0.1f, 0.0f );
+    v += TSVertex<float>(  1.1f, -0.1f, 0.0f );
+    v += TSVertex<float>(  1.1f,  1.1f, 0.0f );
+    v += TSVertex<float>( -0.1f,  1.1f, 0.0f );
+    for( unsigned int i = 0; i < p.size(); i++ )
+      v += TSVertex<float>( float(p[i][0]), float(p[i][1]), float(p[i][2]) );
+
+    TriangleFacets<float> facets( v );
+    facets.triangulateDelaunay();
+    TriangleMesh<float> mesh( v );
+    mesh.triangulateDelaunay();
+
+    EXPECT_EQ( facets.getNoTriangles(), mesh.getNoTriangles() );
+    EXPECT_EQ( facets.getNoEdges(), mesh.getNoEdges() );
+
+    // The ordered triangulation of TriangleFacets has the triangles of the mesh
+    // (TriangleFacets swaps edges with a tolerance, so a few of its own triangles may differ)
+    TriangleFacets<float> ordered( v );
+    ordered.triangulateDelaunay( true );
+    EXPECT_EQ( facets.getNoEdges(), ordered.getNoEdges() );
+
+    std::set<std::vector<int>> tri;
+    for( int t = 0; t < mesh.getNoTriangles(); t++ ) {
+      const Vector<int,3> k = mesh.getTriangle( t );
+      std::vector<int> s( k.getPtr(), k.getPtr() + 3 );
+      std::sort( s.begin(), s.end() );
+      tri.insert( s );
+    }
+    EXPECT_EQ( tri, triangles( ordered ) );
+
+    // and new vertices can be inserted
+    for( int i = 0; i < 20; i++ )
+      ordered.insertVertex( TSVertex<float>( 0.05f + 0.045f * i, 0.5f + 0.3f * std::sin( float(i) ), 0.0f ) );
+    EXPECT_EQ( mesh.getNoTriangles() + 2*20, ordered.getNoTriangles() );
+    EXPECT_EQ( mesh.getNoEdges() + 3*20, ordered.getNoEdges() );
+  }
+
+
+
+  // A new ordered triangulation keeps the constant edges
+  TEST(TriangleSystem_TriangleMesh, TriangleFacets__ConstEdges) {
+
+    const std::vector<Point<double,3>> p = randomPoints( 3000, 9u );
+    TriangleFacets<float> facets;
+    for( unsigned int i = 0; i < p.size(); i++ )
+      facets += TSVertex<float>( float(p[i][0]), float(p[i][1]), float(p[i][2]) );
+    facets.triangulateDelaunay( true, 2 );
+
+    // True if there is an edge between v0 and v1
+    auto hasEdge = [&facets]( const TSVertex<float>* v0, const TSVertex<float>* v1 ) {
+      for( int i = 0; i < facets.getNoEdges(); i++ ) {
+        const TSEdge<float>* e = facets.getEdge( i );
+        if( ( e->getFirstVertex() == v0 && e->getLastVertex() == v1 ) ||
+            ( e->getFirstVertex() == v1 && e->getLastVertex() == v0 ) )
+          return true;
+      }
+      return false;
+    };
+
+    // An inner edge, and a new vertex next to its midpoint
+    TSEdge<float>* e = NULL;
+    for( int i = 0; i < facets.getNoEdges() && !e; i++ )
+      if( !facets.getEdge( i )->boundary() ) e = facets.getEdge( i );
+    ASSERT_TRUE( e != NULL );
+    TSVertex<float>* v0 = e->getFirstVertex();
+    TSVertex<float>* v1 = e->getLastVertex();
+    const Point<float,2> m = e->getCenterPos2D();
+    const Vector<float,2> d = e->getVector2D();
+    EXPECT_TRUE( facets.setConstEdge( *v0, *v1 ) );
+
+    facets += TSVertex<float>( m[0] - 0.01f * d[1], m[1] + 0.01f * d[0], 0.0f );
+    facets.triangulateDelaunay( true, 2 );
+    EXPECT_TRUE( hasEdge( v0, v1 ) );
+    EXPECT_EQ( facets.getNoVertices() + facets.getNoTriangles() - 1, facets.getNoEdges() );
+
+    // but not without
+    int i0 = -1, i1 = -1;
+    TriangleFacets<float> free_facets;
+    for( int i = 0; i < facets.getNoVertices(); i++ ) {
+      free_facets += TSVertex<float>( facets.getVertex( i )->getPosition() );
+      if( facets.getVertex( i ) == v0 ) i0 = i;
+      if( facets.getVertex( i ) == v1 ) i1 = i;
+    }
+    free_facets.triangulateDelaunay( true, 2 );
+    EXPECT_EQ( facets.getNoTriangles(), free_facets.getNoTriangles() );
+
+    for( int i = 0; i < free_facets.getNoEdges(); i++ ) {
+      const TSEdge<float>* f = free_facets.getEdge( i );
+      EXPECT_FALSE( ( f->getFirstVertex() == free_facets.getVertex( i0 ) && f->getLastVertex() == free_facets.getVertex( i1 ) ) ||
+                    ( f->getFirstVertex() == free_facets.getVertex( i1 ) && f->getLastVertex() == free_facets.getVertex( i0 ) ) );
+    }
+  }
+
+
+
+  // Triangulating the same facets again, with more vertices over a larger box
+  TEST(TriangleSystem_TriangleMesh, TriangleFacets__Retriangulate) {
+
+    const std::vector<Point<double,3>> p = randomPoints( 400, 11u );
+    TriangleFacets<float> facets;
+    for( int i = 0; i < 150; i++ )
+      facets += TSVertex<float>( 0.5f * float(p[i][0]), 0.5f * float(p[i][1]), 0.0f );
+    facets.triangulateDelaunay( true );
+
+    auto hasEdge = [&facets]( int i0, int i1 ) {
+      for( int i = 0; i < facets.getNoEdges(); i++ ) {
+        const TSEdge<float>* e = facets.getEdge( i );
+        if( ( e->getFirstVertex() == facets.getVertex( i0 ) && e->getLastVertex() == facets.getVertex( i1 ) ) ||
+            ( e->getFirstVertex() == facets.getVertex( i1 ) && e->getLastVertex() == facets.getVertex( i0 ) ) )
+          return true;
+      }
+      return false;
+    };
+
+    int i0 = -1, i1 = -1;
+    for( int i = 0; i < facets.getNoEdges() && i0 < 0; i++ ) {
+      TSEdge<float>* e = facets.getEdge( i );
+      if( e->boundary() ) continue;
+      for( int k = 0; k < facets.getNoVertices(); k++ ) {
+        if( facets.getVertex( k ) == e->getFirstVertex() ) i0 = k;
+        if( facets.getVertex( k ) == e->getLastVertex() )  i1 = k;
+      }
+      EXPECT_TRUE( facets.setConstEdge( *e->getFirstVertex(), *e->getLastVertex() ) );
+    }
+    ASSERT_GE( i0, 0 );
+
+    // The grid is made again, for the new box and with more cells
+    for( int i = 150; i < 400; i++ )
+      facets += TSVertex<float>( float(p[i][0]), float(p[i][1]), 0.0f );
+    facets.triangulateDelaunay( true );
+    EXPECT_EQ( 400, facets.getNoVertices() );
+    EXPECT_TRUE( hasEdge( i0, i1 ) );
+    EXPECT_EQ( facets.getNoVertices() + facets.getNoTriangles() - 1, facets.getNoEdges() );
+
+    const std::set<std::vector<int>> tri = triangles( facets );
+    facets.triangulateDelaunay( true );
+    EXPECT_EQ( tri, triangles( facets ) );
+    EXPECT_TRUE( hasEdge( i0, i1 ) );
+
+    // New vertices are found in the grid
+    for( int i = 0; i < 40; i++ )
+      EXPECT_TRUE( facets.insertVertex( TSVertex<float>( 0.2f + 0.015f * i, 0.5f + 0.25f * std::sin( float(i) ), 0.0f ) ) );
+    EXPECT_EQ( 440, facets.getNoVertices() );
+    EXPECT_EQ( facets.getNoVertices() + facets.getNoTriangles() - 1, facets.getNoEdges() );
+  }
+
+
+
+  TEST(TriangleSystem_TriangleMesh, Queries) {
+
+    // A 5x5 grid, each square split from the lower left corner
+    std::vector<Point<double,3>> p;
+    std::vector<Vector<int,3>>   tri;
+    for( int j = 0; j < 5; j++ )
+      for( int i = 0; i < 5; i++ )
+        p.push_back( Point<double,3>( i, j, 0.0 ) );
+    for( int j = 0; j < 4; j++ )
+      for( int i = 0; i < 4; i++ ) {
+        const int k = 5*j + i;
+        tri.push_back( Vector<int,3>( k, k+1, k+6 ) );
+        tri.push_back( Vector<int,3>( k, k+6, k+5 ) );
+      }
+
+    TriangleMesh<double> mesh;
+    mesh.set( p, tri );
+    checkTopology( mesh );
+    EXPECT_EQ( 32, mesh.getNoTriangles() );
+    EXPECT_EQ( 56, mesh.getNoEdges() );
+
+    std::vector<int> t, e, nv;
+    mesh.getTriangles( 12, t );
+    mesh.getOuterEdges( 12, e );
+    mesh.getNeighbours( 12, nv );
+    EXPECT_FALSE( mesh.isBoundary( 12 ) );
+    EXPECT_EQ( 6u, t.size() );
+    EXPECT_EQ( 6u, e.size() );
+    EXPECT_EQ( 6u, nv.size() );
+    for( unsigned int i = 0; i < e.size(); i++ ) {
+      EXPECT_EQ( t[i], mesh.getFace( e[i] ) );
+      EXPECT_EQ( nv[i], mesh.getOrigin( e[i] ) );
+    }
+
+    // A corner with two triangles, three neighbours
+    mesh.getTriangles( 0, t );
+    mesh.getNeighbours( 0, nv );
+    EXPECT_TRUE( mesh.isBoundary( 0 ) );
+    EXPECT_EQ( 2u, t.size() );
+    ASSERT_EQ( 3u, nv.size() );
+    EXPECT_EQ( 1, nv[0] );
+    EXPECT_EQ( 6, nv[1] );
+    EXPECT_EQ( 5, nv[2] );
+
+    // The adjacent triangles share the half-edges
+    for( int k = 0; k < 3; k++ ) {
+      const int a = mesh.getAdjacent( 0, k );
+      EXPECT_EQ( a, mesh.isBoundaryEdge( k ) ? -1 : mesh.getFace( mesh.getTwin( k ) ) );
+    }
+
+    mesh.computeNormals();
+    for( int v = 0; v < mesh.getNoVertices(); v++ )
+      EXPECT_NEAR( 1.0, mesh.getNormal( v )[2], 1e-12 );
+
+    // Removing the triangles around vertex 12 makes a hole
+    mesh.getTriangles( 12, t );
+    std::sort( t.begin(), t.end() );
+    for( int i = int(t.size())-1; i >= 0; i-- ) {
+      mesh.removeTriangle( t[i] );
+      checkTopology( mesh );
+    }
+    EXPECT_EQ( 26, mesh.getNoTriangles() );
+    EXPECT_EQ( -1, mesh.getVertexHalfEdge( 12 ) );
+    EXPECT_TRUE( mesh.isBoundary( 13 ) );
+    EXPECT_FALSE( mesh.isBoundary( 8 ) );
+
+    mesh.getBoundary( e );
+    EXPECT_EQ( 16u + 6u, e.size() );
+  }
+
+}
@@ -0,0 +1,198 @@
+// gtest
+#include <gtest/gtest.h>
+
+// gmlib
+#include <trianglesystem/gmtrianglestream.h>
+using namespace GMlib;
+
+// stl
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+
+
+namespace {
+
+
+
+  typedef std::vector<std::pair<double,double> > TriangleKey;
+
+
+
+  // Keeps what it gets, and checks the order of it
+  class Sink : public TriangleStreamSink<double> {
+  public:
+    std::vector<Point<double,3> >   pos;
+    std::vector<char>               final;
+    std::vector<TriangleKey>        tri;
+    int                             no_errors = 0;
+
+    void finalizeVertex( long long v ) override {
+      if( v < 0 || v >= (long long)(pos.size()) || final[v] ) no_errors++;
+      else                                                   final[v] = 1;
+    }
+
+    void triangle( long long v0, long long v1, long long v2 ) override {
+      const long long v[3] = { v0, v1, v2 };
+      TriangleKey key;
+      for( int k = 0; k < 3; k++ ) {
+        if( v[k] < 0 || v[k] >= (long long)(pos.size()) || final[v[k]] ) { no_errors++; return; }
+        key.push_back( std::make_pair( pos[v[k]][0], pos[v[k]][1] ) );
+      }
+      const Point<double,3>& a = pos[v0];
+      const Point<double,3>& b = pos[v1];
+      const Point<double,3>& c = pos[v2];
+      if( (b[0]-a[0])*(c[1]-a[1]) - (b[1]-a[1])*(c[0]-a[0]) <= 0.0 ) no_errors++;
+      std::sort( key.begin(), key.end() );
+      tri.push_back( key );
+    }
+
+    void vertex( long long v, const Point<double,3>& p ) override {
+      if( v != (long long)(pos.size()) || ( !pos.empty() && p[0] < pos.back()[0] ) ) no_errors++;
+      pos.push_back( p );
+      final.push_back( 0 );
+    }
+  };
+
+
+
+  std::vector<Point<double,3> > randomPoints( int n, unsigned int seed ) {
+
+    std::vector<Point<double,3> > p;
+    for( int i = 0; i < n; i++ ) {
+      seed = seed * 1103515245u + 12345u;  const double x = (seed >> 8) / double(1 << 24);
+      seed = seed * 1103515245u + 12345u;  const double y = (seed >> 8) / double(1 << 24);
+      p.push_back( Point<double,3>( x, y, x * y ) );
+    }
+    return p;
+  }
+
+
+
+  // The triangles of the Delaunay triangulation in memory
+  std::vector<TriangleKey> triangles( const std::vector<Point<double,3> >& p ) {
+
+    TriangleMesh<double> mesh( p );
+    mesh.triangulateDelaunay();
+
+    std::vector<TriangleKey> tri;
+    for( int t = 0; t < mesh.getNoTriangles(); t++ ) {
+      TriangleKey key;
+      for( int k = 0; k < 3; k++ ) {
+        const Point<double,3>& q = mesh.getPosition( mesh.getTriangle( t )[k] );
+        key.push_back( std::make_pair( q[0], q[1] ) );
+      }
+      std::sort( key.begin(), key.end() );
+      tri.push_back( key );
+    }
+    std::sort( tri.begin(), tri.end() );
+    return tri;
+  }
+
+
+
+  TEST(TriangleSystem_TriangleStream, Triangulate__Text) {
+
+    const std::vector<Point<double,3> > p = randomPoints( 5000, 3u );
+
+    std::stringstream in;
+    std::ostream& out = in;
+    out.precision( 17 );
+    for( unsigned int i = 0; i < p.size(); i++ )
+      out << p[i][0] << " " << p[i][1] << " " << p[i][2] << "\n";
+
+    // 8 chunks, 20 tiles
+    TriangleStream<double> stream( 250, 700 );
+    Sink sink;
+    EXPECT_TRUE( stream.triangulate( in, sink ) );
+
+    EXPECT_EQ( 0, sink.no_errors );
+    EXPECT_EQ( 5000, stream.getNoVertices() );
+    EXPECT_EQ( (long long)(sink.tri.size()), stream.getNoTriangles() );
+    EXPECT_EQ( 5000, std::count( sink.final.begin(), sink.final.end(), 1 ) );
+    EXPECT_LT( stream.getMaxNoVertices(), 1000 );
+
+    std::sort( sink.tri.begin(), sink.tri.end() );
+    EXPECT_TRUE( sink.tri == triangles( p ) );
+  }
+
+
+
+  TEST(TriangleSystem_TriangleStream, Triangulate__Binary) {
+
+    std::vector<Point<double,3> > p = randomPoints( 20000, 5u );
+
+    // Points equal in (x,y) to one before are not used
+    std::vector<Point<double,3> > q( p );
+    for( int i = 0; i < 1000; i += 7 )
+      q.push_back( Point<double,3>( p[i][0], p[i][1], 1.0 ) );
+
+    std::stringstream in;
+    in.write( reinterpret_cast<const char*>( q.data() ), std::streamsize( q.size() * sizeof(q[0]) ) );
+
+    // 101 chunks, merged in two rounds
+    TriangleStream<double> stream( 1000, 200 );
+    Sink sink;
+    EXPECT_TRUE( stream.triangulate( in, sink, TriangleStream<double>::BINARY ) );
+
+    EXPECT_EQ( 0, sink.no_errors );
+    EXPECT_EQ( 20000, stream.getNoVertices() );
+    EXPECT_EQ( 20000, std::count( sink.final.begin(), sink.final.end(), 1 ) );
+    EXPECT_LT( stream.getMaxNoVertices(), 4000 );
+
+    std::sort( sink.tri.begin(), sink.tri.end() );
+    EXPECT_TRUE( sink.tri == triangles( p ) );
+  }
+
+
+
+  TEST(TriangleSystem_TriangleStream, Triangulate__Degenerate) {
+
+    // No points
+    {
+      std::stringstream in;
+      TriangleStream<double> stream;
+      Sink sink;
+      EXPECT_TRUE( stream.triangulate( in, sink ) );
+      EXPECT_EQ( 0, stream.getNoVertices() );
+      EXPECT_EQ( 0, stream.getNoTriangles() );
+    }
+
+    // Points on a line, the first tiles have no triangles
+    {
+      std::stringstream in;
+      std::ostream& out = in;
+      for( int i = 0; i < 10; i++ )
+        out << i << " " << 2*i << " 0\n";
+      out << "4.5 0 0\n";
+
+      TriangleStream<double> stream( 3, 4 );
+      Sink sink;
+      EXPECT_TRUE( stream.triangulate( in, sink ) );
+      EXPECT_EQ( 0, sink.no_errors );
+      EXPECT_EQ( 11, stream.getNoVertices() );
+      EXPECT_EQ( 9, stream.getNoTriangles() );
+      EXPECT_EQ( 11, std::count( sink.final.begin(), sink.final.end(), 1 ) );
+    }
+
+    // A grid, the tiles end inside columns of equal x
+    {
+      std::stringstream in;
+      std::ostream& out = in;
+      for( int i = 0; i < 30; i++ )
+        for( int j = 0; j < 20; j++ )
+          out << 0.1 * i << " " << 0.1 * j << " 0\n";
+
+      TriangleStream<double> stream( 47, 100 );
+      Sink sink;
+      EXPECT_TRUE( stream.triangulate( in, sink ) );
+      EXPECT_EQ( 0, sink.no_errors );
+      EXPECT_EQ( 600, stream.getNoVertices() );
+      EXPECT_EQ( 2*29*19, stream.getNoTriangles() );
+      EXPECT_EQ( 600, std::count( sink.final.begin(), sink.final.end(), 1 ) );
+    }
+  }
+
+}
@@ -33,7 +33,7 @@ public:
     void            translateControlCurve(int i, Vector<T, 3> direction);
 
 protected:
-    void                eval(T t, int d, bool l) const override;
+    void                eval(DVector<Vector<T,3>>& p, T t, int d, bool l) const override;
     T                   getStartP() const override;
     T                   getEndP()   const override;
 
@@ -103,27 +103,31 @@ inline
 
 
 template <typename T>
-void BlendSplineCurve<T>::eval( T t, int d, bool /*l*/ ) const {
-    this->_p.setDim( d + 1 );
+void BlendSplineCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
+    p.setDim( d + 1 );
 
     if (t > _t[_n]) { // Handling speecial case -if t exceeds the last knot value _t[_n], it blends the last two subcurves using the blending function B(i, t).
         Vector<T, 1> B_t = B(_n, t);
-        DVector<Vector<T, 3>> c0 = _c[_n - 1]->evaluateParent(t, d);
+        DVector<Vector<T, 3>> c0;
+        _c[_n - 1]->evaluateParent(c0, t, d);
 
-        if (std::abs(t - _t[_n]) < 1e-5) { this->_p = c0; return; }
-        DVector<Vector<T, 3>> c1 = _c[0]->evaluateParent(t, d);
+        if (std::abs(t - _t[_n]) < 1e-5) { p = c0; return; }
+        DVector<Vector<T, 3>> c1;
+        _c[0]->evaluateParent(c1, t, d);
 
-        this->_p = c1 + (c0 - c1) * B_t[0];
+        p = c1 + (c0 - c1) * B_t[0];
 
     } else { // Normal case: Finding i and Blending
         int i = findI(t);
         Vector<T, 1> B_t = B(i, t);
-        DVector<Vector<T, 3>> c0 = _c[i - 1]->evaluateParent(t, d);
+        DVector<Vector<T, 3>> c0;
+        _c[i - 1]->evaluateParent(c0, t, d);
 
-        if (std::abs(t - _t[i]) < 1e-5) { this->_p = c0; return; }
-        DVector<Vector<T, 3>> c1 = _c[i]->evaluateParent(t, d);
+        if (std::abs(t - _t[i]) < 1e-5) { p = c0; return; }
+        DVector<Vector<T, 3>> c1;
+        _c[i]->evaluateParent(c1, t, d);
 
-        this->_p = c1 + (c0 - c1) * B_t[0];
+        p = c1 + (c0 - c1) * B_t[0];
     }
 }
 
@@ -30,7 +30,7 @@ public:
 
 protected:
     // Virtual function from PSurf that has to be implemented locally
-    void            eval(T u, T v, int d1 = 1, int d2 = 1, bool lu = true, bool lv = true ) const override;
+    void            eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1 = 1, int d2 = 1, bool lu = true, bool lv = true ) const override;
     T               getStartPU() const override;
     T               getEndPU()   const override;
     T               getStartPV() const override;
@@ -210,8 +210,8 @@ inline
 
 template <typename T>
 inline
-    void MyBlendingSurf<T>::eval(T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/) const {
-    this->_p.setDim( d1 + 1, d2 + 1 );
+    void MyBlendingSurf<T>::eval(DMatrix<Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/) const {
+    p.setDim( d1 + 1, d2 + 1 );
 
     int i_u = findI(u, _u, _n_u);
     int i_v = findI(v, _v, _n_v);
@@ -226,16 +226,16 @@ inline
     right[0] = T(1) - right[1];
 
     DMatrix<DMatrix<Vector<T,3>>> mat(2, 2);
-    mat[1][1] = _c(i_u - 1)(i_v - 1)->evaluateParent(u, v, d1, d2);
-    mat[1][0] = _c(i_u - 1)(i_v)->evaluateParent(u, v, d1, d2);
-    mat[0][1] = _c(i_u)(i_v - 1)->evaluateParent(u, v, d1, d2);
-    mat[0][0] = _c(i_u)(i_v)->evaluateParent(u, v, d1, d2);
+    _c(i_u - 1)(i_v - 1)->evaluateParent(mat[1][1], u, v, d1, d2);
+    _c(i_u - 1)(i_v)->evaluateParent(mat[1][0], u, v, d1, d2);
+    _c(i_u)(i_v - 1)->evaluateParent(mat[0][1], u, v, d1, d2);
+    _c(i_u)(i_v)->evaluateParent(mat[0][0], u, v, d1, d2);
 
     DVector<DMatrix<Vector<T,3>>> vec(2);
     vec[0] = (left[0] * mat[0][0] + left[1] * mat[1][0]) * right[0];
     vec[1] = (left[0] * mat[0][1] + left[1] * mat[1][1]) * right[1];
 
-    this->_p = vec[0] + vec[1];
+    p = vec[0] + vec[1];
 }
 
 template <typename T>
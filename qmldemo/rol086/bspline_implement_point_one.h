@@ -19,7 +19,7 @@ public:
     bool                isClosed() const override;
 
 protected:
-    void                eval(T t, int d, bool l) const override;
+    void                eval(DVector<Vector<T,3>>& p, T t, int d, bool l) const override;
     T                   getStartP() const override;
     T                   getEndP()   const override;
 
@@ -107,8 +107,8 @@ bool BSpline<T>::isClosed() const {
 
 
 template <typename T>
-void BSpline<T>::eval( T t, int d, bool /*l*/ ) const {
-    this->_p.setDim( d + 1 );
+void BSpline<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
+    p.setDim( d + 1 );
 
     // Finds the appropriate knot span i.
     int i = findI(t);
@@ -117,7 +117,7 @@ void BSpline<T>::eval( T t, int d, bool /*l*/ ) const {
     Vector<T,3> b = getB(i, t);
 
     // Computes the weighted sum of control points.
-    this->_p[0] = b[0]*_c[i-2] + b[1]*_c[i-1] + b[2]*_c[i];
+    p[0] = b[0]*_c[i-2] + b[1]*_c[i-1] + b[2]*_c[i];
 }
 
 
@@ -18,7 +18,7 @@ public:
     void                sample(int m, int d = 0) override;
 
 protected:
-    void                eval(T t, int d, bool l) const override;
+    void                eval(DVector<Vector<T,3>>& p, T t, int d, bool l) const override;
     T                   getStartP() const override;
     T                   getEndP()   const override;
 
@@ -68,7 +68,7 @@ LaneRiesenfeldCurve<T>::~LaneRiesenfeldCurve() {}
 
 // Not in use
 template <typename T>
-void LaneRiesenfeldCurve<T>::eval( T t, int d, bool /*l*/ ) const {}
+void LaneRiesenfeldCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {}
 
 
 
@@ -18,7 +18,7 @@ public:
     bool                isClosed() const override;
 
 protected:
-    void                eval(T t, int d, bool l) const override;
+    void                eval(DVector<Vector<T,3>>& p, T t, int d, bool l) const override;
     T                   getStartP() const override;
     T                   getEndP()   const override;
 
@@ -64,13 +64,13 @@ bool LissajousCurve<T>::isClosed() const {
 // x = a cos(kx t)
 // y = b sin(ky t)
 template <typename T>
-void LissajousCurve<T>::eval( T t, int d, bool /*l*/ ) const {
+void LissajousCurve<T>::eval( DVector<Vector<T,3>>& p, T t, int d, bool /*l*/ ) const {
 
-    this->_p.setDim( d + 1 );
+    p.setDim( d + 1 );
 
-    this->_p[0][0] = _a * cos(_kx * t);
-    this->_p[0][1] = _b * sin(_ky * t);
-    this->_p[0][2] = T(0);
+    p[0][0] = _a * cos(_kx * t);
+    p[0][1] = _b * sin(_ky * t);
+    p[0][2] = T(0);
 }
 
 
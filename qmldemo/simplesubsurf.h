@@ -41,7 +41,7 @@
 
   protected:
     // Virtual functions from PSurf, which have to be implemented locally
-    void          eval(T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const override;
+    void          eval(GMlib::DMatrix<GMlib::Vector<T,3>>& p, T u, T v, int d1, int d2, bool lu = true, bool lv = true ) const override;
     T             getStartPU() const override;
     T             getEndPU()   const override;
     T             getStartPV() const override;
@@ -117,11 +117,10 @@
     //*****************************************************
 
     template <typename T>
-    void PSimpleSubSurf<T>::eval( T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/) const {
+    void PSimpleSubSurf<T>::eval( GMlib::DMatrix<GMlib::Vector<T,3>>& p, T u, T v, int d1, int d2, bool /*lu*/, bool /*lv*/) const {
 
-      this->_p.setDim(3,3);
-      this->_p = _s->evaluateParent( u, v, d1, d2 );
-      this->_p[0][0] -=  _trans;
+      _s->evaluateParent( p, u, v, d1, d2 );
+      p[0][0] -=  _trans;
     }
 
 